@@ -16,6 +16,13 @@
  */
 #define CONFIG_SLAVE_MESSAGE_QUEUE_SIZE -1
 
+/**
+ * Number of ASDUs that the unbalanced CS 101 master can queue for each slave.
+ *
+ * For each queued message about 256 bytes of memory are required.
+ */
+#define CONFIG_CS101_MASTER_SLAVE_QUEUE_SIZE 8
+
 /**
  * Define the default size for the slave (outstation) message queue. This is used also
  * to buffer ASDUs in the case when the connection is lost.
@@ -34,6 +41,28 @@
  */
 #define CONFIG_CS104_MESSAGE_QUEUE_HIGH_PRIO_SIZE 50
 
+/**
+ * Size of the connection specific output buffer (in bytes) of the slave (outstation). Data that cannot be
+ * written to the socket immediately (e.g. when the TCP window of the client is closed) is stored in
+ * the buffer and sent when the socket accepts data again. The connection is closed when the buffer overflows.
+ */
+#define CONFIG_CS104_SLAVE_OUTPUT_BUFFER_SIZE 4096
+
+/**
+ * Use io_uring (Linux only) to read and write the connections of a slave. In threadless mode
+ * (see CS104_Slave_startThreadless) the receive and send operations of all connections are submitted
+ * with a single system call per loop iteration. In threaded mode each connection handling thread uses
+ * its own ring. The input and output buffers of the connections are registered with the ring. The slave
+ * falls back to poll and direct socket I/O when the kernel doesn't support io_uring. Not used for TLS connections.
+ */
+#define CONFIG_CS104_SLAVE_USE_IO_RING 1
+
+/**
+ * Use io_uring (Linux only) to receive the data of a CS104_Connection (client) into its registered input buffer.
+ * Falls back to poll when the kernel doesn't support io_uring. Not used for TLS connections.
+ */
+#define CONFIG_CS104_CONNECTION_USE_IO_RING 1
+
 /**
  * Compile the library to use threads. This will require semaphore support
  */
@@ -0,0 +1,437 @@
+/*
+ * cs101_benchmark.c
+ *
+ * Runs a CS101 master against many CS101 slaves inside a single process and reports
+ * the link layer throughput (frames per second), the poll cycle time and the CPU time
+ * per frame.
+ *
+ * The stations are connected by virtual lines (no serial hardware required) that simulate
+ * the baud rate, a latency and corrupted bytes. On Linux pseudo terminals can be used instead
+ * to include the serial port code and the kernel in the measurement.
+ *
+ * Usage: cs101_benchmark [-m balanced|unbalanced] [-n slaves] [-b baudrate] [-l latency_ms]
+ *                        [-e errors_per_million_bytes] [-t duration_s] [-p]
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+
+#include "hal_serial.h"
+#include "hal_thread.h"
+#include "hal_time.h"
+
+#include "cs101_master.h"
+#include "cs101_slave.h"
+#include "cs101_transport.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#endif
+
+/* address of the master in balanced mode */
+#define MASTER_ADDRESS 254
+
+/* size of the message queues (number of ASDUs of maximum size) */
+#define QUEUE_SIZE 100
+
+/* maximum number of slaves (link layer address length is 1) */
+#define MAX_SLAVES 250
+
+static bool running = true;
+
+void
+sigint_handler(int signalId)
+{
+    running = false;
+}
+
+struct sBenchmarkChannel
+{
+    CS101_Master master;
+
+    /* statistics of the master. Only accessed by the thread of the master */
+    uint64_t frames;
+    uint64_t receivedASDUs;
+    uint64_t pollCycles;
+    int lastPolledAddress;
+};
+
+/* Count sent and received frames and detect the end of a poll cycle (unbalanced mode) */
+static void
+rawMessageHandler(void* parameter, uint8_t* msg, int msgSize, bool sent)
+{
+    struct sBenchmarkChannel* channel = (struct sBenchmarkChannel*) parameter;
+
+    channel->frames++;
+
+    if (sent) {
+        int address = -1;
+
+        if (msg[0] == 0x10)
+            address = msg[2];
+        else if ((msg[0] == 0x68) && (msgSize > 5))
+            address = msg[5];
+
+        if (address != -1) {
+            /* the slaves are polled in the order of their addresses */
+            if (address <= channel->lastPolledAddress)
+                channel->pollCycles++;
+
+            channel->lastPolledAddress = address;
+        }
+    }
+}
+
+static bool
+asduReceivedHandler(void* parameter, int address, CS101_ASDU asdu)
+{
+    struct sBenchmarkChannel* channel = (struct sBenchmarkChannel*) parameter;
+
+    channel->receivedASDUs++;
+
+    return true;
+}
+
+#if defined(__linux__)
+
+/* Transport for the master side of a pseudo terminal (the slave side is used as serial port) */
+struct sPtyTransport
+{
+    int fd;
+    int baudRate;
+};
+
+static int
+ptyReadBytes(void* parameter, uint8_t* buffer, int maxSize, int timeoutInMs)
+{
+    struct sPtyTransport* pty = (struct sPtyTransport*) parameter;
+
+    struct pollfd fds;
+
+    fds.fd = pty->fd;
+    fds.events = POLLIN;
+
+    if (poll(&fds, 1, timeoutInMs) <= 0)
+        return 0;
+
+    int readBytes = read(pty->fd, buffer, maxSize);
+
+    return (readBytes < 0) ? 0 : readBytes;
+}
+
+static int
+ptyWrite(void* parameter, uint8_t* buffer, int numberOfBytes)
+{
+    struct sPtyTransport* pty = (struct sPtyTransport*) parameter;
+
+    return write(pty->fd, buffer, numberOfBytes);
+}
+
+static int
+ptyGetBaudRate(void* parameter)
+{
+    struct sPtyTransport* pty = (struct sPtyTransport*) parameter;
+
+    return pty->baudRate;
+}
+
+static int
+openPseudoTerminal(char* ptyName)
+{
+    int fd = open("/dev/ptmx", O_RDWR | O_NOCTTY);
+
+    if (fd >= 0) {
+        int unlock = 0;
+        int ptyNumber = -1;
+
+        if ((ioctl(fd, TIOCSPTLCK, &unlock) != 0) || (ioctl(fd, TIOCGPTN, &ptyNumber) != 0)) {
+            close(fd);
+            return -1;
+        }
+
+        sprintf(ptyName, "/dev/pts/%i", ptyNumber);
+
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    }
+
+    return fd;
+}
+
+#endif /* defined(__linux__) */
+
+static void
+printUsage(void)
+{
+    printf("Usage: cs101_benchmark [-m balanced|unbalanced] [-n slaves] [-b baudrate] [-l latency_ms]\n");
+    printf("                       [-e errors_per_million_bytes] [-t duration_s] [-p]\n\n");
+    printf("  -p  use pseudo terminals instead of virtual lines (Linux only, one line per slave)\n");
+}
+
+int
+main(int argc, char** argv)
+{
+    signal(SIGINT, sigint_handler);
+
+    IEC60870_LinkLayerMode mode = IEC60870_LINK_LAYER_UNBALANCED;
+    int numberOfSlaves = 10;
+    int baudRate = 9600;
+    int latency = 0;
+    int errorsPerMillion = 0;
+    int duration = 10;
+    bool usePty = false;
+
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-m") == 0) && (i + 1 < argc)) {
+            i++;
+
+            if (strcmp(argv[i], "balanced") == 0)
+                mode = IEC60870_LINK_LAYER_BALANCED;
+        }
+        else if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc))
+            numberOfSlaves = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-b") == 0) && (i + 1 < argc))
+            baudRate = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-l") == 0) && (i + 1 < argc))
+            latency = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-e") == 0) && (i + 1 < argc))
+            errorsPerMillion = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+            duration = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-p") == 0)
+            usePty = true;
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if ((numberOfSlaves < 1) || (numberOfSlaves > MAX_SLAVES)) {
+        printf("Number of slaves has to be between 1 and %i\n", MAX_SLAVES);
+        return 1;
+    }
+
+#if !defined(__linux__)
+    if (usePty) {
+        printf("Pseudo terminals are only supported on Linux\n");
+        return 1;
+    }
+#endif
+
+    /* A virtual line is a party line -> in unbalanced mode a single master polls all slaves.
+     * Balanced mode and pseudo terminals are point-to-point -> one master per slave. */
+    int numberOfMasters = ((mode == IEC60870_LINK_LAYER_UNBALANCED) && (usePty == false)) ? 1 : numberOfSlaves;
+
+    struct sBenchmarkChannel* channels = (struct sBenchmarkChannel*) calloc(numberOfMasters, sizeof(struct sBenchmarkChannel));
+    CS101_Slave* slaves = (CS101_Slave*) calloc(numberOfSlaves, sizeof(CS101_Slave));
+    CS101_VirtualLine* lines = (CS101_VirtualLine*) calloc(numberOfMasters, sizeof(CS101_VirtualLine));
+    SerialPort* ports = (SerialPort*) calloc(numberOfSlaves, sizeof(SerialPort));
+
+#if defined(__linux__)
+    struct sPtyTransport* ptys = (struct sPtyTransport*) calloc(numberOfSlaves, sizeof(struct sPtyTransport));
+#endif
+
+    for (i = 0; i < numberOfSlaves; i++) {
+
+        int slaveAddress = i + 1;
+        int channelIndex = (numberOfMasters == 1) ? 0 : i;
+
+        struct sBenchmarkChannel* channel = &(channels[channelIndex]);
+
+        CS101_Transport masterTransport = NULL;
+        CS101_Transport slaveTransport = NULL;
+
+#if defined(__linux__)
+        struct sCS101_Transport ptyTransport;
+
+        if (usePty) {
+            char ptyName[100];
+
+            ptys[i].fd = openPseudoTerminal(ptyName);
+            ptys[i].baudRate = baudRate;
+
+            if (ptys[i].fd < 0) {
+                printf("Failed to open pseudo terminal\n");
+                return 1;
+            }
+
+            ptyTransport.readBytes = ptyReadBytes;
+            ptyTransport.write = ptyWrite;
+            ptyTransport.getBaudRate = ptyGetBaudRate;
+            ptyTransport.getBitsPerCharacter = NULL; /* 8E1 like the serial port of the slave */
+            ptyTransport.parameter = &(ptys[i]);
+
+            masterTransport = &ptyTransport;
+
+            ports[i] = SerialPort_create(ptyName, (baudRate > 0) ? baudRate : 115200, 8, 'E', 1);
+
+            if (SerialPort_open(ports[i]) == false) {
+                printf("Failed to open %s\n", ptyName);
+                return 1;
+            }
+        }
+        else
+#endif
+        {
+            if (lines[channelIndex] == NULL) {
+                lines[channelIndex] = CS101_VirtualLine_create(baudRate);
+                CS101_VirtualLine_setLatency(lines[channelIndex], latency);
+                CS101_VirtualLine_setErrorRate(lines[channelIndex], errorsPerMillion, channelIndex + 1);
+
+                masterTransport = CS101_VirtualLine_addEndpoint(lines[channelIndex]);
+            }
+
+            slaveTransport = CS101_VirtualLine_addEndpoint(lines[channelIndex]);
+        }
+
+        if (masterTransport) {
+            channel->master = CS101_Master_createWithTransport(masterTransport, NULL, NULL, mode, QUEUE_SIZE);
+
+            CS101_Master_setRawMessageHandler(channel->master, rawMessageHandler, channel);
+            CS101_Master_setASDUReceivedHandler(channel->master, asduReceivedHandler, channel);
+
+            if (mode == IEC60870_LINK_LAYER_BALANCED) {
+                CS101_Master_setOwnAddress(channel->master, MASTER_ADDRESS);
+                CS101_Master_useSlaveAddress(channel->master, slaveAddress);
+            }
+        }
+
+        if (mode == IEC60870_LINK_LAYER_UNBALANCED) {
+            CS101_Master_addSlave(channel->master, slaveAddress);
+
+            /* request class 2 data as fast as possible */
+            CS101_Master_setSlavePollIntervals(channel->master, slaveAddress, 0, 1);
+        }
+
+        if (slaveTransport)
+            slaves[i] = CS101_Slave_createWithTransport(slaveTransport, NULL, NULL, mode, QUEUE_SIZE, QUEUE_SIZE);
+        else
+            slaves[i] = CS101_Slave_create(ports[i], NULL, NULL, mode);
+
+        CS101_Slave_setLinkLayerAddress(slaves[i], slaveAddress);
+        CS101_Slave_setLinkLayerAddressOtherStation(slaves[i], MASTER_ADDRESS);
+    }
+
+    printf("mode: %s  slaves: %i  masters: %i  baud rate: %i  latency: %i ms  errors: %i per million bytes  transport: %s\n",
+            (mode == IEC60870_LINK_LAYER_BALANCED) ? "balanced" : "unbalanced",
+            numberOfSlaves, numberOfMasters, baudRate, latency, errorsPerMillion,
+            usePty ? "pseudo terminal" : "virtual line");
+
+    for (i = 0; i < numberOfSlaves; i++)
+        CS101_Slave_start(slaves[i]);
+
+    for (i = 0; i < numberOfMasters; i++)
+        CS101_Master_start(channels[i].master);
+
+    uint64_t startTime = Hal_getTimeInMs();
+    clock_t startCpuTime = clock();
+
+    int16_t scaledValue = 0;
+
+    while (running && (Hal_getTimeInMs() < (startTime + (uint64_t) duration * 1000))) {
+
+        /* keep the class 2 queues of the slaves filled with spontaneous measurements */
+        for (i = 0; i < numberOfSlaves; i++) {
+
+            if (CS101_Slave_isClass2QueueFull(slaves[i]) == false) {
+                CS101_AppLayerParameters alParameters = CS101_Slave_getAppLayerParameters(slaves[i]);
+
+                CS101_ASDU newAsdu = CS101_ASDU_create(alParameters, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+                InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue++, IEC60870_QUALITY_GOOD);
+
+                CS101_ASDU_addInformationObject(newAsdu, io);
+
+                InformationObject_destroy(io);
+
+                CS101_Slave_enqueueUserDataClass2(slaves[i], newAsdu);
+
+                CS101_ASDU_destroy(newAsdu);
+            }
+        }
+
+        Thread_sleep(10);
+    }
+
+    for (i = 0; i < numberOfMasters; i++)
+        CS101_Master_stop(channels[i].master);
+
+    for (i = 0; i < numberOfSlaves; i++)
+        CS101_Slave_stop(slaves[i]);
+
+    double elapsedTime = (double) (Hal_getTimeInMs() - startTime) / 1000.0;
+    double cpuTime = (double) (clock() - startCpuTime) / CLOCKS_PER_SEC;
+
+    uint64_t frames = 0;
+    uint64_t receivedASDUs = 0;
+    double cycleTimeSum = 0.0;
+    int cycleTimeCount = 0;
+
+    for (i = 0; i < numberOfMasters; i++) {
+        frames += channels[i].frames;
+        receivedASDUs += channels[i].receivedASDUs;
+
+        if (channels[i].pollCycles > 0) {
+            cycleTimeSum += (elapsedTime * 1000.0) / channels[i].pollCycles;
+            cycleTimeCount++;
+        }
+    }
+
+    uint64_t corruptedBytes = 0;
+
+    for (i = 0; i < numberOfMasters; i++) {
+        if (lines[i])
+            corruptedBytes += CS101_VirtualLine_getCorruptedBytes(lines[i]);
+    }
+
+    printf("frames:          %llu (%.1f frames/s)\n", (unsigned long long) frames, frames / elapsedTime);
+    printf("received ASDUs:  %llu (%.1f ASDUs/s)\n", (unsigned long long) receivedASDUs, receivedASDUs / elapsedTime);
+
+    if ((mode == IEC60870_LINK_LAYER_UNBALANCED) && (cycleTimeCount > 0))
+        printf("poll cycle time: %.2f ms\n", cycleTimeSum / cycleTimeCount);
+
+    if (frames > 0)
+        printf("CPU per frame:   %.2f us (%.2f s CPU time)\n", (cpuTime * 1000000.0) / frames, cpuTime);
+
+    if (usePty == false)
+        printf("corrupted bytes: %llu\n", (unsigned long long) corruptedBytes);
+
+    for (i = 0; i < numberOfMasters; i++)
+        CS101_Master_destroy(channels[i].master);
+
+    for (i = 0; i < numberOfSlaves; i++) {
+        CS101_Slave_destroy(slaves[i]);
+
+        if (ports[i]) {
+            SerialPort_close(ports[i]);
+            SerialPort_destroy(ports[i]);
+        }
+
+#if defined(__linux__)
+        if (usePty)
+            close(ptys[i].fd);
+#endif
+    }
+
+    for (i = 0; i < numberOfMasters; i++)
+        CS101_VirtualLine_destroy(lines[i]);
+
+#if defined(__linux__)
+    free(ptys);
+#endif
+
+    free(ports);
+    free(lines);
+    free(slaves);
+    free(channels);
+
+    return 0;
+}
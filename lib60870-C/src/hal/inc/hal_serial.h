@@ -103,6 +103,14 @@ SerialPort_close(SerialPort self);
 int
 SerialPort_getBaudRate(SerialPort self);
 
+/**
+ * \brief Get the number of bits of a character (start bit, data bits, parity bit and stop bits)
+ *
+ * \return the number of bits that are transmitted for each byte
+ */
+int
+SerialPort_getBitsPerCharacter(SerialPort self);
+
 /**
  * \brief Set the timeout used for message reception
  *
@@ -125,6 +133,20 @@ SerialPort_discardInBuffer(SerialPort self);
 int
 SerialPort_readByte(SerialPort self);
 
+/**
+ * \brief Read all available bytes from the interface
+ *
+ * Waits up to the timeout (see \ref SerialPort_setTimeout) for the first byte and then
+ * returns all bytes that are available without further waiting.
+ *
+ * \param buffer the buffer to store the received data
+ * \param maxSize maximum number of bytes to read
+ *
+ * \return number of read bytes, 0 when the timeout elapsed, or -1 in case of an error
+ */
+int
+SerialPort_readBytes(SerialPort self, uint8_t* buffer, int maxSize);
+
 /**
  * \brief Write the number of bytes from the buffer to the serial interface
  *
@@ -143,6 +165,45 @@ SerialPort_write(SerialPort self, uint8_t* buffer, int startPos, int numberOfByt
 SerialPortError
 SerialPort_getLastError(SerialPort self);
 
+/** Opaque reference for a set of serial ports that can be monitored together */
+typedef struct sSerialPortSet* SerialPortSet;
+
+/**
+ * \brief Create a new set of serial ports to wait for received data on multiple ports
+ */
+SerialPortSet
+SerialPortSet_create(void);
+
+/**
+ * \brief Add a serial port to the set
+ *
+ * \param port an open serial port
+ */
+void
+SerialPortSet_addPort(SerialPortSet self, SerialPort port);
+
+/**
+ * \brief Wait until data is available on at least one of the ports
+ *
+ * \param timeoutMs maximum time to wait in milliseconds
+ *
+ * \return number of ports with received data, 0 on timeout, or -1 in case of an error
+ */
+int
+SerialPortSet_waitReady(SerialPortSet self, int timeoutMs);
+
+/**
+ * \brief Check if data was available on the port at the last call of \ref SerialPortSet_waitReady
+ */
+bool
+SerialPortSet_isReady(SerialPortSet self, SerialPort port);
+
+/**
+ * \brief Destroy the set (the serial ports are not closed)
+ */
+void
+SerialPortSet_destroy(SerialPortSet self);
+
 /*! @} */
 
 /*! @} */
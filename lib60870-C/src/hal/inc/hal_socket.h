@@ -62,6 +62,18 @@ typedef struct sSocket* Socket;
 /** Opaque reference for a set of server and socket handles */
 typedef struct sHandleSet* HandleSet;
 
+/** TCP socket options (see \ref Socket_setOptions) */
+typedef struct sSocketOptions* SocketOptions;
+
+struct sSocketOptions {
+    int sendBufferSize; /**< SO_SNDBUF (in bytes), 0 = OS default */
+    int receiveBufferSize; /**< SO_RCVBUF (in bytes), 0 = OS default */
+    bool noDelay; /**< TCP_NODELAY - send small segments immediately (default: true) */
+    int userTimeout; /**< TCP_USER_TIMEOUT (in ms) - close connection when sent data is not acknowledged in time, 0 = OS default */
+    int busyPollTime; /**< SO_BUSY_POLL (in us) - busy poll the network device when waiting for data, 0 = disabled */
+    bool corkBatches; /**< cork the socket (\ref Socket_setCork) while the protocol sends a batch of messages (default: false) */
+};
+
 /**
  * \brief Create a new connection handle set (HandleSet)
  *
@@ -71,7 +83,7 @@ HandleSet
 Handleset_new(void);
 
 /**
- * \brief Reset the handle set for reuse
+ * \brief Reset the handle set for reuse (removes all sockets)
  */
 void
 Handleset_reset(HandleSet self);
@@ -79,16 +91,41 @@ Handleset_reset(HandleSet self);
 /**
  * \brief add a soecket to an existing handle set
  *
+ * The socket stays in the set until it is removed or the set is reset. Adding a socket
+ * that is already in the set has no effect.
+ *
  * \param self the HandleSet instance
  * \param sock the socket to add
  */
 void
 Handleset_addSocket(HandleSet self, const Socket sock);
 
+/**
+ * \brief remove a socket from the handle set
+ *
+ * NOTE: has to be called before the socket is destroyed.
+ *
+ * \param self the HandleSet instance
+ * \param sock the socket to remove
+ */
+void
+Handleset_removeSocket(HandleSet self, const Socket sock);
+
+/**
+ * \brief check if a socket was reported ready by the last call of \ref Handleset_waitReady
+ *
+ * \param self the HandleSet instance
+ * \param sock the socket to check
+ *
+ * \return true when data is pending (or the peer closed the connection), false otherwise
+ */
+bool
+Handleset_isReady(HandleSet self, const Socket sock);
+
 /**
  * \brief wait for a socket to become ready
  *
- * This function is corresponding to the BSD socket select function.
+ * This function is corresponding to the BSD socket select/poll function.
  * It returns the number of sockets on which data is pending or 0 if no data is pending
  * on any of the monitored connections. The function will return after "timeout" ms if no
  * data is pending.
@@ -111,6 +148,131 @@ Handleset_waitReady(HandleSet self, unsigned int timeoutMs);
 void
 Handleset_destroy(HandleSet self);
 
+/**
+ * \brief Ring for asynchronous receive and send operations of many sockets
+ *
+ * The receive and send operations of many sockets are submitted and completed with a single system
+ * call (io_uring on Linux). This replaces the HandleSet and a read or write call for each socket.
+ *
+ * Implementation of these functions is OPTIONAL. Platforms without support return NULL
+ * in \ref SocketIoRing_create.
+ */
+typedef struct sSocketIoRing* SocketIoRing;
+
+/**
+ * \brief Create a new ring for asynchronous receive and send operations
+ *
+ * \param maxOperations maximum number of receive and send operations that are pending at the same time
+ *
+ * \return the new ring, or NULL when not supported by the platform or the kernel
+ */
+SocketIoRing
+SocketIoRing_create(int maxOperations);
+
+/**
+ * \brief Register a memory area that contains the buffers of the operations
+ *
+ * The kernel maps the memory area once instead of for each operation. Operations with a buffer
+ * inside of the area use the registered buffer. Has to be called before the first operation is
+ * queued. Can only be called once for a ring.
+ *
+ * \param buf start of the memory area
+ * \param size size of the memory area
+ *
+ * \return true when the area is registered, false when not supported or not permitted (e.g. by
+ *         the limit for locked memory). The operations are working without a registered buffer.
+ */
+bool
+SocketIoRing_registerBuffer(SocketIoRing self, uint8_t* buf, int size);
+
+/**
+ * \brief Queue a receive operation. It is submitted with the next call of \ref SocketIoRing_submitAndWait.
+ *
+ * NOTE: The buffer has to stay valid until the completion of the operation has been received
+ * by \ref SocketIoRing_getCompletion.
+ *
+ * \param sock the socket to read from
+ * \param buf the buffer for the received data
+ * \param size the size of the buffer
+ * \param userData identifies the operation (must not be NULL and must be unique for the pending operations)
+ *
+ * \return true when the operation has been queued, false when too many operations are pending
+ */
+bool
+SocketIoRing_prepareReceive(SocketIoRing self, Socket sock, uint8_t* buf, int size, void* userData);
+
+/**
+ * \brief Queue a send operation. It is submitted with the next call of \ref SocketIoRing_submit
+ * or \ref SocketIoRing_submitAndWait.
+ *
+ * The operation can stay pending while the socket buffer is full (the peer doesn't read).
+ *
+ * NOTE: The buffer has to stay valid until the completion of the operation has been received
+ * by \ref SocketIoRing_getCompletion.
+ *
+ * \param sock the socket to write to
+ * \param buf the data to send
+ * \param size the number of bytes to send
+ * \param userData identifies the operation (must not be NULL and must be unique for the pending
+ *        send operations)
+ *
+ * \return true when the operation has been queued, false when too many operations are pending
+ */
+bool
+SocketIoRing_prepareSend(SocketIoRing self, Socket sock, uint8_t* buf, int size, void* userData);
+
+/**
+ * \brief Cancel the pending receive and send operations with the given user data
+ *
+ * The operations are completed with result -1. The buffers have to stay valid until the completions
+ * have been received.
+ *
+ * \param userData the user data of the operations
+ */
+void
+SocketIoRing_cancel(SocketIoRing self, void* userData);
+
+/**
+ * \brief Submit the queued operations without waiting for completions
+ *
+ * \return false in case of an error
+ */
+bool
+SocketIoRing_submit(SocketIoRing self);
+
+/**
+ * \brief Submit the queued operations and wait until at least one operation is complete
+ *
+ * \param timeoutMs maximum time to wait for a completed operation
+ *
+ * \return false in case of an error
+ */
+bool
+SocketIoRing_submitAndWait(SocketIoRing self, unsigned int timeoutMs);
+
+/**
+ * \brief Get the next completed operation
+ *
+ * \param[out] userData the user data of the completed operation
+ * \param[out] result receive operation: number of received bytes, 0 when the peer closed the connection.
+ *              Send operation: number of sent bytes (can be less than requested when the socket buffer
+ *              is full). -1 in case of an error or when the operation has been canceled.
+ * \param[out] isSend true when the completed operation is a send operation
+ *
+ * \return true when a completed operation is returned, false when no more operations are completed
+ */
+bool
+SocketIoRing_getCompletion(SocketIoRing self, void** userData, int* result, bool* isSend);
+
+/**
+ * \brief Destroy the ring
+ *
+ * Pending operations are canceled. The function returns when the buffers of the operations
+ * are no longer used.
+ */
+void
+SocketIoRing_destroy(SocketIoRing self);
+
 /**
  * \brief Create a new TcpServerSocket instance
  *
@@ -201,6 +363,46 @@ TcpSocket_create(void);
 void
 Socket_setConnectTimeout(Socket self, uint32_t timeoutInMs);
 
+/**
+ * \brief initialize socket options with the default values
+ *
+ * \param self the socket options to initialize
+ */
+void
+SocketOptions_init(SocketOptions self);
+
+/**
+ * \brief set the TCP options of a socket
+ *
+ * The options are applied immediately when the socket is already connected (e.g. a socket
+ * returned by \ref ServerSocket_accept), otherwise they are applied by \ref Socket_connect
+ * before the connection is established. Options that are not supported by the platform
+ * are ignored.
+ *
+ * NOTE: the receive buffer size determines the TCP window scaling. For connections accepted by
+ * a server socket the window scale is already fixed, so the effective window can be limited.
+ *
+ * \param self the socket instance
+ * \param options the options to apply (will be copied)
+ *
+ * \return false when at least one option could not be applied, true otherwise
+ */
+bool
+Socket_setOptions(Socket self, SocketOptions options);
+
+/**
+ * \brief cork or uncork the socket
+ *
+ * While the socket is corked partial segments are not sent, so multiple small messages
+ * are combined into full TCP segments. Uncorking sends the pending data immediately
+ * (TCP_CORK on Linux, TCP_NOPUSH on BSD, no effect on other platforms).
+ *
+ * \param self the socket instance
+ * \param cork true to cork, false to uncork
+ */
+void
+Socket_setCork(Socket self, bool cork);
+
 /**
  * \brief connect to a server
  *
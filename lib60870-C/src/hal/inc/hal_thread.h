@@ -23,6 +23,7 @@
 #define THREAD_HAL_H_
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -50,9 +51,41 @@ typedef struct sThread* Thread;
 /** Qpaque reference of a Semaphore instance */
 typedef void* Semaphore;
 
+/** Opaque reference of a Mutex instance */
+typedef struct sMutex* Mutex;
+
+/** Opaque reference of a Condition (condition variable) instance */
+typedef struct sCondition* Condition;
+
 /** Reference to a function that is called when starting the thread */
 typedef void* (*ThreadExecutionFunction) (void*);
 
+/** Scheduling policy of a thread */
+typedef enum {
+    THREAD_SCHEDULING_POLICY_DEFAULT = 0, /**< normal time sharing scheduling of the OS */
+    THREAD_SCHEDULING_POLICY_FIFO = 1, /**< real-time first-in first-out scheduling (SCHED_FIFO) */
+    THREAD_SCHEDULING_POLICY_RR = 2 /**< real-time round-robin scheduling (SCHED_RR) */
+} ThreadSchedulingPolicy;
+
+/** Maximum length of a thread name (including the terminating zero) */
+#define THREAD_NAME_MAX_LENGTH 16
+
+/**
+ * \brief Execution attributes of a thread (CPU affinity, scheduling, and name)
+ *
+ * The attributes are hints. When the platform does not support an attribute or the
+ * process lacks the required privileges (e.g. for real-time scheduling) the
+ * attribute is ignored and the thread runs with the default settings.
+ */
+typedef struct sThreadAttributes* ThreadAttributes;
+
+struct sThreadAttributes {
+    uint64_t cpuAffinityMask; /**< CPUs the thread is allowed to run on (bit n = CPU n), 0 = no restriction */
+    ThreadSchedulingPolicy schedulingPolicy; /**< scheduling policy */
+    int priority; /**< scheduling priority (only used with real-time scheduling policies) */
+    char name[THREAD_NAME_MAX_LENGTH]; /**< thread name as shown by debuggers and profilers, empty to keep the default */
+};
+
 /**
  * \brief Create a new Thread instance
  *
@@ -76,6 +109,34 @@ Thread_create(ThreadExecutionFunction function, void* parameter, bool autodestro
 void
 Thread_start(Thread thread);
 
+/**
+ * \brief Initialize thread attributes with the default values
+ *
+ * No CPU affinity, default scheduling policy, no thread name.
+ *
+ * \param self the attributes to initialize
+ */
+void
+ThreadAttributes_init(ThreadAttributes self);
+
+/**
+ * \brief Set the thread name. Longer names are truncated to THREAD_NAME_MAX_LENGTH - 1 characters.
+ */
+void
+ThreadAttributes_setName(ThreadAttributes self, const char* name);
+
+/**
+ * \brief Set the execution attributes of a thread
+ *
+ * Has to be called before \ref Thread_start. The attributes are copied and applied
+ * by the new thread itself before the thread function is called.
+ *
+ * \param thread the Thread instance
+ * \param attributes the attributes to apply (NULL to reset to default attributes)
+ */
+void
+Thread_setAttributes(Thread thread, ThreadAttributes attributes);
+
 /**
  * \brief Destroy a Thread and free all related resources.
  *
@@ -103,6 +164,83 @@ Semaphore_post(Semaphore self);
 void
 Semaphore_destroy(Semaphore self);
 
+/**
+ * \brief Create a new (non-recursive) Mutex instance
+ *
+ * A mutex has to be unlocked by the same thread that locked it. Use it instead
+ * of a binary semaphore to protect critical sections.
+ *
+ * \return the newly created Mutex instance, or NULL if it cannot be created
+ */
+Mutex
+Mutex_create(void);
+
+/**
+ * \brief Lock the mutex. Blocks until the mutex is available.
+ */
+void
+Mutex_lock(Mutex self);
+
+/**
+ * \brief Unlock a mutex that has been locked by the calling thread.
+ */
+void
+Mutex_unlock(Mutex self);
+
+void
+Mutex_destroy(Mutex self);
+
+/**
+ * \brief Create a new Condition instance
+ *
+ * A condition is always used together with a Mutex that protects the state the
+ * waiting thread is interested in.
+ *
+ * \return the newly created Condition instance, or NULL if it cannot be created
+ */
+Condition
+Condition_create(void);
+
+/**
+ * \brief Wait until the condition is signaled
+ *
+ * The mutex has to be locked by the caller. It is released while waiting and locked
+ * again before the function returns. As spurious wake-ups are possible the caller has
+ * to check the protected state in a loop.
+ *
+ * \param self the Condition instance
+ * \param mutex the locked mutex that protects the state
+ */
+void
+Condition_wait(Condition self, Mutex mutex);
+
+/**
+ * \brief Wait until the condition is signaled or the timeout elapsed
+ *
+ * \param self the Condition instance
+ * \param mutex the locked mutex that protects the state
+ * \param timeoutInMs maximum time to wait in milliseconds
+ *
+ * \return false when the timeout elapsed, true otherwise
+ */
+bool
+Condition_waitTimed(Condition self, Mutex mutex, int timeoutInMs);
+
+/**
+ * \brief Wake up one thread waiting for the condition
+ */
+void
+Condition_signal(Condition self);
+
+/**
+ * \brief Wake up all threads waiting for the condition
+ */
+void
+Condition_broadcast(Condition self);
+
+void
+Condition_destroy(Condition self);
+
 /*! @} */
 
 /*! @} */
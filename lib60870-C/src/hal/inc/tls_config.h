@@ -117,6 +117,64 @@ TLSConfiguration_addCACertificateFromFile(TLSConfiguration self, const char* fil
 void
 TLSConfiguration_setRenegotiationTime(TLSConfiguration self, int timeInMs);
 
+/**
+ * \brief Set the maximum time for the TLS handshake of a new connection (default: 10000 ms)
+ *
+ * When the handshake is not completed within this time the connection is rejected. This
+ * prevents slow or malicious peers from blocking resources for an unlimited time.
+ *
+ * \param timeoutInMs handshake timeout in milliseconds
+ */
+void
+TLSConfiguration_setHandshakeTimeout(TLSConfiguration self, int timeoutInMs);
+
+/**
+ * \brief Enable or disable TLS session resumption (disabled by default)
+ *
+ * When enabled a server keeps the sessions of its clients in a session cache and
+ * issues session tickets. A client stores the session of its last successful handshake
+ * and tries to resume it on the next connect (e.g. when reconnecting after a network failure).
+ * A resumed session avoids the expensive public key operations of a full handshake.
+ *
+ * \param enable true to enable session resumption, false to disable
+ */
+void
+TLSConfiguration_enableSessionResumption(TLSConfiguration self, bool enable);
+
+/**
+ * \brief Set the lifetime of a resumable session (default: 21600 s)
+ *
+ * After the lifetime elapsed a full handshake is required. This is also the lifetime of
+ * the session tickets issued by a server.
+ *
+ * NOTE: Has to be called before the first connection is created with this configuration.
+ *
+ * \param intervalInSeconds lifetime of a session in seconds
+ */
+void
+TLSConfiguration_setSessionResumptionInterval(TLSConfiguration self, int intervalInSeconds);
+
+/**
+ * \brief Set the maximum number of sessions in the server side session cache (default: 50)
+ *
+ * NOTE: Has to be called before the first connection is created with this configuration.
+ *
+ * \param maxEntries maximum number of cached sessions
+ */
+void
+TLSConfiguration_setSessionCacheSize(TLSConfiguration self, int maxEntries);
+
+/**
+ * \brief Get the number of handshakes that resumed a session instead of doing a full handshake
+ *
+ * Counts the connections of all clients (server side) or all connects (client side) that use this
+ * configuration. Can be used to check that reconnecting clients resume their sessions.
+ *
+ * \return the number of resumed sessions
+ */
+int
+TLSConfiguration_getResumedSessionCount(TLSConfiguration self);
+
 void
 TLSConfiguration_destroy(TLSConfiguration self);
 
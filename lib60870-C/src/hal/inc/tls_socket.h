@@ -62,6 +62,34 @@ typedef struct sTLSSocket* TLSSocket;
 TLSSocket
 TLSSocket_create(Socket socket, TLSConfiguration configuration, bool storeClientCert);
 
+/**
+ * \brief Create a new TLSSocket instance without waiting for the TLS handshake
+ *
+ * The handshake is performed by \ref TLSSocket_continueHandshake. Can be used by servers that
+ * handle many connections with a single thread.
+ *
+ * \param socket the socket instance to use for the TLS connection
+ * \param configuration the TLS configuration object to use
+ * \param storeClientCert if true, the client certificate will be stored
+ *                        for later access by \ref TLSSocket_getPeerCertificate
+ *
+ * \return new TLS connection instance
+ */
+TLSSocket
+TLSSocket_createNonBlocking(Socket socket, TLSConfiguration configuration, bool storeClientCert);
+
+/**
+ * \brief Continue the TLS handshake of a socket created with \ref TLSSocket_createNonBlocking
+ *
+ * Handles the handshake messages that are available without blocking. Has to be called
+ * again (e.g. when the socket is readable) until the handshake is complete.
+ *
+ * \return 1 when the handshake is complete, 0 when the handshake is not yet complete,
+ *         -1 when the handshake failed or timed out (release the socket with \ref TLSSocket_close)
+ */
+int
+TLSSocket_continueHandshake(TLSSocket self);
+
 /**
  * \brief Perform a new TLS handshake/session renegotiation
  */
@@ -98,9 +126,12 @@ TLSSocket_read(TLSSocket self, uint8_t* buf, int size);
  *
  * Implementation of this function is MANDATORY
  *
+ * The function doesn't block when the socket cannot take more data. In this case it returns 0 and the
+ * caller has to repeat the call later with the same data (more data can be appended).
+ *
  * \param self client, connection or server socket instance
  *
- * \return number of bytes transmitted of -1 in case of an error
+ * \return number of bytes transmitted, 0 when the socket is busy, or -1 in case of an error
  */
 int
 TLSSocket_write(TLSSocket self, uint8_t* buf, int size);
@@ -29,6 +29,8 @@
 #include <termios.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <poll.h>
+#include <errno.h>
 
 #include "hal_serial.h"
 #include "hal_time.h"
@@ -41,11 +43,11 @@ struct sSerialPort {
     char parity;
     uint8_t stopBits;
     uint64_t lastSentTime;
+    int portSetIndex; /* position in the port set that registered the port last (-1 = none) */
     struct timeval timeout;
     SerialPortError lastError;
 };
 
-
 SerialPort
 SerialPort_create(const char* interfaceName, int baudRate, uint8_t dataBits, char parity, uint8_t stopBits)
 {
@@ -57,6 +59,7 @@ SerialPort_create(const char* interfaceName, int baudRate, uint8_t dataBits, cha
         self->dataBits = dataBits;
         self->stopBits = stopBits;
         self->parity = parity;
+        self->portSetIndex = -1;
         self->lastSentTime = 0;
         self->timeout.tv_sec = 0;
         self->timeout.tv_usec = 100000; /* 100 ms */
@@ -215,10 +218,16 @@ SerialPort_getBaudRate(SerialPort self)
     return self->baudRate;
 }
 
+int
+SerialPort_getBitsPerCharacter(SerialPort self)
+{
+    return 1 + self->dataBits + ((self->parity == 'N') ? 0 : 1) + self->stopBits;
+}
+
 void
 SerialPort_discardInBuffer(SerialPort self)
 {
-    tcflush(self->fd, TCIOFLUSH);
+    tcflush(self->fd, TCIFLUSH);
 }
 
 void
@@ -261,17 +270,166 @@ SerialPort_readByte(SerialPort self)
 }
 
 int
-SerialPort_write(SerialPort self, uint8_t* buffer, int startPos, int bufSize)
+SerialPort_readBytes(SerialPort self, uint8_t* buffer, int maxSize)
 {
-    //TODO assure minimum line idle time
+    struct pollfd fds;
 
     self->lastError = SERIAL_PORT_ERROR_NONE;
 
-    ssize_t result = write(self->fd, buffer + startPos, bufSize);
+    fds.fd = self->fd;
+    fds.events = POLLIN;
+    fds.revents = 0;
+
+    int timeoutMs = (int) (self->timeout.tv_sec * 1000 + self->timeout.tv_usec / 1000);
+
+    int ret = poll(&fds, 1, timeoutMs);
+
+    if (ret == -1) {
+        self->lastError = SERIAL_PORT_ERROR_UNKNOWN;
+        return -1;
+    }
+    else if (ret == 0)
+        return 0;
+
+    ssize_t readBytes = read(self->fd, buffer, maxSize);
 
-    tcdrain(self->fd);
+    if (readBytes == -1) {
+        if ((errno == EAGAIN) || (errno == EINTR))
+            return 0;
 
+        self->lastError = SERIAL_PORT_ERROR_UNKNOWN;
+        return -1;
+    }
+
+    return (int) readBytes;
+}
+
+int
+SerialPort_write(SerialPort self, uint8_t* buffer, int startPos, int bufSize)
+{
+    self->lastError = SERIAL_PORT_ERROR_NONE;
+
+    int written = 0;
+
+    while (written < bufSize) {
+        ssize_t result = write(self->fd, buffer + startPos + written, bufSize - written);
+
+        if (result < 0) {
+            if ((errno == EAGAIN) || (errno == EINTR)) {
+                /* driver buffer is full -> wait until the UART has sent some characters */
+                struct pollfd fds;
+
+                fds.fd = self->fd;
+                fds.events = POLLOUT;
+                fds.revents = 0;
+
+                poll(&fds, 1, 100);
+
+                continue;
+            }
+
+            self->lastError = SERIAL_PORT_ERROR_UNKNOWN;
+            return -1;
+        }
+
+        written += (int) result;
+    }
+
+    /*
+     * Don't wait for the UART to drain (tcdrain). The caller can continue while the frame
+     * is transmitted (the transmission time is calculated by the FT 1.2 transceiver).
+     */
     self->lastSentTime = Hal_getTimeInMs();
 
-    return result;
+    return written;
+}
+
+struct sSerialPortSet {
+    SerialPort* ports;
+    struct pollfd* fds;
+    int numberOfPorts;
+    int maxPorts;
+};
+
+SerialPortSet
+SerialPortSet_create(void)
+{
+    SerialPortSet self = (SerialPortSet) GLOBAL_CALLOC(1, sizeof(struct sSerialPortSet));
+
+    return self;
+}
+
+void
+SerialPortSet_addPort(SerialPortSet self, SerialPort port)
+{
+    if (self->numberOfPorts == self->maxPorts) {
+        int newMaxPorts = (self->maxPorts == 0) ? 8 : (self->maxPorts * 2);
+
+        self->ports = (SerialPort*) GLOBAL_REALLOC(self->ports, newMaxPorts * sizeof(SerialPort));
+        self->fds = (struct pollfd*) GLOBAL_REALLOC(self->fds, newMaxPorts * sizeof(struct pollfd));
+        self->maxPorts = newMaxPorts;
+    }
+
+    self->ports[self->numberOfPorts] = port;
+    port->portSetIndex = self->numberOfPorts;
+    self->fds[self->numberOfPorts].fd = port->fd;
+    self->fds[self->numberOfPorts].events = POLLIN;
+    self->fds[self->numberOfPorts].revents = 0;
+
+    self->numberOfPorts++;
+}
+
+int
+SerialPortSet_waitReady(SerialPortSet self, int timeoutMs)
+{
+    int i;
+
+    for (i = 0; i < self->numberOfPorts; i++) {
+        self->fds[i].fd = self->ports[i]->fd;
+        self->fds[i].revents = 0;
+    }
+
+    return poll(self->fds, self->numberOfPorts, timeoutMs);
+}
+
+/*
+ * The position of the port is stored in the port when it is added, so that the ready check
+ * doesn't have to search the set. The set is only searched when the port has been added
+ * to another set later.
+ */
+static int
+getPortIndex(SerialPortSet self, SerialPort port)
+{
+    int i = port->portSetIndex;
+
+    if ((i >= 0) && (i < self->numberOfPorts) && (self->ports[i] == port))
+        return i;
+
+    for (i = 0; i < self->numberOfPorts; i++) {
+        if (self->ports[i] == port)
+            return i;
+    }
+
+    return -1;
+}
+
+bool
+SerialPortSet_isReady(SerialPortSet self, SerialPort port)
+{
+    int i = getPortIndex(self, port);
+
+    if (i != -1)
+        return ((self->fds[i].revents & (POLLIN | POLLERR | POLLHUP)) != 0);
+
+    return false;
+}
+
+void
+SerialPortSet_destroy(SerialPortSet self)
+{
+    if (self) {
+        GLOBAL_FREEMEM(self->ports);
+        GLOBAL_FREEMEM(self->fds);
+        GLOBAL_FREEMEM(self);
+    }
 }
@@ -39,6 +39,7 @@ struct sSerialPort {
 	char parity;
 	uint8_t stopBits;
 	uint64_t lastSentTime;
+	int portSetIndex; /* position in the port set that registered the port last (-1 = none) */
 	int timeout;
 	SerialPortError lastError;
 };
@@ -54,6 +55,7 @@ SerialPort_create(const char* interfaceName, int baudRate, uint8_t dataBits, cha
 		self->dataBits = dataBits;
 		self->stopBits = stopBits;
 		self->parity = parity;
+		self->portSetIndex = -1;
 		self->lastSentTime = 0;
 		self->timeout = 100; /* 100 ms */
 		strncpy(self->interfaceName, interfaceName, 100);
@@ -215,10 +217,16 @@ SerialPort_getBaudRate(SerialPort self)
 	return self->baudRate;
 }
 
+int
+SerialPort_getBitsPerCharacter(SerialPort self)
+{
+	return 1 + self->dataBits + ((self->parity == 'N') ? 0 : 1) + self->stopBits;
+}
+
 void
 SerialPort_discardInBuffer(SerialPort self)
 {
-	PurgeComm(self->comPort, PURGE_RXCLEAR | PURGE_TXCLEAR);
+	PurgeComm(self->comPort, PURGE_RXCLEAR);
 }
 
 void
@@ -255,12 +263,59 @@ SerialPort_readByte(SerialPort self)
 		return (int) buf[0];
 }
 
+static int
+getNumberOfReceivedBytes(SerialPort self)
+{
+	DWORD errors;
+	COMSTAT comStat;
+
+	if (ClearCommError(self->comPort, &errors, &comStat))
+		return (int) comStat.cbInQue;
+	else
+		return 0;
+}
+
 int
-SerialPort_write(SerialPort self, uint8_t* buffer, int startPos, int bufSize)
+SerialPort_readBytes(SerialPort self, uint8_t* buffer, int maxSize)
 {
-	//TODO assure minimum line idle time
+	/* timeout 0 -> only return the bytes that are already received */
+	if ((self->timeout == 0) && (getNumberOfReceivedBytes(self) == 0))
+		return 0;
+
+	/* wait for the first byte with the configured timeouts */
+	int firstByte = SerialPort_readByte(self);
+
+	if (firstByte == -1)
+		return (self->lastError == SERIAL_PORT_ERROR_NONE) ? 0 : -1;
+
+	buffer[0] = (uint8_t) firstByte;
+
+	int readBytes = 1;
+
+	DWORD errors;
+	COMSTAT comStat;
+
+	/* read the bytes that are already in the driver buffer */
+	if (ClearCommError(self->comPort, &errors, &comStat) && (comStat.cbInQue > 0) && (maxSize > 1)) {
+
+		DWORD bytesToRead = comStat.cbInQue;
+
+		if (bytesToRead > (DWORD) (maxSize - 1))
+			bytesToRead = (DWORD) (maxSize - 1);
+
+		DWORD bytesRead = 0;
 
-    self->lastError = SERIAL_PORT_ERROR_NONE;
+		if (ReadFile(self->comPort, buffer + 1, bytesToRead, &bytesRead, NULL))
+			readBytes += (int) bytesRead;
+	}
+
+	return readBytes;
+}
+
+int
+SerialPort_write(SerialPort self, uint8_t* buffer, int startPos, int bufSize)
+{
+	self->lastError = SERIAL_PORT_ERROR_NONE;
 
 	DWORD numberOfBytesWritten;
 
@@ -271,13 +326,110 @@ SerialPort_write(SerialPort self, uint8_t* buffer, int startPos, int bufSize)
 	    return -1;
 	}
 
-	status = FlushFileBuffers(self->comPort);
+	/*
+	 * Don't wait for the UART to drain (FlushFileBuffers). The caller can continue while the frame
+	 * is transmitted (the transmission time is calculated by the FT 1.2 transceiver).
+	 */
+	self->lastSentTime = Hal_getTimeInMs();
 
-	if (status == false) {
-		printf("FlushFileBuffers failed!\n");
+	return (int) numberOfBytesWritten;
+}
+
+struct sSerialPortSet {
+	SerialPort* ports;
+	bool* ready;
+	int numberOfPorts;
+	int maxPorts;
+};
+
+SerialPortSet
+SerialPortSet_create(void)
+{
+	SerialPortSet self = (SerialPortSet) GLOBAL_CALLOC(1, sizeof(struct sSerialPortSet));
+
+	return self;
+}
+
+void
+SerialPortSet_addPort(SerialPortSet self, SerialPort port)
+{
+	if (self->numberOfPorts == self->maxPorts) {
+		int newMaxPorts = (self->maxPorts == 0) ? 8 : (self->maxPorts * 2);
+
+		self->ports = (SerialPort*) GLOBAL_REALLOC(self->ports, newMaxPorts * sizeof(SerialPort));
+		self->ready = (bool*) GLOBAL_REALLOC(self->ready, newMaxPorts * sizeof(bool));
+		self->maxPorts = newMaxPorts;
 	}
 
-	self->lastSentTime = Hal_getTimeInMs();
+	self->ports[self->numberOfPorts] = port;
+	port->portSetIndex = self->numberOfPorts;
+	self->ready[self->numberOfPorts] = false;
 
-	return (int) numberOfBytesWritten;
+	self->numberOfPorts++;
+}
+
+int
+SerialPortSet_waitReady(SerialPortSet self, int timeoutMs)
+{
+	/* COM ports cannot be waited for together without overlapped I/O -> check the receive queues periodically */
+	uint64_t endTime = Hal_getTimeInMs() + timeoutMs;
+
+	while (true) {
+		int readyPorts = 0;
+		int i;
+
+		for (i = 0; i < self->numberOfPorts; i++) {
+			self->ready[i] = (getNumberOfReceivedBytes(self->ports[i]) > 0);
+
+			if (self->ready[i])
+				readyPorts++;
+		}
+
+		if ((readyPorts > 0) || (Hal_getTimeInMs() >= endTime))
+			return readyPorts;
+
+		Sleep(1);
+	}
+}
+
+/*
+ * The position of the port is stored in the port when it is added, so that the ready check
+ * doesn't have to search the set. The set is only searched when the port has been added
+ * to another set later.
+ */
+static int
+getPortIndex(SerialPortSet self, SerialPort port)
+{
+	int i = port->portSetIndex;
+
+	if ((i >= 0) && (i < self->numberOfPorts) && (self->ports[i] == port))
+		return i;
+
+	for (i = 0; i < self->numberOfPorts; i++) {
+		if (self->ports[i] == port)
+			return i;
+	}
+
+	return -1;
+}
+
+bool
+SerialPortSet_isReady(SerialPortSet self, SerialPort port)
+{
+	int i = getPortIndex(self, port);
+
+	if (i != -1)
+		return self->ready[i];
+
+	return false;
+}
+
+void
+SerialPortSet_destroy(SerialPortSet self)
+{
+	if (self) {
+		GLOBAL_FREEMEM(self->ports);
+		GLOBAL_FREEMEM(self->ready);
+		GLOBAL_FREEMEM(self);
+	}
 }
@@ -29,6 +29,7 @@
 #include <netdb.h>
 #include <errno.h>
 #include <stdio.h>
+#include <poll.h>
 
 #include <fcntl.h>
 
@@ -43,27 +44,39 @@
 
 struct sSocket {
     int fd;
+    int handleSetIndex; /* position in the handle set that registered the socket last (-1 = none) */
     uint32_t connectTimeout;
+    bool hasOptions;
+    struct sSocketOptions options;
 };
 
 struct sServerSocket {
     int fd;
+    int handleSetIndex; /* same position as in sSocket (a server socket can be added to a handle set) */
     int backLog;
 };
 
+/*
+ * The handle set is backed by poll(): sockets stay registered until they are removed
+ * or the set is reset and there is no limit for the descriptor values (FD_SETSIZE).
+ */
 struct sHandleSet {
-   fd_set handles;
-   int maxHandle;
+   struct pollfd* fds;
+   int nfds; /* number of registered sockets */
+   int maxFds; /* allocated size of fds */
 };
 
+#define HANDLESET_INITIAL_SIZE 8
+
 HandleSet
 Handleset_new(void)
 {
    HandleSet result = (HandleSet) GLOBAL_MALLOC(sizeof(struct sHandleSet));
 
    if (result != NULL) {
-       FD_ZERO(&result->handles);
-       result->maxHandle = -1;
+       result->fds = NULL;
+       result->nfds = 0;
+       result->maxFds = 0;
    }
    return result;
 }
@@ -71,33 +84,95 @@ Handleset_new(void)
 void
 Handleset_reset(HandleSet self)
 {
-    FD_ZERO(&self->handles);
-    self->maxHandle = -1;
+    self->nfds = 0;
 }
 
+/*
+ * The position of a socket is stored in the socket when it is added, so that the ready
+ * check doesn't have to search the set. The stored position can be outdated (another
+ * socket has been moved there by Handleset_removeSocket, or the socket is registered in
+ * more than one set). Then the set is searched and the position is updated.
+ */
+static int
+getIndex(HandleSet self, const Socket sock)
+{
+   int i = sock->handleSetIndex;
+
+   if ((i >= 0) && (i < self->nfds) && (self->fds[i].fd == sock->fd))
+       return i;
+
+   for (i = 0; i < self->nfds; i++) {
+       if (self->fds[i].fd == sock->fd) {
+           sock->handleSetIndex = i;
+           return i;
+       }
+   }
+
+   return -1;
+}
 
 void
 Handleset_addSocket(HandleSet self, const Socket sock)
 {
    if (self != NULL && sock != NULL && sock->fd != -1) {
-       FD_SET(sock->fd, &self->handles);
-       if (sock->fd > self->maxHandle) {
-           self->maxHandle = sock->fd;
+
+       if (getIndex(self, sock) != -1)
+           return;
+
+       if (self->nfds == self->maxFds) {
+           int newSize = (self->maxFds == 0) ? HANDLESET_INITIAL_SIZE : (self->maxFds * 2);
+
+           struct pollfd* newFds = (struct pollfd*) GLOBAL_REALLOC(self->fds, newSize * sizeof(struct pollfd));
+
+           if (newFds == NULL)
+               return;
+
+           self->fds = newFds;
+           self->maxFds = newSize;
        }
+
+       self->fds[self->nfds].fd = sock->fd;
+       self->fds[self->nfds].events = POLLIN;
+       self->fds[self->nfds].revents = 0;
+       sock->handleSetIndex = self->nfds;
+       self->nfds++;
    }
 }
 
+void
+Handleset_removeSocket(HandleSet self, const Socket sock)
+{
+   if (self != NULL && sock != NULL) {
+       int index = getIndex(self, sock);
+
+       if (index != -1) {
+           sock->handleSetIndex = -1;
+           self->nfds--;
+           self->fds[index] = self->fds[self->nfds];
+       }
+   }
+}
+
+bool
+Handleset_isReady(HandleSet self, const Socket sock)
+{
+   if (self != NULL && sock != NULL) {
+       int index = getIndex(self, sock);
+
+       if (index != -1)
+           return ((self->fds[index].revents & (POLLIN | POLLHUP | POLLERR)) != 0);
+   }
+
+   return false;
+}
+
 int
 Handleset_waitReady(HandleSet self, unsigned int timeoutMs)
 {
    int result;
 
-   if (self != NULL && self->maxHandle >= 0) {
-       struct timeval timeout;
-
-       timeout.tv_sec = timeoutMs / 1000;
-       timeout.tv_usec = (timeoutMs % 1000) * 1000;
-       result = select(self->maxHandle + 1, &self->handles, NULL, NULL, &timeout);
+   if ((self != NULL) && (self->nfds > 0)) {
+       result = poll(self->fds, self->nfds, (int) timeoutMs);
    } else {
        result = -1;
    }
@@ -108,7 +183,12 @@ Handleset_waitReady(HandleSet self, unsigned int timeoutMs)
 void
 Handleset_destroy(HandleSet self)
 {
-   GLOBAL_FREEMEM(self);
+   if (self != NULL) {
+       if (self->fds != NULL)
+           GLOBAL_FREEMEM(self->fds);
+
+       GLOBAL_FREEMEM(self);
+   }
 }
 
 #if (CONFIG_ACTIVATE_TCP_KEEPALIVE == 1)
@@ -166,6 +246,66 @@ setSocketNonBlocking(Socket self)
     fcntl(self->fd, F_SETFL, flags | O_NONBLOCK);
 }
 
+void
+SocketOptions_init(SocketOptions self)
+{
+    self->sendBufferSize = 0;
+    self->receiveBufferSize = 0;
+    self->noDelay = true;
+    self->userTimeout = 0;
+    self->busyPollTime = 0;
+    self->corkBatches = false;
+}
+
+/* TCP_USER_TIMEOUT and SO_BUSY_POLL are not supported */
+static bool
+applySocketOptions(Socket self)
+{
+    SocketOptions options = &(self->options);
+    bool success = true;
+    int optval;
+
+    optval = options->noDelay ? 1 : 0;
+    if (setsockopt(self->fd, IPPROTO_TCP, TCP_NODELAY, &optval, sizeof(optval)) < 0)
+        success = false;
+
+    if (options->sendBufferSize > 0) {
+        optval = options->sendBufferSize;
+        if (setsockopt(self->fd, SOL_SOCKET, SO_SNDBUF, &optval, sizeof(optval)) < 0)
+            success = false;
+    }
+
+    if (options->receiveBufferSize > 0) {
+        optval = options->receiveBufferSize;
+        if (setsockopt(self->fd, SOL_SOCKET, SO_RCVBUF, &optval, sizeof(optval)) < 0)
+            success = false;
+    }
+
+    return success;
+}
+
+bool
+Socket_setOptions(Socket self, SocketOptions options)
+{
+    self->options = *options;
+    self->hasOptions = true;
+
+    if (self->fd != -1)
+        return applySocketOptions(self);
+    else
+        return true;
+}
+
+void
+Socket_setCork(Socket self, bool cork)
+{
+#if defined(TCP_NOPUSH)
+    int optval = cork ? 1 : 0;
+
+    setsockopt(self->fd, IPPROTO_TCP, TCP_NOPUSH, &optval, sizeof(optval));
+#endif
+}
+
 ServerSocket
 TcpServerSocket_create(const char* address, int port)
 {
@@ -188,6 +328,7 @@ TcpServerSocket_create(const char* address, int port)
             serverSocket = GLOBAL_MALLOC(sizeof(struct sServerSocket));
             serverSocket->fd = fd;
             serverSocket->backLog = 2;
+            serverSocket->handleSetIndex = -1;
         }
         else {
             close(fd);
@@ -222,6 +363,9 @@ ServerSocket_accept(ServerSocket self)
     if (fd >= 0) {
         conSocket = TcpSocket_create();
         conSocket->fd = fd;
+
+        /* a peer that does not read must not block the writer */
+        setSocketNonBlocking(conSocket);
     }
 
     return conSocket;
@@ -268,6 +412,9 @@ TcpSocket_create()
     Socket self = GLOBAL_MALLOC(sizeof(struct sSocket));
 
     self->fd = -1;
+    self->connectTimeout = 5000;
+    self->hasOptions = false;
+    self->handleSetIndex = -1;
 
     return self;
 }
@@ -297,9 +444,8 @@ Socket_connect(Socket self, const char* address, int port)
 		activateKeepAlive(self->fd);
 	#endif
 
-		fd_set fdSet;
-		FD_ZERO(&fdSet);
-		FD_SET(self->fd, &fdSet);
+		if (self->hasOptions)
+			applySocketOptions(self);
 
 		fcntl(self->fd, F_SETFL, O_NONBLOCK);
 
@@ -308,11 +454,12 @@ Socket_connect(Socket self, const char* address, int port)
 				return false;
 		}
 
-		struct timeval timeout;
-		timeout.tv_sec = self->connectTimeout / 1000;
-		timeout.tv_usec = (self->connectTimeout % 1000) * 1000;
+		struct pollfd pfd;
+		pfd.fd = self->fd;
+		pfd.events = POLLOUT;
+		pfd.revents = 0;
 
-		if (select(self->fd + 1, NULL, &fdSet, NULL, &timeout) == 1) {
+		if (poll(&pfd, 1, (int) self->connectTimeout) == 1) {
             int so_error;
             socklen_t len = sizeof(so_error);
 
@@ -463,3 +610,57 @@ Socket_destroy(Socket self)
 
     GLOBAL_FREEMEM(self);
 }
+
+/* io_uring is Linux only -> the caller uses the HandleSet */
+
+SocketIoRing
+SocketIoRing_create(int maxOperations)
+{
+    return NULL;
+}
+
+bool
+SocketIoRing_registerBuffer(SocketIoRing self, uint8_t* buf, int size)
+{
+    return false;
+}
+
+bool
+SocketIoRing_prepareReceive(SocketIoRing self, Socket sock, uint8_t* buf, int size, void* userData)
+{
+    return false;
+}
+
+bool
+SocketIoRing_prepareSend(SocketIoRing self, Socket sock, uint8_t* buf, int size, void* userData)
+{
+    return false;
+}
+
+void
+SocketIoRing_cancel(SocketIoRing self, void* userData)
+{
+}
+
+bool
+SocketIoRing_submit(SocketIoRing self)
+{
+    return false;
+}
+
+bool
+SocketIoRing_submitAndWait(SocketIoRing self, unsigned int timeoutMs)
+{
+    return false;
+}
+
+bool
+SocketIoRing_getCompletion(SocketIoRing self, void** userData, int* result, bool* isSend)
+{
+    return false;
+}
+
+void
+SocketIoRing_destroy(SocketIoRing self)
+{
+}
@@ -23,7 +23,7 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <netdb.h>
-#include <sys/select.h>
+#include <poll.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <string.h>
@@ -42,27 +42,39 @@
 
 struct sSocket {
     int fd;
+    int handleSetIndex; /* position in the handle set that registered the socket last (-1 = none) */
     uint32_t connectTimeout;
+    bool hasOptions;
+    struct sSocketOptions options;
 };
 
 struct sServerSocket {
     int fd;
+    int handleSetIndex; /* same position as in sSocket (a server socket can be added to a handle set) */
     int backLog;
 };
 
+/*
+ * The handle set is backed by poll(): sockets stay registered until they are removed
+ * or the set is reset and there is no limit for the descriptor values (FD_SETSIZE).
+ */
 struct sHandleSet {
-   fd_set handles;
-   int maxHandle;
+   struct pollfd* fds;
+   int nfds; /* number of registered sockets */
+   int maxFds; /* allocated size of fds */
 };
 
+#define HANDLESET_INITIAL_SIZE 8
+
 HandleSet
 Handleset_new(void)
 {
    HandleSet result = (HandleSet) GLOBAL_MALLOC(sizeof(struct sHandleSet));
 
    if (result != NULL) {
-       FD_ZERO(&result->handles);
-       result->maxHandle = -1;
+       result->fds = NULL;
+       result->nfds = 0;
+       result->maxFds = 0;
    }
    return result;
 }
@@ -70,32 +82,95 @@ Handleset_new(void)
 void
 Handleset_reset(HandleSet self)
 {
-    FD_ZERO(&self->handles);
-    self->maxHandle = -1;
+    self->nfds = 0;
+}
+
+/*
+ * The position of a socket is stored in the socket when it is added, so that the ready
+ * check doesn't have to search the set. The stored position can be outdated (another
+ * socket has been moved there by Handleset_removeSocket, or the socket is registered in
+ * more than one set). Then the set is searched and the position is updated.
+ */
+static int
+getIndex(HandleSet self, const Socket sock)
+{
+   int i = sock->handleSetIndex;
+
+   if ((i >= 0) && (i < self->nfds) && (self->fds[i].fd == sock->fd))
+       return i;
+
+   for (i = 0; i < self->nfds; i++) {
+       if (self->fds[i].fd == sock->fd) {
+           sock->handleSetIndex = i;
+           return i;
+       }
+   }
+
+   return -1;
 }
 
 void
 Handleset_addSocket(HandleSet self, const Socket sock)
 {
    if (self != NULL && sock != NULL && sock->fd != -1) {
-       FD_SET(sock->fd, &self->handles);
-       if (sock->fd > self->maxHandle) {
-           self->maxHandle = sock->fd;
+
+       if (getIndex(self, sock) != -1)
+           return;
+
+       if (self->nfds == self->maxFds) {
+           int newSize = (self->maxFds == 0) ? HANDLESET_INITIAL_SIZE : (self->maxFds * 2);
+
+           struct pollfd* newFds = (struct pollfd*) GLOBAL_REALLOC(self->fds, newSize * sizeof(struct pollfd));
+
+           if (newFds == NULL)
+               return;
+
+           self->fds = newFds;
+           self->maxFds = newSize;
        }
+
+       self->fds[self->nfds].fd = sock->fd;
+       self->fds[self->nfds].events = POLLIN;
+       self->fds[self->nfds].revents = 0;
+       sock->handleSetIndex = self->nfds;
+       self->nfds++;
    }
 }
 
+void
+Handleset_removeSocket(HandleSet self, const Socket sock)
+{
+   if (self != NULL && sock != NULL) {
+       int index = getIndex(self, sock);
+
+       if (index != -1) {
+           sock->handleSetIndex = -1;
+           self->nfds--;
+           self->fds[index] = self->fds[self->nfds];
+       }
+   }
+}
+
+bool
+Handleset_isReady(HandleSet self, const Socket sock)
+{
+   if (self != NULL && sock != NULL) {
+       int index = getIndex(self, sock);
+
+       if (index != -1)
+           return ((self->fds[index].revents & (POLLIN | POLLHUP | POLLERR)) != 0);
+   }
+
+   return false;
+}
+
 int
 Handleset_waitReady(HandleSet self, unsigned int timeoutMs)
 {
    int result;
 
-   if ((self != NULL) && (self->maxHandle >= 0)) {
-       struct timeval timeout;
-
-       timeout.tv_sec = timeoutMs / 1000;
-       timeout.tv_usec = (timeoutMs % 1000) * 1000;
-       result = select(self->maxHandle + 1, &self->handles, NULL, NULL, &timeout);
+   if ((self != NULL) && (self->nfds > 0)) {
+       result = poll(self->fds, self->nfds, (int) timeoutMs);
    } else {
        result = -1;
    }
@@ -106,7 +181,12 @@ Handleset_waitReady(HandleSet self, unsigned int timeoutMs)
 void
 Handleset_destroy(HandleSet self)
 {
-   GLOBAL_FREEMEM(self);
+   if (self != NULL) {
+       if (self->fds != NULL)
+           GLOBAL_FREEMEM(self->fds);
+
+       GLOBAL_FREEMEM(self);
+   }
 }
 
 void
@@ -195,6 +275,84 @@ activateTcpNoDelay(Socket self)
     setsockopt(self->fd, IPPROTO_TCP, TCP_NODELAY, (char *) &flag, sizeof(int));
 }
 
+void
+SocketOptions_init(SocketOptions self)
+{
+    self->sendBufferSize = 0;
+    self->receiveBufferSize = 0;
+    self->noDelay = true;
+    self->userTimeout = 0;
+    self->busyPollTime = 0;
+    self->corkBatches = false;
+}
+
+static bool
+applySocketOptions(Socket self)
+{
+    SocketOptions options = &(self->options);
+    bool success = true;
+    int optval;
+
+    optval = options->noDelay ? 1 : 0;
+    if (setsockopt(self->fd, IPPROTO_TCP, TCP_NODELAY, &optval, sizeof(optval)) < 0)
+        success = false;
+
+    if (options->sendBufferSize > 0) {
+        optval = options->sendBufferSize;
+        if (setsockopt(self->fd, SOL_SOCKET, SO_SNDBUF, &optval, sizeof(optval)) < 0)
+            success = false;
+    }
+
+    if (options->receiveBufferSize > 0) {
+        optval = options->receiveBufferSize;
+        if (setsockopt(self->fd, SOL_SOCKET, SO_RCVBUF, &optval, sizeof(optval)) < 0)
+            success = false;
+    }
+
+#if defined(TCP_USER_TIMEOUT)
+    if (options->userTimeout > 0) {
+        optval = options->userTimeout;
+        if (setsockopt(self->fd, IPPROTO_TCP, TCP_USER_TIMEOUT, &optval, sizeof(optval)) < 0)
+            success = false;
+    }
+#endif
+
+#if defined(SO_BUSY_POLL)
+    if (options->busyPollTime > 0) {
+        optval = options->busyPollTime;
+        if (setsockopt(self->fd, SOL_SOCKET, SO_BUSY_POLL, &optval, sizeof(optval)) < 0)
+            success = false;
+    }
+#endif
+
+    if ((success == false) && DEBUG_SOCKET)
+        printf("SOCKET: failed to apply socket options (errno: %i)\n", errno);
+
+    return success;
+}
+
+bool
+Socket_setOptions(Socket self, SocketOptions options)
+{
+    self->options = *options;
+    self->hasOptions = true;
+
+    if (self->fd != -1)
+        return applySocketOptions(self);
+    else
+        return true;
+}
+
+void
+Socket_setCork(Socket self, bool cork)
+{
+#if defined(TCP_CORK)
+    int optval = cork ? 1 : 0;
+
+    setsockopt(self->fd, IPPROTO_TCP, TCP_CORK, &optval, sizeof(optval));
+#endif
+}
+
 ServerSocket
 TcpServerSocket_create(const char* address, int port)
 {
@@ -229,6 +387,7 @@ TcpServerSocket_create(const char* address, int port)
             serverSocket = (ServerSocket) GLOBAL_MALLOC(sizeof(struct sServerSocket));
             serverSocket->fd = fd;
             serverSocket->backLog = 2;
+            serverSocket->handleSetIndex = -1;
 
             setSocketNonBlocking((Socket) serverSocket);
         }
@@ -261,6 +420,9 @@ ServerSocket_accept(ServerSocket self)
         conSocket = TcpSocket_create();
         conSocket->fd = fd;
 
+        /* a peer that does not read must not block the writer */
+        setSocketNonBlocking(conSocket);
+
         activateTcpNoDelay(conSocket);
     }
 
@@ -319,6 +481,8 @@ TcpSocket_create()
 
     self->fd = -1;
     self->connectTimeout = 5000;
+    self->hasOptions = false;
+    self->handleSetIndex = -1;
 
     return self;
 }
@@ -344,11 +508,10 @@ Socket_connect(Socket self, const char* address, int port)
     self->fd = socket(AF_INET, SOCK_STREAM, 0);
 
     if (self->fd != -1) {
-        fd_set fdSet;
-        FD_ZERO(&fdSet);
-        FD_SET(self->fd, &fdSet);
-
-        activateTcpNoDelay(self);
+        if (self->hasOptions)
+            applySocketOptions(self);
+        else
+            activateTcpNoDelay(self);
 
     #if (CONFIG_ACTIVATE_TCP_KEEPALIVE == 1)
         activateKeepAlive(self->fd);
@@ -361,11 +524,12 @@ Socket_connect(Socket self, const char* address, int port)
                 return false;
         }
 
-        struct timeval timeout;
-        timeout.tv_sec = self->connectTimeout / 1000;
-        timeout.tv_usec = (self->connectTimeout % 1000) * 1000;
+        struct pollfd pfd;
+        pfd.fd = self->fd;
+        pfd.events = POLLOUT;
+        pfd.revents = 0;
 
-        if (select(self->fd + 1, NULL, &fdSet , NULL, &timeout) == 1) {
+        if (poll(&pfd, 1, (int) self->connectTimeout) == 1) {
             int so_error;
             socklen_t len = sizeof(so_error);
 
@@ -537,3 +701,611 @@ Socket_destroy(Socket self)
 
     GLOBAL_FREEMEM(self);
 }
+
+/*
+ * The socket ring uses io_uring with the raw system calls (no liburing). It requires
+ * IORING_FEAT_EXT_ARG (Linux 5.11) for the wait timeout. With older kernels, kernels
+ * without io_uring or when io_uring is not permitted SocketIoRing_create returns NULL
+ * and the caller uses the HandleSet.
+ */
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define SOCKET_IO_RING_SUPPORTED 1
+#endif
+#endif
+
+#if defined(SOCKET_IO_RING_SUPPORTED)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#endif
+
+#if defined(SOCKET_IO_RING_SUPPORTED) && defined(__NR_io_uring_setup) && defined(IORING_FEAT_EXT_ARG)
+
+#define SOCKET_IO_RING_POLL_FLAG ((uint64_t) 1 << 32)
+
+/* maximum time (in 10 ms steps) SocketIoRing_destroy waits for the canceled operations */
+#define SOCKET_IO_RING_DESTROY_WAIT_CYCLES 100
+
+struct sSocketIoRingOperation {
+    void* userData; /* NULL when the operation is not used */
+    int fd;
+    uint8_t* buf;
+    int size;
+    bool isSend;
+    bool isFixed; /* the buffer is part of the registered buffer */
+    bool isCanceled;
+    bool pollFirst; /* wait for data with a linked poll operation (used after -EAGAIN) */
+};
+
+struct sSocketIoRing {
+    int ringFd;
+
+    /* submission queue */
+    unsigned int* sqHead;
+    unsigned int* sqTail;
+    unsigned int sqMask;
+    unsigned int sqEntries;
+    unsigned int* sqArray;
+    struct io_uring_sqe* sqes;
+    unsigned int queuedEntries; /* entries that are not yet submitted */
+
+    /* completion queue */
+    unsigned int* cqHead;
+    unsigned int* cqTail;
+    unsigned int cqMask;
+    struct io_uring_cqe* cqes;
+
+    void* sqRing;
+    size_t sqRingSize;
+    void* cqRing;
+    size_t cqRingSize;
+    size_t sqesSize;
+
+    /* the user data of the receive and send operations is the index + 1, the linked poll operations
+     * additionally have SOCKET_IO_RING_POLL_FLAG set (0 is used for the cancel operations) */
+    struct sSocketIoRingOperation* operations;
+    int maxOperations;
+    int pendingOperations;
+
+    /* registered buffer (buffer index 0) */
+    uint8_t* fixedBuffer;
+    int fixedBufferSize;
+    bool fixedSendSupported; /* false when the kernel doesn't support registered buffers for send */
+};
+
+SocketIoRing
+SocketIoRing_create(int maxOperations)
+{
+    struct io_uring_params params;
+
+    memset(&params, 0, sizeof(params));
+
+    /* each operation can require a poll, a receive (or send) and a cancel entry */
+    int ringFd = (int) syscall(__NR_io_uring_setup, (unsigned int) (maxOperations * 3), &params);
+
+    if (ringFd < 0) {
+        if (DEBUG_SOCKET)
+            printf("socket_linux.c: io_uring not available (%i)\n", errno);
+
+        return NULL;
+    }
+
+    if ((params.features & IORING_FEAT_EXT_ARG) == 0) {
+        close(ringFd);
+        return NULL;
+    }
+
+    SocketIoRing self = (SocketIoRing) GLOBAL_CALLOC(1, sizeof(struct sSocketIoRing));
+
+    if (self == NULL) {
+        close(ringFd);
+        return NULL;
+    }
+
+    self->ringFd = ringFd;
+
+    self->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    self->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    self->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (self->cqRingSize > self->sqRingSize)
+            self->sqRingSize = self->cqRingSize;
+
+        self->cqRingSize = self->sqRingSize;
+    }
+
+    self->sqRing = mmap(NULL, self->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+
+    if (self->sqRing == MAP_FAILED)
+        goto exit_error;
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        self->cqRing = self->sqRing;
+    else {
+        self->cqRing = mmap(NULL, self->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+
+        if (self->cqRing == MAP_FAILED) {
+            self->cqRing = NULL;
+            goto exit_error;
+        }
+    }
+
+    self->sqes = (struct io_uring_sqe*) mmap(NULL, self->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+
+    if (self->sqes == MAP_FAILED) {
+        self->sqes = NULL;
+        goto exit_error;
+    }
+
+    uint8_t* sqRing = (uint8_t*) self->sqRing;
+
+    self->sqHead = (unsigned int*) (sqRing + params.sq_off.head);
+    self->sqTail = (unsigned int*) (sqRing + params.sq_off.tail);
+    self->sqMask = *((unsigned int*) (sqRing + params.sq_off.ring_mask));
+    self->sqEntries = params.sq_entries;
+    self->sqArray = (unsigned int*) (sqRing + params.sq_off.array);
+
+    uint8_t* cqRing = (uint8_t*) self->cqRing;
+
+    self->cqHead = (unsigned int*) (cqRing + params.cq_off.head);
+    self->cqTail = (unsigned int*) (cqRing + params.cq_off.tail);
+    self->cqMask = *((unsigned int*) (cqRing + params.cq_off.ring_mask));
+    self->cqes = (struct io_uring_cqe*) (cqRing + params.cq_off.cqes);
+
+    self->maxOperations = maxOperations;
+    self->operations = (struct sSocketIoRingOperation*) GLOBAL_CALLOC(maxOperations, sizeof(struct sSocketIoRingOperation));
+
+    if (self->operations == NULL)
+        goto exit_error;
+
+    return self;
+
+exit_error:
+    if (self->sqes)
+        munmap(self->sqes, self->sqesSize);
+
+    if (self->cqRing && (self->cqRing != self->sqRing))
+        munmap(self->cqRing, self->cqRingSize);
+
+    if (self->sqRing && (self->sqRing != MAP_FAILED))
+        munmap(self->sqRing, self->sqRingSize);
+
+    close(ringFd);
+
+    GLOBAL_FREEMEM(self);
+
+    return NULL;
+}
+
+/* get the next free submission queue entry (NULL when the queue is full) */
+static struct io_uring_sqe*
+getSubmissionEntry(SocketIoRing self)
+{
+    unsigned int tail = *(self->sqTail);
+    unsigned int head = __atomic_load_n(self->sqHead, __ATOMIC_ACQUIRE);
+
+    if ((tail - head) >= self->sqEntries)
+        return NULL;
+
+    unsigned int index = tail & self->sqMask;
+
+    struct io_uring_sqe* sqe = &(self->sqes[index]);
+
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+
+    self->sqArray[index] = index;
+
+    __atomic_store_n(self->sqTail, tail + 1, __ATOMIC_RELEASE);
+
+    self->queuedEntries++;
+
+    return sqe;
+}
+
+bool
+SocketIoRing_registerBuffer(SocketIoRing self, uint8_t* buf, int size)
+{
+    struct iovec iov;
+
+    if (self->fixedBuffer)
+        return false;
+
+    iov.iov_base = buf;
+    iov.iov_len = (size_t) size;
+
+    if (syscall(__NR_io_uring_register, self->ringFd, IORING_REGISTER_BUFFERS, &iov, 1) < 0) {
+        if (DEBUG_SOCKET)
+            printf("socket_linux.c: failed to register buffer (%i)\n", errno);
+
+        return false;
+    }
+
+    self->fixedBuffer = buf;
+    self->fixedBufferSize = size;
+#if defined(IORING_RECVSEND_FIXED_BUF)
+    self->fixedSendSupported = true;
+#endif
+
+    return true;
+}
+
+static bool
+isInFixedBuffer(SocketIoRing self, uint8_t* buf, int size)
+{
+    if (self->fixedBuffer == NULL)
+        return false;
+
+    return ((buf >= self->fixedBuffer) && ((buf + size) <= (self->fixedBuffer + self->fixedBufferSize)));
+}
+
+static bool
+queueOperation(SocketIoRing self, int operationIndex)
+{
+    struct sSocketIoRingOperation* operation = &(self->operations[operationIndex]);
+
+    /* an operation with a linked poll requires two entries */
+    unsigned int requiredEntries = operation->pollFirst ? 2 : 1;
+
+    unsigned int usedEntries = *(self->sqTail) - __atomic_load_n(self->sqHead, __ATOMIC_ACQUIRE);
+
+    if ((self->sqEntries - usedEntries) < requiredEntries)
+        return false;
+
+    struct io_uring_sqe* sqe;
+
+    if (operation->pollFirst) {
+        sqe = getSubmissionEntry(self);
+
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = operation->fd;
+        sqe->poll_events = POLLIN;
+        sqe->flags = IOSQE_IO_LINK;
+        sqe->user_data = (uint64_t) (operationIndex + 1) | SOCKET_IO_RING_POLL_FLAG;
+    }
+
+    sqe = getSubmissionEntry(self);
+
+    if (operation->isSend) {
+        sqe->opcode = IORING_OP_SEND;
+
+        /* prevent SIGPIPE when the peer closed the socket */
+        sqe->msg_flags = MSG_NOSIGNAL;
+
+#if defined(IORING_RECVSEND_FIXED_BUF)
+        if (operation->isFixed) {
+            sqe->ioprio = IORING_RECVSEND_FIXED_BUF;
+            sqe->buf_index = 0;
+        }
+#endif
+    }
+    else if (operation->isFixed) {
+        /* read from the stream socket (no file offset) into the registered buffer */
+        sqe->opcode = IORING_OP_READ_FIXED;
+        sqe->off = 0;
+        sqe->buf_index = 0;
+    }
+    else {
+        sqe->opcode = IORING_OP_RECV;
+        sqe->msg_flags = 0;
+    }
+
+    sqe->fd = operation->fd;
+    sqe->addr = (uint64_t) (uintptr_t) operation->buf;
+    sqe->len = (uint32_t) operation->size;
+    sqe->user_data = (uint64_t) (operationIndex + 1);
+
+    return true;
+}
+
+static bool
+prepareOperation(SocketIoRing self, Socket sock, uint8_t* buf, int size, void* userData, bool isSend)
+{
+    int i;
+
+    for (i = 0; i < self->maxOperations; i++) {
+        struct sSocketIoRingOperation* operation = &(self->operations[i]);
+
+        if (operation->userData == NULL) {
+            operation->fd = sock->fd;
+            operation->buf = buf;
+            operation->size = size;
+            operation->isSend = isSend;
+            operation->isCanceled = false;
+            operation->pollFirst = false;
+
+            if (isSend)
+                operation->isFixed = self->fixedSendSupported && isInFixedBuffer(self, buf, size);
+            else
+                operation->isFixed = isInFixedBuffer(self, buf, size);
+
+            if (queueOperation(self, i) == false)
+                return false;
+
+            operation->userData = userData;
+            self->pendingOperations++;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool
+SocketIoRing_prepareReceive(SocketIoRing self, Socket sock, uint8_t* buf, int size, void* userData)
+{
+    return prepareOperation(self, sock, buf, size, userData, false);
+}
+
+bool
+SocketIoRing_prepareSend(SocketIoRing self, Socket sock, uint8_t* buf, int size, void* userData)
+{
+    return prepareOperation(self, sock, buf, size, userData, true);
+}
+
+static void
+queueCancel(SocketIoRing self, uint64_t operationId)
+{
+    struct io_uring_sqe* sqe = getSubmissionEntry(self);
+
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = operationId;
+    sqe->user_data = 0;
+}
+
+static void
+cancelOperation(SocketIoRing self, int operationIndex)
+{
+    struct sSocketIoRingOperation* operation = &(self->operations[operationIndex]);
+
+    if (operation->isCanceled == false) {
+
+        /* the receive can wait for a linked poll operation that has to be canceled too */
+        unsigned int requiredEntries = operation->pollFirst ? 2 : 1;
+
+        unsigned int usedEntries = *(self->sqTail) - __atomic_load_n(self->sqHead, __ATOMIC_ACQUIRE);
+
+        if ((self->sqEntries - usedEntries) >= requiredEntries) {
+            operation->isCanceled = true;
+
+            if (operation->pollFirst)
+                queueCancel(self, (uint64_t) (operationIndex + 1) | SOCKET_IO_RING_POLL_FLAG);
+
+            queueCancel(self, (uint64_t) (operationIndex + 1));
+        }
+    }
+}
+
+void
+SocketIoRing_cancel(SocketIoRing self, void* userData)
+{
+    int i;
+
+    for (i = 0; i < self->maxOperations; i++) {
+        if (self->operations[i].userData == userData)
+            cancelOperation(self, i);
+    }
+}
+
+bool
+SocketIoRing_submit(SocketIoRing self)
+{
+    if (self->queuedEntries == 0)
+        return true;
+
+    int result = (int) syscall(__NR_io_uring_enter, self->ringFd, self->queuedEntries, 0, 0, NULL, 0);
+
+    if (result >= 0) {
+        self->queuedEntries -= (unsigned int) result;
+        return true;
+    }
+
+    if ((errno == EINTR) || (errno == EBUSY) || (errno == EAGAIN))
+        return true;
+
+    if (DEBUG_SOCKET)
+        printf("socket_linux.c: io_uring_enter error: %i\n", errno);
+
+    return false;
+}
+
+bool
+SocketIoRing_submitAndWait(SocketIoRing self, unsigned int timeoutMs)
+{
+    struct __kernel_timespec timeout;
+
+    timeout.tv_sec = timeoutMs / 1000;
+    timeout.tv_nsec = (timeoutMs % 1000) * 1000000;
+
+    struct io_uring_getevents_arg arg;
+
+    memset(&arg, 0, sizeof(arg));
+    arg.ts = (uint64_t) (uintptr_t) &timeout;
+
+    int result = (int) syscall(__NR_io_uring_enter, self->ringFd, self->queuedEntries, 1,
+            IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+
+    if (result >= 0) {
+        self->queuedEntries -= (unsigned int) result;
+        return true;
+    }
+
+    /* timeout, signal, or the completion queue has to be emptied first */
+    if ((errno == ETIME) || (errno == EINTR) || (errno == EBUSY) || (errno == EAGAIN))
+        return true;
+
+    if (DEBUG_SOCKET)
+        printf("socket_linux.c: io_uring_enter error: %i\n", errno);
+
+    return false;
+}
+
+bool
+SocketIoRing_getCompletion(SocketIoRing self, void** userData, int* result, bool* isSend)
+{
+    while (true) {
+        unsigned int head = *(self->cqHead);
+        unsigned int tail = __atomic_load_n(self->cqTail, __ATOMIC_ACQUIRE);
+
+        if (head == tail)
+            return false;
+
+        struct io_uring_cqe* cqe = &(self->cqes[head & self->cqMask]);
+
+        uint64_t operationId = cqe->user_data;
+        int res = cqe->res;
+
+        __atomic_store_n(self->cqHead, head + 1, __ATOMIC_RELEASE);
+
+        /* poll and cancel operations */
+        if ((operationId == 0) || (operationId > (uint64_t) self->maxOperations))
+            continue;
+
+        int operationIndex = (int) (operationId - 1);
+
+        struct sSocketIoRingOperation* operation = &(self->operations[operationIndex]);
+
+        if (operation->isCanceled == false) {
+
+            if (operation->isSend) {
+                /* the kernel doesn't support registered buffers for send -> use the buffer address */
+                if ((res == -EINVAL) && operation->isFixed) {
+                    self->fixedSendSupported = false;
+                    operation->isFixed = false;
+
+                    if (queueOperation(self, operationIndex))
+                        continue;
+                }
+
+                /* the socket buffer is full -> nothing sent, the caller sends the data again later */
+                if (res == -EAGAIN)
+                    res = 0;
+            }
+            /* the socket is non-blocking -> wait for data with a linked poll operation */
+            else if ((res == -EAGAIN) || ((res == -ECANCELED) && operation->pollFirst)) {
+                operation->pollFirst = true;
+
+                if (queueOperation(self, operationIndex))
+                    continue;
+            }
+        }
+
+        *userData = operation->userData;
+        *isSend = operation->isSend;
+
+        if (res < 0)
+            *result = -1;
+        else
+            *result = res;
+
+        operation->userData = NULL;
+        self->pendingOperations--;
+
+        return true;
+    }
+}
+
+void
+SocketIoRing_destroy(SocketIoRing self)
+{
+    if (self) {
+        int i;
+
+        int waitCycles = 0;
+
+        /*
+         * Wait until the kernel doesn't use the buffers anymore. Operations that are still pending
+         * after the maximum wait time are canceled by the kernel when the ring is closed.
+         */
+        while ((self->pendingOperations > 0) && (waitCycles < SOCKET_IO_RING_DESTROY_WAIT_CYCLES)) {
+            waitCycles++;
+
+            void* userData;
+            int result;
+            bool isSend;
+
+            /* cancel operations that didn't fit into the submission queue before */
+            for (i = 0; i < self->maxOperations; i++) {
+                if (self->operations[i].userData)
+                    cancelOperation(self, i);
+            }
+
+            if (SocketIoRing_submitAndWait(self, 10) == false)
+                break;
+
+            while (SocketIoRing_getCompletion(self, &userData, &result, &isSend));
+        }
+
+        munmap(self->sqes, self->sqesSize);
+
+        if (self->cqRing != self->sqRing)
+            munmap(self->cqRing, self->cqRingSize);
+
+        munmap(self->sqRing, self->sqRingSize);
+
+        close(self->ringFd);
+
+        GLOBAL_FREEMEM(self->operations);
+        GLOBAL_FREEMEM(self);
+    }
+}
+
+#else
+
+SocketIoRing
+SocketIoRing_create(int maxOperations)
+{
+    return NULL;
+}
+
+bool
+SocketIoRing_registerBuffer(SocketIoRing self, uint8_t* buf, int size)
+{
+    return false;
+}
+
+bool
+SocketIoRing_prepareReceive(SocketIoRing self, Socket sock, uint8_t* buf, int size, void* userData)
+{
+    return false;
+}
+
+bool
+SocketIoRing_prepareSend(SocketIoRing self, Socket sock, uint8_t* buf, int size, void* userData)
+{
+    return false;
+}
+
+void
+SocketIoRing_cancel(SocketIoRing self, void* userData)
+{
+}
+
+bool
+SocketIoRing_submit(SocketIoRing self)
+{
+    return false;
+}
+
+bool
+SocketIoRing_submitAndWait(SocketIoRing self, unsigned int timeoutMs)
+{
+    return false;
+}
+
+bool
+SocketIoRing_getCompletion(SocketIoRing self, void** userData, int* result, bool* isSend)
+{
+    return false;
+}
+
+void
+SocketIoRing_destroy(SocketIoRing self)
+{
+}
+
+#endif /* defined(SOCKET_IO_RING_SUPPORTED) && defined(__NR_io_uring_setup) && defined(IORING_FEAT_EXT_ARG) */
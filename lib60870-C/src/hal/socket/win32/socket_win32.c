@@ -46,17 +46,25 @@ struct tcp_keepalive {
 
 struct sSocket {
 	SOCKET fd;
+	int handleSetIndex; /* position in the handle set that registered the socket last (-1 = none) */
 	uint32_t connectTimeout;
 };
 
 struct sServerSocket {
 	SOCKET fd;
+	int handleSetIndex; /* same position as in sSocket (a server socket can be added to a handle set) */
 	int backLog;
 };
 
+/*
+ * Windows fd_sets are arrays of sockets (not bitmaps). Registered sockets are kept in "handles".
+ * The ready state of handles.fd_array[i] is stored in isReady[i] by Handleset_waitReady, so that
+ * the ready check doesn't have to search the result of select.
+ */
 struct sHandleSet {
    fd_set handles;
-   SOCKET maxHandle;
+   fd_set readyHandles; /* result of the last call of Handleset_waitReady */
+   bool isReady[FD_SETSIZE];
 };
 
 HandleSet
@@ -66,7 +74,7 @@ Handleset_new(void)
 
    if (result != NULL) {
        FD_ZERO(&result->handles);
-       result->maxHandle = INVALID_SOCKET;
+       FD_ZERO(&result->readyHandles);
    }
    return result;
 }
@@ -75,18 +83,75 @@ void
 Handleset_reset(HandleSet self)
 {
     FD_ZERO(&self->handles);
-    self->maxHandle = INVALID_SOCKET;
+    FD_ZERO(&self->readyHandles);
+}
+
+/*
+ * The position of a socket is stored in the socket when it is added. The stored position can
+ * be outdated (another socket has been moved there by Handleset_removeSocket, or the socket is
+ * registered in more than one set). Then the set is searched and the position is updated.
+ */
+static int
+getIndex(HandleSet self, const Socket sock)
+{
+   int i = sock->handleSetIndex;
+
+   if ((i >= 0) && (i < (int) self->handles.fd_count) && (self->handles.fd_array[i] == sock->fd))
+       return i;
+
+   for (i = 0; i < (int) self->handles.fd_count; i++) {
+       if (self->handles.fd_array[i] == sock->fd) {
+           sock->handleSetIndex = i;
+           return i;
+       }
+   }
+
+   return -1;
 }
 
 void
 Handleset_addSocket(HandleSet self, const Socket sock)
 {
    if (self != NULL && sock != NULL && sock->fd != INVALID_SOCKET) {
-       FD_SET(sock->fd, &self->handles);
 
-       if ((sock->fd > self->maxHandle) || (self->maxHandle == INVALID_SOCKET))
-           self->maxHandle = sock->fd;
+       if (getIndex(self, sock) != -1)
+           return;
+
+       if (self->handles.fd_count < FD_SETSIZE) {
+           self->handles.fd_array[self->handles.fd_count] = sock->fd;
+           self->isReady[self->handles.fd_count] = false;
+           sock->handleSetIndex = (int) self->handles.fd_count;
+           self->handles.fd_count++;
+       }
+   }
+}
+
+void
+Handleset_removeSocket(HandleSet self, const Socket sock)
+{
+   if (self != NULL && sock != NULL && sock->fd != INVALID_SOCKET) {
+       int index = getIndex(self, sock);
+
+       if (index != -1) {
+           sock->handleSetIndex = -1;
+           self->handles.fd_count--;
+           self->handles.fd_array[index] = self->handles.fd_array[self->handles.fd_count];
+           self->isReady[index] = self->isReady[self->handles.fd_count];
+       }
+   }
+}
+
+bool
+Handleset_isReady(HandleSet self, const Socket sock)
+{
+   if (self != NULL && sock != NULL && sock->fd != INVALID_SOCKET) {
+       int index = getIndex(self, sock);
+
+       if (index != -1)
+           return self->isReady[index];
    }
+
+   return false;
 }
 
 int
@@ -94,12 +159,44 @@ Handleset_waitReady(HandleSet self, unsigned int timeoutMs)
 {
    int result;
 
-   if (self != NULL && self->maxHandle != INVALID_SOCKET) {
+   if (self != NULL && self->handles.fd_count > 0) {
        struct timeval timeout;
 
        timeout.tv_sec = timeoutMs / 1000;
        timeout.tv_usec = (timeoutMs % 1000) * 1000;
-       result = select(self->maxHandle + 1, &self->handles, NULL, NULL, &timeout);
+
+       /* select modifies the set -> keep the registered sockets */
+       self->readyHandles = self->handles;
+
+       /* first parameter is ignored by winsock */
+       result = select(0, &self->readyHandles, NULL, NULL, &timeout);
+
+       u_int i;
+       u_int j = 0;
+
+       for (i = 0; i < self->handles.fd_count; i++)
+           self->isReady[i] = false;
+
+       if (result > 0) {
+
+           /* select keeps the order of the sockets -> the ready sockets are found with a single pass */
+           for (i = 0; i < self->readyHandles.fd_count; i++) {
+               SOCKET fd = self->readyHandles.fd_array[i];
+
+               while ((j < self->handles.fd_count) && (self->handles.fd_array[j] != fd))
+                   j++;
+
+               /* not in the expected order -> search from the start */
+               if (j == self->handles.fd_count) {
+                   for (j = 0; (j < self->handles.fd_count) && (self->handles.fd_array[j] != fd); j++);
+               }
+
+               if (j < self->handles.fd_count) {
+                   self->isReady[j] = true;
+                   j++;
+               }
+           }
+       }
    } else {
        result = -1;
    }
@@ -256,6 +353,7 @@ TcpServerSocket_create(const char* address, int port)
 
 	serverSocket->fd = listen_socket;
 	serverSocket->backLog = 10;
+	serverSocket->handleSetIndex = -1;
 
     setSocketNonBlocking((Socket) serverSocket);
 
@@ -282,6 +380,7 @@ ServerSocket_accept(ServerSocket self)
 	if (fd >= 0) {
 		conSocket = (Socket) GLOBAL_CALLOC(1, sizeof(struct sSocket));
 		conSocket->fd = fd;
+		conSocket->handleSetIndex = -1;
 
 		socketCount++;
 
@@ -321,6 +420,7 @@ TcpSocket_create()
 
         self->fd = sock;
         self->connectTimeout = 5000;
+        self->handleSetIndex = -1;
 
         socketCount++;
     }
@@ -338,6 +438,58 @@ Socket_setConnectTimeout(Socket self, uint32_t timeoutInMs)
     self->connectTimeout = timeoutInMs;
 }
 
+void
+SocketOptions_init(SocketOptions self)
+{
+    self->sendBufferSize = 0;
+    self->receiveBufferSize = 0;
+    self->noDelay = true;
+    self->userTimeout = 0;
+    self->busyPollTime = 0;
+    self->corkBatches = false;
+}
+
+/* the socket is already created by TcpSocket_create -> options are applied immediately. SO_BUSY_POLL is not supported */
+bool
+Socket_setOptions(Socket self, SocketOptions options)
+{
+    bool success = true;
+    int optval;
+
+    optval = options->noDelay ? 1 : 0;
+    if (setsockopt(self->fd, IPPROTO_TCP, TCP_NODELAY, (const char*) &optval, sizeof(optval)) == SOCKET_ERROR)
+        success = false;
+
+    if (options->sendBufferSize > 0) {
+        optval = options->sendBufferSize;
+        if (setsockopt(self->fd, SOL_SOCKET, SO_SNDBUF, (const char*) &optval, sizeof(optval)) == SOCKET_ERROR)
+            success = false;
+    }
+
+    if (options->receiveBufferSize > 0) {
+        optval = options->receiveBufferSize;
+        if (setsockopt(self->fd, SOL_SOCKET, SO_RCVBUF, (const char*) &optval, sizeof(optval)) == SOCKET_ERROR)
+            success = false;
+    }
+
+#if defined(TCP_MAXRT)
+    if (options->userTimeout > 0) {
+        /* TCP_MAXRT uses seconds */
+        optval = (options->userTimeout + 999) / 1000;
+        if (setsockopt(self->fd, IPPROTO_TCP, TCP_MAXRT, (const char*) &optval, sizeof(optval)) == SOCKET_ERROR)
+            success = false;
+    }
+#endif
+
+    return success;
+}
+
+void
+Socket_setCork(Socket self, bool cork)
+{
+    /* not supported */
+}
+
 bool
 Socket_connect(Socket self, const char* address, int port)
 {
@@ -520,3 +672,57 @@ Socket_destroy(Socket self)
 
 	GLOBAL_FREEMEM(self);
 }
+
+/* io_uring is Linux only -> the caller uses the HandleSet */
+
+SocketIoRing
+SocketIoRing_create(int maxOperations)
+{
+	return NULL;
+}
+
+bool
+SocketIoRing_registerBuffer(SocketIoRing self, uint8_t* buf, int size)
+{
+	return false;
+}
+
+bool
+SocketIoRing_prepareReceive(SocketIoRing self, Socket sock, uint8_t* buf, int size, void* userData)
+{
+	return false;
+}
+
+bool
+SocketIoRing_prepareSend(SocketIoRing self, Socket sock, uint8_t* buf, int size, void* userData)
+{
+	return false;
+}
+
+void
+SocketIoRing_cancel(SocketIoRing self, void* userData)
+{
+}
+
+bool
+SocketIoRing_submit(SocketIoRing self)
+{
+	return false;
+}
+
+bool
+SocketIoRing_submitAndWait(SocketIoRing self, unsigned int timeoutMs)
+{
+	return false;
+}
+
+bool
+SocketIoRing_getCompletion(SocketIoRing self, void** userData, int* result, bool* isSend)
+{
+	return false;
+}
+
+void
+SocketIoRing_destroy(SocketIoRing self)
+{
+}
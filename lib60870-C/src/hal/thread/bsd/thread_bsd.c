@@ -22,6 +22,13 @@
 #include <pthread.h>
 #include <semaphore.h>
 #include <unistd.h>
+#include <errno.h>
+#include <sys/time.h>
+#include <sched.h>
+#include <string.h>
+#if defined(__FreeBSD__) || defined(__OpenBSD__)
+#include <pthread_np.h>
+#endif
 #include "hal_thread.h"
 #include "lib_memory.h"
 
@@ -31,6 +38,16 @@ struct sThread {
    pthread_t pthread;
    int state;
    bool autodestroy;
+   bool hasAttributes;
+   struct sThreadAttributes attributes;
+};
+
+struct sMutex {
+   pthread_mutex_t mutex;
+};
+
+struct sCondition {
+   pthread_cond_t cond;
 };
 
 Semaphore
@@ -62,6 +79,107 @@ Semaphore_destroy(Semaphore self)
     sem_close(self);
 }
 
+Mutex
+Mutex_create(void)
+{
+   Mutex self = (Mutex) GLOBAL_MALLOC(sizeof(struct sMutex));
+
+   if (self) {
+       if (pthread_mutex_init(&(self->mutex), NULL) != 0) {
+           GLOBAL_FREEMEM(self);
+           self = NULL;
+       }
+   }
+
+   return self;
+}
+
+void
+Mutex_lock(Mutex self)
+{
+   pthread_mutex_lock(&(self->mutex));
+}
+
+void
+Mutex_unlock(Mutex self)
+{
+   pthread_mutex_unlock(&(self->mutex));
+}
+
+void
+Mutex_destroy(Mutex self)
+{
+   if (self) {
+       pthread_mutex_destroy(&(self->mutex));
+       GLOBAL_FREEMEM(self);
+   }
+}
+
+Condition
+Condition_create(void)
+{
+   Condition self = (Condition) GLOBAL_MALLOC(sizeof(struct sCondition));
+
+   if (self) {
+       if (pthread_cond_init(&(self->cond), NULL) != 0) {
+           GLOBAL_FREEMEM(self);
+           self = NULL;
+       }
+   }
+
+   return self;
+}
+
+void
+Condition_wait(Condition self, Mutex mutex)
+{
+   pthread_cond_wait(&(self->cond), &(mutex->mutex));
+}
+
+bool
+Condition_waitTimed(Condition self, Mutex mutex, int timeoutInMs)
+{
+   struct timeval now;
+   struct timespec deadline;
+
+   /* CLOCK_MONOTONIC cannot be selected for condition variables on all BSD variants */
+   gettimeofday(&now, NULL);
+
+   deadline.tv_sec = now.tv_sec + timeoutInMs / 1000;
+   deadline.tv_nsec = (long) now.tv_usec * 1000L + (long) (timeoutInMs % 1000) * 1000000L;
+
+   if (deadline.tv_nsec >= 1000000000L) {
+       deadline.tv_sec++;
+       deadline.tv_nsec -= 1000000000L;
+   }
+
+   if (pthread_cond_timedwait(&(self->cond), &(mutex->mutex), &deadline) == ETIMEDOUT)
+       return false;
+   else
+       return true;
+}
+
+void
+Condition_signal(Condition self)
+{
+   pthread_cond_signal(&(self->cond));
+}
+
+void
+Condition_broadcast(Condition self)
+{
+   pthread_cond_broadcast(&(self->cond));
+}
+
+void
+Condition_destroy(Condition self)
+{
+   if (self) {
+       pthread_cond_destroy(&(self->cond));
+       GLOBAL_FREEMEM(self);
+   }
+}
+
 Thread
 Thread_create(ThreadExecutionFunction function, void* parameter, bool autodestroy)
 {
@@ -72,16 +190,72 @@ Thread_create(ThreadExecutionFunction function, void* parameter, bool autodestro
         thread->function = function;
         thread->state = 0;
         thread->autodestroy = autodestroy;
+        thread->hasAttributes = false;
+        ThreadAttributes_init(&(thread->attributes));
    }
 
    return thread;
 }
 
+void
+ThreadAttributes_init(ThreadAttributes self)
+{
+   self->cpuAffinityMask = 0;
+   self->schedulingPolicy = THREAD_SCHEDULING_POLICY_DEFAULT;
+   self->priority = 0;
+   self->name[0] = 0;
+}
+
+void
+ThreadAttributes_setName(ThreadAttributes self, const char* name)
+{
+   strncpy(self->name, name, THREAD_NAME_MAX_LENGTH - 1);
+   self->name[THREAD_NAME_MAX_LENGTH - 1] = 0;
+}
+
+void
+Thread_setAttributes(Thread thread, ThreadAttributes attributes)
+{
+   if (attributes) {
+       thread->attributes = *attributes;
+       thread->hasAttributes = true;
+   }
+   else {
+       ThreadAttributes_init(&(thread->attributes));
+       thread->hasAttributes = false;
+   }
+}
+
+/* called by the new thread itself. CPU affinity is not supported on this platform */
+static void
+applyAttributes(ThreadAttributes attributes)
+{
+   if (attributes->schedulingPolicy != THREAD_SCHEDULING_POLICY_DEFAULT) {
+       struct sched_param param;
+       int policy = (attributes->schedulingPolicy == THREAD_SCHEDULING_POLICY_FIFO) ? SCHED_FIFO : SCHED_RR;
+
+       param.sched_priority = attributes->priority;
+
+       pthread_setschedparam(pthread_self(), policy, &param);
+   }
+
+   if (attributes->name[0] != 0) {
+#if defined(__APPLE__)
+       pthread_setname_np(attributes->name);
+#elif defined(__FreeBSD__) || defined(__OpenBSD__)
+       pthread_set_name_np(pthread_self(), attributes->name);
+#endif
+   }
+}
+
 static void*
 destroyAutomaticThread(void* parameter)
 {
     Thread thread = (Thread) parameter;
 
+   if (thread->hasAttributes)
+       applyAttributes(&(thread->attributes));
+
    thread->function(thread->parameter);
 
    GLOBAL_FREEMEM(thread);
@@ -89,17 +263,34 @@ destroyAutomaticThread(void* parameter)
    pthread_exit(NULL);
 }
 
+static void*
+runThread(void* parameter)
+{
+   Thread thread = (Thread) parameter;
+
+   applyAttributes(&(thread->attributes));
+
+   return thread->function(thread->parameter);
+}
+
 void
 Thread_start(Thread thread)
 {
    if (thread->autodestroy == true) {
-       pthread_create(&thread->pthread, NULL, destroyAutomaticThread, thread);
-       pthread_detach(thread->pthread);
+       pthread_t pthread;
+
+       /* the thread instance may already be released when pthread_create returns */
+       if (pthread_create(&pthread, NULL, destroyAutomaticThread, thread) == 0)
+           pthread_detach(pthread);
    }
-   else
-       pthread_create(&thread->pthread, NULL, thread->function, thread->parameter);
+   else {
+       if (thread->hasAttributes)
+           pthread_create(&thread->pthread, NULL, runThread, thread);
+       else
+           pthread_create(&thread->pthread, NULL, thread->function, thread->parameter);
 
-   thread->state = 1;
+       thread->state = 1;
+   }
 }
 
 void
@@ -19,9 +19,17 @@
  *  See COPYING file for the complete license text.
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* required for PTHREAD_MUTEX_ADAPTIVE_NP */
+#endif
+
 #include <pthread.h>
 #include <semaphore.h>
 #include <unistd.h>
+#include <time.h>
+#include <errno.h>
+#include <sched.h>
+#include <string.h>
 #include "hal_thread.h"
 #include "lib_memory.h"
 
@@ -32,6 +40,16 @@ struct sThread {
 	pthread_t pthread;
 	int state;
 	bool autodestroy;
+	bool hasAttributes;
+	struct sThreadAttributes attributes;
+};
+
+struct sMutex {
+    pthread_mutex_t mutex;
+};
+
+struct sCondition {
+    pthread_cond_t cond;
 };
 
 Semaphore
@@ -64,6 +82,125 @@ Semaphore_destroy(Semaphore self)
     GLOBAL_FREEMEM(self);
 }
 
+Mutex
+Mutex_create(void)
+{
+    Mutex self = (Mutex) GLOBAL_MALLOC(sizeof(struct sMutex));
+
+    if (self) {
+        pthread_mutexattr_t attr;
+
+        pthread_mutexattr_init(&attr);
+
+#if defined(PTHREAD_ADAPTIVE_MUTEX_INITIALIZER_NP)
+        /* spin shortly before the thread is suspended (futex) when the mutex is contended */
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ADAPTIVE_NP);
+#endif
+
+        if (pthread_mutex_init(&(self->mutex), &attr) != 0) {
+            GLOBAL_FREEMEM(self);
+            self = NULL;
+        }
+
+        pthread_mutexattr_destroy(&attr);
+    }
+
+    return self;
+}
+
+void
+Mutex_lock(Mutex self)
+{
+    pthread_mutex_lock(&(self->mutex));
+}
+
+void
+Mutex_unlock(Mutex self)
+{
+    pthread_mutex_unlock(&(self->mutex));
+}
+
+void
+Mutex_destroy(Mutex self)
+{
+    if (self) {
+        pthread_mutex_destroy(&(self->mutex));
+        GLOBAL_FREEMEM(self);
+    }
+}
+
+Condition
+Condition_create(void)
+{
+    Condition self = (Condition) GLOBAL_MALLOC(sizeof(struct sCondition));
+
+    if (self) {
+        pthread_condattr_t attr;
+
+        pthread_condattr_init(&attr);
+
+        /* timed waits are not affected by changes of the system time */
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+
+        if (pthread_cond_init(&(self->cond), &attr) != 0) {
+            GLOBAL_FREEMEM(self);
+            self = NULL;
+        }
+
+        pthread_condattr_destroy(&attr);
+    }
+
+    return self;
+}
+
+void
+Condition_wait(Condition self, Mutex mutex)
+{
+    pthread_cond_wait(&(self->cond), &(mutex->mutex));
+}
+
+bool
+Condition_waitTimed(Condition self, Mutex mutex, int timeoutInMs)
+{
+    struct timespec deadline;
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+    deadline.tv_sec += timeoutInMs / 1000;
+    deadline.tv_nsec += (long) (timeoutInMs % 1000) * 1000000L;
+
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    if (pthread_cond_timedwait(&(self->cond), &(mutex->mutex), &deadline) == ETIMEDOUT)
+        return false;
+    else
+        return true;
+}
+
+void
+Condition_signal(Condition self)
+{
+    pthread_cond_signal(&(self->cond));
+}
+
+void
+Condition_broadcast(Condition self)
+{
+    pthread_cond_broadcast(&(self->cond));
+}
+
+void
+Condition_destroy(Condition self)
+{
+    if (self) {
+        pthread_cond_destroy(&(self->cond));
+        GLOBAL_FREEMEM(self);
+    }
+}
+
 Thread
 Thread_create(ThreadExecutionFunction function, void* parameter, bool autodestroy)
 {
@@ -74,34 +211,118 @@ Thread_create(ThreadExecutionFunction function, void* parameter, bool autodestro
         thread->function = function;
         thread->state = 0;
         thread->autodestroy = autodestroy;
+        thread->hasAttributes = false;
+        ThreadAttributes_init(&(thread->attributes));
 	}
 
 	return thread;
 }
 
+void
+ThreadAttributes_init(ThreadAttributes self)
+{
+    self->cpuAffinityMask = 0;
+    self->schedulingPolicy = THREAD_SCHEDULING_POLICY_DEFAULT;
+    self->priority = 0;
+    self->name[0] = 0;
+}
+
+void
+ThreadAttributes_setName(ThreadAttributes self, const char* name)
+{
+    strncpy(self->name, name, THREAD_NAME_MAX_LENGTH - 1);
+    self->name[THREAD_NAME_MAX_LENGTH - 1] = 0;
+}
+
+void
+Thread_setAttributes(Thread thread, ThreadAttributes attributes)
+{
+    if (attributes) {
+        thread->attributes = *attributes;
+        thread->hasAttributes = true;
+    }
+    else {
+        ThreadAttributes_init(&(thread->attributes));
+        thread->hasAttributes = false;
+    }
+}
+
+/* called by the new thread itself. Errors (e.g. EPERM for real-time scheduling) are ignored */
+static void
+applyAttributes(ThreadAttributes attributes)
+{
+    pthread_t self = pthread_self();
+
+    if (attributes->cpuAffinityMask != 0) {
+        cpu_set_t cpuSet;
+        int cpu;
+
+        CPU_ZERO(&cpuSet);
+
+        for (cpu = 0; cpu < 64; cpu++) {
+            if (attributes->cpuAffinityMask & ((uint64_t) 1 << cpu))
+                CPU_SET(cpu, &cpuSet);
+        }
+
+        pthread_setaffinity_np(self, sizeof(cpu_set_t), &cpuSet);
+    }
+
+    if (attributes->schedulingPolicy != THREAD_SCHEDULING_POLICY_DEFAULT) {
+        struct sched_param param;
+        int policy = (attributes->schedulingPolicy == THREAD_SCHEDULING_POLICY_FIFO) ? SCHED_FIFO : SCHED_RR;
+
+        param.sched_priority = attributes->priority;
+
+        pthread_setschedparam(self, policy, &param);
+    }
+
+    if (attributes->name[0] != 0)
+        pthread_setname_np(self, attributes->name);
+}
+
 static void*
 destroyAutomaticThread(void* parameter)
 {
     Thread thread = (Thread) parameter;
 
-	thread->function(thread->parameter);
+    if (thread->hasAttributes)
+        applyAttributes(&(thread->attributes));
 
-	GLOBAL_FREEMEM(thread);
+    thread->function(thread->parameter);
+
+    GLOBAL_FREEMEM(thread);
 
-	pthread_exit(NULL);
+    pthread_exit(NULL);
+}
+
+static void*
+runThread(void* parameter)
+{
+    Thread thread = (Thread) parameter;
+
+    applyAttributes(&(thread->attributes));
+
+    return thread->function(thread->parameter);
 }
 
 void
 Thread_start(Thread thread)
 {
 	if (thread->autodestroy == true) {
-		pthread_create(&thread->pthread, NULL, destroyAutomaticThread, thread);
-		pthread_detach(thread->pthread);
+		pthread_t pthread;
+
+		/* the thread instance may already be released when pthread_create returns */
+		if (pthread_create(&pthread, NULL, destroyAutomaticThread, thread) == 0)
+		    pthread_detach(pthread);
 	}
-	else
-		pthread_create(&thread->pthread, NULL, thread->function, thread->parameter);
+	else {
+		if (thread->hasAttributes)
+			pthread_create(&thread->pthread, NULL, runThread, thread);
+		else
+			pthread_create(&thread->pthread, NULL, thread->function, thread->parameter);
 
-	thread->state = 1;
+		thread->state = 1;
+	}
 }
 
 void
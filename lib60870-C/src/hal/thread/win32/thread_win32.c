@@ -20,6 +20,7 @@
  */
 
 #include <windows.h>
+#include <string.h>
 
 #include "lib_memory.h"
 #include "hal_thread.h"
@@ -32,6 +33,14 @@ struct sThread {
 	bool autodestroy;
 };
 
+struct sMutex {
+	CRITICAL_SECTION criticalSection;
+};
+
+struct sCondition {
+	CONDITION_VARIABLE conditionVariable;
+};
+
 static DWORD WINAPI
 destroyAutomaticThreadRunner(LPVOID parameter)
 {
@@ -73,6 +82,36 @@ Thread_create(ThreadExecutionFunction function, void* parameter, bool autodestro
 	return thread;
 }
 
+void
+ThreadAttributes_init(ThreadAttributes self)
+{
+	self->cpuAffinityMask = 0;
+	self->schedulingPolicy = THREAD_SCHEDULING_POLICY_DEFAULT;
+	self->priority = 0;
+	self->name[0] = 0;
+}
+
+void
+ThreadAttributes_setName(ThreadAttributes self, const char* name)
+{
+	strncpy(self->name, name, THREAD_NAME_MAX_LENGTH - 1);
+	self->name[THREAD_NAME_MAX_LENGTH - 1] = 0;
+}
+
+/* The thread is still suspended and the attributes can be applied directly. Thread names are not supported */
+void
+Thread_setAttributes(Thread thread, ThreadAttributes attributes)
+{
+	if (attributes == NULL)
+		return;
+
+	if (attributes->cpuAffinityMask != 0)
+		SetThreadAffinityMask(thread->handle, (DWORD_PTR) attributes->cpuAffinityMask);
+
+	if (attributes->schedulingPolicy != THREAD_SCHEDULING_POLICY_DEFAULT)
+		SetThreadPriority(thread->handle, THREAD_PRIORITY_TIME_CRITICAL);
+}
+
 void
 Thread_start(Thread thread)
 {
@@ -123,3 +162,83 @@ Semaphore_destroy(Semaphore self)
 {
     CloseHandle((HANDLE) self);
 }
+
+Mutex
+Mutex_create(void)
+{
+    Mutex self = (Mutex) GLOBAL_MALLOC(sizeof(struct sMutex));
+
+    if (self)
+        InitializeCriticalSection(&(self->criticalSection));
+
+    return self;
+}
+
+void
+Mutex_lock(Mutex self)
+{
+    EnterCriticalSection(&(self->criticalSection));
+}
+
+void
+Mutex_unlock(Mutex self)
+{
+    LeaveCriticalSection(&(self->criticalSection));
+}
+
+void
+Mutex_destroy(Mutex self)
+{
+    if (self) {
+        DeleteCriticalSection(&(self->criticalSection));
+        GLOBAL_FREEMEM(self);
+    }
+}
+
+Condition
+Condition_create(void)
+{
+    Condition self = (Condition) GLOBAL_MALLOC(sizeof(struct sCondition));
+
+    if (self)
+        InitializeConditionVariable(&(self->conditionVariable));
+
+    return self;
+}
+
+void
+Condition_wait(Condition self, Mutex mutex)
+{
+    SleepConditionVariableCS(&(self->conditionVariable), &(mutex->criticalSection), INFINITE);
+}
+
+bool
+Condition_waitTimed(Condition self, Mutex mutex, int timeoutInMs)
+{
+    if (SleepConditionVariableCS(&(self->conditionVariable), &(mutex->criticalSection), (DWORD) timeoutInMs))
+        return true;
+
+    if (GetLastError() == ERROR_TIMEOUT)
+        return false;
+    else
+        return true;
+}
+
+void
+Condition_signal(Condition self)
+{
+    WakeConditionVariable(&(self->conditionVariable));
+}
+
+void
+Condition_broadcast(Condition self)
+{
+    WakeAllConditionVariable(&(self->conditionVariable));
+}
+
+void
+Condition_destroy(Condition self)
+{
+    /* condition variables don't require explicit cleanup on windows */
+    GLOBAL_FREEMEM(self);
+}
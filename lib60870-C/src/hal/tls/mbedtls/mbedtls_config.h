@@ -42,6 +42,7 @@
 #define MBEDTLS_SSL_PROTO_TLS1_1
 #define MBEDTLS_SSL_PROTO_TLS1
 #define MBEDTLS_SSL_RENEGOTIATION
+#define MBEDTLS_SSL_SESSION_TICKETS
 
 #define MBEDTLS_TLS_DEFAULT_ALLOW_SHA1_IN_CERTIFICATES
 
@@ -69,6 +70,8 @@
 #define MBEDTLS_X509_CRT_PARSE_C
 #define MBEDTLS_X509_USE_C
 #define MBEDTLS_SSL_CACHE_C
+#define MBEDTLS_SSL_TICKET_C
+#define MBEDTLS_GCM_C
 
 /* For test certificates */
 #define MBEDTLS_BASE64_C
@@ -13,6 +13,7 @@
 
 #include "tls_socket.h"
 #include "hal_thread.h"
+#include "hal_time.h"
 #include "lib_memory.h"
 #include "linked_list.h"
 
@@ -22,6 +23,8 @@
 #include "mbedtls/certs.h"
 #include "mbedtls/x509.h"
 #include "mbedtls/ssl.h"
+#include "mbedtls/ssl_cache.h"
+#include "mbedtls/ssl_ticket.h"
 #include "mbedtls/net_sockets.h"
 #include "mbedtls/error.h"
 #include "mbedtls/debug.h"
@@ -52,6 +55,30 @@ struct sTLSConfiguration {
 
     /* TLS session renegotioation time in milliseconds */
     int renegotiationTimeInMs;
+
+    /* maximum time for the handshake of a new connection in milliseconds */
+    int handshakeTimeoutInMs;
+
+    /* TLS session resumption */
+    bool sessionResumption;
+    int sessionResumptionInterval; /* lifetime of a session in seconds */
+    int sessionCacheSize;
+
+    /* server side session cache and session tickets */
+    mbedtls_ssl_cache_context sessionCache;
+    mbedtls_ssl_ticket_context ticketContext;
+    bool ticketContextReady;
+
+    /* client side: session of the last successful handshake */
+    mbedtls_ssl_session savedSession;
+    bool hasSavedSession;
+    uint64_t savedSessionTime;
+
+    /* number of handshakes that resumed a session (client and server side) */
+    int resumedSessionCount;
+
+    /* protects the session cache, the ticket context, the saved session and the resumed session count */
+    Mutex sessionLock;
 };
 
 struct sTLSSocket {
@@ -62,6 +89,14 @@ struct sTLSSocket {
     bool storePeerCert;
     uint8_t* peerCert;
     int peerCertLength;
+
+    /* size of the data of the last TLSSocket_write call that is stored in the record buffer of mbedtls
+     * and could not yet be written to the socket (0 = nothing pending) */
+    int pendingWriteSize;
+
+    bool isClient;
+    bool handshakeComplete;
+    uint64_t handshakeDeadline;
 };
 
 static bool
@@ -147,6 +182,67 @@ verifyCertificate (void* parameter, mbedtls_x509_crt *crt, int certificate_depth
 
 
 
+static int
+sessionCacheGet(void* parameter, mbedtls_ssl_session* session)
+{
+    TLSConfiguration self = (TLSConfiguration) parameter;
+
+    Mutex_lock(self->sessionLock);
+
+    int ret = mbedtls_ssl_cache_get(&(self->sessionCache), session);
+
+    /* the session is resumed when it is found in the cache */
+    if (ret == 0)
+        self->resumedSessionCount++;
+
+    Mutex_unlock(self->sessionLock);
+
+    return ret;
+}
+
+static int
+sessionCacheSet(void* parameter, const mbedtls_ssl_session* session)
+{
+    TLSConfiguration self = (TLSConfiguration) parameter;
+
+    Mutex_lock(self->sessionLock);
+    int ret = mbedtls_ssl_cache_set(&(self->sessionCache), session);
+    Mutex_unlock(self->sessionLock);
+
+    return ret;
+}
+
+static int
+sessionTicketWrite(void* parameter, const mbedtls_ssl_session* session, unsigned char* start,
+        const unsigned char* end, size_t* tlen, uint32_t* lifetime)
+{
+    TLSConfiguration self = (TLSConfiguration) parameter;
+
+    Mutex_lock(self->sessionLock);
+    int ret = mbedtls_ssl_ticket_write(&(self->ticketContext), session, start, end, tlen, lifetime);
+    Mutex_unlock(self->sessionLock);
+
+    return ret;
+}
+
+static int
+sessionTicketParse(void* parameter, mbedtls_ssl_session* session, unsigned char* buf, size_t len)
+{
+    TLSConfiguration self = (TLSConfiguration) parameter;
+
+    Mutex_lock(self->sessionLock);
+
+    int ret = mbedtls_ssl_ticket_parse(&(self->ticketContext), session, buf, len);
+
+    /* the session is resumed when the ticket is valid */
+    if (ret == 0)
+        self->resumedSessionCount++;
+
+    Mutex_unlock(self->sessionLock);
+
+    return ret;
+}
+
 TLSConfiguration
 TLSConfiguration_create()
 {
@@ -181,6 +277,23 @@ TLSConfiguration_create()
         /* default behavior is to allow all certificates that are signed by the CA */
         self->chainValidation = true;
         self->allowOnlyKnownCertificates = false;
+
+        self->handshakeTimeoutInMs = 10000;
+
+        self->sessionResumption = false;
+        self->sessionResumptionInterval = 21600;
+        self->sessionCacheSize = 50;
+
+        mbedtls_ssl_cache_init(&(self->sessionCache));
+        mbedtls_ssl_ticket_init(&(self->ticketContext));
+        self->ticketContextReady = false;
+
+        mbedtls_ssl_session_init(&(self->savedSession));
+        self->hasSavedSession = false;
+        self->savedSessionTime = 0;
+        self->resumedSessionCount = 0;
+
+        self->sessionLock = Mutex_create();
     }
 
     return self;
@@ -312,6 +425,42 @@ TLSConfiguration_setRenegotiationTime(TLSConfiguration self, int timeInMs)
     self->renegotiationTimeInMs = timeInMs;
 }
 
+void
+TLSConfiguration_setHandshakeTimeout(TLSConfiguration self, int timeoutInMs)
+{
+    self->handshakeTimeoutInMs = timeoutInMs;
+}
+
+void
+TLSConfiguration_enableSessionResumption(TLSConfiguration self, bool enable)
+{
+    self->sessionResumption = enable;
+}
+
+void
+TLSConfiguration_setSessionResumptionInterval(TLSConfiguration self, int intervalInSeconds)
+{
+    self->sessionResumptionInterval = intervalInSeconds;
+}
+
+void
+TLSConfiguration_setSessionCacheSize(TLSConfiguration self, int maxEntries)
+{
+    self->sessionCacheSize = maxEntries;
+}
+
+int
+TLSConfiguration_getResumedSessionCount(TLSConfiguration self)
+{
+    Mutex_lock(self->sessionLock);
+
+    int resumedSessionCount = self->resumedSessionCount;
+
+    Mutex_unlock(self->sessionLock);
+
+    return resumedSessionCount;
+}
+
 void
 TLSConfiguration_destroy(TLSConfiguration self)
 {
@@ -332,6 +481,12 @@ TLSConfiguration_destroy(TLSConfiguration self)
 
     LinkedList_destroy(self->allowedCertificates);
 
+    mbedtls_ssl_cache_free(&(self->sessionCache));
+    mbedtls_ssl_ticket_free(&(self->ticketContext));
+    mbedtls_ssl_session_free(&(self->savedSession));
+
+    Mutex_destroy(self->sessionLock);
+
     GLOBAL_FREEMEM(self);
 }
 
@@ -362,8 +517,109 @@ writeFunction(void* ctx, const unsigned char* buf, size_t len)
     return ret;
 }
 
-TLSSocket
-TLSSocket_create(Socket socket, TLSConfiguration configuration, bool storeClientCert)
+/* configure session cache and session tickets for a new server side connection */
+static void
+setupServerSessionResumption(TLSSocket self)
+{
+    TLSConfiguration config = self->tlsConfig;
+
+    Mutex_lock(config->sessionLock);
+
+    if (config->ticketContextReady == false) {
+        mbedtls_ssl_cache_set_timeout(&(config->sessionCache), config->sessionResumptionInterval);
+        mbedtls_ssl_cache_set_max_entries(&(config->sessionCache), config->sessionCacheSize);
+
+        int ret = mbedtls_ssl_ticket_setup(&(config->ticketContext), mbedtls_ctr_drbg_random, &(config->ctr_drbg),
+                MBEDTLS_CIPHER_AES_256_GCM, config->sessionResumptionInterval);
+
+        if (ret == 0)
+            config->ticketContextReady = true;
+        else
+            DEBUG_PRINT("TLS", "mbedtls_ssl_ticket_setup returned %d\n", ret);
+    }
+
+    Mutex_unlock(config->sessionLock);
+
+    mbedtls_ssl_conf_session_cache(&(self->conf), config, sessionCacheGet, sessionCacheSet);
+
+    if (config->ticketContextReady)
+        mbedtls_ssl_conf_session_tickets_cb(&(self->conf), sessionTicketWrite, sessionTicketParse, config);
+}
+
+/* offer the session of the last successful handshake to the server */
+static void
+setupClientSessionResumption(TLSSocket self)
+{
+    TLSConfiguration config = self->tlsConfig;
+
+    mbedtls_ssl_conf_session_tickets(&(self->conf), MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+
+    Mutex_lock(config->sessionLock);
+
+    if (config->hasSavedSession) {
+        uint64_t sessionAge = Hal_getTimeInMs() - config->savedSessionTime;
+
+        if (sessionAge < ((uint64_t) config->sessionResumptionInterval * 1000)) {
+            int ret = mbedtls_ssl_set_session(&(self->ssl), &(config->savedSession));
+
+            if (ret != 0)
+                DEBUG_PRINT("TLS", "mbedtls_ssl_set_session returned %d\n", ret);
+        }
+    }
+
+    Mutex_unlock(config->sessionLock);
+}
+
+/* keep the session for the next connect. The lifetime of a resumed session is not extended. */
+static void
+saveClientSession(TLSSocket self)
+{
+    TLSConfiguration config = self->tlsConfig;
+
+    Mutex_lock(config->sessionLock);
+
+    mbedtls_ssl_session session;
+
+    mbedtls_ssl_session_init(&session);
+
+    if (mbedtls_ssl_get_session(&(self->ssl), &session) == 0) {
+
+        /* a resumed session keeps the master secret (the session ID is changed when a ticket is used) */
+        bool isResumed = config->hasSavedSession &&
+                (memcmp(session.master, config->savedSession.master, sizeof(session.master)) == 0);
+
+        if (isResumed)
+            config->resumedSessionCount++;
+        else
+            config->savedSessionTime = Hal_getTimeInMs();
+
+        mbedtls_ssl_session_free(&(config->savedSession));
+        memcpy(&(config->savedSession), &session, sizeof(mbedtls_ssl_session));
+        config->hasSavedSession = true;
+    }
+    else
+        mbedtls_ssl_session_free(&session);
+
+    Mutex_unlock(config->sessionLock);
+}
+
+static void
+clearClientSession(TLSConfiguration config)
+{
+    Mutex_lock(config->sessionLock);
+
+    if (config->hasSavedSession) {
+        mbedtls_ssl_session_free(&(config->savedSession));
+        mbedtls_ssl_session_init(&(config->savedSession));
+        config->hasSavedSession = false;
+    }
+
+    Mutex_unlock(config->sessionLock);
+}
+
+/* create the TLS context without performing the handshake */
+static TLSSocket
+createSocket(Socket socket, TLSConfiguration configuration, bool storeClientCert)
 {
     TLSSocket self = (TLSSocket) GLOBAL_CALLOC(1, sizeof(struct sTLSSocket));
 
@@ -388,33 +644,150 @@ TLSSocket_create(Socket socket, TLSConfiguration configuration, bool storeClient
         if (ret != 0)
             DEBUG_PRINT("TLS", "mbedtls_ssl_conf_own_cert returned %d\n", ret);
 
+        self->isClient = (self->conf.endpoint == MBEDTLS_SSL_IS_CLIENT);
+
+        if (configuration->sessionResumption) {
+            if (self->isClient == false)
+                setupServerSessionResumption(self);
+        }
+        else {
+            mbedtls_ssl_conf_session_tickets(&(self->conf), MBEDTLS_SSL_SESSION_TICKETS_DISABLED);
+        }
+
         ret = mbedtls_ssl_setup( &(self->ssl), &(self->conf) );
 
         if (ret != 0)
             DEBUG_PRINT("TLS", "mbedtls_ssl_setup returned %d\n", ret);
 
+        if (configuration->sessionResumption && self->isClient)
+            setupClientSessionResumption(self);
+
         mbedtls_ssl_set_bio(&(self->ssl), socket, (mbedtls_ssl_send_t*) writeFunction,
                 (mbedtls_ssl_recv_t*) readFunction, NULL);
 
-        while( (ret = mbedtls_ssl_handshake(&(self->ssl)) ) != 0 )
+        self->handshakeDeadline = Hal_getTimeInMs() + configuration->handshakeTimeoutInMs;
+    }
+
+    return self;
+}
+
+/**
+ * Continue the handshake with the data that is available
+ *
+ * \return 0 when the handshake is complete, MBEDTLS_ERR_SSL_WANT_READ/WANT_WRITE when the handshake
+ * is waiting for the socket, other values in case of an error
+ */
+static int
+performHandshakeStep(TLSSocket self)
+{
+    int ret = mbedtls_ssl_handshake(&(self->ssl));
+
+    if (ret == 0) {
+        self->handshakeComplete = true;
+
+        if (self->tlsConfig->sessionResumption && self->isClient)
+            saveClientSession(self);
+    }
+    else if ((ret != MBEDTLS_ERR_SSL_WANT_READ) && (ret != MBEDTLS_ERR_SSL_WANT_WRITE)) {
+        DEBUG_PRINT("TLS", "mbedtls_ssl_handshake returned %d\n\n", ret );
+    }
+
+    return ret;
+}
+
+static void
+handshakeFailed(TLSSocket self)
+{
+    /* don't offer the saved session again */
+    if (self->isClient)
+        clearClientSession(self->tlsConfig);
+}
+
+static void
+releaseSocket(TLSSocket self)
+{
+    mbedtls_ssl_config_free(&(self->conf));
+    mbedtls_ssl_free(&(self->ssl));
+
+    GLOBAL_FREEMEM(self);
+}
+
+TLSSocket
+TLSSocket_create(Socket socket, TLSConfiguration configuration, bool storeClientCert)
+{
+    TLSSocket self = createSocket(socket, configuration, storeClientCert);
+
+    if (self != NULL) {
+
+        HandleSet handleSet = Handleset_new();
+
+        Handleset_addSocket(handleSet, socket);
+
+        int ret;
+
+        while ((ret = performHandshakeStep(self)) != 0)
         {
-            if( ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE )
-            {
-                DEBUG_PRINT("TLS", "mbedtls_ssl_handshake returned %d\n\n", ret );
+            if ((ret == MBEDTLS_ERR_SSL_WANT_READ) || (ret == MBEDTLS_ERR_SSL_WANT_WRITE)) {
+
+                uint64_t currentTime = Hal_getTimeInMs();
 
-                mbedtls_ssl_config_free(&(self->conf));
-                mbedtls_ssl_free(&(self->ssl));
+                if (currentTime < self->handshakeDeadline) {
+                    /* wait for the next handshake message of the peer instead of spinning */
+                    if (ret == MBEDTLS_ERR_SSL_WANT_READ)
+                        Handleset_waitReady(handleSet, (unsigned int) (self->handshakeDeadline - currentTime));
+                    else
+                        Thread_sleep(1);
 
-                GLOBAL_FREEMEM(self);
+                    continue;
+                }
 
-                return NULL;
+                DEBUG_PRINT("TLS", "handshake timeout\n");
             }
+
+            Handleset_destroy(handleSet);
+
+            handshakeFailed(self);
+            releaseSocket(self);
+
+            return NULL;
         }
+
+        Handleset_destroy(handleSet);
     }
 
     return self;
 }
 
+TLSSocket
+TLSSocket_createNonBlocking(Socket socket, TLSConfiguration configuration, bool storeClientCert)
+{
+    return createSocket(socket, configuration, storeClientCert);
+}
+
+int
+TLSSocket_continueHandshake(TLSSocket self)
+{
+    if (self->handshakeComplete)
+        return 1;
+
+    int ret = performHandshakeStep(self);
+
+    if (ret == 0)
+        return 1;
+
+    if ((ret == MBEDTLS_ERR_SSL_WANT_READ) || (ret == MBEDTLS_ERR_SSL_WANT_WRITE)) {
+
+        if (Hal_getTimeInMs() < self->handshakeDeadline)
+            return 0;
+
+        DEBUG_PRINT("TLS", "handshake timeout\n");
+    }
+
+    handshakeFailed(self);
+
+    return -1;
+}
+
 uint8_t*
 TLSSocket_getPeerCertificate(TLSSocket self, int* certSize)
 {
@@ -465,47 +838,54 @@ TLSSocket_read(TLSSocket self, uint8_t* buf, int size)
 int
 TLSSocket_write(TLSSocket self, uint8_t* buf, int size)
 {
-    int ret;
     int len = size;
 
-    while ((ret = mbedtls_ssl_write(&(self->ssl), buf, len)) <= 0)
+    /* mbedtls expects the same data again after MBEDTLS_ERR_SSL_WANT_WRITE */
+    if ((self->pendingWriteSize > 0) && (self->pendingWriteSize <= size))
+        len = self->pendingWriteSize;
+
+    int ret = mbedtls_ssl_write(&(self->ssl), buf, len);
+
+    if (ret >= 0) {
+        self->pendingWriteSize = 0;
+
+        return ret;
+    }
+
+    if ((ret == MBEDTLS_ERR_SSL_WANT_READ) || (ret == MBEDTLS_ERR_SSL_WANT_WRITE))
     {
-        if (ret == MBEDTLS_ERR_NET_CONN_RESET)
-        {
-            DEBUG_PRINT("TLS", "peer closed the connection\n");
-            return -1;
-        }
+        /* the socket cannot take more data -> the caller has to repeat the call later */
+        self->pendingWriteSize = len;
 
-        if ((ret != MBEDTLS_ERR_SSL_WANT_READ) && (ret != MBEDTLS_ERR_SSL_WANT_WRITE))
-        {
-            DEBUG_PRINT("TLS", "mbedtls_ssl_write returned %d\n", ret);
-            return -1;
-        }
+        return 0;
     }
 
-    len = ret;
+    if (ret == MBEDTLS_ERR_NET_CONN_RESET)
+        DEBUG_PRINT("TLS", "peer closed the connection\n");
+    else
+        DEBUG_PRINT("TLS", "mbedtls_ssl_write returned %d\n", ret);
 
-    return len;
+    return -1;
 }
 
 void
 TLSSocket_close(TLSSocket self)
 {
-    int ret;
+    /* no close notification when the handshake has not been completed */
+    if (self->handshakeComplete) {
+        int ret;
 
-    while ((ret = mbedtls_ssl_close_notify(&(self->ssl))) < 0)
-    {
-        if ((ret != MBEDTLS_ERR_SSL_WANT_READ) && (ret != MBEDTLS_ERR_SSL_WANT_WRITE))
+        while ((ret = mbedtls_ssl_close_notify(&(self->ssl))) < 0)
         {
-            DEBUG_PRINT("TLS", "mbedtls_ssl_close_notify returned %d\n", ret);
-            break;
+            if ((ret != MBEDTLS_ERR_SSL_WANT_READ) && (ret != MBEDTLS_ERR_SSL_WANT_WRITE))
+            {
+                DEBUG_PRINT("TLS", "mbedtls_ssl_close_notify returned %d\n", ret);
+                break;
+            }
         }
-    }
-
-    Thread_sleep(10);
 
-    mbedtls_ssl_config_free(&(self->conf));
-    mbedtls_ssl_free(&(self->ssl));
+        Thread_sleep(10);
+    }
 
-    GLOBAL_FREEMEM(self);
+    releaseSocket(self);
 }
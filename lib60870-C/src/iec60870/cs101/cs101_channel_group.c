@@ -0,0 +1,275 @@
+/*
+ *  cs101_channel_group.c
+ *
+ *  Copyright 2017 MZ Automation GmbH
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "cs101_channel_group.h"
+#include "cs101_internal.h"
+#include "serial_transceiver_ft_1_2.h"
+#include "hal_serial.h"
+#include "hal_time.h"
+#include "lib_memory.h"
+#include "lib60870_config.h"
+#include "lib60870_internal.h"
+
+/* maximum time a worker thread waits for received data before the timers of the channels are checked */
+#define CHANNEL_GROUP_WAIT_TIMEOUT 10
+
+struct sCS101_Channel
+{
+    CS101_Master master;
+    CS101_Slave slave;
+    SerialTransceiverFT12 transceiver;
+    uint64_t lastRunTime;
+};
+
+#if (CONFIG_USE_THREADS == 1)
+struct sCS101_ChannelWorker
+{
+    CS101_ChannelGroup group;
+    int index;
+    SerialPortSet portSet;
+    Thread thread;
+};
+#endif
+
+struct sCS101_ChannelGroup
+{
+    struct sCS101_Channel* channels;
+    int numberOfChannels;
+    int maxChannels;
+
+    /* monitors all channels (used by CS101_ChannelGroup_run) */
+    SerialPortSet portSet;
+
+#if (CONFIG_USE_THREADS == 1)
+    bool isRunning;
+    int numberOfWorkers;
+    struct sCS101_ChannelWorker* workers;
+    struct sThreadAttributes threadAttributes;
+#endif
+};
+
+CS101_ChannelGroup
+CS101_ChannelGroup_create(void)
+{
+    CS101_ChannelGroup self = (CS101_ChannelGroup) GLOBAL_CALLOC(1, sizeof(struct sCS101_ChannelGroup));
+
+    if (self) {
+        self->portSet = SerialPortSet_create();
+
+#if (CONFIG_USE_THREADS == 1)
+        ThreadAttributes_init(&(self->threadAttributes));
+        ThreadAttributes_setName(&(self->threadAttributes), "iec101-group");
+#endif
+    }
+
+    return self;
+}
+
+static void
+addChannel(CS101_ChannelGroup self, CS101_Master master, CS101_Slave slave, SerialTransceiverFT12 transceiver)
+{
+    if (self->numberOfChannels == self->maxChannels) {
+        int newMaxChannels = (self->maxChannels == 0) ? 8 : (self->maxChannels * 2);
+
+        self->channels = (struct sCS101_Channel*) GLOBAL_REALLOC(self->channels, newMaxChannels * sizeof(struct sCS101_Channel));
+        self->maxChannels = newMaxChannels;
+    }
+
+    struct sCS101_Channel* channel = &(self->channels[self->numberOfChannels++]);
+
+    channel->master = master;
+    channel->slave = slave;
+    channel->transceiver = transceiver;
+    channel->lastRunTime = 0;
+
+    /* the group waits for received data -> the link layer must not block in the receive function */
+    SerialTransceiverFT12_setNonBlocking(transceiver, true);
+
+    /* channels with a transport (no serial port) are only handled when the wait timeout elapsed */
+    if (SerialTransceiverFT12_getSerialPort(transceiver))
+        SerialPortSet_addPort(self->portSet, SerialTransceiverFT12_getSerialPort(transceiver));
+}
+
+void
+CS101_ChannelGroup_addMaster(CS101_ChannelGroup self, CS101_Master master)
+{
+    addChannel(self, master, NULL, CS101_Master_getTransceiver(master));
+}
+
+void
+CS101_ChannelGroup_addSlave(CS101_ChannelGroup self, CS101_Slave slave)
+{
+    addChannel(self, NULL, slave, CS101_Slave_getTransceiver(slave));
+}
+
+static void
+runChannel(struct sCS101_Channel* channel)
+{
+    /* handle all frames that have been received with a single read */
+    do {
+        if (channel->master)
+            CS101_Master_run(channel->master);
+        else
+            CS101_Slave_run(channel->slave);
+
+    } while (SerialTransceiverFT12_isMessageBuffered(channel->transceiver));
+}
+
+/* run the channels first, first + step, first + 2 * step, ... */
+static void
+runChannels(CS101_ChannelGroup self, SerialPortSet portSet, int first, int step, int timeoutInMs)
+{
+    SerialPortSet_waitReady(portSet, timeoutInMs);
+
+    uint64_t currentTime = Hal_getTimeInMs();
+
+    int i;
+
+    for (i = first; i < self->numberOfChannels; i += step) {
+        struct sCS101_Channel* channel = &(self->channels[i]);
+
+        SerialPort serialPort = SerialTransceiverFT12_getSerialPort(channel->transceiver);
+
+        /* channels without received data are only called after the wait timeout to handle the timeouts
+         * and the queued messages of the link layer state machines */
+        if ((serialPort == NULL) || SerialPortSet_isReady(portSet, serialPort) ||
+                (currentTime >= channel->lastRunTime + timeoutInMs) || (currentTime < channel->lastRunTime))
+        {
+            channel->lastRunTime = currentTime;
+
+            runChannel(channel);
+        }
+    }
+}
+
+void
+CS101_ChannelGroup_run(CS101_ChannelGroup self, int timeoutInMs)
+{
+    runChannels(self, self->portSet, 0, 1, timeoutInMs);
+}
+
+#if (CONFIG_USE_THREADS == 1)
+static void*
+channelWorkerThread(void* parameter)
+{
+    struct sCS101_ChannelWorker* worker = (struct sCS101_ChannelWorker*) parameter;
+
+    CS101_ChannelGroup self = worker->group;
+
+    while (self->isRunning) {
+        runChannels(self, worker->portSet, worker->index, self->numberOfWorkers, CHANNEL_GROUP_WAIT_TIMEOUT);
+    }
+
+    return NULL;
+}
+#endif /* (CONFIG_USE_THREADS == 1) */
+
+void
+CS101_ChannelGroup_setThreadAttributes(CS101_ChannelGroup self, ThreadAttributes attributes)
+{
+#if (CONFIG_USE_THREADS == 1)
+    self->threadAttributes = *attributes;
+#endif
+}
+
+void
+CS101_ChannelGroup_start(CS101_ChannelGroup self, int numberOfThreads)
+{
+#if (CONFIG_USE_THREADS == 1)
+    if (self->isRunning == false) {
+
+        if (numberOfThreads < 1)
+            numberOfThreads = 1;
+
+        if (numberOfThreads > self->numberOfChannels)
+            numberOfThreads = (self->numberOfChannels > 0) ? self->numberOfChannels : 1;
+
+        self->numberOfWorkers = numberOfThreads;
+        self->workers = (struct sCS101_ChannelWorker*) GLOBAL_CALLOC(numberOfThreads, sizeof(struct sCS101_ChannelWorker));
+
+        self->isRunning = true;
+
+        int i;
+
+        for (i = 0; i < numberOfThreads; i++) {
+            struct sCS101_ChannelWorker* worker = &(self->workers[i]);
+
+            worker->group = self;
+            worker->index = i;
+            worker->portSet = SerialPortSet_create();
+
+            int c;
+
+            for (c = i; c < self->numberOfChannels; c += numberOfThreads) {
+                SerialPort serialPort = SerialTransceiverFT12_getSerialPort(self->channels[c].transceiver);
+
+                if (serialPort)
+                    SerialPortSet_addPort(worker->portSet, serialPort);
+            }
+
+            worker->thread = Thread_create(channelWorkerThread, worker, false);
+            Thread_setAttributes(worker->thread, &(self->threadAttributes));
+            Thread_start(worker->thread);
+        }
+    }
+#else
+    DEBUG_PRINT("CS101 CHANNEL GROUP: ERROR: CS101_ChannelGroup_start not supported when CONFIG_USE_THREADS = 0!\n");
+#endif /* (CONFIG_USE_THREADS == 1) */
+}
+
+void
+CS101_ChannelGroup_stop(CS101_ChannelGroup self)
+{
+#if (CONFIG_USE_THREADS == 1)
+    if (self->isRunning) {
+        self->isRunning = false;
+
+        int i;
+
+        for (i = 0; i < self->numberOfWorkers; i++) {
+            Thread_destroy(self->workers[i].thread);
+            SerialPortSet_destroy(self->workers[i].portSet);
+        }
+
+        GLOBAL_FREEMEM(self->workers);
+        self->workers = NULL;
+        self->numberOfWorkers = 0;
+    }
+#endif /* (CONFIG_USE_THREADS == 1) */
+}
+
+void
+CS101_ChannelGroup_destroy(CS101_ChannelGroup self)
+{
+    if (self) {
+        CS101_ChannelGroup_stop(self);
+
+        SerialPortSet_destroy(self->portSet);
+
+        GLOBAL_FREEMEM(self->channels);
+        GLOBAL_FREEMEM(self);
+    }
+}
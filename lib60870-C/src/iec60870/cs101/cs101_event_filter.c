@@ -0,0 +1,524 @@
+/*
+ *  cs101_event_filter.c
+ *
+ *  Copyright 2017 MZ Automation GmbH
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cs101_event_filter.h"
+#include "cs101_information_objects.h"
+#include "information_objects_internal.h"
+#include "cs101_asdu_internal.h"
+#include "hal_thread.h"
+#include "lib_memory.h"
+#include "lib60870_config.h"
+#include "lib60870_internal.h"
+
+/* number of points that are allocated at once */
+#define EVENT_FILTER_ALLOCATION_UNIT 64
+
+typedef enum
+{
+    FILTER_KIND_NONE,
+    FILTER_KIND_STATUS,
+    FILTER_KIND_ANALOG
+} eFilterKind;
+
+typedef struct
+{
+    int ca;
+    int ioa;
+
+    uint8_t mode; /* CS101_DeadbandMode */
+    bool hasDeadband; /* false when the default deadband is used */
+    bool hasValue; /* false until the first value is reported */
+    QualityDescriptor quality; /* last reported quality */
+
+    float deadband;
+    float integral; /* sum of the differences for CS101_DEADBAND_INTEGRATED */
+
+    union {
+        uint32_t u; /* status information */
+        float f; /* measured values */
+    } value; /* last reported value */
+} sFilterPoint;
+
+struct sCS101_EventFilter
+{
+    CS101_DeadbandMode defaultMode;
+    float defaultDeadband;
+
+    /* sorted by CA and IOA */
+    sFilterPoint* points;
+    int numberOfPoints;
+    int maxNumberOfPoints;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex lock;
+#endif
+};
+
+CS101_EventFilter
+CS101_EventFilter_create(void)
+{
+    CS101_EventFilter self = (CS101_EventFilter) GLOBAL_CALLOC(1, sizeof(struct sCS101_EventFilter));
+
+    if (self) {
+        self->defaultMode = CS101_DEADBAND_NONE;
+        self->defaultDeadband = 0.f;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        self->lock = Mutex_create();
+#endif
+    }
+
+    return self;
+}
+
+void
+CS101_EventFilter_setDefaultDeadband(CS101_EventFilter self, CS101_DeadbandMode mode, float deadband)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    self->defaultMode = mode;
+    self->defaultDeadband = deadband;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+}
+
+static int
+comparePoint(sFilterPoint* point, int ca, int ioa)
+{
+    if (point->ca != ca)
+        return (point->ca < ca) ? -1 : 1;
+
+    if (point->ioa != ioa)
+        return (point->ioa < ioa) ? -1 : 1;
+
+    return 0;
+}
+
+static int
+findLowerBound(CS101_EventFilter self, int ca, int ioa)
+{
+    int low = 0;
+    int high = self->numberOfPoints;
+
+    while (low < high) {
+        int mid = (low + high) / 2;
+
+        if (comparePoint(&(self->points[mid]), ca, ioa) < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+/* get the point or add a new point with the default deadband (lock has to be held by caller) */
+static sFilterPoint*
+getOrAddPoint(CS101_EventFilter self, int ca, int ioa)
+{
+    int index = findLowerBound(self, ca, ioa);
+
+    if ((index < self->numberOfPoints) && (comparePoint(&(self->points[index]), ca, ioa) == 0))
+        return &(self->points[index]);
+
+    if (self->numberOfPoints == self->maxNumberOfPoints) {
+        int newMaxNumberOfPoints = self->maxNumberOfPoints + EVENT_FILTER_ALLOCATION_UNIT;
+
+        sFilterPoint* newPoints = (sFilterPoint*) GLOBAL_REALLOC(self->points, newMaxNumberOfPoints * sizeof(sFilterPoint));
+
+        if (newPoints == NULL)
+            return NULL;
+
+        self->points = newPoints;
+        self->maxNumberOfPoints = newMaxNumberOfPoints;
+    }
+
+    /* points are usually added in ascending order -> nothing to move */
+    if (index < self->numberOfPoints)
+        memmove(&(self->points[index + 1]), &(self->points[index]), (self->numberOfPoints - index) * sizeof(sFilterPoint));
+
+    self->numberOfPoints++;
+
+    sFilterPoint* point = &(self->points[index]);
+
+    memset(point, 0, sizeof(sFilterPoint));
+
+    point->ca = ca;
+    point->ioa = ioa;
+
+    return point;
+}
+
+bool
+CS101_EventFilter_setDeadband(CS101_EventFilter self, int ca, int ioa, CS101_DeadbandMode mode, float deadband)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    sFilterPoint* point = getOrAddPoint(self, ca, ioa);
+
+    if (point) {
+        point->hasDeadband = true;
+        point->mode = (uint8_t) mode;
+        point->deadband = deadband;
+        point->integral = 0.f;
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+
+    return (point != NULL);
+}
+
+static eFilterKind
+getFilterKind(TypeID typeId)
+{
+    switch (typeId) {
+
+    case M_SP_NA_1:
+    case M_SP_TA_1:
+    case M_SP_TB_1:
+    case M_DP_NA_1:
+    case M_DP_TA_1:
+    case M_DP_TB_1:
+    case M_ST_NA_1:
+    case M_ST_TA_1:
+    case M_ST_TB_1:
+    case M_BO_NA_1:
+    case M_BO_TA_1:
+    case M_BO_TB_1:
+        return FILTER_KIND_STATUS;
+
+    case M_ME_NA_1:
+    case M_ME_TA_1:
+    case M_ME_TD_1:
+    case M_ME_ND_1:
+    case M_ME_NB_1:
+    case M_ME_TB_1:
+    case M_ME_TE_1:
+    case M_ME_NC_1:
+    case M_ME_TC_1:
+    case M_ME_TF_1:
+        return FILTER_KIND_ANALOG;
+
+    default:
+        return FILTER_KIND_NONE;
+    }
+}
+
+/* get value and quality of an information object (the time tagged types extend the types without time tag) */
+static void
+getValueAndQuality(TypeID typeId, InformationObject io, uint32_t* status, float* analog, QualityDescriptor* quality)
+{
+    switch (typeId) {
+
+    case M_SP_NA_1:
+    case M_SP_TA_1:
+    case M_SP_TB_1:
+        *status = SinglePointInformation_getValue((SinglePointInformation) io) ? 1 : 0;
+        *quality = SinglePointInformation_getQuality((SinglePointInformation) io);
+        break;
+
+    case M_DP_NA_1:
+    case M_DP_TA_1:
+    case M_DP_TB_1:
+        *status = (uint32_t) DoublePointInformation_getValue((DoublePointInformation) io);
+        *quality = DoublePointInformation_getQuality((DoublePointInformation) io);
+        break;
+
+    case M_ST_NA_1:
+    case M_ST_TA_1:
+    case M_ST_TB_1:
+        *status = (uint32_t) (StepPositionInformation_getValue((StepPositionInformation) io) & 0xff);
+
+        if (StepPositionInformation_isTransient((StepPositionInformation) io))
+            *status |= 0x100;
+
+        *quality = StepPositionInformation_getQuality((StepPositionInformation) io);
+        break;
+
+    case M_BO_NA_1:
+    case M_BO_TA_1:
+    case M_BO_TB_1:
+        *status = BitString32_getValue((BitString32) io);
+        *quality = BitString32_getQuality((BitString32) io);
+        break;
+
+    case M_ME_NA_1:
+    case M_ME_TA_1:
+    case M_ME_TD_1:
+        *analog = MeasuredValueNormalized_getValue((MeasuredValueNormalized) io);
+        *quality = MeasuredValueNormalized_getQuality((MeasuredValueNormalized) io);
+        break;
+
+    case M_ME_ND_1:
+        *analog = MeasuredValueNormalizedWithoutQuality_getValue((MeasuredValueNormalizedWithoutQuality) io);
+        *quality = IEC60870_QUALITY_GOOD;
+        break;
+
+    case M_ME_NB_1:
+    case M_ME_TB_1:
+    case M_ME_TE_1:
+        *analog = (float) MeasuredValueScaled_getValue((MeasuredValueScaled) io);
+        *quality = MeasuredValueScaled_getQuality((MeasuredValueScaled) io);
+        break;
+
+    case M_ME_NC_1:
+    case M_ME_TC_1:
+    case M_ME_TF_1:
+        *analog = MeasuredValueShort_getValue((MeasuredValueShort) io);
+        *quality = MeasuredValueShort_getQuality((MeasuredValueShort) io);
+        break;
+
+    default:
+        break;
+    }
+}
+
+static bool
+isDeadbandExceeded(CS101_EventFilter self, sFilterPoint* point, float value)
+{
+    CS101_DeadbandMode mode = point->hasDeadband ? (CS101_DeadbandMode) point->mode : self->defaultMode;
+    float deadband = point->hasDeadband ? point->deadband : self->defaultDeadband;
+
+    float difference = value - point->value.f;
+    float absDifference = (difference < 0.f) ? -difference : difference;
+
+    switch (mode) {
+
+    case CS101_DEADBAND_ABSOLUTE:
+        return (absDifference > deadband);
+
+    case CS101_DEADBAND_PERCENTAGE:
+        {
+            float lastValue = (point->value.f < 0.f) ? -point->value.f : point->value.f;
+
+            return (absDifference > (lastValue * deadband / 100.f));
+        }
+
+    case CS101_DEADBAND_INTEGRATED:
+        point->integral += difference;
+
+        return ((point->integral > deadband) || (point->integral < -deadband));
+
+    default:
+        return (difference != 0.f);
+    }
+}
+
+/* check if the information object has to be reported (lock has to be held by caller). The last reported
+ * value is only changed by setReported when the information object has been passed on. */
+static bool
+isReportRequired(CS101_EventFilter self, int ca, TypeID typeId, eFilterKind kind, InformationObject io)
+{
+    uint32_t status = 0;
+    float analog = 0.f;
+    QualityDescriptor quality = IEC60870_QUALITY_GOOD;
+
+    getValueAndQuality(typeId, io, &status, &analog, &quality);
+
+    sFilterPoint* point = getOrAddPoint(self, ca, InformationObject_getObjectAddress(io));
+
+    /* without filter state every event is reported */
+    if (point == NULL)
+        return true;
+
+    if ((point->hasValue == false) || (point->quality != quality))
+        return true;
+    else if (kind == FILTER_KIND_STATUS)
+        return (point->value.u != status);
+    else
+        return isDeadbandExceeded(self, point, analog);
+}
+
+/* store the value of a reported information object (lock has to be held by caller) */
+static void
+setReported(CS101_EventFilter self, int ca, TypeID typeId, eFilterKind kind, InformationObject io)
+{
+    uint32_t status = 0;
+    float analog = 0.f;
+    QualityDescriptor quality = IEC60870_QUALITY_GOOD;
+
+    getValueAndQuality(typeId, io, &status, &analog, &quality);
+
+    sFilterPoint* point = getOrAddPoint(self, ca, InformationObject_getObjectAddress(io));
+
+    if (point) {
+        point->hasValue = true;
+        point->quality = quality;
+        point->integral = 0.f;
+
+        if (kind == FILTER_KIND_STATUS)
+            point->value.u = status;
+        else
+            point->value.f = analog;
+    }
+}
+
+int
+CS101_EventFilter_apply(CS101_EventFilter self, CS101_ASDU asdu, CS101_EventFilter_ASDUHandler handler, void* parameter)
+{
+    if (CS101_ASDU_getCOT(asdu) != CS101_COT_SPONTANEOUS) {
+        handler(parameter, asdu);
+        return 1;
+    }
+
+    TypeID typeId = CS101_ASDU_getTypeID(asdu);
+
+    eFilterKind kind = getFilterKind(typeId);
+
+    if (kind == FILTER_KIND_NONE) {
+        handler(parameter, asdu);
+        return 1;
+    }
+
+    int ca = CS101_ASDU_getCA(asdu);
+    int numberOfElements = CS101_ASDU_getNumberOfElements(asdu);
+
+    bool isReported[0x7f];
+    int reportedElements = 0;
+    int numberOfAsdus = 0;
+
+    int i;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    for (i = 0; i < numberOfElements; i++) {
+        union uInformationObject _io;
+
+        InformationObject io = CS101_ASDU_getElementEx(asdu, (InformationObject) &_io, i);
+
+        /* invalid elements are not filtered */
+        isReported[i] = (io == NULL) ? true : isReportRequired(self, ca, typeId, kind, io);
+
+        if (isReported[i])
+            reportedElements++;
+    }
+
+    if (reportedElements == numberOfElements) {
+        for (i = 0; i < numberOfElements; i++) {
+            union uInformationObject _io;
+
+            InformationObject io = CS101_ASDU_getElementEx(asdu, (InformationObject) &_io, i);
+
+            if (io)
+                setReported(self, ca, typeId, kind, io);
+        }
+
+        handler(parameter, asdu);
+        numberOfAsdus = 1;
+    }
+    else if (reportedElements > 0) {
+        sCS101_StaticASDU _filteredAsdu;
+
+        /* the remaining information objects are not consecutive anymore -> no sequence ASDU. Without
+         * the sequence format the information objects need more space -> the ASDU can be split. */
+        CS101_ASDU filteredAsdu = CS101_ASDU_initializeStatic(&_filteredAsdu, asdu->parameters, false, CS101_COT_SPONTANEOUS,
+                CS101_ASDU_getOA(asdu), ca, CS101_ASDU_isTest(asdu), CS101_ASDU_isNegative(asdu));
+
+        for (i = 0; i < numberOfElements; i++) {
+            if (isReported[i] == false)
+                continue;
+
+            union uInformationObject _io;
+
+            InformationObject io = CS101_ASDU_getElementEx(asdu, (InformationObject) &_io, i);
+
+            if (io == NULL)
+                continue;
+
+            bool added = CS101_ASDU_addInformationObject(filteredAsdu, io);
+
+            if ((added == false) && (CS101_ASDU_getNumberOfElements(filteredAsdu) > 0)) {
+                handler(parameter, filteredAsdu);
+                numberOfAsdus++;
+
+                CS101_ASDU_removeAllElements(filteredAsdu);
+
+                added = CS101_ASDU_addInformationObject(filteredAsdu, io);
+            }
+
+            /* only information objects that are passed on are stored as reported */
+            if (added)
+                setReported(self, ca, typeId, kind, io);
+        }
+
+        if (CS101_ASDU_getNumberOfElements(filteredAsdu) > 0) {
+            handler(parameter, filteredAsdu);
+            numberOfAsdus++;
+        }
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+
+    return numberOfAsdus;
+}
+
+void
+CS101_EventFilter_reset(CS101_EventFilter self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    int i;
+
+    for (i = 0; i < self->numberOfPoints; i++) {
+        self->points[i].hasValue = false;
+        self->points[i].integral = 0.f;
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+}
+
+void
+CS101_EventFilter_destroy(CS101_EventFilter self)
+{
+    if (self) {
+        if (self->points)
+            GLOBAL_FREEMEM(self->points);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_destroy(self->lock);
+#endif
+
+        GLOBAL_FREEMEM(self);
+    }
+}
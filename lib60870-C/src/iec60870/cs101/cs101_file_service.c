@@ -0,0 +1,1184 @@
+/*
+ *  cs101_file_service.c
+ *
+ *  Copyright 2017 MZ Automation GmbH
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cs101_file_service.h"
+#include "cs101_information_objects.h"
+#include "information_objects_internal.h"
+#include "linked_list.h"
+#include "hal_thread.h"
+#include "hal_time.h"
+#include "lib_memory.h"
+#include "lib60870_config.h"
+#include "lib60870_internal.h"
+
+#define FILE_SERVICE_DEFAULT_SECTION_SIZE 65535
+
+#define FILE_SERVICE_DEFAULT_TIMEOUT 30000
+
+/* LOF is a 3 byte value */
+#define FILE_SERVICE_MAX_LENGTH_OF_FILE 0xffffff
+
+/* NOS is a 1 byte value (0 is not used) */
+#define FILE_SERVICE_MAX_SECTIONS 255
+
+/* LOS is a 1 byte value */
+#define FILE_SERVICE_MAX_SEGMENT_SIZE 255
+
+/* number of times a section is repeated after a negative acknowledgement */
+#define FILE_SERVICE_MAX_SECTION_RETRIES 3
+
+static bool
+sendFileObject(IMasterConnection connection, int oa, int ca, InformationObject io)
+{
+    sCS101_StaticASDU _asdu;
+
+    CS101_ASDU asdu = CS101_ASDU_initializeStatic(&_asdu, IMasterConnection_getApplicationLayerParameters(connection),
+            false, CS101_COT_FILE_TRANSFER, oa, ca, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, io);
+
+    return IMasterConnection_sendASDU(connection, asdu);
+}
+
+/* checksum of the file service (arithmetic sum modulo 256) */
+static uint8_t
+addToChecksum(uint8_t checksum, const uint8_t* data, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+        checksum += data[i];
+
+    return checksum;
+}
+
+/********************************************
+ * File server
+ ********************************************/
+
+typedef struct sCS101_ServerFile* CS101_ServerFile;
+
+struct sCS101_ServerFile
+{
+    int ca;
+    int ioa;
+    uint16_t nof;
+    uint32_t lengthOfFile;
+
+    /* file in memory */
+    const uint8_t* data;
+
+    /* file read with a read handler */
+    CS101_FileReadHandler readHandler;
+    void* readHandlerParameter;
+};
+
+typedef enum
+{
+    SERVER_STATE_FILE_SELECTED,
+    SERVER_STATE_WAIT_FOR_SECTION_REQUEST,
+    SERVER_STATE_SENDING_SECTION,
+    SERVER_STATE_WAIT_FOR_SECTION_ACK,
+    SERVER_STATE_WAIT_FOR_FILE_ACK
+} eServerTransferState;
+
+typedef struct sCS101_ServerTransfer* CS101_ServerTransfer;
+
+/* a file transfer to a master (at most one for each connection) */
+struct sCS101_ServerTransfer
+{
+    IMasterConnection connection;
+    CS101_ServerFile file;
+    eServerTransferState state;
+
+    int oa;
+
+    uint32_t sectionSize;
+
+    uint8_t nos; /* name of the current section (1 .. number of sections) */
+    uint32_t sectionStart;
+    uint32_t sectionLength;
+    uint32_t sectionOffset; /* number of bytes of the section that have been sent */
+
+    uint8_t sectionChecksum;
+    uint8_t fileChecksum; /* checksum of the acknowledged sections */
+
+    int retries;
+
+    uint64_t lastActivity;
+};
+
+struct sCS101_FileServer
+{
+    LinkedList files;
+    LinkedList transfers;
+
+    uint32_t sectionSize;
+    int timeout;
+
+    CS101_FileTransferProgressHandler progressHandler;
+    void* progressHandlerParameter;
+
+    struct sCS101_SlavePlugin plugin;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex lock;
+#endif
+};
+
+static CS101_SlavePlugin_Result
+fileServer_handleAsdu(void* parameter, IMasterConnection connection, CS101_ASDU asdu);
+
+static void
+fileServer_runTask(void* parameter, IMasterConnection connection);
+
+static void
+fileServer_connectionClosed(void* parameter, IMasterConnection connection);
+
+CS101_FileServer
+CS101_FileServer_create(void)
+{
+    CS101_FileServer self = (CS101_FileServer) GLOBAL_CALLOC(1, sizeof(struct sCS101_FileServer));
+
+    if (self) {
+        self->files = LinkedList_create();
+        self->transfers = LinkedList_create();
+
+        self->sectionSize = FILE_SERVICE_DEFAULT_SECTION_SIZE;
+        self->timeout = FILE_SERVICE_DEFAULT_TIMEOUT;
+
+        self->plugin.handleAsdu = fileServer_handleAsdu;
+        self->plugin.runTask = fileServer_runTask;
+        self->plugin.parameter = self;
+        self->plugin.connectionClosed = fileServer_connectionClosed;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        self->lock = Mutex_create();
+#endif
+    }
+
+    return self;
+}
+
+void
+CS101_FileServer_setSectionSize(CS101_FileServer self, uint32_t sectionSize)
+{
+    if (sectionSize > 0)
+        self->sectionSize = sectionSize;
+}
+
+void
+CS101_FileServer_setTimeout(CS101_FileServer self, int timeoutInMs)
+{
+    self->timeout = timeoutInMs;
+}
+
+void
+CS101_FileServer_setProgressHandler(CS101_FileServer self, CS101_FileTransferProgressHandler handler, void* parameter)
+{
+    self->progressHandler = handler;
+    self->progressHandlerParameter = parameter;
+}
+
+static CS101_ServerFile
+getFile(CS101_FileServer self, int ca, int ioa)
+{
+    LinkedList fileElem = LinkedList_getNext(self->files);
+
+    while (fileElem) {
+        CS101_ServerFile file = (CS101_ServerFile) LinkedList_getData(fileElem);
+
+        if ((file->ca == ca) && (file->ioa == ioa))
+            return file;
+
+        fileElem = LinkedList_getNext(fileElem);
+    }
+
+    return NULL;
+}
+
+static bool
+hasFilesOfCA(CS101_FileServer self, int ca)
+{
+    LinkedList fileElem = LinkedList_getNext(self->files);
+
+    while (fileElem) {
+        CS101_ServerFile file = (CS101_ServerFile) LinkedList_getData(fileElem);
+
+        if (file->ca == ca)
+            return true;
+
+        fileElem = LinkedList_getNext(fileElem);
+    }
+
+    return false;
+}
+
+static bool
+addFile(CS101_FileServer self, int ca, int ioa, uint16_t nof, uint32_t lengthOfFile, const uint8_t* data,
+        CS101_FileReadHandler handler, void* parameter)
+{
+    bool retVal = false;
+
+    if (lengthOfFile > FILE_SERVICE_MAX_LENGTH_OF_FILE)
+        return false;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    if (getFile(self, ca, ioa) == NULL) {
+
+        CS101_ServerFile file = (CS101_ServerFile) GLOBAL_CALLOC(1, sizeof(struct sCS101_ServerFile));
+
+        if (file) {
+            file->ca = ca;
+            file->ioa = ioa;
+            file->nof = nof;
+            file->lengthOfFile = lengthOfFile;
+            file->data = data;
+            file->readHandler = handler;
+            file->readHandlerParameter = parameter;
+
+            LinkedList_add(self->files, file);
+
+            retVal = true;
+        }
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+
+    return retVal;
+}
+
+bool
+CS101_FileServer_addFile(CS101_FileServer self, int ca, int ioa, uint16_t nof, const uint8_t* data, uint32_t lengthOfFile)
+{
+    return addFile(self, ca, ioa, nof, lengthOfFile, data, NULL, NULL);
+}
+
+bool
+CS101_FileServer_addFileWithReader(CS101_FileServer self, int ca, int ioa, uint16_t nof, uint32_t lengthOfFile,
+        CS101_FileReadHandler handler, void* parameter)
+{
+    return addFile(self, ca, ioa, nof, lengthOfFile, NULL, handler, parameter);
+}
+
+static void
+reportProgress(CS101_FileServer self, CS101_ServerTransfer transfer, CS101_FileTransferState state)
+{
+    if (self->progressHandler) {
+        CS101_ServerFile file = transfer->file;
+
+        self->progressHandler(self->progressHandlerParameter, file->ca, file->ioa, file->nof, state,
+                transfer->sectionStart + transfer->sectionOffset, file->lengthOfFile);
+    }
+}
+
+static void
+finishTransfer(CS101_FileServer self, CS101_ServerTransfer transfer, CS101_FileTransferState state)
+{
+    reportProgress(self, transfer, state);
+
+    LinkedList_remove(self->transfers, transfer);
+
+    GLOBAL_FREEMEM(transfer);
+}
+
+void
+CS101_FileServer_removeFile(CS101_FileServer self, int ca, int ioa)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    CS101_ServerFile file = getFile(self, ca, ioa);
+
+    if (file) {
+        LinkedList transferElem = LinkedList_getNext(self->transfers);
+
+        while (transferElem) {
+            CS101_ServerTransfer transfer = (CS101_ServerTransfer) LinkedList_getData(transferElem);
+
+            transferElem = LinkedList_getNext(transferElem);
+
+            if (transfer->file == file)
+                finishTransfer(self, transfer, CS101_FILE_TRANSFER_FAILED);
+        }
+
+        LinkedList_remove(self->files, file);
+
+        GLOBAL_FREEMEM(file);
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+}
+
+static CS101_ServerTransfer
+getTransfer(CS101_FileServer self, IMasterConnection connection)
+{
+    LinkedList transferElem = LinkedList_getNext(self->transfers);
+
+    while (transferElem) {
+        CS101_ServerTransfer transfer = (CS101_ServerTransfer) LinkedList_getData(transferElem);
+
+        if (transfer->connection == connection)
+            return transfer;
+
+        transferElem = LinkedList_getNext(transferElem);
+    }
+
+    return NULL;
+}
+
+static int
+getNumberOfSections(CS101_ServerTransfer transfer)
+{
+    return (int) ((transfer->file->lengthOfFile + transfer->sectionSize - 1) / transfer->sectionSize);
+}
+
+static bool
+sendFileReady(CS101_ServerTransfer transfer, CS101_ServerFile file, uint16_t nof, uint32_t lengthOfFile, bool positive)
+{
+    struct sFileReady _fileReady;
+
+    FileReady fileReady = FileReady_create(&_fileReady, file->ioa, nof, lengthOfFile, positive);
+
+    return sendFileObject(transfer->connection, transfer->oa, file->ca, (InformationObject) fileReady);
+}
+
+static bool
+sendSectionReady(CS101_ServerTransfer transfer)
+{
+    CS101_ServerFile file = transfer->file;
+
+    struct sSectionReady _sectionReady;
+
+    SectionReady sectionReady = SectionReady_create(&_sectionReady, file->ioa, file->nof, transfer->nos, transfer->sectionLength, false);
+
+    return sendFileObject(transfer->connection, transfer->oa, file->ca, (InformationObject) sectionReady);
+}
+
+static bool
+sendLastSegmentOrSection(CS101_ServerTransfer transfer, uint8_t lsq, uint8_t chs)
+{
+    CS101_ServerFile file = transfer->file;
+
+    struct sFileLastSegmentOrSection _last;
+
+    FileLastSegmentOrSection last = FileLastSegmentOrSection_create(&_last, file->ioa, file->nof, transfer->nos, lsq, chs);
+
+    return sendFileObject(transfer->connection, transfer->oa, file->ca, (InformationObject) last);
+}
+
+static void
+prepareSection(CS101_ServerTransfer transfer, uint8_t nos)
+{
+    transfer->nos = nos;
+    transfer->sectionStart = (uint32_t) (nos - 1) * transfer->sectionSize;
+    transfer->sectionLength = transfer->file->lengthOfFile - transfer->sectionStart;
+
+    if (transfer->sectionLength > transfer->sectionSize)
+        transfer->sectionLength = transfer->sectionSize;
+
+    transfer->sectionOffset = 0;
+    transfer->sectionChecksum = 0;
+
+    transfer->state = SERVER_STATE_WAIT_FOR_SECTION_REQUEST;
+}
+
+/*
+ * Send the next segment of the current section
+ *
+ * \return true when the segment has been sent, false when the connection cannot take more
+ * messages or the transfer failed (state is changed)
+ */
+static bool
+sendNextSegment(CS101_FileServer self, CS101_ServerTransfer transfer)
+{
+    CS101_ServerFile file = transfer->file;
+
+    int maxSegmentSize = FileSegment_GetMaxDataSize(IMasterConnection_getApplicationLayerParameters(transfer->connection));
+
+    if (maxSegmentSize > FILE_SERVICE_MAX_SEGMENT_SIZE)
+        maxSegmentSize = FILE_SERVICE_MAX_SEGMENT_SIZE;
+
+    uint32_t remaining = transfer->sectionLength - transfer->sectionOffset;
+
+    int segmentSize = (remaining < (uint32_t) maxSegmentSize) ? (int) remaining : maxSegmentSize;
+
+    uint32_t offset = transfer->sectionStart + transfer->sectionOffset;
+
+    uint8_t buffer[FILE_SERVICE_MAX_SEGMENT_SIZE];
+    uint8_t* data;
+
+    if (file->data) {
+        /* the segment is encoded directly from the memory of the file */
+        data = (uint8_t*) (file->data + offset);
+    }
+    else {
+        if (file->readHandler(file->readHandlerParameter, offset, buffer, segmentSize) != segmentSize) {
+            DEBUG_PRINT("FILE SERVER: failed to read file (IOA=%i)\n", file->ioa);
+
+            sendLastSegmentOrSection(transfer, CS101_LSQ_SECTION_TRANSFER_WITH_DEACT, 0);
+            finishTransfer(self, transfer, CS101_FILE_TRANSFER_FAILED);
+
+            return false;
+        }
+
+        data = buffer;
+    }
+
+    struct sFileSegment _segment;
+
+    FileSegment segment = FileSegment_create(&_segment, file->ioa, file->nof, transfer->nos, data, (uint8_t) segmentSize);
+
+    if (sendFileObject(transfer->connection, transfer->oa, file->ca, (InformationObject) segment) == false)
+        return false;
+
+    transfer->sectionChecksum = addToChecksum(transfer->sectionChecksum, data, segmentSize);
+    transfer->sectionOffset += segmentSize;
+
+    reportProgress(self, transfer, CS101_FILE_TRANSFER_IN_PROGRESS);
+
+    return true;
+}
+
+/* send segments as long as the connection can take more messages (the master doesn't confirm single segments) */
+static void
+sendSection(CS101_FileServer self, CS101_ServerTransfer transfer)
+{
+    while (IMasterConnection_isReady(transfer->connection)) {
+
+        if (transfer->sectionOffset < transfer->sectionLength) {
+            if (sendNextSegment(self, transfer) == false)
+                break;
+        }
+        else {
+            if (sendLastSegmentOrSection(transfer, CS101_LSQ_SECTION_TRANSFER_WITHOUT_DEACT, transfer->sectionChecksum))
+                transfer->state = SERVER_STATE_WAIT_FOR_SECTION_ACK;
+
+            break;
+        }
+    }
+}
+
+static void
+handleFileCallOrSelect(CS101_FileServer self, IMasterConnection connection, CS101_ASDU asdu, CS101_ServerFile file,
+        CS101_ServerTransfer transfer, FileCallOrSelect fcs)
+{
+    uint8_t scq = FileCallOrSelect_getSCQ(fcs);
+
+    switch (scq) {
+
+    case CS101_SCQ_SELECT_FILE:
+    case CS101_SCQ_REQUEST_FILE:
+
+        /* a new select aborts the running transfer of the connection */
+        if (transfer && ((scq == CS101_SCQ_SELECT_FILE) || (transfer->file != file) || (transfer->state != SERVER_STATE_FILE_SELECTED))) {
+            finishTransfer(self, transfer, CS101_FILE_TRANSFER_FAILED);
+            transfer = NULL;
+        }
+
+        if (transfer == NULL) {
+            transfer = (CS101_ServerTransfer) GLOBAL_CALLOC(1, sizeof(struct sCS101_ServerTransfer));
+
+            if (transfer == NULL)
+                break;
+
+            transfer->connection = connection;
+            transfer->file = file;
+            transfer->oa = CS101_ASDU_getOA(asdu);
+
+            /* increase the section size when the file would have too many sections */
+            transfer->sectionSize = self->sectionSize;
+
+            if (file->lengthOfFile / FILE_SERVICE_MAX_SECTIONS >= transfer->sectionSize)
+                transfer->sectionSize = (file->lengthOfFile + FILE_SERVICE_MAX_SECTIONS - 1) / FILE_SERVICE_MAX_SECTIONS;
+
+            LinkedList_add(self->transfers, transfer);
+        }
+
+        transfer->lastActivity = Hal_getTimeInMs();
+
+        if (FileCallOrSelect_getNOF(fcs) != file->nof) {
+            sendFileReady(transfer, file, FileCallOrSelect_getNOF(fcs), 0, false);
+            finishTransfer(self, transfer, CS101_FILE_TRANSFER_FAILED);
+        }
+        else if (scq == CS101_SCQ_SELECT_FILE) {
+            transfer->state = SERVER_STATE_FILE_SELECTED;
+
+            sendFileReady(transfer, file, file->nof, file->lengthOfFile, true);
+        }
+        else {
+            if (getNumberOfSections(transfer) == 0) {
+                /* empty file */
+                transfer->state = SERVER_STATE_WAIT_FOR_FILE_ACK;
+
+                sendLastSegmentOrSection(transfer, CS101_LSQ_FILE_TRANSFER_WITHOUT_DEACT, 0);
+            }
+            else {
+                prepareSection(transfer, 1);
+                sendSectionReady(transfer);
+            }
+
+            reportProgress(self, transfer, CS101_FILE_TRANSFER_IN_PROGRESS);
+        }
+
+        break;
+
+    case CS101_SCQ_REQUEST_SECTION:
+
+        if (transfer && (transfer->file == file) && (transfer->state == SERVER_STATE_WAIT_FOR_SECTION_REQUEST) &&
+                (FileCallOrSelect_getNameOfSection(fcs) == transfer->nos))
+        {
+            transfer->lastActivity = Hal_getTimeInMs();
+            transfer->state = SERVER_STATE_SENDING_SECTION;
+
+            sendSection(self, transfer);
+        }
+        else {
+            DEBUG_PRINT("FILE SERVER: unexpected section request (IOA=%i)\n", file->ioa);
+        }
+
+        break;
+
+    case CS101_SCQ_DEACTIVATE_FILE:
+
+        if (transfer && (transfer->file == file))
+            finishTransfer(self, transfer, CS101_FILE_TRANSFER_FAILED);
+
+        break;
+
+    default:
+        DEBUG_PRINT("FILE SERVER: unsupported SCQ %i\n", scq);
+        break;
+    }
+}
+
+static void
+handleFileACK(CS101_FileServer self, CS101_ServerFile file, CS101_ServerTransfer transfer, FileACK fileAck)
+{
+    if ((transfer == NULL) || (transfer->file != file))
+        return;
+
+    transfer->lastActivity = Hal_getTimeInMs();
+
+    /* the upper 4 bits contain the error code */
+    uint8_t afq = FileACK_getAFQ(fileAck) & 0x0f;
+
+    if (transfer->state == SERVER_STATE_WAIT_FOR_SECTION_ACK) {
+
+        if (afq == CS101_AFQ_POS_ACK_SECTION) {
+            transfer->fileChecksum += transfer->sectionChecksum;
+            transfer->retries = 0;
+
+            if (transfer->nos < getNumberOfSections(transfer)) {
+                prepareSection(transfer, transfer->nos + 1);
+                sendSectionReady(transfer);
+            }
+            else {
+                transfer->state = SERVER_STATE_WAIT_FOR_FILE_ACK;
+
+                sendLastSegmentOrSection(transfer, CS101_LSQ_FILE_TRANSFER_WITHOUT_DEACT, transfer->fileChecksum);
+            }
+        }
+        else if (afq == CS101_AFQ_NEG_ACK_SECTION) {
+
+            if (transfer->retries < FILE_SERVICE_MAX_SECTION_RETRIES) {
+                transfer->retries++;
+
+                /* repeat the section */
+                prepareSection(transfer, transfer->nos);
+                sendSectionReady(transfer);
+            }
+            else
+                finishTransfer(self, transfer, CS101_FILE_TRANSFER_FAILED);
+        }
+    }
+    else if (transfer->state == SERVER_STATE_WAIT_FOR_FILE_ACK) {
+
+        if (afq == CS101_AFQ_POS_ACK_FILE)
+            finishTransfer(self, transfer, CS101_FILE_TRANSFER_SUCCESS);
+        else if (afq == CS101_AFQ_NEG_ACK_FILE)
+            finishTransfer(self, transfer, CS101_FILE_TRANSFER_FAILED);
+    }
+}
+
+static CS101_SlavePlugin_Result
+fileServer_handleAsdu(void* parameter, IMasterConnection connection, CS101_ASDU asdu)
+{
+    CS101_FileServer self = (CS101_FileServer) parameter;
+
+    TypeID typeId = CS101_ASDU_getTypeID(asdu);
+
+    if ((typeId != F_SC_NA_1) && (typeId != F_AF_NA_1))
+        return CS101_PLUGIN_RESULT_NOT_HANDLED;
+
+    /* other services (e.g. call directory) are left to the application */
+    if (CS101_ASDU_getCOT(asdu) != CS101_COT_FILE_TRANSFER)
+        return CS101_PLUGIN_RESULT_NOT_HANDLED;
+
+    CS101_SlavePlugin_Result result = CS101_PLUGIN_RESULT_NOT_HANDLED;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    int ca = CS101_ASDU_getCA(asdu);
+
+    /* requests for other CAs are left to the application */
+    if (hasFilesOfCA(self, ca) == false)
+        goto exit_function;
+
+    union uInformationObject _io;
+
+    InformationObject io = CS101_ASDU_getElementEx(asdu, (InformationObject) &_io, 0);
+
+    if (io == NULL) {
+        result = CS101_PLUGIN_RESULT_INVALID_ASDU;
+        goto exit_function;
+    }
+
+    result = CS101_PLUGIN_RESULT_HANDLED;
+
+    CS101_ServerTransfer transfer = getTransfer(self, connection);
+
+    CS101_ServerFile file = getFile(self, ca, InformationObject_getObjectAddress(io));
+
+    if (file == NULL) {
+        DEBUG_PRINT("FILE SERVER: unknown file (IOA=%i)\n", InformationObject_getObjectAddress(io));
+
+        if (typeId == F_SC_NA_1) {
+            struct sFileReady _fileReady;
+
+            FileReady fileReady = FileReady_create(&_fileReady, InformationObject_getObjectAddress(io),
+                    FileCallOrSelect_getNOF((FileCallOrSelect) io), 0, false);
+
+            sendFileObject(connection, CS101_ASDU_getOA(asdu), ca, (InformationObject) fileReady);
+        }
+
+        goto exit_function;
+    }
+
+    if (typeId == F_SC_NA_1)
+        handleFileCallOrSelect(self, connection, asdu, file, transfer, (FileCallOrSelect) io);
+    else
+        handleFileACK(self, file, transfer, (FileACK) io);
+
+exit_function:
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+
+    return result;
+}
+
+static void
+fileServer_runTask(void* parameter, IMasterConnection connection)
+{
+    CS101_FileServer self = (CS101_FileServer) parameter;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    CS101_ServerTransfer transfer = getTransfer(self, connection);
+
+    if (transfer) {
+        if (transfer->state == SERVER_STATE_SENDING_SECTION) {
+            transfer->lastActivity = Hal_getTimeInMs();
+
+            sendSection(self, transfer);
+        }
+        else if (Hal_getTimeInMs() > transfer->lastActivity + self->timeout) {
+            DEBUG_PRINT("FILE SERVER: timeout (IOA=%i)\n", transfer->file->ioa);
+
+            finishTransfer(self, transfer, CS101_FILE_TRANSFER_FAILED);
+        }
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+}
+
+/* the connection object is reused for the next client -> the transfer must not be continued */
+static void
+fileServer_connectionClosed(void* parameter, IMasterConnection connection)
+{
+    CS101_FileServer self = (CS101_FileServer) parameter;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    CS101_ServerTransfer transfer = getTransfer(self, connection);
+
+    if (transfer) {
+        DEBUG_PRINT("FILE SERVER: connection closed (IOA=%i)\n", transfer->file->ioa);
+
+        finishTransfer(self, transfer, CS101_FILE_TRANSFER_FAILED);
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+}
+
+CS101_SlavePlugin
+CS101_FileServer_getSlavePlugin(CS101_FileServer self)
+{
+    return &(self->plugin);
+}
+
+void
+CS101_FileServer_destroy(CS101_FileServer self)
+{
+    if (self) {
+        LinkedList_destroy(self->transfers);
+        LinkedList_destroy(self->files);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_destroy(self->lock);
+#endif
+
+        GLOBAL_FREEMEM(self);
+    }
+}
+
+/********************************************
+ * File client
+ ********************************************/
+
+typedef enum
+{
+    CLIENT_STATE_IDLE,
+    CLIENT_STATE_WAIT_FOR_FILE_READY,
+    CLIENT_STATE_WAIT_FOR_SECTION_READY,
+    CLIENT_STATE_RECEIVING_SECTION
+} eClientTransferState;
+
+struct sCS101_FileClient
+{
+    CS101_AppLayerParameters alParameters;
+
+    CS101_FileClientSendHandler sendHandler;
+    void* sendHandlerParameter;
+
+    CS101_FileTransferProgressHandler progressHandler;
+    void* progressHandlerParameter;
+
+    int timeout;
+
+    eClientTransferState state;
+
+    int ca;
+    int ioa;
+    uint16_t nof;
+
+    CS101_FileWriteHandler writeHandler;
+    void* writeHandlerParameter;
+
+    uint32_t lengthOfFile;
+
+    uint8_t nos;
+    uint32_t sectionStart;
+    uint32_t sectionOffset; /* number of bytes of the section that have been received */
+
+    uint8_t sectionChecksum;
+    uint8_t fileChecksum;
+
+    uint64_t lastActivity;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex lock;
+#endif
+};
+
+CS101_FileClient
+CS101_FileClient_create(CS101_AppLayerParameters alParameters, CS101_FileClientSendHandler sendHandler, void* parameter)
+{
+    CS101_FileClient self = (CS101_FileClient) GLOBAL_CALLOC(1, sizeof(struct sCS101_FileClient));
+
+    if (self) {
+        self->alParameters = alParameters;
+        self->sendHandler = sendHandler;
+        self->sendHandlerParameter = parameter;
+        self->timeout = FILE_SERVICE_DEFAULT_TIMEOUT;
+        self->state = CLIENT_STATE_IDLE;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        self->lock = Mutex_create();
+#endif
+    }
+
+    return self;
+}
+
+static bool
+cs104ConnectionSendHandler(void* parameter, CS101_ASDU asdu)
+{
+    return CS104_Connection_sendASDU((CS104_Connection) parameter, asdu);
+}
+
+CS101_FileClient
+CS101_FileClient_createForCS104Connection(CS104_Connection connection)
+{
+    return CS101_FileClient_create(CS104_Connection_getAppLayerParameters(connection), cs104ConnectionSendHandler, connection);
+}
+
+void
+CS101_FileClient_setTimeout(CS101_FileClient self, int timeoutInMs)
+{
+    self->timeout = timeoutInMs;
+}
+
+void
+CS101_FileClient_setProgressHandler(CS101_FileClient self, CS101_FileTransferProgressHandler handler, void* parameter)
+{
+    self->progressHandler = handler;
+    self->progressHandlerParameter = parameter;
+}
+
+static bool
+sendRequest(CS101_FileClient self, InformationObject io)
+{
+    sCS101_StaticASDU _asdu;
+
+    CS101_ASDU asdu = CS101_ASDU_initializeStatic(&_asdu, self->alParameters, false, CS101_COT_FILE_TRANSFER,
+            self->alParameters->originatorAddress, self->ca, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, io);
+
+    return self->sendHandler(self->sendHandlerParameter, asdu);
+}
+
+static bool
+sendCallOrSelect(CS101_FileClient self, uint8_t nos, uint8_t scq)
+{
+    struct sFileCallOrSelect _fcs;
+
+    FileCallOrSelect fcs = FileCallOrSelect_create(&_fcs, self->ioa, self->nof, nos, scq);
+
+    return sendRequest(self, (InformationObject) fcs);
+}
+
+static bool
+sendFileACK(CS101_FileClient self, uint8_t nos, uint8_t afq)
+{
+    struct sFileACK _fileAck;
+
+    FileACK fileAck = FileACK_create(&_fileAck, self->ioa, self->nof, nos, afq);
+
+    return sendRequest(self, (InformationObject) fileAck);
+}
+
+static void
+clientReportProgress(CS101_FileClient self, CS101_FileTransferState state)
+{
+    if (self->progressHandler)
+        self->progressHandler(self->progressHandlerParameter, self->ca, self->ioa, self->nof, state,
+                self->sectionStart + self->sectionOffset, self->lengthOfFile);
+}
+
+static void
+clientFinishTransfer(CS101_FileClient self, CS101_FileTransferState state)
+{
+    self->state = CLIENT_STATE_IDLE;
+
+    clientReportProgress(self, state);
+}
+
+bool
+CS101_FileClient_getFile(CS101_FileClient self, int ca, int ioa, uint16_t nof, CS101_FileWriteHandler handler, void* parameter)
+{
+    bool retVal = false;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    if (self->state == CLIENT_STATE_IDLE) {
+        self->ca = ca;
+        self->ioa = ioa;
+        self->nof = nof;
+        self->writeHandler = handler;
+        self->writeHandlerParameter = parameter;
+
+        self->lengthOfFile = 0;
+        self->nos = 0;
+        self->sectionStart = 0;
+        self->sectionOffset = 0;
+        self->sectionChecksum = 0;
+        self->fileChecksum = 0;
+
+        self->lastActivity = Hal_getTimeInMs();
+
+        /* the state has to be set before sending because the response can be received immediately */
+        self->state = CLIENT_STATE_WAIT_FOR_FILE_READY;
+
+        if (sendCallOrSelect(self, 0, CS101_SCQ_SELECT_FILE))
+            retVal = true;
+        else
+            self->state = CLIENT_STATE_IDLE;
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+
+    return retVal;
+}
+
+static void
+handleSegment(CS101_FileClient self, FileSegment segment)
+{
+    int size = FileSegment_getLengthOfSegment(segment);
+
+    uint8_t* data = FileSegment_getSegmentData(segment);
+
+    if ((self->sectionStart + self->sectionOffset + size) > self->lengthOfFile) {
+        DEBUG_PRINT("FILE CLIENT: segment exceeds the length of the file\n");
+
+        sendCallOrSelect(self, self->nos, CS101_SCQ_DEACTIVATE_FILE);
+        clientFinishTransfer(self, CS101_FILE_TRANSFER_FAILED);
+
+        return;
+    }
+
+    /* the data is passed directly from the received message */
+    if (self->writeHandler(self->writeHandlerParameter, self->sectionStart + self->sectionOffset, data, size) == false) {
+        sendCallOrSelect(self, self->nos, CS101_SCQ_DEACTIVATE_FILE);
+        clientFinishTransfer(self, CS101_FILE_TRANSFER_FAILED);
+
+        return;
+    }
+
+    self->sectionChecksum = addToChecksum(self->sectionChecksum, data, size);
+    self->sectionOffset += size;
+
+    clientReportProgress(self, CS101_FILE_TRANSFER_IN_PROGRESS);
+}
+
+static void
+handleLastSegmentOrSection(CS101_FileClient self, FileLastSegmentOrSection last)
+{
+    uint8_t lsq = FileLastSegmentOrSection_getLSQ(last);
+    uint8_t chs = FileLastSegmentOrSection_getCHS(last);
+
+    if ((self->state == CLIENT_STATE_RECEIVING_SECTION) && (lsq == CS101_LSQ_SECTION_TRANSFER_WITHOUT_DEACT)) {
+
+        if (chs == self->sectionChecksum) {
+            self->fileChecksum += self->sectionChecksum;
+
+            /* the next section starts at the end of this section */
+            self->sectionStart += self->sectionOffset;
+            self->sectionOffset = 0;
+
+            sendFileACK(self, self->nos, CS101_AFQ_POS_ACK_SECTION);
+        }
+        else {
+            DEBUG_PRINT("FILE CLIENT: checksum error in section %i\n", self->nos);
+
+            /* the section will be repeated */
+            self->sectionOffset = 0;
+
+            sendFileACK(self, self->nos, CS101_AFQ_NEG_ACK_SECTION | (CS101_FILE_ERROR_CHECKSUM_FAILED << 4));
+        }
+
+        self->state = CLIENT_STATE_WAIT_FOR_SECTION_READY;
+    }
+    else if ((self->state == CLIENT_STATE_WAIT_FOR_SECTION_READY) && (lsq == CS101_LSQ_FILE_TRANSFER_WITHOUT_DEACT)) {
+
+        if ((chs == self->fileChecksum) && (self->sectionStart == self->lengthOfFile)) {
+            sendFileACK(self, 0, CS101_AFQ_POS_ACK_FILE);
+            clientFinishTransfer(self, CS101_FILE_TRANSFER_SUCCESS);
+        }
+        else {
+            sendFileACK(self, 0, CS101_AFQ_NEG_ACK_FILE | (CS101_FILE_ERROR_CHECKSUM_FAILED << 4));
+            clientFinishTransfer(self, CS101_FILE_TRANSFER_FAILED);
+        }
+    }
+    else {
+        /* transfer has been deactivated by the slave */
+        clientFinishTransfer(self, CS101_FILE_TRANSFER_FAILED);
+    }
+}
+
+bool
+CS101_FileClient_handleASDU(CS101_FileClient self, CS101_ASDU asdu)
+{
+    bool retVal = false;
+
+    TypeID typeId = CS101_ASDU_getTypeID(asdu);
+
+    if ((typeId < F_FR_NA_1) || (typeId > F_SG_NA_1))
+        return false;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    if ((self->state == CLIENT_STATE_IDLE) || (CS101_ASDU_getCA(asdu) != self->ca))
+        goto exit_function;
+
+    union uInformationObject _io;
+
+    InformationObject io = CS101_ASDU_getElementEx(asdu, (InformationObject) &_io, 0);
+
+    if ((io == NULL) || (InformationObject_getObjectAddress(io) != self->ioa))
+        goto exit_function;
+
+    retVal = true;
+
+    self->lastActivity = Hal_getTimeInMs();
+
+    switch (typeId) {
+
+    case F_FR_NA_1: /* 120 - file ready */
+
+        if (self->state == CLIENT_STATE_WAIT_FOR_FILE_READY) {
+            FileReady fileReady = (FileReady) io;
+
+            if (FileReady_isPositive(fileReady) && (CS101_ASDU_isNegative(asdu) == false)) {
+                self->lengthOfFile = FileReady_getLengthOfFile(fileReady);
+                self->state = CLIENT_STATE_WAIT_FOR_SECTION_READY;
+
+                sendCallOrSelect(self, 0, CS101_SCQ_REQUEST_FILE);
+            }
+            else {
+                DEBUG_PRINT("FILE CLIENT: file not ready\n");
+                clientFinishTransfer(self, CS101_FILE_TRANSFER_FAILED);
+            }
+        }
+
+        break;
+
+    case F_SR_NA_1: /* 121 - section ready */
+
+        if (self->state == CLIENT_STATE_WAIT_FOR_SECTION_READY) {
+            SectionReady sectionReady = (SectionReady) io;
+
+            if (SectionReady_isNotReady(sectionReady) == false) {
+                self->nos = SectionReady_getNameOfSection(sectionReady);
+                self->sectionOffset = 0;
+                self->sectionChecksum = 0;
+                self->state = CLIENT_STATE_RECEIVING_SECTION;
+
+                sendCallOrSelect(self, self->nos, CS101_SCQ_REQUEST_SECTION);
+            }
+        }
+
+        break;
+
+    case F_SG_NA_1: /* 125 - segment */
+
+        if ((self->state == CLIENT_STATE_RECEIVING_SECTION) && (FileSegment_getNameOfSection((FileSegment) io) == self->nos))
+            handleSegment(self, (FileSegment) io);
+
+        break;
+
+    case F_LS_NA_1: /* 123 - last segment/section */
+
+        handleLastSegmentOrSection(self, (FileLastSegmentOrSection) io);
+
+        break;
+
+    default:
+        break;
+    }
+
+exit_function:
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+
+    return retVal;
+}
+
+void
+CS101_FileClient_run(CS101_FileClient self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    if (self->state != CLIENT_STATE_IDLE) {
+        if (Hal_getTimeInMs() > self->lastActivity + self->timeout) {
+            DEBUG_PRINT("FILE CLIENT: timeout\n");
+
+            clientFinishTransfer(self, CS101_FILE_TRANSFER_FAILED);
+        }
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+}
+
+bool
+CS101_FileClient_isBusy(CS101_FileClient self)
+{
+    return (self->state != CLIENT_STATE_IDLE);
+}
+
+void
+CS101_FileClient_abort(CS101_FileClient self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    if (self->state != CLIENT_STATE_IDLE) {
+        sendCallOrSelect(self, 0, CS101_SCQ_DEACTIVATE_FILE);
+
+        clientFinishTransfer(self, CS101_FILE_TRANSFER_FAILED);
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+}
+
+void
+CS101_FileClient_destroy(CS101_FileClient self)
+{
+    if (self) {
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_destroy(self->lock);
+#endif
+
+        GLOBAL_FREEMEM(self);
+    }
+}
@@ -6799,7 +6799,8 @@ FileReady_setFRQ(FileReady self, uint8_t frq)
 bool
 FileReady_isPositive(FileReady self)
 {
-    return ((self->frq & 0x80) == 0x80);
+    /* bit 8 of FRQ is set for a negative confirm */
+    return ((self->frq & 0x80) == 0);
 }
 
 uint16_t
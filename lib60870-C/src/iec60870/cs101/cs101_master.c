@@ -35,6 +35,7 @@
 #include "cs101_master.h"
 #include "cs101_queue.h"
 #include "cs101_asdu_internal.h"
+#include "cs101_internal.h"
 
 
 struct sCS101_Master
@@ -56,11 +57,15 @@ struct sCS101_Master
     CS101_ASDUReceivedHandler asduReceivedHandler;
     void* asduReceivedHandlerParameter;
 
+    CS101_ASDUSentHandler asduSentHandler;
+    void* asduSentHandlerParameter;
+
     struct sCS101_Queue userDataQueue;
 
 #if (CONFIG_USE_THREADS == 1)
     bool isRunning;
     Thread workerThread;
+    struct sThreadAttributes threadAttributes;
 #endif
 };
 
@@ -155,19 +160,36 @@ IPrimaryApplicationLayer_Timeout (void* parameter, int slaveAddress)
     UNUSED_PARAMETER(slaveAddress);
 }
 
+static void
+IPrimaryApplicationLayer_SendCompleted(void* parameter, int slaveAddress, uint8_t* msg, int msgSize, bool success)
+{
+    CS101_Master self = (CS101_Master) parameter;
+
+    if (self->asduSentHandler) {
+        CS101_ASDU asdu = CS101_ASDU_createFromBuffer(&(self->alParameters), msg, msgSize);
+
+        if (asdu) {
+            self->asduSentHandler(self->asduSentHandlerParameter, slaveAddress, asdu, success);
+
+            CS101_ASDU_destroy(asdu);
+        }
+    }
+}
+
 static struct sIPrimaryApplicationLayer cs101UnbalancedAppLayerInterface = {
     IPrimaryApplicationLayer_AccessDemand,
     IPrimaryApplicationLayer_UserData,
-    IPrimaryApplicationLayer_Timeout
+    IPrimaryApplicationLayer_Timeout,
+    IPrimaryApplicationLayer_SendCompleted
 };
 
 /********************************************
  * END IPrimaryApplicationLayer
  ********************************************/
 
-CS101_Master
-CS101_Master_createEx(SerialPort serialPort, LinkLayerParameters llParameters, CS101_AppLayerParameters alParameters, IEC60870_LinkLayerMode linkLayerMode,
-        int queueSize)
+static CS101_Master
+createInstance(SerialPort serialPort, CS101_Transport transport, LinkLayerParameters llParameters, CS101_AppLayerParameters alParameters,
+        IEC60870_LinkLayerMode linkLayerMode, int queueSize)
 {
     CS101_Master self = (CS101_Master) GLOBAL_MALLOC(sizeof(struct sCS101_Master));
 
@@ -187,7 +209,10 @@ CS101_Master_createEx(SerialPort serialPort, LinkLayerParameters llParameters, C
         else
             self->alParameters = defaultAppLayerParameters;
 
-        self->transceiver = SerialTransceiverFT12_create(serialPort,  &(self->linkLayerParameters));
+        if (transport)
+            self->transceiver = SerialTransceiverFT12_createWithTransport(transport, &(self->linkLayerParameters));
+        else
+            self->transceiver = SerialTransceiverFT12_create(serialPort, &(self->linkLayerParameters));
 
         self->linkLayerMode = linkLayerMode;
 
@@ -211,10 +236,14 @@ CS101_Master_createEx(SerialPort serialPort, LinkLayerParameters llParameters, C
         }
 
         self->asduReceivedHandler = NULL;
+        self->asduSentHandler = NULL;
 
 #if (CONFIG_USE_THREADS == 1)
         self->isRunning = false;
         self->workerThread = NULL;
+
+        ThreadAttributes_init(&(self->threadAttributes));
+        ThreadAttributes_setName(&(self->threadAttributes), "iec101-master");
 #endif
 
     }
@@ -222,6 +251,20 @@ CS101_Master_createEx(SerialPort serialPort, LinkLayerParameters llParameters, C
     return self;
 }
 
+CS101_Master
+CS101_Master_createEx(SerialPort serialPort, LinkLayerParameters llParameters, CS101_AppLayerParameters alParameters, IEC60870_LinkLayerMode linkLayerMode,
+        int queueSize)
+{
+    return createInstance(serialPort, NULL, llParameters, alParameters, linkLayerMode, queueSize);
+}
+
+CS101_Master
+CS101_Master_createWithTransport(CS101_Transport transport, LinkLayerParameters llParameters, CS101_AppLayerParameters alParameters,
+        IEC60870_LinkLayerMode linkLayerMode, int queueSize)
+{
+    return createInstance(NULL, transport, llParameters, alParameters, linkLayerMode, queueSize);
+}
+
 CS101_Master
 CS101_Master_create(SerialPort serialPort, LinkLayerParameters llParameters, CS101_AppLayerParameters alParameters, IEC60870_LinkLayerMode linkLayerMode)
 {
@@ -239,6 +282,12 @@ CS101_Master_run(CS101_Master self)
         LinkLayerBalanced_run(self->balancedLinkLayer);
 }
 
+SerialTransceiverFT12
+CS101_Master_getTransceiver(CS101_Master self)
+{
+    return self->transceiver;
+}
+
 #if (CONFIG_USE_THREADS == 1)
 static void*
 masterMainThread(void* parameter)
@@ -255,12 +304,21 @@ masterMainThread(void* parameter)
 }
 #endif /* (CONFIG_USE_THREADS == 1) */
 
+void
+CS101_Master_setThreadAttributes(CS101_Master self, ThreadAttributes attributes)
+{
+#if (CONFIG_USE_THREADS == 1)
+    self->threadAttributes = *attributes;
+#endif
+}
+
 void
 CS101_Master_start(CS101_Master self)
 {
 #if (CONFIG_USE_THREADS == 1)
     if (self->workerThread == NULL) {
         self->workerThread = Thread_create(masterMainThread, self, false);
+        Thread_setAttributes(self->workerThread, &(self->threadAttributes));
         Thread_start(self->workerThread);
     }
 #endif /* (CONFIG_USE_THREADS == 1) */
@@ -471,10 +529,15 @@ CS101_Master_sendASDU(CS101_Master self, CS101_ASDU asdu)
 
         CS101_ASDU_encode(asdu, (Frame) &bufferFrame);
 
+        /* process commands are sent before other queued messages (e.g. interrogation commands) */
+        TypeID typeId = CS101_ASDU_getTypeID(asdu);
+
+        bool highPriority = ((typeId >= C_SC_NA_1) && (typeId <= C_BO_TA_1));
+
         if (isBroadcastAddress(self, self->slaveAddress))
-            LinkLayerPrimaryUnbalanced_sendNoReply(self->unbalancedLinkLayer, self->slaveAddress, &bufferFrame);
-        else
-            LinkLayerPrimaryUnbalanced_sendConfirmed(self->unbalancedLinkLayer, self->slaveAddress, &bufferFrame);
+            LinkLayerPrimaryUnbalanced_sendNoReply(self->unbalancedLinkLayer, self->slaveAddress, &bufferFrame, highPriority);
+        else if (LinkLayerPrimaryUnbalanced_sendConfirmed(self->unbalancedLinkLayer, self->slaveAddress, &bufferFrame, highPriority) == false)
+            DEBUG_PRINT("MASTER: transmit queue of slave %i full -> ASDU dropped\n", self->slaveAddress);
     }
     else
         CS101_Queue_enqueue(&(self->userDataQueue), asdu);
@@ -495,6 +558,27 @@ CS101_Master_pollSingleSlave(CS101_Master self, int address)
     }
 }
 
+void
+CS101_Master_setSlavePollIntervals(CS101_Master self, int address, int class1IntervalInMs, int class2IntervalInMs)
+{
+    if (self->unbalancedLinkLayer)
+        LinkLayerPrimaryUnbalanced_setPollIntervals(self->unbalancedLinkLayer, address, class1IntervalInMs, class2IntervalInMs);
+}
+
+void
+CS101_Master_setSlaveRetryDelay(CS101_Master self, int minDelayInMs, int maxDelayInMs)
+{
+    if (self->unbalancedLinkLayer)
+        LinkLayerPrimaryUnbalanced_setRetryDelay(self->unbalancedLinkLayer, minDelayInMs, maxDelayInMs);
+}
+
+void
+CS101_Master_setASDUSentHandler(CS101_Master self, CS101_ASDUSentHandler handler, void* parameter)
+{
+    self->asduSentHandler = handler;
+    self->asduSentHandlerParameter = parameter;
+}
+
 void
 CS101_Master_setASDUReceivedHandler(CS101_Master self, CS101_ASDUReceivedHandler handler, void* parameter)
 {
@@ -528,3 +612,12 @@ CS101_Master_setIdleTimeout(CS101_Master self, int timeoutInMs)
     /* unbalanced primary layer does not support automatic idle detection */
 }
 
+void
+CS101_Master_setAdaptiveTimeouts(CS101_Master self, bool enable, int minTimeoutInMs, int maxTimeoutInMs)
+{
+    if (self->unbalancedLinkLayer)
+        LinkLayerPrimaryUnbalanced_setAdaptiveTimeouts(self->unbalancedLinkLayer, enable, minTimeoutInMs, maxTimeoutInMs);
+    else if (self->balancedLinkLayer)
+        LinkLayerBalanced_setAdaptiveTimeouts(self->balancedLinkLayer, enable, minTimeoutInMs, maxTimeoutInMs);
+}
+
@@ -29,6 +29,21 @@ IMasterConnection_isReady(IMasterConnection self)
     return self->isReady(self);
 }
 
+bool
+IMasterConnection_isReadyEx(IMasterConnection self, int* freeWindowSlots, int* freeQueueBytes)
+{
+    if (self->isReadyEx)
+        return self->isReadyEx(self, freeWindowSlots, freeQueueBytes);
+
+    if (freeWindowSlots)
+        *freeWindowSlots = 0;
+
+    if (freeQueueBytes)
+        *freeQueueBytes = 0;
+
+    return self->isReady(self);
+}
+
 bool
 IMasterConnection_sendASDU(IMasterConnection self, CS101_ASDU asdu)
 {
@@ -0,0 +1,869 @@
+/*
+ *  cs101_process_image.c
+ *
+ *  Copyright 2017 MZ Automation GmbH
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cs101_process_image.h"
+#include "information_objects_internal.h"
+#include "linked_list.h"
+#include "hal_thread.h"
+#include "hal_time.h"
+#include "lib_memory.h"
+#include "lib60870_config.h"
+#include "lib60870_internal.h"
+
+/* point tables (in the order of the interrogation response) */
+typedef enum
+{
+    PI_TABLE_SINGLE_POINT = 0,
+    PI_TABLE_DOUBLE_POINT,
+    PI_TABLE_STEP_POSITION,
+    PI_TABLE_BITSTRING,
+    PI_TABLE_NORMALIZED,
+    PI_TABLE_SCALED,
+    PI_TABLE_SHORT,
+    PI_NUMBER_OF_TABLES
+} ePointTable;
+
+/* 12 byte per point to keep the scans of large tables cache friendly */
+typedef struct
+{
+    int ioa;
+    uint16_t groups;
+    QualityDescriptor quality;
+    bool isTransient;
+
+    union {
+        int32_t i; /* single point, double point, step position, scaled value */
+        uint32_t u; /* bitstring */
+        float f; /* normalized value, short floating point value */
+    } value;
+} sProcessPoint;
+
+/* points of one type sorted by IOA */
+typedef struct
+{
+    sProcessPoint* points;
+    int numberOfPoints;
+    int maxPoints;
+} sPointTable;
+
+typedef struct sCS101_Interrogation* CS101_Interrogation;
+
+/* interrogation response that is sent to a master (at most one for each connection) */
+struct sCS101_Interrogation
+{
+    IMasterConnection connection;
+
+    int oa;
+    uint8_t qoi;
+
+    /* position of the next point */
+    int table;
+    int index;
+};
+
+struct sCS101_ProcessImage
+{
+    int ca;
+
+    sPointTable tables[PI_NUMBER_OF_TABLES];
+
+    bool eventsWithTimeTag;
+
+    CS101_AppLayerParameters alParameters;
+    CS101_ProcessImageEventHandler eventHandler;
+    void* eventHandlerParameter;
+
+    LinkedList interrogations;
+
+    struct sCS101_SlavePlugin plugin;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex lock;
+#endif
+};
+
+static CS101_SlavePlugin_Result
+processImage_handleAsdu(void* parameter, IMasterConnection connection, CS101_ASDU asdu);
+
+static void
+processImage_runTask(void* parameter, IMasterConnection connection);
+
+static void
+processImage_connectionClosed(void* parameter, IMasterConnection connection);
+
+CS101_ProcessImage
+CS101_ProcessImage_create(int ca)
+{
+    CS101_ProcessImage self = (CS101_ProcessImage) GLOBAL_CALLOC(1, sizeof(struct sCS101_ProcessImage));
+
+    if (self) {
+        self->ca = ca;
+        self->eventsWithTimeTag = true;
+        self->interrogations = LinkedList_create();
+
+        self->plugin.handleAsdu = processImage_handleAsdu;
+        self->plugin.runTask = processImage_runTask;
+        self->plugin.parameter = self;
+        self->plugin.connectionClosed = processImage_connectionClosed;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        self->lock = Mutex_create();
+#endif
+    }
+
+    return self;
+}
+
+static int
+getTableForType(TypeID type)
+{
+    switch (type) {
+    case M_SP_NA_1:
+        return PI_TABLE_SINGLE_POINT;
+    case M_DP_NA_1:
+        return PI_TABLE_DOUBLE_POINT;
+    case M_ST_NA_1:
+        return PI_TABLE_STEP_POSITION;
+    case M_BO_NA_1:
+        return PI_TABLE_BITSTRING;
+    case M_ME_NA_1:
+        return PI_TABLE_NORMALIZED;
+    case M_ME_NB_1:
+        return PI_TABLE_SCALED;
+    case M_ME_NC_1:
+        return PI_TABLE_SHORT;
+    default:
+        return -1;
+    }
+}
+
+/* index of the first point with an IOA >= ioa */
+static int
+findLowerBound(sPointTable* table, int ioa)
+{
+    int low = 0;
+    int high = table->numberOfPoints;
+
+    while (low < high) {
+        int mid = (low + high) / 2;
+
+        if (table->points[mid].ioa < ioa)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+static sProcessPoint*
+getPoint(sPointTable* table, int ioa)
+{
+    int index = findLowerBound(table, ioa);
+
+    if ((index < table->numberOfPoints) && (table->points[index].ioa == ioa))
+        return &(table->points[index]);
+    else
+        return NULL;
+}
+
+/* check if one of the IOAs firstIoa ... lastIoa is used by any table */
+static bool
+isIoaRangeUsed(CS101_ProcessImage self, int firstIoa, int lastIoa)
+{
+    int t;
+
+    for (t = 0; t < PI_NUMBER_OF_TABLES; t++) {
+        sPointTable* table = &(self->tables[t]);
+
+        int index = findLowerBound(table, firstIoa);
+
+        if ((index < table->numberOfPoints) && (table->points[index].ioa <= lastIoa))
+            return true;
+    }
+
+    return false;
+}
+
+bool
+CS101_ProcessImage_addPoints(CS101_ProcessImage self, TypeID type, int firstIoa, int numberOfPoints, uint16_t groups)
+{
+    bool retVal = false;
+
+    int tableIndex = getTableForType(type);
+
+    if ((tableIndex == -1) || (numberOfPoints < 1))
+        return false;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    sPointTable* table = &(self->tables[tableIndex]);
+
+    if (isIoaRangeUsed(self, firstIoa, firstIoa + numberOfPoints - 1))
+        goto exit_function;
+
+    if (table->numberOfPoints + numberOfPoints > table->maxPoints) {
+        int newMaxPoints = (table->maxPoints == 0) ? 64 : (table->maxPoints * 2);
+
+        if (newMaxPoints < table->numberOfPoints + numberOfPoints)
+            newMaxPoints = table->numberOfPoints + numberOfPoints;
+
+        sProcessPoint* newPoints = (sProcessPoint*) GLOBAL_REALLOC(table->points, newMaxPoints * sizeof(sProcessPoint));
+
+        if (newPoints == NULL)
+            goto exit_function;
+
+        table->points = newPoints;
+        table->maxPoints = newMaxPoints;
+    }
+
+    /* keep the table sorted (new points are usually appended) */
+    int index = findLowerBound(table, firstIoa);
+
+    if (index < table->numberOfPoints)
+        memmove(&(table->points[index + numberOfPoints]), &(table->points[index]),
+                (table->numberOfPoints - index) * sizeof(sProcessPoint));
+
+    int i;
+
+    for (i = 0; i < numberOfPoints; i++) {
+        sProcessPoint* point = &(table->points[index + i]);
+
+        point->ioa = firstIoa + i;
+        point->groups = groups;
+        point->quality = IEC60870_QUALITY_INVALID;
+        point->isTransient = false;
+        point->value.u = 0;
+    }
+
+    table->numberOfPoints += numberOfPoints;
+
+    retVal = true;
+
+exit_function:
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+
+    return retVal;
+}
+
+int
+CS101_ProcessImage_getNumberOfPoints(CS101_ProcessImage self)
+{
+    int numberOfPoints = 0;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    int t;
+
+    for (t = 0; t < PI_NUMBER_OF_TABLES; t++)
+        numberOfPoints += self->tables[t].numberOfPoints;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+
+    return numberOfPoints;
+}
+
+void
+CS101_ProcessImage_setEventsWithTimeTag(CS101_ProcessImage self, bool withTimeTag)
+{
+    self->eventsWithTimeTag = withTimeTag;
+}
+
+void
+CS101_ProcessImage_setEventHandler(CS101_ProcessImage self, CS101_AppLayerParameters alParameters,
+        CS101_ProcessImageEventHandler handler, void* parameter)
+{
+    self->alParameters = alParameters;
+    self->eventHandler = handler;
+    self->eventHandlerParameter = parameter;
+}
+
+CS101_SlavePlugin
+CS101_ProcessImage_getSlavePlugin(CS101_ProcessImage self)
+{
+    return &(self->plugin);
+}
+
+static void
+cs104SlaveEventHandler(void* parameter, CS101_ASDU asdu)
+{
+    CS104_Slave_enqueueASDU((CS104_Slave) parameter, asdu);
+}
+
+void
+CS101_ProcessImage_attachToCS104Slave(CS101_ProcessImage self, CS104_Slave slave)
+{
+    CS104_Slave_addPlugin(slave, &(self->plugin));
+    CS101_ProcessImage_setEventHandler(self, CS104_Slave_getAppLayerParameters(slave), cs104SlaveEventHandler, slave);
+}
+
+static void
+cs101SlaveEventHandler(void* parameter, CS101_ASDU asdu)
+{
+    CS101_Slave_enqueueUserDataClass1((CS101_Slave) parameter, asdu);
+}
+
+void
+CS101_ProcessImage_attachToCS101Slave(CS101_ProcessImage self, CS101_Slave slave)
+{
+    CS101_Slave_addPlugin(slave, &(self->plugin));
+    CS101_ProcessImage_setEventHandler(self, CS101_Slave_getAppLayerParameters(slave), cs101SlaveEventHandler, slave);
+}
+
+/* create the information object of the interrogation/read response (without time tag) */
+static InformationObject
+createInformationObject(int tableIndex, sProcessPoint* point, union uInformationObject* io)
+{
+    switch (tableIndex) {
+    case PI_TABLE_SINGLE_POINT:
+        return (InformationObject) SinglePointInformation_create((SinglePointInformation) io, point->ioa,
+                (point->value.i != 0), point->quality);
+    case PI_TABLE_DOUBLE_POINT:
+        return (InformationObject) DoublePointInformation_create((DoublePointInformation) io, point->ioa,
+                (DoublePointValue) point->value.i, point->quality);
+    case PI_TABLE_STEP_POSITION:
+        return (InformationObject) StepPositionInformation_create((StepPositionInformation) io, point->ioa,
+                point->value.i, point->isTransient, point->quality);
+    case PI_TABLE_BITSTRING:
+        return (InformationObject) BitString32_createEx((BitString32) io, point->ioa, point->value.u, point->quality);
+    case PI_TABLE_NORMALIZED:
+        return (InformationObject) MeasuredValueNormalized_create((MeasuredValueNormalized) io, point->ioa,
+                point->value.f, point->quality);
+    case PI_TABLE_SCALED:
+        return (InformationObject) MeasuredValueScaled_create((MeasuredValueScaled) io, point->ioa,
+                point->value.i, point->quality);
+    case PI_TABLE_SHORT:
+        return (InformationObject) MeasuredValueShort_create((MeasuredValueShort) io, point->ioa,
+                point->value.f, point->quality);
+    default:
+        return NULL;
+    }
+}
+
+/* create the information object of an event (with CP56Time2a time tag) */
+static InformationObject
+createEventInformationObject(int tableIndex, sProcessPoint* point, CP56Time2a timestamp, union uInformationObject* io)
+{
+    switch (tableIndex) {
+    case PI_TABLE_SINGLE_POINT:
+        return (InformationObject) SinglePointWithCP56Time2a_create((SinglePointWithCP56Time2a) io, point->ioa,
+                (point->value.i != 0), point->quality, timestamp);
+    case PI_TABLE_DOUBLE_POINT:
+        return (InformationObject) DoublePointWithCP56Time2a_create((DoublePointWithCP56Time2a) io, point->ioa,
+                (DoublePointValue) point->value.i, point->quality, timestamp);
+    case PI_TABLE_STEP_POSITION:
+        return (InformationObject) StepPositionWithCP56Time2a_create((StepPositionWithCP56Time2a) io, point->ioa,
+                point->value.i, point->isTransient, point->quality, timestamp);
+    case PI_TABLE_BITSTRING:
+        return (InformationObject) Bitstring32WithCP56Time2a_createEx((Bitstring32WithCP56Time2a) io, point->ioa,
+                point->value.u, point->quality, timestamp);
+    case PI_TABLE_NORMALIZED:
+        return (InformationObject) MeasuredValueNormalizedWithCP56Time2a_create((MeasuredValueNormalizedWithCP56Time2a) io, point->ioa,
+                point->value.f, point->quality, timestamp);
+    case PI_TABLE_SCALED:
+        return (InformationObject) MeasuredValueScaledWithCP56Time2a_create((MeasuredValueScaledWithCP56Time2a) io, point->ioa,
+                point->value.i, point->quality, timestamp);
+    case PI_TABLE_SHORT:
+        return (InformationObject) MeasuredValueShortWithCP56Time2a_create((MeasuredValueShortWithCP56Time2a) io, point->ioa,
+                point->value.f, point->quality, timestamp);
+    default:
+        return NULL;
+    }
+}
+
+
+static void
+sendEvent(CS101_ProcessImage self, int tableIndex, sProcessPoint* point, CP56Time2a timestamp)
+{
+    union uInformationObject _io;
+    InformationObject io;
+
+    if (self->eventsWithTimeTag) {
+        struct sCP56Time2a currentTime;
+
+        if (timestamp == NULL) {
+            CP56Time2a_createFromMsTimestamp(&currentTime, Hal_getTimeInMs());
+            timestamp = &currentTime;
+        }
+
+        io = createEventInformationObject(tableIndex, point, timestamp, &_io);
+    }
+    else
+        io = createInformationObject(tableIndex, point, &_io);
+
+    sCS101_StaticASDU _asdu;
+
+    CS101_ASDU asdu = CS101_ASDU_initializeStatic(&_asdu, self->alParameters, false, CS101_COT_SPONTANEOUS,
+            self->alParameters->originatorAddress, self->ca, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, io);
+
+    self->eventHandler(self->eventHandlerParameter, asdu);
+}
+
+/* store the new value and create an event when the value or the quality has changed */
+static bool
+updatePoint(CS101_ProcessImage self, int tableIndex, int ioa, sProcessPoint* newValue, CP56Time2a timestamp)
+{
+    bool retVal = false;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    sProcessPoint* point = getPoint(&(self->tables[tableIndex]), ioa);
+
+    if (point) {
+
+        if ((point->value.u != newValue->value.u) || (point->quality != newValue->quality) ||
+                (point->isTransient != newValue->isTransient))
+        {
+            point->value = newValue->value;
+            point->quality = newValue->quality;
+            point->isTransient = newValue->isTransient;
+
+            if (self->eventHandler)
+                sendEvent(self, tableIndex, point, timestamp);
+        }
+
+        retVal = true;
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+
+    return retVal;
+}
+
+bool
+CS101_ProcessImage_updateSinglePoint(CS101_ProcessImage self, int ioa, bool value, QualityDescriptor quality, CP56Time2a timestamp)
+{
+    sProcessPoint newValue;
+
+    newValue.value.i = value ? 1 : 0;
+    newValue.quality = quality;
+    newValue.isTransient = false;
+
+    return updatePoint(self, PI_TABLE_SINGLE_POINT, ioa, &newValue, timestamp);
+}
+
+bool
+CS101_ProcessImage_updateDoublePoint(CS101_ProcessImage self, int ioa, DoublePointValue value, QualityDescriptor quality, CP56Time2a timestamp)
+{
+    sProcessPoint newValue;
+
+    newValue.value.i = (int32_t) value;
+    newValue.quality = quality;
+    newValue.isTransient = false;
+
+    return updatePoint(self, PI_TABLE_DOUBLE_POINT, ioa, &newValue, timestamp);
+}
+
+bool
+CS101_ProcessImage_updateStepPosition(CS101_ProcessImage self, int ioa, int value, bool isTransient, QualityDescriptor quality, CP56Time2a timestamp)
+{
+    sProcessPoint newValue;
+
+    newValue.value.i = value;
+    newValue.quality = quality;
+    newValue.isTransient = isTransient;
+
+    return updatePoint(self, PI_TABLE_STEP_POSITION, ioa, &newValue, timestamp);
+}
+
+bool
+CS101_ProcessImage_updateBitString32(CS101_ProcessImage self, int ioa, uint32_t value, QualityDescriptor quality, CP56Time2a timestamp)
+{
+    sProcessPoint newValue;
+
+    newValue.value.u = value;
+    newValue.quality = quality;
+    newValue.isTransient = false;
+
+    return updatePoint(self, PI_TABLE_BITSTRING, ioa, &newValue, timestamp);
+}
+
+bool
+CS101_ProcessImage_updateMeasuredValueNormalized(CS101_ProcessImage self, int ioa, float value, QualityDescriptor quality, CP56Time2a timestamp)
+{
+    sProcessPoint newValue;
+
+    newValue.value.f = value;
+    newValue.quality = quality;
+    newValue.isTransient = false;
+
+    return updatePoint(self, PI_TABLE_NORMALIZED, ioa, &newValue, timestamp);
+}
+
+bool
+CS101_ProcessImage_updateMeasuredValueScaled(CS101_ProcessImage self, int ioa, int value, QualityDescriptor quality, CP56Time2a timestamp)
+{
+    sProcessPoint newValue;
+
+    newValue.value.i = value;
+    newValue.quality = quality;
+    newValue.isTransient = false;
+
+    return updatePoint(self, PI_TABLE_SCALED, ioa, &newValue, timestamp);
+}
+
+bool
+CS101_ProcessImage_updateMeasuredValueShort(CS101_ProcessImage self, int ioa, float value, QualityDescriptor quality, CP56Time2a timestamp)
+{
+    sProcessPoint newValue;
+
+    newValue.value.f = value;
+    newValue.quality = quality;
+    newValue.isTransient = false;
+
+    return updatePoint(self, PI_TABLE_SHORT, ioa, &newValue, timestamp);
+}
+
+static CS101_Interrogation
+getInterrogation(CS101_ProcessImage self, IMasterConnection connection)
+{
+    LinkedList element = LinkedList_getNext(self->interrogations);
+
+    while (element) {
+        CS101_Interrogation interrogation = (CS101_Interrogation) LinkedList_getData(element);
+
+        if (interrogation->connection == connection)
+            return interrogation;
+
+        element = LinkedList_getNext(element);
+    }
+
+    return NULL;
+}
+
+static void
+removeInterrogation(CS101_ProcessImage self, CS101_Interrogation interrogation)
+{
+    LinkedList_remove(self->interrogations, interrogation);
+
+    GLOBAL_FREEMEM(interrogation);
+}
+
+static bool
+isInGroup(sProcessPoint* point, uint8_t qoi)
+{
+    if (qoi == IEC60870_QOI_STATION)
+        return true;
+    else
+        return ((point->groups & (1 << (qoi - IEC60870_QOI_STATION - 1))) != 0);
+}
+
+/* move the position to the next point of the interrogated group */
+static bool
+skipToNextPoint(CS101_ProcessImage self, CS101_Interrogation interrogation)
+{
+    while (interrogation->table < PI_NUMBER_OF_TABLES) {
+        sPointTable* table = &(self->tables[interrogation->table]);
+
+        while (interrogation->index < table->numberOfPoints) {
+            if (isInGroup(&(table->points[interrogation->index]), interrogation->qoi))
+                return true;
+
+            interrogation->index++;
+        }
+
+        interrogation->table++;
+        interrogation->index = 0;
+    }
+
+    return false;
+}
+
+/*
+ * Send the next ASDU of the interrogation response
+ *
+ * \return true when the ASDU has been sent, false otherwise
+ */
+static bool
+sendNextInterrogationASDU(CS101_ProcessImage self, CS101_Interrogation interrogation)
+{
+    sPointTable* table = &(self->tables[interrogation->table]);
+    sProcessPoint* points = table->points;
+
+    int index = interrogation->index;
+
+    /* use a sequence ASDU when the IOA of the next point is consecutive */
+    bool isSequence = ((index + 1) < table->numberOfPoints) && (points[index + 1].ioa == points[index].ioa + 1) &&
+            isInGroup(&(points[index + 1]), interrogation->qoi);
+
+    sCS101_StaticASDU _asdu;
+
+    CS101_ASDU asdu = CS101_ASDU_initializeStatic(&_asdu, IMasterConnection_getApplicationLayerParameters(interrogation->connection),
+            isSequence, (CS101_CauseOfTransmission) interrogation->qoi, interrogation->oa, self->ca, false, false);
+
+    while (index < table->numberOfPoints) {
+
+        if (isInGroup(&(points[index]), interrogation->qoi)) {
+
+            if (isSequence && (index > interrogation->index) && (points[index].ioa != points[index - 1].ioa + 1))
+                break;
+
+            union uInformationObject _io;
+
+            if (CS101_ASDU_addInformationObject(asdu, createInformationObject(interrogation->table, &(points[index]), &_io)) == false)
+                break; /* ASDU is full */
+        }
+        else if (isSequence)
+            break;
+
+        index++;
+    }
+
+    if (IMasterConnection_sendASDU(interrogation->connection, asdu)) {
+        interrogation->index = index;
+        return true;
+    }
+    else
+        return false;
+}
+
+/* send the interrogation response as long as the connection can take more messages */
+static void
+sendInterrogationResponse(CS101_ProcessImage self, CS101_Interrogation interrogation)
+{
+    while (IMasterConnection_isReady(interrogation->connection)) {
+
+        if (skipToNextPoint(self, interrogation)) {
+            if (sendNextInterrogationASDU(self, interrogation) == false)
+                break;
+        }
+        else {
+            sCS101_StaticASDU _asdu;
+
+            CS101_ASDU asdu = CS101_ASDU_initializeStatic(&_asdu, IMasterConnection_getApplicationLayerParameters(interrogation->connection),
+                    false, CS101_COT_ACTIVATION_TERMINATION, interrogation->oa, self->ca, false, false);
+
+            union uInformationObject _io;
+
+            CS101_ASDU_addInformationObject(asdu, (InformationObject) InterrogationCommand_create((InterrogationCommand) &_io, 0, interrogation->qoi));
+
+            if (IMasterConnection_sendACT_TERM(interrogation->connection, asdu))
+                removeInterrogation(self, interrogation);
+
+            break;
+        }
+    }
+}
+
+static void
+handleInterrogation(CS101_ProcessImage self, IMasterConnection connection, CS101_ASDU asdu, InterrogationCommand irc)
+{
+    uint8_t qoi = InterrogationCommand_getQOI(irc);
+
+    CS101_Interrogation interrogation = getInterrogation(self, connection);
+
+    if (CS101_ASDU_getCOT(asdu) == CS101_COT_ACTIVATION) {
+
+        if ((qoi < IEC60870_QOI_STATION) || (qoi > IEC60870_QOI_GROUP_16)) {
+            IMasterConnection_sendACT_CON(connection, asdu, true);
+            return;
+        }
+
+        /* a new interrogation command restarts the response */
+        if (interrogation == NULL) {
+            interrogation = (CS101_Interrogation) GLOBAL_CALLOC(1, sizeof(struct sCS101_Interrogation));
+
+            if (interrogation == NULL) {
+                IMasterConnection_sendACT_CON(connection, asdu, true);
+                return;
+            }
+
+            interrogation->connection = connection;
+
+            LinkedList_add(self->interrogations, interrogation);
+        }
+
+        interrogation->oa = CS101_ASDU_getOA(asdu);
+        interrogation->qoi = qoi;
+        interrogation->table = 0;
+        interrogation->index = 0;
+
+        IMasterConnection_sendACT_CON(connection, asdu, false);
+
+        sendInterrogationResponse(self, interrogation);
+    }
+    else if (CS101_ASDU_getCOT(asdu) == CS101_COT_DEACTIVATION) {
+
+        if (interrogation)
+            removeInterrogation(self, interrogation);
+
+        CS101_ASDU_setCOT(asdu, CS101_COT_DEACTIVATION_CON);
+        IMasterConnection_sendASDU(connection, asdu);
+    }
+    else {
+        CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_COT);
+        CS101_ASDU_setNegative(asdu, true);
+        IMasterConnection_sendASDU(connection, asdu);
+    }
+}
+
+static void
+handleRead(CS101_ProcessImage self, IMasterConnection connection, CS101_ASDU asdu, int ioa)
+{
+    if (CS101_ASDU_getCOT(asdu) != CS101_COT_REQUEST) {
+        CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_COT);
+        CS101_ASDU_setNegative(asdu, true);
+        IMasterConnection_sendASDU(connection, asdu);
+        return;
+    }
+
+    int t;
+
+    for (t = 0; t < PI_NUMBER_OF_TABLES; t++) {
+        sProcessPoint* point = getPoint(&(self->tables[t]), ioa);
+
+        if (point) {
+            sCS101_StaticASDU _asdu;
+
+            CS101_ASDU response = CS101_ASDU_initializeStatic(&_asdu, IMasterConnection_getApplicationLayerParameters(connection),
+                    false, CS101_COT_REQUEST, CS101_ASDU_getOA(asdu), self->ca, false, false);
+
+            union uInformationObject _io;
+
+            CS101_ASDU_addInformationObject(response, createInformationObject(t, point, &_io));
+
+            IMasterConnection_sendASDU(connection, response);
+
+            return;
+        }
+    }
+
+    CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_IOA);
+    CS101_ASDU_setNegative(asdu, true);
+    IMasterConnection_sendASDU(connection, asdu);
+}
+
+static CS101_SlavePlugin_Result
+processImage_handleAsdu(void* parameter, IMasterConnection connection, CS101_ASDU asdu)
+{
+    CS101_ProcessImage self = (CS101_ProcessImage) parameter;
+
+    TypeID typeId = CS101_ASDU_getTypeID(asdu);
+
+    if ((typeId != C_IC_NA_1) && (typeId != C_RD_NA_1))
+        return CS101_PLUGIN_RESULT_NOT_HANDLED;
+
+    /* requests for other CAs are left to the application */
+    if (CS101_ASDU_getCA(asdu) != self->ca)
+        return CS101_PLUGIN_RESULT_NOT_HANDLED;
+
+    union uInformationObject _io;
+
+    InformationObject io = CS101_ASDU_getElementEx(asdu, (InformationObject) &_io, 0);
+
+    if (io == NULL)
+        return CS101_PLUGIN_RESULT_INVALID_ASDU;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    if (typeId == C_IC_NA_1)
+        handleInterrogation(self, connection, asdu, (InterrogationCommand) io);
+    else
+        handleRead(self, connection, asdu, InformationObject_getObjectAddress(io));
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+
+    return CS101_PLUGIN_RESULT_HANDLED;
+}
+
+static void
+processImage_runTask(void* parameter, IMasterConnection connection)
+{
+    CS101_ProcessImage self = (CS101_ProcessImage) parameter;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    CS101_Interrogation interrogation = getInterrogation(self, connection);
+
+    if (interrogation)
+        sendInterrogationResponse(self, interrogation);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+}
+
+/* the connection object is reused for the next client -> the interrogation must not be continued */
+static void
+processImage_connectionClosed(void* parameter, IMasterConnection connection)
+{
+    CS101_ProcessImage self = (CS101_ProcessImage) parameter;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->lock);
+#endif
+
+    CS101_Interrogation interrogation = getInterrogation(self, connection);
+
+    if (interrogation)
+        removeInterrogation(self, interrogation);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->lock);
+#endif
+}
+
+void
+CS101_ProcessImage_destroy(CS101_ProcessImage self)
+{
+    if (self) {
+        int t;
+
+        for (t = 0; t < PI_NUMBER_OF_TABLES; t++)
+            GLOBAL_FREEMEM(self->tables[t].points);
+
+        LinkedList_destroy(self->interrogations);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_destroy(self->lock);
+#endif
+
+        GLOBAL_FREEMEM(self);
+    }
+}
@@ -31,6 +31,7 @@
 #include "lib60870_internal.h"
 #include "apl_types_internal.h"
 #include "cs101_queue.h"
+#include "cs101_asdu_internal.h"
 
 /********************************************
  * CS101_Queue
@@ -39,12 +40,13 @@
 void
 CS101_Queue_initialize(CS101_Queue self, int maxQueueSize)
 {
+    self->usedBytes = 0;
     self->entryCounter = 0;
     self->firstMsgIndex = 0;
     self->lastMsgIndex = 0;
-    self->size = maxQueueSize;
 
-    BufferFrame_initialize(&(self->encodeFrame), NULL, 0);
+    self->overflowHandler = NULL;
+    self->overflowHandlerParameter = NULL;
 
 #if (CS101_MAX_QUEUE_SIZE == -1)
     int queueSize = maxQueueSize;
@@ -52,16 +54,18 @@ CS101_Queue_initialize(CS101_Queue self, int maxQueueSize)
     if (maxQueueSize == -1)
         queueSize = 100;
 
-    self->elements = (CS101_QueueElement) GLOBAL_CALLOC(queueSize, sizeof(struct sCS101_QueueElement));
+    self->buffer = (uint8_t*) GLOBAL_MALLOC(queueSize * CS101_QUEUE_ELEMENT_SIZE);
 
-    self->size = queueSize;
+    self->size = queueSize * CS101_QUEUE_ELEMENT_SIZE;
 #else
-    self->size = CS101_MAX_QUEUE_SIZE;
+    UNUSED_PARAMETER(maxQueueSize);
+
+    self->size = CS101_MAX_QUEUE_SIZE * CS101_QUEUE_ELEMENT_SIZE;
 #endif
 
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    self->queueLock = Semaphore_create(1);
+    self->queueLock = Mutex_create();
 #endif
 }
 
@@ -69,19 +73,26 @@ void
 CS101_Queue_dispose(CS101_Queue self)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_destroy(self->queueLock);
+    Mutex_destroy(self->queueLock);
 #endif
 
 #if (CS101_MAX_QUEUE_SIZE == -1)
-    GLOBAL_FREEMEM(self->elements);
+    GLOBAL_FREEMEM(self->buffer);
 #endif
 }
 
+void
+CS101_Queue_setOverflowHandler(CS101_Queue self, CS101_QueueOverflowHandler handler, void* parameter)
+{
+    self->overflowHandler = handler;
+    self->overflowHandlerParameter = parameter;
+}
+
 void
 CS101_Queue_lock(CS101_Queue self)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->queueLock);
+    Mutex_lock(self->queueLock);
 #endif
 }
 
@@ -89,63 +100,167 @@ void
 CS101_Queue_unlock(CS101_Queue self)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->queueLock);
+    Mutex_unlock(self->queueLock);
 #endif
 }
 
-void
-CS101_Queue_enqueue(CS101_Queue self, CS101_ASDU asdu)
+static void
+writeBytes(CS101_Queue self, int position, uint8_t* data, int length)
 {
-    CS101_Queue_lock(self);
+    int firstPart = self->size - position;
 
-    int nextIndex;
-    bool removeEntry = false;
+    if (firstPart >= length)
+        memcpy(self->buffer + position, data, length);
+    else {
+        memcpy(self->buffer + position, data, firstPart);
+        memcpy(self->buffer, data + firstPart, length - firstPart);
+    }
+}
+
+static void
+readBytes(CS101_Queue self, int position, uint8_t* data, int length)
+{
+    int firstPart = self->size - position;
 
-    if (self->entryCounter == 0) {
-        self->firstMsgIndex = 0;
-        nextIndex = 0;
+    if (firstPart >= length)
+        memcpy(data, self->buffer + position, length);
+    else {
+        memcpy(data, self->buffer + position, firstPart);
+        memcpy(data + firstPart, self->buffer, length - firstPart);
     }
-    else
-        nextIndex = self->lastMsgIndex + 1;
+}
+
+static int
+nextPosition(CS101_Queue self, int position, int length)
+{
+    position += length;
 
-    if (nextIndex == self->size)
-        nextIndex = 0;
+    if (position >= self->size)
+        position -= self->size;
 
-    if (self->entryCounter == self->size)
-        removeEntry = true;
+    return position;
+}
 
-    if (removeEntry == false) {
-        DEBUG_PRINT("add entry (nextIndex:%i)\n", nextIndex);
-        self->lastMsgIndex = nextIndex;
-        self->entryCounter++;
+static void
+removeOldestEntry(CS101_Queue self)
+{
+    int entrySize = self->buffer[self->firstMsgIndex] + 1;
+
+    self->firstMsgIndex = nextPosition(self, self->firstMsgIndex, entrySize);
+    self->usedBytes -= entrySize;
+    self->entryCounter--;
+}
+
+/**
+ * Get the length of the part of the ASDU that identifies the value (ASDU header + IOA) when the
+ * ASDU contains a single value without time tag that is superseded by a newer value of the same
+ * information object (periodic or background scan data). Returns 0 for all other ASDUs.
+ */
+static int
+getSupersededValueHeaderLength(CS101_ASDU asdu)
+{
+    if (CS101_ASDU_getNumberOfElements(asdu) != 1)
+        return 0;
+
+    CS101_CauseOfTransmission cot = CS101_ASDU_getCOT(asdu);
+
+    if ((cot != CS101_COT_PERIODIC) && (cot != CS101_COT_BACKGROUND_SCAN))
+        return 0;
+
+    switch (CS101_ASDU_getTypeID(asdu)) {
+
+    case M_SP_NA_1:
+    case M_DP_NA_1:
+    case M_ST_NA_1:
+    case M_BO_NA_1:
+    case M_ME_NA_1:
+    case M_ME_NB_1:
+    case M_ME_NC_1:
+    case M_ME_ND_1:
+        return asdu->asduHeaderLength + asdu->parameters->sizeOfIOA;
+
+    default:
+        return 0;
     }
-    else {
-        DEBUG_PRINT("add entry (nextIndex:%i) -> remove oldest\n", nextIndex);
+}
 
-        /* remove oldest entry */
-        self->lastMsgIndex = nextIndex;
+/* replace a queued value of the same information object - returns false when there is none */
+static bool
+replaceSupersededValue(CS101_Queue self, uint8_t* msg, int msgSize, int headerLength)
+{
+    uint8_t entryHeader[256];
+
+    int position = self->firstMsgIndex;
+    int i;
+
+    for (i = 0; i < self->entryCounter; i++) {
+        int entrySize = self->buffer[position];
+
+        int dataPosition = nextPosition(self, position, 1);
 
-        int firstIndex = nextIndex + 1;
+        if (entrySize == msgSize) {
+            readBytes(self, dataPosition, entryHeader, headerLength);
 
-        if (firstIndex == self->size)
-            firstIndex = 0;
+            if (memcmp(entryHeader, msg, headerLength) == 0) {
+                writeBytes(self, dataPosition, msg, msgSize);
+                return true;
+            }
+        }
 
-        self->firstMsgIndex = firstIndex;
+        position = nextPosition(self, dataPosition, entrySize);
     }
 
-    self->encodeFrame.buffer = self->elements[nextIndex].buffer;
-    self->encodeFrame.startSize = 0;
-    self->encodeFrame.msgSize = 0;
+    return false;
+}
+
+void
+CS101_Queue_enqueue(CS101_Queue self, CS101_ASDU asdu)
+{
+    struct sBufferFrame encodeFrame;
+    uint8_t msg[256];
+
+    BufferFrame_initialize(&encodeFrame, msg, 0);
+
+    CS101_ASDU_encode(asdu, (Frame) &encodeFrame);
 
-    CS101_ASDU_encode(asdu, (Frame)&(self->encodeFrame));
+    int msgSize = encodeFrame.msgSize;
+    int droppedEntries = 0;
 
-    int srcSize = self->encodeFrame.msgSize;
-    self->elements[nextIndex].size = srcSize;
+    if ((msgSize > 255) || (msgSize + 1 > self->size))
+        return;
 
-    DEBUG_PRINT("Events in FIFO: %i (first: %i, last: %i)\n", self->entryCounter,
-            self->firstMsgIndex, self->lastMsgIndex);
+    int headerLength = getSupersededValueHeaderLength(asdu);
+
+    CS101_Queue_lock(self);
+
+    if ((headerLength > 0) && replaceSupersededValue(self, msg, msgSize, headerLength)) {
+        DEBUG_PRINT("replaced superseded value\n");
+    }
+    else {
+        /* remove oldest entries until the new entry fits */
+        while (self->usedBytes + msgSize + 1 > self->size) {
+            removeOldestEntry(self);
+            droppedEntries++;
+        }
+
+        self->buffer[self->lastMsgIndex] = (uint8_t) msgSize;
+
+        writeBytes(self, nextPosition(self, self->lastMsgIndex, 1), msg, msgSize);
+
+        self->lastMsgIndex = nextPosition(self, self->lastMsgIndex, msgSize + 1);
+        self->usedBytes += msgSize + 1;
+        self->entryCounter++;
+    }
+
+    DEBUG_PRINT("Events in FIFO: %i (bytes used: %i/%i)\n", self->entryCounter, self->usedBytes, self->size);
+
+    CS101_QueueOverflowHandler overflowHandler = self->overflowHandler;
+    void* overflowHandlerParameter = self->overflowHandlerParameter;
 
     CS101_Queue_unlock(self);
+
+    if ((droppedEntries > 0) && overflowHandler)
+        overflowHandler(overflowHandlerParameter, droppedEntries);
 }
 
 
@@ -160,14 +275,17 @@ CS101_Queue_dequeue(CS101_Queue self, Frame resultStorage)
     if (self->entryCounter != 0) {
 
         if (resultStorage) {
+            uint8_t msg[256];
+
             frame = resultStorage;
 
-            int currentIndex = self->firstMsgIndex;
+            int msgSize = self->buffer[self->firstMsgIndex];
+
+            readBytes(self, nextPosition(self, self->firstMsgIndex, 1), msg, msgSize);
 
-            Frame_appendBytes(frame, self->elements[currentIndex].buffer, self->elements[currentIndex].size);
+            Frame_appendBytes(frame, msg, msgSize);
 
-            self->firstMsgIndex = (currentIndex + 1) % self->size;
-            self->entryCounter--;
+            removeOldestEntry(self);
         }
     }
 
@@ -177,7 +295,8 @@ CS101_Queue_dequeue(CS101_Queue self, Frame resultStorage)
 bool
 CS101_Queue_isFull(CS101_Queue self)
 {
-   return (self->entryCounter == self->size);
+   /* no space for an ASDU of maximum size */
+   return ((self->size - self->usedBytes) < CS101_QUEUE_ELEMENT_SIZE);
 }
 
 bool
@@ -186,11 +305,18 @@ CS101_Queue_isEmpty(CS101_Queue self)
    return (self->entryCounter == 0);
 }
 
+int
+CS101_Queue_getFreeBytes(CS101_Queue self)
+{
+    return (self->size - self->usedBytes);
+}
+
 
 void
 CS101_Queue_flush(CS101_Queue self)
 {
     CS101_Queue_lock(self);
+    self->usedBytes = 0;
     self->entryCounter = 0;
     self->firstMsgIndex = 0;
     self->lastMsgIndex = 0;
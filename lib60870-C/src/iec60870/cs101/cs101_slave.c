@@ -36,6 +36,7 @@
 #include "link_layer.h"
 #include "cs101_queue.h"
 #include "cs101_asdu_internal.h"
+#include "cs101_internal.h"
 #include "linked_list.h"
 
 #if ((CONFIG_USE_THREADS == 1) || (CONFIG_USE_SEMAPHORES == 1))
@@ -68,6 +69,9 @@ struct sCS101_Slave
     CS101_ResetCUHandler resetCUHandler;
     void* resetCUHandlerParameter;
 
+    CS101_SlaveQueueOverflowHandler queueOverflowHandler;
+    void* queueOverflowHandlerParameter;
+
     SerialTransceiverFT12 transceiver;
 
     LinkLayerSecondaryUnbalanced unbalancedLinkLayer;
@@ -88,9 +92,20 @@ struct sCS101_Slave
 #if (CONFIG_USE_THREADS == 1)
     bool isRunning;
     Thread workerThread;
+    struct sThreadAttributes threadAttributes;
 #endif
 
     LinkedList plugins;
+
+    /* logical slave: uses the link layer of the parent slave */
+    CS101_Slave parent;
+    int logicalAddress;
+
+    LinkedList logicalSlaves; /* logical slaves that share the link layer of this slave */
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex logicalSlavesLock; /* protects logicalSlaves and the stations of the link layer while the slave is running */
+#endif
 };
 
 static void
@@ -241,6 +256,21 @@ isReady(IMasterConnection self)
         return true;
 }
 
+static bool
+isReadyEx(IMasterConnection self, int* freeWindowSlots, int* freeQueueBytes)
+{
+    CS101_Slave slave = (CS101_Slave) self->object;
+
+    /* ASDUs are always sent by the class 1 queue */
+    if (freeWindowSlots)
+        *freeWindowSlots = 0;
+
+    if (freeQueueBytes)
+        *freeQueueBytes = CS101_Queue_getFreeBytes(&(slave->userDataClass1Queue));
+
+    return isReady(self);
+}
+
 static bool
 sendASDU(IMasterConnection self, CS101_ASDU asdu)
 {
@@ -281,6 +311,24 @@ getApplicationLayerParameters(IMasterConnection self)
  * END IMasterConnection
  *******************************************/
 
+static void
+class1QueueOverflow(void* parameter, int droppedASDUs)
+{
+    CS101_Slave self = (CS101_Slave) parameter;
+
+    if (self->queueOverflowHandler)
+        self->queueOverflowHandler(self->queueOverflowHandlerParameter, 1, droppedASDUs);
+}
+
+static void
+class2QueueOverflow(void* parameter, int droppedASDUs)
+{
+    CS101_Slave self = (CS101_Slave) parameter;
+
+    if (self->queueOverflowHandler)
+        self->queueOverflowHandler(self->queueOverflowHandlerParameter, 2, droppedASDUs);
+}
+
 static struct sCS101_AppLayerParameters defaultAppLayerParameters = {
     /* .sizeOfTypeId =  */ 1,
     /* .sizeOfVSQ = */ 1,
@@ -291,9 +339,9 @@ static struct sCS101_AppLayerParameters defaultAppLayerParameters = {
     /* .maxSizeOfASDU = */ 249
 };
 
-CS101_Slave
-CS101_Slave_createEx(SerialPort serialPort, LinkLayerParameters llParameters, CS101_AppLayerParameters alParameters, IEC60870_LinkLayerMode linkLayerMode,
-        int class1QueueSize, int class2QueueSize)
+static CS101_Slave
+createInstance(SerialPort serialPort, CS101_Transport transport, LinkLayerParameters llParameters, CS101_AppLayerParameters alParameters,
+        IEC60870_LinkLayerMode linkLayerMode, int class1QueueSize, int class2QueueSize)
 {
     CS101_Slave self = (CS101_Slave) GLOBAL_MALLOC(sizeof(struct sCS101_Slave));
 
@@ -308,9 +356,14 @@ CS101_Slave_createEx(SerialPort serialPort, LinkLayerParameters llParameters, CS
         self->delayAcquisitionHandler = NULL;
         self->resetCUHandler = NULL;
 
+        self->queueOverflowHandler = NULL;
+
 #if (CONFIG_USE_THREADS == 1)
         self->isRunning = false;
         self->workerThread = NULL;
+
+        ThreadAttributes_init(&(self->threadAttributes));
+        ThreadAttributes_setName(&(self->threadAttributes), "iec101-slave");
 #endif
 
         if (llParameters)
@@ -328,11 +381,20 @@ CS101_Slave_createEx(SerialPort serialPort, LinkLayerParameters llParameters, CS
             self->alParameters = defaultAppLayerParameters;
         }
 
-        self->transceiver = SerialTransceiverFT12_create(serialPort,  &(self->linkLayerParameters));
+        if (transport)
+            self->transceiver = SerialTransceiverFT12_createWithTransport(transport, &(self->linkLayerParameters));
+        else if (serialPort)
+            self->transceiver = SerialTransceiverFT12_create(serialPort, &(self->linkLayerParameters));
+        else
+            self->transceiver = NULL; /* logical slave */
 
         self->linkLayerMode = linkLayerMode;
 
-        if (linkLayerMode == IEC60870_LINK_LAYER_UNBALANCED) {
+        if (self->transceiver == NULL) {
+            self->balancedLinkLayer = NULL;
+            self->unbalancedLinkLayer = NULL;
+        }
+        else if (linkLayerMode == IEC60870_LINK_LAYER_UNBALANCED) {
 
             self->balancedLinkLayer = NULL;
 
@@ -352,6 +414,7 @@ CS101_Slave_createEx(SerialPort serialPort, LinkLayerParameters llParameters, CS
         }
 
         self->iMasterConnection.isReady = isReady;
+        self->iMasterConnection.isReadyEx = isReadyEx;
         self->iMasterConnection.sendASDU = sendASDU;
         self->iMasterConnection.sendACT_CON = sendACT_CON;
         self->iMasterConnection.sendACT_TERM = sendACT_TERM;
@@ -363,23 +426,76 @@ CS101_Slave_createEx(SerialPort serialPort, LinkLayerParameters llParameters, CS
         CS101_Queue_initialize(&(self->userDataClass1Queue), class1QueueSize);
         CS101_Queue_initialize(&(self->userDataClass2Queue), class2QueueSize);
 
+        CS101_Queue_setOverflowHandler(&(self->userDataClass1Queue), class1QueueOverflow, self);
+        CS101_Queue_setOverflowHandler(&(self->userDataClass2Queue), class2QueueOverflow, self);
+
         self->plugins = NULL;
+
+        self->parent = NULL;
+        self->logicalAddress = -1;
+        self->logicalSlaves = NULL;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        self->logicalSlavesLock = Mutex_create();
+#endif
     }
 
     return self;
 }
 
+CS101_Slave
+CS101_Slave_createEx(SerialPort serialPort, LinkLayerParameters llParameters, CS101_AppLayerParameters alParameters, IEC60870_LinkLayerMode linkLayerMode,
+        int class1QueueSize, int class2QueueSize)
+{
+    return createInstance(serialPort, NULL, llParameters, alParameters, linkLayerMode, class1QueueSize, class2QueueSize);
+}
+
+CS101_Slave
+CS101_Slave_createWithTransport(CS101_Transport transport, LinkLayerParameters llParameters, CS101_AppLayerParameters alParameters,
+        IEC60870_LinkLayerMode linkLayerMode, int class1QueueSize, int class2QueueSize)
+{
+    return createInstance(NULL, transport, llParameters, alParameters, linkLayerMode, class1QueueSize, class2QueueSize);
+}
+
 CS101_Slave
 CS101_Slave_create(SerialPort serialPort, LinkLayerParameters llParameters, CS101_AppLayerParameters alParameters, IEC60870_LinkLayerMode linkLayerMode)
 {
     return CS101_Slave_createEx(serialPort, llParameters, alParameters, linkLayerMode, CS101_MAX_QUEUE_SIZE, CS101_MAX_QUEUE_SIZE);
 }
 
+static void
+destroyLogicalSlave(void* parameter)
+{
+    CS101_Slave logicalSlave = (CS101_Slave) parameter;
+
+    /* the parent is destroyed -> no need to remove the logical slave from the parent */
+    logicalSlave->parent = NULL;
+
+    CS101_Slave_destroy(logicalSlave);
+}
+
 void
 CS101_Slave_destroy(CS101_Slave self)
 {
     if (self != NULL) {
 
+        if (self->parent) {
+            /* the parent can be running in another thread */
+#if (CONFIG_USE_SEMAPHORES == 1)
+            Mutex_lock(self->parent->logicalSlavesLock);
+#endif
+
+            LinkLayerSecondaryUnbalanced_removeStation(self->parent->unbalancedLinkLayer, self->logicalAddress);
+            LinkedList_remove(self->parent->logicalSlaves, self);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+            Mutex_unlock(self->parent->logicalSlavesLock);
+#endif
+        }
+
+        if (self->logicalSlaves)
+            LinkedList_destroyDeep(self->logicalSlaves, destroyLogicalSlave);
+
         if (self->unbalancedLinkLayer)
             LinkLayerSecondaryUnbalanced_destroy(self->unbalancedLinkLayer);
 
@@ -395,10 +511,61 @@ CS101_Slave_destroy(CS101_Slave self)
             LinkedList_destroyStatic(self->plugins);
         }
 
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_destroy(self->logicalSlavesLock);
+#endif
+
         GLOBAL_FREEMEM(self);
     }
 }
 
+CS101_Slave
+CS101_Slave_addLogicalSlave(CS101_Slave self, int linkLayerAddress, int class1QueueSize, int class2QueueSize)
+{
+    if (self->unbalancedLinkLayer == NULL) {
+        DEBUG_PRINT("CS101 slave: logical slaves require an unbalanced slave with a serial line\n");
+        return NULL;
+    }
+
+    CS101_Slave logicalSlave = createInstance(NULL, NULL, &(self->linkLayerParameters), &(self->alParameters),
+            IEC60870_LINK_LAYER_UNBALANCED, class1QueueSize, class2QueueSize);
+
+    if (logicalSlave) {
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_lock(self->logicalSlavesLock);
+#endif
+
+        if (LinkLayerSecondaryUnbalanced_addStation(self->unbalancedLinkLayer, linkLayerAddress,
+                &cs101UnbalancedAppLayerInterface, logicalSlave) == false)
+        {
+#if (CONFIG_USE_SEMAPHORES == 1)
+            Mutex_unlock(self->logicalSlavesLock);
+#endif
+
+            DEBUG_PRINT("CS101 slave: link layer address %i already in use\n", linkLayerAddress);
+
+            CS101_Slave_destroy(logicalSlave);
+
+            return NULL;
+        }
+
+        logicalSlave->parent = self;
+        logicalSlave->logicalAddress = linkLayerAddress;
+
+        if (self->logicalSlaves == NULL)
+            self->logicalSlaves = LinkedList_create();
+
+        LinkedList_add(self->logicalSlaves, logicalSlave);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_unlock(self->logicalSlavesLock);
+#endif
+    }
+
+    return logicalSlave;
+}
+
 void
 CS101_Slave_addPlugin(CS101_Slave self, CS101_SlavePlugin plugin)
 {
@@ -420,16 +587,27 @@ CS101_Slave_setDIR(CS101_Slave self, bool dir)
 void
 CS101_Slave_setIdleTimeout(CS101_Slave self, int timeoutInMs)
 {
-    if (self->linkLayerMode == IEC60870_LINK_LAYER_UNBALANCED)
+    if (self->unbalancedLinkLayer)
         LinkLayerSecondaryUnbalanced_setIdleTimeout(self->unbalancedLinkLayer, timeoutInMs);
-    else
+    else if (self->balancedLinkLayer)
         LinkLayerBalanced_setIdleTimeout(self->balancedLinkLayer, timeoutInMs);
 }
 
+void
+CS101_Slave_setAdaptiveTimeouts(CS101_Slave self, bool enable, int minTimeoutInMs, int maxTimeoutInMs)
+{
+    if (self->linkLayerMode == IEC60870_LINK_LAYER_BALANCED)
+        LinkLayerBalanced_setAdaptiveTimeouts(self->balancedLinkLayer, enable, minTimeoutInMs, maxTimeoutInMs);
+}
+
 void
 CS101_Slave_setLinkLayerStateChanged(CS101_Slave self, IEC60870_LinkLayerStateChangedHandler handler, void* parameter)
 {
-    if (self->linkLayerMode == IEC60870_LINK_LAYER_UNBALANCED) {
+    if (self->parent) {
+        LinkLayerSecondaryUnbalanced_setStationStateChangeHandler(self->parent->unbalancedLinkLayer, self->logicalAddress,
+                handler, parameter);
+    }
+    else if (self->linkLayerMode == IEC60870_LINK_LAYER_UNBALANCED) {
         LinkLayerSecondaryUnbalanced_setStateChangeHandler(self->unbalancedLinkLayer, handler, parameter);
     }
     else {
@@ -440,9 +618,9 @@ CS101_Slave_setLinkLayerStateChanged(CS101_Slave self, IEC60870_LinkLayerStateCh
 void
 CS101_Slave_setLinkLayerAddress(CS101_Slave self, int address)
 {
-    if (self->linkLayerMode == IEC60870_LINK_LAYER_UNBALANCED)
+    if (self->unbalancedLinkLayer)
         LinkLayerSecondaryUnbalanced_setAddress(self->unbalancedLinkLayer, address);
-    else
+    else if (self->balancedLinkLayer)
         LinkLayerBalanced_setAddress(self->balancedLinkLayer, address);
 }
 
@@ -486,15 +664,15 @@ CS101_Slave_flushQueues(CS101_Slave self)
 }
 
 void
-CS101_Slave_run(CS101_Slave self)
+CS101_Slave_setQueueOverflowHandler(CS101_Slave self, CS101_SlaveQueueOverflowHandler handler, void* parameter)
 {
+    self->queueOverflowHandler = handler;
+    self->queueOverflowHandlerParameter = parameter;
+}
 
-    if (self->unbalancedLinkLayer)
-        LinkLayerSecondaryUnbalanced_run(self->unbalancedLinkLayer);
-    else
-        LinkLayerBalanced_run(self->balancedLinkLayer);
-
-    /* call plugins */
+static void
+runPlugins(CS101_Slave self)
+{
     if (self->plugins) {
 
         LinkedList pluginElem = LinkedList_getNext(self->plugins);
@@ -510,6 +688,44 @@ CS101_Slave_run(CS101_Slave self)
     }
 }
 
+void
+CS101_Slave_run(CS101_Slave self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->logicalSlavesLock);
+#endif
+
+    if (self->unbalancedLinkLayer)
+        LinkLayerSecondaryUnbalanced_run(self->unbalancedLinkLayer);
+    else if (self->balancedLinkLayer)
+        LinkLayerBalanced_run(self->balancedLinkLayer);
+
+    /* call plugins */
+    runPlugins(self);
+
+    if (self->logicalSlaves) {
+
+        LinkedList logicalSlaveElem = LinkedList_getNext(self->logicalSlaves);
+
+        while (logicalSlaveElem) {
+
+            runPlugins((CS101_Slave) LinkedList_getData(logicalSlaveElem));
+
+            logicalSlaveElem = LinkedList_getNext(logicalSlaveElem);
+        }
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->logicalSlavesLock);
+#endif
+}
+
+SerialTransceiverFT12
+CS101_Slave_getTransceiver(CS101_Slave self)
+{
+    return self->transceiver;
+}
+
 #if (CONFIG_USE_THREADS == 1)
 static void*
 slaveMainThread(void* parameter)
@@ -526,12 +742,21 @@ slaveMainThread(void* parameter)
 }
 #endif /* (CONFIG_USE_THREADS == 1) */
 
+void
+CS101_Slave_setThreadAttributes(CS101_Slave self, ThreadAttributes attributes)
+{
+#if (CONFIG_USE_THREADS == 1)
+    self->threadAttributes = *attributes;
+#endif
+}
+
 void
 CS101_Slave_start(CS101_Slave self)
 {
 #if (CONFIG_USE_THREADS == 1)
     if (self->workerThread == NULL) {
         self->workerThread = Thread_create(slaveMainThread, self, false);
+        Thread_setAttributes(self->workerThread, &(self->threadAttributes));
         Thread_start(self->workerThread);
     }
 #endif /* (CONFIG_USE_THREADS == 1) */
@@ -871,6 +1096,7 @@ handleASDU(CS101_Slave self, CS101_ASDU asdu)
 void
 CS101_Slave_setRawMessageHandler(CS101_Slave self, IEC60870_RawMessageHandler handler, void* parameter)
 {
-    SerialTransceiverFT12_setRawMessageHandler(self->transceiver, handler, parameter);
+    if (self->transceiver)
+        SerialTransceiverFT12_setRawMessageHandler(self->transceiver, handler, parameter);
 }
 
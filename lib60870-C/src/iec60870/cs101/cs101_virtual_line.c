@@ -0,0 +1,309 @@
+/*
+ *  cs101_virtual_line.c
+ *
+ *  Copyright 2017 MZ Automation GmbH
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cs101_transport.h"
+#include "hal_thread.h"
+#include "hal_time.h"
+#include "lib_memory.h"
+#include "lib60870_config.h"
+#include "lib60870_internal.h"
+
+/* receive buffer of an endpoint (bytes that don't fit are lost like in a UART overrun) */
+#define VIRTUAL_LINE_RX_BUFFER_SIZE 2048
+
+/* 8 data bits, even parity, start and stop bit */
+#define VIRTUAL_LINE_BITS_PER_CHARACTER 11
+
+typedef struct sCS101_VirtualLineEndpoint* CS101_VirtualLineEndpoint;
+
+struct sCS101_VirtualLineEndpoint
+{
+    CS101_VirtualLine line;
+    struct sCS101_Transport transport;
+
+    /* received bytes in data[first] .. data[first + count - 1] (ring buffer) */
+    int first;
+    int count;
+
+    /* time when the byte is completely received */
+    uint64_t receiveTime[VIRTUAL_LINE_RX_BUFFER_SIZE];
+    uint8_t data[VIRTUAL_LINE_RX_BUFFER_SIZE];
+
+    CS101_VirtualLineEndpoint next;
+};
+
+struct sCS101_VirtualLine
+{
+    int baudRate;
+    int latency;
+
+    int errorsPerMillion;
+    uint32_t randomState;
+
+    /* the line is busy until all sent bytes are transmitted */
+    uint64_t lineFreeTime;
+
+    uint64_t sentBytes;
+    uint64_t corruptedBytes;
+
+    CS101_VirtualLineEndpoint endpoints;
+
+    Mutex lock;
+    Condition dataReceived;
+};
+
+CS101_VirtualLine
+CS101_VirtualLine_create(int baudRate)
+{
+    CS101_VirtualLine self = (CS101_VirtualLine) GLOBAL_CALLOC(1, sizeof(struct sCS101_VirtualLine));
+
+    if (self) {
+        self->baudRate = baudRate;
+        self->randomState = 1;
+        self->lock = Mutex_create();
+        self->dataReceived = Condition_create();
+    }
+
+    return self;
+}
+
+void
+CS101_VirtualLine_setLatency(CS101_VirtualLine self, int latencyInMs)
+{
+    self->latency = latencyInMs;
+}
+
+void
+CS101_VirtualLine_setErrorRate(CS101_VirtualLine self, int errorsPerMillion, uint32_t seed)
+{
+    Mutex_lock(self->lock);
+
+    self->errorsPerMillion = errorsPerMillion;
+    self->randomState = seed;
+
+    Mutex_unlock(self->lock);
+}
+
+/* linear congruential generator (reproducible for a given seed) */
+static uint32_t
+nextRandom(CS101_VirtualLine self)
+{
+    self->randomState = self->randomState * 1103515245u + 12345u;
+
+    return (self->randomState >> 8);
+}
+
+/* transmission time of the first numberOfBytes characters in ms */
+static uint64_t
+getTransmissionTime(CS101_VirtualLine self, int numberOfBytes)
+{
+    if (self->baudRate > 0)
+        return ((uint64_t) numberOfBytes * VIRTUAL_LINE_BITS_PER_CHARACTER * 1000) / self->baudRate;
+    else
+        return 0;
+}
+
+static int
+endpointWrite(void* parameter, uint8_t* buffer, int numberOfBytes)
+{
+    CS101_VirtualLineEndpoint endpoint = (CS101_VirtualLineEndpoint) parameter;
+    CS101_VirtualLine self = endpoint->line;
+
+    Mutex_lock(self->lock);
+
+    uint64_t currentTime = Hal_getTimeInMs();
+
+    /* the transmission starts when the previous transmission is finished */
+    uint64_t startTime = (self->lineFreeTime > currentTime) ? self->lineFreeTime : currentTime;
+
+    self->lineFreeTime = startTime + getTransmissionTime(self, numberOfBytes);
+
+    int i;
+
+    for (i = 0; i < numberOfBytes; i++) {
+
+        uint8_t value = buffer[i];
+
+        if (self->errorsPerMillion > 0) {
+            if ((int) (nextRandom(self) % 1000000) < self->errorsPerMillion) {
+                value ^= (uint8_t) (1 << (nextRandom(self) % 8));
+                self->corruptedBytes++;
+            }
+        }
+
+        uint64_t receiveTime = startTime + getTransmissionTime(self, i + 1) + self->latency;
+
+        CS101_VirtualLineEndpoint receiver = self->endpoints;
+
+        while (receiver) {
+
+            if ((receiver != endpoint) && (receiver->count < VIRTUAL_LINE_RX_BUFFER_SIZE)) {
+                int pos = (receiver->first + receiver->count) % VIRTUAL_LINE_RX_BUFFER_SIZE;
+
+                receiver->data[pos] = value;
+                receiver->receiveTime[pos] = receiveTime;
+                receiver->count++;
+            }
+
+            receiver = receiver->next;
+        }
+    }
+
+    self->sentBytes += numberOfBytes;
+
+    Condition_broadcast(self->dataReceived);
+
+    Mutex_unlock(self->lock);
+
+    return numberOfBytes;
+}
+
+static int
+endpointReadBytes(void* parameter, uint8_t* buffer, int maxSize, int timeoutInMs)
+{
+    CS101_VirtualLineEndpoint endpoint = (CS101_VirtualLineEndpoint) parameter;
+    CS101_VirtualLine self = endpoint->line;
+
+    int readBytes = 0;
+
+    Mutex_lock(self->lock);
+
+    uint64_t timeout = Hal_getTimeInMs() + timeoutInMs;
+
+    while (true) {
+        uint64_t currentTime = Hal_getTimeInMs();
+
+        while ((readBytes < maxSize) && (endpoint->count > 0) &&
+                (endpoint->receiveTime[endpoint->first] <= currentTime))
+        {
+            buffer[readBytes++] = endpoint->data[endpoint->first];
+
+            endpoint->first = (endpoint->first + 1) % VIRTUAL_LINE_RX_BUFFER_SIZE;
+            endpoint->count--;
+        }
+
+        if ((readBytes > 0) || (currentTime >= timeout))
+            break;
+
+        /* wait until the next byte is received or new bytes are sent */
+        uint64_t waitUntil = timeout;
+
+        if ((endpoint->count > 0) && (endpoint->receiveTime[endpoint->first] < waitUntil))
+            waitUntil = endpoint->receiveTime[endpoint->first];
+
+        Condition_waitTimed(self->dataReceived, self->lock, (int) (waitUntil - currentTime));
+    }
+
+    Mutex_unlock(self->lock);
+
+    return readBytes;
+}
+
+static int
+endpointGetBaudRate(void* parameter)
+{
+    CS101_VirtualLineEndpoint endpoint = (CS101_VirtualLineEndpoint) parameter;
+
+    return endpoint->line->baudRate;
+}
+
+static int
+endpointGetBitsPerCharacter(void* parameter)
+{
+    return VIRTUAL_LINE_BITS_PER_CHARACTER;
+}
+
+CS101_Transport
+CS101_VirtualLine_addEndpoint(CS101_VirtualLine self)
+{
+    CS101_VirtualLineEndpoint endpoint = (CS101_VirtualLineEndpoint) GLOBAL_CALLOC(1, sizeof(struct sCS101_VirtualLineEndpoint));
+
+    if (endpoint == NULL)
+        return NULL;
+
+    endpoint->line = self;
+
+    endpoint->transport.readBytes = endpointReadBytes;
+    endpoint->transport.write = endpointWrite;
+    endpoint->transport.getBaudRate = endpointGetBaudRate;
+    endpoint->transport.getBitsPerCharacter = endpointGetBitsPerCharacter;
+    endpoint->transport.parameter = endpoint;
+
+    Mutex_lock(self->lock);
+
+    endpoint->next = self->endpoints;
+    self->endpoints = endpoint;
+
+    Mutex_unlock(self->lock);
+
+    return &(endpoint->transport);
+}
+
+uint64_t
+CS101_VirtualLine_getSentBytes(CS101_VirtualLine self)
+{
+    Mutex_lock(self->lock);
+
+    uint64_t sentBytes = self->sentBytes;
+
+    Mutex_unlock(self->lock);
+
+    return sentBytes;
+}
+
+uint64_t
+CS101_VirtualLine_getCorruptedBytes(CS101_VirtualLine self)
+{
+    Mutex_lock(self->lock);
+
+    uint64_t corruptedBytes = self->corruptedBytes;
+
+    Mutex_unlock(self->lock);
+
+    return corruptedBytes;
+}
+
+void
+CS101_VirtualLine_destroy(CS101_VirtualLine self)
+{
+    if (self) {
+        CS101_VirtualLineEndpoint endpoint = self->endpoints;
+
+        while (endpoint) {
+            CS101_VirtualLineEndpoint next = endpoint->next;
+
+            GLOBAL_FREEMEM(endpoint);
+
+            endpoint = next;
+        }
+
+        Condition_destroy(self->dataReceived);
+        Mutex_destroy(self->lock);
+
+        GLOBAL_FREEMEM(self);
+    }
+}
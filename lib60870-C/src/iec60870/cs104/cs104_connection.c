@@ -61,6 +61,13 @@ static struct sCS101_AppLayerParameters defaultAppLayerParameters = {
 #define HOST_NAME_MAX 64
 #endif
 
+/* size of the receive buffer. Multiple messages can be received with a single read call */
+#define CS104_INPUT_BUFFER_SIZE 1024
+
+#ifndef CONFIG_CS104_CONNECTION_USE_IO_RING
+#define CONFIG_CS104_CONNECTION_USE_IO_RING 1
+#endif
+
 typedef enum {
     STATE_IDLE = 0,
     STATE_INACTIVE = 1,
@@ -81,24 +88,37 @@ struct sCS104_Connection {
     struct sCS104_APCIParameters parameters;
     struct sCS101_AppLayerParameters alParameters;
 
-    uint8_t recvBuffer[260];
-    int recvBufPos;
+    /* data read from the socket that is not yet handled */
+    int inBufStart;
+    int inBufEnd;
+    uint8_t inBuffer[CS104_INPUT_BUFFER_SIZE];
+
+    uint8_t recvBuffer[260]; /* the message that is currently handled */
+
+    SocketIoRing ioRing; /* receives the data into the input buffer (NULL = socket is read directly) */
+    bool ioRingRecvPending; /* a receive operation for the input buffer is queued in the socket ring */
 
     int connectTimeoutInMs;
     uint8_t sMessage[6];
 
+    bool hasSocketOptions;
+    struct sSocketOptions socketOptions;
+
     SentASDU* sentASDUs; /* the k-buffer */
     int maxSentASDUs;    /* maximum number of ASDU to be sent without confirmation - parameter k */
     int oldestSentASDU;  /* index of oldest entry in k-buffer */
     int newestSentASDU;  /* index of newest entry in k-buffer */
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore sentASDUsLock;
-    Semaphore socketWriteLock;
+    Mutex sentASDUsLock;
+    Mutex socketWriteLock;
+    Mutex stateLock;
+    Condition stateChanged; /* signaled when running or failure changes */
 #endif
 
 #if (CONFIG_USE_THREADS == 1)
     Thread connectionHandlingThread;
+    struct sThreadAttributes threadAttributes;
 #endif
 
     int receiveCount;
@@ -160,8 +180,15 @@ writeToSocket(CS104_Connection self, uint8_t* buf, int size)
         self->rawMessageHandler(self->rawMessageHandlerParameter, buf, size, true);
 
 #if (CONFIG_CS104_SUPPORT_TLS == 1)
-    if (self->tlsSocket)
-        return TLSSocket_write(self->tlsSocket, buf, size);
+    if (self->tlsSocket) {
+        int ret;
+
+        /* the client has no output buffer -> wait until the TLS layer can take the data */
+        while ((ret = TLSSocket_write(self->tlsSocket, buf, size)) == 0)
+            Thread_sleep(1);
+
+        return ret;
+    }
     else
         return Socket_write(self->socket, buf, size);
 #else
@@ -182,7 +209,7 @@ static void
 sendSMessage(CS104_Connection self)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->socketWriteLock);
+    Mutex_lock(self->socketWriteLock);
 #endif
     uint8_t* msg = self->sMessage;
 
@@ -191,7 +218,7 @@ sendSMessage(CS104_Connection self)
 
     writeToSocket(self, msg, 6);
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->socketWriteLock);
+    Mutex_unlock(self->socketWriteLock);
 #endif
 }
 
@@ -201,11 +228,11 @@ sendIMessage(CS104_Connection self, Frame frame)
     T104Frame_prepareToSend((T104Frame) frame, self->sendCount, self->receiveCount);
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->socketWriteLock);
+    Mutex_lock(self->socketWriteLock);
 #endif
     writeToSocket(self, T104Frame_getBuffer(frame), T104Frame_getMsgSize(frame));
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->socketWriteLock);
+    Mutex_unlock(self->socketWriteLock);
 #endif
 
     self->sendCount = (self->sendCount + 1) % 32768;
@@ -237,12 +264,19 @@ createConnection(const char* hostname, int tcpPort)
         self->rawMessageHandlerParameter = NULL;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-        self->sentASDUsLock = Semaphore_create(1);
-        self->socketWriteLock = Semaphore_create(1);
+        self->sentASDUsLock = Mutex_create();
+        self->socketWriteLock = Mutex_create();
+        self->stateLock = Mutex_create();
+        self->stateChanged = Condition_create();
 #endif
 
+        self->hasSocketOptions = false;
+
 #if (CONFIG_USE_THREADS == 1)
         self->connectionHandlingThread = NULL;
+
+        ThreadAttributes_init(&(self->threadAttributes));
+        ThreadAttributes_setName(&(self->threadAttributes), "iec104-client");
 #endif
 
 #if (CONFIG_CS104_SUPPORT_TLS == 1)
@@ -252,6 +286,9 @@ createConnection(const char* hostname, int tcpPort)
 
         self->sentASDUs = NULL;
 
+        self->ioRing = NULL;
+        self->ioRingRecvPending = false;
+
         self->conState = STATE_IDLE;
 
         prepareSMessage(self->sMessage);
@@ -297,7 +334,8 @@ static void
 resetConnection(CS104_Connection self)
 {
     self->connectTimeoutInMs = self->parameters.t0 * 1000;
-    self->recvBufPos = 0;
+    self->inBufStart = 0;
+    self->inBufEnd = 0;
 
     self->running = false;
     self->failure = false;
@@ -331,7 +369,7 @@ static bool
 checkSequenceNumber(CS104_Connection self, int seqNo)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->sentASDUsLock);
+    Mutex_lock(self->sentASDUsLock);
 #endif
 
     /* check if received sequence number is valid */
@@ -410,7 +448,7 @@ checkSequenceNumber(CS104_Connection self, int seqNo)
     }
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->sentASDUsLock);
+    Mutex_unlock(self->sentASDUsLock);
 #endif
 
     return seqNoIsValid;
@@ -453,8 +491,10 @@ CS104_Connection_destroy(CS104_Connection self)
         GLOBAL_FREEMEM(self->sentASDUs);
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_destroy(self->sentASDUsLock);
-    Semaphore_destroy(self->socketWriteLock);
+    Mutex_destroy(self->sentASDUsLock);
+    Mutex_destroy(self->socketWriteLock);
+    Mutex_destroy(self->stateLock);
+    Condition_destroy(self->stateChanged);
 #endif
 
     GLOBAL_FREEMEM(self);
@@ -486,6 +526,13 @@ CS104_Connection_setConnectTimeout(CS104_Connection self, int millies)
     self->connectTimeoutInMs = millies;
 }
 
+void
+CS104_Connection_setSocketOptions(CS104_Connection self, SocketOptions options)
+{
+    self->socketOptions = *options;
+    self->hasSocketOptions = true;
+}
+
 CS104_APCIParameters
 CS104_Connection_getAPCIParameters(CS104_Connection self)
 {
@@ -509,71 +556,133 @@ readFromSocket(CS104_Connection self, uint8_t* buffer, int size)
 }
 
 /**
- * \brief Read message part into receive buffer
+ * \brief Get the length of the complete message at the start of the input buffer
+ *
+ * \return -1 in case of a framing error, 0 when no complete message is in the buffer, the message length otherwise
+ */
+static int
+getBufferedMessageLength(CS104_Connection self)
+{
+    int available = self->inBufEnd - self->inBufStart;
+
+    if (available < 1)
+        return 0;
+
+    if (self->inBuffer[self->inBufStart] != 0x68)
+        return -1; /* message error */
+
+    if (available < 2)
+        return 0;
+
+    int length = self->inBuffer[self->inBufStart + 1] + 2;
+
+    if (available < length)
+        return 0;
+
+    return length;
+}
+
+/**
+ * \brief Get the next message from the input buffer into the receive buffer
+ *
+ * The socket is only read when the input buffer contains no complete message. All available
+ * data (up to the size of the input buffer) is read at once.
  *
  * \return -1 in case of an error, 0 when no complete message can be read, > 0 when a complete message is in buffer
  */
 static int
 receiveMessage(CS104_Connection self)
 {
-    uint8_t* buffer = self->recvBuffer;
-    int bufPos = self->recvBufPos;
+    int length = getBufferedMessageLength(self);
 
-    /* read start byte */
-    if (bufPos == 0) {
-        int readFirst = readFromSocket(self, buffer, 1);
+    if (length == 0) {
 
-        if (readFirst < 1)
-            return readFirst;
+        /* with the socket ring the data is received before the messages are handled */
+        if (self->ioRing != NULL)
+            return 0;
+
+        /* move the incomplete message to the start of the buffer */
+        if (self->inBufStart > 0) {
+            memmove(self->inBuffer, self->inBuffer + self->inBufStart, self->inBufEnd - self->inBufStart);
+            self->inBufEnd -= self->inBufStart;
+            self->inBufStart = 0;
+        }
 
-        if (buffer[0] != 0x68)
-            return -1; /* message error */
+        int readCnt = readFromSocket(self, self->inBuffer + self->inBufEnd, CS104_INPUT_BUFFER_SIZE - self->inBufEnd);
 
-        bufPos++;
+        if (readCnt < 0)
+            return -1;
+
+        self->inBufEnd += readCnt;
+
+        length = getBufferedMessageLength(self);
     }
 
-    /* read length byte */
-    if (bufPos == 1)  {
+    if (length > 0) {
+        memcpy(self->recvBuffer, self->inBuffer + self->inBufStart, length);
 
-        int readCnt = readFromSocket(self, buffer + 1, 1);
+        self->inBufStart += length;
 
-        if (readCnt < 0) {
-            self->recvBufPos = 0;
-            return -1;
+        if (self->inBufStart == self->inBufEnd) {
+            self->inBufStart = 0;
+            self->inBufEnd = 0;
         }
-        else if (readCnt == 0) {
-            self->recvBufPos = 1;
-            return 0;
+    }
+
+    return length;
+}
+
+#if (CONFIG_USE_THREADS == 1)
+/**
+ * \brief Receive data into the input buffer with the socket ring
+ *
+ * A receive operation into the free part of the input buffer is queued when none is pending. The
+ * input buffer is registered with the ring.
+ *
+ * \return -1 in case of an error, 0 on timeout, 1 when data was received
+ */
+static int
+receiveWithIoRing(CS104_Connection self, int timeoutMs)
+{
+    if (self->ioRingRecvPending == false) {
+
+        /* move the incomplete message to the start of the buffer */
+        if (self->inBufStart > 0) {
+            memmove(self->inBuffer, self->inBuffer + self->inBufStart, self->inBufEnd - self->inBufStart);
+            self->inBufEnd -= self->inBufStart;
+            self->inBufStart = 0;
         }
 
-        bufPos++;
+        if (self->inBufEnd < CS104_INPUT_BUFFER_SIZE) {
+            if (SocketIoRing_prepareReceive(self->ioRing, self->socket, self->inBuffer + self->inBufEnd,
+                    CS104_INPUT_BUFFER_SIZE - self->inBufEnd, self))
+                self->ioRingRecvPending = true;
+        }
     }
 
-    /* read remaining frame */
-    if (bufPos > 1) {
-        int length = buffer[1];
+    if (SocketIoRing_submitAndWait(self->ioRing, (unsigned int) timeoutMs) == false)
+        return -1;
 
-        int remainingLength = length - bufPos + 2;
+    int retVal = 0;
 
-        int readCnt = readFromSocket(self, buffer + bufPos, remainingLength);
+    void* userData;
+    int result;
+    bool isSend;
 
-        if (readCnt == remainingLength) {
-            self->recvBufPos = 0;
-            return length + 2;
+    while (SocketIoRing_getCompletion(self->ioRing, &userData, &result, &isSend)) {
+        self->ioRingRecvPending = false;
+
+        if (result > 0) {
+            self->inBufEnd += result;
+            retVal = 1;
         }
-        else if (readCnt == -1) {
-            self->recvBufPos = 0;
+        else
             return -1;
-        }
-        else {
-            self->recvBufPos = bufPos + readCnt;
-            return 0;
-        }
     }
 
-    self->recvBufPos = bufPos;
-    return 0;
+    return retVal;
 }
+#endif /* (CONFIG_USE_THREADS == 1) */
 
 static bool
 checkConfirmTimeout(CS104_Connection self, uint64_t currentTime)
@@ -649,11 +758,11 @@ checkMessage(CS104_Connection self, uint8_t* buffer, int msgSize)
         if (buffer[2] == 0x43) { /* Check for TESTFR_ACT message */
             DEBUG_PRINT("Send TESTFR_CON\n");
 #if (CONFIG_USE_SEMAPHORES == 1)
-            Semaphore_wait(self->socketWriteLock);
+            Mutex_lock(self->socketWriteLock);
 #endif
             writeToSocket(self, TESTFR_CON_MSG, TESTFR_CON_MSG_SIZE);
 #if (CONFIG_USE_SEMAPHORES == 1)
-            Semaphore_post(self->socketWriteLock);
+            Mutex_unlock(self->socketWriteLock);
 #endif
         }
         else if (buffer[2] == 0x83) { /* TESTFR_CON */
@@ -663,11 +772,11 @@ checkMessage(CS104_Connection self, uint8_t* buffer, int msgSize)
         else if (buffer[2] == 0x07) { /* STARTDT_ACT */
             DEBUG_PRINT("Send STARTDT_CON\n");
 #if (CONFIG_USE_SEMAPHORES == 1)
-            Semaphore_wait(self->socketWriteLock);
+            Mutex_lock(self->socketWriteLock);
 #endif
             writeToSocket(self, STARTDT_CON_MSG, STARTDT_CON_MSG_SIZE);
 #if (CONFIG_USE_SEMAPHORES == 1)
-            Semaphore_post(self->socketWriteLock);
+            Mutex_unlock(self->socketWriteLock);
 #endif
             self->conState = STATE_ACTIVE;
         }
@@ -722,11 +831,11 @@ handleTimeouts(CS104_Connection self)
         else {
             DEBUG_PRINT("U message T3 timeout\n");
 #if (CONFIG_USE_SEMAPHORES == 1)
-            Semaphore_wait(self->socketWriteLock);
+            Mutex_lock(self->socketWriteLock);
 #endif
             writeToSocket(self, TESTFR_ACT_MSG, TESTFR_ACT_MSG_SIZE);
 #if (CONFIG_USE_SEMAPHORES == 1)
-            Semaphore_post(self->socketWriteLock);
+            Mutex_unlock(self->socketWriteLock);
 #endif
             self->uMessageTimeout = currentTime + (self->parameters.t1 * 1000);
             self->outstandingTestFCConMessages++;
@@ -752,7 +861,7 @@ handleTimeouts(CS104_Connection self)
 
     /* check if counterpart confirmed I messages */
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->sentASDUsLock);
+    Mutex_lock(self->sentASDUsLock);
 #endif
     if (self->oldestSentASDU != -1) {
         if (currentTime > self->sentASDUs[self->oldestSentASDU].sentTime) {
@@ -763,7 +872,7 @@ handleTimeouts(CS104_Connection self)
         }
     }
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->sentASDUsLock);
+    Mutex_unlock(self->sentASDUsLock);
 #endif
 
 
@@ -773,6 +882,19 @@ exit_function:
 }
 
 #if (CONFIG_USE_THREADS == 1)
+/* wake up threads waiting for a change of the running or failure flags */
+static void
+signalStateChange(CS104_Connection self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->stateLock);
+    Condition_broadcast(self->stateChanged);
+    Mutex_unlock(self->stateLock);
+#else
+    (void) self;
+#endif
+}
+
 static void*
 handleConnection(void* parameter)
 {
@@ -785,6 +907,9 @@ handleConnection(void* parameter)
     if (self->socket) {
         Socket_setConnectTimeout(self->socket, self->connectTimeoutInMs);
 
+        if (self->hasSocketOptions)
+            Socket_setOptions(self->socket, &(self->socketOptions));
+
         if (Socket_connect(self->socket, self->hostname, self->tcpPort)) {
 
 #if (CONFIG_CS104_SUPPORT_TLS == 1)
@@ -802,6 +927,8 @@ handleConnection(void* parameter)
             self->running = true;
 #endif
 
+            signalStateChange(self);
+
             if (self->running) {
 
                 self->conState = STATE_INACTIVE;
@@ -812,36 +939,67 @@ handleConnection(void* parameter)
 
                 HandleSet handleSet = Handleset_new();
 
+                Handleset_addSocket(handleSet, self->socket);
+
+#if (CONFIG_CS104_CONNECTION_USE_IO_RING == 1)
+                /* TLS connections are read by the TLS layer and use the handle set */
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+                if (self->tlsSocket == NULL)
+#endif
+                {
+                    self->ioRing = SocketIoRing_create(1);
+                    self->ioRingRecvPending = false;
+
+                    if (self->ioRing)
+                        SocketIoRing_registerBuffer(self->ioRing, self->inBuffer, CS104_INPUT_BUFFER_SIZE);
+                }
+#endif
+
                 bool loopRunning = true;
 
                 while (loopRunning) {
 
-                    Handleset_reset(handleSet);
-                    Handleset_addSocket(handleSet, self->socket);
+                    int readyHandles;
 
-                    if (Handleset_waitReady(handleSet, 100)) {
-                        int bytesRec = receiveMessage(self);
+                    if (self->ioRing) {
+                        readyHandles = receiveWithIoRing(self, 100);
 
-                        if (bytesRec == -1) {
+                        if (readyHandles < 0) {
                             loopRunning = false;
                             self->failure = true;
                         }
+                    }
+                    else
+                        readyHandles = Handleset_waitReady(handleSet, 100);
 
-                        if (bytesRec > 0) {
+                    if (readyHandles > 0) {
+                        int bytesRec;
 
-                            if (self->rawMessageHandler)
-                                self->rawMessageHandler(self->rawMessageHandlerParameter, self->recvBuffer, bytesRec, false);
+                        /* handle all complete messages that have been received with a single read */
+                        do {
+                            bytesRec = receiveMessage(self);
 
-                            if (checkMessage(self, self->recvBuffer, bytesRec) == false) {
-                                /* close connection on error */
+                            if (bytesRec == -1) {
                                 loopRunning = false;
                                 self->failure = true;
                             }
-                        }
 
-                        if ((self->unconfirmedReceivedIMessages >= self->parameters.w) || (self->conState == STATE_WAITING_FOR_STOPDT_CON)) {
-                            confirmOutstandingMessages(self);
-                        }
+                            if (bytesRec > 0) {
+
+                                if (self->rawMessageHandler)
+                                    self->rawMessageHandler(self->rawMessageHandlerParameter, self->recvBuffer, bytesRec, false);
+
+                                if (checkMessage(self, self->recvBuffer, bytesRec) == false) {
+                                    /* close connection on error */
+                                    loopRunning = false;
+                                    self->failure = true;
+                                }
+                            }
+
+                            if ((self->unconfirmedReceivedIMessages >= self->parameters.w) || (self->conState == STATE_WAITING_FOR_STOPDT_CON)) {
+                                confirmOutstandingMessages(self);
+                            }
+                        } while (loopRunning && (bytesRec > 0) && (getBufferedMessageLength(self) != 0));
                     }
 
                     if (handleTimeouts(self) == false)
@@ -853,6 +1011,12 @@ handleConnection(void* parameter)
 
                 Handleset_destroy(handleSet);
 
+                /* cancels the pending receive operation */
+                if (self->ioRing) {
+                    SocketIoRing_destroy(self->ioRing);
+                    self->ioRing = NULL;
+                }
+
                 /* Call connection handler */
                 if (self->connectionHandler != NULL)
                     self->connectionHandler(self->connectionHandlerParameter, self, CS104_CONNECTION_CLOSED);
@@ -861,6 +1025,7 @@ handleConnection(void* parameter)
         }
         else {
             self->failure = true;
+            signalStateChange(self);
         }
 
         /* Confirm all unconfirmed received I-messages before closing the connection */
@@ -879,16 +1044,27 @@ handleConnection(void* parameter)
     }
     else {
     	DEBUG_PRINT("Failed to create socket\n");
+    	self->failure = true;
     }
 
     self->running = false;
 
+    signalStateChange(self);
+
     DEBUG_PRINT("EXIT CONNECTION HANDLING THREAD\n");
 
     return NULL;
 }
 #endif /* (CONFIG_USE_THREADS == 1) */
 
+void
+CS104_Connection_setThreadAttributes(CS104_Connection self, ThreadAttributes attributes)
+{
+#if (CONFIG_USE_THREADS == 1)
+    self->threadAttributes = *attributes;
+#endif
+}
+
 void
 CS104_Connection_connectAsync(CS104_Connection self)
 {
@@ -904,8 +1080,10 @@ CS104_Connection_connectAsync(CS104_Connection self)
 
     self->connectionHandlingThread = Thread_create(handleConnection, (void*) self, false);
 
-    if (self->connectionHandlingThread)
+    if (self->connectionHandlingThread) {
+        Thread_setAttributes(self->connectionHandlingThread, &(self->threadAttributes));
         Thread_start(self->connectionHandlingThread);
+    }
 #endif
 }
 
@@ -918,8 +1096,17 @@ CS104_Connection_connect(CS104_Connection self)
 
     CS104_Connection_connectAsync(self);
 
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->stateLock);
+
+    while ((self->running == false) && (self->failure == false))
+        Condition_wait(self->stateChanged, self->stateLock);
+
+    Mutex_unlock(self->stateLock);
+#else
     while ((self->running == false) && (self->failure == false))
         Thread_sleep(1);
+#endif
 
     return self->running;
 }
@@ -980,11 +1167,11 @@ CS104_Connection_sendStartDT(CS104_Connection self)
 {
     self->conState = STATE_WAITING_FOR_STARTDT_CON;
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->socketWriteLock);
+    Mutex_lock(self->socketWriteLock);
 #endif
     writeToSocket(self, STARTDT_ACT_MSG, STARTDT_ACT_MSG_SIZE);
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->socketWriteLock);
+    Mutex_unlock(self->socketWriteLock);
 #endif
 }
 
@@ -995,11 +1182,11 @@ CS104_Connection_sendStopDT(CS104_Connection self)
 
     self->conState = STATE_WAITING_FOR_STOPDT_CON;
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->socketWriteLock);
+    Mutex_lock(self->socketWriteLock);
 #endif
     writeToSocket(self, STOPDT_ACT_MSG, STOPDT_ACT_MSG_SIZE);
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->socketWriteLock);
+    Mutex_unlock(self->socketWriteLock);
 #endif
 }
 
@@ -1007,7 +1194,7 @@ static void
 sendIMessageAndUpdateSentASDUs(CS104_Connection self, Frame frame)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->sentASDUsLock);
+    Mutex_lock(self->sentASDUsLock);
 #endif
 
     int currentIndex = 0;
@@ -1026,7 +1213,7 @@ sendIMessageAndUpdateSentASDUs(CS104_Connection self, Frame frame)
     self->newestSentASDU = currentIndex;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->sentASDUsLock);
+    Mutex_unlock(self->sentASDUsLock);
 #endif
 }
 
@@ -62,6 +62,23 @@ MasterConnection_activate(MasterConnection self);
 
 #define CS104_DEFAULT_PORT 2404
 
+/* size of the receive buffer. Multiple messages can be received with a single read call */
+#define CS104_INPUT_BUFFER_SIZE 1024
+
+/* maximum size of the TLS records that are created by combining the frames of one loop iteration */
+#define CS104_TLS_RECORD_BUFFER_SIZE 4096
+
+#ifndef CONFIG_CS104_SLAVE_OUTPUT_BUFFER_SIZE
+#define CONFIG_CS104_SLAVE_OUTPUT_BUFFER_SIZE 4096
+#endif
+
+#ifndef CONFIG_CS104_SLAVE_USE_IO_RING
+#define CONFIG_CS104_SLAVE_USE_IO_RING 1
+#endif
+
+/* default time (in ms) the output of a connection can be blocked before CS104_CON_EVENT_SLOW_CONSUMER is raised */
+#define CS104_DEFAULT_SLOW_CONSUMER_WARNING_TIME 5000
+
 static struct sCS104_APCIParameters defaultConnectionParameters = {
 	/* .k = */ 12,
 	/* .w = */ 8,
@@ -114,7 +131,7 @@ struct sMessageQueue {
     uint8_t* buffer;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore queueLock;
+    Mutex queueLock;
 #endif
 };
 
@@ -137,7 +154,7 @@ MessageQueue_initialize(MessageQueue self, int maxQueueSize)
     self->entryId = 1;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    self->queueLock = Semaphore_create(1);
+    self->queueLock = Mutex_create();
 #endif
 }
 
@@ -158,7 +175,7 @@ MessageQueue_destroy(MessageQueue self)
     if (self != NULL) {
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-        Semaphore_destroy(self->queueLock);
+        Mutex_destroy(self->queueLock);
 #endif
 
         GLOBAL_FREEMEM(self->buffer);
@@ -170,7 +187,7 @@ static void
 MessageQueue_lock(MessageQueue self)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->queueLock);
+    Mutex_lock(self->queueLock);
 #endif
 }
 
@@ -178,7 +195,7 @@ static void
 MessageQueue_unlock(MessageQueue self)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->queueLock);
+    Mutex_unlock(self->queueLock);
 #endif
 }
 
@@ -188,13 +205,13 @@ MessageQueue_getEntryCount(MessageQueue self)
     int count = 0;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->queueLock);
+    Mutex_lock(self->queueLock);
 #endif
 
     count = self->entryCounter;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->queueLock);
+    Mutex_unlock(self->queueLock);
 #endif
 
     return count;
@@ -243,7 +260,7 @@ MessageQueue_enqueueASDU(MessageQueue self, CS101_ASDU asdu)
     int entrySize = sizeof(struct sMessageQueueEntryInfo) + asduSize;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->queueLock);
+    Mutex_lock(self->queueLock);
 #endif
 
     struct sMessageQueueEntryInfo entryInfo;
@@ -317,7 +334,7 @@ MessageQueue_enqueueASDU(MessageQueue self, CS101_ASDU asdu)
             self->firstEntry, self->lastEntry, self->lastInBufferEntry);
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->queueLock);
+    Mutex_unlock(self->queueLock);
 #endif
 }
 
@@ -325,7 +342,7 @@ static bool
 MessageQueue_isAsduAvailable(MessageQueue self)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->queueLock);
+    Mutex_lock(self->queueLock);
 #endif
 
     bool retVal;
@@ -336,7 +353,7 @@ MessageQueue_isAsduAvailable(MessageQueue self)
         retVal = false;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->queueLock);
+    Mutex_unlock(self->queueLock);
 #endif
 
     return retVal;
@@ -388,7 +405,7 @@ static void
 MessageQueue_setWaitingForTransmissionWhenNotConfirmed(MessageQueue self)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->queueLock);
+    Mutex_lock(self->queueLock);
 #endif
 
     if (self->entryCounter != 0) {
@@ -419,7 +436,7 @@ MessageQueue_setWaitingForTransmissionWhenNotConfirmed(MessageQueue self)
     }
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->queueLock);
+    Mutex_unlock(self->queueLock);
 #endif
 }
 
@@ -427,7 +444,7 @@ static void
 MessageQueue_releaseAllQueuedASDUs(MessageQueue self)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->queueLock);
+    Mutex_lock(self->queueLock);
 #endif
 
     self->firstEntry = NULL;
@@ -436,7 +453,7 @@ MessageQueue_releaseAllQueuedASDUs(MessageQueue self)
     self->entryCounter = 0;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->queueLock);
+    Mutex_unlock(self->queueLock);
 #endif
 }
 
@@ -469,7 +486,7 @@ static void
 MessageQueue_markAsduAsConfirmed(MessageQueue self, uint8_t* queueEntry, uint64_t entryId)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->queueLock);
+    Mutex_lock(self->queueLock);
 #endif
 
     if (self->entryCounter > 0) {
@@ -502,7 +519,7 @@ MessageQueue_markAsduAsConfirmed(MessageQueue self, uint8_t* queueEntry, uint64_
     }
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->queueLock);
+    Mutex_unlock(self->queueLock);
 #endif
 }
 
@@ -521,7 +538,7 @@ struct sHighPriorityASDUQueue {
     uint8_t* buffer;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore queueLock;
+    Mutex queueLock;
 #endif
 };
 
@@ -541,7 +558,7 @@ HighPriorityASDUQueue_initialize(HighPriorityASDUQueue self, int maxQueueSize)
     self->lastInBufferEntry = NULL;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    self->queueLock = Semaphore_create(1);
+    self->queueLock = Mutex_create();
 #endif
 }
 
@@ -564,7 +581,7 @@ HighPriorityASDUQueue_destroy(HighPriorityASDUQueue self)
             GLOBAL_FREEMEM(self->buffer);
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-        Semaphore_destroy(self->queueLock);
+        Mutex_destroy(self->queueLock);
 #endif
 
         GLOBAL_FREEMEM(self);
@@ -575,7 +592,7 @@ static void
 HighPriorityASDUQueue_lock(HighPriorityASDUQueue self)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->queueLock);
+    Mutex_lock(self->queueLock);
 #endif
 }
 
@@ -583,7 +600,7 @@ static void
 HighPriorityASDUQueue_unlock(HighPriorityASDUQueue self)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->queueLock);
+    Mutex_unlock(self->queueLock);
 #endif
 }
 
@@ -591,7 +608,7 @@ static bool
 HighPriorityASDUQueue_isAsduAvailable(HighPriorityASDUQueue self)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->queueLock);
+    Mutex_lock(self->queueLock);
 #endif
 
     bool retVal;
@@ -602,7 +619,7 @@ HighPriorityASDUQueue_isAsduAvailable(HighPriorityASDUQueue self)
         retVal = false;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->queueLock);
+    Mutex_unlock(self->queueLock);
 #endif
 
     return retVal;
@@ -648,6 +665,44 @@ HighPriorityASDUQueue_getNextASDU(HighPriorityASDUQueue self, int* size)
     return buffer;
 }
 
+/* returns the size of the largest entry (including the size field) that can be stored */
+static int
+HighPriorityASDUQueue_getFreeBytes(HighPriorityASDUQueue self)
+{
+    int freeBytes;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->queueLock);
+#endif
+
+    if (self->entryCounter > 0) {
+        uint16_t msgSize;
+
+        memcpy(&msgSize, self->lastEntry, sizeof(uint16_t));
+
+        uint8_t* nextMsgPtr = self->lastEntry + sizeof(uint16_t) + msgSize;
+
+        if (nextMsgPtr <= self->firstEntry) {
+            freeBytes = (int) (self->firstEntry - nextMsgPtr);
+        }
+        else {
+            /* the next entry can be stored at the end of the buffer or at the beginning */
+            int bytesAtEnd = (int) ((self->buffer + self->size) - nextMsgPtr);
+            int bytesAtStart = (int) (self->firstEntry - self->buffer);
+
+            freeBytes = (bytesAtEnd > bytesAtStart) ? bytesAtEnd : bytesAtStart;
+        }
+    }
+    else
+        freeBytes = self->size;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->queueLock);
+#endif
+
+    return freeBytes;
+}
+
 /* Depends on ASDU size! */
 static bool
 HighPriorityASDUQueue_isFull(HighPriorityASDUQueue self)
@@ -657,7 +712,7 @@ HighPriorityASDUQueue_isFull(HighPriorityASDUQueue self)
     int entrySize = sizeof(uint16_t) + (256 - IEC60870_5_104_APCI_LENGTH);
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->queueLock);
+    Mutex_lock(self->queueLock);
 #endif
 
     uint16_t msgSize;
@@ -680,7 +735,7 @@ HighPriorityASDUQueue_isFull(HighPriorityASDUQueue self)
     }
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->queueLock);
+    Mutex_unlock(self->queueLock);
 #endif
 
     return full;
@@ -699,7 +754,7 @@ HighPriorityASDUQueue_enqueue(HighPriorityASDUQueue self, CS101_ASDU asdu)
     int entrySize = sizeof(uint16_t) + asduSize;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->queueLock);
+    Mutex_lock(self->queueLock);
 #endif
 
     bool enqueued = true;
@@ -752,7 +807,7 @@ HighPriorityASDUQueue_enqueue(HighPriorityASDUQueue self, CS101_ASDU asdu)
     }
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->queueLock);
+    Mutex_unlock(self->queueLock);
 #endif
 
     return enqueued;
@@ -762,7 +817,7 @@ static void
 HighPriorityASDUQueue_resetConnectionQueue(HighPriorityASDUQueue self)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->queueLock);
+    Mutex_lock(self->queueLock);
 #endif
 
     self->firstEntry = 0;
@@ -771,7 +826,7 @@ HighPriorityASDUQueue_resetConnectionQueue(HighPriorityASDUQueue self)
     self->entryCounter = 0;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->queueLock);
+    Mutex_unlock(self->queueLock);
 #endif
 }
 
@@ -990,6 +1045,9 @@ struct sCS104_Slave {
     CS101_InterrogationHandler interrogationHandler;
     void* interrogationHandlerParameter;
 
+    CS101_InterrogationStreamHandler interrogationStreamHandler;
+    void* interrogationStreamHandlerParameter;
+
     CS101_CounterInterrogationHandler counterInterrogationHandler;
     void* counterInterrogationHandlerParameter;
 
@@ -1017,6 +1075,11 @@ struct sCS104_Slave {
     CS104_SlaveRawMessageHandler rawMessageHandler;
     void* rawMessageHandlerParameter;
 
+    CS104_WindowOpenHandler windowOpenHandler;
+    void* windowOpenHandlerParameter;
+
+    CS101_EventFilter eventFilter;
+
 #if (CONFIG_CS104_SUPPORT_TLS == 1)
     TLSConfiguration tlsConfig;
 #endif
@@ -1032,16 +1095,33 @@ struct sCS104_Slave {
     int openConnections; /**< number of connected clients */
     MasterConnection masterConnections[CONFIG_CS104_MAX_CLIENT_CONNECTIONS]; /**< references to all MasterConnection objects */
 
+    struct sMasterConnection* connectionTable; /**< contiguous storage of the frequently accessed connection state */
+    struct sMasterConnectionCold* connectionTableCold; /**< contiguous storage of buffers and rarely accessed connection state */
+
+    MasterConnection freeConnections[CONFIG_CS104_MAX_CLIENT_CONNECTIONS]; /**< stack of unused (pre-allocated) MasterConnection objects */
+    int numberOfFreeConnections;
+
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore openConnectionsLock;
+    Mutex openConnectionsLock;
+    Condition stateChanged; /**< signaled when server state (isStarting/isRunning) changes or all connections are closed */
 #endif
 
 #if (CONFIG_USE_THREADS == 1)
     bool isThreadlessMode;
 #endif
 
+    HandleSet handleSet; /**< sockets of all open connections (threadless mode only) */
+
+    SocketIoRing ioRing; /**< receives the data of all connections (threadless mode only, NULL when not supported) */
+
     int maxOpenConnections; /**< maximum accepted open client connections */
 
+    bool hasSocketOptions;
+    struct sSocketOptions socketOptions; /**< applied to accepted connections */
+
+    int slowConsumerWarningTime; /**< time (in ms) with blocked output until CS104_CON_EVENT_SLOW_CONSUMER is raised (0 = disabled) */
+    int slowConsumerCloseTime; /**< time (in ms) with blocked output until the connection is closed (0 = disabled) */
+
     struct sCS104_APCIParameters conParameters;
 
     struct sCS101_AppLayerParameters alParameters;
@@ -1061,6 +1141,11 @@ struct sCS104_Slave {
     char* localAddress;
     Thread listeningThread;
 
+#if (CONFIG_USE_THREADS == 1)
+    struct sThreadAttributes serverThreadAttributes;
+    struct sThreadAttributes connectionThreadAttributes;
+#endif
+
     ServerSocket serverSocket;
 
     LinkedList plugins;
@@ -1074,24 +1159,83 @@ typedef struct {
     int seqNo;
 } SentASDUSlave;
 
-struct sMasterConnection {
+/*
+ * Connection state that is only required when data is actually read or written, or
+ * that is rarely touched (buffers, TLS context, interface for the application).
+ */
+struct sMasterConnectionCold {
 
-    Socket socket;
+    /* can be moved to CS104_Slave struct */
+    struct sIMasterConnection iMasterConnection;
 
 #if (CONFIG_CS104_SUPPORT_TLS == 1)
     TLSSocket tlsSocket;
+
+    /* frames that are sent with the next TLS record (protected by outputLock) */
+    int tlsRecordLen;
+    bool collectTlsRecord; /* frames are sent at the end of the loop iteration of the connection */
+    uint8_t tlsRecordBuffer[CS104_TLS_RECORD_BUFFER_SIZE];
 #endif
 
-    /* can be moved to CS104_Slave struct */
-    struct sIMasterConnection iMasterConnection;
+    HandleSet handleSet;
 
-    CS104_Slave slave;
+    /* data read from the socket that is not yet handled */
+    int inBufStart;
+    int inBufEnd;
+    uint8_t inBuffer[CS104_INPUT_BUFFER_SIZE];
+
+    uint8_t recvBuffer[260]; /* the message that is currently handled */
+
+    uint8_t sendBuffer[260];
+
+    /* ring buffer for data that could not be written to the socket immediately */
+    int outBufStart;
+    int outBufCount;
+    uint8_t outBuffer[CONFIG_CS104_SLAVE_OUTPUT_BUFFER_SIZE];
+
+    /* socket ring that reads and writes the data of the connection (NULL = socket is read and written directly) */
+    SocketIoRing ioRing;
+    int ioRingSendSize; /* size of the pending send operation */
+    bool collectOutput; /* socket ring: frames are sent with one operation at the end of the loop iteration (protected by outputLock) */
+    SocketIoRing threadIoRing; /* socket ring of the connection handling thread (threaded mode, kept for the next connection) */
+
+    /* running interrogation response (see CS104_Slave_setInterrogationStreamHandler) */
+    uint8_t interrogationQOI;
+    int interrogationOA;
+    int interrogationCA;
+    uint32_t interrogationPosition;
+
+#if (CONFIG_CS104_SUPPORT_SERVER_MODE_MULTIPLE_REDUNDANCY_GROUPS == 1)
+    CS104_RedundancyGroup redundancyGroup;
+#endif
+
+#if (CONFIG_USE_THREADS == 1) && (CONFIG_USE_SEMAPHORES == 1)
+    /* connection handling thread that is kept for the following connections (protected by openConnectionsLock) */
+    Thread workerThread;
+    Condition workerSignal; /* signaled when a connection is assigned or the worker has to exit */
+    bool workerStartRequested;
+    bool workerExit;
+#endif
+};
+
+/*
+ * Connection state that is accessed for each frame and by the periodic timeout
+ * checks. Kept small so that the state of all connections (allocated as a contiguous
+ * table by the slave) stays in cache.
+ */
+struct sMasterConnection {
 
     unsigned int isUsed:1;
     unsigned int isActive:1;
     unsigned int isRunning:1;
     unsigned int timeoutT2Triggered:1;
     unsigned int waitingForTestFRcon:1;
+    unsigned int slowConsumerReported:1;
+    unsigned int interrogationRunning:1; /* interrogation response is provided by the interrogation stream handler */
+    unsigned int tlsHandshakeRunning:1; /* threadless mode: TLS handshake is advanced by the main loop */
+    unsigned int ioRingRecvPending:1; /* a receive operation for the input buffer is queued in the socket ring */
+    unsigned int ioRingDataReceived:1; /* the socket ring added data to the input buffer */
+    unsigned int ioRingSendPending:1; /* a send operation for the output buffer is queued in the socket ring (protected by outputLock) */
     uint16_t maxSentASDUs; /* k-parameter */
     int16_t  oldestSentASDU; /* oldest sent ASDU in k-buffer */
     int16_t  newestSentASDU; /* newest sent ASDU in k-buffer */
@@ -1106,25 +1250,23 @@ struct sMasterConnection {
     uint64_t nextT3Timeout;
     uint64_t nextTestFRConTimeout; /* timeout T1 when waiting for TEST FR con */
 
+    uint64_t outputStalledSince; /* time when data was first kept in the output buffer (0 = output buffer empty) */
+
     SentASDUSlave* sentASDUs;
 
+    CS104_Slave slave;
+
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore sentASDUsLock;
+    Mutex sentASDUsLock;
+    Mutex outputLock; /* protects the output buffer and the TLS record buffer */
 #endif
 
-    HandleSet handleSet;
-
-    uint8_t recvBuffer[260];
-    int recvBufPos;
-
-    uint8_t sendBuffer[260];
+    Socket socket;
 
     MessageQueue lowPrioQueue;
     HighPriorityASDUQueue highPrioQueue;
 
-#if (CONFIG_CS104_SUPPORT_SERVER_MODE_MULTIPLE_REDUNDANCY_GROUPS == 1)
-    CS104_RedundancyGroup redundancyGroup;
-#endif
+    struct sMasterConnectionCold* cold;
 };
 
 static uint8_t STARTDT_CON_MSG[] = { 0x68, 0x04, 0x0b, 0x00, 0x00, 0x00 };
@@ -1161,21 +1303,52 @@ initializeMessageQueues(CS104_Slave self, int lowPrioMaxQueueSize, int highPrioM
 }
 #endif /* (CONFIG_CS104_SUPPORT_SERVER_MODE_SINGLE_REDUNDANCY_GROUP == 1) */
 
-#if (CONFIG_CS104_SUPPORT_SERVER_MODE_CONNECTION_IS_REDUNDANCY_GROUP == 1)
+static MasterConnection
+MasterConnection_initialize(MasterConnection self, struct sMasterConnectionCold* cold, CS104_Slave slave);
+
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+static bool
+MasterConnection_startTls(MasterConnection self);
+#endif
+
+/**
+ * Prepare the pre-allocated MasterConnection objects before the server is started.
+ *
+ * All resources that depend on the configuration (k-buffer size, connection specific
+ * queues) are allocated here, so that accepting a new client only has to reset the
+ * state of a pooled connection object.
+ */
 static void
-initializeConnectionSpecificQueues(CS104_Slave self)
+initializeConnectionPool(CS104_Slave self)
 {
     int i;
 
     for (i = 0; i < CONFIG_CS104_MAX_CLIENT_CONNECTIONS; i++) {
-        self->masterConnections[i]->lowPrioQueue = MessageQueue_create(self->maxLowPrioQueueSize);
-        self->masterConnections[i]->highPrioQueue = HighPriorityASDUQueue_create(self->maxHighPrioQueueSize);
+
+        MasterConnection con = self->masterConnections[i];
+
+        if (con == NULL)
+            continue;
+
+        /* k parameter may have been changed after the slave was created */
+        if (con->maxSentASDUs != self->conParameters.k) {
+            GLOBAL_FREEMEM(con->sentASDUs);
+
+            con->maxSentASDUs = self->conParameters.k;
+            con->sentASDUs = (SentASDUSlave*) GLOBAL_CALLOC(con->maxSentASDUs, sizeof(SentASDUSlave));
+        }
+
+#if (CONFIG_CS104_SUPPORT_SERVER_MODE_CONNECTION_IS_REDUNDANCY_GROUP == 1)
+        if (self->serverMode == CS104_MODE_CONNECTION_IS_REDUNDANCY_GROUP) {
+            if (con->lowPrioQueue == NULL)
+                con->lowPrioQueue = MessageQueue_create(self->maxLowPrioQueueSize);
+
+            if (con->highPrioQueue == NULL)
+                con->highPrioQueue = HighPriorityASDUQueue_create(self->maxHighPrioQueueSize);
+        }
+#endif /* (CONFIG_CS104_SUPPORT_SERVER_MODE_CONNECTION_IS_REDUNDANCY_GROUP == 1) */
     }
 }
-#endif /* (CONFIG_CS104_SUPPORT_SERVER_MODE_CONNECTION_IS_REDUNDANCY_GROUP == 1) */
-
-static MasterConnection
-MasterConnection_create(CS104_Slave slave);
 
 static CS104_Slave
 createSlave(int maxLowPrioQueueSize, int maxHighPrioQueueSize)
@@ -1189,6 +1362,7 @@ createSlave(int maxLowPrioQueueSize, int maxHighPrioQueueSize)
 
         self->asduHandler = NULL;
         self->interrogationHandler = NULL;
+        self->interrogationStreamHandler = NULL;
         self->counterInterrogationHandler = NULL;
         self->readHandler = NULL;
         self->clockSyncHandler = NULL;
@@ -1197,24 +1371,46 @@ createSlave(int maxLowPrioQueueSize, int maxHighPrioQueueSize)
         self->connectionRequestHandler = NULL;
         self->connectionEventHandler = NULL;
         self->rawMessageHandler = NULL;
+        self->windowOpenHandler = NULL;
+        self->eventFilter = NULL;
         self->maxLowPrioQueueSize = maxLowPrioQueueSize;
         self->maxHighPrioQueueSize = maxHighPrioQueueSize;
 
-        {
+        self->connectionTable = (struct sMasterConnection*)
+                GLOBAL_CALLOC(CONFIG_CS104_MAX_CLIENT_CONNECTIONS, sizeof(struct sMasterConnection));
+
+        self->connectionTableCold = (struct sMasterConnectionCold*)
+                GLOBAL_CALLOC(CONFIG_CS104_MAX_CLIENT_CONNECTIONS, sizeof(struct sMasterConnectionCold));
+
+        if (self->connectionTable && self->connectionTableCold) {
             int i;
 
             for (i = 0; i < CONFIG_CS104_MAX_CLIENT_CONNECTIONS; i++) {
-                self->masterConnections[i] = MasterConnection_create(self);
+                self->masterConnections[i] = MasterConnection_initialize(&(self->connectionTable[i]),
+                        &(self->connectionTableCold[i]), self);
+
+                if (self->masterConnections[i])
+                    self->freeConnections[self->numberOfFreeConnections++] = self->masterConnections[i];
             }
         }
 
         self->maxOpenConnections = CONFIG_CS104_MAX_CLIENT_CONNECTIONS;
+        self->hasSocketOptions = false;
+        self->slowConsumerWarningTime = CS104_DEFAULT_SLOW_CONSUMER_WARNING_TIME;
+        self->slowConsumerCloseTime = 0;
 #if (CONFIG_USE_SEMAPHORES == 1)
-        self->openConnectionsLock = Semaphore_create(1);
+        self->openConnectionsLock = Mutex_create();
+        self->stateChanged = Condition_create();
 #endif
 
 #if (CONFIG_USE_THREADS == 1)
         self->isThreadlessMode = false;
+
+        ThreadAttributes_init(&(self->serverThreadAttributes));
+        ThreadAttributes_setName(&(self->serverThreadAttributes), "iec104-server");
+
+        ThreadAttributes_init(&(self->connectionThreadAttributes));
+        ThreadAttributes_setName(&(self->connectionThreadAttributes), "iec104-con");
 #endif
 
         self->isRunning = false;
@@ -1226,6 +1422,8 @@ createSlave(int maxLowPrioQueueSize, int maxHighPrioQueueSize)
         self->listeningThread = NULL;
 
         self->serverSocket = NULL;
+        self->handleSet = NULL;
+        self->ioRing = NULL;
 
         self->plugins = NULL;
 
@@ -1310,29 +1508,62 @@ CS104_Slave_getOpenConnections(CS104_Slave self)
     int openConnections;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->openConnectionsLock);
+    Mutex_lock(self->openConnectionsLock);
 #endif
 
     openConnections = self->openConnections;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->openConnectionsLock);
+    Mutex_unlock(self->openConnectionsLock);
 #endif
 
     return openConnections;
 }
 
+/**
+ * Return a connection to the pool of free connections (caller has to hold openConnectionsLock)
+ */
+static void
+releaseConnection(CS104_Slave self, MasterConnection connection)
+{
+    if (connection->isUsed) {
+        connection->isUsed = false;
+        self->freeConnections[self->numberOfFreeConnections++] = connection;
+        self->openConnections--;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        if (self->openConnections == 0)
+            Condition_broadcast(self->stateChanged);
+#endif
+    }
+}
+
+/**
+ * Wake up threads waiting for a change of isStarting or isRunning
+ */
+static void
+signalStateChange(CS104_Slave self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->openConnectionsLock);
+    Condition_broadcast(self->stateChanged);
+    Mutex_unlock(self->openConnectionsLock);
+#else
+    (void) self;
+#endif
+}
+
 static void
-decreaseConnectionCounter(CS104_Slave self)
+releaseFreeConnection(CS104_Slave self, MasterConnection connection)
 {
 #if (CONFIG_USE_SEMAPHORES)
-    Semaphore_wait(self->openConnectionsLock);
+    Mutex_lock(self->openConnectionsLock);
 #endif
 
-    self->openConnections--;
+    releaseConnection(self, connection);
 
 #if (CONFIG_USE_SEMAPHORES)
-    Semaphore_post(self->openConnectionsLock);
+    Mutex_unlock(self->openConnectionsLock);
 #endif
 }
 
@@ -1342,22 +1573,17 @@ getFreeConnection(CS104_Slave self)
     MasterConnection connection = NULL;
 
 #if (CONFIG_USE_SEMAPHORES)
-    Semaphore_wait(self->openConnectionsLock);
+    Mutex_lock(self->openConnectionsLock);
 #endif
 
-    int i;
-
-    for (i = 0; i < CONFIG_CS104_MAX_CLIENT_CONNECTIONS; i++) {
-        if ((self->masterConnections[i]) && (self->masterConnections[i]->isUsed == false)) {
-            connection = self->masterConnections[i];
-            connection->isUsed = true;
-            self->openConnections++;
-            break;
-        }
+    if (self->numberOfFreeConnections > 0) {
+        connection = self->freeConnections[--self->numberOfFreeConnections];
+        connection->isUsed = true;
+        self->openConnections++;
     }
 
 #if (CONFIG_USE_SEMAPHORES)
-    Semaphore_post(self->openConnectionsLock);
+    Mutex_unlock(self->openConnectionsLock);
 #endif
 
     return connection;
@@ -1368,7 +1594,7 @@ static void
 addOpenConnection(CS104_Slave self, MasterConnection connection)
 {
 #if (CONFIG_USE_SEMAPHORES)
-    Semaphore_wait(self->openConnectionsLock);
+    Mutex_lock(self->openConnectionsLock);
 #endif
 
     int i;
@@ -1382,7 +1608,7 @@ addOpenConnection(CS104_Slave self, MasterConnection connection)
     }
 
 #if (CONFIG_USE_SEMAPHORES)
-    Semaphore_post(self->openConnectionsLock);
+    Mutex_unlock(self->openConnectionsLock);
 #endif
 }
 #endif
@@ -1398,6 +1624,20 @@ CS104_Slave_setMaxOpenConnections(CS104_Slave self, int maxOpenConnections)
     self->maxOpenConnections = maxOpenConnections;
 }
 
+void
+CS104_Slave_setSocketOptions(CS104_Slave self, SocketOptions options)
+{
+    self->socketOptions = *options;
+    self->hasSocketOptions = true;
+}
+
+void
+CS104_Slave_setSlowConsumerThresholds(CS104_Slave self, int warningTimeInMs, int closeTimeInMs)
+{
+    self->slowConsumerWarningTime = warningTimeInMs;
+    self->slowConsumerCloseTime = closeTimeInMs;
+}
+
 void
 CS104_Slave_setConnectionRequestHandler(CS104_Slave self, CS104_ConnectionRequestHandler handler, void* parameter)
 {
@@ -1423,7 +1663,7 @@ CS104_Slave_activate(CS104_Slave self, MasterConnection connectionToActivate)
 
         /* Deactivate all other connections */
 #if (CONFIG_USE_SEMAPHORES == 1)
-        Semaphore_wait(self->openConnectionsLock);
+        Mutex_lock(self->openConnectionsLock);
 #endif
         int i;
 
@@ -1438,7 +1678,7 @@ CS104_Slave_activate(CS104_Slave self, MasterConnection connectionToActivate)
         }
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-        Semaphore_post(self->openConnectionsLock);
+        Mutex_unlock(self->openConnectionsLock);
 #endif
 
     }
@@ -1450,7 +1690,7 @@ CS104_Slave_activate(CS104_Slave self, MasterConnection connectionToActivate)
 
         /* Deactivate all other connections of the same redundancy group */
 #if (CONFIG_USE_SEMAPHORES == 1)
-        Semaphore_wait(self->openConnectionsLock);
+        Mutex_lock(self->openConnectionsLock);
 #endif
 
         int i;
@@ -1459,7 +1699,7 @@ CS104_Slave_activate(CS104_Slave self, MasterConnection connectionToActivate)
             MasterConnection con = self->masterConnections[i];
 
             if (con) {
-                if (con->redundancyGroup == connectionToActivate->redundancyGroup) {
+                if (con->cold->redundancyGroup == connectionToActivate->cold->redundancyGroup) {
                     if (con != connectionToActivate)
                         MasterConnection_deactivate(con);
                 }
@@ -1468,7 +1708,7 @@ CS104_Slave_activate(CS104_Slave self, MasterConnection connectionToActivate)
         }
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-        Semaphore_post(self->openConnectionsLock);
+        Mutex_unlock(self->openConnectionsLock);
 #endif
 
     }
@@ -1485,6 +1725,13 @@ CS104_Slave_setInterrogationHandler(CS104_Slave self, CS101_InterrogationHandler
     self->interrogationHandlerParameter = parameter;
 }
 
+void
+CS104_Slave_setInterrogationStreamHandler(CS104_Slave self, CS101_InterrogationStreamHandler handler, void* parameter)
+{
+    self->interrogationStreamHandler = handler;
+    self->interrogationStreamHandlerParameter = parameter;
+}
+
 void
 CS104_Slave_setCounterInterrogationHandler(CS104_Slave self, CS101_CounterInterrogationHandler handler, void*  parameter)
 {
@@ -1513,6 +1760,13 @@ CS104_Slave_setClockSyncHandler(CS104_Slave self, CS101_ClockSynchronizationHand
     self->clockSyncHandlerParameter = parameter;
 }
 
+void
+CS104_Slave_setWindowOpenHandler(CS104_Slave self, CS104_WindowOpenHandler handler, void* parameter)
+{
+    self->windowOpenHandler = handler;
+    self->windowOpenHandlerParameter = parameter;
+}
+
 void
 CS104_Slave_setRawMessageHandler(CS104_Slave self, CS104_SlaveRawMessageHandler handler, void* parameter)
 {
@@ -1572,8 +1826,8 @@ static int
 readFromSocket(MasterConnection self, uint8_t* buffer, int size)
 {
 #if (CONFIG_CS104_SUPPORT_TLS == 1)
-    if (self->tlsSocket != NULL)
-        return TLSSocket_read(self->tlsSocket, buffer, size);
+    if (self->cold->tlsSocket != NULL)
+        return TLSSocket_read(self->cold->tlsSocket, buffer, size);
     else
         return Socket_read(self->socket, buffer, size);
 #else
@@ -1582,75 +1836,102 @@ readFromSocket(MasterConnection self, uint8_t* buffer, int size)
 }
 
 /**
- * \brief Read message part into receive buffer
+ * \brief Get the length of the complete message at the start of the input buffer
+ *
+ * \return -1 in case of a framing error, 0 when no complete message is in the buffer, the message length otherwise
+ */
+static int
+getBufferedMessageLength(struct sMasterConnectionCold* cold)
+{
+    int available = cold->inBufEnd - cold->inBufStart;
+
+    if (available < 1)
+        return 0;
+
+    if (cold->inBuffer[cold->inBufStart] != 0x68)
+        return -1; /* message error */
+
+    if (available < 2)
+        return 0;
+
+    int length = cold->inBuffer[cold->inBufStart + 1] + 2;
+
+    if (available < length)
+        return 0;
+
+    return length;
+}
+
+/* move the incomplete message to the start of the input buffer */
+static void
+compactInputBuffer(struct sMasterConnectionCold* cold)
+{
+    if (cold->inBufStart > 0) {
+        memmove(cold->inBuffer, cold->inBuffer + cold->inBufStart, cold->inBufEnd - cold->inBufStart);
+        cold->inBufEnd -= cold->inBufStart;
+        cold->inBufStart = 0;
+    }
+}
+
+static bool
+isMessageBuffered(MasterConnection self)
+{
+    return (getBufferedMessageLength(self->cold) != 0);
+}
+
+/**
+ * \brief Get the next message from the input buffer into the receive buffer
+ *
+ * The socket is only read when the input buffer contains no complete message. All available
+ * data (up to the size of the input buffer) is read at once.
  *
  * \return -1 in case of an error, 0 when no complete message can be read, > 0 when a complete message is in buffer
  */
 static int
 receiveMessage(MasterConnection self)
 {
-    uint8_t* buffer = self->recvBuffer;
-    int bufPos = self->recvBufPos;
+    struct sMasterConnectionCold* cold = self->cold;
+
+    int length = getBufferedMessageLength(cold);
 
-    /* read start byte */
-    if (bufPos == 0) {
-        int readFirst = readFromSocket(self, buffer, 1);
+    if (length == 0) {
 
-        if (readFirst < 1)
-            return readFirst;
+        /* with the socket ring the data is received before the messages are handled */
+        if (cold->ioRing != NULL)
+            return 0;
 
-        if (buffer[0] != 0x68)
-            return -1; /* message error */
+        compactInputBuffer(cold);
 
-        bufPos++;
-    }
+        int readCnt = readFromSocket(self, cold->inBuffer + cold->inBufEnd, CS104_INPUT_BUFFER_SIZE - cold->inBufEnd);
 
-    /* read length byte */
-    if (bufPos == 1)  {
-        if (readFromSocket(self, buffer + 1, 1) != 1) {
-            self->recvBufPos = 0;
+        if (readCnt < 0)
             return -1;
-        }
 
-        bufPos++;
-    }
+        cold->inBufEnd += readCnt;
 
-    /* read remaining frame */
-    if (bufPos > 1) {
-        int length = buffer[1];
+        length = getBufferedMessageLength(cold);
+    }
 
-        int remainingLength = length - bufPos + 2;
+    if (length > 0) {
+        memcpy(cold->recvBuffer, cold->inBuffer + cold->inBufStart, length);
 
-        int readCnt = readFromSocket(self, buffer + bufPos, remainingLength);
+        cold->inBufStart += length;
 
-        if (readCnt == remainingLength) {
-            self->recvBufPos = 0;
-            return length + 2;
-        }
-        else if (readCnt == -1) {
-            self->recvBufPos = 0;
-            return -1;
-        }
-        else {
-            self->recvBufPos = bufPos + readCnt;
-            return 0;
+        if (cold->inBufStart == cold->inBufEnd) {
+            cold->inBufStart = 0;
+            cold->inBufEnd = 0;
         }
     }
 
-    self->recvBufPos = bufPos;
-    return 0;
+    return length;
 }
 
 static int
-writeToSocket(MasterConnection self, uint8_t* buf, int size)
+writeToSocketRaw(MasterConnection self, uint8_t* buf, int size)
 {
-    if (self->slave->rawMessageHandler)
-        self->slave->rawMessageHandler(self->slave->rawMessageHandlerParameter,
-                &(self->iMasterConnection), buf, size, true);
-
 #if (CONFIG_CS104_SUPPORT_TLS == 1)
-    if (self->tlsSocket)
-        return TLSSocket_write(self->tlsSocket, buf, size);
+    if (self->cold->tlsSocket)
+        return TLSSocket_write(self->cold->tlsSocket, buf, size);
     else
         return Socket_write(self->socket, buf, size);
 #else
@@ -1658,84 +1939,465 @@ writeToSocket(MasterConnection self, uint8_t* buf, int size)
 #endif
 }
 
-static int
-sendIMessage(MasterConnection self, uint8_t* buffer, int msgSize)
+/**
+ * Write as much of the output buffer to the socket as possible.
+ *
+ * \return false in case of a socket error
+ */
+static bool
+flushOutputBuffer(MasterConnection self)
 {
-    buffer[0] = (uint8_t) 0x68;
-    buffer[1] = (uint8_t) (msgSize - 2);
+    struct sMasterConnectionCold* cold = self->cold;
 
-    buffer[2] = (uint8_t) ((self->sendCount % 128) * 2);
-    buffer[3] = (uint8_t) (self->sendCount / 128);
+    while (cold->outBufCount > 0) {
 
-    buffer[4] = (uint8_t) ((self->receiveCount % 128) * 2);
-    buffer[5] = (uint8_t) (self->receiveCount / 128);
+        int size = CONFIG_CS104_SLAVE_OUTPUT_BUFFER_SIZE - cold->outBufStart;
 
-    if (writeToSocket(self, buffer, msgSize) > 0) {
-        DEBUG_PRINT("CS104 SLAVE: SEND I (size = %i) N(S) = %i N(R) = %i\n", msgSize, self->sendCount, self->receiveCount);
-        self->sendCount = (self->sendCount + 1) % 32768;
-        self->unconfirmedReceivedIMessages = 0;
-        self->timeoutT2Triggered = false;
+        if (size > cold->outBufCount)
+            size = cold->outBufCount;
+
+        int written = writeToSocketRaw(self, cold->outBuffer + cold->outBufStart, size);
+
+        if (written < 0)
+            return false;
+
+        if (written == 0)
+            break;
+
+        cold->outBufStart = (cold->outBufStart + written) % CONFIG_CS104_SLAVE_OUTPUT_BUFFER_SIZE;
+        cold->outBufCount -= written;
     }
-    else
-        self->isRunning = false;
 
-    self->unconfirmedReceivedIMessages = 0;
+    if (cold->outBufCount == 0) {
+        cold->outBufStart = 0;
+        self->outputStalledSince = 0;
+        self->slowConsumerReported = false;
+    }
 
-    return self->sendCount;
+    return true;
 }
 
 static bool
-isSentBufferFull(MasterConnection self)
+appendToOutputBuffer(MasterConnection self, uint8_t* buf, int size)
 {
-    /* locking of k-buffer has to be done by caller! */
-    if (self->oldestSentASDU == -1)
-        return false;
+    struct sMasterConnectionCold* cold = self->cold;
 
-    int newIndex = (self->newestSentASDU + 1) % (self->maxSentASDUs);
-
-    if (newIndex == self->oldestSentASDU)
-        return true;
-    else
+    if (size > (CONFIG_CS104_SLAVE_OUTPUT_BUFFER_SIZE - cold->outBufCount))
         return false;
-}
 
+    int writePos = (cold->outBufStart + cold->outBufCount) % CONFIG_CS104_SLAVE_OUTPUT_BUFFER_SIZE;
 
-static void
-sendASDU(MasterConnection self, uint8_t* buffer, int msgSize, uint64_t entryId, uint8_t* queueEntry)
-{
-    int currentIndex = 0;
+    int firstPart = CONFIG_CS104_SLAVE_OUTPUT_BUFFER_SIZE - writePos;
 
-    if (self->oldestSentASDU == -1) {
-        self->oldestSentASDU = 0;
-        self->newestSentASDU = 0;
-    }
-    else {
-        currentIndex = (self->newestSentASDU + 1) % self->maxSentASDUs;
-    }
+    if (firstPart > size)
+        firstPart = size;
 
-    self->sentASDUs[currentIndex].entryId = entryId;
-    self->sentASDUs[currentIndex].queueEntry = queueEntry;
-    self->sentASDUs[currentIndex].seqNo = sendIMessage(self, buffer, msgSize);
-    self->sentASDUs[currentIndex].sentTime = Hal_getTimeInMs();
+    memcpy(cold->outBuffer + writePos, buf, firstPart);
 
-    self->newestSentASDU = currentIndex;
+    if (firstPart < size)
+        memcpy(cold->outBuffer, buf + firstPart, size - firstPart);
 
-    printSendBuffer(self);
-}
+    cold->outBufCount += size;
 
+    return true;
+}
 
-static bool
-sendASDUInternal(MasterConnection self, CS101_ASDU asdu)
+/**
+ * Write data to the socket. When the socket cannot take all data (TCP window of the peer is
+ * closed) the remaining data is kept in the output buffer. The caller has to hold the output lock.
+ *
+ * With the socket ring the frames of the loop iteration are collected in the output buffer and
+ * sent with a single operation. Frames written outside of the loop iteration (e.g. by another
+ * thread) are written directly when no data of the connection is waiting.
+ *
+ * \return false on socket error or buffer overflow
+ */
+static bool
+sendOrBufferData(MasterConnection self, uint8_t* buf, int size)
+{
+    struct sMasterConnectionCold* cold = self->cold;
+
+    int written = 0;
+
+    if (cold->ioRing) {
+        /* the output buffer is used by the pending send operation of the ring */
+        if (self->ioRingSendPending || (cold->collectOutput && (size <= (CONFIG_CS104_SLAVE_OUTPUT_BUFFER_SIZE - cold->outBufCount)))) {
+            if (appendToOutputBuffer(self, buf, size) == false) {
+                DEBUG_PRINT("CS104 SLAVE: Output buffer overflow\n");
+                return false;
+            }
+
+            return true;
+        }
+    }
+
+    if (cold->outBufCount > 0) {
+        if (flushOutputBuffer(self) == false)
+            return false;
+    }
+
+    /* keep the order of the data -> only write directly when nothing is buffered */
+    if (cold->outBufCount == 0) {
+        written = writeToSocketRaw(self, buf, size);
+
+        if (written < 0)
+            return false;
+    }
+
+    if (written < size) {
+        if (appendToOutputBuffer(self, buf + written, size - written) == false) {
+            DEBUG_PRINT("CS104 SLAVE: Output buffer overflow\n");
+            return false;
+        }
+
+        if (self->outputStalledSince == 0)
+            self->outputStalledSince = Hal_getTimeInMs();
+    }
+
+    return true;
+}
+
+/**
+ * Queue a send operation for the data in the output buffer. It is submitted with the
+ * next submission of the socket ring. The caller has to hold the output lock.
+ */
+static void
+queueOutputBuffer(MasterConnection self)
+{
+    struct sMasterConnectionCold* cold = self->cold;
+
+    if ((cold->outBufCount > 0) && (self->ioRingSendPending == false)) {
+
+        int size = CONFIG_CS104_SLAVE_OUTPUT_BUFFER_SIZE - cold->outBufStart;
+
+        if (size > cold->outBufCount)
+            size = cold->outBufCount;
+
+        if (SocketIoRing_prepareSend(cold->ioRing, self->socket, cold->outBuffer + cold->outBufStart, size, self)) {
+            self->ioRingSendPending = true;
+            cold->ioRingSendSize = size;
+        }
+    }
+}
+
+/**
+ * Collect the frames of the connection in the output buffer until \ref sendCollectedOutput is called
+ */
+static void
+startOutputCollection(MasterConnection self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->outputLock);
+#endif
+
+    self->cold->collectOutput = true;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->outputLock);
+#endif
+}
+
+/**
+ * Queue a send operation for the frames collected since \ref startOutputCollection
+ */
+static void
+sendCollectedOutput(MasterConnection self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->outputLock);
+#endif
+
+    self->cold->collectOutput = false;
+
+    queueOutputBuffer(self);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->outputLock);
+#endif
+}
+
+/**
+ * Handle a completed receive or send operation of the socket ring
+ */
+static void
+handleIoRingCompletion(MasterConnection self, int result, bool isSend)
+{
+    struct sMasterConnectionCold* cold = self->cold;
+    if (isSend) {
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_lock(self->outputLock);
+#endif
+
+        self->ioRingSendPending = false;
+
+        if (result >= 0) {
+            cold->outBufStart = (cold->outBufStart + result) % CONFIG_CS104_SLAVE_OUTPUT_BUFFER_SIZE;
+            cold->outBufCount -= result;
+
+            if (cold->outBufCount == 0) {
+                cold->outBufStart = 0;
+                self->outputStalledSince = 0;
+                self->slowConsumerReported = false;
+            }
+            else if (result == cold->ioRingSendSize) {
+                /* the socket took all data -> the frames added in the meantime are sent with the next operation */
+                self->outputStalledSince = 0;
+            }
+            else if (self->outputStalledSince == 0) {
+                /* the socket didn't take all data */
+                self->outputStalledSince = Hal_getTimeInMs();
+            }
+        }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_unlock(self->outputLock);
+#endif
+
+        if ((result < 0) && self->isRunning) {
+            DEBUG_PRINT("CS104 SLAVE: Error writing to socket\n");
+            self->isRunning = false;
+        }
+    }
+    else {
+        self->ioRingRecvPending = false;
+
+        if (result > 0) {
+            cold->inBufEnd += result;
+            self->ioRingDataReceived = true;
+        }
+        else if (self->isRunning) {
+            DEBUG_PRINT("CS104 SLAVE: Error reading from socket\n");
+            self->isRunning = false;
+        }
+    }
+}
+
+/**
+ * Peer is not reading or the output buffer has no room for another frame
+ */
+static bool
+isOutputBlocked(MasterConnection self)
+{
+    if (self->outputStalledSince != 0)
+        return true;
+
+    return (self->cold->outBufCount > (CONFIG_CS104_SLAVE_OUTPUT_BUFFER_SIZE - (IEC60870_5_104_MAX_ASDU_LENGTH + IEC60870_5_104_APCI_LENGTH)));
+}
+
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+/**
+ * Send the collected frames as a single TLS record. The caller has to hold the output lock.
+ *
+ * \return false in case of a socket error
+ */
+static bool
+sendTlsRecord(MasterConnection self)
+{
+    struct sMasterConnectionCold* cold = self->cold;
+
+    if (cold->tlsRecordLen == 0)
+        return true;
+
+    int len = cold->tlsRecordLen;
+
+    cold->tlsRecordLen = 0;
+
+    if (sendOrBufferData(self, cold->tlsRecordBuffer, len) == false) {
+        DEBUG_PRINT("CS104 SLAVE: Failed to write TLS record\n");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Collect the frames of the connection in the TLS record buffer until \ref flushTlsRecord is called
+ */
+static void
+startTlsRecord(MasterConnection self)
+{
+    if (self->cold->tlsSocket) {
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_lock(self->outputLock);
+#endif
+
+        self->cold->collectTlsRecord = true;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_unlock(self->outputLock);
+#endif
+    }
+}
+
+/**
+ * Send the frames collected since \ref startTlsRecord. Frames written later are sent at once.
+ */
+static void
+flushTlsRecord(MasterConnection self)
+{
+    if (self->cold->tlsSocket) {
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_lock(self->outputLock);
+#endif
+
+        self->cold->collectTlsRecord = false;
+
+        if (sendTlsRecord(self) == false)
+            self->isRunning = false;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_unlock(self->outputLock);
+#endif
+    }
+}
+#endif /* (CONFIG_CS104_SUPPORT_TLS == 1) */
+
+/**
+ * Write a frame to the socket. When the socket cannot take the complete frame
+ * (TCP window of the peer is closed) the remaining data is kept in the output buffer.
+ *
+ * \return size when the frame was sent or buffered, -1 on socket error or buffer overflow
+ */
+static int
+writeToSocket(MasterConnection self, uint8_t* buf, int size)
+{
+    if (self->slave->rawMessageHandler)
+        self->slave->rawMessageHandler(self->slave->rawMessageHandlerParameter,
+                &(self->cold->iMasterConnection), buf, size, true);
+
+    bool success = true;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->outputLock);
+#endif
+
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+    if (self->cold->tlsSocket) {
+        struct sMasterConnectionCold* cold = self->cold;
+
+        /*
+         * Collect the frames of one loop iteration. They are sent as a single TLS record
+         * to avoid the record overhead (header, MAC, padding) for each frame.
+         */
+        if ((cold->tlsRecordLen + size) > CS104_TLS_RECORD_BUFFER_SIZE)
+            success = sendTlsRecord(self);
+
+        if (success) {
+            memcpy(cold->tlsRecordBuffer + cold->tlsRecordLen, buf, size);
+            cold->tlsRecordLen += size;
+
+            /* frames written outside of the loop iteration (e.g. by another thread) are not delayed */
+            if (cold->collectTlsRecord == false)
+                success = sendTlsRecord(self);
+        }
+    }
+    else
+        success = sendOrBufferData(self, buf, size);
+#else
+    success = sendOrBufferData(self, buf, size);
+#endif /* (CONFIG_CS104_SUPPORT_TLS == 1) */
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->outputLock);
+#endif
+
+    if (success)
+        return size;
+    else
+        return -1;
+}
+
+static int
+sendIMessage(MasterConnection self, uint8_t* buffer, int msgSize)
+{
+    buffer[0] = (uint8_t) 0x68;
+    buffer[1] = (uint8_t) (msgSize - 2);
+
+    buffer[2] = (uint8_t) ((self->sendCount % 128) * 2);
+    buffer[3] = (uint8_t) (self->sendCount / 128);
+
+    buffer[4] = (uint8_t) ((self->receiveCount % 128) * 2);
+    buffer[5] = (uint8_t) (self->receiveCount / 128);
+
+    if (writeToSocket(self, buffer, msgSize) > 0) {
+        DEBUG_PRINT("CS104 SLAVE: SEND I (size = %i) N(S) = %i N(R) = %i\n", msgSize, self->sendCount, self->receiveCount);
+        self->sendCount = (self->sendCount + 1) % 32768;
+        self->unconfirmedReceivedIMessages = 0;
+        self->timeoutT2Triggered = false;
+    }
+    else
+        self->isRunning = false;
+
+    self->unconfirmedReceivedIMessages = 0;
+
+    return self->sendCount;
+}
+
+static bool
+isSentBufferFull(MasterConnection self)
+{
+    /* locking of k-buffer has to be done by caller! */
+    if (self->oldestSentASDU == -1)
+        return false;
+
+    int newIndex = (self->newestSentASDU + 1) % (self->maxSentASDUs);
+
+    if (newIndex == self->oldestSentASDU)
+        return true;
+    else
+        return false;
+}
+
+
+static int
+getFreeWindowSlots(MasterConnection self)
+{
+    /* locking of k-buffer has to be done by caller! */
+    if (self->oldestSentASDU == -1)
+        return self->maxSentASDUs;
+
+    int sentASDUs = ((self->newestSentASDU - self->oldestSentASDU + self->maxSentASDUs) % self->maxSentASDUs) + 1;
+
+    return self->maxSentASDUs - sentASDUs;
+}
+
+static void
+sendASDU(MasterConnection self, uint8_t* buffer, int msgSize, uint64_t entryId, uint8_t* queueEntry)
+{
+    int currentIndex = 0;
+
+    if (self->oldestSentASDU == -1) {
+        self->oldestSentASDU = 0;
+        self->newestSentASDU = 0;
+    }
+    else {
+        currentIndex = (self->newestSentASDU + 1) % self->maxSentASDUs;
+    }
+
+    self->sentASDUs[currentIndex].entryId = entryId;
+    self->sentASDUs[currentIndex].queueEntry = queueEntry;
+    self->sentASDUs[currentIndex].seqNo = sendIMessage(self, buffer, msgSize);
+    self->sentASDUs[currentIndex].sentTime = Hal_getTimeInMs();
+
+    self->newestSentASDU = currentIndex;
+
+    printSendBuffer(self);
+}
+
+
+static bool
+sendASDUInternal(MasterConnection self, CS101_ASDU asdu)
 {
     bool asduSent;
 
     if (self->isActive) {
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-        Semaphore_wait(self->sentASDUsLock);
+        Mutex_lock(self->sentASDUsLock);
 #endif
 
-        if (isSentBufferFull(self) == false) {
+        /* queued ASDUs have to be sent first to keep the order of the messages */
+        if ((isSentBufferFull(self) == false) && (HighPriorityASDUQueue_isAsduAvailable(self->highPrioQueue) == false)) {
 
             FrameBuffer frameBuffer;
 
@@ -1749,14 +2411,14 @@ sendASDUInternal(MasterConnection self, CS101_ASDU asdu)
             sendASDU(self, frameBuffer.msg, frameBuffer.msgSize, 0, NULL);
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-            Semaphore_post(self->sentASDUsLock);
+            Mutex_unlock(self->sentASDUsLock);
 #endif
 
             asduSent = true;
         }
         else {
 #if (CONFIG_USE_SEMAPHORES == 1)
-            Semaphore_post(self->sentASDUsLock);
+            Mutex_unlock(self->sentASDUsLock);
 #endif
             asduSent = HighPriorityASDUQueue_enqueue(self->highPrioQueue, asdu);
         }
@@ -1781,6 +2443,44 @@ responseCOTUnknown(CS101_ASDU asdu, MasterConnection self)
     sendASDUInternal(self, asdu);
 }
 
+/*
+ * Start or stop the interrogation response that is provided by the interrogation stream handler.
+ * The response itself is sent by runInterrogationStream.
+ */
+static void
+handleInterrogationStreamCommand(MasterConnection self, CS101_ASDU asdu, uint8_t qoi)
+{
+    if (CS101_ASDU_getCOT(asdu) == CS101_COT_ACTIVATION) {
+
+        if ((qoi < IEC60870_QOI_STATION) || (qoi > IEC60870_QOI_GROUP_16)) {
+            CS101_ASDU_setCOT(asdu, CS101_COT_ACTIVATION_CON);
+            CS101_ASDU_setNegative(asdu, true);
+            sendASDUInternal(self, asdu);
+            return;
+        }
+
+        CS101_ASDU_setCOT(asdu, CS101_COT_ACTIVATION_CON);
+        CS101_ASDU_setNegative(asdu, false);
+
+        if (sendASDUInternal(self, asdu)) {
+            /* a new interrogation command restarts the response */
+            self->cold->interrogationQOI = qoi;
+            self->cold->interrogationOA = CS101_ASDU_getOA(asdu);
+            self->cold->interrogationCA = CS101_ASDU_getCA(asdu);
+            self->cold->interrogationPosition = 0;
+            self->interrogationRunning = true;
+        }
+    }
+    else {
+        CS101_ASDU_setCOT(asdu, CS101_COT_DEACTIVATION_CON);
+        CS101_ASDU_setNegative(asdu, (self->interrogationRunning == false));
+
+        self->interrogationRunning = false;
+
+        sendASDUInternal(self, asdu);
+    }
+}
+
 /*
  * Handle received ASDUs
  *
@@ -1803,7 +2503,7 @@ handleASDU(MasterConnection self, CS101_ASDU asdu)
 
             CS101_SlavePlugin plugin = (CS101_SlavePlugin) LinkedList_getData(pluginElem);
 
-            CS101_SlavePlugin_Result result = plugin->handleAsdu(plugin->parameter, &(self->iMasterConnection), asdu);
+            CS101_SlavePlugin_Result result = plugin->handleAsdu(plugin->parameter, &(self->cold->iMasterConnection), asdu);
 
             if (result == CS101_PLUGIN_RESULT_HANDLED)
                 return true;
@@ -1821,7 +2521,20 @@ handleASDU(MasterConnection self, CS101_ASDU asdu)
         DEBUG_PRINT("CS104 SLAVE: Rcvd interrogation command C_IC_NA_1\n");
 
         if ((cot == CS101_COT_ACTIVATION) || (cot == CS101_COT_DEACTIVATION)) {
-            if (slave->interrogationHandler != NULL) {
+            if (slave->interrogationStreamHandler != NULL) {
+
+                union uInformationObject _io;
+
+                InterrogationCommand irc = (InterrogationCommand) CS101_ASDU_getElementEx(asdu, (InformationObject) &_io, 0);
+
+                if (irc) {
+                    handleInterrogationStreamCommand(self, asdu, InterrogationCommand_getQOI(irc));
+                    messageHandled = true;
+                }
+                else
+                    return false;
+            }
+            else if (slave->interrogationHandler != NULL) {
 
                 union uInformationObject _io;
 
@@ -1829,7 +2542,7 @@ handleASDU(MasterConnection self, CS101_ASDU asdu)
 
                 if (irc) {
                     if (slave->interrogationHandler(slave->interrogationHandlerParameter,
-                            &(self->iMasterConnection), asdu, InterrogationCommand_getQOI(irc)))
+                            &(self->cold->iMasterConnection), asdu, InterrogationCommand_getQOI(irc)))
                         messageHandled = true;
                 }
                 else
@@ -1856,7 +2569,7 @@ handleASDU(MasterConnection self, CS101_ASDU asdu)
 
                 if (cic) {
                     if (slave->counterInterrogationHandler(slave->counterInterrogationHandlerParameter,
-                            &(self->iMasterConnection), asdu, CounterInterrogationCommand_getQCC(cic)))
+                            &(self->cold->iMasterConnection), asdu, CounterInterrogationCommand_getQCC(cic)))
                         messageHandled = true;
                 }
                 else
@@ -1881,7 +2594,7 @@ handleASDU(MasterConnection self, CS101_ASDU asdu)
 
                 if (rc) {
                     if (slave->readHandler(slave->readHandlerParameter,
-                            &(self->iMasterConnection), asdu, InformationObject_getObjectAddress((InformationObject) rc)))
+                            &(self->cold->iMasterConnection), asdu, InformationObject_getObjectAddress((InformationObject) rc)))
                         messageHandled = true;
                 }
                 else
@@ -1909,7 +2622,7 @@ handleASDU(MasterConnection self, CS101_ASDU asdu)
                     CP56Time2a newTime = ClockSynchronizationCommand_getTime(csc);
 
                     if (slave->clockSyncHandler(slave->clockSyncHandlerParameter,
-                            &(self->iMasterConnection), asdu, newTime)) {
+                            &(self->cold->iMasterConnection), asdu, newTime)) {
 
                         CS101_ASDU_removeAllElements(asdu);
 
@@ -1970,7 +2683,7 @@ handleASDU(MasterConnection self, CS101_ASDU asdu)
 
                 if (rpc) {
                     if (slave->resetProcessHandler(slave->resetProcessHandlerParameter,
-                            &(self->iMasterConnection), asdu, ResetProcessCommand_getQRP(rpc)))
+                            &(self->cold->iMasterConnection), asdu, ResetProcessCommand_getQRP(rpc)))
                         messageHandled = true;
                 }
                 else
@@ -1997,7 +2710,7 @@ handleASDU(MasterConnection self, CS101_ASDU asdu)
 
                 if (dac) {
                     if (slave->delayAcquisitionHandler(slave->delayAcquisitionHandlerParameter,
-                            &(self->iMasterConnection), asdu, DelayAcquisitionCommand_getDelay(dac)))
+                            &(self->cold->iMasterConnection), asdu, DelayAcquisitionCommand_getDelay(dac)))
                         messageHandled = true;
                 }
                 else
@@ -2033,7 +2746,7 @@ handleASDU(MasterConnection self, CS101_ASDU asdu)
     }
 
     if ((messageHandled == false) && (slave->asduHandler != NULL))
-        if (slave->asduHandler(slave->asduHandlerParameter, &(self->iMasterConnection), asdu))
+        if (slave->asduHandler(slave->asduHandlerParameter, &(self->cold->iMasterConnection), asdu))
             messageHandled = true;
 
     if (messageHandled == false) {
@@ -2050,9 +2763,11 @@ static bool
 checkSequenceNumber(MasterConnection self, int seqNo)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->sentASDUsLock);
+    Mutex_lock(self->sentASDUsLock);
 #endif
 
+    int freeWindowSlotsBefore = getFreeWindowSlots(self);
+
     /* check if received sequence number is valid */
 
     bool seqNoIsValid = false;
@@ -2141,11 +2856,16 @@ checkSequenceNumber(MasterConnection self, int seqNo)
     else
         DEBUG_PRINT("CS104 SLAVE: Received sequence number out of range");
 
+    int freeWindowSlots = getFreeWindowSlots(self);
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->sentASDUsLock);
+    Mutex_unlock(self->sentASDUsLock);
 #endif
 
+    /* called without holding the lock so that the handler can send ASDUs */
+    if ((freeWindowSlots > freeWindowSlotsBefore) && self->isActive && self->slave->windowOpenHandler)
+        self->slave->windowOpenHandler(self->slave->windowOpenHandlerParameter, &(self->cold->iMasterConnection), freeWindowSlots);
+
     return seqNoIsValid;
 }
 
@@ -2365,8 +3085,8 @@ MasterConnection_deinit(MasterConnection self)
 {
     if (self) {
 #if (CONFIG_CS104_SUPPORT_TLS == 1)
-        if (self->tlsSocket != NULL)
-            TLSSocket_close(self->tlsSocket);
+        if (self->cold->tlsSocket != NULL)
+            TLSSocket_close(self->cold->tlsSocket);
 #endif
 
         Socket_destroy(self->socket);
@@ -2374,17 +3094,21 @@ MasterConnection_deinit(MasterConnection self)
 }
 
 static void
-MasterConnection_destroy(MasterConnection self)
+MasterConnection_finalize(MasterConnection self)
 {
     if (self) {
 
         GLOBAL_FREEMEM(self->sentASDUs);
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-        Semaphore_destroy(self->sentASDUsLock);
+        Mutex_destroy(self->sentASDUsLock);
+        Mutex_destroy(self->outputLock);
 #endif
 
-        Handleset_destroy(self->handleSet);
+        Handleset_destroy(self->cold->handleSet);
+
+        if (self->cold->threadIoRing)
+            SocketIoRing_destroy(self->cold->threadIoRing);
 
 #if (CONFIG_CS104_SUPPORT_SERVER_MODE_CONNECTION_IS_REDUNDANCY_GROUP == 1)
         if (self->slave->serverMode == CS104_MODE_CONNECTION_IS_REDUNDANCY_GROUP) {
@@ -2392,16 +3116,17 @@ MasterConnection_destroy(MasterConnection self)
             HighPriorityASDUQueue_destroy(self->highPrioQueue);
         }
 #endif
-
-        GLOBAL_FREEMEM(self);
     }
 }
 
-static void
+/* returns true when an ASDU was sent */
+static bool
 sendNextLowPriorityASDU(MasterConnection self)
 {
+    bool retVal = false;
+
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->sentASDUsLock);
+    Mutex_lock(self->sentASDUsLock);
 #endif
 
     uint8_t* asduBuffer;
@@ -2418,11 +3143,13 @@ sendNextLowPriorityASDU(MasterConnection self)
     asduBuffer = MessageQueue_getNextWaitingASDU(self->lowPrioQueue, &entryId, &queueEntry, &msgSize);
 
     if (asduBuffer) {
-        memcpy(self->sendBuffer + IEC60870_5_104_APCI_LENGTH, asduBuffer, msgSize);
+        memcpy(self->cold->sendBuffer + IEC60870_5_104_APCI_LENGTH, asduBuffer, msgSize);
 
         msgSize += IEC60870_5_104_APCI_LENGTH;
 
-        sendASDU(self, self->sendBuffer, msgSize, entryId, queueEntry);
+        sendASDU(self, self->cold->sendBuffer, msgSize, entryId, queueEntry);
+
+        retVal = true;
     }
 
     MessageQueue_unlock(self->lowPrioQueue);
@@ -2430,10 +3157,10 @@ sendNextLowPriorityASDU(MasterConnection self)
 exit_function:
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->sentASDUsLock);
+    Mutex_unlock(self->sentASDUsLock);
 #endif
 
-    return;
+    return retVal;
 }
 
 static bool
@@ -2442,7 +3169,7 @@ sendNextHighPriorityASDU(MasterConnection self)
     bool retVal = false;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->sentASDUsLock);
+    Mutex_lock(self->sentASDUsLock);
 #endif
 
     if (isSentBufferFull(self))
@@ -2454,11 +3181,11 @@ sendNextHighPriorityASDU(MasterConnection self)
     uint8_t* buffer = HighPriorityASDUQueue_getNextASDU(self->highPrioQueue, &msgSize);
 
     if (buffer) {
-        memcpy(self->sendBuffer + IEC60870_5_104_APCI_LENGTH, buffer, msgSize);
+        memcpy(self->cold->sendBuffer + IEC60870_5_104_APCI_LENGTH, buffer, msgSize);
 
         msgSize += IEC60870_5_104_APCI_LENGTH;
 
-        sendASDU(self, self->sendBuffer, msgSize, 0, NULL);
+        sendASDU(self, self->cold->sendBuffer, msgSize, 0, NULL);
 
         retVal = true;
     }
@@ -2467,12 +3194,62 @@ sendNextHighPriorityASDU(MasterConnection self)
 
 exit_function:
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->sentASDUsLock);
+    Mutex_unlock(self->sentASDUsLock);
 #endif
 
     return retVal;
 }
 
+/*
+ * Send all high-priority ASDUs and the low-priority ASDUs until the k-buffer is full.
+ * The socket is corked when more than one message is sent, so that the messages are
+ * combined into full TCP segments.
+ */
+static bool
+sendWaitingASDUBatch(MasterConnection self)
+{
+    bool isAsduWaiting = false;
+    bool corked = false;
+    int sentMessages = 0;
+
+    while (HighPriorityASDUQueue_isAsduAvailable(self->highPrioQueue)) {
+
+        if ((sentMessages == 1) && (corked == false)) {
+            Socket_setCork(self->socket, true);
+            corked = true;
+        }
+
+        if ((sendNextHighPriorityASDU(self) == false) || (self->isRunning == false)) {
+            isAsduWaiting = true;
+            goto exit_function;
+        }
+
+        sentMessages++;
+    }
+
+    while (self->isRunning && (isOutputBlocked(self) == false)) {
+
+        if ((sentMessages == 1) && (corked == false)) {
+            Socket_setCork(self->socket, true);
+            corked = true;
+        }
+
+        if (sendNextLowPriorityASDU(self) == false)
+            break;
+
+        sentMessages++;
+    }
+
+    isAsduWaiting = MessageQueue_isAsduAvailable(self->lowPrioQueue);
+
+exit_function:
+
+    if (corked)
+        Socket_setCork(self->socket, false);
+
+    return isAsduWaiting;
+}
+
 /**
  * Send all high-priority ASDUs and the last waiting ASDU from the low-priority queue.
  * Returns true if ASDUs are still waiting. This can happen when there are more ASDUs
@@ -2482,6 +3259,13 @@ exit_function:
 static bool
 sendWaitingASDUs(MasterConnection self)
 {
+    /* peer is not reading -> keep the ASDUs in the queues until the output buffer is flushed */
+    if (isOutputBlocked(self))
+        return false;
+
+    if (self->slave->hasSocketOptions && self->slave->socketOptions.corkBatches)
+        return sendWaitingASDUBatch(self);
+
     /* send all available high priority ASDUs first */
     while (HighPriorityASDUQueue_isAsduAvailable(self->highPrioQueue)) {
 
@@ -2501,12 +3285,73 @@ sendWaitingASDUs(MasterConnection self)
         return false;
 }
 
+static bool
+handleOutputBuffer(MasterConnection self, uint64_t currentTime)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->outputLock);
+#endif
+
+    bool flushed = true;
+
+    /* with the socket ring the output buffer is sent by the send operation of the ring */
+    if (self->cold->ioRing == NULL)
+        flushed = flushOutputBuffer(self);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->outputLock);
+#endif
+
+    if (flushed == false) {
+        DEBUG_PRINT("CS104 SLAVE: Failed to write buffered data\n");
+        return false;
+    }
+
+    if (self->outputStalledSince != 0) {
+
+        /* output stalled time is in the future (maybe caused by system time change) */
+        if (self->outputStalledSince > currentTime)
+            self->outputStalledSince = currentTime;
+
+        uint64_t stalledTime = currentTime - self->outputStalledSince;
+
+        CS104_Slave slave = self->slave;
+
+        if ((slave->slowConsumerCloseTime > 0) && (stalledTime >= (uint64_t) slave->slowConsumerCloseTime)) {
+            DEBUG_PRINT("CS104 SLAVE: Slow consumer - output blocked for %i ms -> close connection\n", (int) stalledTime);
+            return false;
+        }
+
+        if ((self->slowConsumerReported == false) && (slave->slowConsumerWarningTime > 0) &&
+                (stalledTime >= (uint64_t) slave->slowConsumerWarningTime))
+        {
+            self->slowConsumerReported = true;
+
+            DEBUG_PRINT("CS104 SLAVE: Slow consumer - output blocked for %i ms\n", (int) stalledTime);
+
+            if (slave->connectionEventHandler)
+                slave->connectionEventHandler(slave->connectionEventHandlerParameter, &(self->cold->iMasterConnection), CS104_CON_EVENT_SLOW_CONSUMER);
+        }
+    }
+
+    return true;
+}
+
 static bool
 handleTimeouts(MasterConnection self)
 {
     uint64_t currentTime = Hal_getTimeInMs();
 
-    bool timeoutsOk = true;
+    bool timeoutsOk = true;
+
+    /* the send operation of the socket ring waits until the peer reads again */
+    if (self->ioRingSendPending && (self->outputStalledSince == 0))
+        self->outputStalledSince = currentTime;
+
+    if (self->outputStalledSince != 0) {
+        if (handleOutputBuffer(self, currentTime) == false)
+            return false;
+    }
 
     /* check T3 timeout */
     if (checkT3Timeout(self, currentTime)) {
@@ -2551,7 +3396,7 @@ handleTimeouts(MasterConnection self)
     }
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_wait(self->sentASDUsLock);
+    Mutex_lock(self->sentASDUsLock);
 #endif
 
     /* check if counterpart confirmed I message */
@@ -2578,7 +3423,7 @@ handleTimeouts(MasterConnection self)
     }
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore_post(self->sentASDUsLock);
+    Mutex_unlock(self->sentASDUsLock);
 #endif
 
     return timeoutsOk;
@@ -2588,26 +3433,17 @@ static void
 CS104_Slave_removeConnection(CS104_Slave self, MasterConnection connection)
 {
 #if (CONFIG_USE_SEMAPHORES)
-    Semaphore_wait(self->openConnectionsLock);
+    Mutex_lock(self->openConnectionsLock);
 #endif
 
-    self->openConnections--;
-
-    int i;
-
-    for (i = 0; i < CONFIG_CS104_MAX_CLIENT_CONNECTIONS; i++) {
-        if (self->masterConnections[i] == connection) {
-            self->masterConnections[i]->isUsed = false;
-            break;
-        }
-    }
+    releaseConnection(self, connection);
 
     MessageQueue_setWaitingForTransmissionWhenNotConfirmed(connection->lowPrioQueue);
 
     MasterConnection_deinit(connection);
 
 #if (CONFIG_USE_SEMAPHORES)
-    Semaphore_post(self->openConnectionsLock);
+    Mutex_unlock(self->openConnectionsLock);
 #endif
 }
 
@@ -2615,7 +3451,7 @@ static void
 CS104_Slave_closeAllConnections(CS104_Slave self) 
 {
 #if (CONFIG_USE_SEMAPHORES)
-    Semaphore_wait(self->openConnectionsLock);
+    Mutex_lock(self->openConnectionsLock);
 #endif
 
     int i;
@@ -2623,16 +3459,250 @@ CS104_Slave_closeAllConnections(CS104_Slave self)
     for (i = 0; i < CONFIG_CS104_MAX_CLIENT_CONNECTIONS; i++) {
         if (self->masterConnections[i]) {
             if (self->masterConnections[i]->isUsed) {
-                self->masterConnections[i]->isUsed = false;
+                releaseConnection(self, self->masterConnections[i]);
                 MasterConnection_deinit(self->masterConnections[i]);
             }
         }
     }
 
-    self->openConnections = 0;
-
 #if (CONFIG_USE_SEMAPHORES)
-    Semaphore_post(self->openConnectionsLock);
+    Mutex_unlock(self->openConnectionsLock);
+#endif
+}
+
+static void
+runPluginTasks(CS104_Slave self, MasterConnection con)
+{
+    if (self->plugins) {
+
+        LinkedList pluginElem = LinkedList_getNext(self->plugins);
+
+        while (pluginElem) {
+
+            CS101_SlavePlugin plugin = (CS101_SlavePlugin) LinkedList_getData(pluginElem);
+
+            plugin->runTask(plugin->parameter, &(con->cold->iMasterConnection));
+
+            pluginElem = LinkedList_getNext(pluginElem);
+        }
+    }
+}
+
+static void
+closePluginConnections(CS104_Slave self, MasterConnection con)
+{
+    if (self->plugins) {
+
+        LinkedList pluginElem = LinkedList_getNext(self->plugins);
+
+        while (pluginElem) {
+
+            CS101_SlavePlugin plugin = (CS101_SlavePlugin) LinkedList_getData(pluginElem);
+
+            if (plugin->connectionClosed)
+                plugin->connectionClosed(plugin->parameter, &(con->cold->iMasterConnection));
+
+            pluginElem = LinkedList_getNext(pluginElem);
+        }
+    }
+}
+
+/* returns true when the k window can take another ASDU and no older response is waiting in the queue */
+static bool
+canSendResponseDirectly(MasterConnection self)
+{
+    bool canSend;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->sentASDUsLock);
+#endif
+
+    canSend = (isSentBufferFull(self) == false) && (HighPriorityASDUQueue_isAsduAvailable(self->highPrioQueue) == false);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->sentASDUsLock);
+#endif
+
+    return canSend;
+}
+
+/*
+ * Pull the next parts of a running interrogation response from the interrogation stream handler.
+ *
+ * The handler is only called when the ASDU can be sent immediately. The response doesn't use the
+ * high priority queue and is continued when the master confirms the sent ASDUs.
+ */
+static void
+runInterrogationStream(MasterConnection self)
+{
+    CS104_Slave slave = self->slave;
+
+    /* limits the number of handler calls when the handler doesn't provide information objects */
+    int maxCalls = self->maxSentASDUs;
+
+    while (self->interrogationRunning && self->isActive && (isOutputBlocked(self) == false) && (maxCalls > 0)) {
+
+        if (slave->interrogationStreamHandler == NULL) {
+            self->interrogationRunning = false;
+            break;
+        }
+
+        if (canSendResponseDirectly(self) == false)
+            break;
+
+        struct sMasterConnectionCold* cold = self->cold;
+
+        sCS101_StaticASDU _asdu;
+
+        CS101_ASDU asdu = CS101_ASDU_initializeStatic(&_asdu, &(slave->alParameters), false,
+                (CS101_CauseOfTransmission) cold->interrogationQOI, cold->interrogationOA, cold->interrogationCA, false, false);
+
+        bool moreFollows = slave->interrogationStreamHandler(slave->interrogationStreamHandlerParameter,
+                &(cold->iMasterConnection), cold->interrogationQOI, &(cold->interrogationPosition), asdu);
+
+        if (CS101_ASDU_getNumberOfElements(asdu) > 0)
+            sendASDUInternal(self, asdu);
+
+        if (moreFollows == false) {
+
+            asdu = CS101_ASDU_initializeStatic(&_asdu, &(slave->alParameters), false,
+                    CS101_COT_ACTIVATION_TERMINATION, cold->interrogationOA, cold->interrogationCA, false, false);
+
+            union uInformationObject _io;
+
+            CS101_ASDU_addInformationObject(asdu, (InformationObject) InterrogationCommand_create((InterrogationCommand) &_io, 0, cold->interrogationQOI));
+
+            sendASDUInternal(self, asdu);
+
+            self->interrogationRunning = false;
+        }
+
+        maxCalls--;
+    }
+}
+
+#if (CONFIG_CS104_SLAVE_USE_IO_RING == 1)
+/**
+ * Threaded mode: read and write the socket with the socket ring of the connection handling thread.
+ * The input and output buffers are registered with the ring.
+ */
+static void
+startConnectionIoRing(MasterConnection self)
+{
+    struct sMasterConnectionCold* cold = self->cold;
+
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+    /* TLS connections are read and written by the TLS layer */
+    if (cold->tlsSocket)
+        return;
+#endif
+
+    if (cold->threadIoRing == NULL) {
+        /* a receive and a send operation */
+        cold->threadIoRing = SocketIoRing_create(2);
+
+        if (cold->threadIoRing)
+            SocketIoRing_registerBuffer(cold->threadIoRing, (uint8_t*) cold, sizeof(struct sMasterConnectionCold));
+    }
+
+    if (cold->threadIoRing) {
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_lock(self->outputLock);
+#endif
+
+        cold->ioRing = cold->threadIoRing;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_unlock(self->outputLock);
+#endif
+    }
+}
+#endif /* (CONFIG_CS104_SLAVE_USE_IO_RING == 1) */
+
+/**
+ * Threaded mode: submit the queued operations and wait until one of them is completed.
+ *
+ * \return 1 when data was received, 0 on timeout or when only a send operation was completed, -1 on error (closes the connection)
+ */
+static int
+receiveWithConnectionIoRing(MasterConnection self, int timeoutMs)
+{
+    struct sMasterConnectionCold* cold = self->cold;
+
+    if (self->ioRingRecvPending == false) {
+        compactInputBuffer(cold);
+
+        if (cold->inBufEnd < CS104_INPUT_BUFFER_SIZE) {
+            if (SocketIoRing_prepareReceive(cold->ioRing, self->socket, cold->inBuffer + cold->inBufEnd,
+                    CS104_INPUT_BUFFER_SIZE - cold->inBufEnd, self))
+                self->ioRingRecvPending = true;
+        }
+    }
+
+    if (SocketIoRing_submitAndWait(cold->ioRing, (unsigned int) timeoutMs) == false) {
+        DEBUG_PRINT("CS104 SLAVE: Failed to submit socket operations\n");
+        self->isRunning = false;
+        return -1;
+    }
+
+    void* userData;
+    int result;
+    bool isSend;
+
+    while (SocketIoRing_getCompletion(cold->ioRing, &userData, &result, &isSend))
+        handleIoRingCompletion(self, result, isSend);
+
+    if (self->ioRingDataReceived) {
+        self->ioRingDataReceived = false;
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * Threaded mode: cancel the pending operations before the buffers are used by the next connection
+ */
+static void
+stopConnectionIoRing(MasterConnection self)
+{
+    struct sMasterConnectionCold* cold = self->cold;
+
+    int waitCycles = 0;
+
+    while ((self->ioRingRecvPending || self->ioRingSendPending) && (waitCycles < 100)) {
+        waitCycles++;
+
+        SocketIoRing_cancel(cold->ioRing, self);
+
+        if (SocketIoRing_submitAndWait(cold->ioRing, 10) == false)
+            break;
+
+        void* userData;
+        int result;
+        bool isSend;
+
+        while (SocketIoRing_getCompletion(cold->ioRing, &userData, &result, &isSend))
+            handleIoRingCompletion(self, result, isSend);
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(self->outputLock);
+#endif
+
+    /* the kernel may still use the buffers -> closing the ring cancels the operations */
+    if (self->ioRingRecvPending || self->ioRingSendPending) {
+        SocketIoRing_destroy(cold->threadIoRing);
+        cold->threadIoRing = NULL;
+
+        self->ioRingRecvPending = false;
+        self->ioRingSendPending = false;
+    }
+
+    cold->ioRing = NULL;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(self->outputLock);
 #endif
 }
 
@@ -2643,18 +3713,29 @@ connectionHandlingThread(void* parameter)
 
     self->isRunning = true;
 
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+    /* the handshake is done here so that a slow peer doesn't block the accept loop of the server thread */
+    if (MasterConnection_startTls(self) == false)
+        goto exit_function;
+#endif
+
     resetT3Timeout(self, Hal_getTimeInMs());
 
     bool isAsduWaiting = false;
 
     if (self->slave->connectionEventHandler) {
-        self->slave->connectionEventHandler(self->slave->connectionEventHandlerParameter, &(self->iMasterConnection), CS104_CON_EVENT_CONNECTION_OPENED);
+        self->slave->connectionEventHandler(self->slave->connectionEventHandlerParameter, &(self->cold->iMasterConnection), CS104_CON_EVENT_CONNECTION_OPENED);
     }
 
-    while (self->isRunning) {
+    /* the handle set of a pooled connection may still contain the socket of the previous connection */
+    Handleset_reset(self->cold->handleSet);
+    Handleset_addSocket(self->cold->handleSet, self->socket);
+
+#if (CONFIG_CS104_SLAVE_USE_IO_RING == 1)
+    startConnectionIoRing(self);
+#endif
 
-        Handleset_reset(self->handleSet);
-        Handleset_addSocket(self->handleSet, self->socket);
+    while (self->isRunning) {
 
         int socketTimeout;
 
@@ -2664,53 +3745,101 @@ connectionHandlingThread(void* parameter)
          */
         if (isAsduWaiting)
             socketTimeout = 1;
+        else if (self->outputStalledSince != 0)
+            socketTimeout = 10; /* retry to flush the output buffer */
         else
             socketTimeout = 100;
 
-        if (Handleset_waitReady(self->handleSet, socketTimeout)) {
+        int readyHandles;
 
-            int bytesRec = receiveMessage(self);
+        /* the socket ring also submits the send operation of the previous loop iteration */
+        if (self->cold->ioRing)
+            readyHandles = receiveWithConnectionIoRing(self, socketTimeout);
+        else
+            readyHandles = Handleset_waitReady(self->cold->handleSet, socketTimeout);
 
-            if (bytesRec == -1) {
-                DEBUG_PRINT("CS104 SLAVE: Error reading from socket\n");
-                break;
-            }
+        if (self->cold->ioRing)
+            startOutputCollection(self);
+
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+        startTlsRecord(self);
+#endif
+
+        if (readyHandles > 0) {
 
-            if (bytesRec > 0) {
-                DEBUG_PRINT("CS104 SLAVE: Connection: rcvd msg(%i bytes)\n", bytesRec);
+            int bytesRec;
 
-                if (self->slave->rawMessageHandler)
-                    self->slave->rawMessageHandler(self->slave->rawMessageHandlerParameter,
-                            &(self->iMasterConnection), self->recvBuffer, bytesRec, false);
+            /* handle all complete messages that have been received with a single read */
+            do {
+                bytesRec = receiveMessage(self);
+
+                if (bytesRec == -1) {
+                    DEBUG_PRINT("CS104 SLAVE: Error reading from socket\n");
+                    break;
+                }
 
-                if (handleMessage(self, self->recvBuffer, bytesRec) == false)
-                    self->isRunning = false;
+                if (bytesRec > 0) {
+                    DEBUG_PRINT("CS104 SLAVE: Connection: rcvd msg(%i bytes)\n", bytesRec);
 
-                if (self->unconfirmedReceivedIMessages >= self->slave->conParameters.w) {
+                    if (self->slave->rawMessageHandler)
+                        self->slave->rawMessageHandler(self->slave->rawMessageHandlerParameter,
+                                &(self->cold->iMasterConnection), self->cold->recvBuffer, bytesRec, false);
 
-                    self->lastConfirmationTime = Hal_getTimeInMs();
+                    if (handleMessage(self, self->cold->recvBuffer, bytesRec) == false)
+                        self->isRunning = false;
 
-                    self->unconfirmedReceivedIMessages = 0;
+                    if (self->unconfirmedReceivedIMessages >= self->slave->conParameters.w) {
 
-                    self->timeoutT2Triggered = false;
+                        self->lastConfirmationTime = Hal_getTimeInMs();
 
-                    sendSMessage(self);
+                        self->unconfirmedReceivedIMessages = 0;
+
+                        self->timeoutT2Triggered = false;
+
+                        sendSMessage(self);
+                    }
                 }
-            }
+            } while ((bytesRec > 0) && self->isRunning && isMessageBuffered(self));
+
+            if (bytesRec == -1)
+                break;
         }
 
         if (handleTimeouts(self) == false)
             self->isRunning = false;
 
-        if (self->isRunning)
-            if (self->isActive)
+        if (self->isRunning) {
+            if (self->isActive) {
+                runInterrogationStream(self);
+
+                /* plugins (e.g. file server) can fill the queue before it is sent */
+                runPluginTasks(self->slave, self);
+
                 isAsduWaiting = sendWaitingASDUs(self);
+            }
+        }
+
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+        flushTlsRecord(self);
+#endif
+
+        if (self->cold->ioRing)
+            sendCollectedOutput(self);
     }
 
+    if (self->cold->ioRing)
+        stopConnectionIoRing(self);
+
     if (self->slave->connectionEventHandler) {
-       self->slave->connectionEventHandler(self->slave->connectionEventHandlerParameter, &(self->iMasterConnection), CS104_CON_EVENT_CONNECTION_CLOSED);
+       self->slave->connectionEventHandler(self->slave->connectionEventHandlerParameter, &(self->cold->iMasterConnection), CS104_CON_EVENT_CONNECTION_CLOSED);
     }
 
+    closePluginConnections(self->slave, self);
+
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+exit_function:
+#endif
+
     self->isRunning = false;
 
     CS104_Slave_removeConnection(self->slave, self);
@@ -2728,6 +3857,9 @@ _IMasterConnection_isReady(IMasterConnection self)
     MasterConnection con = (MasterConnection) self->object;
 
     if (con->isActive) {
+        if (isOutputBlocked(con))
+            return false;
+
         if (isSentBufferFull(con) == false)
             return true;
 
@@ -2740,6 +3872,36 @@ _IMasterConnection_isReady(IMasterConnection self)
         return false;
 }
 
+static bool
+_IMasterConnection_isReadyEx(IMasterConnection self, int* freeWindowSlots, int* freeQueueBytes)
+{
+    MasterConnection con = (MasterConnection) self->object;
+
+    if (freeWindowSlots) {
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_lock(con->sentASDUsLock);
+#endif
+
+        /* the free slots are used by the ASDUs that are waiting in the queue first */
+        if (HighPriorityASDUQueue_isAsduAvailable(con->highPrioQueue))
+            *freeWindowSlots = 0;
+        else
+            *freeWindowSlots = getFreeWindowSlots(con);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_unlock(con->sentASDUsLock);
+#endif
+
+        if ((con->isActive == false) || isOutputBlocked(con))
+            *freeWindowSlots = 0;
+    }
+
+    if (freeQueueBytes)
+        *freeQueueBytes = HighPriorityASDUQueue_getFreeBytes(con->highPrioQueue);
+
+    return _IMasterConnection_isReady(self);
+}
+
 static bool
 _IMasterConnection_sendASDU(IMasterConnection self, CS101_ASDU asdu)
 {
@@ -2809,38 +3971,39 @@ _IMasterConnection_getApplicationLayerParameters(IMasterConnection self)
  *******************************************/
 
 static MasterConnection
-MasterConnection_create(CS104_Slave slave)
+MasterConnection_initialize(MasterConnection self, struct sMasterConnectionCold* cold, CS104_Slave slave)
 {
-    MasterConnection self = (MasterConnection) GLOBAL_CALLOC(1, sizeof(struct sMasterConnection));
-
     if (self != NULL) {
+        self->cold = cold;
         self->isUsed = false;
         self->slave = slave;
         self->maxSentASDUs = slave->conParameters.k;
         self->sentASDUs = (SentASDUSlave*) GLOBAL_CALLOC(self->maxSentASDUs, sizeof(SentASDUSlave));
 
-        self->iMasterConnection.object = self;
-        self->iMasterConnection.getApplicationLayerParameters = _IMasterConnection_getApplicationLayerParameters;
-        self->iMasterConnection.isReady = _IMasterConnection_isReady;
-        self->iMasterConnection.sendASDU = _IMasterConnection_sendASDU;
-        self->iMasterConnection.sendACT_CON = _IMasterConnection_sendACT_CON;
-        self->iMasterConnection.sendACT_TERM = _IMasterConnection_sendACT_TERM;
-        self->iMasterConnection.close = _IMasterConnection_close;
-        self->iMasterConnection.getPeerAddress = _IMasterConnection_getPeerAddress;
+        self->cold->iMasterConnection.object = self;
+        self->cold->iMasterConnection.getApplicationLayerParameters = _IMasterConnection_getApplicationLayerParameters;
+        self->cold->iMasterConnection.isReady = _IMasterConnection_isReady;
+        self->cold->iMasterConnection.isReadyEx = _IMasterConnection_isReadyEx;
+        self->cold->iMasterConnection.sendASDU = _IMasterConnection_sendASDU;
+        self->cold->iMasterConnection.sendACT_CON = _IMasterConnection_sendACT_CON;
+        self->cold->iMasterConnection.sendACT_TERM = _IMasterConnection_sendACT_TERM;
+        self->cold->iMasterConnection.close = _IMasterConnection_close;
+        self->cold->iMasterConnection.getPeerAddress = _IMasterConnection_getPeerAddress;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-        self->sentASDUsLock = Semaphore_create(1);
+        self->sentASDUsLock = Mutex_create();
+        self->outputLock = Mutex_create();
 #endif
-        self->handleSet = Handleset_new();
+        self->cold->handleSet = Handleset_new();
 
         /* initialize pointers with NULL to avoid segmentation fault on destroy call */
         self->socket = NULL;
 #if (CONFIG_CS104_SUPPORT_TLS == 1)
-        self->tlsSocket = NULL;
+        self->cold->tlsSocket = NULL;
 #endif
 
 #if (CONFIG_CS104_SUPPORT_SERVER_MODE_MULTIPLE_REDUNDANCY_GROUPS == 1)
-        self->redundancyGroup = NULL;
+        self->cold->redundancyGroup = NULL;
 #endif
         self->lowPrioQueue = NULL;
         self->highPrioQueue = NULL;
@@ -2858,7 +4021,21 @@ MasterConnection_init(MasterConnection self, Socket skt, MessageQueue lowPrioQue
         self->isRunning = false;
         self->receiveCount = 0;
         self->sendCount = 0;
-        self->recvBufPos = 0;
+        self->cold->inBufStart = 0;
+        self->cold->inBufEnd = 0;
+        self->cold->outBufStart = 0;
+        self->cold->outBufCount = 0;
+        self->outputStalledSince = 0;
+        self->slowConsumerReported = false;
+        self->interrogationRunning = false;
+        self->tlsHandshakeRunning = false;
+        self->ioRingRecvPending = false;
+        self->ioRingDataReceived = false;
+        self->ioRingSendPending = false;
+        self->cold->collectOutput = false;
+
+        /* threadless mode: all connections use the socket ring of the slave */
+        self->cold->ioRing = self->slave->ioRing;
 
         self->unconfirmedReceivedIMessages = 0;
         self->lastConfirmationTime = UINT64_MAX;
@@ -2871,18 +4048,10 @@ MasterConnection_init(MasterConnection self, Socket skt, MessageQueue lowPrioQue
         resetT3Timeout(self, Hal_getTimeInMs());
 
 #if (CONFIG_CS104_SUPPORT_TLS == 1)
-        if (self->slave->tlsConfig != NULL) {
-            self->tlsSocket = TLSSocket_create(skt, self->slave->tlsConfig, false);
-
-            if (self->tlsSocket == NULL) {
-                DEBUG_PRINT("CS104 SLAVE: Failed to create TLS context. Close connection\n");
-
-                self->isUsed = false;
-                return false;
-            }
-        }
-        else
-            self->tlsSocket = NULL;
+        /* the TLS session is created by MasterConnection_startTls */
+        self->cold->tlsRecordLen = 0;
+        self->cold->collectTlsRecord = false;
+        self->cold->tlsSocket = NULL;
 #endif
 
         /* for the mode CS104_MODE_CONNECTION_IS_REDUNDANCY_GROUP we use the connection specific queues */
@@ -2892,19 +4061,93 @@ MasterConnection_init(MasterConnection self, Socket skt, MessageQueue lowPrioQue
             MessageQueue_releaseAllQueuedASDUs(self->lowPrioQueue);
         }
 
-        if (highPrioQueue)
-            self->highPrioQueue = highPrioQueue;
+        if (highPrioQueue)
+            self->highPrioQueue = highPrioQueue;
+
+        HighPriorityASDUQueue_resetConnectionQueue(self->highPrioQueue);
+
+        self->waitingForTestFRcon = false;
+
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+/**
+ * Perform the TLS handshake of a new connection (when TLS is configured).
+ *
+ * \return false when the handshake failed or timed out
+ */
+static bool
+MasterConnection_startTls(MasterConnection self)
+{
+    if (self->slave->tlsConfig != NULL) {
+        self->cold->tlsSocket = TLSSocket_create(self->socket, self->slave->tlsConfig, false);
+
+        if (self->cold->tlsSocket == NULL) {
+            DEBUG_PRINT("CS104 SLAVE: Failed to create TLS context. Close connection\n");
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Start the TLS handshake of a new connection without waiting for the handshake messages
+ * of the client (threadless mode). The handshake is continued by MasterConnection_continueTls.
+ *
+ * \return false when the TLS context cannot be created
+ */
+static bool
+MasterConnection_startTlsNonBlocking(MasterConnection self)
+{
+    if (self->slave->tlsConfig != NULL) {
+        self->cold->tlsSocket = TLSSocket_createNonBlocking(self->socket, self->slave->tlsConfig, false);
+
+        if (self->cold->tlsSocket == NULL) {
+            DEBUG_PRINT("CS104 SLAVE: Failed to create TLS context. Close connection\n");
+
+            return false;
+        }
+
+        self->tlsHandshakeRunning = true;
+    }
+
+    return true;
+}
+
+/**
+ * Continue the TLS handshake of a connection (threadless mode). The connection is opened
+ * when the handshake is complete and closed when the handshake failed or timed out.
+ */
+static void
+MasterConnection_continueTls(MasterConnection self)
+{
+    int result = TLSSocket_continueHandshake(self->cold->tlsSocket);
 
-        HighPriorityASDUQueue_resetConnectionQueue(self->highPrioQueue);
+    if (result > 0) {
+        self->tlsHandshakeRunning = false;
 
-        self->waitingForTestFRcon = false;
+        resetT3Timeout(self, Hal_getTimeInMs());
 
-        return true;
+        CS104_Slave slave = self->slave;
+
+        if (slave->connectionEventHandler) {
+            slave->connectionEventHandler(slave->connectionEventHandlerParameter, &(self->cold->iMasterConnection), CS104_CON_EVENT_CONNECTION_OPENED);
+        }
     }
-    else {
-        return false;
+    else if (result < 0) {
+        DEBUG_PRINT("CS104 SLAVE: TLS handshake failed. Close connection\n");
+
+        self->isRunning = false;
     }
 }
+#endif /* (CONFIG_CS104_SUPPORT_TLS == 1) */
 
 #if (CONFIG_CS104_SUPPORT_SERVER_MODE_MULTIPLE_REDUNDANCY_GROUPS == 1)
 static bool
@@ -2916,7 +4159,7 @@ MasterConnection_initEx(MasterConnection self, Socket skt, CS104_RedundancyGroup
         retVal = MasterConnection_init(self, skt, redGroup->asduQueue, redGroup->connectionAsduQueue);
 
         if (retVal)
-            self->redundancyGroup = redGroup;
+            self->cold->redundancyGroup = redGroup;
     }
 
     return retVal;
@@ -2924,6 +4167,95 @@ MasterConnection_initEx(MasterConnection self, Socket skt, CS104_RedundancyGroup
 #endif /* (CONFIG_CS104_SUPPORT_SERVER_MODE_MULTIPLE_REDUNDANCY_GROUPS == 1) */
 
 
+#if (CONFIG_USE_THREADS == 1) && (CONFIG_USE_SEMAPHORES == 1)
+/*
+ * Handles all connections that are assigned to the pooled connection object. The thread
+ * is created with the first connection and waits for the next one when the connection is closed.
+ */
+static void*
+connectionWorkerThread(void* parameter)
+{
+    MasterConnection self = (MasterConnection) parameter;
+    struct sMasterConnectionCold* cold = self->cold;
+    CS104_Slave slave = self->slave;
+
+    Mutex_lock(slave->openConnectionsLock);
+
+    while (true) {
+
+        while ((cold->workerStartRequested == false) && (cold->workerExit == false))
+            Condition_wait(cold->workerSignal, slave->openConnectionsLock);
+
+        if (cold->workerExit)
+            break;
+
+        cold->workerStartRequested = false;
+
+        Mutex_unlock(slave->openConnectionsLock);
+
+        connectionHandlingThread(self);
+
+        Mutex_lock(slave->openConnectionsLock);
+    }
+
+    Mutex_unlock(slave->openConnectionsLock);
+
+    return NULL;
+}
+
+static void
+MasterConnection_stopWorker(MasterConnection self)
+{
+    struct sMasterConnectionCold* cold = self->cold;
+
+    if (cold->workerThread) {
+        Mutex_lock(self->slave->openConnectionsLock);
+
+        cold->workerExit = true;
+        Condition_signal(cold->workerSignal);
+
+        Mutex_unlock(self->slave->openConnectionsLock);
+
+        /* waits until the thread is terminated */
+        Thread_destroy(cold->workerThread);
+
+        cold->workerThread = NULL;
+    }
+
+    if (cold->workerSignal) {
+        Condition_destroy(cold->workerSignal);
+        cold->workerSignal = NULL;
+    }
+}
+
+static void
+MasterConnection_start(MasterConnection self)
+{
+    struct sMasterConnectionCold* cold = self->cold;
+
+    Mutex_lock(self->slave->openConnectionsLock);
+
+    cold->workerStartRequested = true;
+
+    if (cold->workerThread == NULL) {
+        cold->workerExit = false;
+
+        if (cold->workerSignal == NULL)
+            cold->workerSignal = Condition_create();
+
+        cold->workerThread = Thread_create(connectionWorkerThread, (void*) self, false);
+
+        Thread_setAttributes(cold->workerThread, &(self->slave->connectionThreadAttributes));
+
+        Thread_start(cold->workerThread);
+    }
+    else {
+        Condition_signal(cold->workerSignal);
+    }
+
+    Mutex_unlock(self->slave->openConnectionsLock);
+}
+#else
 static void
 MasterConnection_start(MasterConnection self)
 {
@@ -2931,8 +4263,13 @@ MasterConnection_start(MasterConnection self)
            Thread_create((ThreadExecutionFunction) connectionHandlingThread,
                    (void*) self, true);
 
+#if (CONFIG_USE_THREADS == 1)
+    Thread_setAttributes(newThread, &(self->slave->connectionThreadAttributes));
+#endif
+
     Thread_start(newThread);
 }
+#endif /* (CONFIG_USE_THREADS == 1) && (CONFIG_USE_SEMAPHORES == 1) */
 
 void
 MasterConnection_close(MasterConnection self)
@@ -2945,10 +4282,13 @@ MasterConnection_deactivate(MasterConnection self)
 {
     if (self->isActive == true) {
         if (self->slave->connectionEventHandler) {
-             self->slave->connectionEventHandler(self->slave->connectionEventHandlerParameter, &(self->iMasterConnection), CS104_CON_EVENT_DEACTIVATED);
+             self->slave->connectionEventHandler(self->slave->connectionEventHandlerParameter, &(self->cold->iMasterConnection), CS104_CON_EVENT_DEACTIVATED);
         }
     }
 
+    /* a running interrogation response is not continued after STOPDT */
+    self->interrogationRunning = false;
+
     self->isActive = false;
 }
 
@@ -2957,7 +4297,7 @@ MasterConnection_activate(MasterConnection self)
 {
     if (self->isActive == false) {
         if (self->slave->connectionEventHandler) {
-             self->slave->connectionEventHandler(self->slave->connectionEventHandlerParameter, &(self->iMasterConnection), CS104_CON_EVENT_ACTIVATED);
+             self->slave->connectionEventHandler(self->slave->connectionEventHandlerParameter, &(self->cold->iMasterConnection), CS104_CON_EVENT_ACTIVATED);
         }
     }
 
@@ -2967,87 +4307,176 @@ MasterConnection_activate(MasterConnection self)
 static void
 MasterConnection_handleTcpConnection(MasterConnection self)
 {
-    int bytesRec = receiveMessage(self);
-
-    if (bytesRec < 0) {
-        DEBUG_PRINT("CS104 SLAVE: Error reading from socket\n");
-        self->isRunning = false;
-    }
+    int bytesRec;
 
-    if ((bytesRec > 0) && (self->isRunning)) {
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+    /* the record is sent by MasterConnection_executePeriodicTasks */
+    startTlsRecord(self);
+#endif
 
-        if (self->slave->rawMessageHandler)
-            self->slave->rawMessageHandler(self->slave->rawMessageHandlerParameter,
-                    &(self->iMasterConnection), self->recvBuffer, bytesRec, false);
+    /* handle all complete messages that have been received with a single read */
+    do {
+        bytesRec = receiveMessage(self);
 
-        if (handleMessage(self, self->recvBuffer, bytesRec) == false)
+        if (bytesRec < 0) {
+            DEBUG_PRINT("CS104 SLAVE: Error reading from socket\n");
             self->isRunning = false;
+        }
 
-        if (self->unconfirmedReceivedIMessages >= self->slave->conParameters.w) {
+        if ((bytesRec > 0) && (self->isRunning)) {
 
-            self->lastConfirmationTime = Hal_getTimeInMs();
+            if (self->slave->rawMessageHandler)
+                self->slave->rawMessageHandler(self->slave->rawMessageHandlerParameter,
+                        &(self->cold->iMasterConnection), self->cold->recvBuffer, bytesRec, false);
 
-            self->unconfirmedReceivedIMessages = 0;
+            if (handleMessage(self, self->cold->recvBuffer, bytesRec) == false)
+                self->isRunning = false;
 
-            self->timeoutT2Triggered = false;
+            if (self->unconfirmedReceivedIMessages >= self->slave->conParameters.w) {
 
-            sendSMessage(self);
+                self->lastConfirmationTime = Hal_getTimeInMs();
+
+                self->unconfirmedReceivedIMessages = 0;
+
+                self->timeoutT2Triggered = false;
+
+                sendSMessage(self);
+            }
         }
-    }
+    } while ((bytesRec > 0) && self->isRunning && isMessageBuffered(self));
 }
 
 static void
 MasterConnection_executePeriodicTasks(MasterConnection self)
 {
-    if (self->isActive)
-        sendWaitingASDUs(self);
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+    startTlsRecord(self);
+#endif
 
     if (handleTimeouts(self) == false)
         self->isRunning = false;
+
+    /* same order as in connectionHandlingThread */
+    if (self->isRunning) {
+        if (self->isActive) {
+            runInterrogationStream(self);
+
+            /* plugins (e.g. file server) can fill the queue before it is sent */
+            runPluginTasks(self->slave, self);
+
+            sendWaitingASDUs(self);
+        }
+    }
+
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+    flushTlsRecord(self);
+#endif
 }
 
+/*
+ * Receive the data of all running connections with a single system call. A receive
+ * operation into the free part of the input buffer is queued for each connection
+ * that has none pending. The operations are submitted together with the send operations
+ * of the previous loop iteration and the completions are collected with one call that
+ * also waits (up to 1 ms) for the first completion.
+ */
 static void
-handleClientConnections(CS104_Slave self)
+receiveWithIoRing(CS104_Slave self)
+{
+    int i;
+
+    for (i = 0; i < CONFIG_CS104_MAX_CLIENT_CONNECTIONS; i++) {
+        MasterConnection con = self->masterConnections[i];
+
+        if (con != NULL && con->isUsed && con->isRunning && (con->ioRingRecvPending == false)) {
+            struct sMasterConnectionCold* cold = con->cold;
+
+            compactInputBuffer(cold);
+
+            if (cold->inBufEnd < CS104_INPUT_BUFFER_SIZE) {
+                if (SocketIoRing_prepareReceive(self->ioRing, con->socket, cold->inBuffer + cold->inBufEnd,
+                        CS104_INPUT_BUFFER_SIZE - cold->inBufEnd, con))
+                    con->ioRingRecvPending = true;
+            }
+        }
+    }
+
+    if (SocketIoRing_submitAndWait(self->ioRing, 1) == false)
+        DEBUG_PRINT("CS104 SLAVE: Failed to submit receive operations\n");
+
+    void* userData;
+    int result;
+    bool isSend;
+
+    while (SocketIoRing_getCompletion(self->ioRing, &userData, &result, &isSend))
+        handleIoRingCompletion((MasterConnection) userData, result, isSend);
+}
+
+/*
+ * Queue the send operations for the frames of the loop iteration. They are submitted
+ * with the receive operations of the next loop iteration.
+ */
+static void
+sendWithIoRing(CS104_Slave self)
 {
-    HandleSet handleset = NULL;
+    int i;
 
+    for (i = 0; i < CONFIG_CS104_MAX_CLIENT_CONNECTIONS; i++) {
+        MasterConnection con = self->masterConnections[i];
+
+        if (con != NULL && con->isUsed && con->isRunning)
+            sendCollectedOutput(con);
+    }
+
+    if (SocketIoRing_submit(self->ioRing) == false)
+        DEBUG_PRINT("CS104 SLAVE: Failed to submit send operations\n");
+}
+
+static void
+handleClientConnections(CS104_Slave self)
+{
     if (self->openConnections > 0) {
 
         int i;
 
-        bool first = true;
-
         for (i = 0; i < CONFIG_CS104_MAX_CLIENT_CONNECTIONS; i++) {
 
             MasterConnection con = self->masterConnections[i];
 
             if (con && con->isUsed) {
 
-                if (con->isRunning) {
-
-                    if (first) {
-
-                        handleset = con->handleSet;
-                        Handleset_reset(handleset);
+                if (con->isRunning == false) {
 
-                        first = false;
+                    /* the kernel can use the input and output buffers until the operations are completed */
+                    if (con->ioRingRecvPending || con->ioRingSendPending) {
+                        SocketIoRing_cancel(self->ioRing, con);
+                        continue;
                     }
 
-                    Handleset_addSocket(handleset, con->socket);
-                }
-                else {
+                    /* a connection that is closed during the TLS handshake has never been opened */
+                    if (con->tlsHandshakeRunning == false) {
+                        if (self->connectionEventHandler) {
+                           self->connectionEventHandler(self->connectionEventHandlerParameter, &(con->cold->iMasterConnection), CS104_CON_EVENT_CONNECTION_CLOSED);
+                        }
 
-                    if (self->connectionEventHandler) {
-                       self->connectionEventHandler(self->connectionEventHandlerParameter, &(con->iMasterConnection), CS104_CON_EVENT_CONNECTION_CLOSED);
+                        closePluginConnections(self, con);
                     }
 
                     DEBUG_PRINT("CS104 SLAVE: Connection closed\n");
 
-                    self->masterConnections[i]->isUsed = false;
+                    MessageQueue_setWaitingForTransmissionWhenNotConfirmed(con->lowPrioQueue);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+                    Mutex_lock(self->openConnectionsLock);
+#endif
 
-                    MessageQueue_setWaitingForTransmissionWhenNotConfirmed(self->masterConnections[i]->lowPrioQueue);
+                    releaseConnection(self, con);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+                    Mutex_unlock(self->openConnectionsLock);
+#endif
 
-                    self->openConnections--;
+                    Handleset_removeSocket(self->handleSet, con->socket);
 
                     MasterConnection_deinit(con);
                 }
@@ -3056,19 +4485,42 @@ handleClientConnections(CS104_Slave self)
 
         }
 
-        /* handle incoming messages when available */
-        if (handleset != NULL) {
+        if (self->ioRing) {
+            receiveWithIoRing(self);
+
+            for (i = 0; i < CONFIG_CS104_MAX_CLIENT_CONNECTIONS; i++) {
+                MasterConnection con = self->masterConnections[i];
 
-            if (Handleset_waitReady(handleset, 1)) {
+                if (con != NULL && con->isUsed) {
+                    if (con->isRunning)
+                        startOutputCollection(con);
 
-                for (i = 0; i < CONFIG_CS104_MAX_CLIENT_CONNECTIONS; i++) {
-                    MasterConnection con = self->masterConnections[i];
+                    if (con->ioRingDataReceived) {
+                        con->ioRingDataReceived = false;
 
-                    if (con != NULL && con->isUsed)
-                        MasterConnection_handleTcpConnection(con);
+                        if (con->isRunning)
+                            MasterConnection_handleTcpConnection(con);
+                    }
                 }
+            }
+        }
+        /* handle incoming messages of the connections that are ready */
+        else if (Handleset_waitReady(self->handleSet, 1) > 0) {
+
+            for (i = 0; i < CONFIG_CS104_MAX_CLIENT_CONNECTIONS; i++) {
+                MasterConnection con = self->masterConnections[i];
 
+                if (con != NULL && con->isUsed && con->isRunning && (con->tlsHandshakeRunning == false)) {
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+                    /* TLS layer can have buffered data that is not visible on the socket */
+                    if (Handleset_isReady(self->handleSet, con->socket) || con->cold->tlsSocket)
+#else
+                    if (Handleset_isReady(self->handleSet, con->socket))
+#endif
+                        MasterConnection_handleTcpConnection(con);
+                }
             }
+
         }
 
         /* handle periodic tasks for running connections */
@@ -3076,28 +4528,22 @@ handleClientConnections(CS104_Slave self)
             MasterConnection con = self->masterConnections[i];
 
             if (con != NULL && con->isUsed) {
-                if (con->isRunning) {
-                    MasterConnection_executePeriodicTasks(con);
-
-                    /* call plugins */
-                    if (self->plugins) {
-
-                        LinkedList pluginElem = LinkedList_getNext(self->plugins);
-
-                        while (pluginElem) {
-
-                            CS101_SlavePlugin plugin = (CS101_SlavePlugin) LinkedList_getData(pluginElem);
-
-                            plugin->runTask(plugin->parameter, &(con->iMasterConnection));
-
-                            pluginElem = LinkedList_getNext(pluginElem);
-                        }
-                    }
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+                /* also called without received data to check the handshake timeout */
+                if (con->isRunning && con->tlsHandshakeRunning) {
+                    MasterConnection_continueTls(con);
 
+                    continue;
                 }
+#endif
+
+                if (con->isRunning)
+                    MasterConnection_executePeriodicTasks(con);
             }
         }
 
+        if (self->ioRing)
+            sendWithIoRing(self);
     }
 
 }
@@ -3190,6 +4636,9 @@ handleConnectionsThreadless(CS104_Slave self)
 
         if (newSocket != NULL) {
 
+            if (self->hasSocketOptions)
+                Socket_setOptions(newSocket, &(self->socketOptions));
+
             bool acceptConnection = true;
 
             if (acceptConnection)
@@ -3208,9 +4657,10 @@ handleConnectionsThreadless(CS104_Slave self)
 #endif
 
 #if (CONFIG_CS104_SUPPORT_SERVER_MODE_CONNECTION_IS_REDUNDANCY_GROUP == 1)
+                /* connection specific queues are pre-allocated by the connection pool */
                 if (self->serverMode == CS104_MODE_CONNECTION_IS_REDUNDANCY_GROUP) {
-                    lowPrioQueue = MessageQueue_create(self->maxLowPrioQueueSize);
-                    highPrioQueue = HighPriorityASDUQueue_create(self->maxHighPrioQueueSize);
+                    lowPrioQueue = NULL;
+                    highPrioQueue = NULL;
                 }
 #endif
                 MasterConnection connection = NULL;
@@ -3234,7 +4684,7 @@ handleConnectionsThreadless(CS104_Slave self)
                                 }
                             }
                             else {
-                                decreaseConnectionCounter(self);
+                                releaseFreeConnection(self, connection);
                                 connection = NULL;
                             }
                         }
@@ -3251,7 +4701,7 @@ handleConnectionsThreadless(CS104_Slave self)
 
                     if (connection) {
                         if (MasterConnection_init(connection, newSocket, lowPrioQueue, highPrioQueue) == false) {
-                            decreaseConnectionCounter(self);
+                            releaseFreeConnection(self, connection);
                             connection = NULL;
                         }
                     }
@@ -3262,7 +4712,17 @@ handleConnectionsThreadless(CS104_Slave self)
 
                 if (connection) {
                     if (MasterConnection_init(connection, newSocket, lowPrioQueue, highPrioQueue) == false) {
-                        decreaseConnectionCounter(self);
+                        releaseFreeConnection(self, connection);
+                        connection = NULL;
+                    }
+                }
+#endif
+
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+                /* the handshake is continued by handleClientConnections and doesn't block the main loop */
+                if (connection) {
+                    if (MasterConnection_startTlsNonBlocking(connection) == false) {
+                        releaseFreeConnection(self, connection);
                         connection = NULL;
                     }
                 }
@@ -3272,8 +4732,11 @@ handleConnectionsThreadless(CS104_Slave self)
 
                     connection->isRunning = true;
 
-                    if (self->connectionEventHandler) {
-                        self->connectionEventHandler(self->connectionEventHandlerParameter, &(connection->iMasterConnection), CS104_CON_EVENT_CONNECTION_OPENED);
+                    Handleset_addSocket(self->handleSet, newSocket);
+
+                    /* with TLS the connection is opened when the handshake is complete */
+                    if ((self->connectionEventHandler) && (connection->tlsHandshakeRunning == false)) {
+                        self->connectionEventHandler(self->connectionEventHandlerParameter, &(connection->cold->iMasterConnection), CS104_CON_EVENT_CONNECTION_OPENED);
                     }
                 }
                 else {
@@ -3305,19 +4768,28 @@ serverThread (void* parameter)
     if (self->serverSocket == NULL) {
         DEBUG_PRINT("CS104 SLAVE: Cannot create server socket\n");
         self->isStarting = false;
+        signalStateChange(self);
         goto exit_function;
     }
 
     ServerSocket_listen(self->serverSocket);
 
+    HandleSet handleSet = Handleset_new();
+
+    Handleset_addSocket(handleSet, (Socket) self->serverSocket);
+
     self->isRunning = true;
     self->isStarting = false;
+    signalStateChange(self);
 
     while (self->stopRunning == false) {
         Socket newSocket = ServerSocket_accept(self->serverSocket);
 
         if (newSocket != NULL) {
 
+            if (self->hasSocketOptions)
+                Socket_setOptions(newSocket, &(self->socketOptions));
+
             bool acceptConnection = true;
 
             /* check if maximum number of open connections is reached */
@@ -3369,7 +4841,7 @@ serverThread (void* parameter)
                                 }
                             }
                             else {
-                                decreaseConnectionCounter(self);
+                                releaseFreeConnection(self, connection);
                                 connection = NULL;
                             }
                         }
@@ -3386,7 +4858,7 @@ serverThread (void* parameter)
 
                     if (connection) {
                         if (MasterConnection_init(connection, newSocket, lowPrioQueue, highPrioQueue) == false) {
-                            decreaseConnectionCounter(self);
+                            releaseFreeConnection(self, connection);
                             connection = NULL;
                         }
                     }
@@ -3397,7 +4869,7 @@ serverThread (void* parameter)
 
                 if (connection) {
                     if (MasterConnection_init(connection, newSocket, lowPrioQueue, highPrioQueue) == false) {
-                        decreaseConnectionCounter(self);
+                        releaseFreeConnection(self, connection);
                         connection = NULL;
                     }
                 }
@@ -3419,22 +4891,33 @@ serverThread (void* parameter)
             }
         }
         else
-            Thread_sleep(10);
+            Handleset_waitReady(handleSet, 100); /* wait for the next connection request */
     }
 
+    Handleset_destroy(handleSet);
+
     if (self->serverSocket)
         Socket_destroy((Socket) self->serverSocket);
 
     self->isRunning = false;
     self->stopRunning = false;
+    signalStateChange(self);
 
 exit_function:
     return NULL;
 }
 
 void
-CS104_Slave_enqueueASDU(CS104_Slave self, CS101_ASDU asdu)
+CS104_Slave_setEventFilter(CS104_Slave self, CS101_EventFilter filter)
 {
+    self->eventFilter = filter;
+}
+
+static void
+enqueueASDU(void* parameter, CS101_ASDU asdu)
+{
+    CS104_Slave self = (CS104_Slave) parameter;
+
 #if (CONFIG_CS104_SUPPORT_SERVER_MODE_SINGLE_REDUNDANCY_GROUP == 1)
     if (self->serverMode == CS104_MODE_SINGLE_REDUNDANCY_GROUP)
         MessageQueue_enqueueASDU(self->asduQueue, asdu);
@@ -3466,7 +4949,7 @@ CS104_Slave_enqueueASDU(CS104_Slave self, CS101_ASDU asdu)
     if (self->serverMode == CS104_MODE_CONNECTION_IS_REDUNDANCY_GROUP) {
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-        Semaphore_wait(self->openConnectionsLock);
+        Mutex_lock(self->openConnectionsLock);
 #endif
 
         /************************************************
@@ -3485,12 +4968,21 @@ CS104_Slave_enqueueASDU(CS104_Slave self, CS101_ASDU asdu)
         }
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-        Semaphore_post(self->openConnectionsLock);
+        Mutex_unlock(self->openConnectionsLock);
 #endif
     }
 #endif /* (CONFIG_CS104_SUPPORT_SERVER_MODE_SINGLE_REDUNDANCY_GROUP == 1) */
 }
 
+void
+CS104_Slave_enqueueASDU(CS104_Slave self, CS101_ASDU asdu)
+{
+    if (self->eventFilter)
+        CS101_EventFilter_apply(self->eventFilter, asdu, enqueueASDU, self);
+    else
+        enqueueASDU(self, asdu);
+}
+
 void
 CS104_Slave_addRedundancyGroup(CS104_Slave self, CS104_RedundancyGroup redundancyGroup)
 {
@@ -3529,6 +5021,22 @@ initializeRedundancyGroups(CS104_Slave self, int lowPrioMaxQueueSize, int highPr
 }
 #endif /* (CONFIG_CS104_SUPPORT_SERVER_MODE_MULTIPLE_REDUNDANCY_GROUPS == 1) */
 
+void
+CS104_Slave_setServerThreadAttributes(CS104_Slave self, ThreadAttributes attributes)
+{
+#if (CONFIG_USE_THREADS == 1)
+    self->serverThreadAttributes = *attributes;
+#endif
+}
+
+void
+CS104_Slave_setConnectionThreadAttributes(CS104_Slave self, ThreadAttributes attributes)
+{
+#if (CONFIG_USE_THREADS == 1)
+    self->connectionThreadAttributes = *attributes;
+#endif
+}
+
 void
 CS104_Slave_start(CS104_Slave self)
 {
@@ -3548,17 +5056,20 @@ CS104_Slave_start(CS104_Slave self)
             initializeRedundancyGroups(self, self->maxLowPrioQueueSize, self->maxHighPrioQueueSize);
 #endif
 
-#if (CONFIG_CS104_SUPPORT_SERVER_MODE_CONNECTION_IS_REDUNDANCY_GROUP == 1)
-        if (self->serverMode == CS104_MODE_CONNECTION_IS_REDUNDANCY_GROUP)
-            initializeConnectionSpecificQueues(self);
-#endif
+        initializeConnectionPool(self);
 
         self->listeningThread = Thread_create(serverThread, (void*) self, false);
 
+        Thread_setAttributes(self->listeningThread, &(self->serverThreadAttributes));
+
         Thread_start(self->listeningThread);
 
+        Mutex_lock(self->openConnectionsLock);
+
         while (self->isStarting)
-            Thread_sleep(1);
+            Condition_wait(self->stateChanged, self->openConnectionsLock);
+
+        Mutex_unlock(self->openConnectionsLock);
     }
 #else
     DEBUG_PRINT("CS104 SLAVE: ERROR: CS104_Slave_start not supported when CONFIG_USE_TREADS = 0 or CONFIG_USE_SEMAPHORES = 0!\n");
@@ -3608,10 +5119,12 @@ CS104_Slave_startThreadless(CS104_Slave self)
             initializeRedundancyGroups(self, self->maxLowPrioQueueSize, self->maxHighPrioQueueSize);
 #endif
 
-#if (CONFIG_CS104_SUPPORT_SERVER_MODE_CONNECTION_IS_REDUNDANCY_GROUP == 1)
-        if (self->serverMode == CS104_MODE_CONNECTION_IS_REDUNDANCY_GROUP)
-            initializeConnectionSpecificQueues(self);
-#endif
+        initializeConnectionPool(self);
+
+        if (self->handleSet == NULL)
+            self->handleSet = Handleset_new();
+        else
+            Handleset_reset(self->handleSet);
 
         if (self->localAddress)
             self->serverSocket = TcpServerSocket_create(self->localAddress, self->tcpPort);
@@ -3626,6 +5139,22 @@ CS104_Slave_startThreadless(CS104_Slave self)
 
         ServerSocket_listen(self->serverSocket);
 
+#if (CONFIG_CS104_SLAVE_USE_IO_RING == 1)
+        /* TLS connections are read by the TLS layer and use the handle set */
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+        if (self->tlsConfig == NULL)
+#endif
+        {
+            /* a receive and a send operation for each connection */
+            self->ioRing = SocketIoRing_create(2 * CONFIG_CS104_MAX_CLIENT_CONNECTIONS);
+
+            /* the input and output buffers of all connections are part of the connection table */
+            if (self->ioRing)
+                SocketIoRing_registerBuffer(self->ioRing, (uint8_t*) self->connectionTableCold,
+                        CONFIG_CS104_MAX_CLIENT_CONNECTIONS * sizeof(struct sMasterConnectionCold));
+        }
+#endif
+
         self->isRunning = true;
     }
 
@@ -3643,6 +5172,24 @@ CS104_Slave_stopThreadless(CS104_Slave self)
         self->serverSocket = NULL;
     }
 
+    /* cancels the pending operations before the connections are released */
+    if (self->ioRing) {
+        int i;
+
+        SocketIoRing_destroy(self->ioRing);
+        self->ioRing = NULL;
+
+        for (i = 0; i < CONFIG_CS104_MAX_CLIENT_CONNECTIONS; i++) {
+            MasterConnection con = self->masterConnections[i];
+
+            if (con != NULL) {
+                con->cold->ioRing = NULL;
+                con->ioRingRecvPending = false;
+                con->ioRingSendPending = false;
+            }
+        }
+    }
+
     CS104_Slave_closeAllConnections(self);
 }
 
@@ -3672,8 +5219,17 @@ CS104_Slave_stop(CS104_Slave self)
         if (self->isRunning) {
             self->stopRunning = true;
 
+#if (CONFIG_USE_SEMAPHORES == 1)
+            Mutex_lock(self->openConnectionsLock);
+
+            while (self->isRunning)
+                Condition_wait(self->stateChanged, self->openConnectionsLock);
+
+            Mutex_unlock(self->openConnectionsLock);
+#else
             while (self->isRunning)
                 Thread_sleep(1);
+#endif
         }
 
         if (self->listeningThread) {
@@ -3705,7 +5261,7 @@ CS104_Slave_destroy(CS104_Slave self)
          * Stop all connections
          * */
 #if (CONFIG_USE_SEMAPHORES == 1)
-        Semaphore_wait(self->openConnectionsLock);
+        Mutex_lock(self->openConnectionsLock);
 #endif
 
         {
@@ -3718,19 +5274,41 @@ CS104_Slave_destroy(CS104_Slave self)
         }
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-        Semaphore_post(self->openConnectionsLock);
+        Mutex_unlock(self->openConnectionsLock);
 #endif
 
 #if (CONFIG_USE_THREADS == 1)
         if (self->isThreadlessMode == false) {
             /* Wait until all connections are closed */
+#if (CONFIG_USE_SEMAPHORES == 1)
+            Mutex_lock(self->openConnectionsLock);
+
+            while (self->openConnections > 0)
+                Condition_wait(self->stateChanged, self->openConnectionsLock);
+
+            Mutex_unlock(self->openConnectionsLock);
+#else
             while (CS104_Slave_getOpenConnections(self) > 0)
                 Thread_sleep(10);
+#endif
+        }
+#endif
+
+#if (CONFIG_USE_THREADS == 1) && (CONFIG_USE_SEMAPHORES == 1)
+        /* terminate the connection handling threads that are waiting for the next connection */
+        {
+            int i;
+
+            for (i = 0; i < CONFIG_CS104_MAX_CLIENT_CONNECTIONS; i++) {
+                if (self->masterConnections[i])
+                    MasterConnection_stopWorker(self->masterConnections[i]);
+            }
         }
 #endif
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-        Semaphore_destroy(self->openConnectionsLock);
+        Mutex_destroy(self->openConnectionsLock);
+        Condition_destroy(self->stateChanged);
 #endif
 
 #if (CONFIG_CS104_SUPPORT_SERVER_MODE_SINGLE_REDUNDANCY_GROUP == 1)
@@ -3756,12 +5334,21 @@ CS104_Slave_destroy(CS104_Slave self)
             for (i = 0; i < CONFIG_CS104_MAX_CLIENT_CONNECTIONS; i++) {
 
                 if (self->masterConnections[i]) {
-                    MasterConnection_destroy(self->masterConnections[i]);
+                    MasterConnection_finalize(self->masterConnections[i]);
                     self->masterConnections[i] = NULL;
                 }
             }
         }
 
+        if (self->handleSet)
+            Handleset_destroy(self->handleSet);
+
+        if (self->connectionTable)
+            GLOBAL_FREEMEM(self->connectionTable);
+
+        if (self->connectionTableCold)
+            GLOBAL_FREEMEM(self->connectionTableCold);
+
         if (self->plugins) {
             LinkedList_destroyStatic(self->plugins);
         }
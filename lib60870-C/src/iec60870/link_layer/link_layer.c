@@ -32,10 +32,12 @@
 #include "frame.h"
 #include "lib60870_internal.h"
 #include "hal_time.h"
-#include "linked_list.h"
+#include "hal_thread.h"
 
 typedef struct sLinkLayerSecondaryUnbalanced* LL_Sec_Unb; /* short cut definition */
 
+typedef struct sLLSecondaryStation* LLSecondaryStation;
+
 typedef struct sLinkLayerSecondaryBalanced* LinkLayerSecondaryBalanced;
 typedef struct sLinkLayerSecondaryBalanced* LL_Sec_Bal;  /* short cut definition */
 
@@ -62,7 +64,7 @@ LinkLayerPrimaryUnbalanced_handleMessage(LinkLayerPrimaryUnbalanced self, uint8_
         uint8_t* msg, int userDataStart, int userDataLength);
 
 static void
-llsu_setState(LL_Sec_Unb self, LinkLayerState newState);
+llsu_setState(LLSecondaryStation self, LinkLayerState newState);
 
 void
 LinkLayerPrimaryUnbalanced_runStateMachine(LinkLayerPrimaryUnbalanced self);
@@ -76,6 +78,11 @@ struct sLinkLayer {
 
     bool dir; /* DIR bit to be used when messages are sent in balanced mode */
 
+    /* derive timeouts of the primary link layer from the measured response times */
+    bool useAdaptiveTimeouts;
+    int minTimeoutForAck;
+    int maxTimeoutForAck;
+
     LinkLayerSecondaryUnbalanced llSecUnbalanced;
     LinkLayerSecondaryBalanced llSecBalanced;
 
@@ -84,7 +91,9 @@ struct sLinkLayer {
 
 };
 
-struct sLinkLayerSecondaryUnbalanced {
+/* a (logical) station that answers the requests for one link layer address */
+struct sLLSecondaryStation {
+    int address;
 
     /**
      * Initialized/timeout -> state = IDLE
@@ -94,17 +103,28 @@ struct sLinkLayerSecondaryUnbalanced {
     LinkLayerState state;
 
     bool expectedFcb; /* expected value of next frame count bit (FCB) */
-    LinkLayer linkLayer;
     ISecondaryApplicationLayer applicationLayer;
     void* appLayerParam;
+
+    IEC60870_LinkLayerStateChangedHandler stateChangedHandler;
+    void* stateChangedHandlerParameter;
+};
+
+struct sLinkLayerSecondaryUnbalanced {
+
+    struct sLLSecondaryStation station; /* station with the address of the link layer */
+
+    /* additional stations on the same line (sorted by address) */
+    struct sLLSecondaryStation* stations;
+    int numberOfStations;
+    int maxStations;
+
+    LinkLayer linkLayer;
     LinkLayerParameters linkLayerParameters;
 
     uint64_t lastReceivedMsg;
     int idleTimeout; /* connection timeout in ms */
 
-    IEC60870_LinkLayerStateChangedHandler stateChangedHandler;
-    void* stateChangedHandlerParameter;
-
     struct sLinkLayer _linkLayer;
 };
 
@@ -121,6 +141,10 @@ LinkLayer_init(LinkLayer self, int address, SerialTransceiverFT12 transceiver, L
 
         self->dir = false;
 
+        self->useAdaptiveTimeouts = false;
+        self->minTimeoutForAck = 0;
+        self->maxTimeoutForAck = 0;
+
         self->llSecUnbalanced = NULL;
         self->llSecBalanced = NULL;
         self->llPriBalanced = NULL;
@@ -142,6 +166,138 @@ LinkLayer_setAddress(LinkLayer self, int address)
     self->address = address;
 }
 
+static void
+LinkLayer_setAdaptiveTimeouts(LinkLayer self, bool enable, int minTimeoutForAck, int maxTimeoutForAck)
+{
+    if (maxTimeoutForAck < minTimeoutForAck)
+        maxTimeoutForAck = minTimeoutForAck;
+
+    self->useAdaptiveTimeouts = enable;
+    self->minTimeoutForAck = minTimeoutForAck;
+    self->maxTimeoutForAck = maxTimeoutForAck;
+}
+
+/* maximum number of timeout doublings after repeated transmissions */
+#define LL_RTT_MAX_BACKOFF 3
+
+/**
+ * Response time estimation of the other station (smoothed response time and mean deviation
+ * as used for the TCP retransmission timer).
+ */
+typedef struct sLinkLayerRtt* LinkLayerRtt;
+
+struct sLinkLayerRtt {
+    uint64_t sendTime; /* end of the first transmission of the current frame (0 = no valid sample) */
+    int srtt; /* smoothed response time in ms (scaled by 8) */
+    int rttvar; /* mean deviation of the response time in ms (scaled by 4) */
+    int backoff; /* timeout is doubled for each repeated transmission without valid sample */
+};
+
+static void
+LinkLayerRtt_init(LinkLayerRtt self)
+{
+    self->sendTime = 0;
+    self->srtt = 0;
+    self->rttvar = 0;
+    self->backoff = 0;
+}
+
+/* the response time is measured from the end of the transmission to exclude the transmission time of the frame */
+static void
+LinkLayerRtt_frameSent(LinkLayerRtt self, uint64_t transmissionEndTime)
+{
+    self->sendTime = transmissionEndTime;
+}
+
+static void
+LinkLayerRtt_frameRepeated(LinkLayerRtt self)
+{
+    /* the response cannot be associated with one of the transmissions -> no sample (Karn's algorithm) */
+    self->sendTime = 0;
+
+    if (self->backoff < LL_RTT_MAX_BACKOFF)
+        self->backoff++;
+}
+
+static void
+LinkLayerRtt_responseReceived(LinkLayerRtt self, uint64_t currentTime)
+{
+    if (self->sendTime != 0) {
+        int rtt = 1;
+
+        /* the calculated end of the transmission is rounded up -> a fast response can be received before */
+        if (currentTime > self->sendTime + 1)
+            rtt = (int) (currentTime - self->sendTime);
+
+        if (self->srtt == 0) {
+            self->srtt = rtt << 3;
+            self->rttvar = rtt << 1;
+        }
+        else {
+            int delta = rtt - (self->srtt >> 3);
+
+            self->srtt += delta;
+
+            if (self->srtt <= 0)
+                self->srtt = 1;
+
+            if (delta < 0)
+                delta = -delta;
+
+            self->rttvar += delta - (self->rttvar >> 2);
+        }
+
+        self->backoff = 0;
+    }
+
+    self->sendTime = 0;
+}
+
+/* smoothed response time + 4 * mean deviation (limited by the configured minimum and maximum) */
+static int
+LinkLayer_calculateTimeoutForAck(LinkLayer self, LinkLayerRtt rtt, int backoff)
+{
+    int timeout = ((rtt->srtt >> 3) + rtt->rttvar) << backoff;
+
+    if (timeout < self->minTimeoutForAck)
+        timeout = self->minTimeoutForAck;
+    else if (timeout > self->maxTimeoutForAck)
+        timeout = self->maxTimeoutForAck;
+
+    return timeout;
+}
+
+/* timeout for the response to a frame sent by the primary link layer */
+static int
+LinkLayer_getTimeoutForAck(LinkLayer self, LinkLayerRtt rtt)
+{
+    if ((self->useAdaptiveTimeouts == false) || (rtt->srtt == 0))
+        return self->linkLayerParameters->timeoutForAck;
+
+    return LinkLayer_calculateTimeoutForAck(self, rtt, rtt->backoff);
+}
+
+/* time after that repeated transmissions are given up - keeps the configured ratio to timeoutForAck */
+static int
+LinkLayer_getTimeoutRepeat(LinkLayer self, LinkLayerRtt rtt)
+{
+    LinkLayerParameters parameters = self->linkLayerParameters;
+
+    if ((self->useAdaptiveTimeouts == false) || (rtt->srtt == 0) || (parameters->timeoutForAck <= 0))
+        return parameters->timeoutRepeat;
+
+    int timeoutForAck = LinkLayer_calculateTimeoutForAck(self, rtt, 0);
+
+    return (int) (((int64_t) timeoutForAck * parameters->timeoutRepeat) / parameters->timeoutForAck);
+}
+
+/* the timeouts for the response start when the frame has been transmitted completely */
+static uint64_t
+LinkLayer_getTransmissionEndTime(LinkLayer self)
+{
+    return SerialTransceiverFT12_getTransmissionEndTime(self->transceiver);
+}
+
 static int
 LinkLayer_getBroadcastAddress(LinkLayer self)
 {
@@ -165,16 +321,21 @@ LinkLayerSecondaryUnbalanced_create(
     LL_Sec_Unb self = (LL_Sec_Unb) GLOBAL_MALLOC(sizeof(struct sLinkLayerSecondaryUnbalanced));
 
     if (self != NULL) {
-        self->expectedFcb = true;
-        self->applicationLayer = applicationLayer;
-        self->appLayerParam = applicationLayerParameter;
+        self->station.address = linkLayerAddress;
+        self->station.state = LL_STATE_IDLE;
+        self->station.expectedFcb = true;
+        self->station.applicationLayer = applicationLayer;
+        self->station.appLayerParam = applicationLayerParameter;
+        self->station.stateChangedHandler = NULL;
+
+        self->stations = NULL;
+        self->numberOfStations = 0;
+        self->maxStations = 0;
+
         self->linkLayerParameters = linkLayerParameters;
         self->linkLayer = &(self->_linkLayer);
 
-        self->state = LL_STATE_IDLE;
-
         self->idleTimeout = 500;
-        self->stateChangedHandler = NULL;
 
         self->lastReceivedMsg = 0;
 
@@ -189,16 +350,115 @@ LinkLayerSecondaryUnbalanced_create(
 void
 LinkLayerSecondaryUnbalanced_destroy(LL_Sec_Unb self)
 {
-    if (self != NULL)
+    if (self != NULL) {
+        if (self->stations)
+            GLOBAL_FREEMEM(self->stations);
+
         GLOBAL_FREEMEM(self);
+    }
 }
 
 void
 LinkLayerSecondaryUnbalanced_setStateChangeHandler(LinkLayerSecondaryUnbalanced self,
         IEC60870_LinkLayerStateChangedHandler handler, void* parameter)
 {
-    self->stateChangedHandler = handler;
-    self->stateChangedHandlerParameter = parameter;
+    self->station.stateChangedHandler = handler;
+    self->station.stateChangedHandlerParameter = parameter;
+}
+
+/* binary search in the sorted station table - returns the index where a station with this address is (or has to be inserted) */
+static int
+LinkLayerSecondaryUnbalanced_findStationIndex(LL_Sec_Unb self, int address)
+{
+    int low = 0;
+    int high = self->numberOfStations;
+
+    while (low < high) {
+        int mid = (low + high) / 2;
+
+        if (self->stations[mid].address < address)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+static LLSecondaryStation
+LinkLayerSecondaryUnbalanced_getStation(LL_Sec_Unb self, int address)
+{
+    if (address == self->station.address)
+        return &(self->station);
+
+    int index = LinkLayerSecondaryUnbalanced_findStationIndex(self, address);
+
+    if ((index < self->numberOfStations) && (self->stations[index].address == address))
+        return &(self->stations[index]);
+
+    return NULL;
+}
+
+bool
+LinkLayerSecondaryUnbalanced_addStation(LinkLayerSecondaryUnbalanced self, int address,
+        ISecondaryApplicationLayer applicationLayer, void* applicationLayerParameter)
+{
+    if (LinkLayerSecondaryUnbalanced_getStation(self, address))
+        return false;
+
+    if (self->numberOfStations == self->maxStations) {
+        int newMaxStations = (self->maxStations == 0) ? 8 : (self->maxStations * 2);
+
+        struct sLLSecondaryStation* newStations = (struct sLLSecondaryStation*)
+                GLOBAL_REALLOC(self->stations, newMaxStations * sizeof(struct sLLSecondaryStation));
+
+        if (newStations == NULL)
+            return false;
+
+        self->stations = newStations;
+        self->maxStations = newMaxStations;
+    }
+
+    int index = LinkLayerSecondaryUnbalanced_findStationIndex(self, address);
+
+    memmove(self->stations + index + 1, self->stations + index, (self->numberOfStations - index) * sizeof(struct sLLSecondaryStation));
+
+    LLSecondaryStation station = &(self->stations[index]);
+
+    station->address = address;
+    station->state = LL_STATE_IDLE;
+    station->expectedFcb = true;
+    station->applicationLayer = applicationLayer;
+    station->appLayerParam = applicationLayerParameter;
+    station->stateChangedHandler = NULL;
+
+    self->numberOfStations++;
+
+    return true;
+}
+
+void
+LinkLayerSecondaryUnbalanced_removeStation(LinkLayerSecondaryUnbalanced self, int address)
+{
+    int index = LinkLayerSecondaryUnbalanced_findStationIndex(self, address);
+
+    if ((index < self->numberOfStations) && (self->stations[index].address == address)) {
+        memmove(self->stations + index, self->stations + index + 1, (self->numberOfStations - index - 1) * sizeof(struct sLLSecondaryStation));
+
+        self->numberOfStations--;
+    }
+}
+
+void
+LinkLayerSecondaryUnbalanced_setStationStateChangeHandler(LinkLayerSecondaryUnbalanced self, int address,
+        IEC60870_LinkLayerStateChangedHandler handler, void* parameter)
+{
+    LLSecondaryStation station = LinkLayerSecondaryUnbalanced_getStation(self, address);
+
+    if (station) {
+        station->stateChangedHandler = handler;
+        station->stateChangedHandlerParameter = parameter;
+    }
 }
 
 
@@ -316,7 +576,7 @@ SendVariableLengthFrame(LinkLayer self, uint8_t fc, int address, bool prm, bool
 
 
 static bool
-checkFCB(LL_Sec_Unb self, bool fcb)
+checkFCB(LLSecondaryStation self, bool fcb)
 {
     if (fcb != self->expectedFcb)
         return false;
@@ -328,6 +588,7 @@ checkFCB(LL_Sec_Unb self, bool fcb)
 
 static void
 LinkLayerSecondaryUnbalanced_handleMessage(LL_Sec_Unb self,
+        LLSecondaryStation station,
         uint8_t fc,
         bool isBroadcast,
         bool fcb,
@@ -335,51 +596,51 @@ LinkLayerSecondaryUnbalanced_handleMessage(LL_Sec_Unb self,
         uint8_t* msg, int userDataStart, int userDataLength)
 {
     if (fcv) {
-        if (checkFCB(self, fcb) == false) {
+        if (checkFCB(station, fcb) == false) {
             DEBUG_PRINT("SLL - FCB check failed\n");
-            llsu_setState(self, LL_STATE_ERROR);
+            llsu_setState(station, LL_STATE_ERROR);
             return;
         }
     }
 
-    llsu_setState(self, LL_STATE_AVAILABLE);
+    llsu_setState(station, LL_STATE_AVAILABLE);
 
     switch (fc) {
 
     case LL_FC_09_REQUEST_LINK_STATUS:
         DEBUG_PRINT("SLL - REQUEST LINK STATUS\n");
         {
-            bool accessDemand = self->applicationLayer->IsClass1DataAvailable(self->appLayerParam);
+            bool accessDemand = station->applicationLayer->IsClass1DataAvailable(station->appLayerParam);
 
-            SendFixedFrame(self->linkLayer, LL_FC_11_STATUS_OF_LINK_OR_ACCESS_DEMAND, self->linkLayer->address, false, false, accessDemand, false);
+            SendFixedFrame(self->linkLayer, LL_FC_11_STATUS_OF_LINK_OR_ACCESS_DEMAND, station->address, false, false, accessDemand, false);
         }
         break;
 
     case LL_FC_00_RESET_REMOTE_LINK:
         DEBUG_PRINT("SLL - RESET REMOTE LINK\n");
         {
-            self->expectedFcb = true;
+            station->expectedFcb = true;
 
             if (self->linkLayerParameters->useSingleCharACK)
                 SendSingleCharCharacter(self->linkLayer);
             else
-                SendFixedFrame(self->linkLayer, LL_FC_00_ACK, self->linkLayer->address, false, false, false, false);
+                SendFixedFrame(self->linkLayer, LL_FC_00_ACK, station->address, false, false, false, false);
 
-            self->applicationLayer->ResetCUReceived(self->appLayerParam, false);
+            station->applicationLayer->ResetCUReceived(station->appLayerParam, false);
         }
         break;
 
     case LL_FC_07_RESET_FCB:
         DEBUG_PRINT("SLL - RESET FCB\n");
         {
-            self->expectedFcb = true;
+            station->expectedFcb = true;
 
             if (self->linkLayerParameters->useSingleCharACK)
                 SendSingleCharCharacter(self->linkLayer);
             else
-                SendFixedFrame(self->linkLayer, LL_FC_00_ACK, self->linkLayer->address, false, false, false, false);
+                SendFixedFrame(self->linkLayer, LL_FC_00_ACK, station->address, false, false, false, false);
 
-            self->applicationLayer->ResetCUReceived(self->appLayerParam, true);
+            station->applicationLayer->ResetCUReceived(station->appLayerParam, true);
         }
         break;
 
@@ -390,12 +651,12 @@ LinkLayerSecondaryUnbalanced_handleMessage(LL_Sec_Unb self,
             struct sBufferFrame _bufferFrame;
             Frame bufferFrame = BufferFrame_initialize(&_bufferFrame, self->_linkLayer.userDataBuffer, 0);
 
-            Frame asdu = self->applicationLayer->GetClass2Data(self->appLayerParam, bufferFrame);
+            Frame asdu = station->applicationLayer->GetClass2Data(station->appLayerParam, bufferFrame);
 
-            bool accessDemand = self->applicationLayer->IsClass1DataAvailable(self->appLayerParam);
+            bool accessDemand = station->applicationLayer->IsClass1DataAvailable(station->appLayerParam);
 
             if (asdu != NULL) {
-                SendVariableLengthFrame(self->linkLayer, LL_FC_08_RESP_USER_DATA, self->linkLayer->address, false, false, accessDemand, false, asdu);
+                SendVariableLengthFrame(self->linkLayer, LL_FC_08_RESP_USER_DATA, station->address, false, false, accessDemand, false, asdu);
 
                 /* release frame buffer if required */
                 if (asdu != bufferFrame)
@@ -406,7 +667,7 @@ LinkLayerSecondaryUnbalanced_handleMessage(LL_Sec_Unb self,
                 if (self->linkLayerParameters->useSingleCharACK && !accessDemand)
                     SendSingleCharCharacter(self->linkLayer);
                 else
-                    SendFixedFrame(self->linkLayer, LL_FC_09_RESP_NACK_NO_DATA, self->linkLayer->address, false, false, accessDemand, false);
+                    SendFixedFrame(self->linkLayer, LL_FC_09_RESP_NACK_NO_DATA, station->address, false, false, accessDemand, false);
             }
         }
         break;
@@ -418,12 +679,12 @@ LinkLayerSecondaryUnbalanced_handleMessage(LL_Sec_Unb self,
             struct sBufferFrame _bufferFrame;
             Frame bufferFrame = BufferFrame_initialize(&_bufferFrame, self->_linkLayer.userDataBuffer, 0);
 
-            Frame asdu = self->applicationLayer->GetClass1Data(self->appLayerParam, bufferFrame);
+            Frame asdu = station->applicationLayer->GetClass1Data(station->appLayerParam, bufferFrame);
 
-            bool accessDemand = self->applicationLayer->IsClass1DataAvailable(self->appLayerParam);
+            bool accessDemand = station->applicationLayer->IsClass1DataAvailable(station->appLayerParam);
 
             if (asdu != NULL) {
-                SendVariableLengthFrame(self->linkLayer, LL_FC_08_RESP_USER_DATA, self->linkLayer->address, false, false, accessDemand, false, asdu);
+                SendVariableLengthFrame(self->linkLayer, LL_FC_08_RESP_USER_DATA, station->address, false, false, accessDemand, false, asdu);
 
                 /* release frame buffer if required */
                 if (asdu != bufferFrame)
@@ -433,7 +694,7 @@ LinkLayerSecondaryUnbalanced_handleMessage(LL_Sec_Unb self,
                 if (self->linkLayerParameters->useSingleCharACK && !accessDemand)
                     SendSingleCharCharacter(self->linkLayer);
                 else
-                    SendFixedFrame(self->linkLayer, LL_FC_09_RESP_NACK_NO_DATA, self->linkLayer->address, false, false, accessDemand, false);
+                    SendFixedFrame(self->linkLayer, LL_FC_09_RESP_NACK_NO_DATA, station->address, false, false, accessDemand, false);
             }
         }
         break;
@@ -441,13 +702,13 @@ LinkLayerSecondaryUnbalanced_handleMessage(LL_Sec_Unb self,
     case LL_FC_03_USER_DATA_CONFIRMED:
         DEBUG_PRINT ("SLL - USER DATA CONFIRMED\n");
         if (userDataLength > 0) {
-            if (self->applicationLayer->HandleReceivedData(self->appLayerParam, msg, isBroadcast, userDataStart, userDataLength)) {
-                bool accessDemand = self->applicationLayer->IsClass1DataAvailable(self->appLayerParam);
+            if (station->applicationLayer->HandleReceivedData(station->appLayerParam, msg, isBroadcast, userDataStart, userDataLength)) {
+                bool accessDemand = station->applicationLayer->IsClass1DataAvailable(station->appLayerParam);
 
                 if (self->linkLayerParameters->useSingleCharACK && !accessDemand)
                     SendSingleCharCharacter(self->linkLayer);
                 else
-                    SendFixedFrame(self->linkLayer, LL_FC_00_ACK, self->linkLayer->address, false, false, accessDemand, false);
+                    SendFixedFrame(self->linkLayer, LL_FC_00_ACK, station->address, false, false, accessDemand, false);
             }
         }
         break;
@@ -455,21 +716,21 @@ LinkLayerSecondaryUnbalanced_handleMessage(LL_Sec_Unb self,
     case LL_FC_04_USER_DATA_NO_REPLY:
         DEBUG_PRINT ("SLL - USER DATA NO REPLY\n");
         if (userDataLength > 0) {
-            self->applicationLayer->HandleReceivedData(self->appLayerParam, msg, isBroadcast, userDataStart, userDataLength);
+            station->applicationLayer->HandleReceivedData(station->appLayerParam, msg, isBroadcast, userDataStart, userDataLength);
         }
         break;
 
     default:
         DEBUG_PRINT ("SLL - UNEXPECTED LINK LAYER MESSAGE\n");
 
-        SendFixedFrame(self->linkLayer, LL_FC_15_SERVICE_NOT_IMPLEMENTED, self->linkLayer->address, false, false, false, false);
+        SendFixedFrame(self->linkLayer, LL_FC_15_SERVICE_NOT_IMPLEMENTED, station->address, false, false, false, false);
 
         break;
     }
 }
 
 static void
-llsu_setState(LL_Sec_Unb self, LinkLayerState newState)
+llsu_setState(LLSecondaryStation self, LinkLayerState newState)
 {
     if (self->state != newState) {
 
@@ -500,7 +761,7 @@ ParserHeaderSecondaryUnbalanced(void* parameter, uint8_t* msg, int msgSize)
 
         if (msg [1] != msg [2]) {
             DEBUG_PRINT("ERROR: L fields differ!\n");
-            llsu_setState(self, LL_STATE_ERROR);
+            llsu_setState(&(self->station), LL_STATE_ERROR);
             return;
         }
 
@@ -513,7 +774,7 @@ ParserHeaderSecondaryUnbalanced(void* parameter, uint8_t* msg, int msgSize)
         /* check if message size is reasonable */
         if (msgSize != (userDataStart + userDataLength + 2 /* CS + END */)) {
             DEBUG_PRINT("ERROR: Invalid message length\n");
-            llsu_setState(self, LL_STATE_ERROR);
+            llsu_setState(&(self->station), LL_STATE_ERROR);
             return;
         }
 
@@ -525,7 +786,7 @@ ParserHeaderSecondaryUnbalanced(void* parameter, uint8_t* msg, int msgSize)
 
     } else {
         DEBUG_PRINT("ERROR: Received unexpected message type in unbalanced slave mode!\n");
-        llsu_setState(self, LL_STATE_ERROR);
+        llsu_setState(&(self->station), LL_STATE_ERROR);
         return;
     }
 
@@ -550,15 +811,20 @@ ParserHeaderSecondaryUnbalanced(void* parameter, uint8_t* msg, int msgSize)
     int fc = c & 0x0f;
 
 
+    /* station that is addressed by the message (the own station for broadcast messages) */
+    LLSecondaryStation station = &(self->station);
+
     if (isBroadcast) {
         if (fc != LL_FC_04_USER_DATA_NO_REPLY) {
             DEBUG_PRINT("ERROR: Invalid function code for broadcast message!\n");
-            llsu_setState(self, LL_STATE_ERROR);
+            llsu_setState(station, LL_STATE_ERROR);
             return;
         }
 
     } else {
-        if (address != self->linkLayer->address) {
+        station = LinkLayerSecondaryUnbalanced_getStation(self, address);
+
+        if (station == NULL) {
             DEBUG_PRINT ("INFO: unknown link layer address -> ignore message\n");
             return;
         }
@@ -574,7 +840,7 @@ ParserHeaderSecondaryUnbalanced(void* parameter, uint8_t* msg, int msgSize)
 
     if (checksum != msg [csIndex]) {
         DEBUG_PRINT("ERROR: checksum invalid!\n");
-        llsu_setState(self, LL_STATE_ERROR);
+        llsu_setState(station, LL_STATE_ERROR);
         return;
     }
 
@@ -584,14 +850,23 @@ ParserHeaderSecondaryUnbalanced(void* parameter, uint8_t* msg, int msgSize)
 
     if (prm == false) {
         DEBUG_PRINT("ERROR: Received secondary message in unbalanced slave mode!\n");
-        llsu_setState(self, LL_STATE_ERROR);
+        llsu_setState(station, LL_STATE_ERROR);
         return;
     }
 
     bool fcb = ((c & 0x20) == 0x20);
     bool fcv = ((c & 0x10) == 0x10);
 
-    LinkLayerSecondaryUnbalanced_handleMessage(self, fc, isBroadcast, fcb, fcv, msg, userDataStart, userDataLength);
+    if (isBroadcast) {
+        /* broadcast messages are handled by all stations */
+        LinkLayerSecondaryUnbalanced_handleMessage(self, &(self->station), fc, isBroadcast, fcb, fcv, msg, userDataStart, userDataLength);
+
+        for (i = 0; i < self->numberOfStations; i++)
+            LinkLayerSecondaryUnbalanced_handleMessage(self, &(self->stations[i]), fc, isBroadcast, fcb, fcv, msg, userDataStart, userDataLength);
+    }
+    else {
+        LinkLayerSecondaryUnbalanced_handleMessage(self, station, fc, isBroadcast, fcb, fcv, msg, userDataStart, userDataLength);
+    }
 }
 
 
@@ -736,6 +1011,7 @@ void
 LinkLayerSecondaryUnbalanced_setAddress(LinkLayerSecondaryUnbalanced self, int address)
 {
     self->_linkLayer.address = address;
+    self->station.address = address;
 }
 
 void
@@ -745,9 +1021,15 @@ LinkLayerSecondaryUnbalanced_run(LinkLayerSecondaryUnbalanced self)
 
     SerialTransceiverFT12_readNextMessage(ll->transceiver, ll->buffer, ParserHeaderSecondaryUnbalanced, self);
 
-    if (self->state != LL_STATE_IDLE) {
-        if ((Hal_getTimeInMs() - self->lastReceivedMsg) > (unsigned int) self->idleTimeout)
-            llsu_setState(self, LL_STATE_IDLE);
+    /* the stations become idle when no message is received on the line */
+    if ((Hal_getTimeInMs() - self->lastReceivedMsg) > (unsigned int) self->idleTimeout) {
+
+        llsu_setState(&(self->station), LL_STATE_IDLE);
+
+        int i;
+
+        for (i = 0; i < self->numberOfStations; i++)
+            llsu_setState(&(self->stations[i]), LL_STATE_IDLE);
     }
 }
 
@@ -895,6 +1177,8 @@ struct sLinkLayerPrimaryBalanced {
     bool sendLinkLayerTestFunction;
     bool nextFcb;
 
+    struct sLinkLayerRtt rtt;
+
     int otherStationAddress;
 
     struct sBufferFrame lastSendAsdu;
@@ -921,6 +1205,8 @@ LinkLayerPrimaryBalanced_init(LinkLayerPrimaryBalanced self, LinkLayer linkLayer
     self->sendLinkLayerTestFunction = false;
     self->nextFcb = true;
 
+    LinkLayerRtt_init(&(self->rtt));
+
     self->linkLayer = linkLayer;
 
     self->applicationLayer = applicationLayer;
@@ -967,6 +1253,8 @@ LinkLayerPrimaryBalanced_handleMessage(LinkLayerPrimaryBalanced self, uint8_t fc
 
     self->lastReceivedMsg = Hal_getTimeInMs();
 
+    LinkLayerRtt_responseReceived(&(self->rtt), self->lastReceivedMsg);
+
     if (dfc) {
 
         switch (self->primaryState) {
@@ -1049,8 +1337,9 @@ LinkLayerPrimaryBalanced_handleMessage(LinkLayerPrimaryBalanced self, uint8_t fc
 
             SendFixedFrame(self->linkLayer, LL_FC_00_RESET_REMOTE_LINK, self->otherStationAddress, true, self->linkLayer->dir, false, false);
 
-            self->lastSendTime = Hal_getTimeInMs();
+            self->lastSendTime = LinkLayer_getTransmissionEndTime(self->linkLayer);
             self->waitingForResponse = true;
+            LinkLayerRtt_frameSent(&(self->rtt), self->lastSendTime);
             newState = PLL_EXECUTE_RESET_REMOTE_LINK;
             llpb_setNewState(self, LL_STATE_BUSY);
         }
@@ -1092,6 +1381,10 @@ LinkLayerPrimaryBalanced_handleMessage(LinkLayerPrimaryBalanced self, uint8_t fc
 void
 LinkLayerPrimaryBalanced_runStateMachine(LinkLayerPrimaryBalanced self)
 {
+    /* previous frame is still transmitted or the line idle time is not elapsed -> continue in the next call */
+    if (SerialTransceiverFT12_isReadyToSend(self->linkLayer->transceiver) == false)
+        return;
+
     uint64_t currentTime = Hal_getTimeInMs();
 
     PrimaryLinkLayerState primaryState = self->primaryState;
@@ -1113,16 +1406,17 @@ LinkLayerPrimaryBalanced_runStateMachine(LinkLayerPrimaryBalanced self)
 
         if (self->waitingForResponse) {
 
-            if (self->lastSendTime > currentTime) {
+            if (self->lastSendTime > LinkLayer_getTransmissionEndTime(self->linkLayer)) {
                 /* last sent time not plausible! */
                 self->lastSendTime = currentTime;
             }
 
-            if (currentTime > (self->lastSendTime + self->linkLayer->linkLayerParameters->timeoutForAck)) {
+            if (currentTime > (self->lastSendTime + LinkLayer_getTimeoutForAck(self->linkLayer, &(self->rtt)))) {
 
                 SendFixedFrame(self->linkLayer, LL_FC_09_REQUEST_LINK_STATUS, self->otherStationAddress, true, self->linkLayer->dir, false, false);
 
-                self->lastSendTime = currentTime;
+                self->lastSendTime = LinkLayer_getTransmissionEndTime(self->linkLayer);
+                LinkLayerRtt_frameRepeated(&(self->rtt));
             }
 
         }
@@ -1131,8 +1425,9 @@ LinkLayerPrimaryBalanced_runStateMachine(LinkLayerPrimaryBalanced self)
 
             SendFixedFrame(self->linkLayer, LL_FC_00_RESET_REMOTE_LINK, self->otherStationAddress, true, self->linkLayer->dir, false, false);
 
-            self->lastSendTime = currentTime;
+            self->lastSendTime = LinkLayer_getTransmissionEndTime(self->linkLayer);
             self->waitingForResponse = true;
+            LinkLayerRtt_frameSent(&(self->rtt), self->lastSendTime);
             newState = PLL_EXECUTE_RESET_REMOTE_LINK;
         }
 
@@ -1141,7 +1436,7 @@ LinkLayerPrimaryBalanced_runStateMachine(LinkLayerPrimaryBalanced self)
     case PLL_EXECUTE_RESET_REMOTE_LINK:
 
         if (self->waitingForResponse) {
-            if (currentTime > (self->lastSendTime + self->linkLayer->linkLayerParameters->timeoutForAck)) {
+            if (currentTime > (self->lastSendTime + LinkLayer_getTimeoutForAck(self->linkLayer, &(self->rtt)))) {
                 self->waitingForResponse = false;
                 newState = PLL_IDLE;
                 llpb_setNewState(self, LL_STATE_ERROR);
@@ -1172,8 +1467,9 @@ LinkLayerPrimaryBalanced_runStateMachine(LinkLayerPrimaryBalanced self)
             SendFixedFrame(self->linkLayer, LL_FC_02_TEST_FUNCTION_FOR_LINK, self->otherStationAddress, true, self->linkLayer->dir, self->nextFcb, true);
 
             self->nextFcb = !(self->nextFcb);
-            self->lastSendTime = currentTime;
+            self->lastSendTime = LinkLayer_getTransmissionEndTime(self->linkLayer);
             self->originalSendTime = self->lastSendTime;
+            LinkLayerRtt_frameSent(&(self->rtt), self->lastSendTime);
             newState = PLL_EXECUTE_SERVICE_SEND_CONFIRM;
         }
         else {
@@ -1190,9 +1486,10 @@ LinkLayerPrimaryBalanced_runStateMachine(LinkLayerPrimaryBalanced self)
                 SendVariableLengthFrame(self->linkLayer, LL_FC_03_USER_DATA_CONFIRMED, self->otherStationAddress, true, self->linkLayer->dir, self->nextFcb, true, asdu);
 
                 self->nextFcb = !(self->nextFcb);
-                self->lastSendTime = currentTime;
+                self->lastSendTime = LinkLayer_getTransmissionEndTime(self->linkLayer);
                 self->originalSendTime = self->lastSendTime;
                 self->waitingForResponse = true;
+                LinkLayerRtt_frameSent(&(self->rtt), self->lastSendTime);
 
                 newState = PLL_EXECUTE_SERVICE_SEND_CONFIRM;
             }
@@ -1203,9 +1500,9 @@ LinkLayerPrimaryBalanced_runStateMachine(LinkLayerPrimaryBalanced self)
 
     case PLL_EXECUTE_SERVICE_SEND_CONFIRM:
 
-        if (currentTime > (self->lastSendTime + self->linkLayer->linkLayerParameters->timeoutForAck)) {
+        if (currentTime > (self->lastSendTime + LinkLayer_getTimeoutForAck(self->linkLayer, &(self->rtt)))) {
 
-            if (currentTime > (self->originalSendTime + self->linkLayer->linkLayerParameters->timeoutRepeat)) {
+            if (currentTime > (self->originalSendTime + LinkLayer_getTimeoutRepeat(self->linkLayer, &(self->rtt)))) {
                 DEBUG_PRINT ("TIMEOUT: ASDU not confirmed after repeated transmission\n");
 
                 newState = PLL_IDLE;
@@ -1225,7 +1522,8 @@ LinkLayerPrimaryBalanced_runStateMachine(LinkLayerPrimaryBalanced self)
                     SendVariableLengthFrame(self->linkLayer, LL_FC_03_USER_DATA_CONFIRMED, self->otherStationAddress, true, self->linkLayer->dir, !(self->nextFcb), true, (Frame) &(self->lastSendAsdu));
                 }
 
-                self->lastSendTime = currentTime;
+                self->lastSendTime = LinkLayer_getTransmissionEndTime(self->linkLayer);
+                LinkLayerRtt_frameRepeated(&(self->rtt));
             }
 
         }
@@ -1311,6 +1609,12 @@ LinkLayerBalanced_setIdleTimeout(LinkLayerBalanced self, int timeoutInMs)
     self->primaryLinkLayer.idleTimeout = timeoutInMs;
 }
 
+void
+LinkLayerBalanced_setAdaptiveTimeouts(LinkLayerBalanced self, bool enable, int minTimeoutForAck, int maxTimeoutForAck)
+{
+    LinkLayer_setAdaptiveTimeouts(self->linkLayer, enable, minTimeoutForAck, maxTimeoutForAck);
+}
+
 
 void
 LinkLayerBalanced_setDIR(LinkLayerBalanced self, bool dir)
@@ -1361,11 +1665,29 @@ LinkLayerBalanced_run(LinkLayerBalanced self)
 
 typedef struct sLinkLayerSlaveConnection* LinkLayerSlaveConnection;
 
+/* default time in ms a slave is not polled after it stopped responding (doubled with each failed retry) */
+#define LL_DEFAULT_MIN_RETRY_DELAY 1000
+
+/* default maximum time in ms between two attempts to reach a slave that doesn't respond */
+#define LL_DEFAULT_MAX_RETRY_DELAY 60000
+
+/* maximum number of class 1 requests sent to a slave with ACD set before other slaves are served */
+#define LL_MAX_CONSECUTIVE_ACD_POLLS 8
+
+#ifdef CONFIG_CS101_MASTER_SLAVE_QUEUE_SIZE
+#define LL_SLAVE_QUEUE_SIZE CONFIG_CS101_MASTER_SLAVE_QUEUE_SIZE
+#else
+#define LL_SLAVE_QUEUE_SIZE 8
+#endif
+
 struct sLinkLayerPrimaryUnbalanced {
 
     LinkLayerSlaveConnection currentSlave;
     int currentSlaveIndex;
 
+    /* number of successive requests to the current slave caused by ACD */
+    int consecutiveAcdPolls;
+
     bool hasNextBroadcastToSend;
     struct sBufferFrame nextBroadcastMessage;
     uint8_t buffer[256];
@@ -1378,7 +1700,19 @@ struct sLinkLayerPrimaryUnbalanced {
 
     struct sLinkLayerParameters linkLayerParameters;
 
-    LinkedList slaveConnections;
+    /* slave table sorted by link layer address */
+    LinkLayerSlaveConnection* slaves;
+    int numberOfSlaves;
+    int maxSlaves;
+
+    int minRetryDelay;
+    int maxRetryDelay;
+
+    int queueSize; /* number of ASDUs that can be queued for each slave */
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex queueLock;
+#endif
 
     IEC60870_LinkLayerStateChangedHandler stateChangedHandler;
     void* stateChangedHandlerParameter;
@@ -1396,6 +1730,7 @@ LinkLayerPrimaryUnbalanced_create(SerialTransceiverFT12 transceiver, LinkLayerPa
 
         self->currentSlave = NULL;
         self->currentSlaveIndex = 0;
+        self->consecutiveAcdPolls = 0;
 
         self->hasNextBroadcastToSend = false;
 
@@ -1411,7 +1746,18 @@ LinkLayerPrimaryUnbalanced_create(SerialTransceiverFT12 transceiver, LinkLayerPa
 
         BufferFrame_initialize(&(self->nextBroadcastMessage), self->buffer, 0);
 
-        self->slaveConnections = LinkedList_create();
+        self->slaves = NULL;
+        self->numberOfSlaves = 0;
+        self->maxSlaves = 0;
+
+        self->minRetryDelay = LL_DEFAULT_MIN_RETRY_DELAY;
+        self->maxRetryDelay = LL_DEFAULT_MAX_RETRY_DELAY;
+
+        self->queueSize = LL_SLAVE_QUEUE_SIZE;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        self->queueLock = Mutex_create();
+#endif
 
         self->stateChangedHandler = NULL;
     }
@@ -1427,17 +1773,36 @@ LinkLayerPrimaryUnbalanced_setStateChangeHandler(LinkLayerPrimaryUnbalanced self
     self->stateChangedHandlerParameter = parameter;
 }
 
+static void
+LinkLayerSlaveConnection_destroy(LinkLayerSlaveConnection self);
+
 void
 LinkLayerPrimaryUnbalanced_destroy(LinkLayerPrimaryUnbalanced self)
 {
     if (self) {
-        if (self->slaveConnections)
-            LinkedList_destroy(self->slaveConnections);
+        int i;
+
+        for (i = 0; i < self->numberOfSlaves; i++)
+            LinkLayerSlaveConnection_destroy(self->slaves[i]);
+
+        GLOBAL_FREEMEM(self->slaves);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Mutex_destroy(self->queueLock);
+#endif
 
         GLOBAL_FREEMEM(self);
     }
 }
 
+/* ASDU in the transmit queue of a slave connection */
+struct sLLQueuedMessage {
+    bool isUsed;
+    bool highPriority;
+    int msgSize;
+    uint8_t buffer[256];
+};
+
 struct sLinkLayerSlaveConnection {
 
     LinkLayerPrimaryUnbalanced primaryLink;
@@ -1451,6 +1816,11 @@ struct sLinkLayerSlaveConnection {
     struct sBufferFrame nextMessage;
     uint8_t buffer[256];
 
+    /* messages waiting for transmission after nextMessage */
+    struct sLLQueuedMessage* queue;
+    int* queueOrder; /* indices of the used queue elements in transmission order */
+    int queueEntries;
+
     uint64_t lastSendTime;
     uint64_t originalSendTime;
 
@@ -1464,6 +1834,16 @@ struct sLinkLayerSlaveConnection {
     bool sendLinkLayerTestFunction;
 
     bool nextFcb;
+
+    struct sLinkLayerRtt rtt;
+
+    int class1PollInterval; /* interval of cyclic class 1 requests in ms (0 = no cyclic requests) */
+    int class2PollInterval; /* interval of cyclic class 2 requests in ms (0 = no cyclic requests) */
+    uint64_t nextClass1PollTime;
+    uint64_t nextClass2PollTime;
+
+    int retryDelay; /* current back-off time in ms (0 = slave is responding) */
+    uint64_t nextRetryTime; /* slave is not scheduled before this time */
 };
 
 static LinkLayerSlaveConnection
@@ -1473,6 +1853,15 @@ LinkLayerSlaveConnection_create(LinkLayerSlaveConnection self, LinkLayerPrimaryU
         self = (LinkLayerSlaveConnection) GLOBAL_MALLOC(sizeof(struct sLinkLayerSlaveConnection));
 
     if (self) {
+        self->queue = (struct sLLQueuedMessage*) GLOBAL_CALLOC(primaryLink->queueSize, sizeof(struct sLLQueuedMessage));
+        self->queueOrder = (int*) GLOBAL_MALLOC(primaryLink->queueSize * sizeof(int));
+        self->queueEntries = 0;
+
+        if ((self->queue == NULL) || (self->queueOrder == NULL)) {
+            LinkLayerSlaveConnection_destroy(self);
+            return NULL;
+        }
+
         self->primaryLink = primaryLink;
         self->address = slaveAddress;
 
@@ -1483,6 +1872,8 @@ LinkLayerSlaveConnection_create(LinkLayerSlaveConnection self, LinkLayerPrimaryU
         self->nextFcb = true;
         self->waitingForResponse = false;
 
+        LinkLayerRtt_init(&(self->rtt));
+
         self->primaryState = PLL_IDLE;
 
         self->hasMessageToSend = false;
@@ -1492,12 +1883,142 @@ LinkLayerSlaveConnection_create(LinkLayerSlaveConnection self, LinkLayerPrimaryU
         self->requestClass1Data = false;
         self->requestClass2Data = false;
 
+        self->class1PollInterval = 0;
+        self->class2PollInterval = 0;
+        self->nextClass1PollTime = 0;
+        self->nextClass2PollTime = 0;
+
+        self->retryDelay = 0;
+        self->nextRetryTime = 0;
+
         BufferFrame_initialize(&(self->nextMessage), self->buffer, 0);
     }
 
     return self;
 }
 
+static void
+LinkLayerSlaveConnection_destroy(LinkLayerSlaveConnection self)
+{
+    if (self->queue)
+        GLOBAL_FREEMEM(self->queue);
+
+    if (self->queueOrder)
+        GLOBAL_FREEMEM(self->queueOrder);
+
+    GLOBAL_FREEMEM(self);
+}
+
+static bool
+llsc_enqueueMessage(LinkLayerSlaveConnection self, BufferFrame message, bool highPriority)
+{
+    bool retVal = false;
+
+    LinkLayerPrimaryUnbalanced primaryLink = self->primaryLink;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(primaryLink->queueLock);
+#endif
+
+    if (self->queueEntries < primaryLink->queueSize) {
+
+        int index = 0;
+
+        while (self->queue[index].isUsed)
+            index++;
+
+        struct sLLQueuedMessage* element = &(self->queue[index]);
+
+        element->isUsed = true;
+        element->highPriority = highPriority;
+        element->msgSize = message->msgSize;
+        memcpy(element->buffer, message->buffer, message->msgSize);
+
+        /* high priority messages are sent before all queued low priority messages */
+        int position = self->queueEntries;
+
+        if (highPriority) {
+            for (position = 0; position < self->queueEntries; position++) {
+                if (self->queue[self->queueOrder[position]].highPriority == false)
+                    break;
+            }
+        }
+
+        memmove(self->queueOrder + position + 1, self->queueOrder + position, (self->queueEntries - position) * sizeof(int));
+
+        self->queueOrder[position] = index;
+        self->queueEntries++;
+
+        retVal = true;
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(primaryLink->queueLock);
+#endif
+
+    return retVal;
+}
+
+/* move the next queued message to nextMessage (only when no message is in transmission) */
+static bool
+llsc_dequeueMessage(LinkLayerSlaveConnection self)
+{
+    bool retVal = false;
+
+    LinkLayerPrimaryUnbalanced primaryLink = self->primaryLink;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_lock(primaryLink->queueLock);
+#endif
+
+    if (self->queueEntries > 0) {
+        struct sLLQueuedMessage* element = &(self->queue[self->queueOrder[0]]);
+
+        self->nextMessage.startSize = 0;
+        self->nextMessage.msgSize = element->msgSize;
+        memcpy(self->nextMessage.buffer, element->buffer, element->msgSize);
+
+        element->isUsed = false;
+
+        self->queueEntries--;
+        memmove(self->queueOrder, self->queueOrder + 1, self->queueEntries * sizeof(int));
+
+        self->hasMessageToSend = true;
+
+        retVal = true;
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Mutex_unlock(primaryLink->queueLock);
+#endif
+
+    return retVal;
+}
+
+/* transmission of nextMessage is finished (confirmed or failed) */
+static void
+llsc_messageCompleted(LinkLayerSlaveConnection self, bool success)
+{
+    IPrimaryApplicationLayer applicationLayer = self->primaryLink->applicationLayer;
+
+    self->hasMessageToSend = false;
+
+    if (applicationLayer->SendCompleted)
+        applicationLayer->SendCompleted(self->primaryLink->applicationLayerParam, self->address,
+                self->nextMessage.buffer, self->nextMessage.msgSize, success);
+}
+
+/* link to the slave failed -> don't send old messages (e.g. commands) when the slave is available again */
+static void
+llsc_dropMessages(LinkLayerSlaveConnection self)
+{
+    if (self->hasMessageToSend)
+        llsc_messageCompleted(self, false);
+
+    while (llsc_dequeueMessage(self))
+        llsc_messageCompleted(self, false);
+}
+
 static void
 llsc_setState(LinkLayerSlaveConnection self, LinkLayerState newState)
 {
@@ -1505,11 +2026,34 @@ llsc_setState(LinkLayerSlaveConnection self, LinkLayerState newState)
 
         self->state = newState;
 
+        if (newState == LL_STATE_AVAILABLE)
+            self->retryDelay = 0;
+
         if (self->primaryLink->stateChangedHandler)
             self->primaryLink->stateChangedHandler(self->primaryLink->stateChangedHandlerParameter, self->address, newState);
     }
 }
 
+/* the slave didn't respond -> don't schedule it again before the back-off time elapsed */
+static void
+llsc_startRetryDelay(LinkLayerSlaveConnection self, uint64_t currentTime)
+{
+    LinkLayerPrimaryUnbalanced primaryLink = self->primaryLink;
+
+    if (self->retryDelay == 0)
+        self->retryDelay = primaryLink->minRetryDelay;
+    else if (self->retryDelay < primaryLink->maxRetryDelay) {
+        self->retryDelay = self->retryDelay * 2;
+
+        if (self->retryDelay > primaryLink->maxRetryDelay)
+            self->retryDelay = primaryLink->maxRetryDelay;
+    }
+
+    self->nextRetryTime = currentTime + self->retryDelay;
+
+    DEBUG_PRINT ("[SLAVE %i] PLL - no response -> retry in %i ms\n", self->address, self->retryDelay);
+}
+
 static void
 LinkLayerSlaveConnection_HandleMessage(LinkLayerSlaveConnection self, uint8_t fc, bool acd, bool dfc, int address, uint8_t* msg, int userDataStart, int userDataLength)
 {
@@ -1518,6 +2062,9 @@ LinkLayerSlaveConnection_HandleMessage(LinkLayerSlaveConnection self, uint8_t fc
     PrimaryLinkLayerState primaryState = self->primaryState;
     PrimaryLinkLayerState newState = primaryState;
 
+    if (self->waitingForResponse)
+        LinkLayerRtt_responseReceived(&(self->rtt), Hal_getTimeInMs());
+
     if (dfc) {
 
         DEBUG_PRINT ("[SLAVE %i] PLL - DFC = true!\n", self->address);
@@ -1568,7 +2115,7 @@ LinkLayerSlaveConnection_HandleMessage(LinkLayerSlaveConnection self, uint8_t fc
             if (self->sendLinkLayerTestFunction)
                 self->sendLinkLayerTestFunction = false;
             else
-                self->hasMessageToSend = false;
+                llsc_messageCompleted(self, true);
 
             llsc_setState(self, LL_STATE_AVAILABLE);
 
@@ -1611,8 +2158,9 @@ LinkLayerSlaveConnection_HandleMessage(LinkLayerSlaveConnection self, uint8_t fc
 
             SendFixedFrame(self->primaryLink->linkLayer, LL_FC_00_RESET_REMOTE_LINK, self->address, true, false, false, false);
 
-            self->lastSendTime = Hal_getTimeInMs();
+            self->lastSendTime = LinkLayer_getTransmissionEndTime(self->primaryLink->linkLayer);
             self->waitingForResponse = true;
+            LinkLayerRtt_frameSent(&(self->rtt), self->lastSendTime);
             newState = PLL_EXECUTE_RESET_REMOTE_LINK;
 
             llsc_setState(self, LL_STATE_BUSY);
@@ -1678,6 +2226,10 @@ LinkLayerSlaveConnection_HandleMessage(LinkLayerSlaveConnection self, uint8_t fc
         if (primaryState == PLL_EXECUTE_SERVICE_SEND_CONFIRM) {
             newState = PLL_LINK_LAYERS_AVAILABLE;
 
+            /* message is not accepted by the slave -> don't repeat it */
+            if (self->hasMessageToSend)
+                llsc_messageCompleted(self, false);
+
             llsc_setState(self, LL_STATE_AVAILABLE);
         }
 
@@ -1707,12 +2259,44 @@ LinkLayerSlaveConnection_HandleMessage(LinkLayerSlaveConnection self, uint8_t fc
 static bool
 llsc_isMessageWaitingToSend(LinkLayerSlaveConnection self)
 {
-    if ((self->requestClass1Data) || (self->requestClass2Data) || (self->hasMessageToSend))
+    if ((self->requestClass1Data) || (self->requestClass2Data) || (self->hasMessageToSend) || (self->queueEntries > 0))
         return true;
     else
         return false;
 }
 
+/* check if the slave has to be scheduled (starts the cyclic class 1/2 requests when they are due) */
+static bool
+llsc_needsService(LinkLayerSlaveConnection self, uint64_t currentTime)
+{
+    switch (self->primaryState) {
+
+    case PLL_LINK_LAYERS_AVAILABLE:
+
+        if ((self->class1PollInterval > 0) && (currentTime >= self->nextClass1PollTime)) {
+            self->requestClass1Data = true;
+            self->nextClass1PollTime = currentTime + self->class1PollInterval;
+        }
+
+        if ((self->class2PollInterval > 0) && (currentTime >= self->nextClass2PollTime)) {
+            self->requestClass2Data = true;
+            self->nextClass2PollTime = currentTime + self->class2PollInterval;
+        }
+
+        return (llsc_isMessageWaitingToSend(self) || self->sendLinkLayerTestFunction);
+
+    case PLL_IDLE:
+        /* slave that didn't respond is skipped until the back-off time elapsed */
+        return (currentTime >= self->nextRetryTime);
+
+    case PLL_SECONDARY_LINK_LAYER_BUSY:
+        return false;
+
+    default:
+        return true;
+    }
+}
+
 static void
 LinkLayerSlaveConnection_runStateMachine(LinkLayerSlaveConnection self)
 {
@@ -1738,13 +2322,14 @@ LinkLayerSlaveConnection_runStateMachine(LinkLayerSlaveConnection self)
 
         if (self->waitingForResponse) {
 
-            if (currentTime > (self->lastSendTime + self->primaryLink->linkLayer->linkLayerParameters->timeoutForAck)) {
+            if (currentTime > (self->lastSendTime + LinkLayer_getTimeoutForAck(self->primaryLink->linkLayer, &(self->rtt)))) {
 
                 DEBUG_PRINT ("[SLAVE %i] PLL - SEND FC 09 - REQUEST LINK STATUS\n", self->address);
 
                 SendFixedFrame(self->primaryLink->linkLayer, LL_FC_09_REQUEST_LINK_STATUS, self->address, true, false, false, false);
 
-                self->lastSendTime = currentTime;
+                self->lastSendTime = LinkLayer_getTransmissionEndTime(self->primaryLink->linkLayer);
+                LinkLayerRtt_frameRepeated(&(self->rtt));
             }
 
         }
@@ -1753,8 +2338,9 @@ LinkLayerSlaveConnection_runStateMachine(LinkLayerSlaveConnection self)
 
             SendFixedFrame(self->primaryLink->linkLayer, LL_FC_00_RESET_REMOTE_LINK, self->address, true, false, false, false);
 
-            self->lastSendTime = currentTime;
+            self->lastSendTime = LinkLayer_getTransmissionEndTime(self->primaryLink->linkLayer);
             self->waitingForResponse = true;
+            LinkLayerRtt_frameSent(&(self->rtt), self->lastSendTime);
             self->nextFcb = true;
             newState = PLL_EXECUTE_RESET_REMOTE_LINK;
         }
@@ -1764,11 +2350,13 @@ LinkLayerSlaveConnection_runStateMachine(LinkLayerSlaveConnection self)
     case PLL_EXECUTE_RESET_REMOTE_LINK:
 
         if (self->waitingForResponse) {
-            if (currentTime > (self->lastSendTime + self->primaryLink->linkLayer->linkLayerParameters->timeoutForAck)) {
+            if (currentTime > (self->lastSendTime + LinkLayer_getTimeoutForAck(self->primaryLink->linkLayer, &(self->rtt)))) {
                 self->waitingForResponse = false;
                 newState = PLL_IDLE;
 
                 llsc_setState(self, LL_STATE_ERROR);
+                llsc_startRetryDelay(self, currentTime);
+                llsc_dropMessages(self);
             }
         }
         else {
@@ -1781,15 +2369,19 @@ LinkLayerSlaveConnection_runStateMachine(LinkLayerSlaveConnection self)
 
     case PLL_LINK_LAYERS_AVAILABLE:
 
+        if (self->hasMessageToSend == false)
+            llsc_dequeueMessage(self);
+
         if (self->sendLinkLayerTestFunction) {
             DEBUG_PRINT ("[SLAVE %i] PLL - FC 02 - SEND TEST LINK\n", self->address);
 
             SendFixedFrame(self->primaryLink->linkLayer, LL_FC_02_TEST_FUNCTION_FOR_LINK, self->address, true, false, self->nextFcb, true);
 
             self->nextFcb = !(self->nextFcb);
-            self->lastSendTime = currentTime;
-            self->originalSendTime = currentTime;
+            self->lastSendTime = LinkLayer_getTransmissionEndTime(self->primaryLink->linkLayer);
+            self->originalSendTime = self->lastSendTime;
             self->waitingForResponse = true;
+            LinkLayerRtt_frameSent(&(self->rtt), self->lastSendTime);
 
             newState = PLL_EXECUTE_SERVICE_REQUEST_RESPOND;
         }
@@ -1800,9 +2392,10 @@ LinkLayerSlaveConnection_runStateMachine(LinkLayerSlaveConnection self)
             SendVariableLengthFrame(self->primaryLink->linkLayer, LL_FC_03_USER_DATA_CONFIRMED, self->address, true, false, self->nextFcb, true, (Frame) &(self->nextMessage));
 
             self->nextFcb = !(self->nextFcb);
-            self->lastSendTime = currentTime;
-            self->originalSendTime = currentTime;
+            self->lastSendTime = LinkLayer_getTransmissionEndTime(self->primaryLink->linkLayer);
+            self->originalSendTime = self->lastSendTime;
             self->waitingForResponse = true;
+            LinkLayerRtt_frameSent(&(self->rtt), self->lastSendTime);
 
             newState = PLL_EXECUTE_SERVICE_SEND_CONFIRM;
         }
@@ -1824,9 +2417,10 @@ LinkLayerSlaveConnection_runStateMachine(LinkLayerSlaveConnection self)
             }
 
             self->nextFcb = !(self->nextFcb);
-            self->lastSendTime = currentTime;
-            self->originalSendTime = currentTime;
+            self->lastSendTime = LinkLayer_getTransmissionEndTime(self->primaryLink->linkLayer);
+            self->originalSendTime = self->lastSendTime;
             self->waitingForResponse = true;
+            LinkLayerRtt_frameSent(&(self->rtt), self->lastSendTime);
             newState = PLL_EXECUTE_SERVICE_REQUEST_RESPOND;
         }
 
@@ -1834,13 +2428,15 @@ LinkLayerSlaveConnection_runStateMachine(LinkLayerSlaveConnection self)
 
     case PLL_EXECUTE_SERVICE_SEND_CONFIRM:
 
-        if (currentTime > (self->lastSendTime + self->primaryLink->linkLayer->linkLayerParameters->timeoutForAck)) {
+        if (currentTime > (self->lastSendTime + LinkLayer_getTimeoutForAck(self->primaryLink->linkLayer, &(self->rtt)))) {
 
-            if (currentTime > (self->originalSendTime + self->primaryLink->linkLayer->linkLayerParameters->timeoutRepeat)) {
+            if (currentTime > (self->originalSendTime + LinkLayer_getTimeoutRepeat(self->primaryLink->linkLayer, &(self->rtt)))) {
                 DEBUG_PRINT ("[SLAVE %i] TIMEOUT: ASDU not confirmed after repeated transmission\n", self->address);
                 newState = PLL_IDLE;
 
                 llsc_setState(self, LL_STATE_ERROR);
+                llsc_startRetryDelay(self, currentTime);
+                llsc_dropMessages(self);
             }
             else {
                 DEBUG_PRINT ("[SLAVE %i] TIMEOUT: ASDU not confirmed\n", self->address);
@@ -1860,7 +2456,8 @@ LinkLayerSlaveConnection_runStateMachine(LinkLayerSlaveConnection self)
 
                 }
 
-                self->lastSendTime = currentTime;
+                self->lastSendTime = LinkLayer_getTransmissionEndTime(self->primaryLink->linkLayer);
+                LinkLayerRtt_frameRepeated(&(self->rtt));
             }
 
         }
@@ -1869,9 +2466,9 @@ LinkLayerSlaveConnection_runStateMachine(LinkLayerSlaveConnection self)
 
     case PLL_EXECUTE_SERVICE_REQUEST_RESPOND:
 
-        if (currentTime > (self->lastSendTime + self->primaryLink->linkLayer->linkLayerParameters->timeoutForAck)) {
+        if (currentTime > (self->lastSendTime + LinkLayer_getTimeoutForAck(self->primaryLink->linkLayer, &(self->rtt)))) {
 
-            if (currentTime > (self->originalSendTime + self->primaryLink->linkLayer->linkLayerParameters->timeoutRepeat)) {
+            if (currentTime > (self->originalSendTime + LinkLayer_getTimeoutRepeat(self->primaryLink->linkLayer, &(self->rtt)))) {
                 DEBUG_PRINT ("[SLAVE %i] TIMEOUT: ASDU not confirmed after repeated transmission\n", self->address);
 
                 newState = PLL_IDLE;
@@ -1879,6 +2476,8 @@ LinkLayerSlaveConnection_runStateMachine(LinkLayerSlaveConnection self)
                 self->requestClass2Data = false;
 
                 llsc_setState(self, LL_STATE_ERROR);
+                llsc_startRetryDelay(self, currentTime);
+                llsc_dropMessages(self);
             }
             else {
                 DEBUG_PRINT ("[SLAVE %i] TIMEOUT: ASDU not confirmed\n", self->address);
@@ -1894,7 +2493,8 @@ LinkLayerSlaveConnection_runStateMachine(LinkLayerSlaveConnection self)
                     SendFixedFrame(self->primaryLink->linkLayer, LL_FC_11_REQUEST_USER_DATA_CLASS_2, self->address, true, false, !(self->nextFcb), true);
                 }
 
-                self->lastSendTime = currentTime;
+                self->lastSendTime = LinkLayer_getTransmissionEndTime(self->primaryLink->linkLayer);
+                LinkLayerRtt_frameRepeated(&(self->rtt));
             }
 
         }
@@ -1914,39 +2514,105 @@ LinkLayerSlaveConnection_runStateMachine(LinkLayerSlaveConnection self)
 
 
 
+/* binary search in the sorted slave table - returns the index where a slave with this address is (or has to be inserted) */
+static int
+LinkLayerPrimaryUnbalanced_findSlaveIndex(LinkLayerPrimaryUnbalanced self, int slaveAddress)
+{
+    int low = 0;
+    int high = self->numberOfSlaves;
+
+    while (low < high) {
+        int mid = (low + high) / 2;
+
+        if (self->slaves[mid]->address < slaveAddress)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
 static LinkLayerSlaveConnection
 LinkLayerPrimaryUnbalanced_getSlaveConnection(LinkLayerPrimaryUnbalanced self, int slaveAddress)
 {
-    LinkLayerSlaveConnection retVal = NULL;
+    /* responses are usually received from the slave that is currently polled */
+    if ((self->currentSlave) && (self->currentSlave->address == slaveAddress))
+        return self->currentSlave;
 
-    LinkedList element = LinkedList_getNext(self->slaveConnections);
+    int index = LinkLayerPrimaryUnbalanced_findSlaveIndex(self, slaveAddress);
 
-    while (element) {
+    if ((index < self->numberOfSlaves) && (self->slaves[index]->address == slaveAddress))
+        return self->slaves[index];
 
-        LinkLayerSlaveConnection slaveConnection = (LinkLayerSlaveConnection) LinkedList_getData(element);
+    return NULL;
+}
 
-        if (slaveConnection->address == slaveAddress) {
-            retVal = slaveConnection;
-            break;
-        }
+void
+LinkLayerPrimaryUnbalanced_addSlaveConnection(LinkLayerPrimaryUnbalanced self, int slaveAddress)
+{
+    int index = LinkLayerPrimaryUnbalanced_findSlaveIndex(self, slaveAddress);
+
+    if ((index < self->numberOfSlaves) && (self->slaves[index]->address == slaveAddress))
+        return;
 
-        element = LinkedList_getNext(element);
+    if (self->numberOfSlaves == self->maxSlaves) {
+        int newMaxSlaves = (self->maxSlaves == 0) ? 8 : (self->maxSlaves * 2);
+
+        LinkLayerSlaveConnection* newSlaves = (LinkLayerSlaveConnection*) GLOBAL_REALLOC(self->slaves, newMaxSlaves * sizeof(LinkLayerSlaveConnection));
+
+        if (newSlaves == NULL)
+            return;
+
+        self->slaves = newSlaves;
+        self->maxSlaves = newMaxSlaves;
     }
 
-    return retVal;
+    LinkLayerSlaveConnection newSlave = LinkLayerSlaveConnection_create(NULL, self, slaveAddress);
+
+    if (newSlave) {
+        memmove(self->slaves + index + 1, self->slaves + index, (self->numberOfSlaves - index) * sizeof(LinkLayerSlaveConnection));
+
+        self->slaves[index] = newSlave;
+        self->numberOfSlaves++;
+
+        /* keep the round robin position */
+        if (index < self->currentSlaveIndex)
+            self->currentSlaveIndex++;
+    }
 }
 
-void
-LinkLayerPrimaryUnbalanced_addSlaveConnection(LinkLayerPrimaryUnbalanced self, int slaveAddress)
+bool
+LinkLayerPrimaryUnbalanced_setPollIntervals(LinkLayerPrimaryUnbalanced self, int slaveAddress, int class1Interval, int class2Interval)
 {
-    LinkLayerSlaveConnection slaveConnection = LinkLayerPrimaryUnbalanced_getSlaveConnection(self, slaveAddress);
+    LinkLayerSlaveConnection slave = LinkLayerPrimaryUnbalanced_getSlaveConnection(self, slaveAddress);
 
-    if (slaveConnection == NULL) {
-        LinkLayerSlaveConnection newSlave = LinkLayerSlaveConnection_create(NULL, self, slaveAddress);
+    if (slave) {
+        slave->class1PollInterval = class1Interval;
+        slave->class2PollInterval = class2Interval;
+        slave->nextClass1PollTime = 0;
+        slave->nextClass2PollTime = 0;
 
-        LinkedList_add(self->slaveConnections, newSlave);
+        return true;
     }
 
+    return false;
+}
+
+void
+LinkLayerPrimaryUnbalanced_setAdaptiveTimeouts(LinkLayerPrimaryUnbalanced self, bool enable, int minTimeoutForAck, int maxTimeoutForAck)
+{
+    LinkLayer_setAdaptiveTimeouts(self->linkLayer, enable, minTimeoutForAck, maxTimeoutForAck);
+}
+
+void
+LinkLayerPrimaryUnbalanced_setRetryDelay(LinkLayerPrimaryUnbalanced self, int minRetryDelay, int maxRetryDelay)
+{
+    if (maxRetryDelay < minRetryDelay)
+        maxRetryDelay = minRetryDelay;
+
+    self->minRetryDelay = minRetryDelay;
+    self->maxRetryDelay = maxRetryDelay;
 }
 
 void
@@ -1965,7 +2631,7 @@ LinkLayerPrimaryUnbalanced_isChannelAvailable(LinkLayerPrimaryUnbalanced self, i
     LinkLayerSlaveConnection slave = LinkLayerPrimaryUnbalanced_getSlaveConnection(self, slaveAddress);
 
     if (slave)
-        return !(llsc_isMessageWaitingToSend(slave));
+        return (slave->queueEntries < self->queueSize);
 
     return false;
 }
@@ -2006,28 +2672,18 @@ LinkLayerPrimaryUnbalanced_requestClass2Data(LinkLayerPrimaryUnbalanced self, in
 }
 
 bool
-LinkLayerPrimaryUnbalanced_sendConfirmed(LinkLayerPrimaryUnbalanced self, int slaveAddress, BufferFrame message)
+LinkLayerPrimaryUnbalanced_sendConfirmed(LinkLayerPrimaryUnbalanced self, int slaveAddress, BufferFrame message, bool highPriority)
 {
     LinkLayerSlaveConnection slave = LinkLayerPrimaryUnbalanced_getSlaveConnection(self, slaveAddress);
 
-    if (slave) {
-
-        if (slave->hasMessageToSend == false) {
-
-            slave->nextMessage.msgSize = message->msgSize;
-            slave->nextMessage.startSize = message->startSize;
-            memcpy(slave->nextMessage.buffer, message->buffer, message->msgSize);
-
-            slave->hasMessageToSend = true;
-            return true;
-        }
-    }
+    if (slave)
+        return llsc_enqueueMessage(slave, message, highPriority);
 
     return false;
 }
 
 bool
-LinkLayerPrimaryUnbalanced_sendNoReply(LinkLayerPrimaryUnbalanced self, int slaveAddress, BufferFrame message)
+LinkLayerPrimaryUnbalanced_sendNoReply(LinkLayerPrimaryUnbalanced self, int slaveAddress, BufferFrame message, bool highPriority)
 {
     if (slaveAddress == LinkLayer_getBroadcastAddress(self->linkLayer)) {
         if (self->hasNextBroadcastToSend)
@@ -2045,17 +2701,8 @@ LinkLayerPrimaryUnbalanced_sendNoReply(LinkLayerPrimaryUnbalanced self, int slav
     else {
         LinkLayerSlaveConnection slave = LinkLayerPrimaryUnbalanced_getSlaveConnection(self, slaveAddress);
 
-        if (slave) {
-            if (slave->hasMessageToSend == false) {
-
-                slave->nextMessage.msgSize = message->msgSize;
-                slave->nextMessage.startSize = message->startSize;
-                memcpy(slave->nextMessage.buffer, message->buffer, message->msgSize);
-
-                slave->hasMessageToSend = true;
-                return true;
-            }
-        }
+        if (slave)
+            return llsc_enqueueMessage(slave, message, highPriority);
     }
 
     return false;
@@ -2083,6 +2730,10 @@ LinkLayerPrimaryUnbalanced_handleMessage(LinkLayerPrimaryUnbalanced self, uint8_
 void
 LinkLayerPrimaryUnbalanced_runStateMachine(LinkLayerPrimaryUnbalanced self)
 {
+    /* previous frame is still transmitted or the line idle time is not elapsed -> continue in the next call */
+    if (SerialTransceiverFT12_isReadyToSend(self->linkLayer->transceiver) == false)
+        return;
+
     if (self->hasNextBroadcastToSend) {
         /* send pending broadcast message */
 
@@ -2092,20 +2743,45 @@ LinkLayerPrimaryUnbalanced_runStateMachine(LinkLayerPrimaryUnbalanced self)
     }
 
     /* run all the link layer state machines for the registered slaves */
-    if (LinkedList_size(self->slaveConnections) > 0) {
+    if (self->numberOfSlaves > 0) {
+
+        uint64_t currentTime = Hal_getTimeInMs();
 
         if (self->currentSlave != NULL) {
-            if (self->currentSlave->waitingForResponse == false)
-                self->currentSlave = NULL;
+            if (self->currentSlave->waitingForResponse == false) {
+
+                /* slave indicated class 1 data (ACD) -> request it before polling other slaves */
+                if ((self->currentSlave->requestClass1Data) &&
+                        (self->currentSlave->primaryState == PLL_LINK_LAYERS_AVAILABLE) &&
+                        (self->consecutiveAcdPolls < LL_MAX_CONSECUTIVE_ACD_POLLS))
+                {
+                    self->consecutiveAcdPolls++;
+                }
+                else {
+                    self->currentSlave = NULL;
+                    self->consecutiveAcdPolls = 0;
+                }
+            }
         }
 
         if (self->currentSlave == NULL) {
-            /* schedule next slave connection */
-            self->currentSlave = (LinkLayerSlaveConnection) LinkedList_getData(LinkedList_get(self->slaveConnections, self->currentSlaveIndex));
-            self->currentSlaveIndex = (self->currentSlaveIndex + 1) % LinkedList_size(self->slaveConnections);
+            /* schedule next slave connection that has something to do */
+            int i;
+
+            for (i = 0; i < self->numberOfSlaves; i++) {
+                LinkLayerSlaveConnection slave = self->slaves[self->currentSlaveIndex];
+
+                self->currentSlaveIndex = (self->currentSlaveIndex + 1) % self->numberOfSlaves;
+
+                if (llsc_needsService(slave, currentTime)) {
+                    self->currentSlave = slave;
+                    break;
+                }
+            }
         }
 
-        LinkLayerSlaveConnection_runStateMachine(self->currentSlave);
+        if (self->currentSlave)
+            LinkLayerSlaveConnection_runStateMachine(self->currentSlave);
     }
 }
 
@@ -22,23 +22,76 @@
  */
 
 #include "hal_serial.h"
+#include "hal_time.h"
 #include "serial_transceiver_ft_1_2.h"
 #include "lib_memory.h"
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include "lib60870_internal.h"
 
+/* size of the receive buffer. Has to be larger than the maximum FT1.2 frame length (261) */
+#define FT12_RX_BUFFER_SIZE 1024
+
+/* FT1.2 character: start bit, 8 data bits, even parity bit, stop bit (used when the transport doesn't provide the format) */
+#define FT12_DEFAULT_BITS_PER_CHARACTER 11
+
+/* minimum line idle time between two frames in bit times (IEC 60870-5-1 FT1.2) */
+#define FT12_LINE_IDLE_BITS 33
+
 struct sSerialTransceiverFT12 {
     int messageTimeout;
     int characterTimeout;
     LinkLayerParameters linkLayerParameters;
-    SerialPort serialPort;
+    SerialPort serialPort; /* NULL when a user provided transport is used */
+    struct sCS101_Transport transport;
     IEC60870_RawMessageHandler rawMessageHandler;
     void* rawMessageHandlerParameter;
+
+    /* don't wait for data in readNextMessage (when the port is monitored by the caller) */
+    bool nonBlocking;
+    uint64_t lastRxTime;
+
+    /* calculated time when the last sent message has left the UART */
+    uint64_t transmissionEndTime;
+    uint64_t lastSendTime;
+
+    /* received bytes that are not yet handled are kept in rxBuffer[rxStart] .. rxBuffer[rxEnd - 1] */
+    int rxStart;
+    int rxEnd;
+    uint8_t rxBuffer[FT12_RX_BUFFER_SIZE];
 };
 
+static int
+serialPortReadBytes(void* parameter, uint8_t* buffer, int maxSize, int timeoutInMs)
+{
+    SerialPort serialPort = (SerialPort) parameter;
+
+    SerialPort_setTimeout(serialPort, timeoutInMs);
+
+    return SerialPort_readBytes(serialPort, buffer, maxSize);
+}
+
+static int
+serialPortWrite(void* parameter, uint8_t* buffer, int numberOfBytes)
+{
+    return SerialPort_write((SerialPort) parameter, buffer, 0, numberOfBytes);
+}
+
+static int
+serialPortGetBaudRate(void* parameter)
+{
+    return SerialPort_getBaudRate((SerialPort) parameter);
+}
+
+static int
+serialPortGetBitsPerCharacter(void* parameter)
+{
+    return SerialPort_getBitsPerCharacter((SerialPort) parameter);
+}
+
 SerialTransceiverFT12
-SerialTransceiverFT12_create(SerialPort serialPort, LinkLayerParameters linkLayerParameters)
+SerialTransceiverFT12_createWithTransport(CS101_Transport transport, LinkLayerParameters linkLayerParameters)
 {
     SerialTransceiverFT12 self = (SerialTransceiverFT12) GLOBAL_MALLOC(sizeof(struct sSerialTransceiverFT12));
 
@@ -46,13 +99,39 @@ SerialTransceiverFT12_create(SerialPort serialPort, LinkLayerParameters linkLaye
         self->messageTimeout = 10;
         self->characterTimeout = 300;
         self->linkLayerParameters = linkLayerParameters;
-        self->serialPort = serialPort;
+        self->serialPort = NULL;
+        self->transport = *transport;
         self->rawMessageHandler = NULL;
+        self->rxStart = 0;
+        self->rxEnd = 0;
+        self->nonBlocking = false;
+        self->lastRxTime = 0;
+        self->transmissionEndTime = 0;
+        self->lastSendTime = 0;
     }
 
     return self;
 }
 
+SerialTransceiverFT12
+SerialTransceiverFT12_create(SerialPort serialPort, LinkLayerParameters linkLayerParameters)
+{
+    struct sCS101_Transport transport;
+
+    transport.readBytes = serialPortReadBytes;
+    transport.write = serialPortWrite;
+    transport.getBaudRate = serialPortGetBaudRate;
+    transport.getBitsPerCharacter = serialPortGetBitsPerCharacter;
+    transport.parameter = serialPort;
+
+    SerialTransceiverFT12 self = SerialTransceiverFT12_createWithTransport(&transport, linkLayerParameters);
+
+    if (self != NULL)
+        self->serialPort = serialPort;
+
+    return self;
+}
+
 void
 SerialTransceiverFT12_destroy(SerialTransceiverFT12 self)
 {
@@ -74,127 +153,219 @@ SerialTransceiverFT12_setRawMessageHandler(SerialTransceiverFT12 self, IEC60870_
     self->rawMessageHandlerParameter = parameter;
 }
 
+void
+SerialTransceiverFT12_setNonBlocking(SerialTransceiverFT12 self, bool nonBlocking)
+{
+    self->nonBlocking = nonBlocking;
+}
+
+SerialPort
+SerialTransceiverFT12_getSerialPort(SerialTransceiverFT12 self)
+{
+    return self->serialPort;
+}
+
 int
 SerialTransceiverFT12_getBaudRate(SerialTransceiverFT12 self)
 {
-    return SerialPort_getBaudRate(self->serialPort);
+    return self->transport.getBaudRate(self->transport.parameter);
 }
 
-void
-SerialTransceiverFT12_sendMessage(SerialTransceiverFT12 self, uint8_t* msg, int msgSize)
+/* transmission time of a number of bits in ms (rounded up) */
+static int
+getTransmissionTime(SerialTransceiverFT12 self, int numberOfBits)
 {
-    if (self->rawMessageHandler)
-        self->rawMessageHandler(self->rawMessageHandlerParameter, msg, msgSize, true);
+    int baudRate = SerialTransceiverFT12_getBaudRate(self);
 
-    SerialPort_write(self->serialPort, msg, 0, msgSize);
+    if (baudRate > 0)
+        return (int) ((((int64_t) numberOfBits * 1000) + baudRate - 1) / baudRate);
+    else
+        return 0;
 }
 
 static int
-readBytesWithTimeout(SerialTransceiverFT12 self, uint8_t* buffer, int startIndex, int count)
+getBitsPerCharacter(SerialTransceiverFT12 self)
 {
-    int readByte;
-    int readBytes = 0;
-
-    while ((readByte = SerialPort_readByte(self->serialPort)) != -1) {
-        buffer[startIndex++] = (uint8_t) readByte;
+    if (self->transport.getBitsPerCharacter)
+        return self->transport.getBitsPerCharacter(self->transport.parameter);
+    else
+        return FT12_DEFAULT_BITS_PER_CHARACTER;
+}
 
-        readBytes++;
+uint64_t
+SerialTransceiverFT12_getTransmissionEndTime(SerialTransceiverFT12 self)
+{
+    uint64_t currentTime = Hal_getTimeInMs();
 
-        if (readBytes >= count)
-            break;
+    /* not plausible (system time moved to the past) */
+    if (currentTime < self->lastSendTime) {
+        self->lastSendTime = currentTime;
+        self->transmissionEndTime = currentTime;
     }
 
-    return readBytes;
+    return self->transmissionEndTime;
 }
 
-void
-SerialTransceiverFT12_readNextMessage(SerialTransceiverFT12 self, uint8_t* buffer,
-        SerialTXMessageHandler messageHandler, void* parameter)
+bool
+SerialTransceiverFT12_isReadyToSend(SerialTransceiverFT12 self)
 {
-    SerialPort_setTimeout(self->serialPort, self->messageTimeout);
-
-    int read = SerialPort_readByte(self->serialPort);
+    uint64_t lineFreeTime = SerialTransceiverFT12_getTransmissionEndTime(self) + getTransmissionTime(self, FT12_LINE_IDLE_BITS);
 
-    if (read != -1) {
+    return (Hal_getTimeInMs() >= lineFreeTime);
+}
 
-        if (read == 0x68) {
+void
+SerialTransceiverFT12_sendMessage(SerialTransceiverFT12 self, uint8_t* msg, int msgSize)
+{
+    if (self->rawMessageHandler)
+        self->rawMessageHandler(self->rawMessageHandlerParameter, msg, msgSize, true);
 
-            SerialPort_setTimeout(self->serialPort, self->characterTimeout);
+    /* the message is sent after the data that is still in the transmit buffer of the UART */
+    uint64_t startTime = SerialTransceiverFT12_getTransmissionEndTime(self);
 
-            int msgSize = SerialPort_readByte(self->serialPort);
+    self->lastSendTime = Hal_getTimeInMs();
 
-            if (msgSize == -1)
-                goto sync_error;
+    if (startTime < self->lastSendTime)
+        startTime = self->lastSendTime;
 
-            buffer[0] = (uint8_t) 0x68;
-            buffer[1] = (uint8_t) msgSize;
+    self->transmissionEndTime = startTime + getTransmissionTime(self, msgSize * getBitsPerCharacter(self));
 
-            msgSize += 4;
+    self->transport.write(self->transport.parameter, msg, msgSize);
+}
 
-            int readBytes = readBytesWithTimeout(self, buffer, 2, msgSize);
+static bool
+isStartCharacter(uint8_t value)
+{
+    return ((value == 0x68) || (value == 0x10) || (value == 0xe5));
+}
 
-            if (readBytes == msgSize) {
-                msgSize += 2;
+/**
+ * Check if a complete frame is at the start of the receive buffer. Bytes that cannot
+ * be the start of a valid frame are skipped (resynchronization inside the buffered data).
+ *
+ * \return the length of the frame, or 0 when no complete frame is buffered
+ */
+static int
+getBufferedFrameLength(SerialTransceiverFT12 self)
+{
+    while (self->rxStart < self->rxEnd) {
 
-                if (self->rawMessageHandler)
-                    self->rawMessageHandler(self->rawMessageHandlerParameter, buffer, msgSize, false);
+        uint8_t* frame = self->rxBuffer + self->rxStart;
+        int available = self->rxEnd - self->rxStart;
+        int frameLength;
 
-                messageHandler(parameter, buffer, msgSize);
-            }
-            else {
-                DEBUG_PRINT("RECV: Timeout reading variable length frame size = %i (expected = %i)\n", readBytes, msgSize);
+        if (frame[0] == 0xe5) {
+            return 1;
+        }
+        else if (frame[0] == 0x10) {
+            frameLength = 4 + self->linkLayerParameters->addressLength;
+        }
+        else if (frame[0] == 0x68) {
+            if (available < 4)
+                return 0;
+
+            /* variable length frame header: 0x68 L L 0x68 */
+            if ((frame[1] != frame[2]) || (frame[3] != 0x68)) {
+                DEBUG_PRINT("RECV: SYNC ERROR (invalid frame header)\n");
+                self->rxStart++;
+                continue;
             }
 
+            frameLength = frame[1] + 6;
+        }
+        else {
+            DEBUG_PRINT("RECV: SYNC ERROR\n");
+
+            /* skip to the next possible start character */
+            do {
+                self->rxStart++;
+            } while ((self->rxStart < self->rxEnd) && (isStartCharacter(self->rxBuffer[self->rxStart]) == false));
+
+            continue;
         }
-        else if (read == 0x10) {
 
-            SerialPort_setTimeout(self->serialPort, self->characterTimeout);
+        if (available < frameLength)
+            return 0;
 
-            buffer[0] = 0x10;
+        if (frame[frameLength - 1] != 0x16) {
+            DEBUG_PRINT("RECV: SYNC ERROR (missing end character)\n");
+            self->rxStart++;
+            continue;
+        }
 
-            int msgSize = 3 + self->linkLayerParameters->addressLength;
+        return frameLength;
+    }
 
-            int readBytes = readBytesWithTimeout(self, buffer, 1, msgSize);
+    return 0;
+}
 
-            if (readBytes == msgSize) {
-                msgSize += 1;
+bool
+SerialTransceiverFT12_isMessageBuffered(SerialTransceiverFT12 self)
+{
+    return (getBufferedFrameLength(self) > 0);
+}
 
-                if (self->rawMessageHandler)
-                    self->rawMessageHandler(self->rawMessageHandlerParameter, buffer, msgSize, false);
+void
+SerialTransceiverFT12_readNextMessage(SerialTransceiverFT12 self, uint8_t* buffer,
+        SerialTXMessageHandler messageHandler, void* parameter)
+{
+    int frameLength;
 
-                messageHandler(parameter, buffer, msgSize);
-            }
-            else {
-                DEBUG_PRINT("RECV: Timeout reading fixed length frame size = %i (expected = %i)\n", readBytes, msgSize);
-            }
+    while ((frameLength = getBufferedFrameLength(self)) == 0) {
 
-        }
-        else if (read == 0xe5) {
-            int msgSize = 1;
-            buffer[0] = (uint8_t) read;
+        int readTimeout;
 
-            if (self->rawMessageHandler)
-                self->rawMessageHandler(self->rawMessageHandlerParameter, buffer, msgSize, false);
+        if (self->rxStart == self->rxEnd) {
+            self->rxStart = 0;
+            self->rxEnd = 0;
 
-            messageHandler(parameter, buffer, msgSize);
+            readTimeout = self->messageTimeout;
         }
         else {
-            goto sync_error;
+            /* move the incomplete frame to the start of the buffer */
+            if (self->rxStart > 0) {
+                memmove(self->rxBuffer, self->rxBuffer + self->rxStart, self->rxEnd - self->rxStart);
+                self->rxEnd -= self->rxStart;
+                self->rxStart = 0;
+            }
+
+            readTimeout = self->characterTimeout;
         }
 
-    }
+        if (self->nonBlocking)
+            readTimeout = 0;
 
-    return;
+        int readBytes = self->transport.readBytes(self->transport.parameter, self->rxBuffer + self->rxEnd,
+                FT12_RX_BUFFER_SIZE - self->rxEnd, readTimeout);
 
-sync_error:
+        if (readBytes <= 0) {
 
-    DEBUG_PRINT("RECV: SYNC ERROR\n");
+            if (self->rxStart < self->rxEnd) {
 
-    SerialPort_discardInBuffer(self->serialPort);
+                /* in non-blocking mode the character timeout is checked over multiple calls */
+                if ((self->nonBlocking == false) ||
+                        ((Hal_getTimeInMs() - self->lastRxTime) > (uint64_t) self->characterTimeout))
+                {
+                    DEBUG_PRINT("RECV: Timeout reading frame (%i bytes received)\n", self->rxEnd - self->rxStart);
 
-    return;
-}
+                    /* drop the start character of the incomplete frame. Following bytes are checked for a new frame */
+                    self->rxStart++;
+                }
+            }
 
+            return;
+        }
+
+        self->rxEnd += readBytes;
+        self->lastRxTime = Hal_getTimeInMs();
+    }
 
+    memcpy(buffer, self->rxBuffer + self->rxStart, frameLength);
 
+    self->rxStart += frameLength;
 
+    if (self->rawMessageHandler)
+        self->rawMessageHandler(self->rawMessageHandlerParameter, buffer, frameLength, false);
+
+    messageHandler(parameter, buffer, frameLength);
+}
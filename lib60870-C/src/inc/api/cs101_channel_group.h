@@ -0,0 +1,152 @@
+/*
+ *  cs101_channel_group.h
+ *
+ *  Copyright 2017 MZ Automation GmbH
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+/**
+ * \file cs101_channel_group.h
+ * \brief Handle multiple CS 101 channels (serial lines) with a small number of threads.
+ */
+
+#ifndef SRC_INC_API_CS101_CHANNEL_GROUP_H_
+#define SRC_INC_API_CS101_CHANNEL_GROUP_H_
+
+#include "hal_serial.h"
+#include "cs101_master.h"
+#include "cs101_slave.h"
+#include "hal_thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup MASTER
+ *
+ * @{
+ */
+
+/**
+ * @defgroup CS101_CHANNEL_GROUP CS 101 channel group
+ *
+ * A channel group runs the protocol state machines of many \ref CS101_Master and \ref CS101_Slave
+ * instances. Instead of one thread per serial line the group waits for received data on all
+ * serial ports at once. The number of threads can be chosen independently of the number of channels.
+ *
+ * NOTE: The masters and slaves of a group must not be started with \ref CS101_Master_start or
+ * \ref CS101_Slave_start and their run functions must not be called by the application.
+ *
+ * @{
+ */
+
+typedef struct sCS101_ChannelGroup* CS101_ChannelGroup;
+
+/**
+ * \brief Create a new (empty) channel group
+ *
+ * \return the new channel group instance
+ */
+CS101_ChannelGroup
+CS101_ChannelGroup_create(void);
+
+/**
+ * \brief Add a master to the channel group
+ *
+ * NOTE: Has to be called before \ref CS101_ChannelGroup_start. The serial port of the master has to be open.
+ *
+ * \param master the master instance (will not be destroyed by the group)
+ */
+void
+CS101_ChannelGroup_addMaster(CS101_ChannelGroup self, CS101_Master master);
+
+/**
+ * \brief Add a slave to the channel group
+ *
+ * NOTE: Has to be called before \ref CS101_ChannelGroup_start. The serial port of the slave has to be open.
+ *
+ * \param slave the slave instance (will not be destroyed by the group)
+ */
+void
+CS101_ChannelGroup_addSlave(CS101_ChannelGroup self, CS101_Slave slave);
+
+/**
+ * \brief Wait for received data on any channel and run the protocol state machines of the channels
+ *
+ * Can be used instead of \ref CS101_ChannelGroup_start when the application doesn't want the group
+ * to create threads. Has to be called frequently.
+ *
+ * The channels with received data are run immediately. The other channels are run when they have not
+ * been run for timeoutInMs (to handle the timeouts and the queued messages).
+ *
+ * \param timeoutInMs maximum time to wait for received data
+ */
+void
+CS101_ChannelGroup_run(CS101_ChannelGroup self, int timeoutInMs);
+
+/**
+ * \brief Set the attributes of the worker threads (CPU affinity, scheduling, name)
+ *
+ * NOTE: Has to be called before \ref CS101_ChannelGroup_start. Requires threads.
+ *
+ * \param attributes the thread attributes (will be copied)
+ */
+void
+CS101_ChannelGroup_setThreadAttributes(CS101_ChannelGroup self, ThreadAttributes attributes);
+
+/**
+ * \brief Start worker threads that handle the channels of the group
+ *
+ * The channels are distributed equally over the worker threads.
+ *
+ * NOTE: This requires threads.
+ *
+ * \param numberOfThreads number of worker threads (e.g. the number of CPU cores)
+ */
+void
+CS101_ChannelGroup_start(CS101_ChannelGroup self, int numberOfThreads);
+
+/**
+ * \brief Stop the worker threads
+ */
+void
+CS101_ChannelGroup_stop(CS101_ChannelGroup self);
+
+/**
+ * \brief Destroy the channel group
+ *
+ * The masters and slaves of the group are not destroyed.
+ */
+void
+CS101_ChannelGroup_destroy(CS101_ChannelGroup self);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_API_CS101_CHANNEL_GROUP_H_ */
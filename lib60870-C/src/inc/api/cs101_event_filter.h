@@ -0,0 +1,179 @@
+/*
+ *  cs101_event_filter.h
+ *
+ *  Copyright 2017 MZ Automation GmbH
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+/**
+ * \file cs101_event_filter.h
+ * \brief Deadband and change detection filter for spontaneous events
+ */
+
+#ifndef SRC_INC_API_CS101_EVENT_FILTER_H_
+#define SRC_INC_API_CS101_EVENT_FILTER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "iec60870_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup SLAVE Slave related functions
+ *
+ * @{
+ */
+
+/**
+ * @defgroup CS101_EVENT_FILTER Event filter
+ *
+ * The event filter removes spontaneous events (COT \ref CS101_COT_SPONTANEOUS) that don't contain a
+ * relevant change from the ASDUs before they are stored in the event queue of the slave
+ * (see \ref CS104_Slave_setEventFilter).
+ *
+ * The filter stores the last reported value and quality of each point (identified by CA and IOA):
+ * - status information (M_SP, M_DP, M_ST and M_BO types) is reported when the value changes (change of state)
+ * - measured values (M_ME types) are reported when the change exceeds the deadband of the point
+ * - a change of the quality is always reported
+ * - the first event of a point is always reported
+ *
+ * ASDUs with other types or other causes of transmission are not changed.
+ *
+ * @{
+ */
+
+typedef struct sCS101_EventFilter* CS101_EventFilter;
+
+/**
+ * \brief Deadband mode of a measured value
+ */
+typedef enum
+{
+    /** every change of the value is reported */
+    CS101_DEADBAND_NONE = 0,
+
+    /** the value is reported when the difference to the last reported value exceeds the deadband */
+    CS101_DEADBAND_ABSOLUTE = 1,
+
+    /** the value is reported when the difference to the last reported value exceeds the deadband
+     * (in percent of the last reported value) */
+    CS101_DEADBAND_PERCENTAGE = 2,
+
+    /** the differences of all filtered values to the last reported value are added up. The value is
+     * reported when the sum exceeds the deadband. */
+    CS101_DEADBAND_INTEGRATED = 3
+} CS101_DeadbandMode;
+
+/**
+ * \brief Create a new event filter
+ *
+ * The default deadband of the measured values is \ref CS101_DEADBAND_NONE.
+ *
+ * \return the new event filter instance
+ */
+CS101_EventFilter
+CS101_EventFilter_create(void);
+
+/**
+ * \brief Set the deadband of the measured values without own deadband
+ *
+ * \param mode the deadband mode
+ * \param deadband the deadband (in the unit of the value or in percent)
+ */
+void
+CS101_EventFilter_setDefaultDeadband(CS101_EventFilter self, CS101_DeadbandMode mode, float deadband);
+
+/**
+ * \brief Set the deadband of a measured value
+ *
+ * NOTE: The deadband of normalized values is in the range of the value (-1.0 ... +1.0). The deadband of
+ * scaled values is in the unit of the scaled value.
+ *
+ * \param ca common address of the point
+ * \param ioa information object address of the point
+ * \param mode the deadband mode
+ * \param deadband the deadband (in the unit of the value or in percent)
+ *
+ * \return true when the deadband has been set, false otherwise (out of memory)
+ */
+bool
+CS101_EventFilter_setDeadband(CS101_EventFilter self, int ca, int ioa, CS101_DeadbandMode mode, float deadband);
+
+/**
+ * \brief Handler that receives the ASDUs with the reported information objects
+ *
+ * NOTE: The ASDU is only valid while the handler is running. The handler must not call functions
+ * of the event filter.
+ *
+ * \param parameter user provided parameter
+ * \param asdu ASDU with reported information objects
+ */
+typedef void (*CS101_EventFilter_ASDUHandler) (void* parameter, CS101_ASDU asdu);
+
+/**
+ * \brief Filter the information objects of an ASDU
+ *
+ * Is called by the slave when the filter is set with \ref CS104_Slave_setEventFilter. Can be
+ * used directly for other queues (e.g. before \ref CS101_Slave_enqueueUserDataClass1).
+ *
+ * When all information objects are reported the handler is called with the original ASDU. Otherwise
+ * the reported information objects are copied to new ASDUs without the sequence format. The
+ * information objects may need more space in this format and are split over several ASDUs when they
+ * don't fit into a single ASDU.
+ *
+ * \param asdu the ASDU to filter (is not changed)
+ * \param handler is called for each ASDU with reported information objects
+ * \param parameter user provided parameter that is passed to the handler
+ *
+ * \return the number of ASDUs passed to the handler (0 when no information object is reported)
+ */
+int
+CS101_EventFilter_apply(CS101_EventFilter self, CS101_ASDU asdu, CS101_EventFilter_ASDUHandler handler, void* parameter);
+
+/**
+ * \brief Forget the last reported values of all points. The next event of each point is reported.
+ */
+void
+CS101_EventFilter_reset(CS101_EventFilter self);
+
+/**
+ * \brief Destroy the event filter
+ *
+ * NOTE: The slave that uses the filter has to be destroyed before.
+ */
+void
+CS101_EventFilter_destroy(CS101_EventFilter self);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_API_CS101_EVENT_FILTER_H_ */
@@ -0,0 +1,343 @@
+/*
+ *  cs101_file_service.h
+ *
+ *  Copyright 2017 MZ Automation GmbH
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+/**
+ * \file cs101_file_service.h
+ * \brief File transfer in control and monitor direction (IEC 60870-5-101 7.4.11)
+ */
+
+#ifndef SRC_INC_API_CS101_FILE_SERVICE_H_
+#define SRC_INC_API_CS101_FILE_SERVICE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "iec60870_common.h"
+#include "iec60870_slave.h"
+#include "cs104_connection.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup COMMON Common API functions
+ *
+ * @{
+ */
+
+/**
+ * @defgroup CS101_FILE_SERVICE File transfer service
+ *
+ * The file server (slave side) and the file client (master side) handle the complete
+ * select, call, segment and acknowledge sequence of the file transfer in monitor direction.
+ *
+ * The file server sends the segments of a section without waiting for the master. The number of
+ * segments in transit is only limited by the flow control of the connection (the k parameter of
+ * CS 104 or the class 1 queue of CS 101).
+ *
+ * The file data is not buffered by the service. The server reads the segments directly from the memory
+ * of the file (e.g. a memory mapped file) or with a read handler (e.g. pread on a file descriptor).
+ * The client passes the received segment data directly from the received message to a write handler.
+ *
+ * @{
+ */
+
+/**
+ * \brief State of a file transfer
+ */
+typedef enum
+{
+    CS101_FILE_TRANSFER_IN_PROGRESS = 0,
+    CS101_FILE_TRANSFER_SUCCESS = 1,
+    CS101_FILE_TRANSFER_FAILED = 2
+} CS101_FileTransferState;
+
+/**
+ * \brief Handler that is called when the state of a file transfer changes
+ *
+ * The handler is called for each transferred segment (state \ref CS101_FILE_TRANSFER_IN_PROGRESS) and when the transfer
+ * is finished.
+ *
+ * NOTE: The functions of the file server or file client must not be called by the handler.
+ *
+ * \param parameter user provided parameter
+ * \param ca common address of the file
+ * \param ioa information object address of the file
+ * \param nof name of file
+ * \param state the state of the transfer
+ * \param transferredBytes number of bytes of the file that have been transferred
+ * \param lengthOfFile length of the file
+ */
+typedef void (*CS101_FileTransferProgressHandler) (void* parameter, int ca, int ioa, uint16_t nof, CS101_FileTransferState state,
+        uint32_t transferredBytes, uint32_t lengthOfFile);
+
+/**
+ * \brief Handler to read the data of a file (e.g. with pread from a file descriptor)
+ *
+ * \param parameter user provided parameter
+ * \param offset position in the file
+ * \param buffer buffer where to store the data
+ * \param size number of bytes to read
+ *
+ * \return number of bytes read (has to be size), -1 in case of an error
+ */
+typedef int (*CS101_FileReadHandler) (void* parameter, uint32_t offset, uint8_t* buffer, int size);
+
+/**
+ * \brief Handler to store the data of a file (e.g. with pwrite to a file descriptor)
+ *
+ * NOTE: When a section is repeated because of a checksum error the same offset is written again.
+ *
+ * \param parameter user provided parameter
+ * \param offset position in the file
+ * \param data the received data (only valid while the handler is running)
+ * \param size number of bytes
+ *
+ * \return true when the data has been stored, false to abort the file transfer
+ */
+typedef bool (*CS101_FileWriteHandler) (void* parameter, uint32_t offset, const uint8_t* data, int size);
+
+/**
+ * @defgroup CS101_FILE_SERVER File server
+ *
+ * Provides files to the master. The file server is added to a \ref CS104_Slave or \ref CS101_Slave as a plugin
+ * (see \ref CS101_FileServer_getSlavePlugin).
+ *
+ * @{
+ */
+
+typedef struct sCS101_FileServer* CS101_FileServer;
+
+/**
+ * \brief Create a new file server instance
+ *
+ * \return the new file server instance
+ */
+CS101_FileServer
+CS101_FileServer_create(void);
+
+/**
+ * \brief Set the maximum length of a section (default is 65535)
+ *
+ * A file can have up to 255 sections. For larger files the section length is increased.
+ *
+ * \param sectionSize the maximum length of a section in bytes
+ */
+void
+CS101_FileServer_setSectionSize(CS101_FileServer self, uint32_t sectionSize);
+
+/**
+ * \brief Set the time the file server waits for the next request of the master (default is 30000 ms)
+ *
+ * \param timeoutInMs the timeout in ms
+ */
+void
+CS101_FileServer_setTimeout(CS101_FileServer self, int timeoutInMs);
+
+/**
+ * \brief Set a handler that is called when the state of a file transfer changes
+ */
+void
+CS101_FileServer_setProgressHandler(CS101_FileServer self, CS101_FileTransferProgressHandler handler, void* parameter);
+
+/**
+ * \brief Add a file that is stored in memory (e.g. a memory mapped file)
+ *
+ * The segments are sent directly from the memory of the file.
+ *
+ * \param ca common address of the file
+ * \param ioa information object address of the file
+ * \param nof name of file (e.g. \ref CS101_NOF_TRANSPARENT_FILE)
+ * \param data the content of the file. Has to be valid until the file is removed.
+ * \param lengthOfFile the length of the file (max. 16777215 bytes)
+ *
+ * \return true when the file has been added, false otherwise (file too large or address already used)
+ */
+bool
+CS101_FileServer_addFile(CS101_FileServer self, int ca, int ioa, uint16_t nof, const uint8_t* data, uint32_t lengthOfFile);
+
+/**
+ * \brief Add a file that is read with a read handler (e.g. from a file descriptor)
+ *
+ * \param ca common address of the file
+ * \param ioa information object address of the file
+ * \param nof name of file (e.g. \ref CS101_NOF_TRANSPARENT_FILE)
+ * \param lengthOfFile the length of the file (max. 16777215 bytes)
+ * \param handler the read handler
+ * \param parameter user provided parameter for the read handler
+ *
+ * \return true when the file has been added, false otherwise (file too large or address already used)
+ */
+bool
+CS101_FileServer_addFileWithReader(CS101_FileServer self, int ca, int ioa, uint16_t nof, uint32_t lengthOfFile,
+        CS101_FileReadHandler handler, void* parameter);
+
+/**
+ * \brief Remove a file. Running transfers of the file are aborted.
+ *
+ * \param ca common address of the file
+ * \param ioa information object address of the file
+ */
+void
+CS101_FileServer_removeFile(CS101_FileServer self, int ca, int ioa);
+
+/**
+ * \brief Get the plugin interface of the file server
+ *
+ * The plugin has to be added to the slave with \ref CS104_Slave_addPlugin or \ref CS101_Slave_addPlugin.
+ */
+CS101_SlavePlugin
+CS101_FileServer_getSlavePlugin(CS101_FileServer self);
+
+/**
+ * \brief Destroy the file server
+ *
+ * NOTE: The slave that uses the file server has to be stopped and destroyed before.
+ */
+void
+CS101_FileServer_destroy(CS101_FileServer self);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup CS101_FILE_CLIENT File client
+ *
+ * Requests files from a slave. The application has to forward the received ASDUs to
+ * \ref CS101_FileClient_handleASDU.
+ *
+ * @{
+ */
+
+typedef struct sCS101_FileClient* CS101_FileClient;
+
+/**
+ * \brief Handler that is used by the file client to send an ASDU
+ *
+ * \return true when the ASDU has been sent or queued for transmission, false otherwise
+ */
+typedef bool (*CS101_FileClientSendHandler) (void* parameter, CS101_ASDU asdu);
+
+/**
+ * \brief Create a new file client instance
+ *
+ * \param alParameters the application layer parameters of the connection
+ * \param sendHandler handler to send the requests of the file client
+ * \param parameter user provided parameter for the send handler
+ *
+ * \return the new file client instance
+ */
+CS101_FileClient
+CS101_FileClient_create(CS101_AppLayerParameters alParameters, CS101_FileClientSendHandler sendHandler, void* parameter);
+
+/**
+ * \brief Create a new file client instance that sends the requests over a CS 104 connection
+ *
+ * \param connection the connection (has to be valid until the file client is destroyed)
+ *
+ * \return the new file client instance
+ */
+CS101_FileClient
+CS101_FileClient_createForCS104Connection(CS104_Connection connection);
+
+/**
+ * \brief Set the time the file client waits for the next message of the slave (default is 30000 ms)
+ *
+ * \param timeoutInMs the timeout in ms
+ */
+void
+CS101_FileClient_setTimeout(CS101_FileClient self, int timeoutInMs);
+
+/**
+ * \brief Set a handler that is called when the state of a file transfer changes
+ */
+void
+CS101_FileClient_setProgressHandler(CS101_FileClient self, CS101_FileTransferProgressHandler handler, void* parameter);
+
+/**
+ * \brief Start to transfer a file from the slave
+ *
+ * \param ca common address of the file
+ * \param ioa information object address of the file
+ * \param nof name of file
+ * \param handler handler to store the received data
+ * \param parameter user provided parameter for the write handler
+ *
+ * \return true when the file has been requested, false otherwise (e.g. another transfer is running)
+ */
+bool
+CS101_FileClient_getFile(CS101_FileClient self, int ca, int ioa, uint16_t nof, CS101_FileWriteHandler handler, void* parameter);
+
+/**
+ * \brief Handle a received ASDU
+ *
+ * Has to be called by the ASDU received handler of the connection.
+ *
+ * \return true when the ASDU belongs to the running file transfer, false otherwise
+ */
+bool
+CS101_FileClient_handleASDU(CS101_FileClient self, CS101_ASDU asdu);
+
+/**
+ * \brief Check the timeout of the running file transfer. Has to be called periodically.
+ */
+void
+CS101_FileClient_run(CS101_FileClient self);
+
+/**
+ * \brief Check if a file transfer is running
+ */
+bool
+CS101_FileClient_isBusy(CS101_FileClient self);
+
+/**
+ * \brief Abort the running file transfer
+ */
+void
+CS101_FileClient_abort(CS101_FileClient self);
+
+/**
+ * \brief Destroy the file client
+ */
+void
+CS101_FileClient_destroy(CS101_FileClient self);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_API_CS101_FILE_SERVICE_H_ */
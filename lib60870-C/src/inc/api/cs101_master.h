@@ -31,7 +31,10 @@
 #define SRC_INC_API_CS101_MASTER_H_
 
 #include "iec60870_master.h"
+#include "hal_serial.h"
 #include "link_layer_parameters.h"
+#include "hal_thread.h"
+#include "cs101_transport.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -54,6 +57,19 @@ extern "C" {
  */
 typedef struct sCS101_Master* CS101_Master;
 
+/**
+ * \brief Callback handler that is called when the transmission of an ASDU is finished (only unbalanced mode)
+ *
+ * The CS101_ASDU object that is passed is only valid in the context of the callback function.
+ *
+ * \param parameter user provided parameter
+ * \param address link layer address of the slave
+ * \param asdu the ASDU that has been sent
+ * \param confirmed true when the slave confirmed the ASDU, false when the ASDU was rejected by the slave or
+ *        dropped because the link to the slave failed
+ */
+typedef void (*CS101_ASDUSentHandler) (void* parameter, int address, CS101_ASDU asdu, bool confirmed);
+
 /**
  * \brief Create a new master instance
  *
@@ -82,6 +98,21 @@ CS101_Master
 CS101_Master_createEx(SerialPort serialPort, LinkLayerParameters llParameters, CS101_AppLayerParameters alParameters, IEC60870_LinkLayerMode linkLayerMode,
         int queueSize);
 
+/**
+ * \brief Create a new master instance that uses a transport instead of a serial port
+ *
+ * \param transport the transport functions (will be copied), e.g. an endpoint of a \ref CS101_VirtualLine
+ * \param llParameters the link layer parameters to use
+ * \param alParameters the application layer parameters to use
+ * \param mode the link layer mode (either IEC60870_LINK_LAYER_BALANCED or IEC60870_LINK_LAYER_UNBALANCED)
+ * \param queueSize set the message queue size (only for balanced mode)
+ *
+ * \return the new CS101_Master instance
+ */
+CS101_Master
+CS101_Master_createWithTransport(CS101_Transport transport, LinkLayerParameters llParameters, CS101_AppLayerParameters alParameters,
+        IEC60870_LinkLayerMode linkLayerMode, int queueSize);
+
 /**
  * \brief Receive a new message and run the protocol state machine(s).
  *
@@ -91,6 +122,17 @@ CS101_Master_createEx(SerialPort serialPort, LinkLayerParameters llParameters, C
 void
 CS101_Master_run(CS101_Master self);
 
+/**
+ * \brief Set CPU affinity, scheduling policy, and name of the background thread
+ *
+ * NOTE: Has to be called before \ref CS101_Master_start. Requires threads.
+ *
+ * \param self CS101_Master instance
+ * \param attributes the thread attributes (will be copied)
+ */
+void
+CS101_Master_setThreadAttributes(CS101_Master self, ThreadAttributes attributes);
+
 /**
  * \brief Start a background thread that handles the link layer connections
  *
@@ -137,6 +179,35 @@ CS101_Master_addSlave(CS101_Master self, int address);
 void
 CS101_Master_pollSingleSlave(CS101_Master self, int address);
 
+/**
+ * \brief Set the intervals of the cyclic class 1 and class 2 requests of a slave (only unbalanced mode)
+ *
+ * The link layer requests the class 1 or class 2 data of the slave automatically when the interval
+ * elapsed. A slave that indicates available class 1 data (ACD bit) is requested for class 1 data
+ * immediately without waiting for the interval.
+ *
+ * NOTE: The slave has to be added with \ref CS101_Master_addSlave before.
+ *
+ * \param address the link layer address of the slave
+ * \param class1IntervalInMs interval of the class 1 requests in ms (0 = no cyclic requests)
+ * \param class2IntervalInMs interval of the class 2 requests in ms (0 = no cyclic requests - default)
+ */
+void
+CS101_Master_setSlavePollIntervals(CS101_Master self, int address, int class1IntervalInMs, int class2IntervalInMs);
+
+/**
+ * \brief Set the retry delay for slaves that don't respond (only unbalanced mode)
+ *
+ * A slave that doesn't respond is not polled until the retry delay elapsed. The delay starts with
+ * the minimum value and is doubled with each failed retry until the maximum value is reached. This
+ * way slaves that are offline don't consume the time slices of the working slaves.
+ *
+ * \param minDelayInMs initial retry delay in ms (default 1000)
+ * \param maxDelayInMs maximum retry delay in ms (default 60000)
+ */
+void
+CS101_Master_setSlaveRetryDelay(CS101_Master self, int minDelayInMs, int maxDelayInMs);
+
 /**
  * \brief Destroy the master instance and release all resources
  */
@@ -195,8 +266,8 @@ CS101_Master_getLinkLayerParameters(CS101_Master self);
 /**
  * \brief Is the channel ready to transmit an ASDU (only unbalanced mode)
  *
- * The function will return true when the channel (slave) transmit buffer
- * is empty.
+ * The function will return true when the transmit queue of the channel (slave)
+ * has space for another ASDU.
  *
  * \param address slave address of the recipient
  *
@@ -285,13 +356,27 @@ CS101_Master_sendProcessCommand(CS101_Master self, CS101_CauseOfTransmission cot
  *
  * NOTE: The ASDU is put into a message queue and will be sent whenever
  * the link layer state machine is able to transmit the ASDU. The ASDUs will
- * be sent in the order they are put into the queue.
+ * be sent in the order they are put into the queue. In unbalanced mode each slave
+ * has its own queue and process commands are sent before other queued ASDUs. When
+ * the queue of the slave is full the ASDU is dropped (see \ref CS101_Master_isChannelReady).
  *
  * \param asdu the ASDU to send
  */
 void
 CS101_Master_sendASDU(CS101_Master self, CS101_ASDU asdu);
 
+/**
+ * \brief Register a callback handler that is called when a queued ASDU is confirmed or dropped (only unbalanced mode)
+ *
+ * NOTE: The queued ASDUs of a slave are dropped when the link to the slave fails. This way
+ * outdated commands are not sent when the slave is available again.
+ *
+ * \param handler user provided callback handler function
+ * \param parameter user provided parameter that is passed to the callback handler
+ */
+void
+CS101_Master_setASDUSentHandler(CS101_Master self, CS101_ASDUSentHandler handler, void* parameter);
+
 /**
  * \brief Register a callback handler for received ASDUs
  *
@@ -327,6 +412,22 @@ CS101_Master_setRawMessageHandler(CS101_Master self, IEC60870_RawMessageHandler
 void
 CS101_Master_setIdleTimeout(CS101_Master self, int timeoutInMs);
 
+/**
+ * \brief Derive the link layer timeouts from the measured response times
+ *
+ * When enabled the timeout for the link layer ACK is calculated from the smoothed response time
+ * of the slave (other station) and its deviation instead of using the fixed timeoutForAck value
+ * of the link layer parameters. In unbalanced mode the response times are measured for each slave.
+ * The timeout for repeated transmissions keeps the configured ratio of timeoutRepeat to timeoutForAck.
+ * The fixed values are used until the first response is received.
+ *
+ * \param enable true to enable adaptive timeouts, false to use the fixed timeouts (default)
+ * \param minTimeoutInMs lower limit of the ACK timeout in milliseconds
+ * \param maxTimeoutInMs upper limit of the ACK timeout in milliseconds
+ */
+void
+CS101_Master_setAdaptiveTimeouts(CS101_Master self, bool enable, int minTimeoutInMs, int maxTimeoutInMs);
+
 /**
  * @}
  */
@@ -0,0 +1,251 @@
+/*
+ *  cs101_process_image.h
+ *
+ *  Copyright 2017 MZ Automation GmbH
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+/**
+ * \file cs101_process_image.h
+ * \brief Process image of a slave (point database) with automatic interrogation and read responses
+ */
+
+#ifndef SRC_INC_API_CS101_PROCESS_IMAGE_H_
+#define SRC_INC_API_CS101_PROCESS_IMAGE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "iec60870_common.h"
+#include "iec60870_slave.h"
+#include "cs101_information_objects.h"
+#include "cs101_slave.h"
+#include "cs104_slave.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup SLAVE Slave related functions
+ *
+ * @{
+ */
+
+/**
+ * @defgroup CS101_PROCESS_IMAGE Process image
+ *
+ * The process image stores the current values of the monitoring points of one common address (CA).
+ *
+ * The process image answers the station and group interrogation commands (C_IC_NA_1 - QOI 20 to 36) and read
+ * commands (C_RD_NA_1) without involvement of the application. The interrogation responses are packed into
+ * sequence ASDUs when the IOAs of the points are consecutive and are sent as fast as the connection can take them.
+ *
+ * When the value or the quality of a point is updated a spontaneous event is created.
+ *
+ * Supported point types (type of the interrogation response/type of the event):
+ * - M_SP_NA_1/M_SP_TB_1 single point information
+ * - M_DP_NA_1/M_DP_TB_1 double point information
+ * - M_ST_NA_1/M_ST_TB_1 step position information
+ * - M_BO_NA_1/M_BO_TB_1 bitstring of 32 bit
+ * - M_ME_NA_1/M_ME_TD_1 measured value, normalized value
+ * - M_ME_NB_1/M_ME_TE_1 measured value, scaled value
+ * - M_ME_NC_1/M_ME_TF_1 measured value, short floating point value
+ *
+ * @{
+ */
+
+typedef struct sCS101_ProcessImage* CS101_ProcessImage;
+
+/**
+ * \brief Handler that is called with the spontaneous events of the process image
+ *
+ * \param parameter user provided parameter
+ * \param asdu the event (only valid while the handler is running)
+ */
+typedef void (*CS101_ProcessImageEventHandler) (void* parameter, CS101_ASDU asdu);
+
+/**
+ * \brief Create a new (empty) process image
+ *
+ * \param ca the common address of the points
+ *
+ * \return the new process image instance
+ */
+CS101_ProcessImage
+CS101_ProcessImage_create(int ca);
+
+/**
+ * \brief Add a range of points with consecutive IOAs
+ *
+ * The points are initialized with value 0 and quality \ref IEC60870_QUALITY_INVALID.
+ *
+ * NOTE: Points should be added before the slave is started. Adding points is faster when the IOAs are
+ * added in ascending order.
+ *
+ * \param type the type of the interrogation response of the points (e.g. M_SP_NA_1)
+ * \param firstIoa IOA of the first point
+ * \param numberOfPoints number of points
+ * \param groups interrogation groups of the points (bit 0 - group 1 ... bit 15 - group 16)
+ *
+ * \return true when the points have been added, false otherwise (unsupported type or IOA already used)
+ */
+bool
+CS101_ProcessImage_addPoints(CS101_ProcessImage self, TypeID type, int firstIoa, int numberOfPoints, uint16_t groups);
+
+/**
+ * \brief Get the number of points of the process image
+ */
+int
+CS101_ProcessImage_getNumberOfPoints(CS101_ProcessImage self);
+
+/**
+ * \brief Set if the spontaneous events contain a CP56Time2a time tag (default is true)
+ */
+void
+CS101_ProcessImage_setEventsWithTimeTag(CS101_ProcessImage self, bool withTimeTag);
+
+/**
+ * \brief Set the handler that gets the spontaneous events
+ *
+ * NOTE: Is set by \ref CS101_ProcessImage_attachToCS104Slave and \ref CS101_ProcessImage_attachToCS101Slave
+ *
+ * \param alParameters the application layer parameters used to encode the events
+ * \param handler the event handler
+ * \param parameter user provided parameter for the event handler
+ */
+void
+CS101_ProcessImage_setEventHandler(CS101_ProcessImage self, CS101_AppLayerParameters alParameters,
+        CS101_ProcessImageEventHandler handler, void* parameter);
+
+/**
+ * \brief Get the plugin interface of the process image
+ *
+ * NOTE: Is added by \ref CS101_ProcessImage_attachToCS104Slave and \ref CS101_ProcessImage_attachToCS101Slave
+ */
+CS101_SlavePlugin
+CS101_ProcessImage_getSlavePlugin(CS101_ProcessImage self);
+
+/**
+ * \brief Use the process image for a CS 104 slave
+ *
+ * The process image is added as plugin and the events are sent with \ref CS104_Slave_enqueueASDU.
+ */
+void
+CS101_ProcessImage_attachToCS104Slave(CS101_ProcessImage self, CS104_Slave slave);
+
+/**
+ * \brief Use the process image for a CS 101 slave
+ *
+ * The process image is added as plugin and the events are sent as class 1 data.
+ */
+void
+CS101_ProcessImage_attachToCS101Slave(CS101_ProcessImage self, CS101_Slave slave);
+
+/**
+ * \brief Update a single point (M_SP_NA_1)
+ *
+ * \param timestamp time tag of the event. NULL to use the current time.
+ *
+ * \return true when the point exists, false otherwise
+ */
+bool
+CS101_ProcessImage_updateSinglePoint(CS101_ProcessImage self, int ioa, bool value, QualityDescriptor quality, CP56Time2a timestamp);
+
+/**
+ * \brief Update a double point (M_DP_NA_1)
+ *
+ * \param timestamp time tag of the event. NULL to use the current time.
+ *
+ * \return true when the point exists, false otherwise
+ */
+bool
+CS101_ProcessImage_updateDoublePoint(CS101_ProcessImage self, int ioa, DoublePointValue value, QualityDescriptor quality, CP56Time2a timestamp);
+
+/**
+ * \brief Update a step position (M_ST_NA_1)
+ *
+ * \param timestamp time tag of the event. NULL to use the current time.
+ *
+ * \return true when the point exists, false otherwise
+ */
+bool
+CS101_ProcessImage_updateStepPosition(CS101_ProcessImage self, int ioa, int value, bool isTransient, QualityDescriptor quality, CP56Time2a timestamp);
+
+/**
+ * \brief Update a bitstring (M_BO_NA_1)
+ *
+ * \param timestamp time tag of the event. NULL to use the current time.
+ *
+ * \return true when the point exists, false otherwise
+ */
+bool
+CS101_ProcessImage_updateBitString32(CS101_ProcessImage self, int ioa, uint32_t value, QualityDescriptor quality, CP56Time2a timestamp);
+
+/**
+ * \brief Update a normalized measured value (M_ME_NA_1)
+ *
+ * \param timestamp time tag of the event. NULL to use the current time.
+ *
+ * \return true when the point exists, false otherwise
+ */
+bool
+CS101_ProcessImage_updateMeasuredValueNormalized(CS101_ProcessImage self, int ioa, float value, QualityDescriptor quality, CP56Time2a timestamp);
+
+/**
+ * \brief Update a scaled measured value (M_ME_NB_1)
+ *
+ * \param timestamp time tag of the event. NULL to use the current time.
+ *
+ * \return true when the point exists, false otherwise
+ */
+bool
+CS101_ProcessImage_updateMeasuredValueScaled(CS101_ProcessImage self, int ioa, int value, QualityDescriptor quality, CP56Time2a timestamp);
+
+/**
+ * \brief Update a short floating point measured value (M_ME_NC_1)
+ *
+ * \param timestamp time tag of the event. NULL to use the current time.
+ *
+ * \return true when the point exists, false otherwise
+ */
+bool
+CS101_ProcessImage_updateMeasuredValueShort(CS101_ProcessImage self, int ioa, float value, QualityDescriptor quality, CP56Time2a timestamp);
+
+/**
+ * \brief Destroy the process image
+ *
+ * NOTE: The slave that uses the process image has to be stopped and destroyed before.
+ */
+void
+CS101_ProcessImage_destroy(CS101_ProcessImage self);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_API_CS101_PROCESS_IMAGE_H_ */
@@ -31,9 +31,11 @@
  */
 
 #include "hal_serial.h"
+#include "hal_thread.h"
 #include "iec60870_common.h"
 #include "iec60870_slave.h"
 #include "link_layer_parameters.h"
+#include "cs101_transport.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -58,6 +60,17 @@ extern "C" {
  */
 typedef struct sCS101_Slave* CS101_Slave;
 
+/**
+ * \brief Handler that is called when ASDUs have been removed from a full class 1/2 data queue
+ *
+ * NOTE: The handler is called in the context of the enqueue function.
+ *
+ * \param parameter user provided parameter
+ * \param dataClass the data class of the queue (1 or 2)
+ * \param droppedASDUs number of (oldest) ASDUs that have been removed to store the new ASDU
+ */
+typedef void (*CS101_SlaveQueueOverflowHandler) (void* parameter, int dataClass, int droppedASDUs);
+
 /**
  * \brief Create a new balanced or unbalanced CS101 slave
  *
@@ -86,20 +99,65 @@ CS101_Slave_create(SerialPort serialPort, LinkLayerParameters llParameters, CS10
  * \param class1QueueSize size of the class1 data queue
  * \param class2QueueSize size of the class2 data queue
  *
+ * NOTE: The queue size is the number of ASDUs of maximum size. The queues only use the memory
+ * required by the encoded ASDUs so they can store more ASDUs of a typical size.
+ *
  * \return the new slave instance
  */
 CS101_Slave
 CS101_Slave_createEx(SerialPort serialPort, LinkLayerParameters llParameters, CS101_AppLayerParameters alParameters, IEC60870_LinkLayerMode linkLayerMode,
         int class1QueueSize, int class2QueueSize);
 
+/**
+ * \brief Create a new balanced or unbalanced CS101 slave that uses a transport instead of a serial port
+ *
+ * \param transport the transport functions (will be copied), e.g. an endpoint of a \ref CS101_VirtualLine
+ * \param llParameters the link layer parameters to be used
+ * \param alParameters the CS101 application layer parameters
+ * \param linkLayerMode the link layer mode (either BALANCED or UNBALANCED)
+ * \param class1QueueSize size of the class1 data queue
+ * \param class2QueueSize size of the class2 data queue
+ *
+ * \return the new slave instance
+ */
+CS101_Slave
+CS101_Slave_createWithTransport(CS101_Transport transport, LinkLayerParameters llParameters, CS101_AppLayerParameters alParameters,
+        IEC60870_LinkLayerMode linkLayerMode, int class1QueueSize, int class2QueueSize);
+
 /**
  * \brief Destroy the slave instance and cleanup all resources
  *
+ * NOTE: A logical slave (see \ref CS101_Slave_addLogicalSlave) can be destroyed while its parent slave is
+ * running. It must not be destroyed by a callback handler of the slave.
+ *
  * \param self CS101_Slave instance
  */
 void
 CS101_Slave_destroy(CS101_Slave self);
 
+/**
+ * \brief Add a logical slave that answers the requests for another link layer address on the serial line of this slave
+ *
+ * This way a single serial port can emulate many outstations of a multidrop line (e.g. for test benches or
+ * protocol converters). Each logical slave has its own class 1 and class 2 data queues, callback handlers and
+ * plugins and is configured with the CS101_Slave functions. The link layer of this slave dispatches the received
+ * requests by the link layer address.
+ *
+ * The logical slave is created with a copy of the link layer and application layer parameters of this slave.
+ *
+ * NOTE: Only supported in unbalanced mode. Has to be called before the slave is started. The logical slave must not be
+ * started or added to a channel group - it is handled by \ref CS101_Slave_run of this slave. The link layer address
+ * of the logical slave cannot be changed. The logical slave is destroyed together with this slave.
+ *
+ * \param linkLayerAddress the link layer address of the logical slave
+ * \param class1QueueSize size of the class1 data queue
+ * \param class2QueueSize size of the class2 data queue
+ *
+ * \return the new logical slave, or NULL when the address is already used or the slave is in balanced mode
+ */
+CS101_Slave
+CS101_Slave_addLogicalSlave(CS101_Slave self, int linkLayerAddress, int class1QueueSize, int class2QueueSize);
+
 /**
  * \brief Set the value of the DIR bit when sending messages (only balanced mode)
  *
@@ -130,6 +188,19 @@ CS101_Slave_addPlugin(CS101_Slave self, CS101_SlavePlugin plugin);
 void
 CS101_Slave_setIdleTimeout(CS101_Slave self, int timeoutInMs);
 
+/**
+ * \brief Derive the link layer timeouts from the measured response times (only balanced mode)
+ *
+ * When enabled the timeout for the link layer ACK is calculated from the smoothed response time
+ * of the other station and its deviation instead of using the fixed timeoutForAck value.
+ *
+ * \param enable true to enable adaptive timeouts, false to use the fixed timeouts (default)
+ * \param minTimeoutInMs lower limit of the ACK timeout in milliseconds
+ * \param maxTimeoutInMs upper limit of the ACK timeout in milliseconds
+ */
+void
+CS101_Slave_setAdaptiveTimeouts(CS101_Slave self, bool enable, int minTimeoutInMs, int maxTimeoutInMs);
+
 /**
  * \brief Set a callback handler for link layer state changes
  */
@@ -201,6 +272,20 @@ CS101_Slave_enqueueUserDataClass2(CS101_Slave self, CS101_ASDU asdu);
 void
 CS101_Slave_flushQueues(CS101_Slave self);
 
+/**
+ * \brief Set a handler that is called when a data queue overflows
+ *
+ * When there is not enough space in a queue for a new ASDU the oldest ASDUs are removed.
+ *
+ * NOTE: Periodic and background scan ASDUs with a single value without time tag replace a queued
+ * ASDU of the same information object instead of being added to the queue.
+ *
+ * \param handler the callback handler function
+ * \param parameter user provided parameter to be passed to the callback handler
+ */
+void
+CS101_Slave_setQueueOverflowHandler(CS101_Slave self, CS101_SlaveQueueOverflowHandler handler, void* parameter);
+
 /**
  * \brief Receive a new message and run the link layer state machines
  *
@@ -212,6 +297,17 @@ CS101_Slave_flushQueues(CS101_Slave self);
 void
 CS101_Slave_run(CS101_Slave self);
 
+/**
+ * \brief Set CPU affinity, scheduling policy, and name of the background thread
+ *
+ * NOTE: Has to be called before \ref CS101_Slave_start. Requires threads.
+ *
+ * \param self CS101_Slave instance
+ * \param attributes the thread attributes (will be copied)
+ */
+void
+CS101_Slave_setThreadAttributes(CS101_Slave self, ThreadAttributes attributes);
+
 /**
  * \brief Start a background thread that handles the link layer connections
  *
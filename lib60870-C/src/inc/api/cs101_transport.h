@@ -0,0 +1,180 @@
+/*
+ *  cs101_transport.h
+ *
+ *  Copyright 2017 MZ Automation GmbH
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+/**
+ * \file cs101_transport.h
+ * \brief Byte stream transport of the CS 101 link layer (serial port replacement).
+ */
+
+#ifndef SRC_INC_API_CS101_TRANSPORT_H_
+#define SRC_INC_API_CS101_TRANSPORT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup COMMON Common API functions
+ *
+ * @{
+ */
+
+/**
+ * @defgroup CS101_TRANSPORT CS 101 transport interface
+ *
+ * By default the CS 101 link layer uses a \ref SerialPort. A transport can be used instead
+ * to run the link layer over a different byte stream (e.g. a pseudo terminal, a terminal server
+ * or the in-memory \ref CS101_VirtualLine for tests and benchmarks).
+ *
+ * @{
+ */
+
+typedef struct sCS101_Transport* CS101_Transport;
+
+/**
+ * \brief Functions that the link layer uses to access the byte stream
+ */
+struct sCS101_Transport {
+
+    /**
+     * \brief Read the received bytes
+     *
+     * Waits up to timeoutInMs for the first byte and returns all bytes that are available.
+     *
+     * \return number of bytes read (0 when the timeout elapsed), -1 in case of an error
+     */
+    int (*readBytes) (void* parameter, uint8_t* buffer, int maxSize, int timeoutInMs);
+
+    /**
+     * \brief Send bytes
+     *
+     * \return number of bytes sent, -1 in case of an error
+     */
+    int (*write) (void* parameter, uint8_t* buffer, int numberOfBytes);
+
+    /**
+     * \brief Get the (simulated) baud rate. Used to calculate the transmission time of a frame.
+     */
+    int (*getBaudRate) (void* parameter);
+
+    /**
+     * \brief Get the number of bits of a character (start bit, data bits, parity bit and stop bits).
+     * Used to calculate the transmission time of a frame. Can be NULL (11 bits per character - 8E1).
+     */
+    int (*getBitsPerCharacter) (void* parameter);
+
+    /** parameter that is passed to the transport functions */
+    void* parameter;
+};
+
+/**
+ * @defgroup CS101_VIRTUAL_LINE In-memory serial line
+ *
+ * A virtual line connects the transports of multiple masters and slaves inside a single process
+ * without serial hardware. Like a real party line every byte sent by one endpoint is received
+ * by all other endpoints. The line simulates the transmission time for the configured baud rate,
+ * an additional latency and corrupted bytes.
+ *
+ * NOTE: Channels that use a virtual line cannot be monitored by a \ref CS101_ChannelGroup
+ * without polling, because there is no file descriptor to wait for.
+ *
+ * @{
+ */
+
+typedef struct sCS101_VirtualLine* CS101_VirtualLine;
+
+/**
+ * \brief Create a new virtual line
+ *
+ * \param baudRate the simulated baud rate (8E1 - 11 bits per character). 0 to send without delay.
+ *
+ * \return the new virtual line instance
+ */
+CS101_VirtualLine
+CS101_VirtualLine_create(int baudRate);
+
+/**
+ * \brief Set an additional delay until sent bytes are received by the other endpoints (e.g. for modems or radio links)
+ *
+ * \param latencyInMs the latency in ms (default is 0)
+ */
+void
+CS101_VirtualLine_setLatency(CS101_VirtualLine self, int latencyInMs);
+
+/**
+ * \brief Corrupt bytes randomly (a single bit of the byte is toggled)
+ *
+ * \param errorsPerMillion average number of corrupted bytes per one million bytes (default is 0)
+ * \param seed start value of the pseudo random number generator (to reproduce a test run)
+ */
+void
+CS101_VirtualLine_setErrorRate(CS101_VirtualLine self, int errorsPerMillion, uint32_t seed);
+
+/**
+ * \brief Add a new endpoint to the line
+ *
+ * \return the transport of the endpoint. Is valid until the line is destroyed.
+ */
+CS101_Transport
+CS101_VirtualLine_addEndpoint(CS101_VirtualLine self);
+
+/**
+ * \brief Get the number of bytes that have been sent over the line
+ */
+uint64_t
+CS101_VirtualLine_getSentBytes(CS101_VirtualLine self);
+
+/**
+ * \brief Get the number of bytes that have been corrupted by the line
+ */
+uint64_t
+CS101_VirtualLine_getCorruptedBytes(CS101_VirtualLine self);
+
+/**
+ * \brief Destroy the virtual line and all of its endpoints
+ *
+ * NOTE: The masters and slaves that use the endpoints have to be stopped and destroyed before.
+ */
+void
+CS101_VirtualLine_destroy(CS101_VirtualLine self);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_API_CS101_TRANSPORT_H_ */
@@ -27,6 +27,8 @@
 
 #include "tls_config.h"
 #include "iec60870_master.h"
+#include "hal_thread.h"
+#include "hal_socket.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -65,6 +67,9 @@ CS104_Connection_create(const char* hostname, int tcpPort);
 /**
  * \brief Create a new secure connection object (uses TLS)
  *
+ * When session resumption is enabled in the TLS configuration (\ref TLSConfiguration_enableSessionResumption)
+ * a reconnect resumes the TLS session of the previous connection.
+ *
  * \param hostname host name of IP address of the server to connect
  * \param tcpPort tcp port of the server to connect. If set to -1 use default port (19998)
  * \param tlcConfig the TLS configuration (certificates, keys, and parameters)
@@ -126,6 +131,28 @@ CS104_Connection_getAppLayerParameters(CS104_Connection self);
 void
 CS104_Connection_setConnectTimeout(CS104_Connection self, int millies);
 
+/**
+ * \brief Set the TCP socket options (buffer sizes, TCP_NODELAY, TCP_USER_TIMEOUT, ...)
+ *
+ * The options are applied when the connection is established.
+ *
+ * \param self CS104_Connection instance
+ * \param options the socket options (will be copied)
+ */
+void
+CS104_Connection_setSocketOptions(CS104_Connection self, SocketOptions options);
+
+/**
+ * \brief Set CPU affinity, scheduling policy, and name of the connection handling thread
+ *
+ * NOTE: Has to be called before \ref CS104_Connection_connect or \ref CS104_Connection_connectAsync.
+ *
+ * \param self CS104_Connection instance
+ * \param attributes the thread attributes (will be copied)
+ */
+void
+CS104_Connection_setThreadAttributes(CS104_Connection self, ThreadAttributes attributes);
+
 /**
  * \brief non-blocking connect.
  *
@@ -25,6 +25,9 @@
 #define SRC_INC_API_CS104_SLAVE_H_
 
 #include "iec60870_slave.h"
+#include "cs101_event_filter.h"
+#include "hal_thread.h"
+#include "hal_socket.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -77,7 +80,8 @@ typedef enum {
     CS104_CON_EVENT_CONNECTION_OPENED = 0,
     CS104_CON_EVENT_CONNECTION_CLOSED = 1,
     CS104_CON_EVENT_ACTIVATED = 2,
-    CS104_CON_EVENT_DEACTIVATED = 3
+    CS104_CON_EVENT_DEACTIVATED = 3,
+    CS104_CON_EVENT_SLOW_CONSUMER = 4 /**< peer has not been reading data for the configured warning time */
 } CS104_PeerConnectionEvent;
 
 
@@ -105,6 +109,20 @@ typedef void (*CS104_ConnectionEventHandler) (void* parameter, IMasterConnection
  */
 typedef void (*CS104_SlaveRawMessageHandler) (void* parameter, IMasterConnection connection, uint8_t* msg, int msgSize, bool send);
 
+/**
+ * \brief Handler that is called when the master confirms sent ASDUs and the k window has free slots again
+ *
+ * The handler can be used to send the next ASDUs (e.g. with \ref IMasterConnection_sendASDU) without
+ * polling the state of the connection.
+ *
+ * NOTE: The handler is called by the thread that handles the connection.
+ *
+ * \param parameter user provided parameter
+ * \param connection the connection with the free window slots
+ * \param freeWindowSlots number of ASDUs that can be sent before the k window is full
+ */
+typedef void (*CS104_WindowOpenHandler) (void* parameter, IMasterConnection connection, int freeWindowSlots);
+
 
 /**
  * \brief Create a new instance of a CS104 slave (server)
@@ -170,6 +188,38 @@ CS104_Slave_getOpenConnections(CS104_Slave self);
 void
 CS104_Slave_setMaxOpenConnections(CS104_Slave self, int maxOpenConnections);
 
+/**
+ * \brief Set the TCP socket options for client connections
+ *
+ * The options (buffer sizes, TCP_NODELAY, TCP_USER_TIMEOUT, ...) are applied to each accepted
+ * connection. With corkBatches enabled the slave sends all ASDUs that are waiting in the queues
+ * (up to the k parameter) as a batch and corks the socket while doing so.
+ *
+ * \param self the slave instance
+ * \param options the socket options (will be copied)
+ */
+void
+CS104_Slave_setSocketOptions(CS104_Slave self, SocketOptions options);
+
+/**
+ * \brief Set the thresholds for the handling of slow consumers
+ *
+ * When a client does not read the data sent by the slave (TCP window is closed) the data is kept
+ * in a connection specific output buffer (CONFIG_CS104_SLAVE_OUTPUT_BUFFER_SIZE) and no more ASDUs
+ * are sent to the client. When the output is blocked for longer than the warning time the
+ * connection event CS104_CON_EVENT_SLOW_CONSUMER is raised. When the output is blocked for longer
+ * than the close time the connection is closed. The connection is always closed when the output
+ * buffer overflows.
+ *
+ * Default values: warning time 5000 ms, close time 0 (disabled)
+ *
+ * \param self the slave instance
+ * \param warningTimeInMs time until CS104_CON_EVENT_SLOW_CONSUMER is raised (0 = disabled)
+ * \param closeTimeInMs time until the connection is closed (0 = disabled)
+ */
+void
+CS104_Slave_setSlowConsumerThresholds(CS104_Slave self, int warningTimeInMs, int closeTimeInMs);
+
 /**
  * \brief Set one of the server modes
  *
@@ -209,6 +259,24 @@ CS104_Slave_setConnectionEventHandler(CS104_Slave self, CS104_ConnectionEventHan
 void
 CS104_Slave_setInterrogationHandler(CS104_Slave self, CS101_InterrogationHandler handler, void*  parameter);
 
+/**
+ * \brief Set a handler that provides the interrogation responses step by step (generator style)
+ *
+ * When set, the slave handles the interrogation commands (C_IC_NA_1) itself and the interrogation
+ * handler is not called. The ACT_CON and ACT_TERM messages are created by the slave. The handler is only
+ * called when the k window of the connection can take another ASDU. The response is not buffered in the
+ * queues of the slave and can have any size.
+ *
+ * Only one interrogation per connection can run at the same time. A new interrogation command
+ * restarts the response. A STOPDT or a deactivation command stops the running response.
+ *
+ * \param self the slave instance
+ * \param handler the callback function to be used (NULL to use the interrogation handler)
+ * \param parameter user provided context parameter that will be passed to the callback function (or NULL if not required).
+ */
+void
+CS104_Slave_setInterrogationStreamHandler(CS104_Slave self, CS101_InterrogationStreamHandler handler, void* parameter);
+
 void
 CS104_Slave_setCounterInterrogationHandler(CS104_Slave self, CS101_CounterInterrogationHandler handler, void*  parameter);
 
@@ -224,6 +292,15 @@ CS104_Slave_setASDUHandler(CS104_Slave self, CS101_ASDUHandler handler, void* pa
 void
 CS104_Slave_setClockSyncHandler(CS104_Slave self, CS101_ClockSynchronizationHandler handler, void* parameter);
 
+/**
+ * \brief Set the handler that is called when confirmations of the master open the k window
+ *
+ * \param handler user provided callback handler function
+ * \param parameter user provided parameter that is passed to the callback handler
+ */
+void
+CS104_Slave_setWindowOpenHandler(CS104_Slave self, CS104_WindowOpenHandler handler, void* parameter);
+
 /**
  * \brief Set the raw message callback (called when a message is sent or received)
  *
@@ -245,6 +322,32 @@ CS104_Slave_getConnectionParameters(CS104_Slave self);
 CS101_AppLayerParameters
 CS104_Slave_getAppLayerParameters(CS104_Slave self);
 
+/**
+ * \brief Set CPU affinity, scheduling policy, and name of the server (listening) thread
+ *
+ * NOTE: Has to be called before \ref CS104_Slave_start. Requires CONFIG_USE_THREADS = 1.
+ *
+ * \param self CS104_Slave instance
+ * \param attributes the thread attributes (will be copied)
+ */
+void
+CS104_Slave_setServerThreadAttributes(CS104_Slave self, ThreadAttributes attributes);
+
+/**
+ * \brief Set CPU affinity, scheduling policy, and name of the connection handling threads
+ *
+ * The connection handling threads belong to the pre-allocated connection objects. A thread is
+ * created for the first connection of its connection object and is reused for the following
+ * connections until the slave is destroyed. The attributes are applied to threads that are
+ * created afterwards, so they should be set before \ref CS104_Slave_start is called.
+ * Requires CONFIG_USE_THREADS = 1.
+ *
+ * \param self CS104_Slave instance
+ * \param attributes the thread attributes (will be copied)
+ */
+void
+CS104_Slave_setConnectionThreadAttributes(CS104_Slave self, ThreadAttributes attributes);
+
 /**
  * \brief Start the CS 104 slave. The slave (server) will listen on the configured TCP/IP port
  *
@@ -298,7 +401,10 @@ CS104_Slave_stopThreadless(CS104_Slave self);
  * \brief Protocol stack tick function for non-threaded mode.
  *
  * Handle incoming connection requests and messages, send buffered events, and
- * handle periodic tasks.
+ * handle periodic tasks. The function waits up to 1 ms for received data. On Linux the
+ * receive operations and the send operations of the previous tick are submitted for all
+ * connections with a single io_uring system call when the kernel supports it
+ * (see CONFIG_CS104_SLAVE_USE_IO_RING).
  *
  * NOTE: This function has to be called periodically by the application.
  */
@@ -325,6 +431,17 @@ CS104_Slave_getNumberOfQueueEntries(CS104_Slave self, CS104_RedundancyGroup redG
 void
 CS104_Slave_enqueueASDU(CS104_Slave self, CS101_ASDU asdu);
 
+/**
+ * \brief Set a filter for the ASDUs that are added with \ref CS104_Slave_enqueueASDU
+ *
+ * The filter removes spontaneous events without relevant changes (see \ref CS101_EVENT_FILTER)
+ * before they are stored in the queue.
+ *
+ * \param filter the event filter (NULL to disable the filter). Has to be valid until the slave is destroyed.
+ */
+void
+CS104_Slave_setEventFilter(CS104_Slave self, CS101_EventFilter filter);
+
 /**
  * \brief Add a new redundancy group to the server.
  *
@@ -71,6 +71,9 @@ struct sIMasterConnection {
     int (*getPeerAddress) (IMasterConnection self, char* addrBuf, int addrBufSize);
     CS101_AppLayerParameters (*getApplicationLayerParameters) (IMasterConnection self);
     void* object;
+
+    /* added at the end to keep the layout of the older members */
+    bool (*isReadyEx) (IMasterConnection self, int* freeWindowSlots, int* freeQueueBytes);
 };
 
 /*
@@ -89,6 +92,26 @@ struct sIMasterConnection {
 bool
 IMasterConnection_isReady(IMasterConnection self);
 
+/**
+ * \brief Check if the connection is ready to send an ASDU and get the remaining send capacity
+ *
+ * The capacity can be used to send as many ASDUs as the connection can take without checking the
+ * state before each ASDU.
+ *
+ * For CS 104 the free window slots are the number of ASDUs that can be sent before the k window is full.
+ * When the window is full (or older ASDUs are waiting) the ASDUs are stored in the high priority queue.
+ * For CS 101 the ASDUs are always stored in the class 1 queue (free window slots is always 0).
+ *
+ * \param self the connection object (this is usually received as a parameter of a callback function)
+ * \param[out] freeWindowSlots number of ASDUs that can be sent immediately (can be NULL)
+ * \param[out] freeQueueBytes free space in the queue in bytes. An ASDU requires its size plus 2 bytes (CS 104)
+ * or 1 byte (CS 101). (can be NULL)
+ *
+ * \returns true if the connection is ready to send an ASDU, false otherwise
+ */
+bool
+IMasterConnection_isReadyEx(IMasterConnection self, int* freeWindowSlots, int* freeQueueBytes);
+
 /**
  * \brief Send an ASDU to the client/master
  *
@@ -181,6 +204,11 @@ struct sCS101_SlavePlugin
     void (*runTask) (void* parameter, IMasterConnection connection);
 
     void* parameter;
+
+    /* added at the end to keep the layout of the older members. Is called when the connection is closed
+     * to release the connection specific state of the plugin (the connection object can be reused
+     * for the next client). Can be NULL. */
+    void (*connectionClosed) (void* parameter, IMasterConnection connection);
 };
 
 /**
@@ -207,6 +235,28 @@ typedef void (*CS101_ResetCUHandler) (void* parameter);
  */
 typedef bool (*CS101_InterrogationHandler) (void* parameter, IMasterConnection connection, CS101_ASDU asdu, uint8_t qoi);
 
+/**
+ * \brief Handler that provides the response of an interrogation command (C_IC_NA_1 - 100) step by step
+ *
+ * The handler is called by the stack whenever the connection can take another ASDU. It adds the next
+ * information objects of the response to the (empty) ASDU and remembers where to continue with the
+ * next call in the position parameter. The stack sends the ACT_CON before the first and the ACT_TERM
+ * after the last ASDU of the response.
+ *
+ * NOTE: The ASDU is only valid while the handler is running. The type ID of the ASDU is set by the first
+ * added information object. The ASDU can be changed to a sequence ASDU with \ref CS101_ASDU_setSequence before
+ * the first information object is added. An ASDU without information objects is not sent.
+ *
+ * \param parameter user provided parameter
+ * \param connection the connection that received the interrogation command
+ * \param qoi the qualifier of interrogation (20 - station interrogation, 21 to 36 - group 1 to 16)
+ * \param position position of the response (0 for the first call). Is only changed by the handler.
+ * \param asdu the ASDU for the next part of the response (COT, CA and OA are already set)
+ *
+ * \return true when more information objects follow, false when the response is complete
+ */
+typedef bool (*CS101_InterrogationStreamHandler) (void* parameter, IMasterConnection connection, uint8_t qoi, uint32_t* position, CS101_ASDU asdu);
+
 /**
  * \brief Handler for counter interrogation command (C_CI_NA_1 - 101).
  */
@@ -38,32 +38,40 @@ extern "C" {
 #define CS101_MAX_QUEUE_SIZE 10
 #endif
 
-typedef struct sCS101_QueueElement* CS101_QueueElement;
+/**
+ * Memory required for an ASDU of maximum size (length byte + 256 byte ASDU). The queue size
+ * is given in this unit. Smaller ASDUs only use the memory they require so the queue
+ * can store more ASDUs than its size.
+ */
+#define CS101_QUEUE_ELEMENT_SIZE 257
 
-struct sCS101_QueueElement {
-    uint8_t size;
-    uint8_t buffer[256];
-};
+/**
+ * Called (without holding the queue lock) when old ASDUs have been removed to store a new ASDU
+ */
+typedef void (*CS101_QueueOverflowHandler) (void* parameter, int droppedASDUs);
 
 typedef struct sCS101_Queue* CS101_Queue;
 
+/* ring buffer of variable length entries (length byte + encoded ASDU) */
 struct sCS101_Queue {
 
-    int size;
+    int size; /* size of the ring buffer in bytes */
+    int usedBytes;
     int entryCounter;
-    int lastMsgIndex;
-    int firstMsgIndex;
+    int firstMsgIndex; /* position of the oldest entry */
+    int lastMsgIndex; /* position where the next entry is written */
 
-    struct sBufferFrame encodeFrame;
+    CS101_QueueOverflowHandler overflowHandler;
+    void* overflowHandlerParameter;
 
 #if (CS101_MAX_QUEUE_SIZE == -1)
-    struct sCS101_QueueElement* elements;
+    uint8_t* buffer;
 #else
-    struct sCS101_QueueElement elements[CS101_MAX_QUEUE_SIZE];
+    uint8_t buffer[CS101_MAX_QUEUE_SIZE * CS101_QUEUE_ELEMENT_SIZE];
 #endif
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-    Semaphore queueLock;
+    Mutex queueLock;
 #endif
 };
 
@@ -73,6 +81,9 @@ CS101_Queue_initialize(CS101_Queue self, int maxQueueSize);
 void
 CS101_Queue_dispose(CS101_Queue self);
 
+void
+CS101_Queue_setOverflowHandler(CS101_Queue self, CS101_QueueOverflowHandler handler, void* parameter);
+
 void
 CS101_Queue_lock(CS101_Queue self);
 
@@ -94,6 +105,10 @@ CS101_Queue_isFull(CS101_Queue self);
 bool
 CS101_Queue_isEmpty(CS101_Queue self);
 
+/* number of bytes that are not used by entries */
+int
+CS101_Queue_getFreeBytes(CS101_Queue self);
+
 void
 CS101_Queue_flush(CS101_Queue self);
 
@@ -1214,6 +1214,12 @@ union uInformationObject {
     struct sStepCommandWithCP56Time2a m38;
     struct sFileDirectory m39;
     struct sQueryLog m40;
+    struct sFileReady m41;
+    struct sSectionReady m42;
+    struct sFileCallOrSelect m43;
+    struct sFileLastSegmentOrSection m44;
+    struct sFileACK m45;
+    struct sFileSegment m46;
 };
 
 #endif /* SRC_INC_INFORMATION_OBJECTS_INTERNAL_H_ */
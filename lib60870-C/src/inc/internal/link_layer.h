@@ -55,6 +55,7 @@ struct sIPrimaryApplicationLayer {
     void (*AccessDemand) (void* parameter, int slaveAddress);
     void (*UserData) (void* parameter, int slaveAddress, uint8_t* msg, int start, int length);
     void (*Timeout) (void* parameter, int slaveAddress);
+    void (*SendCompleted) (void* parameter, int slaveAddress, uint8_t* msg, int msgSize, bool success);
 };
 
 typedef struct sIBalancedApplicationLayer* IBalancedApplicationLayer;
@@ -83,6 +84,15 @@ LinkLayerPrimaryUnbalanced_setStateChangeHandler(LinkLayerPrimaryUnbalanced self
 void
 LinkLayerPrimaryUnbalanced_addSlaveConnection(LinkLayerPrimaryUnbalanced self, int slaveAddress);
 
+bool
+LinkLayerPrimaryUnbalanced_setPollIntervals(LinkLayerPrimaryUnbalanced self, int slaveAddress, int class1Interval, int class2Interval);
+
+void
+LinkLayerPrimaryUnbalanced_setRetryDelay(LinkLayerPrimaryUnbalanced self, int minRetryDelay, int maxRetryDelay);
+
+void
+LinkLayerPrimaryUnbalanced_setAdaptiveTimeouts(LinkLayerPrimaryUnbalanced self, bool enable, int minTimeoutForAck, int maxTimeoutForAck);
+
 void
 LinkLayerPrimaryUnbalanced_resetCU(LinkLayerPrimaryUnbalanced self, int slaveAddress);
 
@@ -99,10 +109,10 @@ bool
 LinkLayerPrimaryUnbalanced_requestClass2Data(LinkLayerPrimaryUnbalanced self, int slaveAddress);
 
 bool
-LinkLayerPrimaryUnbalanced_sendConfirmed(LinkLayerPrimaryUnbalanced self, int slaveAddress, BufferFrame message);
+LinkLayerPrimaryUnbalanced_sendConfirmed(LinkLayerPrimaryUnbalanced self, int slaveAddress, BufferFrame message, bool highPriority);
 
 bool
-LinkLayerPrimaryUnbalanced_sendNoReply(LinkLayerPrimaryUnbalanced self, int slaveAddress, BufferFrame message);
+LinkLayerPrimaryUnbalanced_sendNoReply(LinkLayerPrimaryUnbalanced self, int slaveAddress, BufferFrame message, bool highPriority);
 
 void
 LinkLayerPrimaryUnbalanced_run(LinkLayerPrimaryUnbalanced self);
@@ -135,6 +145,22 @@ LinkLayerSecondaryUnbalanced_setStateChangeHandler(LinkLayerSecondaryUnbalanced
 void
 LinkLayerSecondaryUnbalanced_setAddress(LinkLayerSecondaryUnbalanced self, int address);
 
+/**
+ * \brief Add a station that answers the requests for another link layer address on the same line
+ *
+ * \return false when a station with this address already exists
+ */
+bool
+LinkLayerSecondaryUnbalanced_addStation(LinkLayerSecondaryUnbalanced self, int address,
+        ISecondaryApplicationLayer applicationLayer, void* applicationLayerParameter);
+
+void
+LinkLayerSecondaryUnbalanced_removeStation(LinkLayerSecondaryUnbalanced self, int address);
+
+void
+LinkLayerSecondaryUnbalanced_setStationStateChangeHandler(LinkLayerSecondaryUnbalanced self, int address,
+        IEC60870_LinkLayerStateChangedHandler handler, void* parameter);
+
 LinkLayerBalanced
 LinkLayerBalanced_create(
         int linkLayerAddress,
@@ -154,6 +180,9 @@ LinkLayerBalanced_sendLinkLayerTestFunction(LinkLayerBalanced self);
 void
 LinkLayerBalanced_setIdleTimeout(LinkLayerBalanced self, int timeoutInMs);
 
+void
+LinkLayerBalanced_setAdaptiveTimeouts(LinkLayerBalanced self, bool enable, int minTimeoutForAck, int maxTimeoutForAck);
+
 void
 LinkLayerBalanced_setDIR(LinkLayerBalanced self, bool dir);
 
@@ -27,6 +27,7 @@
 #include "link_layer_parameters.h"
 #include "hal_serial.h"
 #include "iec60870_common.h"
+#include "cs101_transport.h"
 
 typedef struct sSerialTransceiverFT12* SerialTransceiverFT12;
 
@@ -35,6 +36,14 @@ typedef void (*SerialTXMessageHandler) (void* parameter, uint8_t* msg, int msgSi
 SerialTransceiverFT12
 SerialTransceiverFT12_create(SerialPort serialPort, LinkLayerParameters linkLayerParameters);
 
+/**
+ * \brief Create a transceiver that uses a transport instead of a serial port
+ *
+ * \param transport the transport functions (will be copied)
+ */
+SerialTransceiverFT12
+SerialTransceiverFT12_createWithTransport(CS101_Transport transport, LinkLayerParameters linkLayerParameters);
+
 void
 SerialTransceiverFT12_destroy(SerialTransceiverFT12 self);
 
@@ -44,12 +53,58 @@ SerialTransceiverFT12_setTimeouts(SerialTransceiverFT12 self, int messageTimeout
 void
 SerialTransceiverFT12_setRawMessageHandler(SerialTransceiverFT12 self, IEC60870_RawMessageHandler handler, void* parameter);
 
+/**
+ * \brief Don't wait for data when reading messages
+ *
+ * Used when the serial port is monitored by the caller (e.g. for multiple channels in a single thread).
+ */
+void
+SerialTransceiverFT12_setNonBlocking(SerialTransceiverFT12 self, bool nonBlocking);
+
+/**
+ * \brief Get the serial port of the transceiver
+ *
+ * \return the serial port, or NULL when the transceiver uses a transport
+ */
+SerialPort
+SerialTransceiverFT12_getSerialPort(SerialTransceiverFT12 self);
+
 int
 SerialTransceiverFT12_getBaudRate(SerialTransceiverFT12 self);
 
+/**
+ * \brief Send a message
+ *
+ * The function doesn't wait until the message is transmitted. The time when the transmission
+ * is finished is calculated from the baud rate (see \ref SerialTransceiverFT12_getTransmissionEndTime).
+ */
 void
 SerialTransceiverFT12_sendMessage(SerialTransceiverFT12 self, uint8_t* msg, int msgSize);
 
+/**
+ * \brief Get the time when the last sent message has been transmitted completely
+ *
+ * Timeouts for the response of the other station have to start at this time.
+ *
+ * \return the calculated end of the transmission (in ms, same time base as Hal_getTimeInMs)
+ */
+uint64_t
+SerialTransceiverFT12_getTransmissionEndTime(SerialTransceiverFT12 self);
+
+/**
+ * \brief Check if the line is free for the next message
+ *
+ * \return true when the last message has been transmitted and the minimum line idle time (33 bit times) elapsed
+ */
+bool
+SerialTransceiverFT12_isReadyToSend(SerialTransceiverFT12 self);
+
+/**
+ * \brief Check if a complete message is in the receive buffer (can be read without waiting)
+ */
+bool
+SerialTransceiverFT12_isMessageBuffered(SerialTransceiverFT12 self);
+
 void
 SerialTransceiverFT12_readNextMessage(SerialTransceiverFT12 self, uint8_t* buffer,
         SerialTXMessageHandler, void* parameter);
@@ -4,10 +4,28 @@
 #include "cs104_connection.h"
 #include "hal_time.h"
 #include "hal_thread.h"
+#include "hal_socket.h"
+#include "lib60870_config.h"
 #include "buffer_frame.h"
+#include "cs101_queue.h"
+#include "cs101_asdu_internal.h"
+#include "cs101_master.h"
+#include "cs101_slave.h"
+#include "cs101_transport.h"
+#include "cs101_file_service.h"
+#include "cs101_process_image.h"
 #include <string.h>
 #include <stdlib.h>
 
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <pthread.h>
+#include "serial_transceiver_ft_1_2.h"
+#include "cs101_channel_group.h"
+#endif
+
 #if WIN32
 #define bzero(b,len) (memset((b), '\0', (len)), (void) 0) 
 #endif
@@ -1030,6 +1048,287 @@ test_CS104SlaveSingleRedundancyGroup()
     CS104_Slave_destroy(slave);
 }
 
+void
+test_CS104SlaveConnectionIsRedundancyGroupThreadless()
+{
+    CS104_Slave slave = CS104_Slave_create(100, 100);
+
+    CS104_Slave_setServerMode(slave, CS104_MODE_CONNECTION_IS_REDUNDANCY_GROUP);
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    /* change k after the connection objects are pre-allocated */
+    CS104_Slave_getConnectionParameters(slave)->k = 20;
+
+    CS104_Slave_startThreadless(slave);
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    int i;
+
+    for (i = 0; i < 3 * CONFIG_CS104_MAX_CLIENT_CONNECTIONS; i++) {
+        bool result = CS104_Connection_connect(con);
+        TEST_ASSERT_TRUE(result);
+
+        CS104_Connection_sendStartDT(con);
+
+        int j;
+
+        for (j = 0; j < 10; j++) {
+            CS104_Slave_tick(slave);
+            Thread_sleep(1);
+        }
+
+        TEST_ASSERT_EQUAL_INT(1, CS104_Slave_getOpenConnections(slave));
+
+        CS104_Connection_close(con);
+
+        for (j = 0; j < 10; j++) {
+            CS104_Slave_tick(slave);
+            Thread_sleep(1);
+        }
+
+        TEST_ASSERT_EQUAL_INT(0, CS104_Slave_getOpenConnections(slave));
+    }
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_stopThreadless(slave);
+
+    CS104_Slave_destroy(slave);
+}
+
+struct sThreadlessCommandCounter {
+    int receivedCommands;
+    int confirmations;
+};
+
+static bool
+threadlessCommandHandler(void* parameter, IMasterConnection connection, CS101_ASDU asdu)
+{
+    struct sThreadlessCommandCounter* counter = (struct sThreadlessCommandCounter*) parameter;
+
+    if (CS101_ASDU_getTypeID(asdu) == C_SC_NA_1) {
+        counter->receivedCommands++;
+
+        IMasterConnection_sendACT_CON(connection, asdu, false);
+
+        return true;
+    }
+
+    return false;
+}
+
+static bool
+threadlessConfirmationHandler(void* parameter, int address, CS101_ASDU asdu)
+{
+    struct sThreadlessCommandCounter* counter = (struct sThreadlessCommandCounter*) parameter;
+
+    if (CS101_ASDU_getCOT(asdu) == CS101_COT_ACTIVATION_CON)
+        counter->confirmations++;
+
+    return true;
+}
+
+void
+test_CS104SlaveThreadlessMultipleConnections()
+{
+    struct sThreadlessCommandCounter slaveCounter;
+    struct sThreadlessCommandCounter clientCounters[3];
+
+    memset(&slaveCounter, 0, sizeof(slaveCounter));
+    memset(clientCounters, 0, sizeof(clientCounters));
+
+    CS104_Slave slave = CS104_Slave_create(100, 100);
+
+    /* each connection is active */
+    CS104_Slave_setServerMode(slave, CS104_MODE_CONNECTION_IS_REDUNDANCY_GROUP);
+    CS104_Slave_setLocalPort(slave, 20008);
+    CS104_Slave_setASDUHandler(slave, threadlessCommandHandler, &slaveCounter);
+
+    CS104_Slave_startThreadless(slave);
+
+    CS104_Connection cons[3];
+
+    int i;
+
+    for (i = 0; i < 3; i++) {
+        cons[i] = CS104_Connection_create("127.0.0.1", 20008);
+        CS104_Connection_setASDUReceivedHandler(cons[i], threadlessConfirmationHandler, &(clientCounters[i]));
+
+        TEST_ASSERT_TRUE(CS104_Connection_connect(cons[i]));
+
+        CS104_Connection_sendStartDT(cons[i]);
+    }
+
+    int j;
+
+    for (j = 0; j < 20; j++) {
+        CS104_Slave_tick(slave);
+        Thread_sleep(1);
+    }
+
+    TEST_ASSERT_EQUAL_INT(3, CS104_Slave_getOpenConnections(slave));
+
+    /* the commands of all connections are received with the same ticks (less than k = 12 per connection) */
+    for (j = 0; j < 10; j++) {
+        for (i = 0; i < 3; i++) {
+            InformationObject sc = (InformationObject) SingleCommand_create(NULL, 5000 + j, true, false, 0);
+
+            TEST_ASSERT_TRUE(CS104_Connection_sendProcessCommandEx(cons[i], CS101_COT_ACTIVATION, 1, sc));
+
+            InformationObject_destroy(sc);
+        }
+    }
+
+    uint64_t timeout = Hal_getTimeInMs() + 2000;
+
+    while ((Hal_getTimeInMs() < timeout) && ((clientCounters[0].confirmations < 10) ||
+            (clientCounters[1].confirmations < 10) || (clientCounters[2].confirmations < 10)))
+    {
+        CS104_Slave_tick(slave);
+        Thread_sleep(1);
+    }
+
+    TEST_ASSERT_EQUAL_INT(30, slaveCounter.receivedCommands);
+
+    for (i = 0; i < 3; i++)
+        TEST_ASSERT_EQUAL_INT(10, clientCounters[i].confirmations);
+
+    /* a closed connection is released while the others are still receiving */
+    CS104_Connection_destroy(cons[0]);
+
+    for (j = 0; j < 20; j++) {
+        CS104_Slave_tick(slave);
+        Thread_sleep(1);
+    }
+
+    TEST_ASSERT_EQUAL_INT(2, CS104_Slave_getOpenConnections(slave));
+
+    /* stopping the slave cancels the pending receive operations */
+    CS104_Slave_stopThreadless(slave);
+
+    TEST_ASSERT_EQUAL_INT(0, CS104_Slave_getOpenConnections(slave));
+
+    CS104_Connection_destroy(cons[1]);
+    CS104_Connection_destroy(cons[2]);
+
+    CS104_Slave_destroy(slave);
+}
+
+#if defined(__linux__)
+struct sConnectionThreadRecorder {
+    int receivedCommands;
+    pthread_t handlingThread[4];
+};
+
+static bool
+connectionThreadRecorderHandler(void* parameter, IMasterConnection connection, CS101_ASDU asdu)
+{
+    struct sConnectionThreadRecorder* recorder = (struct sConnectionThreadRecorder*) parameter;
+
+    if (CS101_ASDU_getTypeID(asdu) == C_SC_NA_1) {
+        if (recorder->receivedCommands < 4)
+            recorder->handlingThread[recorder->receivedCommands] = pthread_self();
+
+        recorder->receivedCommands++;
+
+        IMasterConnection_sendACT_CON(connection, asdu, false);
+
+        return true;
+    }
+
+    return false;
+}
+
+static void
+connectAndSendCommand(struct sThreadlessCommandCounter* clientCounter)
+{
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20008);
+    CS104_Connection_setASDUReceivedHandler(con, threadlessConfirmationHandler, clientCounter);
+
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con));
+
+    CS104_Connection_sendStartDT(con);
+
+    Thread_sleep(50);
+
+    /* the confirmation can be received before the send function returns */
+    int expectedConfirmations = clientCounter->confirmations + 1;
+
+    InformationObject sc = (InformationObject) SingleCommand_create(NULL, 5000, true, false, 0);
+
+    TEST_ASSERT_TRUE(CS104_Connection_sendProcessCommandEx(con, CS101_COT_ACTIVATION, 1, sc));
+
+    InformationObject_destroy(sc);
+
+    uint64_t timeout = Hal_getTimeInMs() + 2000;
+
+    while ((Hal_getTimeInMs() < timeout) && (clientCounter->confirmations < expectedConfirmations))
+        Thread_sleep(1);
+
+    TEST_ASSERT_EQUAL_INT(expectedConfirmations, clientCounter->confirmations);
+
+    CS104_Connection_destroy(con);
+}
+
+static void
+waitUntilConnectionsClosed(CS104_Slave slave)
+{
+    uint64_t timeout = Hal_getTimeInMs() + 2000;
+
+    while ((Hal_getTimeInMs() < timeout) && (CS104_Slave_getOpenConnections(slave) > 0))
+        Thread_sleep(1);
+
+    TEST_ASSERT_EQUAL_INT(0, CS104_Slave_getOpenConnections(slave));
+}
+
+void
+test_CS104SlaveConnectionThreadReused()
+{
+    struct sConnectionThreadRecorder recorder;
+    struct sThreadlessCommandCounter clientCounter;
+
+    memset(&recorder, 0, sizeof(recorder));
+    memset(&clientCounter, 0, sizeof(clientCounter));
+
+    CS104_Slave slave = CS104_Slave_create(100, 100);
+
+    CS104_Slave_setServerMode(slave, CS104_MODE_CONNECTION_IS_REDUNDANCY_GROUP);
+    CS104_Slave_setLocalPort(slave, 20008);
+    CS104_Slave_setASDUHandler(slave, connectionThreadRecorderHandler, &recorder);
+
+    CS104_Slave_start(slave);
+
+    TEST_ASSERT_TRUE(CS104_Slave_isRunning(slave));
+
+    int i;
+
+    /* the following connections get the connection object (and thread) of the closed connection */
+    for (i = 0; i < 3; i++) {
+        connectAndSendCommand(&clientCounter);
+        waitUntilConnectionsClosed(slave);
+    }
+
+    /* the threads are kept when the slave is restarted */
+    CS104_Slave_stop(slave);
+    CS104_Slave_start(slave);
+
+    TEST_ASSERT_TRUE(CS104_Slave_isRunning(slave));
+
+    connectAndSendCommand(&clientCounter);
+    waitUntilConnectionsClosed(slave);
+
+    CS104_Slave_stop(slave);
+
+    CS104_Slave_destroy(slave);
+
+    TEST_ASSERT_EQUAL_INT(4, recorder.receivedCommands);
+
+    for (i = 1; i < 4; i++)
+        TEST_ASSERT_TRUE(pthread_equal(recorder.handlingThread[0], recorder.handlingThread[i]));
+}
+#endif /* defined(__linux__) */
+
 struct stest_CS104SlaveEventQueue1 {
     int asduHandlerCalled;
     int spontCount;
@@ -1159,12 +1458,21 @@ test_CS104SlaveEventQueue1()
 }
 
 void
-test_CS104SlaveEventQueueOverflow()
+test_CS104SlaveSocketOptionsCorkBatches()
 {
-    CS104_Slave slave = CS104_Slave_create(10, 10);
+    struct sSocketOptions socketOptions;
+
+    SocketOptions_init(&socketOptions);
+    socketOptions.sendBufferSize = 65536;
+    socketOptions.receiveBufferSize = 65536;
+    socketOptions.userTimeout = 5000;
+    socketOptions.corkBatches = true;
+
+    CS104_Slave slave = CS104_Slave_create(100, 100);
 
     CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
-    CS104_Slave_setLocalPort(slave, 20004);
+    CS104_Slave_setLocalPort(slave, 20006);
+    CS104_Slave_setSocketOptions(slave, &socketOptions);
 
     CS104_Slave_start(slave);
 
@@ -1175,16 +1483,13 @@ test_CS104SlaveEventQueueOverflow()
     info.spontCount = 0;
     info.lastScaledValue = 0;
 
-    int16_t scaledValue = 0;
-
     int i;
 
-    for (int i = 0; i < 300; i++) {
+    /* more ASDUs than the k parameter allows to send without confirmation */
+    for (i = 0; i < 30; i++) {
         CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
 
-        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
-
-        scaledValue++;
+        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, i, IEC60870_QUALITY_GOOD);
 
         CS101_ASDU_addInformationObject(newAsdu, io);
 
@@ -1195,8 +1500,9 @@ test_CS104SlaveEventQueueOverflow()
         CS101_ASDU_destroy(newAsdu);
     }
 
-    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20006);
 
+    CS104_Connection_setSocketOptions(con, &socketOptions);
     CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
 
     bool result = CS104_Connection_connect(con);
@@ -1208,1003 +1514,4130 @@ test_CS104SlaveEventQueueOverflow()
 
     CS104_Connection_close(con);
 
-    int asduSize = 12;
-    int entrySize = sizeof(struct sTestMessageQueueEntryInfo) + asduSize;
-    int msgQueueCapacity = ((sizeof(struct sTestMessageQueueEntryInfo) + 256) * 10) / entrySize;
-
-    TEST_ASSERT_EQUAL_INT(299, info.lastScaledValue);
-    TEST_ASSERT_EQUAL_INT(msgQueueCapacity, info.asduHandlerCalled);
+    TEST_ASSERT_EQUAL_INT(30, info.spontCount);
+    TEST_ASSERT_EQUAL_INT(29, info.lastScaledValue);
 
-    result = CS104_Connection_connect(con);
-    TEST_ASSERT_TRUE(result);
+    CS104_Connection_destroy(con);
 
-    CS104_Connection_sendStartDT(con);
+    CS104_Slave_destroy(slave);
+}
 
-    for (int i = 0; i < 150; i++) {
-        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+#if defined(__linux__)
+/* open a pseudo terminal that is used as serial line. Returns the (non-blocking) master side, the name of the
+ * slave side is stored in ptyName */
+static int
+openPseudoTerminal(char* ptyName)
+{
+    int master = open("/dev/ptmx", O_RDWR | O_NOCTTY | O_NONBLOCK);
 
-        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
+    if (master >= 0) {
+        int unlock = 0;
+        int ptyNumber = -1;
 
-        scaledValue++;
+        if ((ioctl(master, TIOCSPTLCK, &unlock) != 0) || (ioctl(master, TIOCGPTN, &ptyNumber) != 0)) {
+            close(master);
+            return -1;
+        }
 
-        CS101_ASDU_addInformationObject(newAsdu, io);
+        sprintf(ptyName, "/dev/pts/%i", ptyNumber);
+    }
 
-        InformationObject_destroy(io);
+    return master;
+}
 
-        CS104_Slave_enqueueASDU(slave, newAsdu);
+struct sFT12ReceivedFrames {
+    int count;
+    int sizes[10];
+    uint8_t firstBytes[10];
+};
 
-        CS101_ASDU_destroy(newAsdu);
+static void
+ft12FrameHandler(void* parameter, uint8_t* msg, int msgSize)
+{
+    struct sFT12ReceivedFrames* frames = (struct sFT12ReceivedFrames*) parameter;
 
-        Thread_sleep(10);
+    if (frames->count < 10) {
+        frames->sizes[frames->count] = msgSize;
+        frames->firstBytes[frames->count] = msg[0];
+        frames->count++;
     }
+}
 
-    Thread_sleep(500);
+void
+test_SerialTransceiverFT12_ResyncInBuffer(void)
+{
+    /* use a pseudo terminal as serial line */
+    char ptyName[50];
 
-    CS104_Connection_close(con);
+    int master = openPseudoTerminal(ptyName);
 
-    TEST_ASSERT_EQUAL_INT(msgQueueCapacity + 150, info.asduHandlerCalled);
-    TEST_ASSERT_EQUAL_INT(msgQueueCapacity + 150, info.spontCount);
-    TEST_ASSERT_EQUAL_INT(449, info.lastScaledValue);
+    TEST_ASSERT_TRUE(master >= 0);
 
-    CS104_Connection_destroy(con);
+    SerialPort port = SerialPort_create(ptyName, 9600, 8, 'E', 1);
 
-    CS104_Slave_destroy(slave);
-}
+    TEST_ASSERT_TRUE(SerialPort_open(port));
 
-void
-test_CS104SlaveEventQueueOverflow2()
-{
-    CS104_Slave slave = CS104_Slave_create(10, 10);
+    struct sLinkLayerParameters llParameters;
+    llParameters.addressLength = 1;
+    llParameters.timeoutForAck = 200;
+    llParameters.timeoutRepeat = 1000;
+    llParameters.useSingleCharACK = true;
 
-    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
-    CS104_Slave_setLocalPort(slave, 20004);
+    SerialTransceiverFT12 transceiver = SerialTransceiverFT12_create(port, &llParameters);
 
-    CS104_Slave_start(slave);
+    SerialTransceiverFT12_setTimeouts(transceiver, 50, 50);
 
-    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
+    uint8_t data[] = {
+            0x00, 0x55, /* line noise */
+            0x10, 0x49, 0x01, 0x4a, 0x16, /* fixed length frame */
+            0xe5, /* single character */
+            0x68, 0x05, 0x07, 0x68, /* invalid frame header */
+            0x68, 0x03, 0x03, 0x68, 0x73, 0x01, 0x00, 0x74, 0x16 /* variable length frame */
+    };
 
-    struct stest_CS104SlaveEventQueue1 info;
-    info.asduHandlerCalled = 0;
-    info.spontCount = 0;
-    info.lastScaledValue = 0;
+    TEST_ASSERT_EQUAL_INT(sizeof(data), write(master, data, sizeof(data)));
 
-    int16_t scaledValue = 0;
+    struct sFT12ReceivedFrames frames;
+    memset(&frames, 0, sizeof(frames));
+
+    uint8_t buffer[261];
 
     int i;
 
-    for (int i = 0; i < 300; i++) {
-        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+    for (i = 0; i < 10; i++)
+        SerialTransceiverFT12_readNextMessage(transceiver, buffer, ft12FrameHandler, &frames);
 
-        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
+    /* the frames following the invalid bytes are not lost */
+    TEST_ASSERT_EQUAL_INT(3, frames.count);
+    TEST_ASSERT_EQUAL_INT(5, frames.sizes[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x10, frames.firstBytes[0]);
+    TEST_ASSERT_EQUAL_INT(1, frames.sizes[1]);
+    TEST_ASSERT_EQUAL_UINT8(0xe5, frames.firstBytes[1]);
+    TEST_ASSERT_EQUAL_INT(9, frames.sizes[2]);
+    TEST_ASSERT_EQUAL_UINT8(0x68, frames.firstBytes[2]);
 
-        scaledValue++;
+    SerialTransceiverFT12_destroy(transceiver);
 
-        CS101_ASDU_addInformationObject(newAsdu, io);
+    SerialPort_close(port);
+    SerialPort_destroy(port);
 
-        InformationObject_destroy(io);
+    close(master);
+}
 
-        CS104_Slave_enqueueASDU(slave, newAsdu);
+void
+test_SerialPort_WriteLineTiming(void)
+{
+    char ptyName[50];
 
-        CS101_ASDU_destroy(newAsdu);
-    }
+    int master = openPseudoTerminal(ptyName);
 
-    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+    TEST_ASSERT_TRUE(master >= 0);
 
-    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
+    /* 1200 baud, 8E1 -> 11 bits per character -> 9.17 ms per character */
+    SerialPort port = SerialPort_create(ptyName, 1200, 8, 'E', 1);
 
-    bool result = CS104_Connection_connect(con);
-    TEST_ASSERT_TRUE(result);
+    TEST_ASSERT_TRUE(SerialPort_open(port));
 
-    CS104_Connection_sendStartDT(con);
+    uint8_t frame[20];
+    memset(frame, 0xe5, sizeof(frame));
 
-    Thread_sleep(500);
+    uint64_t startTime = Hal_getTimeInMs();
 
-    CS104_Connection_close(con);
+    TEST_ASSERT_EQUAL_INT(20, SerialPort_write(port, frame, 0, 20));
+    TEST_ASSERT_EQUAL_INT(20, SerialPort_write(port, frame, 0, 20));
 
-    int asduSize = 12;
-    int entrySize = sizeof(struct sTestMessageQueueEntryInfo) + asduSize;
-    int msgQueueCapacity = ((sizeof(struct sTestMessageQueueEntryInfo) + 256) * 10) / entrySize;
+    /* the frames are handed to the driver without waiting for the transmission (2 * 183 ms) */
+    TEST_ASSERT_TRUE(Hal_getTimeInMs() - startTime < 100);
 
-    TEST_ASSERT_EQUAL_INT(299, info.lastScaledValue);
-    TEST_ASSERT_EQUAL_INT(msgQueueCapacity, info.asduHandlerCalled);
+    SerialPort_close(port);
+    SerialPort_destroy(port);
 
-    result = CS104_Connection_connect(con);
-    TEST_ASSERT_TRUE(result);
+    close(master);
+}
 
-    CS104_Connection_sendStartDT(con);
+static uint64_t
+getFrameTransmissionTime(int master, const char* ptyName, uint8_t dataBits, char parity, uint8_t stopBits)
+{
+    SerialPort port = SerialPort_create(ptyName, 1200, dataBits, parity, stopBits);
 
-    int typeNo = 0;
+    TEST_ASSERT_TRUE(SerialPort_open(port));
 
-    for (int i = 0; i < 20000; i++) {
-        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+    struct sLinkLayerParameters llParameters;
+    llParameters.addressLength = 1;
+    llParameters.timeoutForAck = 200;
+    llParameters.timeoutRepeat = 1000;
+    llParameters.useSingleCharACK = true;
 
-        InformationObject io;
+    SerialTransceiverFT12 transceiver = SerialTransceiverFT12_create(port, &llParameters);
 
-        if (typeNo == 0) {
-            io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
-            CS101_ASDU_addInformationObject(newAsdu, io);
-        }
-        else if (typeNo == 1) {
-            struct sCP56Time2a cp56;
-            CP56Time2a_createFromMsTimestamp(&cp56, Hal_getTimeInMs());
+    uint8_t frame[120];
+    memset(frame, 0xe5, sizeof(frame));
 
-            io =  (InformationObject) MeasuredValueScaledWithCP56Time2a_create(NULL, 111, scaledValue, IEC60870_QUALITY_GOOD, &cp56);
+    uint64_t startTime = Hal_getTimeInMs();
 
-            CS101_ASDU_addInformationObject(newAsdu, io);
-        }
-        else if (typeNo == 2) {
-            io = (InformationObject) SinglePointInformation_create(NULL, 112, true, IEC60870_QUALITY_GOOD);
+    SerialTransceiverFT12_sendMessage(transceiver, frame, sizeof(frame));
 
-            CS101_ASDU_addInformationObject(newAsdu, io);
-        }
-        else if (typeNo == 3) {
-            io = (InformationObject) SinglePointInformation_create(NULL, 112, true, IEC60870_QUALITY_GOOD);
-            int j = 1;
-            while (CS101_ASDU_addInformationObject(newAsdu, io)) {
-                io = (InformationObject) SinglePointInformation_create((SinglePointInformation) io, 112 + j, true, IEC60870_QUALITY_GOOD);
-                j++;
-            }
-        }
+    uint64_t transmissionTime = SerialTransceiverFT12_getTransmissionEndTime(transceiver) - startTime;
 
-        typeNo++;
+    SerialTransceiverFT12_destroy(transceiver);
 
-        if (typeNo == 4)
-            typeNo = 0;
+    SerialPort_close(port);
+    SerialPort_destroy(port);
 
-        scaledValue++;
+    /* drop the written data (the pseudo terminal is non-blocking) */
+    uint8_t buf[200];
+    while (read(master, buf, sizeof(buf)) > 0);
 
-        InformationObject_destroy(io);
+    return transmissionTime;
+}
 
-        CS104_Slave_enqueueASDU(slave, newAsdu);
+void
+test_SerialTransceiverFT12_TransmissionTimeFromCharacterFormat(void)
+{
+    char ptyName[50];
 
-        CS101_ASDU_destroy(newAsdu);
+    int master = openPseudoTerminal(ptyName);
 
-        //Thread_sleep(10);
+    TEST_ASSERT_TRUE(master >= 0);
+
+    /* 120 characters at 1200 baud: 8N1 (10 bits) -> 1000 ms, 8E1 (11 bits) -> 1100 ms, 8E2 (12 bits) -> 1200 ms */
+    uint64_t time8N1 = getFrameTransmissionTime(master, ptyName, 8, 'N', 1);
+    uint64_t time8E1 = getFrameTransmissionTime(master, ptyName, 8, 'E', 1);
+    uint64_t time8E2 = getFrameTransmissionTime(master, ptyName, 8, 'E', 2);
+
+    TEST_ASSERT_TRUE((time8N1 >= 1000) && (time8N1 <= 1002));
+    TEST_ASSERT_TRUE((time8E1 >= 1100) && (time8E1 <= 1102));
+    TEST_ASSERT_TRUE((time8E2 >= 1200) && (time8E2 <= 1202));
+
+    close(master);
+}
+
+void
+test_CS101_ChannelGroup_MultipleSlaves(void)
+{
+    int i;
+    int master[4];
+    SerialPort port[4];
+    CS101_Slave slave[4];
+
+    CS101_ChannelGroup group = CS101_ChannelGroup_create();
+
+    for (i = 0; i < 4; i++) {
+        char ptyName[50];
+
+        master[i] = openPseudoTerminal(ptyName);
+
+        TEST_ASSERT_TRUE(master[i] >= 0);
+
+        port[i] = SerialPort_create(ptyName, 9600, 8, 'E', 1);
+
+        TEST_ASSERT_TRUE(SerialPort_open(port[i]));
+
+        slave[i] = CS101_Slave_create(port[i], NULL, NULL, IEC60870_LINK_LAYER_UNBALANCED);
+
+        CS101_Slave_setLinkLayerAddress(slave[i], 1);
+
+        CS101_ChannelGroup_addSlave(group, slave[i]);
     }
 
-    Thread_sleep(500);
+    /* a single thread handles all four serial lines */
+    CS101_ChannelGroup_start(group, 1);
 
-    CS104_Connection_close(con);
+    /* request status of link (FC=9) */
+    uint8_t request[] = { 0x10, 0x49, 0x01, 0x4a, 0x16 };
 
-    CS104_Connection_destroy(con);
+    for (i = 0; i < 4; i++)
+        TEST_ASSERT_EQUAL_INT(sizeof(request), write(master[i], request, sizeof(request)));
 
-    CS104_Slave_destroy(slave);
+    for (i = 0; i < 4; i++) {
+        uint8_t response[20];
+        int responseSize = 0;
+
+        uint64_t startTime = Hal_getTimeInMs();
+
+        while ((responseSize < 5) && (Hal_getTimeInMs() - startTime < 1000)) {
+            int readBytes = read(master[i], response + responseSize, sizeof(response) - responseSize);
+
+            if (readBytes > 0)
+                responseSize += readBytes;
+            else
+                Thread_sleep(1);
+        }
+
+        /* status of link (FC=11) */
+        TEST_ASSERT_EQUAL_INT(5, responseSize);
+        TEST_ASSERT_EQUAL_UINT8(0x10, response[0]);
+        TEST_ASSERT_EQUAL_INT(11, response[1] & 0x0f);
+    }
+
+    CS101_ChannelGroup_destroy(group);
+
+    for (i = 0; i < 4; i++) {
+        CS101_Slave_destroy(slave[i]);
+        SerialPort_close(port[i]);
+        SerialPort_destroy(port[i]);
+        close(master[i]);
+    }
 }
 
 void
-test_CS104SlaveEventQueueCheckCapacity()
+test_CS101_MasterUnbalanced_RetryDelayForDeadSlave(void)
 {
-    CS104_Slave slave = CS104_Slave_create(2, 2);
+    char ptyName[50];
 
-    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
-    CS104_Slave_setLocalPort(slave, 20004);
+    int pty = openPseudoTerminal(ptyName);
 
-    CS104_Slave_start(slave);
+    TEST_ASSERT_TRUE(pty >= 0);
 
-    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
+    SerialPort port = SerialPort_create(ptyName, 9600, 8, 'E', 1);
 
-    struct stest_CS104SlaveEventQueue1 info;
-    info.asduHandlerCalled = 0;
-    info.spontCount = 0;
-    info.lastScaledValue = 0;
+    TEST_ASSERT_TRUE(SerialPort_open(port));
 
-    int16_t scaledValue = 0;
+    CS101_Master master = CS101_Master_create(port, NULL, NULL, IEC60870_LINK_LAYER_UNBALANCED);
 
-    /* Fill queue with small messages */
-    int asduSize = 6 + 3 + 1;
-    int entrySize = sizeof(struct sTestMessageQueueEntryInfo) + asduSize;
-    int msgQueueCapacity = ((sizeof(struct sTestMessageQueueEntryInfo) + 256) * 2) / entrySize;
+    /* slave 1 answers - slave 2 is offline */
+    CS101_Master_addSlave(master, 1);
+    CS101_Master_addSlave(master, 2);
 
-    for (int i = 0; i < 299; i++) {
-        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+    CS101_Master_setSlavePollIntervals(master, 1, 0, 50);
+    CS101_Master_setSlaveRetryDelay(master, 500, 4000);
 
-        InformationObject io = (InformationObject) SinglePointInformation_create(NULL, 101, true, IEC60870_QUALITY_GOOD);
+    CS101_Master_start(master);
 
-        CS101_ASDU_addInformationObject(newAsdu, io);
+    int requestsToSlave1 = 0;
+    int requestsToSlave2 = 0;
 
-        InformationObject_destroy(io);
+    uint8_t buffer[100];
+    int bufferSize = 0;
 
-        CS104_Slave_enqueueASDU(slave, newAsdu);
+    uint64_t startTime = Hal_getTimeInMs();
 
-        if (i >= msgQueueCapacity)
-            TEST_ASSERT_EQUAL_INT(msgQueueCapacity, CS104_Slave_getNumberOfQueueEntries(slave, NULL));
+    while (Hal_getTimeInMs() - startTime < 2000) {
+        int readBytes = read(pty, buffer + bufferSize, sizeof(buffer) - bufferSize);
+
+        if (readBytes > 0)
+            bufferSize += readBytes;
         else
-            TEST_ASSERT_EQUAL_INT(i + 1, CS104_Slave_getNumberOfQueueEntries(slave, NULL));
+            Thread_sleep(1);
 
-        CS101_ASDU_destroy(newAsdu);
-    }
+        /* the master only sends fixed length frames (0x10 C A CS 0x16) */
+        while (bufferSize >= 5) {
+            if (buffer[0] != 0x10) {
+                memmove(buffer, buffer + 1, --bufferSize);
+                continue;
+            }
 
-    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+            if (buffer[2] == 1) {
+                if ((buffer[1] & 0x0f) == 11) /* request class 2 data */
+                    requestsToSlave1++;
 
-    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
+                uint8_t ack = 0xe5;
 
-    bool result = CS104_Connection_connect(con);
-    TEST_ASSERT_TRUE(result);
+                TEST_ASSERT_EQUAL_INT(1, write(pty, &ack, 1));
+            }
+            else if (buffer[2] == 2)
+                requestsToSlave2++;
 
-    CS104_Connection_sendStartDT(con);
+            bufferSize -= 5;
+            memmove(buffer, buffer + 5, bufferSize);
+        }
+    }
 
-    Thread_sleep(1000);
+    CS101_Master_stop(master);
 
-    CS104_Connection_close(con);
+    /* requests at 0, ~0.7 s, and ~1.9 s instead of one request every 200 ms */
+    TEST_ASSERT_TRUE(requestsToSlave2 >= 1);
+    TEST_ASSERT_TRUE(requestsToSlave2 <= 4);
 
-    TEST_ASSERT_EQUAL_INT(msgQueueCapacity, info.asduHandlerCalled);
+    TEST_ASSERT_TRUE(requestsToSlave1 >= 10);
 
-    /* outstanding I messages that are not confirmed */
-    TEST_ASSERT_EQUAL_INT(0, CS104_Slave_getNumberOfQueueEntries(slave, NULL));
+    CS101_Master_destroy(master);
+    SerialPort_close(port);
+    SerialPort_destroy(port);
+    close(pty);
+}
 
-    CS104_Connection_destroy(con);
+struct sSentASDUs {
+    int count;
+    int confirmed;
+};
 
-    CS104_Slave_destroy(slave);
+static void
+asduSentHandler(void* parameter, int address, CS101_ASDU asdu, bool confirmed)
+{
+    struct sSentASDUs* sent = (struct sSentASDUs*) parameter;
+
+    (void) address;
+    (void) asdu;
+
+    sent->count++;
+
+    if (confirmed)
+        sent->confirmed++;
 }
 
 void
-test_CS104SlaveEventQueueOverflow3()
+test_CS101_MasterUnbalanced_SlaveQueueWithPriorities(void)
 {
-    /**
-     * Trigger code to remove multiple messages at once from the buffer
-     */
+    char ptyName[50];
 
-    CS104_Slave slave = CS104_Slave_create(2, 2);
+    int pty = openPseudoTerminal(ptyName);
 
-    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
-    CS104_Slave_setLocalPort(slave, 20004);
+    TEST_ASSERT_TRUE(pty >= 0);
 
-    CS104_Slave_start(slave);
+    SerialPort port = SerialPort_create(ptyName, 9600, 8, 'E', 1);
 
-    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
+    TEST_ASSERT_TRUE(SerialPort_open(port));
 
-    struct stest_CS104SlaveEventQueue1 info;
-    info.asduHandlerCalled = 0;
-    info.spontCount = 0;
-    info.lastScaledValue = 0;
+    CS101_Master master = CS101_Master_create(port, NULL, NULL, IEC60870_LINK_LAYER_UNBALANCED);
 
-    int16_t scaledValue = 0;
+    struct sSentASDUs sent = { 0, 0 };
 
-    /* Fill queue with small messages */
+    CS101_Master_setASDUSentHandler(master, asduSentHandler, &sent);
 
-    int asduSize = 6 + 3 + 1;
-    int entrySize = sizeof(struct sTestMessageQueueEntryInfo) + asduSize;
-    int msgQueueCapacity = ((sizeof(struct sTestMessageQueueEntryInfo) + 256) * 2) / entrySize;
+    CS101_Master_addSlave(master, 1);
+    CS101_Master_useSlaveAddress(master, 1);
 
-    for (int i = 0; i < 35; i++) {
+    /* queue ASDUs without waiting for the channel to become ready */
+    CS101_Master_sendInterrogationCommand(master, CS101_COT_ACTIVATION, 1, IEC60870_QOI_STATION);
+    CS101_Master_sendReadCommand(master, 1, 102);
 
-        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+    InformationObject sc = (InformationObject) SingleCommand_create(NULL, 5000, true, false, 0);
+    CS101_Master_sendProcessCommand(master, CS101_COT_ACTIVATION, 1, sc);
+    InformationObject_destroy(sc);
 
-        InformationObject io = (InformationObject) SinglePointInformation_create(NULL, 101, true, IEC60870_QUALITY_GOOD);
+    TEST_ASSERT_TRUE(CS101_Master_isChannelReady(master, 1));
 
-        CS101_ASDU_addInformationObject(newAsdu, io);
+    CS101_Master_start(master);
 
-        InformationObject_destroy(io);
+    int typeIds[10];
+    int numberOfASDUs = 0;
 
-        CS104_Slave_enqueueASDU(slave, newAsdu);
+    uint8_t buffer[300];
+    int bufferSize = 0;
 
-        CS101_ASDU_destroy(newAsdu);
-    }
+    uint64_t startTime = Hal_getTimeInMs();
 
-    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+    while ((sent.count < 3) && (Hal_getTimeInMs() - startTime < 2000)) {
+        int readBytes = read(pty, buffer + bufferSize, sizeof(buffer) - bufferSize);
 
-    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
+        if (readBytes > 0)
+            bufferSize += readBytes;
+        else
+            Thread_sleep(1);
 
-    int count1 = CS104_Slave_getNumberOfQueueEntries(slave, NULL);
+        while (bufferSize > 0) {
+            int frameSize = 0;
 
+            if (buffer[0] == 0x10)
+                frameSize = 5;
+            else if ((buffer[0] == 0x68) && (bufferSize >= 4))
+                frameSize = buffer[1] + 6;
+            else if (buffer[0] != 0x68)
+                frameSize = 1; /* skip unexpected byte */
 
+            if ((frameSize == 0) || (bufferSize < frameSize))
+                break;
 
-    /* add a single large messages */
-    CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_PERIODIC, 0, 1, false, false);
+            if ((buffer[0] == 0x68) && (numberOfASDUs < 10))
+                typeIds[numberOfASDUs++] = buffer[6];
 
-    for (int i = 0; i < 50; i++) {
-          SinglePointInformation spi = SinglePointInformation_create(NULL, 110, false, IEC60870_QUALITY_GOOD);;
+            if (frameSize > 1) {
+                uint8_t ack = 0xe5;
 
-          CS101_ASDU_addInformationObject(newAsdu, (InformationObject) spi);
+                TEST_ASSERT_EQUAL_INT(1, write(pty, &ack, 1));
+            }
 
-          InformationObject_destroy((InformationObject) spi);
+            bufferSize -= frameSize;
+            memmove(buffer, buffer + frameSize, bufferSize);
+        }
     }
 
-    CS104_Slave_enqueueASDU(slave, newAsdu);
+    CS101_Master_stop(master);
 
-    CS101_ASDU_destroy(newAsdu);
+    TEST_ASSERT_EQUAL_INT(3, sent.count);
+    TEST_ASSERT_EQUAL_INT(3, sent.confirmed);
 
-    int count2 = CS104_Slave_getNumberOfQueueEntries(slave, NULL);
+    /* the command is sent before the interrogation and read commands */
+    TEST_ASSERT_EQUAL_INT(3, numberOfASDUs);
+    TEST_ASSERT_EQUAL_INT(C_SC_NA_1, typeIds[0]);
+    TEST_ASSERT_EQUAL_INT(C_IC_NA_1, typeIds[1]);
+    TEST_ASSERT_EQUAL_INT(C_RD_NA_1, typeIds[2]);
 
-    /* check that multiple buffer entries were removed */
-    TEST_ASSERT_TRUE(count2 + 1 < count1);
+    CS101_Master_destroy(master);
+    SerialPort_close(port);
+    SerialPort_destroy(port);
+    close(pty);
+}
 
-    info.asduHandlerCalled = 0;
+void
+test_CS101_MasterUnbalanced_AdaptiveTimeouts(void)
+{
+    char ptyName[50];
 
-    bool result = CS104_Connection_connect(con);
-    TEST_ASSERT_TRUE(result);
+    int pty = openPseudoTerminal(ptyName);
 
-    CS104_Connection_sendStartDT(con);
+    TEST_ASSERT_TRUE(pty >= 0);
 
-    Thread_sleep(500);
+    SerialPort port = SerialPort_create(ptyName, 9600, 8, 'E', 1);
 
-    CS104_Connection_close(con);
+    TEST_ASSERT_TRUE(SerialPort_open(port));
 
-    TEST_ASSERT_EQUAL_INT(count2, info.asduHandlerCalled);
+    CS101_Master master = CS101_Master_create(port, NULL, NULL, IEC60870_LINK_LAYER_UNBALANCED);
 
-    CS104_Connection_destroy(con);
+    /* fixed timeoutForAck is 200 ms */
+    CS101_Master_setAdaptiveTimeouts(master, true, 20, 1000);
 
-    CS104_Slave_destroy(slave);
+    CS101_Master_addSlave(master, 1);
+    CS101_Master_setSlavePollIntervals(master, 1, 0, 20);
+
+    CS101_Master_start(master);
+
+    int answeredRequests = 0;
+    uint64_t unansweredRequestTime = 0;
+    uint64_t repeatDelay = 0;
+
+    uint8_t buffer[100];
+    int bufferSize = 0;
+
+    uint64_t startTime = Hal_getTimeInMs();
+
+    while ((repeatDelay == 0) && (Hal_getTimeInMs() - startTime < 2000)) {
+        int readBytes = read(pty, buffer + bufferSize, sizeof(buffer) - bufferSize);
+
+        if (readBytes > 0)
+            bufferSize += readBytes;
+        else
+            Thread_sleep(1);
+
+        while (bufferSize >= 5) {
+            if (buffer[0] != 0x10) {
+                memmove(buffer, buffer + 1, --bufferSize);
+                continue;
+            }
+
+            if ((buffer[1] & 0x0f) == 11) { /* request class 2 data */
+                if (answeredRequests < 10) {
+                    uint8_t ack = 0xe5;
+
+                    TEST_ASSERT_EQUAL_INT(1, write(pty, &ack, 1));
+
+                    answeredRequests++;
+                }
+                else if (unansweredRequestTime == 0)
+                    unansweredRequestTime = Hal_getTimeInMs();
+                else
+                    repeatDelay = Hal_getTimeInMs() - unansweredRequestTime;
+            }
+            else {
+                uint8_t ack = 0xe5;
+
+                TEST_ASSERT_EQUAL_INT(1, write(pty, &ack, 1));
+            }
+
+            bufferSize -= 5;
+            memmove(buffer, buffer + 5, bufferSize);
+        }
+    }
+
+    CS101_Master_stop(master);
+
+    TEST_ASSERT_EQUAL_INT(10, answeredRequests);
+
+    /* repetition after the measured response time instead of the fixed 200 ms */
+    TEST_ASSERT_TRUE(repeatDelay > 0);
+    TEST_ASSERT_TRUE(repeatDelay < 150);
+
+    CS101_Master_destroy(master);
+    SerialPort_close(port);
+    SerialPort_destroy(port);
+    close(pty);
 }
+#endif /* defined(__linux__) */
+
+static bool
+virtualLineASDUReceivedHandler(void* parameter, int address, CS101_ASDU asdu)
+{
+    int* receivedValue = (int*) parameter;
+
+    if (CS101_ASDU_getTypeID(asdu) == M_ME_NB_1) {
+        MeasuredValueScaled io = (MeasuredValueScaled) CS101_ASDU_getElement(asdu, 0);
 
+        *receivedValue = MeasuredValueScaled_getValue(io);
+
+        MeasuredValueScaled_destroy(io);
+    }
+
+    return true;
+}
 
 void
-test_IpAddressHandling(void)
+test_CS101_VirtualLine_MasterSlaveUnbalanced(void)
 {
-    struct sCS104_IPAddress ipAddr1;
+    /* 1200 baud -> ~9 ms per character */
+    CS101_VirtualLine line = CS101_VirtualLine_create(1200);
 
-    CS104_IPAddress_setFromString(&ipAddr1, "192.168.34.25");
+    CS101_Transport transport1 = CS101_VirtualLine_addEndpoint(line);
+    CS101_Transport transport2 = CS101_VirtualLine_addEndpoint(line);
 
-    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV4, ipAddr1.type);
-    TEST_ASSERT_EQUAL_UINT8(192, ipAddr1.address[0]);
-    TEST_ASSERT_EQUAL_UINT8(168, ipAddr1.address[1]);
-    TEST_ASSERT_EQUAL_UINT8(34, ipAddr1.address[2]);
-    TEST_ASSERT_EQUAL_UINT8(25, ipAddr1.address[3]);
+    uint8_t data[10] = { 0x10, 0x49, 0x01, 0x4a, 0x16, 0x10, 0x49, 0x01, 0x4a, 0x16 };
+    uint8_t buffer[20];
 
-    CS104_IPAddress_setFromString(&ipAddr1, "1:22:333:aaaa:b:c:d:e");
-    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV6, ipAddr1.type);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[0]);
-    TEST_ASSERT_EQUAL_UINT8(0x01, ipAddr1.address[1]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[2]);
-    TEST_ASSERT_EQUAL_UINT8(0x22, ipAddr1.address[3]);
-    TEST_ASSERT_EQUAL_UINT8(0x03, ipAddr1.address[4]);
-    TEST_ASSERT_EQUAL_UINT8(0x33, ipAddr1.address[5]);
-    TEST_ASSERT_EQUAL_UINT8(0xaa, ipAddr1.address[6]);
-    TEST_ASSERT_EQUAL_UINT8(0xaa, ipAddr1.address[7]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[8]);
-    TEST_ASSERT_EQUAL_UINT8(0x0b, ipAddr1.address[9]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[10]);
-    TEST_ASSERT_EQUAL_UINT8(0x0c, ipAddr1.address[11]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[12]);
-    TEST_ASSERT_EQUAL_UINT8(0x0d, ipAddr1.address[13]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[14]);
-    TEST_ASSERT_EQUAL_UINT8(0x0e, ipAddr1.address[15]);
+    uint64_t startTime = Hal_getTimeInMs();
 
-    CS104_IPAddress_setFromString(&ipAddr1, "::2001:db8");
-    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV6, ipAddr1.type);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[0]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[1]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[2]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[3]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[4]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[5]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[6]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[7]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[8]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[9]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[10]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[11]);
-    TEST_ASSERT_EQUAL_UINT8(0x20, ipAddr1.address[12]);
-    TEST_ASSERT_EQUAL_UINT8(0x01, ipAddr1.address[13]);
-    TEST_ASSERT_EQUAL_UINT8(0x0d, ipAddr1.address[14]);
-    TEST_ASSERT_EQUAL_UINT8(0xb8, ipAddr1.address[15]);
+    TEST_ASSERT_EQUAL_INT(10, transport1->write(transport1->parameter, data, 10));
 
-    CS104_IPAddress_setFromString(&ipAddr1, "fe80::70d2:6cba:a994:2ced");
-    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV6, ipAddr1.type);
-    TEST_ASSERT_EQUAL_UINT8(0xfe, ipAddr1.address[0]);
-    TEST_ASSERT_EQUAL_UINT8(0x80, ipAddr1.address[1]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[2]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[3]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[4]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[5]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[6]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[7]);
-    TEST_ASSERT_EQUAL_UINT8(0x70, ipAddr1.address[8]);
-    TEST_ASSERT_EQUAL_UINT8(0xd2, ipAddr1.address[9]);
-    TEST_ASSERT_EQUAL_UINT8(0x6c, ipAddr1.address[10]);
-    TEST_ASSERT_EQUAL_UINT8(0xba, ipAddr1.address[11]);
-    TEST_ASSERT_EQUAL_UINT8(0xa9, ipAddr1.address[12]);
-    TEST_ASSERT_EQUAL_UINT8(0x94, ipAddr1.address[13]);
-    TEST_ASSERT_EQUAL_UINT8(0x2c, ipAddr1.address[14]);
-    TEST_ASSERT_EQUAL_UINT8(0xed, ipAddr1.address[15]);
+    /* the bytes are not received by the sender and not before they are transmitted */
+    TEST_ASSERT_EQUAL_INT(0, transport1->readBytes(transport1->parameter, buffer, sizeof(buffer), 0));
+    TEST_ASSERT_EQUAL_INT(0, transport2->readBytes(transport2->parameter, buffer, sizeof(buffer), 0));
 
-    CS104_IPAddress_setFromString(&ipAddr1, "2001:db8:1::ab9:C0A8:102");
-    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV6, ipAddr1.type);
-    TEST_ASSERT_EQUAL_UINT8(0x20, ipAddr1.address[0]);
-    TEST_ASSERT_EQUAL_UINT8(0x01, ipAddr1.address[1]);
-    TEST_ASSERT_EQUAL_UINT8(0x0d, ipAddr1.address[2]);
-    TEST_ASSERT_EQUAL_UINT8(0xb8, ipAddr1.address[3]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[4]);
-    TEST_ASSERT_EQUAL_UINT8(0x01, ipAddr1.address[5]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[6]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[7]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[8]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[9]);
-    TEST_ASSERT_EQUAL_UINT8(0x0a, ipAddr1.address[10]);
-    TEST_ASSERT_EQUAL_UINT8(0xb9, ipAddr1.address[11]);
-    TEST_ASSERT_EQUAL_UINT8(0xc0, ipAddr1.address[12]);
-    TEST_ASSERT_EQUAL_UINT8(0xa8, ipAddr1.address[13]);
-    TEST_ASSERT_EQUAL_UINT8(0x01, ipAddr1.address[14]);
-    TEST_ASSERT_EQUAL_UINT8(0x02, ipAddr1.address[15]);
+    int receivedBytes = 0;
 
-    CS104_IPAddress_setFromString(&ipAddr1, "::1");
-    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV6, ipAddr1.type);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[0]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[1]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[2]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[3]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[4]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[5]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[6]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[7]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[8]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[9]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[10]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[11]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[12]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[13]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[14]);
-    TEST_ASSERT_EQUAL_UINT8(0x01, ipAddr1.address[15]);
+    while ((receivedBytes < 10) && (Hal_getTimeInMs() - startTime < 1000))
+        receivedBytes += transport2->readBytes(transport2->parameter, buffer + receivedBytes, sizeof(buffer) - receivedBytes, 100);
 
-    CS104_IPAddress_setFromString(&ipAddr1, "::1");
-    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV6, ipAddr1.type);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[0]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[1]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[2]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[3]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[4]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[5]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[6]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[7]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[8]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[9]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[10]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[11]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[12]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[13]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[14]);
-    TEST_ASSERT_EQUAL_UINT8(0x01, ipAddr1.address[15]);
+    TEST_ASSERT_EQUAL_INT(10, receivedBytes);
+    TEST_ASSERT_EQUAL_MEMORY(data, buffer, 10);
+    TEST_ASSERT_TRUE(Hal_getTimeInMs() - startTime >= 80);
 
-    CS104_IPAddress_setFromString(&ipAddr1, "::");
-    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV6, ipAddr1.type);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[0]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[1]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[2]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[3]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[4]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[5]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[6]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[7]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[8]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[9]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[10]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[11]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[12]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[13]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[14]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[15]);
+    /* master and slave connected by the line */
+    CS101_Master master = CS101_Master_createWithTransport(transport1, NULL, NULL, IEC60870_LINK_LAYER_UNBALANCED, 10);
+    CS101_Slave slave = CS101_Slave_createWithTransport(transport2, NULL, NULL, IEC60870_LINK_LAYER_UNBALANCED, 10, 10);
 
-    CS104_IPAddress_setFromString(&ipAddr1, "fe80:2001::");
-    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV6, ipAddr1.type);
-    TEST_ASSERT_EQUAL_UINT8(0xfe, ipAddr1.address[0]);
-    TEST_ASSERT_EQUAL_UINT8(0x80, ipAddr1.address[1]);
-    TEST_ASSERT_EQUAL_UINT8(0x20, ipAddr1.address[2]);
-    TEST_ASSERT_EQUAL_UINT8(0x01, ipAddr1.address[3]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[4]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[5]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[6]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[7]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[8]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[9]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[10]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[11]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[12]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[13]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[14]);
-    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[15]);
-}
+    CS101_Slave_setLinkLayerAddress(slave, 1);
 
-void
-test_DoublePointInformation(void)
-{
-    DoublePointInformation dpi1;
-    DoublePointInformation dpi2;
-    DoublePointInformation dpi3;
+    int receivedValue = 0;
 
-    dpi1 = DoublePointInformation_create(NULL, 101, IEC60870_DOUBLE_POINT_OFF, IEC60870_QUALITY_INVALID);
-    dpi2 = DoublePointInformation_create(NULL, 102, IEC60870_DOUBLE_POINT_ON, IEC60870_QUALITY_BLOCKED);
-    dpi3 = DoublePointInformation_create(NULL, 103, IEC60870_DOUBLE_POINT_INDETERMINATE, IEC60870_QUALITY_GOOD);
+    CS101_Master_setASDUReceivedHandler(master, virtualLineASDUReceivedHandler, &receivedValue);
+    CS101_Master_addSlave(master, 1);
+    CS101_Master_setSlavePollIntervals(master, 1, 0, 10);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_OFF, DoublePointInformation_getValue(dpi1));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_ON, DoublePointInformation_getValue(dpi2));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_INDETERMINATE, DoublePointInformation_getValue(dpi3));
+    CS101_ASDU asdu = CS101_ASDU_create(CS101_Slave_getAppLayerParameters(slave), false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
 
-    uint8_t buffer[256];
+    InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 100, 1234, IEC60870_QUALITY_GOOD);
 
-    struct sBufferFrame bf;
+    CS101_ASDU_addInformationObject(asdu, io);
+    CS101_Slave_enqueueUserDataClass2(slave, asdu);
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    InformationObject_destroy(io);
+    CS101_ASDU_destroy(asdu);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    startTime = Hal_getTimeInMs();
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi2);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi3);
+    while ((receivedValue == 0) && (Hal_getTimeInMs() - startTime < 3000)) {
+        CS101_Master_run(master);
+        CS101_Slave_run(slave);
+    }
 
-    InformationObject_destroy((InformationObject) dpi1);
-    InformationObject_destroy((InformationObject) dpi2);
-    InformationObject_destroy((InformationObject) dpi3);
+    TEST_ASSERT_EQUAL_INT(1234, receivedValue);
+    TEST_ASSERT_TRUE(CS101_VirtualLine_getSentBytes(line) > 10);
+    TEST_ASSERT_EQUAL_INT(0, (int) CS101_VirtualLine_getCorruptedBytes(line));
 
-    CS101_ASDU_encode(asdu, f);
+    CS101_Master_destroy(master);
+    CS101_Slave_destroy(slave);
+    CS101_VirtualLine_destroy(line);
+}
 
-    TEST_ASSERT_EQUAL_INT(18, Frame_getMsgSize(f));
+static bool
+longFrameASDUHandler(void* parameter, IMasterConnection connection, CS101_ASDU asdu)
+{
+    int* receivedAsdus = (int*) parameter;
 
-    CS101_ASDU_destroy(asdu);
+    (void)connection;
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    if (CS101_ASDU_getTypeID(asdu) == M_ME_NB_1)
+        (*receivedAsdus)++;
 
-    TEST_ASSERT_EQUAL_INT(3, CS101_ASDU_getNumberOfElements(asdu2));
+    return true;
+}
 
-    DoublePointInformation dpi1_dec = (DoublePointInformation) CS101_ASDU_getElement(asdu2, 0);
-    DoublePointInformation dpi2_dec = (DoublePointInformation) CS101_ASDU_getElement(asdu2, 1);
-    DoublePointInformation dpi3_dec = (DoublePointInformation) CS101_ASDU_getElement(asdu2, 2);
+static void
+longFrameLinkLayerStateChanged(void* parameter, int address, LinkLayerState state)
+{
+    int* errors = (int*) parameter;
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )dpi1_dec));
-    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )dpi2_dec));
-    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )dpi3_dec));
+    (void)address;
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, DoublePointInformation_getQuality(dpi1_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_OFF, DoublePointInformation_getValue(dpi1_dec));
+    if (state == LL_STATE_ERROR)
+        (*errors)++;
+}
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, DoublePointInformation_getQuality(dpi2_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_ON, DoublePointInformation_getValue(dpi2_dec));
+void
+test_CS101_VirtualLine_LongFrameAtLowBaudRate(void)
+{
+    /* 1200 baud -> ~9 ms per character. The default timeoutForAck (200 ms) is much shorter than the frame */
+    CS101_VirtualLine line = CS101_VirtualLine_create(1200);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, DoublePointInformation_getQuality(dpi3_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_INDETERMINATE, DoublePointInformation_getValue(dpi3_dec));
+    CS101_Master master = CS101_Master_createWithTransport(CS101_VirtualLine_addEndpoint(line), NULL, NULL, IEC60870_LINK_LAYER_BALANCED, 10);
+    CS101_Slave slave = CS101_Slave_createWithTransport(CS101_VirtualLine_addEndpoint(line), NULL, NULL, IEC60870_LINK_LAYER_BALANCED, 10, 10);
 
-    InformationObject_destroy((InformationObject) dpi1_dec);
-    InformationObject_destroy((InformationObject) dpi2_dec);
-    InformationObject_destroy((InformationObject) dpi3_dec);
+    CS101_Master_setOwnAddress(master, 2);
+    CS101_Master_useSlaveAddress(master, 3);
+    CS101_Slave_setLinkLayerAddress(slave, 3);
+    CS101_Slave_setLinkLayerAddressOtherStation(slave, 2);
 
-    CS101_ASDU_destroy(asdu2);
-}
+    int linkLayerErrors = 0;
+    int receivedAsdus = 0;
 
-void
-test_SinglePointInformation(void)
-{
-    SinglePointInformation spi1;
-    SinglePointInformation spi2;
-    SinglePointInformation spi3;
-    SinglePointInformation spi4;
+    CS101_Master_setLinkLayerStateChanged(master, longFrameLinkLayerStateChanged, &linkLayerErrors);
+    CS101_Slave_setASDUHandler(slave, longFrameASDUHandler, &receivedAsdus);
 
-    spi1 = SinglePointInformation_create(NULL, 101, true, IEC60870_QUALITY_INVALID);
-    spi2 = SinglePointInformation_create(NULL, 102, false, IEC60870_QUALITY_BLOCKED);
-    spi3 = SinglePointInformation_create(NULL, 103, true, IEC60870_QUALITY_GOOD);
+    /* ASDU with the maximum size -> frame with 255 bytes (~2.3 s) */
+    CS101_ASDU asdu = CS101_ASDU_create(CS101_Slave_getAppLayerParameters(slave), false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
 
-    /* invalid quality bit (overflow) is expected to be ignored */
-    spi4 = SinglePointInformation_create(NULL, 104, false, IEC60870_QUALITY_OVERFLOW);
+    int ioa = 100;
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, SinglePointInformation_getQuality(spi1));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, SinglePointInformation_getQuality(spi2));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, SinglePointInformation_getQuality(spi3));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, SinglePointInformation_getQuality(spi4));
-    TEST_ASSERT_TRUE(SinglePointInformation_getValue(spi1));
+    while (true) {
+        struct sMeasuredValueScaled _io;
 
-    uint8_t buffer[256];
+        if (CS101_ASDU_addInformationObject(asdu, (InformationObject) MeasuredValueScaled_create(&_io, ioa++, 1, IEC60870_QUALITY_GOOD)) == false)
+            break;
+    }
 
-    struct sBufferFrame bf;
+    TEST_ASSERT_TRUE(CS101_ASDU_getPayloadSize(asdu) > 230);
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    /* master and slave in own threads -> the master checks the timeout while the frame is received by the slave */
+    CS101_Master_start(master);
+    CS101_Slave_start(slave);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    /* reset of the links in both directions */
+    Thread_sleep(500);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi2);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi3);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi4);
+    uint64_t sentBytes = CS101_VirtualLine_getSentBytes(line);
 
-    SinglePointInformation_destroy(spi1);
-    SinglePointInformation_destroy(spi2);
-    SinglePointInformation_destroy(spi3);
-    SinglePointInformation_destroy(spi4);
+    CS101_Master_sendASDU(master, asdu);
 
-    CS101_ASDU_encode(asdu, f);
+    uint64_t startTime = Hal_getTimeInMs();
 
-    TEST_ASSERT_EQUAL_INT(22, Frame_getMsgSize(f));
+    while ((receivedAsdus == 0) && (Hal_getTimeInMs() - startTime < 6000))
+        Thread_sleep(10);
 
-    CS101_ASDU_destroy(asdu);
+    /* wait for the confirmation (a repetition would be sent after the timeout) */
+    Thread_sleep(500);
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    CS101_Master_stop(master);
+    CS101_Slave_stop(slave);
 
-    TEST_ASSERT_EQUAL_INT(4, CS101_ASDU_getNumberOfElements(asdu2));
+    /* the frame is sent only once and the link stays available */
+    TEST_ASSERT_EQUAL_INT(1, receivedAsdus);
+    TEST_ASSERT_EQUAL_INT(0, linkLayerErrors);
+    TEST_ASSERT_TRUE(CS101_VirtualLine_getSentBytes(line) - sentBytes < 2 * 255);
 
-    SinglePointInformation spi1_dec = (SinglePointInformation) CS101_ASDU_getElement(asdu2, 0);
-    SinglePointInformation spi2_dec = (SinglePointInformation) CS101_ASDU_getElement(asdu2, 1);
-    SinglePointInformation spi3_dec = (SinglePointInformation) CS101_ASDU_getElement(asdu2, 2);
-    SinglePointInformation spi4_dec = (SinglePointInformation) CS101_ASDU_getElement(asdu2, 3);
+    CS101_ASDU_destroy(asdu);
+    CS101_Master_destroy(master);
+    CS101_Slave_destroy(slave);
+    CS101_VirtualLine_destroy(line);
+}
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject)spi1_dec));
-    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject)spi2_dec));
-    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject)spi3_dec));
-    TEST_ASSERT_EQUAL_INT(104, InformationObject_getObjectAddress((InformationObject)spi4_dec));
+static bool
+logicalSlavesASDUReceivedHandler(void* parameter, int address, CS101_ASDU asdu)
+{
+    int* receivedValues = (int*) parameter;
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, SinglePointInformation_getQuality(spi1_dec));
-    TEST_ASSERT_TRUE(SinglePointInformation_getValue(spi1_dec));
+    if ((CS101_ASDU_getTypeID(asdu) == M_ME_NB_1) && (address < 20)) {
+        MeasuredValueScaled io = (MeasuredValueScaled) CS101_ASDU_getElement(asdu, 0);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, SinglePointInformation_getQuality(spi2_dec));
-    TEST_ASSERT_FALSE(SinglePointInformation_getValue(spi2_dec));
+        receivedValues[address] = MeasuredValueScaled_getValue(io);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, SinglePointInformation_getQuality(spi3_dec));
-    TEST_ASSERT_TRUE(SinglePointInformation_getValue(spi3_dec));
+        MeasuredValueScaled_destroy(io);
+    }
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, SinglePointInformation_getQuality(spi4_dec));
-    TEST_ASSERT_FALSE(SinglePointInformation_getValue(spi4_dec));
+    return true;
+}
 
-    SinglePointInformation_destroy(spi1_dec);
-    SinglePointInformation_destroy(spi2_dec);
-    SinglePointInformation_destroy(spi3_dec);
-    SinglePointInformation_destroy(spi4_dec);
+static void
+enqueueClass2Value(CS101_Slave slave, int value)
+{
+    CS101_ASDU asdu = CS101_ASDU_create(CS101_Slave_getAppLayerParameters(slave), false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
 
-    CS101_ASDU_destroy(asdu2);
+    InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 100, value, IEC60870_QUALITY_GOOD);
+
+    CS101_ASDU_addInformationObject(asdu, io);
+    CS101_Slave_enqueueUserDataClass2(slave, asdu);
+
+    InformationObject_destroy(io);
+    CS101_ASDU_destroy(asdu);
 }
 
 void
-test_DoublePointWithCP24Time2a(void)
+test_CS101_Slave_LogicalSlavesOnOneLine(void)
 {
-    DoublePointWithCP24Time2a dpi1;
-    DoublePointWithCP24Time2a dpi2;
-    DoublePointWithCP24Time2a dpi3;
+    CS101_VirtualLine line = CS101_VirtualLine_create(0);
 
-    uint64_t time1 = Hal_getTimeInMs();
-    uint64_t time2 = time1 + 1000;
-    uint64_t time3 = time2 + 1000;
+    CS101_Master master = CS101_Master_createWithTransport(CS101_VirtualLine_addEndpoint(line), NULL, NULL, IEC60870_LINK_LAYER_UNBALANCED, 10);
+    CS101_Slave slave = CS101_Slave_createWithTransport(CS101_VirtualLine_addEndpoint(line), NULL, NULL, IEC60870_LINK_LAYER_UNBALANCED, 10, 10);
 
-    struct sCP24Time2a cpTime1;
-    struct sCP24Time2a cpTime2;
-    struct sCP24Time2a cpTime3;
+    CS101_Slave_setLinkLayerAddress(slave, 3);
 
-    bzero(&cpTime1, sizeof(struct sCP24Time2a));
-    bzero(&cpTime2, sizeof(struct sCP24Time2a));
-    bzero(&cpTime3, sizeof(struct sCP24Time2a));
+    CS101_Slave logicalSlave1 = CS101_Slave_addLogicalSlave(slave, 7, 10, 10);
+    CS101_Slave logicalSlave2 = CS101_Slave_addLogicalSlave(slave, 12, 10, 10);
 
-    CP24Time2a_setMinute(&cpTime1, 12);
-    CP24Time2a_setMillisecond(&cpTime1, 24123);
+    TEST_ASSERT_NOT_NULL(logicalSlave1);
+    TEST_ASSERT_NOT_NULL(logicalSlave2);
 
-    CP24Time2a_setMinute(&cpTime2, 54);
-    CP24Time2a_setMillisecond(&cpTime2, 12345);
+    /* address already in use */
+    TEST_ASSERT_NULL(CS101_Slave_addLogicalSlave(slave, 7, 10, 10));
 
-    CP24Time2a_setMinute(&cpTime3, 00);
-    CP24Time2a_setMillisecond(&cpTime3, 00001);
+    enqueueClass2Value(slave, 300);
+    enqueueClass2Value(logicalSlave1, 700);
+    enqueueClass2Value(logicalSlave2, 1200);
 
-    dpi1 = DoublePointWithCP24Time2a_create(NULL, 101, IEC60870_DOUBLE_POINT_OFF, IEC60870_QUALITY_INVALID, &cpTime1);
-    dpi2 = DoublePointWithCP24Time2a_create(NULL, 102, IEC60870_DOUBLE_POINT_ON, IEC60870_QUALITY_BLOCKED, &cpTime2);
-    dpi3 = DoublePointWithCP24Time2a_create(NULL, 103, IEC60870_DOUBLE_POINT_INDETERMINATE, IEC60870_QUALITY_GOOD, &cpTime3);
+    int receivedValues[20];
+    memset(receivedValues, 0, sizeof(receivedValues));
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, DoublePointInformation_getQuality((DoublePointInformation )dpi1));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, DoublePointInformation_getQuality((DoublePointInformation )dpi2));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, DoublePointInformation_getQuality((DoublePointInformation )dpi3));
-    TEST_ASSERT_TRUE(DoublePointInformation_getQuality((DoublePointInformation )dpi1));
+    CS101_Master_setASDUReceivedHandler(master, logicalSlavesASDUReceivedHandler, receivedValues);
 
-    uint8_t buffer[256];
+    int addresses[] = { 3, 7, 12, 15 };
+    int i;
 
-    struct sBufferFrame bf;
+    for (i = 0; i < 4; i++) {
+        CS101_Master_addSlave(master, addresses[i]);
+        CS101_Master_setSlavePollIntervals(master, addresses[i], 0, 10);
+    }
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    uint64_t startTime = Hal_getTimeInMs();
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    while (((receivedValues[3] == 0) || (receivedValues[7] == 0) || (receivedValues[12] == 0)) &&
+            (Hal_getTimeInMs() - startTime < 3000))
+    {
+        CS101_Master_run(master);
+        CS101_Slave_run(slave);
+    }
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi2);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi3);
+    TEST_ASSERT_EQUAL_INT(300, receivedValues[3]);
+    TEST_ASSERT_EQUAL_INT(700, receivedValues[7]);
+    TEST_ASSERT_EQUAL_INT(1200, receivedValues[12]);
 
-    InformationObject_destroy((InformationObject) dpi1);
-    InformationObject_destroy((InformationObject) dpi2);
-    InformationObject_destroy((InformationObject) dpi3);
+    /* no station with address 15 */
+    TEST_ASSERT_EQUAL_INT(0, receivedValues[15]);
 
-    CS101_ASDU_encode(asdu, f);
+    /* a logical slave can be destroyed before its parent */
+    CS101_Slave_destroy(logicalSlave1);
 
-    TEST_ASSERT_EQUAL_INT(27, Frame_getMsgSize(f));
+    CS101_Master_destroy(master);
+    CS101_Slave_destroy(slave);
+    CS101_VirtualLine_destroy(line);
+}
 
-    CS101_ASDU_destroy(asdu);
+void
+test_CS104SlaveMultipleMessagesInOneSegment()
+{
+    /* STARTDT_ACT and TESTFR_ACT sent with a single write */
+    uint8_t request[] = { 0x68, 0x04, 0x07, 0x00, 0x00, 0x00, 0x68, 0x04, 0x43, 0x00, 0x00, 0x00 };
+    uint8_t response[12];
+    int received = 0;
+    int retries = 100;
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    CS104_Slave slave = CS104_Slave_create(10, 10);
 
-    TEST_ASSERT_EQUAL_INT(3, CS101_ASDU_getNumberOfElements(asdu2));
+    CS104_Slave_setLocalPort(slave, 20007);
 
-    DoublePointWithCP24Time2a dpi1_dec = (DoublePointWithCP24Time2a) CS101_ASDU_getElement(asdu2, 0);
-    DoublePointWithCP24Time2a dpi2_dec = (DoublePointWithCP24Time2a) CS101_ASDU_getElement(asdu2, 1);
-    DoublePointWithCP24Time2a dpi3_dec = (DoublePointWithCP24Time2a) CS101_ASDU_getElement(asdu2, 2);
+    CS104_Slave_start(slave);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )dpi1_dec));
-    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )dpi2_dec));
-    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )dpi3_dec));
+    Socket socket = TcpSocket_create();
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, DoublePointInformation_getQuality((DoublePointInformation )dpi1_dec));
-    TEST_ASSERT_TRUE(DoublePointInformation_getQuality((DoublePointInformation )dpi1_dec));
-    CP24Time2a time1_dec = DoublePointWithCP24Time2a_getTimestamp(dpi1_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time1_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time1_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time1_dec));
+    TEST_ASSERT_TRUE(Socket_connect(socket, "127.0.0.1", 20007));
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, DoublePointInformation_getQuality((DoublePointInformation )dpi2_dec));
-    TEST_ASSERT_TRUE(DoublePointInformation_getQuality((DoublePointInformation )dpi2_dec));
-    CP24Time2a time2_dec = DoublePointWithCP24Time2a_getTimestamp(dpi2_dec);
-    TEST_ASSERT_EQUAL_INT(54, CP24Time2a_getMinute(time2_dec));
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getSecond(time2_dec));
-    TEST_ASSERT_EQUAL_INT(345, CP24Time2a_getMillisecond(time2_dec));
+    TEST_ASSERT_EQUAL_INT(sizeof(request), Socket_write(socket, request, sizeof(request)));
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, DoublePointInformation_getQuality((DoublePointInformation )dpi3_dec));
-    TEST_ASSERT_TRUE(DoublePointInformation_getValue((DoublePointInformation )dpi3_dec));
-    CP24Time2a time3_dec = DoublePointWithCP24Time2a_getTimestamp(dpi3_dec);
-    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getMinute(time3_dec));
-    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getSecond(time3_dec));
-    TEST_ASSERT_EQUAL_INT(1, CP24Time2a_getMillisecond(time3_dec));
+    while ((received < (int) sizeof(response)) && (retries-- > 0)) {
+        int readBytes = Socket_read(socket, response + received, sizeof(response) - received);
 
-    InformationObject_destroy((InformationObject) dpi1_dec);
-    InformationObject_destroy((InformationObject) dpi2_dec);
-    InformationObject_destroy((InformationObject) dpi3_dec);
+        TEST_ASSERT_TRUE(readBytes >= 0);
 
-    CS101_ASDU_destroy(asdu2);
-}
+        received += readBytes;
 
-void
-test_SinglePointWithCP24Time2a(void)
-{
-    SinglePointWithCP24Time2a spi1;
-    SinglePointWithCP24Time2a spi2;
-    SinglePointWithCP24Time2a spi3;
+        if (received < (int) sizeof(response))
+            Thread_sleep(10);
+    }
 
-    uint64_t time1 = Hal_getTimeInMs();
-    uint64_t time2 = time1 + 1000;
-    uint64_t time3 = time2 + 1000;
+    TEST_ASSERT_EQUAL_INT(sizeof(response), received);
 
-    struct sCP24Time2a cpTime1;
-    struct sCP24Time2a cpTime2;
-    struct sCP24Time2a cpTime3;
+    /* STARTDT_CON */
+    TEST_ASSERT_EQUAL_UINT8(0x0b, response[2]);
 
-    bzero(&cpTime1, sizeof(struct sCP24Time2a));
-    bzero(&cpTime2, sizeof(struct sCP24Time2a));
-    bzero(&cpTime3, sizeof(struct sCP24Time2a));
+    /* TESTFR_CON */
+    TEST_ASSERT_EQUAL_UINT8(0x83, response[8]);
 
-    CP24Time2a_setMinute(&cpTime1, 12);
-    CP24Time2a_setMillisecond(&cpTime1, 24123);
+    Socket_destroy(socket);
 
-    CP24Time2a_setMinute(&cpTime2, 54);
-    CP24Time2a_setMillisecond(&cpTime2, 12345);
+    CS104_Slave_destroy(slave);
+}
 
-    CP24Time2a_setMinute(&cpTime3, 00);
-    CP24Time2a_setMillisecond(&cpTime3, 00001);
+struct sSlowConsumerEvents {
+    int slowConsumerEvents;
+    int closedEvents;
+    uint64_t firstSlowConsumerTime;
+    uint64_t closedTime;
+};
 
-    spi1 = SinglePointWithCP24Time2a_create(NULL, 101, true, IEC60870_QUALITY_INVALID, &cpTime1);
-    spi2 = SinglePointWithCP24Time2a_create(NULL, 102, false, IEC60870_QUALITY_BLOCKED, &cpTime2);
-    spi3 = SinglePointWithCP24Time2a_create(NULL, 103, true, IEC60870_QUALITY_GOOD, &cpTime3);
+static void
+slowConsumerEventHandler(void* parameter, IMasterConnection connection, CS104_PeerConnectionEvent event)
+{
+    struct sSlowConsumerEvents* events = (struct sSlowConsumerEvents*) parameter;
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, SinglePointInformation_getQuality((SinglePointInformation)spi1));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, SinglePointInformation_getQuality((SinglePointInformation)spi2));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, SinglePointInformation_getQuality((SinglePointInformation)spi3));
-    TEST_ASSERT_TRUE(SinglePointInformation_getValue((SinglePointInformation)spi1));
+    if (event == CS104_CON_EVENT_SLOW_CONSUMER) {
+        if (events->slowConsumerEvents == 0)
+            events->firstSlowConsumerTime = Hal_getTimeInMs();
 
-    uint8_t buffer[256];
+        events->slowConsumerEvents++;
+    }
+    else if (event == CS104_CON_EVENT_CONNECTION_CLOSED) {
+        events->closedTime = Hal_getTimeInMs();
+        events->closedEvents++;
+    }
+}
 
-    struct sBufferFrame bf;
+/* configures small socket buffers for more data than the socket buffers can take */
+static void
+configureSlowConsumerSlave(CS104_Slave slave, struct sSlowConsumerEvents* events, int numberOfAsdus)
+{
+    struct sSocketOptions socketOptions;
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
+    CS104_Slave_setLocalPort(slave, 20007);
+    CS104_Slave_setConnectionEventHandler(slave, slowConsumerEventHandler, events);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    /* the data is not confirmed by the peer */
+    CS104_Slave_getConnectionParameters(slave)->k = numberOfAsdus;
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi2);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi3);
+    SocketOptions_init(&socketOptions);
+    socketOptions.sendBufferSize = 4096;
 
-    InformationObject_destroy((InformationObject) spi1);
-    InformationObject_destroy((InformationObject) spi2);
-    InformationObject_destroy((InformationObject) spi3);
+    CS104_Slave_setSocketOptions(slave, &socketOptions);
+}
 
-    CS101_ASDU_encode(asdu, f);
+static void
+enqueueSlowConsumerData(CS104_Slave slave, int numberOfAsdus)
+{
+    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
 
-    TEST_ASSERT_EQUAL_INT(27, Frame_getMsgSize(f));
+    int i;
 
-    CS101_ASDU_destroy(asdu);
+    for (i = 0; i < numberOfAsdus; i++) {
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, true, CS101_COT_SPONTANEOUS, 0, 1, false, false);
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+        int j;
 
-    TEST_ASSERT_EQUAL_INT(3, CS101_ASDU_getNumberOfElements(asdu2));
+        for (j = 0; j < 30; j++) {
+            InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 100 + j, (int16_t) i, IEC60870_QUALITY_GOOD);
 
-    SinglePointWithCP24Time2a spi1_dec = (SinglePointWithCP24Time2a) CS101_ASDU_getElement(asdu2, 0);
-    SinglePointWithCP24Time2a spi2_dec = (SinglePointWithCP24Time2a) CS101_ASDU_getElement(asdu2, 1);
-    SinglePointWithCP24Time2a spi3_dec = (SinglePointWithCP24Time2a) CS101_ASDU_getElement(asdu2, 2);
+            CS101_ASDU_addInformationObject(newAsdu, io);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject)spi1_dec));
-    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject)spi2_dec));
-    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject)spi3_dec));
+            InformationObject_destroy(io);
+        }
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, SinglePointInformation_getQuality((SinglePointInformation)spi1_dec));
-    TEST_ASSERT_TRUE(SinglePointInformation_getValue((SinglePointInformation)spi1_dec));
-    CP24Time2a time1_dec = SinglePointWithCP24Time2a_getTimestamp(spi1_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time1_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time1_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time1_dec));
+        CS104_Slave_enqueueASDU(slave, newAsdu);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, SinglePointInformation_getQuality((SinglePointInformation)spi2_dec));
-    TEST_ASSERT_FALSE(SinglePointInformation_getValue((SinglePointInformation)spi2_dec));
-    CP24Time2a time2_dec = SinglePointWithCP24Time2a_getTimestamp(spi2_dec);
-    TEST_ASSERT_EQUAL_INT(54, CP24Time2a_getMinute(time2_dec));
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getSecond(time2_dec));
-    TEST_ASSERT_EQUAL_INT(345, CP24Time2a_getMillisecond(time2_dec));
+        CS101_ASDU_destroy(newAsdu);
+    }
+}
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, SinglePointInformation_getQuality((SinglePointInformation)spi3_dec));
-    TEST_ASSERT_TRUE(SinglePointInformation_getValue((SinglePointInformation)spi3_dec));
-    CP24Time2a time3_dec = SinglePointWithCP24Time2a_getTimestamp(spi3_dec);
-    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getMinute(time3_dec));
-    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getSecond(time3_dec));
-    TEST_ASSERT_EQUAL_INT(1, CP24Time2a_getMillisecond(time3_dec));
+/* connects a client that sends STARTDT_ACT and then doesn't read */
+static Socket
+connectSlowConsumer(void)
+{
+    uint8_t startDtAct[] = { 0x68, 0x04, 0x07, 0x00, 0x00, 0x00 };
+    struct sSocketOptions socketOptions;
 
-    InformationObject_destroy((InformationObject) spi1_dec);
-    InformationObject_destroy((InformationObject) spi2_dec);
-    InformationObject_destroy((InformationObject) spi3_dec);
+    SocketOptions_init(&socketOptions);
+    socketOptions.receiveBufferSize = 4096;
 
-    CS101_ASDU_destroy(asdu2);
+    Socket socket = TcpSocket_create();
+
+    Socket_setOptions(socket, &socketOptions);
+
+    TEST_ASSERT_TRUE(Socket_connect(socket, "127.0.0.1", 20007));
+
+    TEST_ASSERT_EQUAL_INT(sizeof(startDtAct), Socket_write(socket, startDtAct, sizeof(startDtAct)));
+
+    return socket;
 }
+
 void
-test_DoublePointWithCP56Time2a(void)
+test_CS104SlaveSlowConsumerResume()
 {
-	DoublePointWithCP56Time2a dpi1;
-	DoublePointWithCP56Time2a dpi2;
-	DoublePointWithCP56Time2a dpi3;
+    struct sSlowConsumerEvents events;
 
-    uint64_t time1 = Hal_getTimeInMs();
-    uint64_t time2 = time1 + 1000;
-    uint64_t time3 = time2 + 1000;
+    memset(&events, 0, sizeof(events));
 
-    struct sCP56Time2a cpTime1;
-    struct sCP56Time2a cpTime2;
-    struct sCP56Time2a cpTime3;
+    CS104_Slave slave = CS104_Slave_create(500, 10);
 
-    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
-    CP56Time2a_createFromMsTimestamp(&cpTime2, time2);
-    CP56Time2a_createFromMsTimestamp(&cpTime3, time3);
+    configureSlowConsumerSlave(slave, &events, 500);
 
-    dpi1 = DoublePointWithCP56Time2a_create(NULL, 101, IEC60870_DOUBLE_POINT_OFF, IEC60870_QUALITY_INVALID, &cpTime1);
-    dpi2 = DoublePointWithCP56Time2a_create(NULL, 102, IEC60870_DOUBLE_POINT_ON, IEC60870_QUALITY_BLOCKED, &cpTime2);
-    dpi3 = DoublePointWithCP56Time2a_create(NULL, 103, IEC60870_DOUBLE_POINT_INDETERMINATE, IEC60870_QUALITY_GOOD, &cpTime3);
+    CS104_Slave_setSlowConsumerThresholds(slave, 200, 0);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, DoublePointInformation_getQuality((DoublePointInformation)dpi1));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, DoublePointInformation_getQuality((DoublePointInformation)dpi2));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, DoublePointInformation_getQuality((DoublePointInformation)dpi3));
-    TEST_ASSERT_TRUE(DoublePointInformation_getValue((DoublePointInformation)dpi1));
+    CS104_Slave_start(slave);
 
-    uint8_t buffer[256];
+    enqueueSlowConsumerData(slave, 500);
 
-    struct sBufferFrame bf;
+    Socket socket = connectSlowConsumer();
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    /* the frame that doesn't fit into the socket is kept in the output buffer */
+    uint64_t timeout = Hal_getTimeInMs() + 2000;
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    while ((Hal_getTimeInMs() < timeout) && (events.slowConsumerEvents == 0))
+        Thread_sleep(10);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi2);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi3);
+    TEST_ASSERT_TRUE(events.slowConsumerEvents > 0);
 
-    InformationObject_destroy((InformationObject) dpi1);
-    InformationObject_destroy((InformationObject) dpi2);
-    InformationObject_destroy((InformationObject) dpi3);
+    /* the connection is kept when no close time is configured */
+    Thread_sleep(300);
 
-    CS101_ASDU_encode(asdu, f);
+    TEST_ASSERT_EQUAL_INT(1, CS104_Slave_getOpenConnections(slave));
+    TEST_ASSERT_EQUAL_INT(0, events.closedEvents);
 
-    TEST_ASSERT_EQUAL_INT(39, Frame_getMsgSize(f));
+    /* the peer reads again -> the rest of the partially written frame and all other frames are received in order */
+    static uint8_t stream[500 * 256];
+    int received = 0;
+    int iFrames = 0;
+    int position = 0;
 
-    CS101_ASDU_destroy(asdu);
+    timeout = Hal_getTimeInMs() + 5000;
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    while ((Hal_getTimeInMs() < timeout) && (iFrames < 500)) {
+        int readBytes = Socket_read(socket, stream + received, sizeof(stream) - received);
 
-    TEST_ASSERT_EQUAL_INT(3, CS101_ASDU_getNumberOfElements(asdu2));
+        TEST_ASSERT_TRUE(readBytes >= 0);
 
-    DoublePointWithCP56Time2a dpi1_dec = (DoublePointWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
-    DoublePointWithCP56Time2a dpi2_dec = (DoublePointWithCP56Time2a) CS101_ASDU_getElement(asdu2, 1);
-    DoublePointWithCP56Time2a dpi3_dec = (DoublePointWithCP56Time2a) CS101_ASDU_getElement(asdu2, 2);
+        if (readBytes == 0) {
+            Thread_sleep(1);
+            continue;
+        }
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject)dpi1_dec));
-    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject)dpi2_dec));
-    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject)dpi3_dec));
+        received += readBytes;
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, DoublePointInformation_getQuality((DoublePointInformation)dpi1_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_OFF, DoublePointInformation_getValue((DoublePointInformation)dpi1_dec));
-    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(DoublePointWithCP56Time2a_getTimestamp(dpi1_dec)));
+        while ((received - position >= 2) && (received - position >= stream[position + 1] + 2)) {
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, DoublePointInformation_getQuality((DoublePointInformation)dpi2_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_ON, DoublePointInformation_getValue((DoublePointInformation)dpi2_dec));
-    TEST_ASSERT_EQUAL_UINT64(time2, CP56Time2a_toMsTimestamp(DoublePointWithCP56Time2a_getTimestamp(dpi2_dec)));
+            TEST_ASSERT_EQUAL_UINT8(0x68, stream[position]);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, DoublePointInformation_getQuality((DoublePointInformation)dpi3_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_INDETERMINATE, DoublePointInformation_getValue((DoublePointInformation)dpi3_dec));
-    TEST_ASSERT_EQUAL_UINT64(time3, CP56Time2a_toMsTimestamp(DoublePointWithCP56Time2a_getTimestamp(dpi3_dec)));
+            /* I frame */
+            if ((stream[position + 2] & 0x01) == 0) {
+                int sendSequenceNumber = (stream[position + 2] + (stream[position + 3] * 0x100)) / 2;
 
-    InformationObject_destroy((InformationObject) dpi1_dec);
-    InformationObject_destroy((InformationObject) dpi2_dec);
-    InformationObject_destroy((InformationObject) dpi3_dec);
+                TEST_ASSERT_EQUAL_INT(iFrames, sendSequenceNumber);
 
-    CS101_ASDU_destroy(asdu2);
+                iFrames++;
+            }
+
+            position += stream[position + 1] + 2;
+        }
+    }
+
+    TEST_ASSERT_EQUAL_INT(500, iFrames);
+    TEST_ASSERT_EQUAL_INT(received, position);
+
+    Socket_destroy(socket);
+
+    CS104_Slave_destroy(slave);
 }
 
 void
-test_SinglePointWithCP56Time2a(void)
+test_CS104SlaveSlowConsumerClose()
 {
-    SinglePointWithCP56Time2a spi1;
-    SinglePointWithCP56Time2a spi2;
-    SinglePointWithCP56Time2a spi3;
+    struct sSlowConsumerEvents events;
 
-    uint64_t time1 = Hal_getTimeInMs();
-    uint64_t time2 = time1 + 1000;
-    uint64_t time3 = time2 + 1000;
+    memset(&events, 0, sizeof(events));
 
-    struct sCP56Time2a cpTime1;
-    struct sCP56Time2a cpTime2;
-    struct sCP56Time2a cpTime3;
+    CS104_Slave slave = CS104_Slave_create(500, 10);
 
-    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
-    CP56Time2a_createFromMsTimestamp(&cpTime2, time2);
-    CP56Time2a_createFromMsTimestamp(&cpTime3, time3);
+    configureSlowConsumerSlave(slave, &events, 500);
 
-    spi1 = SinglePointWithCP56Time2a_create(NULL, 101, true, IEC60870_QUALITY_INVALID, &cpTime1);
-    spi2 = SinglePointWithCP56Time2a_create(NULL, 102, false, IEC60870_QUALITY_BLOCKED, &cpTime2);
-    spi3 = SinglePointWithCP56Time2a_create(NULL, 103, true, IEC60870_QUALITY_GOOD, &cpTime3);
+    CS104_Slave_setSlowConsumerThresholds(slave, 100, 500);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, SinglePointInformation_getQuality((SinglePointInformation)spi1));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, SinglePointInformation_getQuality((SinglePointInformation)spi2));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, SinglePointInformation_getQuality((SinglePointInformation)spi3));
-    TEST_ASSERT_TRUE(SinglePointInformation_getValue((SinglePointInformation)spi1));
+    CS104_Slave_start(slave);
 
-    uint8_t buffer[256];
+    enqueueSlowConsumerData(slave, 500);
 
-    struct sBufferFrame bf;
+    Socket socket = connectSlowConsumer();
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    uint64_t timeout = Hal_getTimeInMs() + 3000;
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    while ((Hal_getTimeInMs() < timeout) && (events.closedEvents == 0))
+        Thread_sleep(10);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi2);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi3);
+    /*
+     * The warning is raised first. The kernel can still take some data from time to time,
+     * then the output buffer is flushed and the warning is raised again for the next stall.
+     */
+    TEST_ASSERT_TRUE(events.slowConsumerEvents > 0);
+    TEST_ASSERT_EQUAL_INT(1, events.closedEvents);
 
-    InformationObject_destroy((InformationObject) spi1);
-    InformationObject_destroy((InformationObject) spi2);
-    InformationObject_destroy((InformationObject) spi3);
+    /* the connection is closed when the output was blocked for the close time */
+    TEST_ASSERT_TRUE(events.closedTime >= events.firstSlowConsumerTime + 350);
 
-    CS101_ASDU_encode(asdu, f);
+    timeout = Hal_getTimeInMs() + 1000;
 
-    TEST_ASSERT_EQUAL_INT(39, Frame_getMsgSize(f));
+    while ((Hal_getTimeInMs() < timeout) && (CS104_Slave_getOpenConnections(slave) > 0))
+        Thread_sleep(10);
 
-    CS101_ASDU_destroy(asdu);
+    TEST_ASSERT_EQUAL_INT(0, CS104_Slave_getOpenConnections(slave));
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    Socket_destroy(socket);
 
-    TEST_ASSERT_EQUAL_INT(3, CS101_ASDU_getNumberOfElements(asdu2));
+    CS104_Slave_destroy(slave);
+}
 
-    SinglePointWithCP56Time2a spi1_dec = (SinglePointWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
-    SinglePointWithCP56Time2a spi2_dec = (SinglePointWithCP56Time2a) CS101_ASDU_getElement(asdu2, 1);
-    SinglePointWithCP56Time2a spi3_dec = (SinglePointWithCP56Time2a) CS101_ASDU_getElement(asdu2, 2);
+void
+test_CS104SlaveEventQueueOverflow()
+{
+    CS104_Slave slave = CS104_Slave_create(10, 10);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject)spi1_dec));
-    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject)spi2_dec));
+    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS104_Slave_start(slave);
+
+    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
+
+    struct stest_CS104SlaveEventQueue1 info;
+    info.asduHandlerCalled = 0;
+    info.spontCount = 0;
+    info.lastScaledValue = 0;
+
+    int16_t scaledValue = 0;
+
+    int i;
+
+    for (int i = 0; i < 300; i++) {
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
+
+        scaledValue++;
+
+        CS101_ASDU_addInformationObject(newAsdu, io);
+
+        InformationObject_destroy(io);
+
+        CS104_Slave_enqueueASDU(slave, newAsdu);
+
+        CS101_ASDU_destroy(newAsdu);
+    }
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
+
+    bool result = CS104_Connection_connect(con);
+    TEST_ASSERT_TRUE(result);
+
+    CS104_Connection_sendStartDT(con);
+
+    Thread_sleep(500);
+
+    CS104_Connection_close(con);
+
+    int asduSize = 12;
+    int entrySize = sizeof(struct sTestMessageQueueEntryInfo) + asduSize;
+    int msgQueueCapacity = ((sizeof(struct sTestMessageQueueEntryInfo) + 256) * 10) / entrySize;
+
+    TEST_ASSERT_EQUAL_INT(299, info.lastScaledValue);
+    TEST_ASSERT_EQUAL_INT(msgQueueCapacity, info.asduHandlerCalled);
+
+    result = CS104_Connection_connect(con);
+    TEST_ASSERT_TRUE(result);
+
+    CS104_Connection_sendStartDT(con);
+
+    for (int i = 0; i < 150; i++) {
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
+
+        scaledValue++;
+
+        CS101_ASDU_addInformationObject(newAsdu, io);
+
+        InformationObject_destroy(io);
+
+        CS104_Slave_enqueueASDU(slave, newAsdu);
+
+        CS101_ASDU_destroy(newAsdu);
+
+        Thread_sleep(10);
+    }
+
+    Thread_sleep(500);
+
+    CS104_Connection_close(con);
+
+    TEST_ASSERT_EQUAL_INT(msgQueueCapacity + 150, info.asduHandlerCalled);
+    TEST_ASSERT_EQUAL_INT(msgQueueCapacity + 150, info.spontCount);
+    TEST_ASSERT_EQUAL_INT(449, info.lastScaledValue);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+}
+
+void
+test_CS104SlaveEventQueueOverflow2()
+{
+    CS104_Slave slave = CS104_Slave_create(10, 10);
+
+    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS104_Slave_start(slave);
+
+    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
+
+    struct stest_CS104SlaveEventQueue1 info;
+    info.asduHandlerCalled = 0;
+    info.spontCount = 0;
+    info.lastScaledValue = 0;
+
+    int16_t scaledValue = 0;
+
+    int i;
+
+    for (int i = 0; i < 300; i++) {
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
+
+        scaledValue++;
+
+        CS101_ASDU_addInformationObject(newAsdu, io);
+
+        InformationObject_destroy(io);
+
+        CS104_Slave_enqueueASDU(slave, newAsdu);
+
+        CS101_ASDU_destroy(newAsdu);
+    }
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
+
+    bool result = CS104_Connection_connect(con);
+    TEST_ASSERT_TRUE(result);
+
+    CS104_Connection_sendStartDT(con);
+
+    Thread_sleep(500);
+
+    CS104_Connection_close(con);
+
+    int asduSize = 12;
+    int entrySize = sizeof(struct sTestMessageQueueEntryInfo) + asduSize;
+    int msgQueueCapacity = ((sizeof(struct sTestMessageQueueEntryInfo) + 256) * 10) / entrySize;
+
+    TEST_ASSERT_EQUAL_INT(299, info.lastScaledValue);
+    TEST_ASSERT_EQUAL_INT(msgQueueCapacity, info.asduHandlerCalled);
+
+    result = CS104_Connection_connect(con);
+    TEST_ASSERT_TRUE(result);
+
+    CS104_Connection_sendStartDT(con);
+
+    int typeNo = 0;
+
+    for (int i = 0; i < 20000; i++) {
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+        InformationObject io;
+
+        if (typeNo == 0) {
+            io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
+            CS101_ASDU_addInformationObject(newAsdu, io);
+        }
+        else if (typeNo == 1) {
+            struct sCP56Time2a cp56;
+            CP56Time2a_createFromMsTimestamp(&cp56, Hal_getTimeInMs());
+
+            io =  (InformationObject) MeasuredValueScaledWithCP56Time2a_create(NULL, 111, scaledValue, IEC60870_QUALITY_GOOD, &cp56);
+
+            CS101_ASDU_addInformationObject(newAsdu, io);
+        }
+        else if (typeNo == 2) {
+            io = (InformationObject) SinglePointInformation_create(NULL, 112, true, IEC60870_QUALITY_GOOD);
+
+            CS101_ASDU_addInformationObject(newAsdu, io);
+        }
+        else if (typeNo == 3) {
+            io = (InformationObject) SinglePointInformation_create(NULL, 112, true, IEC60870_QUALITY_GOOD);
+            int j = 1;
+            while (CS101_ASDU_addInformationObject(newAsdu, io)) {
+                io = (InformationObject) SinglePointInformation_create((SinglePointInformation) io, 112 + j, true, IEC60870_QUALITY_GOOD);
+                j++;
+            }
+        }
+
+        typeNo++;
+
+        if (typeNo == 4)
+            typeNo = 0;
+
+        scaledValue++;
+
+        InformationObject_destroy(io);
+
+        CS104_Slave_enqueueASDU(slave, newAsdu);
+
+        CS101_ASDU_destroy(newAsdu);
+
+        //Thread_sleep(10);
+    }
+
+    Thread_sleep(500);
+
+    CS104_Connection_close(con);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+}
+
+void
+test_CS104SlaveEventQueueCheckCapacity()
+{
+    CS104_Slave slave = CS104_Slave_create(2, 2);
+
+    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS104_Slave_start(slave);
+
+    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
+
+    struct stest_CS104SlaveEventQueue1 info;
+    info.asduHandlerCalled = 0;
+    info.spontCount = 0;
+    info.lastScaledValue = 0;
+
+    int16_t scaledValue = 0;
+
+    /* Fill queue with small messages */
+    int asduSize = 6 + 3 + 1;
+    int entrySize = sizeof(struct sTestMessageQueueEntryInfo) + asduSize;
+    int msgQueueCapacity = ((sizeof(struct sTestMessageQueueEntryInfo) + 256) * 2) / entrySize;
+
+    for (int i = 0; i < 299; i++) {
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+        InformationObject io = (InformationObject) SinglePointInformation_create(NULL, 101, true, IEC60870_QUALITY_GOOD);
+
+        CS101_ASDU_addInformationObject(newAsdu, io);
+
+        InformationObject_destroy(io);
+
+        CS104_Slave_enqueueASDU(slave, newAsdu);
+
+        if (i >= msgQueueCapacity)
+            TEST_ASSERT_EQUAL_INT(msgQueueCapacity, CS104_Slave_getNumberOfQueueEntries(slave, NULL));
+        else
+            TEST_ASSERT_EQUAL_INT(i + 1, CS104_Slave_getNumberOfQueueEntries(slave, NULL));
+
+        CS101_ASDU_destroy(newAsdu);
+    }
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
+
+    bool result = CS104_Connection_connect(con);
+    TEST_ASSERT_TRUE(result);
+
+    CS104_Connection_sendStartDT(con);
+
+    Thread_sleep(1000);
+
+    CS104_Connection_close(con);
+
+    TEST_ASSERT_EQUAL_INT(msgQueueCapacity, info.asduHandlerCalled);
+
+    /* outstanding I messages that are not confirmed */
+    TEST_ASSERT_EQUAL_INT(0, CS104_Slave_getNumberOfQueueEntries(slave, NULL));
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+}
+
+void
+test_CS104SlaveEventQueueOverflow3()
+{
+    /**
+     * Trigger code to remove multiple messages at once from the buffer
+     */
+
+    CS104_Slave slave = CS104_Slave_create(2, 2);
+
+    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS104_Slave_start(slave);
+
+    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
+
+    struct stest_CS104SlaveEventQueue1 info;
+    info.asduHandlerCalled = 0;
+    info.spontCount = 0;
+    info.lastScaledValue = 0;
+
+    int16_t scaledValue = 0;
+
+    /* Fill queue with small messages */
+
+    int asduSize = 6 + 3 + 1;
+    int entrySize = sizeof(struct sTestMessageQueueEntryInfo) + asduSize;
+    int msgQueueCapacity = ((sizeof(struct sTestMessageQueueEntryInfo) + 256) * 2) / entrySize;
+
+    for (int i = 0; i < 35; i++) {
+
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+        InformationObject io = (InformationObject) SinglePointInformation_create(NULL, 101, true, IEC60870_QUALITY_GOOD);
+
+        CS101_ASDU_addInformationObject(newAsdu, io);
+
+        InformationObject_destroy(io);
+
+        CS104_Slave_enqueueASDU(slave, newAsdu);
+
+        CS101_ASDU_destroy(newAsdu);
+    }
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
+
+    int count1 = CS104_Slave_getNumberOfQueueEntries(slave, NULL);
+
+
+
+    /* add a single large messages */
+    CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    for (int i = 0; i < 50; i++) {
+          SinglePointInformation spi = SinglePointInformation_create(NULL, 110, false, IEC60870_QUALITY_GOOD);;
+
+          CS101_ASDU_addInformationObject(newAsdu, (InformationObject) spi);
+
+          InformationObject_destroy((InformationObject) spi);
+    }
+
+    CS104_Slave_enqueueASDU(slave, newAsdu);
+
+    CS101_ASDU_destroy(newAsdu);
+
+    int count2 = CS104_Slave_getNumberOfQueueEntries(slave, NULL);
+
+    /* check that multiple buffer entries were removed */
+    TEST_ASSERT_TRUE(count2 + 1 < count1);
+
+    info.asduHandlerCalled = 0;
+
+    bool result = CS104_Connection_connect(con);
+    TEST_ASSERT_TRUE(result);
+
+    CS104_Connection_sendStartDT(con);
+
+    Thread_sleep(500);
+
+    CS104_Connection_close(con);
+
+    TEST_ASSERT_EQUAL_INT(count2, info.asduHandlerCalled);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+}
+
+
+void
+test_IpAddressHandling(void)
+{
+    struct sCS104_IPAddress ipAddr1;
+
+    CS104_IPAddress_setFromString(&ipAddr1, "192.168.34.25");
+
+    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV4, ipAddr1.type);
+    TEST_ASSERT_EQUAL_UINT8(192, ipAddr1.address[0]);
+    TEST_ASSERT_EQUAL_UINT8(168, ipAddr1.address[1]);
+    TEST_ASSERT_EQUAL_UINT8(34, ipAddr1.address[2]);
+    TEST_ASSERT_EQUAL_UINT8(25, ipAddr1.address[3]);
+
+    CS104_IPAddress_setFromString(&ipAddr1, "1:22:333:aaaa:b:c:d:e");
+    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV6, ipAddr1.type);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x01, ipAddr1.address[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[2]);
+    TEST_ASSERT_EQUAL_UINT8(0x22, ipAddr1.address[3]);
+    TEST_ASSERT_EQUAL_UINT8(0x03, ipAddr1.address[4]);
+    TEST_ASSERT_EQUAL_UINT8(0x33, ipAddr1.address[5]);
+    TEST_ASSERT_EQUAL_UINT8(0xaa, ipAddr1.address[6]);
+    TEST_ASSERT_EQUAL_UINT8(0xaa, ipAddr1.address[7]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[8]);
+    TEST_ASSERT_EQUAL_UINT8(0x0b, ipAddr1.address[9]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[10]);
+    TEST_ASSERT_EQUAL_UINT8(0x0c, ipAddr1.address[11]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[12]);
+    TEST_ASSERT_EQUAL_UINT8(0x0d, ipAddr1.address[13]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[14]);
+    TEST_ASSERT_EQUAL_UINT8(0x0e, ipAddr1.address[15]);
+
+    CS104_IPAddress_setFromString(&ipAddr1, "::2001:db8");
+    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV6, ipAddr1.type);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[2]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[3]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[4]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[5]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[6]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[7]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[8]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[9]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[10]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[11]);
+    TEST_ASSERT_EQUAL_UINT8(0x20, ipAddr1.address[12]);
+    TEST_ASSERT_EQUAL_UINT8(0x01, ipAddr1.address[13]);
+    TEST_ASSERT_EQUAL_UINT8(0x0d, ipAddr1.address[14]);
+    TEST_ASSERT_EQUAL_UINT8(0xb8, ipAddr1.address[15]);
+
+    CS104_IPAddress_setFromString(&ipAddr1, "fe80::70d2:6cba:a994:2ced");
+    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV6, ipAddr1.type);
+    TEST_ASSERT_EQUAL_UINT8(0xfe, ipAddr1.address[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x80, ipAddr1.address[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[2]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[3]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[4]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[5]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[6]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[7]);
+    TEST_ASSERT_EQUAL_UINT8(0x70, ipAddr1.address[8]);
+    TEST_ASSERT_EQUAL_UINT8(0xd2, ipAddr1.address[9]);
+    TEST_ASSERT_EQUAL_UINT8(0x6c, ipAddr1.address[10]);
+    TEST_ASSERT_EQUAL_UINT8(0xba, ipAddr1.address[11]);
+    TEST_ASSERT_EQUAL_UINT8(0xa9, ipAddr1.address[12]);
+    TEST_ASSERT_EQUAL_UINT8(0x94, ipAddr1.address[13]);
+    TEST_ASSERT_EQUAL_UINT8(0x2c, ipAddr1.address[14]);
+    TEST_ASSERT_EQUAL_UINT8(0xed, ipAddr1.address[15]);
+
+    CS104_IPAddress_setFromString(&ipAddr1, "2001:db8:1::ab9:C0A8:102");
+    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV6, ipAddr1.type);
+    TEST_ASSERT_EQUAL_UINT8(0x20, ipAddr1.address[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x01, ipAddr1.address[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x0d, ipAddr1.address[2]);
+    TEST_ASSERT_EQUAL_UINT8(0xb8, ipAddr1.address[3]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[4]);
+    TEST_ASSERT_EQUAL_UINT8(0x01, ipAddr1.address[5]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[6]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[7]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[8]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[9]);
+    TEST_ASSERT_EQUAL_UINT8(0x0a, ipAddr1.address[10]);
+    TEST_ASSERT_EQUAL_UINT8(0xb9, ipAddr1.address[11]);
+    TEST_ASSERT_EQUAL_UINT8(0xc0, ipAddr1.address[12]);
+    TEST_ASSERT_EQUAL_UINT8(0xa8, ipAddr1.address[13]);
+    TEST_ASSERT_EQUAL_UINT8(0x01, ipAddr1.address[14]);
+    TEST_ASSERT_EQUAL_UINT8(0x02, ipAddr1.address[15]);
+
+    CS104_IPAddress_setFromString(&ipAddr1, "::1");
+    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV6, ipAddr1.type);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[2]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[3]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[4]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[5]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[6]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[7]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[8]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[9]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[10]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[11]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[12]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[13]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[14]);
+    TEST_ASSERT_EQUAL_UINT8(0x01, ipAddr1.address[15]);
+
+    CS104_IPAddress_setFromString(&ipAddr1, "::1");
+    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV6, ipAddr1.type);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[2]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[3]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[4]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[5]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[6]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[7]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[8]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[9]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[10]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[11]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[12]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[13]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[14]);
+    TEST_ASSERT_EQUAL_UINT8(0x01, ipAddr1.address[15]);
+
+    CS104_IPAddress_setFromString(&ipAddr1, "::");
+    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV6, ipAddr1.type);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[2]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[3]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[4]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[5]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[6]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[7]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[8]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[9]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[10]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[11]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[12]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[13]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[14]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[15]);
+
+    CS104_IPAddress_setFromString(&ipAddr1, "fe80:2001::");
+    TEST_ASSERT_EQUAL_INT(IP_ADDRESS_TYPE_IPV6, ipAddr1.type);
+    TEST_ASSERT_EQUAL_UINT8(0xfe, ipAddr1.address[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x80, ipAddr1.address[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x20, ipAddr1.address[2]);
+    TEST_ASSERT_EQUAL_UINT8(0x01, ipAddr1.address[3]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[4]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[5]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[6]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[7]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[8]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[9]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[10]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[11]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[12]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[13]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[14]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ipAddr1.address[15]);
+}
+
+void
+test_DoublePointInformation(void)
+{
+    DoublePointInformation dpi1;
+    DoublePointInformation dpi2;
+    DoublePointInformation dpi3;
+
+    dpi1 = DoublePointInformation_create(NULL, 101, IEC60870_DOUBLE_POINT_OFF, IEC60870_QUALITY_INVALID);
+    dpi2 = DoublePointInformation_create(NULL, 102, IEC60870_DOUBLE_POINT_ON, IEC60870_QUALITY_BLOCKED);
+    dpi3 = DoublePointInformation_create(NULL, 103, IEC60870_DOUBLE_POINT_INDETERMINATE, IEC60870_QUALITY_GOOD);
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_OFF, DoublePointInformation_getValue(dpi1));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_ON, DoublePointInformation_getValue(dpi2));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_INDETERMINATE, DoublePointInformation_getValue(dpi3));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi2);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi3);
+
+    InformationObject_destroy((InformationObject) dpi1);
+    InformationObject_destroy((InformationObject) dpi2);
+    InformationObject_destroy((InformationObject) dpi3);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(18, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(3, CS101_ASDU_getNumberOfElements(asdu2));
+
+    DoublePointInformation dpi1_dec = (DoublePointInformation) CS101_ASDU_getElement(asdu2, 0);
+    DoublePointInformation dpi2_dec = (DoublePointInformation) CS101_ASDU_getElement(asdu2, 1);
+    DoublePointInformation dpi3_dec = (DoublePointInformation) CS101_ASDU_getElement(asdu2, 2);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )dpi1_dec));
+    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )dpi2_dec));
+    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )dpi3_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, DoublePointInformation_getQuality(dpi1_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_OFF, DoublePointInformation_getValue(dpi1_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, DoublePointInformation_getQuality(dpi2_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_ON, DoublePointInformation_getValue(dpi2_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, DoublePointInformation_getQuality(dpi3_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_INDETERMINATE, DoublePointInformation_getValue(dpi3_dec));
+
+    InformationObject_destroy((InformationObject) dpi1_dec);
+    InformationObject_destroy((InformationObject) dpi2_dec);
+    InformationObject_destroy((InformationObject) dpi3_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_SinglePointInformation(void)
+{
+    SinglePointInformation spi1;
+    SinglePointInformation spi2;
+    SinglePointInformation spi3;
+    SinglePointInformation spi4;
+
+    spi1 = SinglePointInformation_create(NULL, 101, true, IEC60870_QUALITY_INVALID);
+    spi2 = SinglePointInformation_create(NULL, 102, false, IEC60870_QUALITY_BLOCKED);
+    spi3 = SinglePointInformation_create(NULL, 103, true, IEC60870_QUALITY_GOOD);
+
+    /* invalid quality bit (overflow) is expected to be ignored */
+    spi4 = SinglePointInformation_create(NULL, 104, false, IEC60870_QUALITY_OVERFLOW);
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, SinglePointInformation_getQuality(spi1));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, SinglePointInformation_getQuality(spi2));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, SinglePointInformation_getQuality(spi3));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, SinglePointInformation_getQuality(spi4));
+    TEST_ASSERT_TRUE(SinglePointInformation_getValue(spi1));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi2);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi3);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi4);
+
+    SinglePointInformation_destroy(spi1);
+    SinglePointInformation_destroy(spi2);
+    SinglePointInformation_destroy(spi3);
+    SinglePointInformation_destroy(spi4);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(22, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(4, CS101_ASDU_getNumberOfElements(asdu2));
+
+    SinglePointInformation spi1_dec = (SinglePointInformation) CS101_ASDU_getElement(asdu2, 0);
+    SinglePointInformation spi2_dec = (SinglePointInformation) CS101_ASDU_getElement(asdu2, 1);
+    SinglePointInformation spi3_dec = (SinglePointInformation) CS101_ASDU_getElement(asdu2, 2);
+    SinglePointInformation spi4_dec = (SinglePointInformation) CS101_ASDU_getElement(asdu2, 3);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject)spi1_dec));
+    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject)spi2_dec));
+    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject)spi3_dec));
+    TEST_ASSERT_EQUAL_INT(104, InformationObject_getObjectAddress((InformationObject)spi4_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, SinglePointInformation_getQuality(spi1_dec));
+    TEST_ASSERT_TRUE(SinglePointInformation_getValue(spi1_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, SinglePointInformation_getQuality(spi2_dec));
+    TEST_ASSERT_FALSE(SinglePointInformation_getValue(spi2_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, SinglePointInformation_getQuality(spi3_dec));
+    TEST_ASSERT_TRUE(SinglePointInformation_getValue(spi3_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, SinglePointInformation_getQuality(spi4_dec));
+    TEST_ASSERT_FALSE(SinglePointInformation_getValue(spi4_dec));
+
+    SinglePointInformation_destroy(spi1_dec);
+    SinglePointInformation_destroy(spi2_dec);
+    SinglePointInformation_destroy(spi3_dec);
+    SinglePointInformation_destroy(spi4_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_DoublePointWithCP24Time2a(void)
+{
+    DoublePointWithCP24Time2a dpi1;
+    DoublePointWithCP24Time2a dpi2;
+    DoublePointWithCP24Time2a dpi3;
+
+    uint64_t time1 = Hal_getTimeInMs();
+    uint64_t time2 = time1 + 1000;
+    uint64_t time3 = time2 + 1000;
+
+    struct sCP24Time2a cpTime1;
+    struct sCP24Time2a cpTime2;
+    struct sCP24Time2a cpTime3;
+
+    bzero(&cpTime1, sizeof(struct sCP24Time2a));
+    bzero(&cpTime2, sizeof(struct sCP24Time2a));
+    bzero(&cpTime3, sizeof(struct sCP24Time2a));
+
+    CP24Time2a_setMinute(&cpTime1, 12);
+    CP24Time2a_setMillisecond(&cpTime1, 24123);
+
+    CP24Time2a_setMinute(&cpTime2, 54);
+    CP24Time2a_setMillisecond(&cpTime2, 12345);
+
+    CP24Time2a_setMinute(&cpTime3, 00);
+    CP24Time2a_setMillisecond(&cpTime3, 00001);
+
+    dpi1 = DoublePointWithCP24Time2a_create(NULL, 101, IEC60870_DOUBLE_POINT_OFF, IEC60870_QUALITY_INVALID, &cpTime1);
+    dpi2 = DoublePointWithCP24Time2a_create(NULL, 102, IEC60870_DOUBLE_POINT_ON, IEC60870_QUALITY_BLOCKED, &cpTime2);
+    dpi3 = DoublePointWithCP24Time2a_create(NULL, 103, IEC60870_DOUBLE_POINT_INDETERMINATE, IEC60870_QUALITY_GOOD, &cpTime3);
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, DoublePointInformation_getQuality((DoublePointInformation )dpi1));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, DoublePointInformation_getQuality((DoublePointInformation )dpi2));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, DoublePointInformation_getQuality((DoublePointInformation )dpi3));
+    TEST_ASSERT_TRUE(DoublePointInformation_getQuality((DoublePointInformation )dpi1));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi2);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi3);
+
+    InformationObject_destroy((InformationObject) dpi1);
+    InformationObject_destroy((InformationObject) dpi2);
+    InformationObject_destroy((InformationObject) dpi3);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(27, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(3, CS101_ASDU_getNumberOfElements(asdu2));
+
+    DoublePointWithCP24Time2a dpi1_dec = (DoublePointWithCP24Time2a) CS101_ASDU_getElement(asdu2, 0);
+    DoublePointWithCP24Time2a dpi2_dec = (DoublePointWithCP24Time2a) CS101_ASDU_getElement(asdu2, 1);
+    DoublePointWithCP24Time2a dpi3_dec = (DoublePointWithCP24Time2a) CS101_ASDU_getElement(asdu2, 2);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )dpi1_dec));
+    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )dpi2_dec));
+    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )dpi3_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, DoublePointInformation_getQuality((DoublePointInformation )dpi1_dec));
+    TEST_ASSERT_TRUE(DoublePointInformation_getQuality((DoublePointInformation )dpi1_dec));
+    CP24Time2a time1_dec = DoublePointWithCP24Time2a_getTimestamp(dpi1_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time1_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time1_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time1_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, DoublePointInformation_getQuality((DoublePointInformation )dpi2_dec));
+    TEST_ASSERT_TRUE(DoublePointInformation_getQuality((DoublePointInformation )dpi2_dec));
+    CP24Time2a time2_dec = DoublePointWithCP24Time2a_getTimestamp(dpi2_dec);
+    TEST_ASSERT_EQUAL_INT(54, CP24Time2a_getMinute(time2_dec));
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getSecond(time2_dec));
+    TEST_ASSERT_EQUAL_INT(345, CP24Time2a_getMillisecond(time2_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, DoublePointInformation_getQuality((DoublePointInformation )dpi3_dec));
+    TEST_ASSERT_TRUE(DoublePointInformation_getValue((DoublePointInformation )dpi3_dec));
+    CP24Time2a time3_dec = DoublePointWithCP24Time2a_getTimestamp(dpi3_dec);
+    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getMinute(time3_dec));
+    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getSecond(time3_dec));
+    TEST_ASSERT_EQUAL_INT(1, CP24Time2a_getMillisecond(time3_dec));
+
+    InformationObject_destroy((InformationObject) dpi1_dec);
+    InformationObject_destroy((InformationObject) dpi2_dec);
+    InformationObject_destroy((InformationObject) dpi3_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_SinglePointWithCP24Time2a(void)
+{
+    SinglePointWithCP24Time2a spi1;
+    SinglePointWithCP24Time2a spi2;
+    SinglePointWithCP24Time2a spi3;
+
+    uint64_t time1 = Hal_getTimeInMs();
+    uint64_t time2 = time1 + 1000;
+    uint64_t time3 = time2 + 1000;
+
+    struct sCP24Time2a cpTime1;
+    struct sCP24Time2a cpTime2;
+    struct sCP24Time2a cpTime3;
+
+    bzero(&cpTime1, sizeof(struct sCP24Time2a));
+    bzero(&cpTime2, sizeof(struct sCP24Time2a));
+    bzero(&cpTime3, sizeof(struct sCP24Time2a));
+
+    CP24Time2a_setMinute(&cpTime1, 12);
+    CP24Time2a_setMillisecond(&cpTime1, 24123);
+
+    CP24Time2a_setMinute(&cpTime2, 54);
+    CP24Time2a_setMillisecond(&cpTime2, 12345);
+
+    CP24Time2a_setMinute(&cpTime3, 00);
+    CP24Time2a_setMillisecond(&cpTime3, 00001);
+
+    spi1 = SinglePointWithCP24Time2a_create(NULL, 101, true, IEC60870_QUALITY_INVALID, &cpTime1);
+    spi2 = SinglePointWithCP24Time2a_create(NULL, 102, false, IEC60870_QUALITY_BLOCKED, &cpTime2);
+    spi3 = SinglePointWithCP24Time2a_create(NULL, 103, true, IEC60870_QUALITY_GOOD, &cpTime3);
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, SinglePointInformation_getQuality((SinglePointInformation)spi1));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, SinglePointInformation_getQuality((SinglePointInformation)spi2));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, SinglePointInformation_getQuality((SinglePointInformation)spi3));
+    TEST_ASSERT_TRUE(SinglePointInformation_getValue((SinglePointInformation)spi1));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi2);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi3);
+
+    InformationObject_destroy((InformationObject) spi1);
+    InformationObject_destroy((InformationObject) spi2);
+    InformationObject_destroy((InformationObject) spi3);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(27, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(3, CS101_ASDU_getNumberOfElements(asdu2));
+
+    SinglePointWithCP24Time2a spi1_dec = (SinglePointWithCP24Time2a) CS101_ASDU_getElement(asdu2, 0);
+    SinglePointWithCP24Time2a spi2_dec = (SinglePointWithCP24Time2a) CS101_ASDU_getElement(asdu2, 1);
+    SinglePointWithCP24Time2a spi3_dec = (SinglePointWithCP24Time2a) CS101_ASDU_getElement(asdu2, 2);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject)spi1_dec));
+    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject)spi2_dec));
+    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject)spi3_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, SinglePointInformation_getQuality((SinglePointInformation)spi1_dec));
+    TEST_ASSERT_TRUE(SinglePointInformation_getValue((SinglePointInformation)spi1_dec));
+    CP24Time2a time1_dec = SinglePointWithCP24Time2a_getTimestamp(spi1_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time1_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time1_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time1_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, SinglePointInformation_getQuality((SinglePointInformation)spi2_dec));
+    TEST_ASSERT_FALSE(SinglePointInformation_getValue((SinglePointInformation)spi2_dec));
+    CP24Time2a time2_dec = SinglePointWithCP24Time2a_getTimestamp(spi2_dec);
+    TEST_ASSERT_EQUAL_INT(54, CP24Time2a_getMinute(time2_dec));
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getSecond(time2_dec));
+    TEST_ASSERT_EQUAL_INT(345, CP24Time2a_getMillisecond(time2_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, SinglePointInformation_getQuality((SinglePointInformation)spi3_dec));
+    TEST_ASSERT_TRUE(SinglePointInformation_getValue((SinglePointInformation)spi3_dec));
+    CP24Time2a time3_dec = SinglePointWithCP24Time2a_getTimestamp(spi3_dec);
+    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getMinute(time3_dec));
+    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getSecond(time3_dec));
+    TEST_ASSERT_EQUAL_INT(1, CP24Time2a_getMillisecond(time3_dec));
+
+    InformationObject_destroy((InformationObject) spi1_dec);
+    InformationObject_destroy((InformationObject) spi2_dec);
+    InformationObject_destroy((InformationObject) spi3_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+void
+test_DoublePointWithCP56Time2a(void)
+{
+	DoublePointWithCP56Time2a dpi1;
+	DoublePointWithCP56Time2a dpi2;
+	DoublePointWithCP56Time2a dpi3;
+
+    uint64_t time1 = Hal_getTimeInMs();
+    uint64_t time2 = time1 + 1000;
+    uint64_t time3 = time2 + 1000;
+
+    struct sCP56Time2a cpTime1;
+    struct sCP56Time2a cpTime2;
+    struct sCP56Time2a cpTime3;
+
+    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
+    CP56Time2a_createFromMsTimestamp(&cpTime2, time2);
+    CP56Time2a_createFromMsTimestamp(&cpTime3, time3);
+
+    dpi1 = DoublePointWithCP56Time2a_create(NULL, 101, IEC60870_DOUBLE_POINT_OFF, IEC60870_QUALITY_INVALID, &cpTime1);
+    dpi2 = DoublePointWithCP56Time2a_create(NULL, 102, IEC60870_DOUBLE_POINT_ON, IEC60870_QUALITY_BLOCKED, &cpTime2);
+    dpi3 = DoublePointWithCP56Time2a_create(NULL, 103, IEC60870_DOUBLE_POINT_INDETERMINATE, IEC60870_QUALITY_GOOD, &cpTime3);
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, DoublePointInformation_getQuality((DoublePointInformation)dpi1));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, DoublePointInformation_getQuality((DoublePointInformation)dpi2));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, DoublePointInformation_getQuality((DoublePointInformation)dpi3));
+    TEST_ASSERT_TRUE(DoublePointInformation_getValue((DoublePointInformation)dpi1));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi2);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) dpi3);
+
+    InformationObject_destroy((InformationObject) dpi1);
+    InformationObject_destroy((InformationObject) dpi2);
+    InformationObject_destroy((InformationObject) dpi3);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(39, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(3, CS101_ASDU_getNumberOfElements(asdu2));
+
+    DoublePointWithCP56Time2a dpi1_dec = (DoublePointWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
+    DoublePointWithCP56Time2a dpi2_dec = (DoublePointWithCP56Time2a) CS101_ASDU_getElement(asdu2, 1);
+    DoublePointWithCP56Time2a dpi3_dec = (DoublePointWithCP56Time2a) CS101_ASDU_getElement(asdu2, 2);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject)dpi1_dec));
+    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject)dpi2_dec));
+    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject)dpi3_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, DoublePointInformation_getQuality((DoublePointInformation)dpi1_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_OFF, DoublePointInformation_getValue((DoublePointInformation)dpi1_dec));
+    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(DoublePointWithCP56Time2a_getTimestamp(dpi1_dec)));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, DoublePointInformation_getQuality((DoublePointInformation)dpi2_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_ON, DoublePointInformation_getValue((DoublePointInformation)dpi2_dec));
+    TEST_ASSERT_EQUAL_UINT64(time2, CP56Time2a_toMsTimestamp(DoublePointWithCP56Time2a_getTimestamp(dpi2_dec)));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, DoublePointInformation_getQuality((DoublePointInformation)dpi3_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_DOUBLE_POINT_INDETERMINATE, DoublePointInformation_getValue((DoublePointInformation)dpi3_dec));
+    TEST_ASSERT_EQUAL_UINT64(time3, CP56Time2a_toMsTimestamp(DoublePointWithCP56Time2a_getTimestamp(dpi3_dec)));
+
+    InformationObject_destroy((InformationObject) dpi1_dec);
+    InformationObject_destroy((InformationObject) dpi2_dec);
+    InformationObject_destroy((InformationObject) dpi3_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_SinglePointWithCP56Time2a(void)
+{
+    SinglePointWithCP56Time2a spi1;
+    SinglePointWithCP56Time2a spi2;
+    SinglePointWithCP56Time2a spi3;
+
+    uint64_t time1 = Hal_getTimeInMs();
+    uint64_t time2 = time1 + 1000;
+    uint64_t time3 = time2 + 1000;
+
+    struct sCP56Time2a cpTime1;
+    struct sCP56Time2a cpTime2;
+    struct sCP56Time2a cpTime3;
+
+    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
+    CP56Time2a_createFromMsTimestamp(&cpTime2, time2);
+    CP56Time2a_createFromMsTimestamp(&cpTime3, time3);
+
+    spi1 = SinglePointWithCP56Time2a_create(NULL, 101, true, IEC60870_QUALITY_INVALID, &cpTime1);
+    spi2 = SinglePointWithCP56Time2a_create(NULL, 102, false, IEC60870_QUALITY_BLOCKED, &cpTime2);
+    spi3 = SinglePointWithCP56Time2a_create(NULL, 103, true, IEC60870_QUALITY_GOOD, &cpTime3);
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, SinglePointInformation_getQuality((SinglePointInformation)spi1));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, SinglePointInformation_getQuality((SinglePointInformation)spi2));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, SinglePointInformation_getQuality((SinglePointInformation)spi3));
+    TEST_ASSERT_TRUE(SinglePointInformation_getValue((SinglePointInformation)spi1));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi2);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) spi3);
+
+    InformationObject_destroy((InformationObject) spi1);
+    InformationObject_destroy((InformationObject) spi2);
+    InformationObject_destroy((InformationObject) spi3);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(39, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(3, CS101_ASDU_getNumberOfElements(asdu2));
+
+    SinglePointWithCP56Time2a spi1_dec = (SinglePointWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
+    SinglePointWithCP56Time2a spi2_dec = (SinglePointWithCP56Time2a) CS101_ASDU_getElement(asdu2, 1);
+    SinglePointWithCP56Time2a spi3_dec = (SinglePointWithCP56Time2a) CS101_ASDU_getElement(asdu2, 2);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject)spi1_dec));
+    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject)spi2_dec));
     TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject)spi3_dec));
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, SinglePointInformation_getQuality((SinglePointInformation)spi1_dec));
-    TEST_ASSERT_TRUE(SinglePointInformation_getValue((SinglePointInformation)spi1_dec));
-    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(SinglePointWithCP56Time2a_getTimestamp(spi1_dec)));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, SinglePointInformation_getQuality((SinglePointInformation)spi1_dec));
+    TEST_ASSERT_TRUE(SinglePointInformation_getValue((SinglePointInformation)spi1_dec));
+    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(SinglePointWithCP56Time2a_getTimestamp(spi1_dec)));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, SinglePointInformation_getQuality((SinglePointInformation)spi2_dec));
+    TEST_ASSERT_FALSE(SinglePointInformation_getValue((SinglePointInformation)spi2_dec));
+    TEST_ASSERT_EQUAL_UINT64(time2, CP56Time2a_toMsTimestamp(SinglePointWithCP56Time2a_getTimestamp(spi2_dec)));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, SinglePointInformation_getQuality((SinglePointInformation)spi3_dec));
+    TEST_ASSERT_TRUE(SinglePointInformation_getValue((SinglePointInformation)spi3_dec));
+    TEST_ASSERT_EQUAL_UINT64(time3, CP56Time2a_toMsTimestamp(SinglePointWithCP56Time2a_getTimestamp(spi3_dec)));
+
+    InformationObject_destroy((InformationObject) spi1_dec);
+    InformationObject_destroy((InformationObject) spi2_dec);
+    InformationObject_destroy((InformationObject) spi3_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_NormalizeMeasureValueWithoutQuality(void)
+{
+    MeasuredValueNormalizedWithoutQuality nmv1;
+
+    nmv1 = MeasuredValueNormalizedWithoutQuality_create(NULL, 101, 0.5f);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, MeasuredValueNormalizedWithoutQuality_getValue((MeasuredValueNormalizedWithoutQuality )nmv1));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv1);
+
+    MeasuredValueNormalizedWithoutQuality_destroy(nmv1);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(11, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+
+    MeasuredValueNormalizedWithoutQuality nmv1_dec = (MeasuredValueNormalizedWithoutQuality) CS101_ASDU_getElement(asdu2, 0);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )nmv1_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, MeasuredValueNormalizedWithoutQuality_getValue((MeasuredValueNormalizedWithoutQuality )nmv1_dec));
+
+    MeasuredValueNormalizedWithoutQuality_destroy(nmv1_dec);
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_NormalizeMeasureValue(void)
+{
+    MeasuredValueNormalized nmv1;
+    MeasuredValueNormalized nmv2;
+    MeasuredValueNormalized nmv3;
+    MeasuredValueNormalized nmv4;
+    MeasuredValueNormalized nmv5;
+    MeasuredValueNormalized nmv6;
+    MeasuredValueNormalized nmv7;
+    MeasuredValueNormalized nmv8;
+
+    nmv1 = MeasuredValueNormalized_create(NULL, 101, -0.5f, IEC60870_QUALITY_GOOD);
+    nmv2 = MeasuredValueNormalized_create(NULL, 102, -0.2f, IEC60870_QUALITY_OVERFLOW);
+    nmv3 = MeasuredValueNormalized_create(NULL, 103, -0.1f, IEC60870_QUALITY_RESERVED);
+    nmv4 = MeasuredValueNormalized_create(NULL, 104, 0, IEC60870_QUALITY_ELAPSED_TIME_INVALID);
+    nmv5 = MeasuredValueNormalized_create(NULL, 105, 0.2f, IEC60870_QUALITY_BLOCKED);
+    nmv6 = MeasuredValueNormalized_create(NULL, 106, 0.3f, IEC60870_QUALITY_SUBSTITUTED);
+    nmv7 = MeasuredValueNormalized_create(NULL, 107, 0.4f, IEC60870_QUALITY_NON_TOPICAL);
+    nmv8 = MeasuredValueNormalized_create(NULL, 108, 0.5f, IEC60870_QUALITY_INVALID);
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv1));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv2));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv3));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv4));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv5));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv6));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv7));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv8));
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv1));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv2));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.1f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv3));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv4));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv5));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.3f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv6));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.4f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv7));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv8));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv2);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv3);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv4);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv5);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv6);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv7);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv8);
+
+    MeasuredValueNormalized_destroy(nmv1);
+    MeasuredValueNormalized_destroy(nmv2);
+    MeasuredValueNormalized_destroy(nmv3);
+    MeasuredValueNormalized_destroy(nmv4);
+    MeasuredValueNormalized_destroy(nmv5);
+    MeasuredValueNormalized_destroy(nmv6);
+    MeasuredValueNormalized_destroy(nmv7);
+    MeasuredValueNormalized_destroy(nmv8);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(54, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
+
+    MeasuredValueNormalized nmv1_dec = (MeasuredValueNormalized) CS101_ASDU_getElement(asdu2, 0);
+    MeasuredValueNormalized nmv2_dec = (MeasuredValueNormalized) CS101_ASDU_getElement(asdu2, 1);
+    MeasuredValueNormalized nmv3_dec = (MeasuredValueNormalized) CS101_ASDU_getElement(asdu2, 2);
+    MeasuredValueNormalized nmv4_dec = (MeasuredValueNormalized) CS101_ASDU_getElement(asdu2, 3);
+    MeasuredValueNormalized nmv5_dec = (MeasuredValueNormalized) CS101_ASDU_getElement(asdu2, 4);
+    MeasuredValueNormalized nmv6_dec = (MeasuredValueNormalized) CS101_ASDU_getElement(asdu2, 5);
+    MeasuredValueNormalized nmv7_dec = (MeasuredValueNormalized) CS101_ASDU_getElement(asdu2, 6);
+    MeasuredValueNormalized nmv8_dec = (MeasuredValueNormalized) CS101_ASDU_getElement(asdu2, 7);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )nmv1_dec));
+    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )nmv2_dec));
+    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )nmv3_dec));
+    TEST_ASSERT_EQUAL_INT(104, InformationObject_getObjectAddress((InformationObject )nmv4_dec));
+    TEST_ASSERT_EQUAL_INT(105, InformationObject_getObjectAddress((InformationObject )nmv5_dec));
+    TEST_ASSERT_EQUAL_INT(106, InformationObject_getObjectAddress((InformationObject )nmv6_dec));
+    TEST_ASSERT_EQUAL_INT(107, InformationObject_getObjectAddress((InformationObject )nmv7_dec));
+    TEST_ASSERT_EQUAL_INT(108, InformationObject_getObjectAddress((InformationObject )nmv8_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv1_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv2_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv3_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv4_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv5_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv6_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv7_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv8_dec));
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv1_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv2_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.1f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv3_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv4_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv5_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.3f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv6_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.4f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv7_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv8_dec));
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )nmv1_dec));
+    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )nmv2_dec));
+    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )nmv3_dec));
+    TEST_ASSERT_EQUAL_INT(104, InformationObject_getObjectAddress((InformationObject )nmv4_dec));
+    TEST_ASSERT_EQUAL_INT(105, InformationObject_getObjectAddress((InformationObject )nmv5_dec));
+    TEST_ASSERT_EQUAL_INT(106, InformationObject_getObjectAddress((InformationObject )nmv6_dec));
+    TEST_ASSERT_EQUAL_INT(107, InformationObject_getObjectAddress((InformationObject )nmv7_dec));
+    TEST_ASSERT_EQUAL_INT(108, InformationObject_getObjectAddress((InformationObject )nmv8_dec));
+
+    MeasuredValueNormalized_destroy(nmv1_dec);
+    MeasuredValueNormalized_destroy(nmv2_dec);
+    MeasuredValueNormalized_destroy(nmv3_dec);
+    MeasuredValueNormalized_destroy(nmv4_dec);
+    MeasuredValueNormalized_destroy(nmv5_dec);
+    MeasuredValueNormalized_destroy(nmv6_dec);
+    MeasuredValueNormalized_destroy(nmv7_dec);
+    MeasuredValueNormalized_destroy(nmv8_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_MeasuredValueNormalizedWithCP24Time2a(void)
+{
+    MeasuredValueNormalizedWithCP24Time2a nmv1;
+    MeasuredValueNormalizedWithCP24Time2a nmv2;
+    MeasuredValueNormalizedWithCP24Time2a nmv3;
+    MeasuredValueNormalizedWithCP24Time2a nmv4;
+    MeasuredValueNormalizedWithCP24Time2a nmv5;
+    MeasuredValueNormalizedWithCP24Time2a nmv6;
+    MeasuredValueNormalizedWithCP24Time2a nmv7;
+    MeasuredValueNormalizedWithCP24Time2a nmv8;
+
+    uint64_t time1 = Hal_getTimeInMs();
+    uint64_t time2 = time1 + 1000;
+    uint64_t time3 = time2 + 1000;
+    uint64_t time4 = time3 + 1000;
+    uint64_t time5 = time4 + 1000;
+    uint64_t time6 = time5 + 1000;
+    uint64_t time7 = time6 + 1000;
+    uint64_t time8 = time7 + 1000;
+
+    struct sCP24Time2a cpTime1;
+    struct sCP24Time2a cpTime2;
+    struct sCP24Time2a cpTime3;
+    struct sCP24Time2a cpTime4;
+    struct sCP24Time2a cpTime5;
+    struct sCP24Time2a cpTime6;
+    struct sCP24Time2a cpTime7;
+    struct sCP24Time2a cpTime8;
+
+    bzero(&cpTime1, sizeof(struct sCP24Time2a));
+    bzero(&cpTime2, sizeof(struct sCP24Time2a));
+    bzero(&cpTime3, sizeof(struct sCP24Time2a));
+    bzero(&cpTime4, sizeof(struct sCP24Time2a));
+    bzero(&cpTime5, sizeof(struct sCP24Time2a));
+    bzero(&cpTime6, sizeof(struct sCP24Time2a));
+    bzero(&cpTime7, sizeof(struct sCP24Time2a));
+    bzero(&cpTime8, sizeof(struct sCP24Time2a));
+
+    CP24Time2a_setMinute(&cpTime1, 12);
+    CP24Time2a_setMillisecond(&cpTime1, 24123);
+
+    CP24Time2a_setMinute(&cpTime2, 54);
+    CP24Time2a_setMillisecond(&cpTime2, 12345);
+
+    CP24Time2a_setMinute(&cpTime3, 00);
+    CP24Time2a_setMillisecond(&cpTime3, 00001);
+
+    CP24Time2a_setMinute(&cpTime4, 12);
+    CP24Time2a_setMillisecond(&cpTime4, 24123);
+
+    CP24Time2a_setMinute(&cpTime5, 12);
+    CP24Time2a_setMillisecond(&cpTime5, 24123);
+
+    CP24Time2a_setMinute(&cpTime6, 12);
+    CP24Time2a_setMillisecond(&cpTime6, 24123);
+
+    CP24Time2a_setMinute(&cpTime7, 12);
+    CP24Time2a_setMillisecond(&cpTime7, 24123);
+
+    CP24Time2a_setMinute(&cpTime8, 12);
+    CP24Time2a_setMillisecond(&cpTime8, 24123);
+
+    nmv1 = MeasuredValueNormalizedWithCP24Time2a_create(NULL, 101, -0.5f, IEC60870_QUALITY_GOOD, &cpTime1);
+    nmv2 = MeasuredValueNormalizedWithCP24Time2a_create(NULL, 102, -0.2f, IEC60870_QUALITY_OVERFLOW, &cpTime2);
+    nmv3 = MeasuredValueNormalizedWithCP24Time2a_create(NULL, 103, -0.1f, IEC60870_QUALITY_RESERVED, &cpTime3);
+    nmv4 = MeasuredValueNormalizedWithCP24Time2a_create(NULL, 104, 0, IEC60870_QUALITY_ELAPSED_TIME_INVALID, &cpTime4);
+    nmv5 = MeasuredValueNormalizedWithCP24Time2a_create(NULL, 105, 0.2f, IEC60870_QUALITY_BLOCKED, &cpTime5);
+    nmv6 = MeasuredValueNormalizedWithCP24Time2a_create(NULL, 106, 0.3f, IEC60870_QUALITY_SUBSTITUTED, &cpTime6);
+    nmv7 = MeasuredValueNormalizedWithCP24Time2a_create(NULL, 107, 0.4f, IEC60870_QUALITY_NON_TOPICAL, &cpTime7);
+    nmv8 = MeasuredValueNormalizedWithCP24Time2a_create(NULL, 108, 0.5f, IEC60870_QUALITY_INVALID, &cpTime8);
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv1));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv2));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv3));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv4));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv5));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv6));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv7));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv8));
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv1));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv2));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.1f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv3));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv4));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv5));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.3f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv6));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.4f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv7));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv8));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv2);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv3);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv4);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv5);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv6);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv7);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv8);
+
+    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv1);
+    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv2);
+    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv3);
+    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv4);
+    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv5);
+    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv6);
+    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv7);
+    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv8);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(78, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
+
+    MeasuredValueNormalizedWithCP24Time2a nmv1_dec = (MeasuredValueNormalizedWithCP24Time2a) CS101_ASDU_getElement(asdu2, 0);
+    MeasuredValueNormalizedWithCP24Time2a nmv2_dec = (MeasuredValueNormalizedWithCP24Time2a) CS101_ASDU_getElement(asdu2, 1);
+    MeasuredValueNormalizedWithCP24Time2a nmv3_dec = (MeasuredValueNormalizedWithCP24Time2a) CS101_ASDU_getElement(asdu2, 2);
+    MeasuredValueNormalizedWithCP24Time2a nmv4_dec = (MeasuredValueNormalizedWithCP24Time2a) CS101_ASDU_getElement(asdu2, 3);
+    MeasuredValueNormalizedWithCP24Time2a nmv5_dec = (MeasuredValueNormalizedWithCP24Time2a) CS101_ASDU_getElement(asdu2, 4);
+    MeasuredValueNormalizedWithCP24Time2a nmv6_dec = (MeasuredValueNormalizedWithCP24Time2a) CS101_ASDU_getElement(asdu2, 5);
+    MeasuredValueNormalizedWithCP24Time2a nmv7_dec = (MeasuredValueNormalizedWithCP24Time2a) CS101_ASDU_getElement(asdu2, 6);
+    MeasuredValueNormalizedWithCP24Time2a nmv8_dec = (MeasuredValueNormalizedWithCP24Time2a) CS101_ASDU_getElement(asdu2, 7);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )nmv1_dec));
+    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )nmv2_dec));
+    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )nmv3_dec));
+    TEST_ASSERT_EQUAL_INT(104, InformationObject_getObjectAddress((InformationObject )nmv4_dec));
+    TEST_ASSERT_EQUAL_INT(105, InformationObject_getObjectAddress((InformationObject )nmv5_dec));
+    TEST_ASSERT_EQUAL_INT(106, InformationObject_getObjectAddress((InformationObject )nmv6_dec));
+    TEST_ASSERT_EQUAL_INT(107, InformationObject_getObjectAddress((InformationObject )nmv7_dec));
+    TEST_ASSERT_EQUAL_INT(108, InformationObject_getObjectAddress((InformationObject )nmv8_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv1_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv2_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv3_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv4_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv5_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv6_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv7_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv8_dec));
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv1_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv2_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.1f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv3_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv4_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv5_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.3f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv6_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.4f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv7_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv8_dec));
+
+    CP24Time2a time1_dec = MeasuredValueNormalizedWithCP24Time2a_getTimestamp(nmv1_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time1_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time1_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time1_dec));
+
+    CP24Time2a time2_dec = MeasuredValueNormalizedWithCP24Time2a_getTimestamp(nmv2_dec);
+    TEST_ASSERT_EQUAL_INT(54, CP24Time2a_getMinute(time2_dec));
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getSecond(time2_dec));
+    TEST_ASSERT_EQUAL_INT(345, CP24Time2a_getMillisecond(time2_dec));
+
+    CP24Time2a time3_dec = MeasuredValueNormalizedWithCP24Time2a_getTimestamp(nmv3_dec);
+    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getMinute(time3_dec));
+    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getSecond(time3_dec));
+    TEST_ASSERT_EQUAL_INT(1, CP24Time2a_getMillisecond(time3_dec));
+
+    CP24Time2a time4_dec = MeasuredValueNormalizedWithCP24Time2a_getTimestamp(nmv4_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time4_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time4_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time4_dec));
+
+    CP24Time2a time5_dec = MeasuredValueNormalizedWithCP24Time2a_getTimestamp(nmv5_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time5_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time5_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time5_dec));
+
+    CP24Time2a time6_dec = MeasuredValueNormalizedWithCP24Time2a_getTimestamp(nmv6_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time6_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time6_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time6_dec));
+
+    CP24Time2a time7_dec = MeasuredValueNormalizedWithCP24Time2a_getTimestamp(nmv7_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time7_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time7_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time7_dec));
+
+    CP24Time2a time8_dec = MeasuredValueNormalizedWithCP24Time2a_getTimestamp(nmv8_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time8_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time8_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time8_dec));
+
+    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv1_dec);
+    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv2_dec);
+    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv3_dec);
+    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv4_dec);
+    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv5_dec);
+    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv6_dec);
+    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv7_dec);
+    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv8_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+
+test_MeasuredValueNormalizedWithCP56Time2a(void)
+{
+    MeasuredValueNormalizedWithCP56Time2a nmv1;
+    MeasuredValueNormalizedWithCP56Time2a nmv2;
+    MeasuredValueNormalizedWithCP56Time2a nmv3;
+    MeasuredValueNormalizedWithCP56Time2a nmv4;
+    MeasuredValueNormalizedWithCP56Time2a nmv5;
+    MeasuredValueNormalizedWithCP56Time2a nmv6;
+    MeasuredValueNormalizedWithCP56Time2a nmv7;
+    MeasuredValueNormalizedWithCP56Time2a nmv8;
+
+    uint64_t time1 = Hal_getTimeInMs();
+    uint64_t time2 = time1 + 1000;
+    uint64_t time3 = time2 + 1000;
+    uint64_t time4 = time3 + 1000;
+    uint64_t time5 = time4 + 1000;
+    uint64_t time6 = time5 + 1000;
+    uint64_t time7 = time6 + 1000;
+    uint64_t time8 = time7 + 1000;
+
+    struct sCP56Time2a cpTime1;
+    struct sCP56Time2a cpTime2;
+    struct sCP56Time2a cpTime3;
+    struct sCP56Time2a cpTime4;
+    struct sCP56Time2a cpTime5;
+    struct sCP56Time2a cpTime6;
+    struct sCP56Time2a cpTime7;
+    struct sCP56Time2a cpTime8;
+
+    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
+    CP56Time2a_createFromMsTimestamp(&cpTime2, time2);
+    CP56Time2a_createFromMsTimestamp(&cpTime3, time3);
+    CP56Time2a_createFromMsTimestamp(&cpTime4, time4);
+    CP56Time2a_createFromMsTimestamp(&cpTime5, time5);
+    CP56Time2a_createFromMsTimestamp(&cpTime6, time6);
+    CP56Time2a_createFromMsTimestamp(&cpTime7, time7);
+    CP56Time2a_createFromMsTimestamp(&cpTime8, time8);
+
+    nmv1 = MeasuredValueNormalizedWithCP56Time2a_create(NULL, 101, -0.5f, IEC60870_QUALITY_GOOD, &cpTime1);
+    nmv2 = MeasuredValueNormalizedWithCP56Time2a_create(NULL, 102, -0.2f, IEC60870_QUALITY_OVERFLOW, &cpTime2);
+    nmv3 = MeasuredValueNormalizedWithCP56Time2a_create(NULL, 103, -0.1f, IEC60870_QUALITY_RESERVED, &cpTime3);
+    nmv4 = MeasuredValueNormalizedWithCP56Time2a_create(NULL, 104, 0, IEC60870_QUALITY_ELAPSED_TIME_INVALID, &cpTime4);
+    nmv5 = MeasuredValueNormalizedWithCP56Time2a_create(NULL, 105, 0.2f, IEC60870_QUALITY_BLOCKED, &cpTime5);
+    nmv6 = MeasuredValueNormalizedWithCP56Time2a_create(NULL, 106, 0.3f, IEC60870_QUALITY_SUBSTITUTED, &cpTime6);
+    nmv7 = MeasuredValueNormalizedWithCP56Time2a_create(NULL, 107, 0.4f, IEC60870_QUALITY_NON_TOPICAL, &cpTime7);
+    nmv8 = MeasuredValueNormalizedWithCP56Time2a_create(NULL, 108, 0.5f, IEC60870_QUALITY_INVALID, &cpTime8);
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv1));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv2));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv3));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv4));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv5));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv6));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv7));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv8));
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv1));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv2));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.1f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv3));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv4));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv5));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.3f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv6));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.4f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv7));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv8));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv2);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv3);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv4);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv5);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv6);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv7);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv8);
+
+    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv1);
+    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv2);
+    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv3);
+    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv4);
+    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv5);
+    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv6);
+    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv7);
+    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv8);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(110, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
+
+    MeasuredValueNormalizedWithCP56Time2a nmv1_dec = (MeasuredValueNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
+    MeasuredValueNormalizedWithCP56Time2a nmv2_dec = (MeasuredValueNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 1);
+    MeasuredValueNormalizedWithCP56Time2a nmv3_dec = (MeasuredValueNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 2);
+    MeasuredValueNormalizedWithCP56Time2a nmv4_dec = (MeasuredValueNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 3);
+    MeasuredValueNormalizedWithCP56Time2a nmv5_dec = (MeasuredValueNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 4);
+    MeasuredValueNormalizedWithCP56Time2a nmv6_dec = (MeasuredValueNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 5);
+    MeasuredValueNormalizedWithCP56Time2a nmv7_dec = (MeasuredValueNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 6);
+    MeasuredValueNormalizedWithCP56Time2a nmv8_dec = (MeasuredValueNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 7);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )nmv1_dec));
+    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )nmv2_dec));
+    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )nmv3_dec));
+    TEST_ASSERT_EQUAL_INT(104, InformationObject_getObjectAddress((InformationObject )nmv4_dec));
+    TEST_ASSERT_EQUAL_INT(105, InformationObject_getObjectAddress((InformationObject )nmv5_dec));
+    TEST_ASSERT_EQUAL_INT(106, InformationObject_getObjectAddress((InformationObject )nmv6_dec));
+    TEST_ASSERT_EQUAL_INT(107, InformationObject_getObjectAddress((InformationObject )nmv7_dec));
+    TEST_ASSERT_EQUAL_INT(108, InformationObject_getObjectAddress((InformationObject )nmv8_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv1_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv2_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv3_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv4_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv5_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv6_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv7_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv8_dec));
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv1_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv2_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.1f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv3_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv4_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv5_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.3f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv6_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.4f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv7_dec));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv8_dec));
+
+    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(MeasuredValueNormalizedWithCP56Time2a_getTimestamp(nmv1_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time2, CP56Time2a_toMsTimestamp(MeasuredValueNormalizedWithCP56Time2a_getTimestamp(nmv2_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time3, CP56Time2a_toMsTimestamp(MeasuredValueNormalizedWithCP56Time2a_getTimestamp(nmv3_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time4, CP56Time2a_toMsTimestamp(MeasuredValueNormalizedWithCP56Time2a_getTimestamp(nmv4_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time5, CP56Time2a_toMsTimestamp(MeasuredValueNormalizedWithCP56Time2a_getTimestamp(nmv5_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time6, CP56Time2a_toMsTimestamp(MeasuredValueNormalizedWithCP56Time2a_getTimestamp(nmv6_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time7, CP56Time2a_toMsTimestamp(MeasuredValueNormalizedWithCP56Time2a_getTimestamp(nmv7_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time8, CP56Time2a_toMsTimestamp(MeasuredValueNormalizedWithCP56Time2a_getTimestamp(nmv8_dec)));
+
+    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv1_dec);
+    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv2_dec);
+    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv3_dec);
+    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv4_dec);
+    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv5_dec);
+    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv6_dec);
+    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv7_dec);
+    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv8_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_MeasuredValueScaled(void)
+{
+    MeasuredValueScaled mvs1;
+    MeasuredValueScaled mvs2;
+    MeasuredValueScaled mvs3;
+    MeasuredValueScaled mvs4;
+    MeasuredValueScaled mvs5;
+    MeasuredValueScaled mvs6;
+    MeasuredValueScaled mvs7;
+    MeasuredValueScaled mvs8;
+
+    mvs1 = MeasuredValueScaled_create(NULL, 101, INT16_MAX, IEC60870_QUALITY_GOOD);
+    mvs2 = MeasuredValueScaled_create(NULL, 102, INT16_MAX, IEC60870_QUALITY_OVERFLOW);
+    mvs3 = MeasuredValueScaled_create(NULL, 103, INT16_MAX, IEC60870_QUALITY_RESERVED);
+    mvs4 = MeasuredValueScaled_create(NULL, 104, INT16_MAX, IEC60870_QUALITY_ELAPSED_TIME_INVALID);
+    mvs5 = MeasuredValueScaled_create(NULL, 105, INT16_MIN, IEC60870_QUALITY_BLOCKED);
+    mvs6 = MeasuredValueScaled_create(NULL, 106, INT16_MIN, IEC60870_QUALITY_SUBSTITUTED);
+    mvs7 = MeasuredValueScaled_create(NULL, 107, INT16_MIN, IEC60870_QUALITY_NON_TOPICAL);
+    mvs8 = MeasuredValueScaled_create(NULL, 108, INT16_MIN, IEC60870_QUALITY_INVALID);
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs1));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs2));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs3));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs4));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs5));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs6));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs7));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs8));
+
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs1));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs2));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs3));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs4));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs5));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs6));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs7));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs8));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs2);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs3);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs4);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs5);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs6);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs7);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs8);
+
+    MeasuredValueScaled_destroy(mvs1);
+    MeasuredValueScaled_destroy(mvs2);
+    MeasuredValueScaled_destroy(mvs3);
+    MeasuredValueScaled_destroy(mvs4);
+    MeasuredValueScaled_destroy(mvs5);
+    MeasuredValueScaled_destroy(mvs6);
+    MeasuredValueScaled_destroy(mvs7);
+    MeasuredValueScaled_destroy(mvs8);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(54, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
+
+    MeasuredValueScaled mvs1_dec = (MeasuredValueScaled) CS101_ASDU_getElement(asdu2, 0);
+    MeasuredValueScaled mvs2_dec = (MeasuredValueScaled) CS101_ASDU_getElement(asdu2, 1);
+    MeasuredValueScaled mvs3_dec = (MeasuredValueScaled) CS101_ASDU_getElement(asdu2, 2);
+    MeasuredValueScaled mvs4_dec = (MeasuredValueScaled) CS101_ASDU_getElement(asdu2, 3);
+    MeasuredValueScaled mvs5_dec = (MeasuredValueScaled) CS101_ASDU_getElement(asdu2, 4);
+    MeasuredValueScaled mvs6_dec = (MeasuredValueScaled) CS101_ASDU_getElement(asdu2, 5);
+    MeasuredValueScaled mvs7_dec = (MeasuredValueScaled) CS101_ASDU_getElement(asdu2, 6);
+    MeasuredValueScaled mvs8_dec = (MeasuredValueScaled) CS101_ASDU_getElement(asdu2, 7);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )mvs1_dec));
+    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )mvs2_dec));
+    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )mvs3_dec));
+    TEST_ASSERT_EQUAL_INT(104, InformationObject_getObjectAddress((InformationObject )mvs4_dec));
+    TEST_ASSERT_EQUAL_INT(105, InformationObject_getObjectAddress((InformationObject )mvs5_dec));
+    TEST_ASSERT_EQUAL_INT(106, InformationObject_getObjectAddress((InformationObject )mvs6_dec));
+    TEST_ASSERT_EQUAL_INT(107, InformationObject_getObjectAddress((InformationObject )mvs7_dec));
+    TEST_ASSERT_EQUAL_INT(108, InformationObject_getObjectAddress((InformationObject )mvs8_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs1_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs2_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs3_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs4_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs5_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs6_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs7_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs8_dec));
+
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs1_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs2_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs3_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs4_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs5_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs6_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs7_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs8_dec));
+
+    MeasuredValueScaled_destroy(mvs1_dec);
+    MeasuredValueScaled_destroy(mvs2_dec);
+    MeasuredValueScaled_destroy(mvs3_dec);
+    MeasuredValueScaled_destroy(mvs4_dec);
+    MeasuredValueScaled_destroy(mvs5_dec);
+    MeasuredValueScaled_destroy(mvs6_dec);
+    MeasuredValueScaled_destroy(mvs7_dec);
+    MeasuredValueScaled_destroy(mvs8_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+
+test_MeasuredValueScaledWithCP24Time2a(void)
+{
+    MeasuredValueScaledWithCP24Time2a mvs1;
+    MeasuredValueScaledWithCP24Time2a mvs2;
+    MeasuredValueScaledWithCP24Time2a mvs3;
+    MeasuredValueScaledWithCP24Time2a mvs4;
+    MeasuredValueScaledWithCP24Time2a mvs5;
+    MeasuredValueScaledWithCP24Time2a mvs6;
+    MeasuredValueScaledWithCP24Time2a mvs7;
+    MeasuredValueScaledWithCP24Time2a mvs8;
+
+    uint64_t time1 = Hal_getTimeInMs();
+    uint64_t time2 = time1 + 1000;
+    uint64_t time3 = time2 + 1000;
+    uint64_t time4 = time3 + 1000;
+    uint64_t time5 = time4 + 1000;
+    uint64_t time6 = time5 + 1000;
+    uint64_t time7 = time6 + 1000;
+    uint64_t time8 = time7 + 1000;
+
+    struct sCP24Time2a cpTime1;
+    struct sCP24Time2a cpTime2;
+    struct sCP24Time2a cpTime3;
+    struct sCP24Time2a cpTime4;
+    struct sCP24Time2a cpTime5;
+    struct sCP24Time2a cpTime6;
+    struct sCP24Time2a cpTime7;
+    struct sCP24Time2a cpTime8;
+
+    bzero(&cpTime1, sizeof(struct sCP24Time2a));
+    bzero(&cpTime2, sizeof(struct sCP24Time2a));
+    bzero(&cpTime3, sizeof(struct sCP24Time2a));
+    bzero(&cpTime4, sizeof(struct sCP24Time2a));
+    bzero(&cpTime5, sizeof(struct sCP24Time2a));
+    bzero(&cpTime6, sizeof(struct sCP24Time2a));
+    bzero(&cpTime7, sizeof(struct sCP24Time2a));
+    bzero(&cpTime8, sizeof(struct sCP24Time2a));
+
+    CP24Time2a_setMinute(&cpTime1, 12);
+    CP24Time2a_setMillisecond(&cpTime1, 24123);
+
+    CP24Time2a_setMinute(&cpTime2, 54);
+    CP24Time2a_setMillisecond(&cpTime2, 12345);
+
+    CP24Time2a_setMinute(&cpTime3, 00);
+    CP24Time2a_setMillisecond(&cpTime3, 00001);
+
+    CP24Time2a_setMinute(&cpTime4, 12);
+    CP24Time2a_setMillisecond(&cpTime4, 24123);
+
+    CP24Time2a_setMinute(&cpTime5, 12);
+    CP24Time2a_setMillisecond(&cpTime5, 24123);
+
+    CP24Time2a_setMinute(&cpTime6, 12);
+    CP24Time2a_setMillisecond(&cpTime6, 24123);
+
+    CP24Time2a_setMinute(&cpTime7, 12);
+    CP24Time2a_setMillisecond(&cpTime7, 24123);
+
+    CP24Time2a_setMinute(&cpTime8, 12);
+    CP24Time2a_setMillisecond(&cpTime8, 24123);
+
+    mvs1 = MeasuredValueScaledWithCP24Time2a_create(NULL, 101, INT16_MAX, IEC60870_QUALITY_GOOD, &cpTime1);
+    mvs2 = MeasuredValueScaledWithCP24Time2a_create(NULL, 102, INT16_MAX, IEC60870_QUALITY_OVERFLOW, &cpTime2);
+    mvs3 = MeasuredValueScaledWithCP24Time2a_create(NULL, 103, INT16_MAX, IEC60870_QUALITY_RESERVED, &cpTime3);
+    mvs4 = MeasuredValueScaledWithCP24Time2a_create(NULL, 104, INT16_MAX, IEC60870_QUALITY_ELAPSED_TIME_INVALID, &cpTime4);
+    mvs5 = MeasuredValueScaledWithCP24Time2a_create(NULL, 105, INT16_MIN, IEC60870_QUALITY_BLOCKED, &cpTime5);
+    mvs6 = MeasuredValueScaledWithCP24Time2a_create(NULL, 106, INT16_MIN, IEC60870_QUALITY_SUBSTITUTED, &cpTime6);
+    mvs7 = MeasuredValueScaledWithCP24Time2a_create(NULL, 107, INT16_MIN, IEC60870_QUALITY_NON_TOPICAL, &cpTime7);
+    mvs8 = MeasuredValueScaledWithCP24Time2a_create(NULL, 108, INT16_MIN, IEC60870_QUALITY_INVALID, &cpTime8);
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs1));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs2));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs3));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs4));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs5));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs6));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs7));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs8));
+
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs1));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs2));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs3));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs4));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs5));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs6));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs7));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs8));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs2);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs3);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs4);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs5);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs6);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs7);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs8);
+
+    MeasuredValueScaledWithCP24Time2a_destroy(mvs1);
+    MeasuredValueScaledWithCP24Time2a_destroy(mvs2);
+    MeasuredValueScaledWithCP24Time2a_destroy(mvs3);
+    MeasuredValueScaledWithCP24Time2a_destroy(mvs4);
+    MeasuredValueScaledWithCP24Time2a_destroy(mvs5);
+    MeasuredValueScaledWithCP24Time2a_destroy(mvs6);
+    MeasuredValueScaledWithCP24Time2a_destroy(mvs7);
+    MeasuredValueScaledWithCP24Time2a_destroy(mvs8);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(78, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
+
+    MeasuredValueScaledWithCP24Time2a mvs1_dec = (MeasuredValueScaledWithCP24Time2a) CS101_ASDU_getElement(asdu2, 0);
+    MeasuredValueScaledWithCP24Time2a mvs2_dec = (MeasuredValueScaledWithCP24Time2a) CS101_ASDU_getElement(asdu2, 1);
+    MeasuredValueScaledWithCP24Time2a mvs3_dec = (MeasuredValueScaledWithCP24Time2a) CS101_ASDU_getElement(asdu2, 2);
+    MeasuredValueScaledWithCP24Time2a mvs4_dec = (MeasuredValueScaledWithCP24Time2a) CS101_ASDU_getElement(asdu2, 3);
+    MeasuredValueScaledWithCP24Time2a mvs5_dec = (MeasuredValueScaledWithCP24Time2a) CS101_ASDU_getElement(asdu2, 4);
+    MeasuredValueScaledWithCP24Time2a mvs6_dec = (MeasuredValueScaledWithCP24Time2a) CS101_ASDU_getElement(asdu2, 5);
+    MeasuredValueScaledWithCP24Time2a mvs7_dec = (MeasuredValueScaledWithCP24Time2a) CS101_ASDU_getElement(asdu2, 6);
+    MeasuredValueScaledWithCP24Time2a mvs8_dec = (MeasuredValueScaledWithCP24Time2a) CS101_ASDU_getElement(asdu2, 7);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )mvs1_dec));
+    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )mvs2_dec));
+    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )mvs3_dec));
+    TEST_ASSERT_EQUAL_INT(104, InformationObject_getObjectAddress((InformationObject )mvs4_dec));
+    TEST_ASSERT_EQUAL_INT(105, InformationObject_getObjectAddress((InformationObject )mvs5_dec));
+    TEST_ASSERT_EQUAL_INT(106, InformationObject_getObjectAddress((InformationObject )mvs6_dec));
+    TEST_ASSERT_EQUAL_INT(107, InformationObject_getObjectAddress((InformationObject )mvs7_dec));
+    TEST_ASSERT_EQUAL_INT(108, InformationObject_getObjectAddress((InformationObject )mvs8_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs1_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs2_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs3_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs4_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs5_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs6_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs7_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs8_dec));
+
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs1_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs2_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs3_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs4_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs5_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs6_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs7_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs8_dec));
+
+    CP24Time2a time1_dec = MeasuredValueScaledWithCP24Time2a_getTimestamp(mvs1_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time1_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time1_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time1_dec));
+
+    CP24Time2a time2_dec = MeasuredValueScaledWithCP24Time2a_getTimestamp(mvs2_dec);
+    TEST_ASSERT_EQUAL_INT(54, CP24Time2a_getMinute(time2_dec));
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getSecond(time2_dec));
+    TEST_ASSERT_EQUAL_INT(345, CP24Time2a_getMillisecond(time2_dec));
+
+    CP24Time2a time3_dec = MeasuredValueScaledWithCP24Time2a_getTimestamp(mvs3_dec);
+    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getMinute(time3_dec));
+    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getSecond(time3_dec));
+    TEST_ASSERT_EQUAL_INT(1, CP24Time2a_getMillisecond(time3_dec));
+
+    CP24Time2a time4_dec = MeasuredValueScaledWithCP24Time2a_getTimestamp(mvs4_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time4_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time4_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time4_dec));
+
+    CP24Time2a time5_dec = MeasuredValueScaledWithCP24Time2a_getTimestamp(mvs5_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time5_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time5_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time5_dec));
+
+    CP24Time2a time6_dec = MeasuredValueScaledWithCP24Time2a_getTimestamp(mvs6_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time6_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time6_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time6_dec));
+
+    CP24Time2a time7_dec = MeasuredValueScaledWithCP24Time2a_getTimestamp(mvs7_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time7_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time7_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time7_dec));
+
+    CP24Time2a time8_dec = MeasuredValueScaledWithCP24Time2a_getTimestamp(mvs8_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time8_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time8_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time8_dec));
+
+    MeasuredValueScaledWithCP24Time2a_destroy(mvs1_dec);
+    MeasuredValueScaledWithCP24Time2a_destroy(mvs2_dec);
+    MeasuredValueScaledWithCP24Time2a_destroy(mvs3_dec);
+    MeasuredValueScaledWithCP24Time2a_destroy(mvs4_dec);
+    MeasuredValueScaledWithCP24Time2a_destroy(mvs5_dec);
+    MeasuredValueScaledWithCP24Time2a_destroy(mvs6_dec);
+    MeasuredValueScaledWithCP24Time2a_destroy(mvs7_dec);
+    MeasuredValueScaledWithCP24Time2a_destroy(mvs8_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_MeasuredValueScaledWithCP56Time2a(void)
+{
+    MeasuredValueScaledWithCP56Time2a mvs1;
+    MeasuredValueScaledWithCP56Time2a mvs2;
+    MeasuredValueScaledWithCP56Time2a mvs3;
+    MeasuredValueScaledWithCP56Time2a mvs4;
+    MeasuredValueScaledWithCP56Time2a mvs5;
+    MeasuredValueScaledWithCP56Time2a mvs6;
+    MeasuredValueScaledWithCP56Time2a mvs7;
+    MeasuredValueScaledWithCP56Time2a mvs8;
+
+    uint64_t time1 = Hal_getTimeInMs();
+    uint64_t time2 = time1 + 1000;
+    uint64_t time3 = time2 + 1000;
+    uint64_t time4 = time3 + 1000;
+    uint64_t time5 = time4 + 1000;
+    uint64_t time6 = time5 + 1000;
+    uint64_t time7 = time6 + 1000;
+    uint64_t time8 = time7 + 1000;
+
+    struct sCP56Time2a cpTime1;
+    struct sCP56Time2a cpTime2;
+    struct sCP56Time2a cpTime3;
+    struct sCP56Time2a cpTime4;
+    struct sCP56Time2a cpTime5;
+    struct sCP56Time2a cpTime6;
+    struct sCP56Time2a cpTime7;
+    struct sCP56Time2a cpTime8;
+
+    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
+    CP56Time2a_createFromMsTimestamp(&cpTime2, time2);
+    CP56Time2a_createFromMsTimestamp(&cpTime3, time3);
+    CP56Time2a_createFromMsTimestamp(&cpTime4, time4);
+    CP56Time2a_createFromMsTimestamp(&cpTime5, time5);
+    CP56Time2a_createFromMsTimestamp(&cpTime6, time6);
+    CP56Time2a_createFromMsTimestamp(&cpTime7, time7);
+    CP56Time2a_createFromMsTimestamp(&cpTime8, time8);
+
+    mvs1 = MeasuredValueScaledWithCP56Time2a_create(NULL, 101, INT16_MAX, IEC60870_QUALITY_GOOD, &cpTime1);
+    mvs2 = MeasuredValueScaledWithCP56Time2a_create(NULL, 102, INT16_MAX, IEC60870_QUALITY_OVERFLOW, &cpTime2);
+    mvs3 = MeasuredValueScaledWithCP56Time2a_create(NULL, 103, INT16_MAX, IEC60870_QUALITY_RESERVED, &cpTime3);
+    mvs4 = MeasuredValueScaledWithCP56Time2a_create(NULL, 104, INT16_MAX, IEC60870_QUALITY_ELAPSED_TIME_INVALID, &cpTime4);
+    mvs5 = MeasuredValueScaledWithCP56Time2a_create(NULL, 105, INT16_MIN, IEC60870_QUALITY_BLOCKED, &cpTime5);
+    mvs6 = MeasuredValueScaledWithCP56Time2a_create(NULL, 106, INT16_MIN, IEC60870_QUALITY_SUBSTITUTED, &cpTime6);
+    mvs7 = MeasuredValueScaledWithCP56Time2a_create(NULL, 107, INT16_MIN, IEC60870_QUALITY_NON_TOPICAL, &cpTime7);
+    mvs8 = MeasuredValueScaledWithCP56Time2a_create(NULL, 108, INT16_MIN, IEC60870_QUALITY_INVALID, &cpTime8);
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs1));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs2));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs3));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs4));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs5));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs6));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs7));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs8));
+
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs1));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs2));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs3));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs4));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs5));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs6));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs7));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs8));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs2);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs3);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs4);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs5);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs6);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs7);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs8);
+
+    MeasuredValueScaledWithCP56Time2a_destroy(mvs1);
+    MeasuredValueScaledWithCP56Time2a_destroy(mvs2);
+    MeasuredValueScaledWithCP56Time2a_destroy(mvs3);
+    MeasuredValueScaledWithCP56Time2a_destroy(mvs4);
+    MeasuredValueScaledWithCP56Time2a_destroy(mvs5);
+    MeasuredValueScaledWithCP56Time2a_destroy(mvs6);
+    MeasuredValueScaledWithCP56Time2a_destroy(mvs7);
+    MeasuredValueScaledWithCP56Time2a_destroy(mvs8);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(110, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
+
+    MeasuredValueScaledWithCP56Time2a mvs1_dec = (MeasuredValueScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
+    MeasuredValueScaledWithCP56Time2a mvs2_dec = (MeasuredValueScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 1);
+    MeasuredValueScaledWithCP56Time2a mvs3_dec = (MeasuredValueScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 2);
+    MeasuredValueScaledWithCP56Time2a mvs4_dec = (MeasuredValueScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 3);
+    MeasuredValueScaledWithCP56Time2a mvs5_dec = (MeasuredValueScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 4);
+    MeasuredValueScaledWithCP56Time2a mvs6_dec = (MeasuredValueScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 5);
+    MeasuredValueScaledWithCP56Time2a mvs7_dec = (MeasuredValueScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 6);
+    MeasuredValueScaledWithCP56Time2a mvs8_dec = (MeasuredValueScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 7);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )mvs1_dec));
+    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )mvs2_dec));
+    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )mvs3_dec));
+    TEST_ASSERT_EQUAL_INT(104, InformationObject_getObjectAddress((InformationObject )mvs4_dec));
+    TEST_ASSERT_EQUAL_INT(105, InformationObject_getObjectAddress((InformationObject )mvs5_dec));
+    TEST_ASSERT_EQUAL_INT(106, InformationObject_getObjectAddress((InformationObject )mvs6_dec));
+    TEST_ASSERT_EQUAL_INT(107, InformationObject_getObjectAddress((InformationObject )mvs7_dec));
+    TEST_ASSERT_EQUAL_INT(108, InformationObject_getObjectAddress((InformationObject )mvs8_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs1_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs2_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs3_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs4_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs5_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs6_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs7_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs8_dec));
+
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs1_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs2_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs3_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs4_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs5_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs6_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs7_dec));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs8_dec));
+
+    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(MeasuredValueScaledWithCP56Time2a_getTimestamp(mvs1_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time2, CP56Time2a_toMsTimestamp(MeasuredValueScaledWithCP56Time2a_getTimestamp(mvs2_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time3, CP56Time2a_toMsTimestamp(MeasuredValueScaledWithCP56Time2a_getTimestamp(mvs3_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time4, CP56Time2a_toMsTimestamp(MeasuredValueScaledWithCP56Time2a_getTimestamp(mvs4_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time5, CP56Time2a_toMsTimestamp(MeasuredValueScaledWithCP56Time2a_getTimestamp(mvs5_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time6, CP56Time2a_toMsTimestamp(MeasuredValueScaledWithCP56Time2a_getTimestamp(mvs6_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time7, CP56Time2a_toMsTimestamp(MeasuredValueScaledWithCP56Time2a_getTimestamp(mvs7_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time8, CP56Time2a_toMsTimestamp(MeasuredValueScaledWithCP56Time2a_getTimestamp(mvs8_dec)));
+
+    MeasuredValueScaledWithCP56Time2a_destroy(mvs1_dec);
+    MeasuredValueScaledWithCP56Time2a_destroy(mvs2_dec);
+    MeasuredValueScaledWithCP56Time2a_destroy(mvs3_dec);
+    MeasuredValueScaledWithCP56Time2a_destroy(mvs4_dec);
+    MeasuredValueScaledWithCP56Time2a_destroy(mvs5_dec);
+    MeasuredValueScaledWithCP56Time2a_destroy(mvs6_dec);
+    MeasuredValueScaledWithCP56Time2a_destroy(mvs7_dec);
+    MeasuredValueScaledWithCP56Time2a_destroy(mvs8_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_MeasuredValueShort(void)
+{
+    MeasuredValueShort mvs1;
+    MeasuredValueShort mvs2;
+    MeasuredValueShort mvs3;
+    MeasuredValueShort mvs4;
+    MeasuredValueShort mvs5;
+    MeasuredValueShort mvs6;
+    MeasuredValueShort mvs7;
+    MeasuredValueShort mvs8;
+
+    mvs1 = MeasuredValueShort_create(NULL, 101, 10.5f, IEC60870_QUALITY_GOOD);
+    mvs2 = MeasuredValueShort_create(NULL, 102, 11.5f, IEC60870_QUALITY_OVERFLOW);
+    mvs3 = MeasuredValueShort_create(NULL, 103, 12.5f, IEC60870_QUALITY_RESERVED);
+    mvs4 = MeasuredValueShort_create(NULL, 104, 13.5f, IEC60870_QUALITY_ELAPSED_TIME_INVALID);
+    mvs5 = MeasuredValueShort_create(NULL, 105, 14.5f, IEC60870_QUALITY_BLOCKED);
+    mvs6 = MeasuredValueShort_create(NULL, 106, 15.5f, IEC60870_QUALITY_SUBSTITUTED);
+    mvs7 = MeasuredValueShort_create(NULL, 107, 16.5f, IEC60870_QUALITY_NON_TOPICAL);
+    mvs8 = MeasuredValueShort_create(NULL, 108, 17.5f, IEC60870_QUALITY_INVALID);
+
+    TEST_ASSERT_EQUAL_FLOAT(10.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs1));
+    TEST_ASSERT_EQUAL_FLOAT(11.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs2));
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs3));
+    TEST_ASSERT_EQUAL_FLOAT(13.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs4));
+    TEST_ASSERT_EQUAL_FLOAT(14.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs5));
+    TEST_ASSERT_EQUAL_FLOAT(15.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs6));
+    TEST_ASSERT_EQUAL_FLOAT(16.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs7));
+    TEST_ASSERT_EQUAL_FLOAT(17.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs8));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueShort_getQuality(mvs1));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueShort_getQuality(mvs2));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueShort_getQuality(mvs3));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueShort_getQuality(mvs4));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueShort_getQuality(mvs5));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueShort_getQuality(mvs6));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueShort_getQuality(mvs7));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueShort_getQuality(mvs8));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs2);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs3);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs4);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs5);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs6);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs7);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs8);
+
+    MeasuredValueShort_destroy(mvs1);
+    MeasuredValueShort_destroy(mvs2);
+    MeasuredValueShort_destroy(mvs3);
+    MeasuredValueShort_destroy(mvs4);
+    MeasuredValueShort_destroy(mvs5);
+    MeasuredValueShort_destroy(mvs6);
+    MeasuredValueShort_destroy(mvs7);
+    MeasuredValueShort_destroy(mvs8);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(70, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
+
+    MeasuredValueShort mvs1_dec = (MeasuredValueShort) CS101_ASDU_getElement(asdu2, 0);
+    MeasuredValueShort mvs2_dec = (MeasuredValueShort) CS101_ASDU_getElement(asdu2, 1);
+    MeasuredValueShort mvs3_dec = (MeasuredValueShort) CS101_ASDU_getElement(asdu2, 2);
+    MeasuredValueShort mvs4_dec = (MeasuredValueShort) CS101_ASDU_getElement(asdu2, 3);
+    MeasuredValueShort mvs5_dec = (MeasuredValueShort) CS101_ASDU_getElement(asdu2, 4);
+    MeasuredValueShort mvs6_dec = (MeasuredValueShort) CS101_ASDU_getElement(asdu2, 5);
+    MeasuredValueShort mvs7_dec = (MeasuredValueShort) CS101_ASDU_getElement(asdu2, 6);
+    MeasuredValueShort mvs8_dec = (MeasuredValueShort) CS101_ASDU_getElement(asdu2, 7);
+
+    TEST_ASSERT_EQUAL_FLOAT(10.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs1_dec));
+    TEST_ASSERT_EQUAL_FLOAT(11.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs2_dec));
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs3_dec));
+    TEST_ASSERT_EQUAL_FLOAT(13.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs4_dec));
+    TEST_ASSERT_EQUAL_FLOAT(14.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs5_dec));
+    TEST_ASSERT_EQUAL_FLOAT(15.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs6_dec));
+    TEST_ASSERT_EQUAL_FLOAT(16.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs7_dec));
+    TEST_ASSERT_EQUAL_FLOAT(17.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs8_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueShort_getQuality(mvs1_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueShort_getQuality(mvs2_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueShort_getQuality(mvs3_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueShort_getQuality(mvs4_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueShort_getQuality(mvs5_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueShort_getQuality(mvs6_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueShort_getQuality(mvs7_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueShort_getQuality(mvs8_dec));
+
+    MeasuredValueShort_destroy(mvs1_dec);
+    MeasuredValueShort_destroy(mvs2_dec);
+    MeasuredValueShort_destroy(mvs3_dec);
+    MeasuredValueShort_destroy(mvs4_dec);
+    MeasuredValueShort_destroy(mvs5_dec);
+    MeasuredValueShort_destroy(mvs6_dec);
+    MeasuredValueShort_destroy(mvs7_dec);
+    MeasuredValueShort_destroy(mvs8_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_MeasuredValueShortWithCP24Time2a(void)
+{
+    MeasuredValueShortWithCP24Time2a mvs1;
+    MeasuredValueShortWithCP24Time2a mvs2;
+    MeasuredValueShortWithCP24Time2a mvs3;
+    MeasuredValueShortWithCP24Time2a mvs4;
+    MeasuredValueShortWithCP24Time2a mvs5;
+    MeasuredValueShortWithCP24Time2a mvs6;
+    MeasuredValueShortWithCP24Time2a mvs7;
+    MeasuredValueShortWithCP24Time2a mvs8;
+
+    uint64_t time1 = Hal_getTimeInMs();
+    uint64_t time2 = time1 + 1000;
+    uint64_t time3 = time2 + 1000;
+    uint64_t time4 = time3 + 1000;
+    uint64_t time5 = time4 + 1000;
+    uint64_t time6 = time5 + 1000;
+    uint64_t time7 = time6 + 1000;
+    uint64_t time8 = time7 + 1000;
+
+    struct sCP24Time2a cpTime1;
+    struct sCP24Time2a cpTime2;
+    struct sCP24Time2a cpTime3;
+    struct sCP24Time2a cpTime4;
+    struct sCP24Time2a cpTime5;
+    struct sCP24Time2a cpTime6;
+    struct sCP24Time2a cpTime7;
+    struct sCP24Time2a cpTime8;
+
+    bzero(&cpTime1, sizeof(struct sCP24Time2a));
+    bzero(&cpTime2, sizeof(struct sCP24Time2a));
+    bzero(&cpTime3, sizeof(struct sCP24Time2a));
+    bzero(&cpTime4, sizeof(struct sCP24Time2a));
+    bzero(&cpTime5, sizeof(struct sCP24Time2a));
+    bzero(&cpTime6, sizeof(struct sCP24Time2a));
+    bzero(&cpTime7, sizeof(struct sCP24Time2a));
+    bzero(&cpTime8, sizeof(struct sCP24Time2a));
+
+    CP24Time2a_setMinute(&cpTime1, 12);
+    CP24Time2a_setMillisecond(&cpTime1, 24123);
+
+    CP24Time2a_setMinute(&cpTime2, 54);
+    CP24Time2a_setMillisecond(&cpTime2, 12345);
+
+    CP24Time2a_setMinute(&cpTime3, 00);
+    CP24Time2a_setMillisecond(&cpTime3, 00001);
+
+    CP24Time2a_setMinute(&cpTime4, 12);
+    CP24Time2a_setMillisecond(&cpTime4, 24123);
+
+    CP24Time2a_setMinute(&cpTime5, 12);
+    CP24Time2a_setMillisecond(&cpTime5, 24123);
+
+    CP24Time2a_setMinute(&cpTime6, 12);
+    CP24Time2a_setMillisecond(&cpTime6, 24123);
+
+    CP24Time2a_setMinute(&cpTime7, 12);
+    CP24Time2a_setMillisecond(&cpTime7, 24123);
+
+    CP24Time2a_setMinute(&cpTime8, 12);
+    CP24Time2a_setMillisecond(&cpTime8, 24123);
+
+    mvs1 = MeasuredValueShortWithCP24Time2a_create(NULL, 101, 10.5f, IEC60870_QUALITY_GOOD, &cpTime1);
+    mvs2 = MeasuredValueShortWithCP24Time2a_create(NULL, 102, 11.5f, IEC60870_QUALITY_OVERFLOW, &cpTime2);
+    mvs3 = MeasuredValueShortWithCP24Time2a_create(NULL, 103, 12.5f, IEC60870_QUALITY_RESERVED, &cpTime3);
+    mvs4 = MeasuredValueShortWithCP24Time2a_create(NULL, 104, 13.5f, IEC60870_QUALITY_ELAPSED_TIME_INVALID, &cpTime4);
+    mvs5 = MeasuredValueShortWithCP24Time2a_create(NULL, 105, 14.5f, IEC60870_QUALITY_BLOCKED, &cpTime5);
+    mvs6 = MeasuredValueShortWithCP24Time2a_create(NULL, 106, 15.5f, IEC60870_QUALITY_SUBSTITUTED, &cpTime6);
+    mvs7 = MeasuredValueShortWithCP24Time2a_create(NULL, 107, 16.5f, IEC60870_QUALITY_NON_TOPICAL, &cpTime7);
+    mvs8 = MeasuredValueShortWithCP24Time2a_create(NULL, 108, 17.5f, IEC60870_QUALITY_INVALID, &cpTime8);
+
+    TEST_ASSERT_EQUAL_FLOAT(10.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs1));
+    TEST_ASSERT_EQUAL_FLOAT(11.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs2));
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs3));
+    TEST_ASSERT_EQUAL_FLOAT(13.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs4));
+    TEST_ASSERT_EQUAL_FLOAT(14.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs5));
+    TEST_ASSERT_EQUAL_FLOAT(15.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs6));
+    TEST_ASSERT_EQUAL_FLOAT(16.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs7));
+    TEST_ASSERT_EQUAL_FLOAT(17.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs8));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueShort_getQuality((MeasuredValueShort )mvs1));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueShort_getQuality((MeasuredValueShort )mvs2));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs3));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueShort_getQuality((MeasuredValueShort )mvs4));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs5));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs6));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueShort_getQuality((MeasuredValueShort )mvs7));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueShort_getQuality((MeasuredValueShort )mvs8));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs2);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs3);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs4);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs5);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs6);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs7);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs8);
+
+    MeasuredValueShortWithCP24Time2a_destroy(mvs1);
+    MeasuredValueShortWithCP24Time2a_destroy(mvs2);
+    MeasuredValueShortWithCP24Time2a_destroy(mvs3);
+    MeasuredValueShortWithCP24Time2a_destroy(mvs4);
+    MeasuredValueShortWithCP24Time2a_destroy(mvs5);
+    MeasuredValueShortWithCP24Time2a_destroy(mvs6);
+    MeasuredValueShortWithCP24Time2a_destroy(mvs7);
+    MeasuredValueShortWithCP24Time2a_destroy(mvs8);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(94, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
+
+    MeasuredValueShortWithCP24Time2a mvs1_dec = (MeasuredValueShortWithCP24Time2a) CS101_ASDU_getElement(asdu2, 0);
+    MeasuredValueShortWithCP24Time2a mvs2_dec = (MeasuredValueShortWithCP24Time2a) CS101_ASDU_getElement(asdu2, 1);
+    MeasuredValueShortWithCP24Time2a mvs3_dec = (MeasuredValueShortWithCP24Time2a) CS101_ASDU_getElement(asdu2, 2);
+    MeasuredValueShortWithCP24Time2a mvs4_dec = (MeasuredValueShortWithCP24Time2a) CS101_ASDU_getElement(asdu2, 3);
+    MeasuredValueShortWithCP24Time2a mvs5_dec = (MeasuredValueShortWithCP24Time2a) CS101_ASDU_getElement(asdu2, 4);
+    MeasuredValueShortWithCP24Time2a mvs6_dec = (MeasuredValueShortWithCP24Time2a) CS101_ASDU_getElement(asdu2, 5);
+    MeasuredValueShortWithCP24Time2a mvs7_dec = (MeasuredValueShortWithCP24Time2a) CS101_ASDU_getElement(asdu2, 6);
+    MeasuredValueShortWithCP24Time2a mvs8_dec = (MeasuredValueShortWithCP24Time2a) CS101_ASDU_getElement(asdu2, 7);
+
+    TEST_ASSERT_EQUAL_FLOAT(10.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs1_dec));
+    TEST_ASSERT_EQUAL_FLOAT(11.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs2_dec));
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs3_dec));
+    TEST_ASSERT_EQUAL_FLOAT(13.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs4_dec));
+    TEST_ASSERT_EQUAL_FLOAT(14.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs5_dec));
+    TEST_ASSERT_EQUAL_FLOAT(15.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs6_dec));
+    TEST_ASSERT_EQUAL_FLOAT(16.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs7_dec));
+    TEST_ASSERT_EQUAL_FLOAT(17.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs8_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueShort_getQuality((MeasuredValueShort )mvs1_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueShort_getQuality((MeasuredValueShort )mvs2_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs3_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueShort_getQuality((MeasuredValueShort )mvs4_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs5_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs6_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueShort_getQuality((MeasuredValueShort )mvs7_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueShort_getQuality((MeasuredValueShort )mvs8_dec));
+
+    CP24Time2a time1_dec = MeasuredValueShortWithCP24Time2a_getTimestamp(mvs1_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time1_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time1_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time1_dec));
+
+    CP24Time2a time2_dec = MeasuredValueShortWithCP24Time2a_getTimestamp(mvs2_dec);
+    TEST_ASSERT_EQUAL_INT(54, CP24Time2a_getMinute(time2_dec));
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getSecond(time2_dec));
+    TEST_ASSERT_EQUAL_INT(345, CP24Time2a_getMillisecond(time2_dec));
+
+    CP24Time2a time3_dec = MeasuredValueShortWithCP24Time2a_getTimestamp(mvs3_dec);
+    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getMinute(time3_dec));
+    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getSecond(time3_dec));
+    TEST_ASSERT_EQUAL_INT(1, CP24Time2a_getMillisecond(time3_dec));
+
+    CP24Time2a time4_dec = MeasuredValueShortWithCP24Time2a_getTimestamp(mvs4_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time4_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time4_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time4_dec));
+
+    CP24Time2a time5_dec = MeasuredValueShortWithCP24Time2a_getTimestamp(mvs5_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time5_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time5_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time5_dec));
+
+    CP24Time2a time6_dec = MeasuredValueShortWithCP24Time2a_getTimestamp(mvs6_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time6_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time6_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time6_dec));
+
+    CP24Time2a time7_dec = MeasuredValueShortWithCP24Time2a_getTimestamp(mvs7_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time7_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time7_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time7_dec));
+
+    CP24Time2a time8_dec = MeasuredValueShortWithCP24Time2a_getTimestamp(mvs8_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time8_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time8_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time8_dec));
+
+    MeasuredValueShortWithCP24Time2a_destroy(mvs1_dec);
+    MeasuredValueShortWithCP24Time2a_destroy(mvs2_dec);
+    MeasuredValueShortWithCP24Time2a_destroy(mvs3_dec);
+    MeasuredValueShortWithCP24Time2a_destroy(mvs4_dec);
+    MeasuredValueShortWithCP24Time2a_destroy(mvs5_dec);
+    MeasuredValueShortWithCP24Time2a_destroy(mvs6_dec);
+    MeasuredValueShortWithCP24Time2a_destroy(mvs7_dec);
+    MeasuredValueShortWithCP24Time2a_destroy(mvs8_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_MeasuredValueShortWithCP56Time2a(void)
+{
+    MeasuredValueShortWithCP56Time2a mvs1;
+    MeasuredValueShortWithCP56Time2a mvs2;
+    MeasuredValueShortWithCP56Time2a mvs3;
+    MeasuredValueShortWithCP56Time2a mvs4;
+    MeasuredValueShortWithCP56Time2a mvs5;
+    MeasuredValueShortWithCP56Time2a mvs6;
+    MeasuredValueShortWithCP56Time2a mvs7;
+    MeasuredValueShortWithCP56Time2a mvs8;
+
+    uint64_t time1 = Hal_getTimeInMs();
+    uint64_t time2 = time1 + 1000;
+    uint64_t time3 = time2 + 1000;
+    uint64_t time4 = time3 + 1000;
+    uint64_t time5 = time4 + 1000;
+    uint64_t time6 = time5 + 1000;
+    uint64_t time7 = time6 + 1000;
+    uint64_t time8 = time7 + 1000;
+
+    struct sCP56Time2a cpTime1;
+    struct sCP56Time2a cpTime2;
+    struct sCP56Time2a cpTime3;
+    struct sCP56Time2a cpTime4;
+    struct sCP56Time2a cpTime5;
+    struct sCP56Time2a cpTime6;
+    struct sCP56Time2a cpTime7;
+    struct sCP56Time2a cpTime8;
+
+    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
+    CP56Time2a_createFromMsTimestamp(&cpTime2, time2);
+    CP56Time2a_createFromMsTimestamp(&cpTime3, time3);
+    CP56Time2a_createFromMsTimestamp(&cpTime4, time4);
+    CP56Time2a_createFromMsTimestamp(&cpTime5, time5);
+    CP56Time2a_createFromMsTimestamp(&cpTime6, time6);
+    CP56Time2a_createFromMsTimestamp(&cpTime7, time7);
+    CP56Time2a_createFromMsTimestamp(&cpTime8, time8);
+
+    mvs1 = MeasuredValueShortWithCP56Time2a_create(NULL, 101, 10.5f, IEC60870_QUALITY_GOOD, &cpTime1);
+    mvs2 = MeasuredValueShortWithCP56Time2a_create(NULL, 102, 11.5f, IEC60870_QUALITY_OVERFLOW, &cpTime2);
+    mvs3 = MeasuredValueShortWithCP56Time2a_create(NULL, 103, 12.5f, IEC60870_QUALITY_RESERVED, &cpTime3);
+    mvs4 = MeasuredValueShortWithCP56Time2a_create(NULL, 104, 13.5f, IEC60870_QUALITY_ELAPSED_TIME_INVALID, &cpTime4);
+    mvs5 = MeasuredValueShortWithCP56Time2a_create(NULL, 105, 14.5f, IEC60870_QUALITY_BLOCKED, &cpTime5);
+    mvs6 = MeasuredValueShortWithCP56Time2a_create(NULL, 106, 15.5f, IEC60870_QUALITY_SUBSTITUTED, &cpTime6);
+    mvs7 = MeasuredValueShortWithCP56Time2a_create(NULL, 107, 16.5f, IEC60870_QUALITY_NON_TOPICAL, &cpTime7);
+    mvs8 = MeasuredValueShortWithCP56Time2a_create(NULL, 108, 17.5f, IEC60870_QUALITY_INVALID, &cpTime8);
+
+    TEST_ASSERT_EQUAL_FLOAT(10.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs1));
+    TEST_ASSERT_EQUAL_FLOAT(11.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs2));
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs3));
+    TEST_ASSERT_EQUAL_FLOAT(13.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs4));
+    TEST_ASSERT_EQUAL_FLOAT(14.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs5));
+    TEST_ASSERT_EQUAL_FLOAT(15.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs6));
+    TEST_ASSERT_EQUAL_FLOAT(16.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs7));
+    TEST_ASSERT_EQUAL_FLOAT(17.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs8));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueShort_getQuality((MeasuredValueShort )mvs1));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueShort_getQuality((MeasuredValueShort )mvs2));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs3));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueShort_getQuality((MeasuredValueShort )mvs4));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs5));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs6));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueShort_getQuality((MeasuredValueShort )mvs7));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueShort_getQuality((MeasuredValueShort )mvs8));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs2);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs3);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs4);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs5);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs6);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs7);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs8);
+
+    MeasuredValueShortWithCP56Time2a_destroy(mvs1);
+    MeasuredValueShortWithCP56Time2a_destroy(mvs2);
+    MeasuredValueShortWithCP56Time2a_destroy(mvs3);
+    MeasuredValueShortWithCP56Time2a_destroy(mvs4);
+    MeasuredValueShortWithCP56Time2a_destroy(mvs5);
+    MeasuredValueShortWithCP56Time2a_destroy(mvs6);
+    MeasuredValueShortWithCP56Time2a_destroy(mvs7);
+    MeasuredValueShortWithCP56Time2a_destroy(mvs8);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(126, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
+
+    MeasuredValueShortWithCP56Time2a mvs1_dec = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
+    MeasuredValueShortWithCP56Time2a mvs2_dec = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 1);
+    MeasuredValueShortWithCP56Time2a mvs3_dec = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 2);
+    MeasuredValueShortWithCP56Time2a mvs4_dec = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 3);
+    MeasuredValueShortWithCP56Time2a mvs5_dec = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 4);
+    MeasuredValueShortWithCP56Time2a mvs6_dec = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 5);
+    MeasuredValueShortWithCP56Time2a mvs7_dec = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 6);
+    MeasuredValueShortWithCP56Time2a mvs8_dec = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 7);
+
+    TEST_ASSERT_EQUAL_FLOAT(10.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs1_dec));
+    TEST_ASSERT_EQUAL_FLOAT(11.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs2_dec));
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs3_dec));
+    TEST_ASSERT_EQUAL_FLOAT(13.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs4_dec));
+    TEST_ASSERT_EQUAL_FLOAT(14.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs5_dec));
+    TEST_ASSERT_EQUAL_FLOAT(15.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs6_dec));
+    TEST_ASSERT_EQUAL_FLOAT(16.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs7_dec));
+    TEST_ASSERT_EQUAL_FLOAT(17.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs8_dec));
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueShort_getQuality((MeasuredValueShort )mvs1_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueShort_getQuality((MeasuredValueShort )mvs2_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs3_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueShort_getQuality((MeasuredValueShort )mvs4_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs5_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs6_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueShort_getQuality((MeasuredValueShort )mvs7_dec));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueShort_getQuality((MeasuredValueShort )mvs8_dec));
+
+    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mvs1_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time2, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mvs2_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time3, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mvs3_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time4, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mvs4_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time5, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mvs5_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time6, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mvs6_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time7, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mvs7_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time8, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mvs8_dec)));
+
+    MeasuredValueShortWithCP56Time2a_destroy(mvs1_dec);
+    MeasuredValueShortWithCP56Time2a_destroy(mvs2_dec);
+    MeasuredValueShortWithCP56Time2a_destroy(mvs3_dec);
+    MeasuredValueShortWithCP56Time2a_destroy(mvs4_dec);
+    MeasuredValueShortWithCP56Time2a_destroy(mvs5_dec);
+    MeasuredValueShortWithCP56Time2a_destroy(mvs6_dec);
+    MeasuredValueShortWithCP56Time2a_destroy(mvs7_dec);
+    MeasuredValueShortWithCP56Time2a_destroy(mvs8_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_IntegratedTotals(void)
+{
+    IntegratedTotals it1;
+    IntegratedTotals it2;
+    BinaryCounterReading bcr1;
+    BinaryCounterReading bcr2;
+
+    bcr1 = BinaryCounterReading_create(NULL, INT32_MAX, 0, true, true, true);
+    bcr2 = BinaryCounterReading_create(NULL, INT32_MIN, 15, false, false, false);
+    it1 = IntegratedTotals_create(NULL, 101, bcr1);
+    it2 = IntegratedTotals_create(NULL, 102, bcr2);
+
+    BinaryCounterReading_destroy(bcr1);
+    BinaryCounterReading_destroy(bcr2);
+
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, BinaryCounterReading_getValue(IntegratedTotals_getBCR(it1)));
+    TEST_ASSERT_EQUAL_UINT8(0, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR(it1)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR(it1)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR(it1)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR(it1)));
+
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, BinaryCounterReading_getValue(IntegratedTotals_getBCR(it2)));
+    TEST_ASSERT_EQUAL_UINT8(15, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR(it2)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR(it2)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR(it2)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR(it2)));
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) it1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) it2);
+
+    IntegratedTotals_destroy(it1);
+    IntegratedTotals_destroy(it2);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(22, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(2, CS101_ASDU_getNumberOfElements(asdu2));
+
+    IntegratedTotals it1_dec = (IntegratedTotals) CS101_ASDU_getElement(asdu2, 0);
+    IntegratedTotals it2_dec = (IntegratedTotals) CS101_ASDU_getElement(asdu2, 1);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )it1_dec));
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, BinaryCounterReading_getValue(IntegratedTotals_getBCR(it1_dec)));
+    TEST_ASSERT_EQUAL_UINT8(0, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR(it1_dec)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR(it1_dec)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR(it1_dec)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR(it1_dec)));
+
+    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )it2_dec));
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, BinaryCounterReading_getValue(IntegratedTotals_getBCR(it2_dec)));
+    TEST_ASSERT_EQUAL_UINT8(15, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR(it2_dec)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR(it2_dec)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR(it2_dec)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR(it2_dec)));
+
+    IntegratedTotals_destroy(it1_dec);
+    IntegratedTotals_destroy(it2_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_IntegratedTotalsWithCP24Time2a(void)
+{
+    IntegratedTotalsWithCP24Time2a it1;
+    IntegratedTotalsWithCP24Time2a it2;
+    BinaryCounterReading bcr1;
+    BinaryCounterReading bcr2;
+    uint64_t time1 = Hal_getTimeInMs();
+    uint64_t time2 = time1 + 1000;
+
+    struct sCP24Time2a cpTime1;
+    struct sCP24Time2a cpTime2;
+
+    bzero(&cpTime1, sizeof(struct sCP24Time2a));
+    bzero(&cpTime2, sizeof(struct sCP24Time2a));
+
+    CP24Time2a_setMinute(&cpTime1, 12);
+    CP24Time2a_setMillisecond(&cpTime1, 24123);
+
+    CP24Time2a_setMinute(&cpTime2, 54);
+    CP24Time2a_setMillisecond(&cpTime2, 12345);
+
+    bcr1 = BinaryCounterReading_create(NULL, INT32_MAX, 0, true, true, true);
+    bcr2 = BinaryCounterReading_create(NULL, INT32_MIN, 15, false, false, false);
+    it1 = IntegratedTotalsWithCP24Time2a_create(NULL, 101, bcr1, &cpTime1);
+    it2 = IntegratedTotalsWithCP24Time2a_create(NULL, 102, bcr2, &cpTime2);
+
+    BinaryCounterReading_destroy(bcr1);
+    BinaryCounterReading_destroy(bcr2);
+
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, BinaryCounterReading_getValue(IntegratedTotals_getBCR((IntegratedTotals )it1)));
+    TEST_ASSERT_EQUAL_UINT8(0, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR((IntegratedTotals )it1)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR((IntegratedTotals )it1)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR((IntegratedTotals )it1)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR((IntegratedTotals )it1)));
+
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, BinaryCounterReading_getValue(IntegratedTotals_getBCR((IntegratedTotals )it2)));
+    TEST_ASSERT_EQUAL_UINT8(15, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR((IntegratedTotals )it2)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR((IntegratedTotals )it2)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR((IntegratedTotals )it2)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR((IntegratedTotals )it2)));
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) it1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) it2);
+
+    IntegratedTotalsWithCP24Time2a_destroy(it1);
+    IntegratedTotalsWithCP24Time2a_destroy(it2);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(28, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(2, CS101_ASDU_getNumberOfElements(asdu2));
+
+    IntegratedTotalsWithCP24Time2a it1_dec = (IntegratedTotalsWithCP24Time2a) CS101_ASDU_getElement(asdu2, 0);
+    IntegratedTotalsWithCP24Time2a it2_dec = (IntegratedTotalsWithCP24Time2a) CS101_ASDU_getElement(asdu2, 1);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )it1_dec));
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, BinaryCounterReading_getValue(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
+    TEST_ASSERT_EQUAL_UINT8(0, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
+
+    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )it2_dec));
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, BinaryCounterReading_getValue(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
+    TEST_ASSERT_EQUAL_UINT8(15, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
+
+    CP24Time2a time1_dec = IntegratedTotalsWithCP24Time2a_getTimestamp(it1_dec);
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time1_dec));
+    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time1_dec));
+    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time1_dec));
+
+    CP24Time2a time2_dec = IntegratedTotalsWithCP24Time2a_getTimestamp(it2_dec);
+    TEST_ASSERT_EQUAL_INT(54, CP24Time2a_getMinute(time2_dec));
+    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getSecond(time2_dec));
+    TEST_ASSERT_EQUAL_INT(345, CP24Time2a_getMillisecond(time2_dec));
+
+    IntegratedTotalsWithCP24Time2a_destroy(it1_dec);
+    IntegratedTotalsWithCP24Time2a_destroy(it2_dec);
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_IntegratedTotalsWithCP56Time2a(void)
+{
+    IntegratedTotalsWithCP56Time2a it1;
+    IntegratedTotalsWithCP56Time2a it2;
+    BinaryCounterReading bcr1;
+    BinaryCounterReading bcr2;
+
+    uint64_t time1 = Hal_getTimeInMs();
+    uint64_t time2 = time1 + 1000;
+
+    struct sCP56Time2a cpTime1;
+    struct sCP56Time2a cpTime2;
+
+    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
+    CP56Time2a_createFromMsTimestamp(&cpTime2, time2);
+
+    bcr1 = BinaryCounterReading_create(NULL, INT32_MAX, 0, true, true, true);
+    bcr2 = BinaryCounterReading_create(NULL, INT32_MIN, 15, false, false, false);
+    it1 = IntegratedTotalsWithCP56Time2a_create(NULL, 101, bcr1, &cpTime1);
+    it2 = IntegratedTotalsWithCP56Time2a_create(NULL, 102, bcr2, &cpTime2);
+
+    BinaryCounterReading_destroy(bcr1);
+    BinaryCounterReading_destroy(bcr2);
+
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, BinaryCounterReading_getValue(IntegratedTotals_getBCR((IntegratedTotals )it1)));
+    TEST_ASSERT_EQUAL_UINT8(0, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR((IntegratedTotals )it1)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR((IntegratedTotals )it1)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR((IntegratedTotals )it1)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR((IntegratedTotals )it1)));
+
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, BinaryCounterReading_getValue(IntegratedTotals_getBCR((IntegratedTotals )it2)));
+    TEST_ASSERT_EQUAL_UINT8(15, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR((IntegratedTotals )it2)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR((IntegratedTotals )it2)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR((IntegratedTotals )it2)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR((IntegratedTotals )it2)));
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) it1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) it2);
+
+    IntegratedTotalsWithCP56Time2a_destroy(it1);
+    IntegratedTotalsWithCP56Time2a_destroy(it2);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(36, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(2, CS101_ASDU_getNumberOfElements(asdu2));
+
+    IntegratedTotalsWithCP56Time2a it1_dec = (IntegratedTotalsWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
+    IntegratedTotalsWithCP56Time2a it2_dec = (IntegratedTotalsWithCP56Time2a) CS101_ASDU_getElement(asdu2, 1);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )it1_dec));
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, BinaryCounterReading_getValue(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
+    TEST_ASSERT_EQUAL_UINT8(0, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
+    TEST_ASSERT_TRUE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
+
+    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )it2_dec));
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, BinaryCounterReading_getValue(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
+    TEST_ASSERT_EQUAL_UINT8(15, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
+    TEST_ASSERT_FALSE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
+
+    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(IntegratedTotalsWithCP56Time2a_getTimestamp(it1_dec)));
+    TEST_ASSERT_EQUAL_UINT64(time2, CP56Time2a_toMsTimestamp(IntegratedTotalsWithCP56Time2a_getTimestamp(it2_dec)));
+
+    IntegratedTotalsWithCP56Time2a_destroy(it1_dec);
+    IntegratedTotalsWithCP56Time2a_destroy(it2_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_SingleCommand(void)
+{
+    SingleCommand sc;
+    sc = SingleCommand_create(NULL, 101, true, true, 0);
+
+    TEST_ASSERT_TRUE(SingleCommand_getState(sc));
+    TEST_ASSERT_TRUE(SingleCommand_isSelect(sc));
+    TEST_ASSERT_EQUAL_INT(0, SingleCommand_getQU(sc));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) sc);
+
+    SingleCommand_destroy(sc);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(10, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+
+    SingleCommand sc_dec = (SingleCommand) CS101_ASDU_getElement(asdu2, 0);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )sc_dec));
+
+    TEST_ASSERT_TRUE(SingleCommand_getState(sc_dec));
+    TEST_ASSERT_TRUE(SingleCommand_isSelect(sc_dec));
+    TEST_ASSERT_EQUAL_INT(0, SingleCommand_getQU(sc_dec));
+
+    SingleCommand_destroy(sc_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_SingleCommandWithCP56Time2a(void)
+{
+    SingleCommandWithCP56Time2a sc;
+
+    uint64_t time1 = Hal_getTimeInMs();
+
+    struct sCP56Time2a cpTime1;
+
+    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
+
+    sc = SingleCommandWithCP56Time2a_create(NULL, 101, true, true, 0, &cpTime1);
+
+    TEST_ASSERT_TRUE(SingleCommand_getState((SingleCommand )sc));
+    TEST_ASSERT_TRUE(SingleCommand_isSelect((SingleCommand )sc));
+    TEST_ASSERT_EQUAL_INT(0, SingleCommand_getQU((SingleCommand )sc));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) sc);
+
+    SingleCommandWithCP56Time2a_destroy(sc);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(17, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+
+    SingleCommandWithCP56Time2a sc_dec = (SingleCommandWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )sc_dec));
+
+    TEST_ASSERT_TRUE(SingleCommand_getState((SingleCommand )sc_dec));
+    TEST_ASSERT_TRUE(SingleCommand_isSelect((SingleCommand )sc_dec));
+    TEST_ASSERT_EQUAL_INT(0, SingleCommand_getQU((SingleCommand )sc_dec));
+    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(SingleCommandWithCP56Time2a_getTimestamp(sc_dec)));
+
+    SingleCommandWithCP56Time2a_destroy(sc_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_DoubleCommand(void)
+{
+    DoubleCommand dc;
+    dc = DoubleCommand_create(NULL, 101, 1, true, 0);
+
+    TEST_ASSERT_TRUE(DoubleCommand_isSelect(dc));
+    TEST_ASSERT_EQUAL_INT(1, DoubleCommand_getState(dc));
+    TEST_ASSERT_EQUAL_INT(0, DoubleCommand_getQU(dc));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) dc);
+
+    DoubleCommand_destroy(dc);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(10, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+
+    DoubleCommand dc_dec = (DoubleCommand) CS101_ASDU_getElement(asdu2, 0);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )dc_dec));
+
+    TEST_ASSERT_TRUE(DoubleCommand_isSelect(dc_dec));
+    TEST_ASSERT_EQUAL_INT(1, DoubleCommand_getState(dc_dec));
+    TEST_ASSERT_EQUAL_INT(0, DoubleCommand_getQU(dc_dec));
+
+    DoubleCommand_destroy(dc_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_DoubleCommandWithCP56Time2a(void)
+{
+    DoubleCommandWithCP56Time2a dc;
+
+    uint64_t time1 = Hal_getTimeInMs();
+    struct sCP56Time2a cpTime1;
+    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
+
+    dc = DoubleCommandWithCP56Time2a_create(NULL, 101, 1, true, 0, &cpTime1);
+
+    TEST_ASSERT_TRUE(DoubleCommandWithCP56Time2a_isSelect(dc));
+    TEST_ASSERT_EQUAL_INT(1, DoubleCommandWithCP56Time2a_getState(dc));
+    TEST_ASSERT_EQUAL_INT(0, DoubleCommandWithCP56Time2a_getQU(dc));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) dc);
+
+    DoubleCommandWithCP56Time2a_destroy(dc);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(17, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+
+    DoubleCommandWithCP56Time2a dc_dec = (DoubleCommandWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )dc_dec));
+
+    TEST_ASSERT_TRUE(DoubleCommandWithCP56Time2a_isSelect(dc_dec));
+    TEST_ASSERT_EQUAL_INT(1, DoubleCommandWithCP56Time2a_getState(dc_dec));
+    TEST_ASSERT_EQUAL_INT(0, DoubleCommandWithCP56Time2a_getQU(dc_dec));
+    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(DoubleCommandWithCP56Time2a_getTimestamp(dc_dec)));
+
+    DoubleCommandWithCP56Time2a_destroy(dc_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_StepCommandValue(void)
+{
+    StepCommand scv;
+    scv = StepCommand_create(NULL, 101, IEC60870_STEP_INVALID_0, true, 0);
+
+    TEST_ASSERT_TRUE(StepCommand_isSelect(scv));
+    TEST_ASSERT_EQUAL_INT(IEC60870_STEP_INVALID_0, StepCommand_getState(scv));
+    TEST_ASSERT_EQUAL_INT(0, StepCommand_getQU(scv));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) scv);
+
+    StepCommand_destroy(scv);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(10, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, SinglePointInformation_getQuality((SinglePointInformation)spi2_dec));
-    TEST_ASSERT_FALSE(SinglePointInformation_getValue((SinglePointInformation)spi2_dec));
-    TEST_ASSERT_EQUAL_UINT64(time2, CP56Time2a_toMsTimestamp(SinglePointWithCP56Time2a_getTimestamp(spi2_dec)));
+    StepCommand scv_dec = (StepCommand) CS101_ASDU_getElement(asdu2, 0);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, SinglePointInformation_getQuality((SinglePointInformation)spi3_dec));
-    TEST_ASSERT_TRUE(SinglePointInformation_getValue((SinglePointInformation)spi3_dec));
-    TEST_ASSERT_EQUAL_UINT64(time3, CP56Time2a_toMsTimestamp(SinglePointWithCP56Time2a_getTimestamp(spi3_dec)));
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )scv_dec));
 
-    InformationObject_destroy((InformationObject) spi1_dec);
-    InformationObject_destroy((InformationObject) spi2_dec);
-    InformationObject_destroy((InformationObject) spi3_dec);
+    TEST_ASSERT_TRUE(StepCommand_isSelect(scv_dec));
+    TEST_ASSERT_EQUAL_INT(IEC60870_STEP_INVALID_0, StepCommand_getState(scv_dec));
+    TEST_ASSERT_EQUAL_INT(0, StepCommand_getQU(scv_dec));
+
+    StepCommand_destroy(scv_dec);
 
     CS101_ASDU_destroy(asdu2);
 }
 
 void
-test_NormalizeMeasureValueWithoutQuality(void)
+test_StepCommandWithCP56Time2a(void)
 {
-    MeasuredValueNormalizedWithoutQuality nmv1;
+    StepCommandWithCP56Time2a scv;
+    uint64_t time1 = Hal_getTimeInMs();
+    struct sCP56Time2a cpTime1;
+    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
 
-    nmv1 = MeasuredValueNormalizedWithoutQuality_create(NULL, 101, 0.5f);
+    scv = StepCommandWithCP56Time2a_create(NULL, 101, IEC60870_STEP_INVALID_0, true, 0, &cpTime1);
 
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, MeasuredValueNormalizedWithoutQuality_getValue((MeasuredValueNormalizedWithoutQuality )nmv1));
+    TEST_ASSERT_TRUE(StepCommandWithCP56Time2a_isSelect(scv));
+    TEST_ASSERT_EQUAL_INT(IEC60870_STEP_INVALID_0, StepCommandWithCP56Time2a_getState(scv));
+    TEST_ASSERT_EQUAL_INT(0, StepCommandWithCP56Time2a_getQU(scv));
 
     uint8_t buffer[256];
 
@@ -2212,15 +5645,15 @@ test_NormalizeMeasureValueWithoutQuality(void)
 
     Frame f = BufferFrame_initialize(&bf, buffer, 0);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) scv);
 
-    MeasuredValueNormalizedWithoutQuality_destroy(nmv1);
+    StepCommandWithCP56Time2a_destroy((StepCommandWithCP56Time2a) scv);
 
     CS101_ASDU_encode(asdu, f);
 
-    TEST_ASSERT_EQUAL_INT(11, Frame_getMsgSize(f));
+    TEST_ASSERT_EQUAL_INT(17, Frame_getMsgSize(f));
 
     CS101_ASDU_destroy(asdu);
 
@@ -2228,53 +5661,29 @@ test_NormalizeMeasureValueWithoutQuality(void)
 
     TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
 
-    MeasuredValueNormalizedWithoutQuality nmv1_dec = (MeasuredValueNormalizedWithoutQuality) CS101_ASDU_getElement(asdu2, 0);
+    StepCommandWithCP56Time2a scv_dec = (StepCommandWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )nmv1_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, MeasuredValueNormalizedWithoutQuality_getValue((MeasuredValueNormalizedWithoutQuality )nmv1_dec));
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )scv_dec));
+
+    TEST_ASSERT_TRUE(StepCommandWithCP56Time2a_isSelect(scv_dec));
+    TEST_ASSERT_EQUAL_INT(IEC60870_STEP_INVALID_0, StepCommandWithCP56Time2a_getState(scv_dec));
+    TEST_ASSERT_EQUAL_INT(0, StepCommandWithCP56Time2a_getQU(scv_dec));
+    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(StepCommandWithCP56Time2a_getTimestamp(scv_dec)));
+
+    StepCommandWithCP56Time2a_destroy((StepCommandWithCP56Time2a) scv_dec);
 
-    MeasuredValueNormalizedWithoutQuality_destroy(nmv1_dec);
     CS101_ASDU_destroy(asdu2);
 }
 
 void
-test_NormalizeMeasureValue(void)
+test_SetpointCommandNormalized(void)
 {
-    MeasuredValueNormalized nmv1;
-    MeasuredValueNormalized nmv2;
-    MeasuredValueNormalized nmv3;
-    MeasuredValueNormalized nmv4;
-    MeasuredValueNormalized nmv5;
-    MeasuredValueNormalized nmv6;
-    MeasuredValueNormalized nmv7;
-    MeasuredValueNormalized nmv8;
-
-    nmv1 = MeasuredValueNormalized_create(NULL, 101, -0.5f, IEC60870_QUALITY_GOOD);
-    nmv2 = MeasuredValueNormalized_create(NULL, 102, -0.2f, IEC60870_QUALITY_OVERFLOW);
-    nmv3 = MeasuredValueNormalized_create(NULL, 103, -0.1f, IEC60870_QUALITY_RESERVED);
-    nmv4 = MeasuredValueNormalized_create(NULL, 104, 0, IEC60870_QUALITY_ELAPSED_TIME_INVALID);
-    nmv5 = MeasuredValueNormalized_create(NULL, 105, 0.2f, IEC60870_QUALITY_BLOCKED);
-    nmv6 = MeasuredValueNormalized_create(NULL, 106, 0.3f, IEC60870_QUALITY_SUBSTITUTED);
-    nmv7 = MeasuredValueNormalized_create(NULL, 107, 0.4f, IEC60870_QUALITY_NON_TOPICAL);
-    nmv8 = MeasuredValueNormalized_create(NULL, 108, 0.5f, IEC60870_QUALITY_INVALID);
-
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv1));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv2));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv3));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv4));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv5));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv6));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv7));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv8));
+    SetpointCommandNormalized spcn;
+    spcn = SetpointCommandNormalized_create(NULL, 101, -1, true, 0);
 
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv1));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv2));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.1f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv3));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv4));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv5));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.3f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv6));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.4f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv7));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv8));
+    TEST_ASSERT_EQUAL_INT(-1, SetpointCommandNormalized_getValue(spcn));
+    TEST_ASSERT_EQUAL_INT(0, SetpointCommandNormalized_getQL(spcn));
+    TEST_ASSERT_TRUE(SetpointCommandNormalized_isSelect(spcn));
 
     uint8_t buffer[256];
 
@@ -2282,182 +5691,144 @@ test_NormalizeMeasureValue(void)
 
     Frame f = BufferFrame_initialize(&bf, buffer, 0);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv2);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv3);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv4);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv5);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv6);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv7);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv8);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) spcn);
 
-    MeasuredValueNormalized_destroy(nmv1);
-    MeasuredValueNormalized_destroy(nmv2);
-    MeasuredValueNormalized_destroy(nmv3);
-    MeasuredValueNormalized_destroy(nmv4);
-    MeasuredValueNormalized_destroy(nmv5);
-    MeasuredValueNormalized_destroy(nmv6);
-    MeasuredValueNormalized_destroy(nmv7);
-    MeasuredValueNormalized_destroy(nmv8);
+    SetpointCommandNormalized_destroy(spcn);
 
     CS101_ASDU_encode(asdu, f);
 
-    TEST_ASSERT_EQUAL_INT(54, Frame_getMsgSize(f));
+    TEST_ASSERT_EQUAL_INT(12, Frame_getMsgSize(f));
 
     CS101_ASDU_destroy(asdu);
 
     CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
 
-    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
 
-    MeasuredValueNormalized nmv1_dec = (MeasuredValueNormalized) CS101_ASDU_getElement(asdu2, 0);
-    MeasuredValueNormalized nmv2_dec = (MeasuredValueNormalized) CS101_ASDU_getElement(asdu2, 1);
-    MeasuredValueNormalized nmv3_dec = (MeasuredValueNormalized) CS101_ASDU_getElement(asdu2, 2);
-    MeasuredValueNormalized nmv4_dec = (MeasuredValueNormalized) CS101_ASDU_getElement(asdu2, 3);
-    MeasuredValueNormalized nmv5_dec = (MeasuredValueNormalized) CS101_ASDU_getElement(asdu2, 4);
-    MeasuredValueNormalized nmv6_dec = (MeasuredValueNormalized) CS101_ASDU_getElement(asdu2, 5);
-    MeasuredValueNormalized nmv7_dec = (MeasuredValueNormalized) CS101_ASDU_getElement(asdu2, 6);
-    MeasuredValueNormalized nmv8_dec = (MeasuredValueNormalized) CS101_ASDU_getElement(asdu2, 7);
+    SetpointCommandNormalized spcn_dec = (SetpointCommandNormalized) CS101_ASDU_getElement(asdu2, 0);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )nmv1_dec));
-    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )nmv2_dec));
-    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )nmv3_dec));
-    TEST_ASSERT_EQUAL_INT(104, InformationObject_getObjectAddress((InformationObject )nmv4_dec));
-    TEST_ASSERT_EQUAL_INT(105, InformationObject_getObjectAddress((InformationObject )nmv5_dec));
-    TEST_ASSERT_EQUAL_INT(106, InformationObject_getObjectAddress((InformationObject )nmv6_dec));
-    TEST_ASSERT_EQUAL_INT(107, InformationObject_getObjectAddress((InformationObject )nmv7_dec));
-    TEST_ASSERT_EQUAL_INT(108, InformationObject_getObjectAddress((InformationObject )nmv8_dec));
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )spcn_dec));
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv1_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv2_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv3_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv4_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv5_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv6_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv7_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv8_dec));
+    TEST_ASSERT_EQUAL_INT(-1, SetpointCommandNormalized_getValue(spcn_dec));
+    TEST_ASSERT_EQUAL_INT(0, SetpointCommandNormalized_getQL(spcn_dec));
+    TEST_ASSERT_TRUE(SetpointCommandNormalized_isSelect(spcn_dec));
 
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv1_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv2_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.1f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv3_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv4_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv5_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.3f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv6_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.4f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv7_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv8_dec));
+    SetpointCommandNormalized_destroy(spcn_dec);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )nmv1_dec));
-    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )nmv2_dec));
-    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )nmv3_dec));
-    TEST_ASSERT_EQUAL_INT(104, InformationObject_getObjectAddress((InformationObject )nmv4_dec));
-    TEST_ASSERT_EQUAL_INT(105, InformationObject_getObjectAddress((InformationObject )nmv5_dec));
-    TEST_ASSERT_EQUAL_INT(106, InformationObject_getObjectAddress((InformationObject )nmv6_dec));
-    TEST_ASSERT_EQUAL_INT(107, InformationObject_getObjectAddress((InformationObject )nmv7_dec));
-    TEST_ASSERT_EQUAL_INT(108, InformationObject_getObjectAddress((InformationObject )nmv8_dec));
+    CS101_ASDU_destroy(asdu2);
+}
 
-    MeasuredValueNormalized_destroy(nmv1_dec);
-    MeasuredValueNormalized_destroy(nmv2_dec);
-    MeasuredValueNormalized_destroy(nmv3_dec);
-    MeasuredValueNormalized_destroy(nmv4_dec);
-    MeasuredValueNormalized_destroy(nmv5_dec);
-    MeasuredValueNormalized_destroy(nmv6_dec);
-    MeasuredValueNormalized_destroy(nmv7_dec);
-    MeasuredValueNormalized_destroy(nmv8_dec);
+void
+test_SetpointCommandNormalizedWithCP56Time2a(void)
+{
+    SetpointCommandNormalizedWithCP56Time2a spcn;
+    uint64_t time1 = Hal_getTimeInMs();
+    struct sCP56Time2a cpTime1;
+    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
+
+    spcn = SetpointCommandNormalizedWithCP56Time2a_create(NULL, 101, 0, true, 0, &cpTime1);
+
+    TEST_ASSERT_EQUAL_INT(0, SetpointCommandNormalizedWithCP56Time2a_getValue(spcn));
+    TEST_ASSERT_EQUAL_INT(0, SetpointCommandNormalizedWithCP56Time2a_getQL(spcn));
+    TEST_ASSERT_TRUE(SetpointCommandNormalizedWithCP56Time2a_isSelect(spcn));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) spcn);
+
+    SetpointCommandNormalizedWithCP56Time2a_destroy(spcn);
+
+    CS101_ASDU_encode(asdu, f);
+
+    TEST_ASSERT_EQUAL_INT(19, Frame_getMsgSize(f));
+
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+
+    SetpointCommandNormalizedWithCP56Time2a spcn_dec = (SetpointCommandNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )spcn_dec));
+
+    TEST_ASSERT_EQUAL_INT(0, SetpointCommandNormalizedWithCP56Time2a_getValue(spcn_dec));
+    TEST_ASSERT_EQUAL_INT(0, SetpointCommandNormalizedWithCP56Time2a_getQL(spcn_dec));
+    TEST_ASSERT_TRUE(SetpointCommandNormalizedWithCP56Time2a_isSelect(spcn_dec));
+    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(SetpointCommandNormalizedWithCP56Time2a_getTimestamp(spcn_dec)));
+
+    SetpointCommandNormalizedWithCP56Time2a_destroy(spcn_dec);
 
     CS101_ASDU_destroy(asdu2);
 }
 
 void
-test_MeasuredValueNormalizedWithCP24Time2a(void)
+test_SetpointCommandScaled(void)
 {
-    MeasuredValueNormalizedWithCP24Time2a nmv1;
-    MeasuredValueNormalizedWithCP24Time2a nmv2;
-    MeasuredValueNormalizedWithCP24Time2a nmv3;
-    MeasuredValueNormalizedWithCP24Time2a nmv4;
-    MeasuredValueNormalizedWithCP24Time2a nmv5;
-    MeasuredValueNormalizedWithCP24Time2a nmv6;
-    MeasuredValueNormalizedWithCP24Time2a nmv7;
-    MeasuredValueNormalizedWithCP24Time2a nmv8;
+    SetpointCommandScaled spcs;
+    spcs = SetpointCommandScaled_create(NULL, 101, -32768, true, 0);
 
-    uint64_t time1 = Hal_getTimeInMs();
-    uint64_t time2 = time1 + 1000;
-    uint64_t time3 = time2 + 1000;
-    uint64_t time4 = time3 + 1000;
-    uint64_t time5 = time4 + 1000;
-    uint64_t time6 = time5 + 1000;
-    uint64_t time7 = time6 + 1000;
-    uint64_t time8 = time7 + 1000;
+    TEST_ASSERT_EQUAL_INT(-32768, SetpointCommandScaled_getValue(spcs));
+    TEST_ASSERT_EQUAL_INT(0, SetpointCommandScaled_getQL(spcs));
+    TEST_ASSERT_TRUE(SetpointCommandScaled_isSelect(spcs));
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) spcs);
+
+    SetpointCommandScaled_destroy(spcs);
 
-    struct sCP24Time2a cpTime1;
-    struct sCP24Time2a cpTime2;
-    struct sCP24Time2a cpTime3;
-    struct sCP24Time2a cpTime4;
-    struct sCP24Time2a cpTime5;
-    struct sCP24Time2a cpTime6;
-    struct sCP24Time2a cpTime7;
-    struct sCP24Time2a cpTime8;
+    CS101_ASDU_encode(asdu, f);
 
-    bzero(&cpTime1, sizeof(struct sCP24Time2a));
-    bzero(&cpTime2, sizeof(struct sCP24Time2a));
-    bzero(&cpTime3, sizeof(struct sCP24Time2a));
-    bzero(&cpTime4, sizeof(struct sCP24Time2a));
-    bzero(&cpTime5, sizeof(struct sCP24Time2a));
-    bzero(&cpTime6, sizeof(struct sCP24Time2a));
-    bzero(&cpTime7, sizeof(struct sCP24Time2a));
-    bzero(&cpTime8, sizeof(struct sCP24Time2a));
+    TEST_ASSERT_EQUAL_INT(12, Frame_getMsgSize(f));
 
-    CP24Time2a_setMinute(&cpTime1, 12);
-    CP24Time2a_setMillisecond(&cpTime1, 24123);
+    CS101_ASDU_destroy(asdu);
 
-    CP24Time2a_setMinute(&cpTime2, 54);
-    CP24Time2a_setMillisecond(&cpTime2, 12345);
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
 
-    CP24Time2a_setMinute(&cpTime3, 00);
-    CP24Time2a_setMillisecond(&cpTime3, 00001);
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
 
-    CP24Time2a_setMinute(&cpTime4, 12);
-    CP24Time2a_setMillisecond(&cpTime4, 24123);
+    SetpointCommandScaled spcs_dec = (SetpointCommandScaled) CS101_ASDU_getElement(asdu2, 0);
 
-    CP24Time2a_setMinute(&cpTime5, 12);
-    CP24Time2a_setMillisecond(&cpTime5, 24123);
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )spcs_dec));
 
-    CP24Time2a_setMinute(&cpTime6, 12);
-    CP24Time2a_setMillisecond(&cpTime6, 24123);
+    TEST_ASSERT_EQUAL_INT(-32768, SetpointCommandScaled_getValue(spcs_dec));
+    TEST_ASSERT_EQUAL_INT(0, SetpointCommandScaled_getQL(spcs_dec));
+    TEST_ASSERT_TRUE(SetpointCommandScaled_isSelect(spcs_dec));
 
-    CP24Time2a_setMinute(&cpTime7, 12);
-    CP24Time2a_setMillisecond(&cpTime7, 24123);
+    SetpointCommandScaled_destroy(spcs_dec);
 
-    CP24Time2a_setMinute(&cpTime8, 12);
-    CP24Time2a_setMillisecond(&cpTime8, 24123);
+    CS101_ASDU_destroy(asdu2);
+}
 
-    nmv1 = MeasuredValueNormalizedWithCP24Time2a_create(NULL, 101, -0.5f, IEC60870_QUALITY_GOOD, &cpTime1);
-    nmv2 = MeasuredValueNormalizedWithCP24Time2a_create(NULL, 102, -0.2f, IEC60870_QUALITY_OVERFLOW, &cpTime2);
-    nmv3 = MeasuredValueNormalizedWithCP24Time2a_create(NULL, 103, -0.1f, IEC60870_QUALITY_RESERVED, &cpTime3);
-    nmv4 = MeasuredValueNormalizedWithCP24Time2a_create(NULL, 104, 0, IEC60870_QUALITY_ELAPSED_TIME_INVALID, &cpTime4);
-    nmv5 = MeasuredValueNormalizedWithCP24Time2a_create(NULL, 105, 0.2f, IEC60870_QUALITY_BLOCKED, &cpTime5);
-    nmv6 = MeasuredValueNormalizedWithCP24Time2a_create(NULL, 106, 0.3f, IEC60870_QUALITY_SUBSTITUTED, &cpTime6);
-    nmv7 = MeasuredValueNormalizedWithCP24Time2a_create(NULL, 107, 0.4f, IEC60870_QUALITY_NON_TOPICAL, &cpTime7);
-    nmv8 = MeasuredValueNormalizedWithCP24Time2a_create(NULL, 108, 0.5f, IEC60870_QUALITY_INVALID, &cpTime8);
+void
+test_SetpointCommandScaledWithCP56Time2a(void)
+{
+    SetpointCommandScaledWithCP56Time2a spcs;
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv1));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv2));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv3));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv4));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv5));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv6));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv7));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv8));
+    uint64_t time1 = Hal_getTimeInMs();
+    struct sCP56Time2a cpTime1;
+    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
 
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv1));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv2));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.1f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv3));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv4));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv5));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.3f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv6));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.4f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv7));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv8));
+    spcs = SetpointCommandScaledWithCP56Time2a_create(NULL, 101, -32768, true, 0, &cpTime1);
+
+    TEST_ASSERT_EQUAL_INT(-32768, SetpointCommandScaledWithCP56Time2a_getValue(spcs));
+    TEST_ASSERT_EQUAL_INT(0, SetpointCommandScaledWithCP56Time2a_getQL(spcs));
+    TEST_ASSERT_TRUE(SetpointCommandScaledWithCP56Time2a_isSelect(spcs));
 
     uint8_t buffer[256];
 
@@ -2465,190 +5836,94 @@ test_MeasuredValueNormalizedWithCP24Time2a(void)
 
     Frame f = BufferFrame_initialize(&bf, buffer, 0);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv2);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv3);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv4);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv5);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv6);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv7);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv8);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) spcs);
 
-    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv1);
-    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv2);
-    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv3);
-    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv4);
-    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv5);
-    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv6);
-    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv7);
-    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv8);
+    SetpointCommandScaledWithCP56Time2a_destroy(spcs);
 
     CS101_ASDU_encode(asdu, f);
 
-    TEST_ASSERT_EQUAL_INT(78, Frame_getMsgSize(f));
+    TEST_ASSERT_EQUAL_INT(19, Frame_getMsgSize(f));
 
     CS101_ASDU_destroy(asdu);
 
     CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
 
-    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
 
-    MeasuredValueNormalizedWithCP24Time2a nmv1_dec = (MeasuredValueNormalizedWithCP24Time2a) CS101_ASDU_getElement(asdu2, 0);
-    MeasuredValueNormalizedWithCP24Time2a nmv2_dec = (MeasuredValueNormalizedWithCP24Time2a) CS101_ASDU_getElement(asdu2, 1);
-    MeasuredValueNormalizedWithCP24Time2a nmv3_dec = (MeasuredValueNormalizedWithCP24Time2a) CS101_ASDU_getElement(asdu2, 2);
-    MeasuredValueNormalizedWithCP24Time2a nmv4_dec = (MeasuredValueNormalizedWithCP24Time2a) CS101_ASDU_getElement(asdu2, 3);
-    MeasuredValueNormalizedWithCP24Time2a nmv5_dec = (MeasuredValueNormalizedWithCP24Time2a) CS101_ASDU_getElement(asdu2, 4);
-    MeasuredValueNormalizedWithCP24Time2a nmv6_dec = (MeasuredValueNormalizedWithCP24Time2a) CS101_ASDU_getElement(asdu2, 5);
-    MeasuredValueNormalizedWithCP24Time2a nmv7_dec = (MeasuredValueNormalizedWithCP24Time2a) CS101_ASDU_getElement(asdu2, 6);
-    MeasuredValueNormalizedWithCP24Time2a nmv8_dec = (MeasuredValueNormalizedWithCP24Time2a) CS101_ASDU_getElement(asdu2, 7);
+    SetpointCommandScaledWithCP56Time2a spcs_dec = (SetpointCommandScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )nmv1_dec));
-    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )nmv2_dec));
-    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )nmv3_dec));
-    TEST_ASSERT_EQUAL_INT(104, InformationObject_getObjectAddress((InformationObject )nmv4_dec));
-    TEST_ASSERT_EQUAL_INT(105, InformationObject_getObjectAddress((InformationObject )nmv5_dec));
-    TEST_ASSERT_EQUAL_INT(106, InformationObject_getObjectAddress((InformationObject )nmv6_dec));
-    TEST_ASSERT_EQUAL_INT(107, InformationObject_getObjectAddress((InformationObject )nmv7_dec));
-    TEST_ASSERT_EQUAL_INT(108, InformationObject_getObjectAddress((InformationObject )nmv8_dec));
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )spcs_dec));
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv1_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv2_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv3_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv4_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv5_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv6_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv7_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv8_dec));
+    TEST_ASSERT_EQUAL_INT(-32768, SetpointCommandScaledWithCP56Time2a_getValue(spcs_dec));
+    TEST_ASSERT_EQUAL_INT(0, SetpointCommandScaledWithCP56Time2a_getQL(spcs_dec));
+    TEST_ASSERT_TRUE(SetpointCommandScaledWithCP56Time2a_isSelect(spcs_dec));
+    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(SetpointCommandScaledWithCP56Time2a_getTimestamp(spcs_dec)));
 
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv1_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv2_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.1f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv3_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv4_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv5_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.3f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv6_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.4f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv7_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv8_dec));
+    SetpointCommandScaledWithCP56Time2a_destroy(spcs_dec);
 
-    CP24Time2a time1_dec = MeasuredValueNormalizedWithCP24Time2a_getTimestamp(nmv1_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time1_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time1_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time1_dec));
+    CS101_ASDU_destroy(asdu2);
+}
 
-    CP24Time2a time2_dec = MeasuredValueNormalizedWithCP24Time2a_getTimestamp(nmv2_dec);
-    TEST_ASSERT_EQUAL_INT(54, CP24Time2a_getMinute(time2_dec));
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getSecond(time2_dec));
-    TEST_ASSERT_EQUAL_INT(345, CP24Time2a_getMillisecond(time2_dec));
+void
+test_SetpointCommandShort(void)
+{
+    SetpointCommandShort spcs;
+    spcs = SetpointCommandShort_create(NULL, 101, 10.5f, true, 0);
 
-    CP24Time2a time3_dec = MeasuredValueNormalizedWithCP24Time2a_getTimestamp(nmv3_dec);
-    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getMinute(time3_dec));
-    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getSecond(time3_dec));
-    TEST_ASSERT_EQUAL_INT(1, CP24Time2a_getMillisecond(time3_dec));
+    TEST_ASSERT_EQUAL_FLOAT(10.5f, SetpointCommandShort_getValue(spcs));
+    TEST_ASSERT_EQUAL_INT(0, SetpointCommandShort_getQL(spcs));
+    TEST_ASSERT_TRUE(SetpointCommandShort_isSelect(spcs));
 
-    CP24Time2a time4_dec = MeasuredValueNormalizedWithCP24Time2a_getTimestamp(nmv4_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time4_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time4_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time4_dec));
+    uint8_t buffer[256];
 
-    CP24Time2a time5_dec = MeasuredValueNormalizedWithCP24Time2a_getTimestamp(nmv5_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time5_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time5_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time5_dec));
+    struct sBufferFrame bf;
 
-    CP24Time2a time6_dec = MeasuredValueNormalizedWithCP24Time2a_getTimestamp(nmv6_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time6_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time6_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time6_dec));
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
 
-    CP24Time2a time7_dec = MeasuredValueNormalizedWithCP24Time2a_getTimestamp(nmv7_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time7_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time7_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time7_dec));
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
 
-    CP24Time2a time8_dec = MeasuredValueNormalizedWithCP24Time2a_getTimestamp(nmv8_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time8_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time8_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time8_dec));
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) spcs);
 
-    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv1_dec);
-    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv2_dec);
-    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv3_dec);
-    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv4_dec);
-    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv5_dec);
-    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv6_dec);
-    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv7_dec);
-    MeasuredValueNormalizedWithCP24Time2a_destroy(nmv8_dec);
+    SetpointCommandShort_destroy(spcs);
 
-    CS101_ASDU_destroy(asdu2);
-}
+    CS101_ASDU_encode(asdu, f);
 
-void
+    TEST_ASSERT_EQUAL_INT(14, Frame_getMsgSize(f));
 
-test_MeasuredValueNormalizedWithCP56Time2a(void)
-{
-    MeasuredValueNormalizedWithCP56Time2a nmv1;
-    MeasuredValueNormalizedWithCP56Time2a nmv2;
-    MeasuredValueNormalizedWithCP56Time2a nmv3;
-    MeasuredValueNormalizedWithCP56Time2a nmv4;
-    MeasuredValueNormalizedWithCP56Time2a nmv5;
-    MeasuredValueNormalizedWithCP56Time2a nmv6;
-    MeasuredValueNormalizedWithCP56Time2a nmv7;
-    MeasuredValueNormalizedWithCP56Time2a nmv8;
+    CS101_ASDU_destroy(asdu);
 
-    uint64_t time1 = Hal_getTimeInMs();
-    uint64_t time2 = time1 + 1000;
-    uint64_t time3 = time2 + 1000;
-    uint64_t time4 = time3 + 1000;
-    uint64_t time5 = time4 + 1000;
-    uint64_t time6 = time5 + 1000;
-    uint64_t time7 = time6 + 1000;
-    uint64_t time8 = time7 + 1000;
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
 
-    struct sCP56Time2a cpTime1;
-    struct sCP56Time2a cpTime2;
-    struct sCP56Time2a cpTime3;
-    struct sCP56Time2a cpTime4;
-    struct sCP56Time2a cpTime5;
-    struct sCP56Time2a cpTime6;
-    struct sCP56Time2a cpTime7;
-    struct sCP56Time2a cpTime8;
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
 
-    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
-    CP56Time2a_createFromMsTimestamp(&cpTime2, time2);
-    CP56Time2a_createFromMsTimestamp(&cpTime3, time3);
-    CP56Time2a_createFromMsTimestamp(&cpTime4, time4);
-    CP56Time2a_createFromMsTimestamp(&cpTime5, time5);
-    CP56Time2a_createFromMsTimestamp(&cpTime6, time6);
-    CP56Time2a_createFromMsTimestamp(&cpTime7, time7);
-    CP56Time2a_createFromMsTimestamp(&cpTime8, time8);
+    SetpointCommandShort spcs_dec = (SetpointCommandShort) CS101_ASDU_getElement(asdu2, 0);
 
-    nmv1 = MeasuredValueNormalizedWithCP56Time2a_create(NULL, 101, -0.5f, IEC60870_QUALITY_GOOD, &cpTime1);
-    nmv2 = MeasuredValueNormalizedWithCP56Time2a_create(NULL, 102, -0.2f, IEC60870_QUALITY_OVERFLOW, &cpTime2);
-    nmv3 = MeasuredValueNormalizedWithCP56Time2a_create(NULL, 103, -0.1f, IEC60870_QUALITY_RESERVED, &cpTime3);
-    nmv4 = MeasuredValueNormalizedWithCP56Time2a_create(NULL, 104, 0, IEC60870_QUALITY_ELAPSED_TIME_INVALID, &cpTime4);
-    nmv5 = MeasuredValueNormalizedWithCP56Time2a_create(NULL, 105, 0.2f, IEC60870_QUALITY_BLOCKED, &cpTime5);
-    nmv6 = MeasuredValueNormalizedWithCP56Time2a_create(NULL, 106, 0.3f, IEC60870_QUALITY_SUBSTITUTED, &cpTime6);
-    nmv7 = MeasuredValueNormalizedWithCP56Time2a_create(NULL, 107, 0.4f, IEC60870_QUALITY_NON_TOPICAL, &cpTime7);
-    nmv8 = MeasuredValueNormalizedWithCP56Time2a_create(NULL, 108, 0.5f, IEC60870_QUALITY_INVALID, &cpTime8);
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )spcs_dec));
+
+    TEST_ASSERT_EQUAL_FLOAT(10.5f, SetpointCommandShort_getValue(spcs_dec));
+    TEST_ASSERT_EQUAL_INT(0, SetpointCommandShort_getQL(spcs_dec));
+    TEST_ASSERT_TRUE(SetpointCommandShort_isSelect(spcs_dec));
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv1));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv2));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv3));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv4));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv5));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv6));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv7));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv8));
+    SetpointCommandShort_destroy(spcs_dec);
 
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv1));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv2));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.1f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv3));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv4));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv5));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.3f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv6));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.4f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv7));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv8));
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_SetpointCommandShortWithCP56Time2a(void)
+{
+    SetpointCommandShortWithCP56Time2a spcs;
+    uint64_t time1 = Hal_getTimeInMs();
+    struct sCP56Time2a cpTime1;
+    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
+
+    spcs = SetpointCommandShortWithCP56Time2a_create(NULL, 101, 10.5f, true, 0, &cpTime1);
+
+    TEST_ASSERT_EQUAL_FLOAT(10.5f, SetpointCommandShortWithCP56Time2a_getValue(spcs));
+    TEST_ASSERT_EQUAL_INT(0, SetpointCommandShortWithCP56Time2a_getQL(spcs));
+    TEST_ASSERT_TRUE(SetpointCommandShortWithCP56Time2a_isSelect(spcs));
 
     uint8_t buffer[256];
 
@@ -2656,131 +5931,43 @@ test_MeasuredValueNormalizedWithCP56Time2a(void)
 
     Frame f = BufferFrame_initialize(&bf, buffer, 0);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv2);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv3);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv4);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv5);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv6);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv7);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) nmv8);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) spcs);
 
-    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv1);
-    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv2);
-    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv3);
-    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv4);
-    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv5);
-    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv6);
-    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv7);
-    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv8);
+    SetpointCommandShortWithCP56Time2a_destroy(spcs);
 
     CS101_ASDU_encode(asdu, f);
 
-    TEST_ASSERT_EQUAL_INT(110, Frame_getMsgSize(f));
+    TEST_ASSERT_EQUAL_INT(21, Frame_getMsgSize(f));
 
     CS101_ASDU_destroy(asdu);
 
     CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
 
-    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
-
-    MeasuredValueNormalizedWithCP56Time2a nmv1_dec = (MeasuredValueNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
-    MeasuredValueNormalizedWithCP56Time2a nmv2_dec = (MeasuredValueNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 1);
-    MeasuredValueNormalizedWithCP56Time2a nmv3_dec = (MeasuredValueNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 2);
-    MeasuredValueNormalizedWithCP56Time2a nmv4_dec = (MeasuredValueNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 3);
-    MeasuredValueNormalizedWithCP56Time2a nmv5_dec = (MeasuredValueNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 4);
-    MeasuredValueNormalizedWithCP56Time2a nmv6_dec = (MeasuredValueNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 5);
-    MeasuredValueNormalizedWithCP56Time2a nmv7_dec = (MeasuredValueNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 6);
-    MeasuredValueNormalizedWithCP56Time2a nmv8_dec = (MeasuredValueNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 7);
-
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )nmv1_dec));
-    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )nmv2_dec));
-    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )nmv3_dec));
-    TEST_ASSERT_EQUAL_INT(104, InformationObject_getObjectAddress((InformationObject )nmv4_dec));
-    TEST_ASSERT_EQUAL_INT(105, InformationObject_getObjectAddress((InformationObject )nmv5_dec));
-    TEST_ASSERT_EQUAL_INT(106, InformationObject_getObjectAddress((InformationObject )nmv6_dec));
-    TEST_ASSERT_EQUAL_INT(107, InformationObject_getObjectAddress((InformationObject )nmv7_dec));
-    TEST_ASSERT_EQUAL_INT(108, InformationObject_getObjectAddress((InformationObject )nmv8_dec));
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv1_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv2_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv3_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv4_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv5_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv6_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv7_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueNormalized_getQuality((MeasuredValueNormalized )nmv8_dec));
+    SetpointCommandShortWithCP56Time2a spcs_dec = (SetpointCommandShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
 
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv1_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv2_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, -0.1f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv3_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv4_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.2f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv5_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.3f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv6_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.4f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv7_dec));
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, MeasuredValueNormalized_getValue((MeasuredValueNormalized )nmv8_dec));
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )spcs_dec));
 
-    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(MeasuredValueNormalizedWithCP56Time2a_getTimestamp(nmv1_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time2, CP56Time2a_toMsTimestamp(MeasuredValueNormalizedWithCP56Time2a_getTimestamp(nmv2_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time3, CP56Time2a_toMsTimestamp(MeasuredValueNormalizedWithCP56Time2a_getTimestamp(nmv3_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time4, CP56Time2a_toMsTimestamp(MeasuredValueNormalizedWithCP56Time2a_getTimestamp(nmv4_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time5, CP56Time2a_toMsTimestamp(MeasuredValueNormalizedWithCP56Time2a_getTimestamp(nmv5_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time6, CP56Time2a_toMsTimestamp(MeasuredValueNormalizedWithCP56Time2a_getTimestamp(nmv6_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time7, CP56Time2a_toMsTimestamp(MeasuredValueNormalizedWithCP56Time2a_getTimestamp(nmv7_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time8, CP56Time2a_toMsTimestamp(MeasuredValueNormalizedWithCP56Time2a_getTimestamp(nmv8_dec)));
+    TEST_ASSERT_EQUAL_FLOAT(10.5f, SetpointCommandShortWithCP56Time2a_getValue(spcs_dec));
+    TEST_ASSERT_EQUAL_INT(0, SetpointCommandShortWithCP56Time2a_getQL(spcs_dec));
+    TEST_ASSERT_TRUE(SetpointCommandShortWithCP56Time2a_isSelect(spcs_dec));
+    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(SetpointCommandShortWithCP56Time2a_getTimestamp(spcs_dec)));
 
-    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv1_dec);
-    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv2_dec);
-    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv3_dec);
-    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv4_dec);
-    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv5_dec);
-    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv6_dec);
-    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv7_dec);
-    MeasuredValueNormalizedWithCP56Time2a_destroy(nmv8_dec);
+    SetpointCommandShortWithCP56Time2a_destroy(spcs_dec);
 
     CS101_ASDU_destroy(asdu2);
 }
 
 void
-test_MeasuredValueScaled(void)
+test_InterrogationCommand(void)
 {
-    MeasuredValueScaled mvs1;
-    MeasuredValueScaled mvs2;
-    MeasuredValueScaled mvs3;
-    MeasuredValueScaled mvs4;
-    MeasuredValueScaled mvs5;
-    MeasuredValueScaled mvs6;
-    MeasuredValueScaled mvs7;
-    MeasuredValueScaled mvs8;
-
-    mvs1 = MeasuredValueScaled_create(NULL, 101, INT16_MAX, IEC60870_QUALITY_GOOD);
-    mvs2 = MeasuredValueScaled_create(NULL, 102, INT16_MAX, IEC60870_QUALITY_OVERFLOW);
-    mvs3 = MeasuredValueScaled_create(NULL, 103, INT16_MAX, IEC60870_QUALITY_RESERVED);
-    mvs4 = MeasuredValueScaled_create(NULL, 104, INT16_MAX, IEC60870_QUALITY_ELAPSED_TIME_INVALID);
-    mvs5 = MeasuredValueScaled_create(NULL, 105, INT16_MIN, IEC60870_QUALITY_BLOCKED);
-    mvs6 = MeasuredValueScaled_create(NULL, 106, INT16_MIN, IEC60870_QUALITY_SUBSTITUTED);
-    mvs7 = MeasuredValueScaled_create(NULL, 107, INT16_MIN, IEC60870_QUALITY_NON_TOPICAL);
-    mvs8 = MeasuredValueScaled_create(NULL, 108, INT16_MIN, IEC60870_QUALITY_INVALID);
-
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs1));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs2));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs3));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs4));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs5));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs6));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs7));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs8));
-
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs1));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs2));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs3));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs4));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs5));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs6));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs7));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs8));
+    InterrogationCommand ic;
+    uint8_t qoi = 21;
+    ic = InterrogationCommand_create(NULL, 101, qoi);
+    TEST_ASSERT_EQUAL_INT(21, InterrogationCommand_getQOI(ic));
 
     uint8_t buffer[256];
 
@@ -2788,174 +5975,80 @@ test_MeasuredValueScaled(void)
 
     Frame f = BufferFrame_initialize(&bf, buffer, 0);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs2);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs3);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs4);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs5);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs6);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs7);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs8);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) ic);
 
-    MeasuredValueScaled_destroy(mvs1);
-    MeasuredValueScaled_destroy(mvs2);
-    MeasuredValueScaled_destroy(mvs3);
-    MeasuredValueScaled_destroy(mvs4);
-    MeasuredValueScaled_destroy(mvs5);
-    MeasuredValueScaled_destroy(mvs6);
-    MeasuredValueScaled_destroy(mvs7);
-    MeasuredValueScaled_destroy(mvs8);
+    InterrogationCommand_destroy(ic);
 
     CS101_ASDU_encode(asdu, f);
 
-    TEST_ASSERT_EQUAL_INT(54, Frame_getMsgSize(f));
+    TEST_ASSERT_EQUAL_INT(10, Frame_getMsgSize(f));
 
     CS101_ASDU_destroy(asdu);
 
     CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
 
-    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
-
-    MeasuredValueScaled mvs1_dec = (MeasuredValueScaled) CS101_ASDU_getElement(asdu2, 0);
-    MeasuredValueScaled mvs2_dec = (MeasuredValueScaled) CS101_ASDU_getElement(asdu2, 1);
-    MeasuredValueScaled mvs3_dec = (MeasuredValueScaled) CS101_ASDU_getElement(asdu2, 2);
-    MeasuredValueScaled mvs4_dec = (MeasuredValueScaled) CS101_ASDU_getElement(asdu2, 3);
-    MeasuredValueScaled mvs5_dec = (MeasuredValueScaled) CS101_ASDU_getElement(asdu2, 4);
-    MeasuredValueScaled mvs6_dec = (MeasuredValueScaled) CS101_ASDU_getElement(asdu2, 5);
-    MeasuredValueScaled mvs7_dec = (MeasuredValueScaled) CS101_ASDU_getElement(asdu2, 6);
-    MeasuredValueScaled mvs8_dec = (MeasuredValueScaled) CS101_ASDU_getElement(asdu2, 7);
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )mvs1_dec));
-    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )mvs2_dec));
-    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )mvs3_dec));
-    TEST_ASSERT_EQUAL_INT(104, InformationObject_getObjectAddress((InformationObject )mvs4_dec));
-    TEST_ASSERT_EQUAL_INT(105, InformationObject_getObjectAddress((InformationObject )mvs5_dec));
-    TEST_ASSERT_EQUAL_INT(106, InformationObject_getObjectAddress((InformationObject )mvs6_dec));
-    TEST_ASSERT_EQUAL_INT(107, InformationObject_getObjectAddress((InformationObject )mvs7_dec));
-    TEST_ASSERT_EQUAL_INT(108, InformationObject_getObjectAddress((InformationObject )mvs8_dec));
+    InterrogationCommand ic_dec = (InterrogationCommand) CS101_ASDU_getElement(asdu2, 0);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs1_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs2_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs3_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs4_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs5_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs6_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs7_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs8_dec));
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )ic_dec));
 
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs1_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs2_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs3_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs4_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs5_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs6_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs7_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs8_dec));
+    TEST_ASSERT_EQUAL_INT(21, InterrogationCommand_getQOI(ic_dec));
 
-    MeasuredValueScaled_destroy(mvs1_dec);
-    MeasuredValueScaled_destroy(mvs2_dec);
-    MeasuredValueScaled_destroy(mvs3_dec);
-    MeasuredValueScaled_destroy(mvs4_dec);
-    MeasuredValueScaled_destroy(mvs5_dec);
-    MeasuredValueScaled_destroy(mvs6_dec);
-    MeasuredValueScaled_destroy(mvs7_dec);
-    MeasuredValueScaled_destroy(mvs8_dec);
+    InterrogationCommand_destroy(ic_dec);
 
     CS101_ASDU_destroy(asdu2);
 }
 
 void
-
-test_MeasuredValueScaledWithCP24Time2a(void)
+test_CounterInterrogationCommand(void)
 {
-    MeasuredValueScaledWithCP24Time2a mvs1;
-    MeasuredValueScaledWithCP24Time2a mvs2;
-    MeasuredValueScaledWithCP24Time2a mvs3;
-    MeasuredValueScaledWithCP24Time2a mvs4;
-    MeasuredValueScaledWithCP24Time2a mvs5;
-    MeasuredValueScaledWithCP24Time2a mvs6;
-    MeasuredValueScaledWithCP24Time2a mvs7;
-    MeasuredValueScaledWithCP24Time2a mvs8;
+    CounterInterrogationCommand cic;
+    uint8_t qcc = 1;
+    cic = CounterInterrogationCommand_create(NULL, 101, qcc);
 
-    uint64_t time1 = Hal_getTimeInMs();
-    uint64_t time2 = time1 + 1000;
-    uint64_t time3 = time2 + 1000;
-    uint64_t time4 = time3 + 1000;
-    uint64_t time5 = time4 + 1000;
-    uint64_t time6 = time5 + 1000;
-    uint64_t time7 = time6 + 1000;
-    uint64_t time8 = time7 + 1000;
+    TEST_ASSERT_EQUAL_INT(1, CounterInterrogationCommand_getQCC(cic));
 
-    struct sCP24Time2a cpTime1;
-    struct sCP24Time2a cpTime2;
-    struct sCP24Time2a cpTime3;
-    struct sCP24Time2a cpTime4;
-    struct sCP24Time2a cpTime5;
-    struct sCP24Time2a cpTime6;
-    struct sCP24Time2a cpTime7;
-    struct sCP24Time2a cpTime8;
+    uint8_t buffer[256];
 
-    bzero(&cpTime1, sizeof(struct sCP24Time2a));
-    bzero(&cpTime2, sizeof(struct sCP24Time2a));
-    bzero(&cpTime3, sizeof(struct sCP24Time2a));
-    bzero(&cpTime4, sizeof(struct sCP24Time2a));
-    bzero(&cpTime5, sizeof(struct sCP24Time2a));
-    bzero(&cpTime6, sizeof(struct sCP24Time2a));
-    bzero(&cpTime7, sizeof(struct sCP24Time2a));
-    bzero(&cpTime8, sizeof(struct sCP24Time2a));
+    struct sBufferFrame bf;
 
-    CP24Time2a_setMinute(&cpTime1, 12);
-    CP24Time2a_setMillisecond(&cpTime1, 24123);
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
 
-    CP24Time2a_setMinute(&cpTime2, 54);
-    CP24Time2a_setMillisecond(&cpTime2, 12345);
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
 
-    CP24Time2a_setMinute(&cpTime3, 00);
-    CP24Time2a_setMillisecond(&cpTime3, 00001);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) cic);
 
-    CP24Time2a_setMinute(&cpTime4, 12);
-    CP24Time2a_setMillisecond(&cpTime4, 24123);
+    CounterInterrogationCommand_destroy(cic);
 
-    CP24Time2a_setMinute(&cpTime5, 12);
-    CP24Time2a_setMillisecond(&cpTime5, 24123);
+    CS101_ASDU_encode(asdu, f);
 
-    CP24Time2a_setMinute(&cpTime6, 12);
-    CP24Time2a_setMillisecond(&cpTime6, 24123);
+    TEST_ASSERT_EQUAL_INT(10, Frame_getMsgSize(f));
 
-    CP24Time2a_setMinute(&cpTime7, 12);
-    CP24Time2a_setMillisecond(&cpTime7, 24123);
+    CS101_ASDU_destroy(asdu);
 
-    CP24Time2a_setMinute(&cpTime8, 12);
-    CP24Time2a_setMillisecond(&cpTime8, 24123);
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
 
-    mvs1 = MeasuredValueScaledWithCP24Time2a_create(NULL, 101, INT16_MAX, IEC60870_QUALITY_GOOD, &cpTime1);
-    mvs2 = MeasuredValueScaledWithCP24Time2a_create(NULL, 102, INT16_MAX, IEC60870_QUALITY_OVERFLOW, &cpTime2);
-    mvs3 = MeasuredValueScaledWithCP24Time2a_create(NULL, 103, INT16_MAX, IEC60870_QUALITY_RESERVED, &cpTime3);
-    mvs4 = MeasuredValueScaledWithCP24Time2a_create(NULL, 104, INT16_MAX, IEC60870_QUALITY_ELAPSED_TIME_INVALID, &cpTime4);
-    mvs5 = MeasuredValueScaledWithCP24Time2a_create(NULL, 105, INT16_MIN, IEC60870_QUALITY_BLOCKED, &cpTime5);
-    mvs6 = MeasuredValueScaledWithCP24Time2a_create(NULL, 106, INT16_MIN, IEC60870_QUALITY_SUBSTITUTED, &cpTime6);
-    mvs7 = MeasuredValueScaledWithCP24Time2a_create(NULL, 107, INT16_MIN, IEC60870_QUALITY_NON_TOPICAL, &cpTime7);
-    mvs8 = MeasuredValueScaledWithCP24Time2a_create(NULL, 108, INT16_MIN, IEC60870_QUALITY_INVALID, &cpTime8);
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs1));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs2));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs3));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs4));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs5));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs6));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs7));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs8));
+    CounterInterrogationCommand cic_dec = (CounterInterrogationCommand) CS101_ASDU_getElement(asdu2, 0);
 
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs1));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs2));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs3));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs4));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs5));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs6));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs7));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs8));
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )cic_dec));
+
+    TEST_ASSERT_EQUAL_INT(1, CounterInterrogationCommand_getQCC(cic_dec));
+
+    CounterInterrogationCommand_destroy(cic_dec);
+
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_ReadCommand(void)
+{
+    ReadCommand rc;
+    rc = ReadCommand_create( NULL, 101);
 
     uint8_t buffer[256];
 
@@ -2963,189 +6056,80 @@ test_MeasuredValueScaledWithCP24Time2a(void)
 
     Frame f = BufferFrame_initialize(&bf, buffer, 0);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs2);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs3);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs4);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs5);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs6);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs7);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs8);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) rc);
 
-    MeasuredValueScaledWithCP24Time2a_destroy(mvs1);
-    MeasuredValueScaledWithCP24Time2a_destroy(mvs2);
-    MeasuredValueScaledWithCP24Time2a_destroy(mvs3);
-    MeasuredValueScaledWithCP24Time2a_destroy(mvs4);
-    MeasuredValueScaledWithCP24Time2a_destroy(mvs5);
-    MeasuredValueScaledWithCP24Time2a_destroy(mvs6);
-    MeasuredValueScaledWithCP24Time2a_destroy(mvs7);
-    MeasuredValueScaledWithCP24Time2a_destroy(mvs8);
+    ReadCommand_destroy(rc);
 
     CS101_ASDU_encode(asdu, f);
 
-    TEST_ASSERT_EQUAL_INT(78, Frame_getMsgSize(f));
+    TEST_ASSERT_EQUAL_INT(9, Frame_getMsgSize(f));
 
     CS101_ASDU_destroy(asdu);
 
     CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
 
-    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
 
-    MeasuredValueScaledWithCP24Time2a mvs1_dec = (MeasuredValueScaledWithCP24Time2a) CS101_ASDU_getElement(asdu2, 0);
-    MeasuredValueScaledWithCP24Time2a mvs2_dec = (MeasuredValueScaledWithCP24Time2a) CS101_ASDU_getElement(asdu2, 1);
-    MeasuredValueScaledWithCP24Time2a mvs3_dec = (MeasuredValueScaledWithCP24Time2a) CS101_ASDU_getElement(asdu2, 2);
-    MeasuredValueScaledWithCP24Time2a mvs4_dec = (MeasuredValueScaledWithCP24Time2a) CS101_ASDU_getElement(asdu2, 3);
-    MeasuredValueScaledWithCP24Time2a mvs5_dec = (MeasuredValueScaledWithCP24Time2a) CS101_ASDU_getElement(asdu2, 4);
-    MeasuredValueScaledWithCP24Time2a mvs6_dec = (MeasuredValueScaledWithCP24Time2a) CS101_ASDU_getElement(asdu2, 5);
-    MeasuredValueScaledWithCP24Time2a mvs7_dec = (MeasuredValueScaledWithCP24Time2a) CS101_ASDU_getElement(asdu2, 6);
-    MeasuredValueScaledWithCP24Time2a mvs8_dec = (MeasuredValueScaledWithCP24Time2a) CS101_ASDU_getElement(asdu2, 7);
+    ReadCommand rc_dec = (ReadCommand) CS101_ASDU_getElement(asdu2, 0);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )mvs1_dec));
-    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )mvs2_dec));
-    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )mvs3_dec));
-    TEST_ASSERT_EQUAL_INT(104, InformationObject_getObjectAddress((InformationObject )mvs4_dec));
-    TEST_ASSERT_EQUAL_INT(105, InformationObject_getObjectAddress((InformationObject )mvs5_dec));
-    TEST_ASSERT_EQUAL_INT(106, InformationObject_getObjectAddress((InformationObject )mvs6_dec));
-    TEST_ASSERT_EQUAL_INT(107, InformationObject_getObjectAddress((InformationObject )mvs7_dec));
-    TEST_ASSERT_EQUAL_INT(108, InformationObject_getObjectAddress((InformationObject )mvs8_dec));
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )rc_dec));
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs1_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs2_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs3_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs4_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs5_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs6_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs7_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs8_dec));
+    ReadCommand_destroy(rc_dec);
 
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs1_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs2_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs3_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs4_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs5_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs6_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs7_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs8_dec));
+    CS101_ASDU_destroy(asdu2);
+}
 
-    CP24Time2a time1_dec = MeasuredValueScaledWithCP24Time2a_getTimestamp(mvs1_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time1_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time1_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time1_dec));
+void
+test_ClockSynchronizationCommand(void)
+{
+    ClockSynchronizationCommand csc;
+    uint64_t time1 = Hal_getTimeInMs();
+    struct sCP56Time2a cpTime1;
+    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
+    csc = ClockSynchronizationCommand_create(NULL, 101, &cpTime1);
 
-    CP24Time2a time2_dec = MeasuredValueScaledWithCP24Time2a_getTimestamp(mvs2_dec);
-    TEST_ASSERT_EQUAL_INT(54, CP24Time2a_getMinute(time2_dec));
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getSecond(time2_dec));
-    TEST_ASSERT_EQUAL_INT(345, CP24Time2a_getMillisecond(time2_dec));
+    uint8_t buffer[256];
 
-    CP24Time2a time3_dec = MeasuredValueScaledWithCP24Time2a_getTimestamp(mvs3_dec);
-    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getMinute(time3_dec));
-    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getSecond(time3_dec));
-    TEST_ASSERT_EQUAL_INT(1, CP24Time2a_getMillisecond(time3_dec));
+    struct sBufferFrame bf;
 
-    CP24Time2a time4_dec = MeasuredValueScaledWithCP24Time2a_getTimestamp(mvs4_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time4_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time4_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time4_dec));
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
 
-    CP24Time2a time5_dec = MeasuredValueScaledWithCP24Time2a_getTimestamp(mvs5_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time5_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time5_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time5_dec));
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
 
-    CP24Time2a time6_dec = MeasuredValueScaledWithCP24Time2a_getTimestamp(mvs6_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time6_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time6_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time6_dec));
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) csc);
 
-    CP24Time2a time7_dec = MeasuredValueScaledWithCP24Time2a_getTimestamp(mvs7_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time7_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time7_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time7_dec));
+    ClockSynchronizationCommand_destroy(csc);
 
-    CP24Time2a time8_dec = MeasuredValueScaledWithCP24Time2a_getTimestamp(mvs8_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time8_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time8_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time8_dec));
+    CS101_ASDU_encode(asdu, f);
 
-    MeasuredValueScaledWithCP24Time2a_destroy(mvs1_dec);
-    MeasuredValueScaledWithCP24Time2a_destroy(mvs2_dec);
-    MeasuredValueScaledWithCP24Time2a_destroy(mvs3_dec);
-    MeasuredValueScaledWithCP24Time2a_destroy(mvs4_dec);
-    MeasuredValueScaledWithCP24Time2a_destroy(mvs5_dec);
-    MeasuredValueScaledWithCP24Time2a_destroy(mvs6_dec);
-    MeasuredValueScaledWithCP24Time2a_destroy(mvs7_dec);
-    MeasuredValueScaledWithCP24Time2a_destroy(mvs8_dec);
+    TEST_ASSERT_EQUAL_INT(16, Frame_getMsgSize(f));
 
-    CS101_ASDU_destroy(asdu2);
-}
+    CS101_ASDU_destroy(asdu);
 
-void
-test_MeasuredValueScaledWithCP56Time2a(void)
-{
-    MeasuredValueScaledWithCP56Time2a mvs1;
-    MeasuredValueScaledWithCP56Time2a mvs2;
-    MeasuredValueScaledWithCP56Time2a mvs3;
-    MeasuredValueScaledWithCP56Time2a mvs4;
-    MeasuredValueScaledWithCP56Time2a mvs5;
-    MeasuredValueScaledWithCP56Time2a mvs6;
-    MeasuredValueScaledWithCP56Time2a mvs7;
-    MeasuredValueScaledWithCP56Time2a mvs8;
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
 
-    uint64_t time1 = Hal_getTimeInMs();
-    uint64_t time2 = time1 + 1000;
-    uint64_t time3 = time2 + 1000;
-    uint64_t time4 = time3 + 1000;
-    uint64_t time5 = time4 + 1000;
-    uint64_t time6 = time5 + 1000;
-    uint64_t time7 = time6 + 1000;
-    uint64_t time8 = time7 + 1000;
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
 
-    struct sCP56Time2a cpTime1;
-    struct sCP56Time2a cpTime2;
-    struct sCP56Time2a cpTime3;
-    struct sCP56Time2a cpTime4;
-    struct sCP56Time2a cpTime5;
-    struct sCP56Time2a cpTime6;
-    struct sCP56Time2a cpTime7;
-    struct sCP56Time2a cpTime8;
+    ClockSynchronizationCommand csc_dec = (ClockSynchronizationCommand) CS101_ASDU_getElement(asdu2, 0);
 
-    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
-    CP56Time2a_createFromMsTimestamp(&cpTime2, time2);
-    CP56Time2a_createFromMsTimestamp(&cpTime3, time3);
-    CP56Time2a_createFromMsTimestamp(&cpTime4, time4);
-    CP56Time2a_createFromMsTimestamp(&cpTime5, time5);
-    CP56Time2a_createFromMsTimestamp(&cpTime6, time6);
-    CP56Time2a_createFromMsTimestamp(&cpTime7, time7);
-    CP56Time2a_createFromMsTimestamp(&cpTime8, time8);
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )csc_dec));
+    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(ClockSynchronizationCommand_getTime(csc_dec)));
 
-    mvs1 = MeasuredValueScaledWithCP56Time2a_create(NULL, 101, INT16_MAX, IEC60870_QUALITY_GOOD, &cpTime1);
-    mvs2 = MeasuredValueScaledWithCP56Time2a_create(NULL, 102, INT16_MAX, IEC60870_QUALITY_OVERFLOW, &cpTime2);
-    mvs3 = MeasuredValueScaledWithCP56Time2a_create(NULL, 103, INT16_MAX, IEC60870_QUALITY_RESERVED, &cpTime3);
-    mvs4 = MeasuredValueScaledWithCP56Time2a_create(NULL, 104, INT16_MAX, IEC60870_QUALITY_ELAPSED_TIME_INVALID, &cpTime4);
-    mvs5 = MeasuredValueScaledWithCP56Time2a_create(NULL, 105, INT16_MIN, IEC60870_QUALITY_BLOCKED, &cpTime5);
-    mvs6 = MeasuredValueScaledWithCP56Time2a_create(NULL, 106, INT16_MIN, IEC60870_QUALITY_SUBSTITUTED, &cpTime6);
-    mvs7 = MeasuredValueScaledWithCP56Time2a_create(NULL, 107, INT16_MIN, IEC60870_QUALITY_NON_TOPICAL, &cpTime7);
-    mvs8 = MeasuredValueScaledWithCP56Time2a_create(NULL, 108, INT16_MIN, IEC60870_QUALITY_INVALID, &cpTime8);
+    ClockSynchronizationCommand_destroy(csc_dec);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs1));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs2));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs3));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs4));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs5));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs6));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs7));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs8));
+    CS101_ASDU_destroy(asdu2);
+}
+
+void
+test_ResetProcessCommand(void)
+{
+    ResetProcessCommand rpc;
+    uint8_t qrp = 0;
+    rpc = ResetProcessCommand_create(NULL, 101, qrp);
 
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs1));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs2));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs3));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs4));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs5));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs6));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs7));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs8));
+    TEST_ASSERT_EQUAL_INT(0, ResetProcessCommand_getQRP(rpc));
 
     uint8_t buffer[256];
 
@@ -3153,477 +6137,219 @@ test_MeasuredValueScaledWithCP56Time2a(void)
 
     Frame f = BufferFrame_initialize(&bf, buffer, 0);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs2);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs3);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs4);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs5);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs6);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs7);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs8);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) rpc);
 
-    MeasuredValueScaledWithCP56Time2a_destroy(mvs1);
-    MeasuredValueScaledWithCP56Time2a_destroy(mvs2);
-    MeasuredValueScaledWithCP56Time2a_destroy(mvs3);
-    MeasuredValueScaledWithCP56Time2a_destroy(mvs4);
-    MeasuredValueScaledWithCP56Time2a_destroy(mvs5);
-    MeasuredValueScaledWithCP56Time2a_destroy(mvs6);
-    MeasuredValueScaledWithCP56Time2a_destroy(mvs7);
-    MeasuredValueScaledWithCP56Time2a_destroy(mvs8);
+    ResetProcessCommand_destroy(rpc);
 
     CS101_ASDU_encode(asdu, f);
 
-    TEST_ASSERT_EQUAL_INT(110, Frame_getMsgSize(f));
+    TEST_ASSERT_EQUAL_INT(10, Frame_getMsgSize(f));
 
     CS101_ASDU_destroy(asdu);
 
     CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
 
-    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
-
-    MeasuredValueScaledWithCP56Time2a mvs1_dec = (MeasuredValueScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
-    MeasuredValueScaledWithCP56Time2a mvs2_dec = (MeasuredValueScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 1);
-    MeasuredValueScaledWithCP56Time2a mvs3_dec = (MeasuredValueScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 2);
-    MeasuredValueScaledWithCP56Time2a mvs4_dec = (MeasuredValueScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 3);
-    MeasuredValueScaledWithCP56Time2a mvs5_dec = (MeasuredValueScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 4);
-    MeasuredValueScaledWithCP56Time2a mvs6_dec = (MeasuredValueScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 5);
-    MeasuredValueScaledWithCP56Time2a mvs7_dec = (MeasuredValueScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 6);
-    MeasuredValueScaledWithCP56Time2a mvs8_dec = (MeasuredValueScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 7);
-
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )mvs1_dec));
-    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )mvs2_dec));
-    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject )mvs3_dec));
-    TEST_ASSERT_EQUAL_INT(104, InformationObject_getObjectAddress((InformationObject )mvs4_dec));
-    TEST_ASSERT_EQUAL_INT(105, InformationObject_getObjectAddress((InformationObject )mvs5_dec));
-    TEST_ASSERT_EQUAL_INT(106, InformationObject_getObjectAddress((InformationObject )mvs6_dec));
-    TEST_ASSERT_EQUAL_INT(107, InformationObject_getObjectAddress((InformationObject )mvs7_dec));
-    TEST_ASSERT_EQUAL_INT(108, InformationObject_getObjectAddress((InformationObject )mvs8_dec));
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs1_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs2_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs3_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs4_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs5_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs6_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs7_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueScaled_getQuality((MeasuredValueScaled )mvs8_dec));
+    ResetProcessCommand rpc_dec = (ResetProcessCommand) CS101_ASDU_getElement(asdu2, 0);
 
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs1_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs2_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs3_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MAX, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs4_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs5_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs6_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs7_dec));
-    TEST_ASSERT_EQUAL_INT(INT16_MIN, MeasuredValueScaled_getValue((MeasuredValueScaled )mvs8_dec));
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )rpc_dec));
 
-    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(MeasuredValueScaledWithCP56Time2a_getTimestamp(mvs1_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time2, CP56Time2a_toMsTimestamp(MeasuredValueScaledWithCP56Time2a_getTimestamp(mvs2_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time3, CP56Time2a_toMsTimestamp(MeasuredValueScaledWithCP56Time2a_getTimestamp(mvs3_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time4, CP56Time2a_toMsTimestamp(MeasuredValueScaledWithCP56Time2a_getTimestamp(mvs4_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time5, CP56Time2a_toMsTimestamp(MeasuredValueScaledWithCP56Time2a_getTimestamp(mvs5_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time6, CP56Time2a_toMsTimestamp(MeasuredValueScaledWithCP56Time2a_getTimestamp(mvs6_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time7, CP56Time2a_toMsTimestamp(MeasuredValueScaledWithCP56Time2a_getTimestamp(mvs7_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time8, CP56Time2a_toMsTimestamp(MeasuredValueScaledWithCP56Time2a_getTimestamp(mvs8_dec)));
+    TEST_ASSERT_EQUAL_INT(0, ResetProcessCommand_getQRP(rpc_dec));
 
-    MeasuredValueScaledWithCP56Time2a_destroy(mvs1_dec);
-    MeasuredValueScaledWithCP56Time2a_destroy(mvs2_dec);
-    MeasuredValueScaledWithCP56Time2a_destroy(mvs3_dec);
-    MeasuredValueScaledWithCP56Time2a_destroy(mvs4_dec);
-    MeasuredValueScaledWithCP56Time2a_destroy(mvs5_dec);
-    MeasuredValueScaledWithCP56Time2a_destroy(mvs6_dec);
-    MeasuredValueScaledWithCP56Time2a_destroy(mvs7_dec);
-    MeasuredValueScaledWithCP56Time2a_destroy(mvs8_dec);
+    ResetProcessCommand_destroy(rpc_dec);
 
     CS101_ASDU_destroy(asdu2);
 }
 
 void
-test_MeasuredValueShort(void)
+test_DelayAcquisitionCommand(void)
 {
-    MeasuredValueShort mvs1;
-    MeasuredValueShort mvs2;
-    MeasuredValueShort mvs3;
-    MeasuredValueShort mvs4;
-    MeasuredValueShort mvs5;
-    MeasuredValueShort mvs6;
-    MeasuredValueShort mvs7;
-    MeasuredValueShort mvs8;
+    DelayAcquisitionCommand dac;
+    uint8_t time1 = Hal_getTimeInMs();
 
-    mvs1 = MeasuredValueShort_create(NULL, 101, 10.5f, IEC60870_QUALITY_GOOD);
-    mvs2 = MeasuredValueShort_create(NULL, 102, 11.5f, IEC60870_QUALITY_OVERFLOW);
-    mvs3 = MeasuredValueShort_create(NULL, 103, 12.5f, IEC60870_QUALITY_RESERVED);
-    mvs4 = MeasuredValueShort_create(NULL, 104, 13.5f, IEC60870_QUALITY_ELAPSED_TIME_INVALID);
-    mvs5 = MeasuredValueShort_create(NULL, 105, 14.5f, IEC60870_QUALITY_BLOCKED);
-    mvs6 = MeasuredValueShort_create(NULL, 106, 15.5f, IEC60870_QUALITY_SUBSTITUTED);
-    mvs7 = MeasuredValueShort_create(NULL, 107, 16.5f, IEC60870_QUALITY_NON_TOPICAL);
-    mvs8 = MeasuredValueShort_create(NULL, 108, 17.5f, IEC60870_QUALITY_INVALID);
+    struct sCP16Time2a delay;
 
-    TEST_ASSERT_EQUAL_FLOAT(10.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs1));
-    TEST_ASSERT_EQUAL_FLOAT(11.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs2));
-    TEST_ASSERT_EQUAL_FLOAT(12.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs3));
-    TEST_ASSERT_EQUAL_FLOAT(13.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs4));
-    TEST_ASSERT_EQUAL_FLOAT(14.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs5));
-    TEST_ASSERT_EQUAL_FLOAT(15.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs6));
-    TEST_ASSERT_EQUAL_FLOAT(16.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs7));
-    TEST_ASSERT_EQUAL_FLOAT(17.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs8));
+    bzero(&delay, sizeof(struct sCP16Time2a));
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueShort_getQuality(mvs1));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueShort_getQuality(mvs2));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueShort_getQuality(mvs3));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueShort_getQuality(mvs4));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueShort_getQuality(mvs5));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueShort_getQuality(mvs6));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueShort_getQuality(mvs7));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueShort_getQuality(mvs8));
+    CP16Time2a_setEplapsedTimeInMs(&delay, 24123);
 
+    dac = DelayAcquisitionCommand_create(NULL, 101, &delay);
     uint8_t buffer[256];
 
     struct sBufferFrame bf;
 
     Frame f = BufferFrame_initialize(&bf, buffer, 0);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs2);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs3);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs4);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs5);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs6);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs7);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs8);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) dac);
 
-    MeasuredValueShort_destroy(mvs1);
-    MeasuredValueShort_destroy(mvs2);
-    MeasuredValueShort_destroy(mvs3);
-    MeasuredValueShort_destroy(mvs4);
-    MeasuredValueShort_destroy(mvs5);
-    MeasuredValueShort_destroy(mvs6);
-    MeasuredValueShort_destroy(mvs7);
-    MeasuredValueShort_destroy(mvs8);
+    DelayAcquisitionCommand_destroy(dac);
 
     CS101_ASDU_encode(asdu, f);
 
-    TEST_ASSERT_EQUAL_INT(70, Frame_getMsgSize(f));
+    TEST_ASSERT_EQUAL_INT(11, Frame_getMsgSize(f));
 
     CS101_ASDU_destroy(asdu);
 
     CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
 
-    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
-
-    MeasuredValueShort mvs1_dec = (MeasuredValueShort) CS101_ASDU_getElement(asdu2, 0);
-    MeasuredValueShort mvs2_dec = (MeasuredValueShort) CS101_ASDU_getElement(asdu2, 1);
-    MeasuredValueShort mvs3_dec = (MeasuredValueShort) CS101_ASDU_getElement(asdu2, 2);
-    MeasuredValueShort mvs4_dec = (MeasuredValueShort) CS101_ASDU_getElement(asdu2, 3);
-    MeasuredValueShort mvs5_dec = (MeasuredValueShort) CS101_ASDU_getElement(asdu2, 4);
-    MeasuredValueShort mvs6_dec = (MeasuredValueShort) CS101_ASDU_getElement(asdu2, 5);
-    MeasuredValueShort mvs7_dec = (MeasuredValueShort) CS101_ASDU_getElement(asdu2, 6);
-    MeasuredValueShort mvs8_dec = (MeasuredValueShort) CS101_ASDU_getElement(asdu2, 7);
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
 
-    TEST_ASSERT_EQUAL_FLOAT(10.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs1_dec));
-    TEST_ASSERT_EQUAL_FLOAT(11.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs2_dec));
-    TEST_ASSERT_EQUAL_FLOAT(12.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs3_dec));
-    TEST_ASSERT_EQUAL_FLOAT(13.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs4_dec));
-    TEST_ASSERT_EQUAL_FLOAT(14.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs5_dec));
-    TEST_ASSERT_EQUAL_FLOAT(15.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs6_dec));
-    TEST_ASSERT_EQUAL_FLOAT(16.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs7_dec));
-    TEST_ASSERT_EQUAL_FLOAT(17.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs8_dec));
+    DelayAcquisitionCommand dac_dec = (DelayAcquisitionCommand) CS101_ASDU_getElement(asdu2, 0);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueShort_getQuality(mvs1_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueShort_getQuality(mvs2_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueShort_getQuality(mvs3_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueShort_getQuality(mvs4_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueShort_getQuality(mvs5_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueShort_getQuality(mvs6_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueShort_getQuality(mvs7_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueShort_getQuality(mvs8_dec));
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )dac_dec));
+    CP16Time2a time1_dec = DelayAcquisitionCommand_getDelay(dac_dec);
+    TEST_ASSERT_EQUAL_INT(24123, CP16Time2a_getEplapsedTimeInMs(time1_dec));
 
-    MeasuredValueShort_destroy(mvs1_dec);
-    MeasuredValueShort_destroy(mvs2_dec);
-    MeasuredValueShort_destroy(mvs3_dec);
-    MeasuredValueShort_destroy(mvs4_dec);
-    MeasuredValueShort_destroy(mvs5_dec);
-    MeasuredValueShort_destroy(mvs6_dec);
-    MeasuredValueShort_destroy(mvs7_dec);
-    MeasuredValueShort_destroy(mvs8_dec);
+    DelayAcquisitionCommand_destroy(dac_dec);
 
     CS101_ASDU_destroy(asdu2);
 }
 
 void
-test_MeasuredValueShortWithCP24Time2a(void)
+test_BitString32(void)
 {
-    MeasuredValueShortWithCP24Time2a mvs1;
-    MeasuredValueShortWithCP24Time2a mvs2;
-    MeasuredValueShortWithCP24Time2a mvs3;
-    MeasuredValueShortWithCP24Time2a mvs4;
-    MeasuredValueShortWithCP24Time2a mvs5;
-    MeasuredValueShortWithCP24Time2a mvs6;
-    MeasuredValueShortWithCP24Time2a mvs7;
-    MeasuredValueShortWithCP24Time2a mvs8;
+    BitString32 bs32;
 
-    uint64_t time1 = Hal_getTimeInMs();
-    uint64_t time2 = time1 + 1000;
-    uint64_t time3 = time2 + 1000;
-    uint64_t time4 = time3 + 1000;
-    uint64_t time5 = time4 + 1000;
-    uint64_t time6 = time5 + 1000;
-    uint64_t time7 = time6 + 1000;
-    uint64_t time8 = time7 + 1000;
+    bs32 = BitString32_createEx(NULL, 101, 0xaaaa, IEC60870_QUALITY_INVALID);
 
-    struct sCP24Time2a cpTime1;
-    struct sCP24Time2a cpTime2;
-    struct sCP24Time2a cpTime3;
-    struct sCP24Time2a cpTime4;
-    struct sCP24Time2a cpTime5;
-    struct sCP24Time2a cpTime6;
-    struct sCP24Time2a cpTime7;
-    struct sCP24Time2a cpTime8;
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, BitString32_getQuality(bs32));
 
-    bzero(&cpTime1, sizeof(struct sCP24Time2a));
-    bzero(&cpTime2, sizeof(struct sCP24Time2a));
-    bzero(&cpTime3, sizeof(struct sCP24Time2a));
-    bzero(&cpTime4, sizeof(struct sCP24Time2a));
-    bzero(&cpTime5, sizeof(struct sCP24Time2a));
-    bzero(&cpTime6, sizeof(struct sCP24Time2a));
-    bzero(&cpTime7, sizeof(struct sCP24Time2a));
-    bzero(&cpTime8, sizeof(struct sCP24Time2a));
+    BitString32_destroy(bs32);
+
+    bs32 = BitString32_create(NULL, 101, 0xaaaa);
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, BitString32_getQuality(bs32));
+
+    BitString32_destroy(bs32);
+
+    bs32 = BitString32_createEx(NULL, 101, 0xaaaa, IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL);
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID + IEC60870_QUALITY_NON_TOPICAL, BitString32_getQuality(bs32));
+
+    TEST_ASSERT_EQUAL_UINT32(0xaaaa, BitString32_getValue(bs32));
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject ) bs32));
+
+    BitString32_destroy(bs32);
+
+    Bitstring32WithCP24Time2a bs32cp24;
+
+    struct sCP24Time2a cp24;
+
+    bs32cp24 = Bitstring32WithCP24Time2a_createEx(NULL, 100002, 0xbbbb, IEC60870_QUALITY_INVALID, &cp24);
+
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, BitString32_getQuality((BitString32 )bs32cp24));
+
+    TEST_ASSERT_EQUAL_UINT32(0xbbbb, BitString32_getValue((BitString32 )bs32cp24));
 
-    CP24Time2a_setMinute(&cpTime1, 12);
-    CP24Time2a_setMillisecond(&cpTime1, 24123);
+    TEST_ASSERT_EQUAL_INT(100002, InformationObject_getObjectAddress((InformationObject ) bs32cp24));
 
-    CP24Time2a_setMinute(&cpTime2, 54);
-    CP24Time2a_setMillisecond(&cpTime2, 12345);
+    Bitstring32WithCP24Time2a_destroy(bs32cp24);
 
-    CP24Time2a_setMinute(&cpTime3, 00);
-    CP24Time2a_setMillisecond(&cpTime3, 00001);
+    bs32cp24 = Bitstring32WithCP24Time2a_create(NULL, 100002, 0xbbbb, &cp24);
 
-    CP24Time2a_setMinute(&cpTime4, 12);
-    CP24Time2a_setMillisecond(&cpTime4, 24123);
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, BitString32_getQuality((BitString32 )bs32cp24));
 
-    CP24Time2a_setMinute(&cpTime5, 12);
-    CP24Time2a_setMillisecond(&cpTime5, 24123);
+    TEST_ASSERT_EQUAL_UINT32(0xbbbb, BitString32_getValue((BitString32 )bs32cp24));
 
-    CP24Time2a_setMinute(&cpTime6, 12);
-    CP24Time2a_setMillisecond(&cpTime6, 24123);
+    TEST_ASSERT_EQUAL_INT(100002, InformationObject_getObjectAddress((InformationObject ) bs32cp24));
 
-    CP24Time2a_setMinute(&cpTime7, 12);
-    CP24Time2a_setMillisecond(&cpTime7, 24123);
+    Bitstring32WithCP24Time2a_destroy(bs32cp24);
 
-    CP24Time2a_setMinute(&cpTime8, 12);
-    CP24Time2a_setMillisecond(&cpTime8, 24123);
+    Bitstring32WithCP56Time2a bs32cp56;
 
-    mvs1 = MeasuredValueShortWithCP24Time2a_create(NULL, 101, 10.5f, IEC60870_QUALITY_GOOD, &cpTime1);
-    mvs2 = MeasuredValueShortWithCP24Time2a_create(NULL, 102, 11.5f, IEC60870_QUALITY_OVERFLOW, &cpTime2);
-    mvs3 = MeasuredValueShortWithCP24Time2a_create(NULL, 103, 12.5f, IEC60870_QUALITY_RESERVED, &cpTime3);
-    mvs4 = MeasuredValueShortWithCP24Time2a_create(NULL, 104, 13.5f, IEC60870_QUALITY_ELAPSED_TIME_INVALID, &cpTime4);
-    mvs5 = MeasuredValueShortWithCP24Time2a_create(NULL, 105, 14.5f, IEC60870_QUALITY_BLOCKED, &cpTime5);
-    mvs6 = MeasuredValueShortWithCP24Time2a_create(NULL, 106, 15.5f, IEC60870_QUALITY_SUBSTITUTED, &cpTime6);
-    mvs7 = MeasuredValueShortWithCP24Time2a_create(NULL, 107, 16.5f, IEC60870_QUALITY_NON_TOPICAL, &cpTime7);
-    mvs8 = MeasuredValueShortWithCP24Time2a_create(NULL, 108, 17.5f, IEC60870_QUALITY_INVALID, &cpTime8);
+    struct sCP56Time2a cp56;
 
-    TEST_ASSERT_EQUAL_FLOAT(10.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs1));
-    TEST_ASSERT_EQUAL_FLOAT(11.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs2));
-    TEST_ASSERT_EQUAL_FLOAT(12.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs3));
-    TEST_ASSERT_EQUAL_FLOAT(13.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs4));
-    TEST_ASSERT_EQUAL_FLOAT(14.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs5));
-    TEST_ASSERT_EQUAL_FLOAT(15.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs6));
-    TEST_ASSERT_EQUAL_FLOAT(16.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs7));
-    TEST_ASSERT_EQUAL_FLOAT(17.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs8));
+    bs32cp56 = Bitstring32WithCP56Time2a_createEx(NULL, 1000002, 0xcccc, IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL, &cp56);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueShort_getQuality((MeasuredValueShort )mvs1));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueShort_getQuality((MeasuredValueShort )mvs2));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs3));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueShort_getQuality((MeasuredValueShort )mvs4));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs5));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs6));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueShort_getQuality((MeasuredValueShort )mvs7));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueShort_getQuality((MeasuredValueShort )mvs8));
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID + IEC60870_QUALITY_NON_TOPICAL, BitString32_getQuality((BitString32 )bs32cp56));
 
-    uint8_t buffer[256];
+    TEST_ASSERT_EQUAL_UINT32(0xcccc, BitString32_getValue((BitString32 )bs32cp56));
 
-    struct sBufferFrame bf;
+    TEST_ASSERT_EQUAL_INT(1000002, InformationObject_getObjectAddress((InformationObject ) bs32cp56));
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    Bitstring32WithCP56Time2a_destroy(bs32cp56);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    bs32cp56 = Bitstring32WithCP56Time2a_create(NULL, 1000002, 0xcccc, &cp56);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs2);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs3);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs4);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs5);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs6);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs7);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs8);
+    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, BitString32_getQuality((BitString32 )bs32cp56));
 
-    MeasuredValueShortWithCP24Time2a_destroy(mvs1);
-    MeasuredValueShortWithCP24Time2a_destroy(mvs2);
-    MeasuredValueShortWithCP24Time2a_destroy(mvs3);
-    MeasuredValueShortWithCP24Time2a_destroy(mvs4);
-    MeasuredValueShortWithCP24Time2a_destroy(mvs5);
-    MeasuredValueShortWithCP24Time2a_destroy(mvs6);
-    MeasuredValueShortWithCP24Time2a_destroy(mvs7);
-    MeasuredValueShortWithCP24Time2a_destroy(mvs8);
+    TEST_ASSERT_EQUAL_UINT32(0xcccc, BitString32_getValue((BitString32 )bs32cp56));
 
-    CS101_ASDU_encode(asdu, f);
+    TEST_ASSERT_EQUAL_INT(1000002, InformationObject_getObjectAddress((InformationObject ) bs32cp56));
 
-    TEST_ASSERT_EQUAL_INT(94, Frame_getMsgSize(f));
+    Bitstring32WithCP56Time2a_destroy(bs32cp56);
+}
 
-    CS101_ASDU_destroy(asdu);
+void
+test_Bitstring32CommandWithCP56Time2a(void)
+{
+    Bitstring32CommandWithCP56Time2a bsc;
+    uint64_t time1 = Hal_getTimeInMs();
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    struct sCP56Time2a cpTime1;
 
-    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
+    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
 
-    MeasuredValueShortWithCP24Time2a mvs1_dec = (MeasuredValueShortWithCP24Time2a) CS101_ASDU_getElement(asdu2, 0);
-    MeasuredValueShortWithCP24Time2a mvs2_dec = (MeasuredValueShortWithCP24Time2a) CS101_ASDU_getElement(asdu2, 1);
-    MeasuredValueShortWithCP24Time2a mvs3_dec = (MeasuredValueShortWithCP24Time2a) CS101_ASDU_getElement(asdu2, 2);
-    MeasuredValueShortWithCP24Time2a mvs4_dec = (MeasuredValueShortWithCP24Time2a) CS101_ASDU_getElement(asdu2, 3);
-    MeasuredValueShortWithCP24Time2a mvs5_dec = (MeasuredValueShortWithCP24Time2a) CS101_ASDU_getElement(asdu2, 4);
-    MeasuredValueShortWithCP24Time2a mvs6_dec = (MeasuredValueShortWithCP24Time2a) CS101_ASDU_getElement(asdu2, 5);
-    MeasuredValueShortWithCP24Time2a mvs7_dec = (MeasuredValueShortWithCP24Time2a) CS101_ASDU_getElement(asdu2, 6);
-    MeasuredValueShortWithCP24Time2a mvs8_dec = (MeasuredValueShortWithCP24Time2a) CS101_ASDU_getElement(asdu2, 7);
+    bsc = Bitstring32CommandWithCP56Time2a_create(NULL, 101, (uint32_t) 0x0000000000, &cpTime1);
 
-    TEST_ASSERT_EQUAL_FLOAT(10.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs1_dec));
-    TEST_ASSERT_EQUAL_FLOAT(11.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs2_dec));
-    TEST_ASSERT_EQUAL_FLOAT(12.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs3_dec));
-    TEST_ASSERT_EQUAL_FLOAT(13.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs4_dec));
-    TEST_ASSERT_EQUAL_FLOAT(14.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs5_dec));
-    TEST_ASSERT_EQUAL_FLOAT(15.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs6_dec));
-    TEST_ASSERT_EQUAL_FLOAT(16.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs7_dec));
-    TEST_ASSERT_EQUAL_FLOAT(17.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs8_dec));
+    TEST_ASSERT_EQUAL_UINT32(0x0000000000, Bitstring32CommandWithCP56Time2a_getValue(bsc));
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueShort_getQuality((MeasuredValueShort )mvs1_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueShort_getQuality((MeasuredValueShort )mvs2_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs3_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueShort_getQuality((MeasuredValueShort )mvs4_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs5_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs6_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueShort_getQuality((MeasuredValueShort )mvs7_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueShort_getQuality((MeasuredValueShort )mvs8_dec));
+    uint8_t buffer[256];
 
-    CP24Time2a time1_dec = MeasuredValueShortWithCP24Time2a_getTimestamp(mvs1_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time1_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time1_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time1_dec));
+    struct sBufferFrame bf;
 
-    CP24Time2a time2_dec = MeasuredValueShortWithCP24Time2a_getTimestamp(mvs2_dec);
-    TEST_ASSERT_EQUAL_INT(54, CP24Time2a_getMinute(time2_dec));
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getSecond(time2_dec));
-    TEST_ASSERT_EQUAL_INT(345, CP24Time2a_getMillisecond(time2_dec));
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
 
-    CP24Time2a time3_dec = MeasuredValueShortWithCP24Time2a_getTimestamp(mvs3_dec);
-    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getMinute(time3_dec));
-    TEST_ASSERT_EQUAL_INT(00, CP24Time2a_getSecond(time3_dec));
-    TEST_ASSERT_EQUAL_INT(1, CP24Time2a_getMillisecond(time3_dec));
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
 
-    CP24Time2a time4_dec = MeasuredValueShortWithCP24Time2a_getTimestamp(mvs4_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time4_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time4_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time4_dec));
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) bsc);
 
-    CP24Time2a time5_dec = MeasuredValueShortWithCP24Time2a_getTimestamp(mvs5_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time5_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time5_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time5_dec));
+    Bitstring32CommandWithCP56Time2a_destroy(bsc);
 
-    CP24Time2a time6_dec = MeasuredValueShortWithCP24Time2a_getTimestamp(mvs6_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time6_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time6_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time6_dec));
+    CS101_ASDU_encode(asdu, f);
 
-    CP24Time2a time7_dec = MeasuredValueShortWithCP24Time2a_getTimestamp(mvs7_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time7_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time7_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time7_dec));
+    TEST_ASSERT_EQUAL_INT(20, Frame_getMsgSize(f));
 
-    CP24Time2a time8_dec = MeasuredValueShortWithCP24Time2a_getTimestamp(mvs8_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time8_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time8_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time8_dec));
+    CS101_ASDU_destroy(asdu);
 
-    MeasuredValueShortWithCP24Time2a_destroy(mvs1_dec);
-    MeasuredValueShortWithCP24Time2a_destroy(mvs2_dec);
-    MeasuredValueShortWithCP24Time2a_destroy(mvs3_dec);
-    MeasuredValueShortWithCP24Time2a_destroy(mvs4_dec);
-    MeasuredValueShortWithCP24Time2a_destroy(mvs5_dec);
-    MeasuredValueShortWithCP24Time2a_destroy(mvs6_dec);
-    MeasuredValueShortWithCP24Time2a_destroy(mvs7_dec);
-    MeasuredValueShortWithCP24Time2a_destroy(mvs8_dec);
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+
+    Bitstring32CommandWithCP56Time2a bsc_dec = (Bitstring32CommandWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
+
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )bsc_dec));
+    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(Bitstring32CommandWithCP56Time2a_getTimestamp(bsc_dec)));
+    TEST_ASSERT_EQUAL_UINT32(0x0000000000, Bitstring32CommandWithCP56Time2a_getValue(bsc_dec));
+
+    Bitstring32CommandWithCP56Time2a_destroy(bsc_dec);
 
     CS101_ASDU_destroy(asdu2);
 }
 
 void
-test_MeasuredValueShortWithCP56Time2a(void)
+test_QueryLog(void)
 {
-    MeasuredValueShortWithCP56Time2a mvs1;
-    MeasuredValueShortWithCP56Time2a mvs2;
-    MeasuredValueShortWithCP56Time2a mvs3;
-    MeasuredValueShortWithCP56Time2a mvs4;
-    MeasuredValueShortWithCP56Time2a mvs5;
-    MeasuredValueShortWithCP56Time2a mvs6;
-    MeasuredValueShortWithCP56Time2a mvs7;
-    MeasuredValueShortWithCP56Time2a mvs8;
-
-    uint64_t time1 = Hal_getTimeInMs();
-    uint64_t time2 = time1 + 1000;
-    uint64_t time3 = time2 + 1000;
-    uint64_t time4 = time3 + 1000;
-    uint64_t time5 = time4 + 1000;
-    uint64_t time6 = time5 + 1000;
-    uint64_t time7 = time6 + 1000;
-    uint64_t time8 = time7 + 1000;
+    QueryLog queryLog;
 
-    struct sCP56Time2a cpTime1;
-    struct sCP56Time2a cpTime2;
-    struct sCP56Time2a cpTime3;
-    struct sCP56Time2a cpTime4;
-    struct sCP56Time2a cpTime5;
-    struct sCP56Time2a cpTime6;
-    struct sCP56Time2a cpTime7;
-    struct sCP56Time2a cpTime8;
+    uint64_t stopTime = Hal_getTimeInMs();
+    uint64_t startTime = stopTime - 2000;
 
-    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
-    CP56Time2a_createFromMsTimestamp(&cpTime2, time2);
-    CP56Time2a_createFromMsTimestamp(&cpTime3, time3);
-    CP56Time2a_createFromMsTimestamp(&cpTime4, time4);
-    CP56Time2a_createFromMsTimestamp(&cpTime5, time5);
-    CP56Time2a_createFromMsTimestamp(&cpTime6, time6);
-    CP56Time2a_createFromMsTimestamp(&cpTime7, time7);
-    CP56Time2a_createFromMsTimestamp(&cpTime8, time8);
+    struct sCP56Time2a rangeStartTime;
+    struct sCP56Time2a rangeStopTime;
 
-    mvs1 = MeasuredValueShortWithCP56Time2a_create(NULL, 101, 10.5f, IEC60870_QUALITY_GOOD, &cpTime1);
-    mvs2 = MeasuredValueShortWithCP56Time2a_create(NULL, 102, 11.5f, IEC60870_QUALITY_OVERFLOW, &cpTime2);
-    mvs3 = MeasuredValueShortWithCP56Time2a_create(NULL, 103, 12.5f, IEC60870_QUALITY_RESERVED, &cpTime3);
-    mvs4 = MeasuredValueShortWithCP56Time2a_create(NULL, 104, 13.5f, IEC60870_QUALITY_ELAPSED_TIME_INVALID, &cpTime4);
-    mvs5 = MeasuredValueShortWithCP56Time2a_create(NULL, 105, 14.5f, IEC60870_QUALITY_BLOCKED, &cpTime5);
-    mvs6 = MeasuredValueShortWithCP56Time2a_create(NULL, 106, 15.5f, IEC60870_QUALITY_SUBSTITUTED, &cpTime6);
-    mvs7 = MeasuredValueShortWithCP56Time2a_create(NULL, 107, 16.5f, IEC60870_QUALITY_NON_TOPICAL, &cpTime7);
-    mvs8 = MeasuredValueShortWithCP56Time2a_create(NULL, 108, 17.5f, IEC60870_QUALITY_INVALID, &cpTime8);
+    CP56Time2a_createFromMsTimestamp(&rangeStartTime, startTime);
+    CP56Time2a_createFromMsTimestamp(&rangeStopTime, stopTime);
 
-    TEST_ASSERT_EQUAL_FLOAT(10.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs1));
-    TEST_ASSERT_EQUAL_FLOAT(11.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs2));
-    TEST_ASSERT_EQUAL_FLOAT(12.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs3));
-    TEST_ASSERT_EQUAL_FLOAT(13.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs4));
-    TEST_ASSERT_EQUAL_FLOAT(14.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs5));
-    TEST_ASSERT_EQUAL_FLOAT(15.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs6));
-    TEST_ASSERT_EQUAL_FLOAT(16.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs7));
-    TEST_ASSERT_EQUAL_FLOAT(17.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs8));
+    queryLog = QueryLog_create(NULL, 101, 256, &rangeStartTime, &rangeStopTime);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueShort_getQuality((MeasuredValueShort )mvs1));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueShort_getQuality((MeasuredValueShort )mvs2));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs3));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueShort_getQuality((MeasuredValueShort )mvs4));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs5));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs6));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueShort_getQuality((MeasuredValueShort )mvs7));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueShort_getQuality((MeasuredValueShort )mvs8));
+    TEST_ASSERT_EQUAL_UINT16(256, QueryLog_getNOF(queryLog));
 
     uint8_t buffer[256];
 
@@ -3631,111 +6357,40 @@ test_MeasuredValueShortWithCP56Time2a(void)
 
     Frame f = BufferFrame_initialize(&bf, buffer, 0);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
-
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs2);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs3);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs4);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs5);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs6);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs7);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) mvs8);
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
 
-    MeasuredValueShortWithCP56Time2a_destroy(mvs1);
-    MeasuredValueShortWithCP56Time2a_destroy(mvs2);
-    MeasuredValueShortWithCP56Time2a_destroy(mvs3);
-    MeasuredValueShortWithCP56Time2a_destroy(mvs4);
-    MeasuredValueShortWithCP56Time2a_destroy(mvs5);
-    MeasuredValueShortWithCP56Time2a_destroy(mvs6);
-    MeasuredValueShortWithCP56Time2a_destroy(mvs7);
-    MeasuredValueShortWithCP56Time2a_destroy(mvs8);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) queryLog);
+
+    QueryLog_destroy(queryLog);
 
     CS101_ASDU_encode(asdu, f);
 
-    TEST_ASSERT_EQUAL_INT(126, Frame_getMsgSize(f));
+    TEST_ASSERT_EQUAL_INT(25, Frame_getMsgSize(f));
 
     CS101_ASDU_destroy(asdu);
 
     CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
 
-    TEST_ASSERT_EQUAL_INT(8, CS101_ASDU_getNumberOfElements(asdu2));
-
-    MeasuredValueShortWithCP56Time2a mvs1_dec = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
-    MeasuredValueShortWithCP56Time2a mvs2_dec = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 1);
-    MeasuredValueShortWithCP56Time2a mvs3_dec = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 2);
-    MeasuredValueShortWithCP56Time2a mvs4_dec = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 3);
-    MeasuredValueShortWithCP56Time2a mvs5_dec = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 4);
-    MeasuredValueShortWithCP56Time2a mvs6_dec = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 5);
-    MeasuredValueShortWithCP56Time2a mvs7_dec = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 6);
-    MeasuredValueShortWithCP56Time2a mvs8_dec = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 7);
+    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
 
-    TEST_ASSERT_EQUAL_FLOAT(10.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs1_dec));
-    TEST_ASSERT_EQUAL_FLOAT(11.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs2_dec));
-    TEST_ASSERT_EQUAL_FLOAT(12.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs3_dec));
-    TEST_ASSERT_EQUAL_FLOAT(13.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs4_dec));
-    TEST_ASSERT_EQUAL_FLOAT(14.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs5_dec));
-    TEST_ASSERT_EQUAL_FLOAT(15.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs6_dec));
-    TEST_ASSERT_EQUAL_FLOAT(16.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs7_dec));
-    TEST_ASSERT_EQUAL_FLOAT(17.5f, MeasuredValueShort_getValue((MeasuredValueShort )mvs8_dec));
+    QueryLog queryLog_dec = (QueryLog) CS101_ASDU_getElement(asdu2, 0);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, MeasuredValueShort_getQuality((MeasuredValueShort )mvs1_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_OVERFLOW, MeasuredValueShort_getQuality((MeasuredValueShort )mvs2_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_RESERVED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs3_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_ELAPSED_TIME_INVALID, MeasuredValueShort_getQuality((MeasuredValueShort )mvs4_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_BLOCKED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs5_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_SUBSTITUTED, MeasuredValueShort_getQuality((MeasuredValueShort )mvs6_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueShort_getQuality((MeasuredValueShort )mvs7_dec));
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, MeasuredValueShort_getQuality((MeasuredValueShort )mvs8_dec));
+    TEST_ASSERT_NOT_NULL(queryLog_dec);
 
-    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mvs1_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time2, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mvs2_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time3, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mvs3_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time4, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mvs4_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time5, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mvs5_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time6, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mvs6_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time7, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mvs7_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time8, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mvs8_dec)));
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )queryLog_dec));
+    TEST_ASSERT_EQUAL_UINT16(256, QueryLog_getNOF(queryLog_dec));
+    TEST_ASSERT_EQUAL_UINT64(startTime, CP56Time2a_toMsTimestamp(QueryLog_getRangeStartTime(queryLog_dec)));
+    TEST_ASSERT_EQUAL_UINT64(stopTime, CP56Time2a_toMsTimestamp(QueryLog_getRangeStopTime(queryLog_dec)));
 
-    MeasuredValueShortWithCP56Time2a_destroy(mvs1_dec);
-    MeasuredValueShortWithCP56Time2a_destroy(mvs2_dec);
-    MeasuredValueShortWithCP56Time2a_destroy(mvs3_dec);
-    MeasuredValueShortWithCP56Time2a_destroy(mvs4_dec);
-    MeasuredValueShortWithCP56Time2a_destroy(mvs5_dec);
-    MeasuredValueShortWithCP56Time2a_destroy(mvs6_dec);
-    MeasuredValueShortWithCP56Time2a_destroy(mvs7_dec);
-    MeasuredValueShortWithCP56Time2a_destroy(mvs8_dec);
+    QueryLog_destroy(queryLog_dec);
 
     CS101_ASDU_destroy(asdu2);
 }
 
 void
-test_IntegratedTotals(void)
+test_BitString32xx_encodeDecode(void)
 {
-    IntegratedTotals it1;
-    IntegratedTotals it2;
-    BinaryCounterReading bcr1;
-    BinaryCounterReading bcr2;
-
-    bcr1 = BinaryCounterReading_create(NULL, INT32_MAX, 0, true, true, true);
-    bcr2 = BinaryCounterReading_create(NULL, INT32_MIN, 15, false, false, false);
-    it1 = IntegratedTotals_create(NULL, 101, bcr1);
-    it2 = IntegratedTotals_create(NULL, 102, bcr2);
-
-    BinaryCounterReading_destroy(bcr1);
-    BinaryCounterReading_destroy(bcr2);
-
-    TEST_ASSERT_EQUAL_INT32(INT32_MAX, BinaryCounterReading_getValue(IntegratedTotals_getBCR(it1)));
-    TEST_ASSERT_EQUAL_UINT8(0, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR(it1)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR(it1)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR(it1)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR(it1)));
-
-    TEST_ASSERT_EQUAL_INT32(INT32_MIN, BinaryCounterReading_getValue(IntegratedTotals_getBCR(it2)));
-    TEST_ASSERT_EQUAL_UINT8(15, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR(it2)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR(it2)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR(it2)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR(it2)));
+#ifndef _WIN32
     uint8_t buffer[256];
 
     struct sBufferFrame bf;
@@ -3744,1485 +6399,1998 @@ test_IntegratedTotals(void)
 
     CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) it1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) it2);
+    BitString32 bs32_1 = BitString32_createEx(NULL, 101, (uint32_t) 0xaaaaaaaaaa, IEC60870_QUALITY_INVALID);
+    BitString32 bs32_2 = BitString32_create(NULL, 102, (uint32_t) 0x0000000000);
+    BitString32 bs32_3 = BitString32_create(NULL, 103, (uint32_t) 0xffffffffffUL);
 
-    IntegratedTotals_destroy(it1);
-    IntegratedTotals_destroy(it2);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) bs32_1);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) bs32_2);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) bs32_3);
 
     CS101_ASDU_encode(asdu, f);
 
-    TEST_ASSERT_EQUAL_INT(22, Frame_getMsgSize(f));
-
+    InformationObject_destroy((InformationObject) bs32_1);
+    InformationObject_destroy((InformationObject) bs32_2);
+    InformationObject_destroy((InformationObject) bs32_3);
     CS101_ASDU_destroy(asdu);
 
     CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
 
-    TEST_ASSERT_EQUAL_INT(2, CS101_ASDU_getNumberOfElements(asdu2));
+    BitString32 bs32_1_dec = (BitString32) CS101_ASDU_getElement(asdu2, 0);
+    BitString32 bs32_2_dec = (BitString32) CS101_ASDU_getElement(asdu2, 1);
+    BitString32 bs32_3_dec = (BitString32) CS101_ASDU_getElement(asdu2, 2);
 
-    IntegratedTotals it1_dec = (IntegratedTotals) CS101_ASDU_getElement(asdu2, 0);
-    IntegratedTotals it2_dec = (IntegratedTotals) CS101_ASDU_getElement(asdu2, 1);
+    TEST_ASSERT_EQUAL_UINT32(0xaaaaaaaaaaUL, BitString32_getValue(bs32_1_dec));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_INVALID, BitString32_getQuality(bs32_1_dec));
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )it1_dec));
-    TEST_ASSERT_EQUAL_INT32(INT32_MAX, BinaryCounterReading_getValue(IntegratedTotals_getBCR(it1_dec)));
-    TEST_ASSERT_EQUAL_UINT8(0, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR(it1_dec)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR(it1_dec)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR(it1_dec)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR(it1_dec)));
+    TEST_ASSERT_EQUAL_UINT32(0x0000000000UL, BitString32_getValue(bs32_2_dec));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_GOOD, BitString32_getQuality(bs32_2_dec));
 
-    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )it2_dec));
-    TEST_ASSERT_EQUAL_INT32(INT32_MIN, BinaryCounterReading_getValue(IntegratedTotals_getBCR(it2_dec)));
-    TEST_ASSERT_EQUAL_UINT8(15, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR(it2_dec)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR(it2_dec)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR(it2_dec)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR(it2_dec)));
+    TEST_ASSERT_EQUAL_UINT32(0xffffffffUL, BitString32_getValue(bs32_3_dec));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_GOOD, BitString32_getQuality(bs32_3_dec));
 
-    IntegratedTotals_destroy(it1_dec);
-    IntegratedTotals_destroy(it2_dec);
+    InformationObject_destroy((InformationObject)bs32_1_dec);
+    InformationObject_destroy((InformationObject)bs32_2_dec);
+    InformationObject_destroy((InformationObject)bs32_3_dec);
 
     CS101_ASDU_destroy(asdu2);
+#endif
+}
+
+struct test_ConditionWaitTimed_Info
+{
+    Mutex mutex;
+    Condition condition;
+    bool flag;
+};
+
+static void*
+test_ConditionWaitTimed_signalThreadFunction(void* parameter)
+{
+    struct test_ConditionWaitTimed_Info* info = (struct test_ConditionWaitTimed_Info*) parameter;
+
+    Thread_sleep(10);
+
+    Mutex_lock(info->mutex);
+    info->flag = true;
+    Condition_signal(info->condition);
+    Mutex_unlock(info->mutex);
+
+    return NULL;
 }
 
 void
-test_IntegratedTotalsWithCP24Time2a(void)
+test_ConditionWaitTimed(void)
 {
-    IntegratedTotalsWithCP24Time2a it1;
-    IntegratedTotalsWithCP24Time2a it2;
-    BinaryCounterReading bcr1;
-    BinaryCounterReading bcr2;
-    uint64_t time1 = Hal_getTimeInMs();
-    uint64_t time2 = time1 + 1000;
+    struct test_ConditionWaitTimed_Info info;
 
-    struct sCP24Time2a cpTime1;
-    struct sCP24Time2a cpTime2;
+    info.mutex = Mutex_create();
+    info.condition = Condition_create();
+    info.flag = false;
 
-    bzero(&cpTime1, sizeof(struct sCP24Time2a));
-    bzero(&cpTime2, sizeof(struct sCP24Time2a));
+    TEST_ASSERT_NOT_NULL(info.mutex);
+    TEST_ASSERT_NOT_NULL(info.condition);
 
-    CP24Time2a_setMinute(&cpTime1, 12);
-    CP24Time2a_setMillisecond(&cpTime1, 24123);
+    Mutex_lock(info.mutex);
 
-    CP24Time2a_setMinute(&cpTime2, 54);
-    CP24Time2a_setMillisecond(&cpTime2, 12345);
+    uint64_t startTime = Hal_getTimeInMs();
 
-    bcr1 = BinaryCounterReading_create(NULL, INT32_MAX, 0, true, true, true);
-    bcr2 = BinaryCounterReading_create(NULL, INT32_MIN, 15, false, false, false);
-    it1 = IntegratedTotalsWithCP24Time2a_create(NULL, 101, bcr1, &cpTime1);
-    it2 = IntegratedTotalsWithCP24Time2a_create(NULL, 102, bcr2, &cpTime2);
+    TEST_ASSERT_FALSE(Condition_waitTimed(info.condition, info.mutex, 50));
 
-    BinaryCounterReading_destroy(bcr1);
-    BinaryCounterReading_destroy(bcr2);
+    TEST_ASSERT_TRUE(Hal_getTimeInMs() - startTime >= 45);
 
-    TEST_ASSERT_EQUAL_INT32(INT32_MAX, BinaryCounterReading_getValue(IntegratedTotals_getBCR((IntegratedTotals )it1)));
-    TEST_ASSERT_EQUAL_UINT8(0, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR((IntegratedTotals )it1)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR((IntegratedTotals )it1)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR((IntegratedTotals )it1)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR((IntegratedTotals )it1)));
+    Thread signalThread = Thread_create(test_ConditionWaitTimed_signalThreadFunction, &info, false);
+    Thread_start(signalThread);
 
-    TEST_ASSERT_EQUAL_INT32(INT32_MIN, BinaryCounterReading_getValue(IntegratedTotals_getBCR((IntegratedTotals )it2)));
-    TEST_ASSERT_EQUAL_UINT8(15, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR((IntegratedTotals )it2)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR((IntegratedTotals )it2)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR((IntegratedTotals )it2)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR((IntegratedTotals )it2)));
-    uint8_t buffer[256];
+    while (info.flag == false) {
+        if (Condition_waitTimed(info.condition, info.mutex, 1000) == false)
+            break;
+    }
 
-    struct sBufferFrame bf;
+    TEST_ASSERT_TRUE(info.flag);
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    Mutex_unlock(info.mutex);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    Thread_destroy(signalThread);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) it1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) it2);
+    Condition_destroy(info.condition);
+    Mutex_destroy(info.mutex);
+}
 
-    IntegratedTotalsWithCP24Time2a_destroy(it1);
-    IntegratedTotalsWithCP24Time2a_destroy(it2);
+static void*
+test_ThreadAttributes_threadFunction(void* parameter)
+{
+    bool* executed = (bool*) parameter;
 
-    CS101_ASDU_encode(asdu, f);
+    *executed = true;
 
-    TEST_ASSERT_EQUAL_INT(28, Frame_getMsgSize(f));
+    return NULL;
+}
 
-    CS101_ASDU_destroy(asdu);
+void
+test_ThreadAttributes(void)
+{
+    struct sThreadAttributes attributes;
+    bool executed = false;
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    ThreadAttributes_init(&attributes);
 
-    TEST_ASSERT_EQUAL_INT(2, CS101_ASDU_getNumberOfElements(asdu2));
+    TEST_ASSERT_EQUAL_UINT64(0, attributes.cpuAffinityMask);
+    TEST_ASSERT_EQUAL_INT(THREAD_SCHEDULING_POLICY_DEFAULT, attributes.schedulingPolicy);
+    TEST_ASSERT_EQUAL_STRING("", attributes.name);
 
-    IntegratedTotalsWithCP24Time2a it1_dec = (IntegratedTotalsWithCP24Time2a) CS101_ASDU_getElement(asdu2, 0);
-    IntegratedTotalsWithCP24Time2a it2_dec = (IntegratedTotalsWithCP24Time2a) CS101_ASDU_getElement(asdu2, 1);
+    ThreadAttributes_setName(&attributes, "a-very-long-thread-name");
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )it1_dec));
-    TEST_ASSERT_EQUAL_INT32(INT32_MAX, BinaryCounterReading_getValue(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
-    TEST_ASSERT_EQUAL_UINT8(0, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
+    TEST_ASSERT_EQUAL_STRING("a-very-long-thr", attributes.name);
 
-    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )it2_dec));
-    TEST_ASSERT_EQUAL_INT32(INT32_MIN, BinaryCounterReading_getValue(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
-    TEST_ASSERT_EQUAL_UINT8(15, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
+    /* attributes that cannot be applied (real-time scheduling without privileges) are ignored */
+    attributes.cpuAffinityMask = 1;
+    attributes.schedulingPolicy = THREAD_SCHEDULING_POLICY_FIFO;
+    attributes.priority = 10;
 
-    CP24Time2a time1_dec = IntegratedTotalsWithCP24Time2a_getTimestamp(it1_dec);
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getMinute(time1_dec));
-    TEST_ASSERT_EQUAL_INT(24, CP24Time2a_getSecond(time1_dec));
-    TEST_ASSERT_EQUAL_INT(123, CP24Time2a_getMillisecond(time1_dec));
+    Thread thread = Thread_create(test_ThreadAttributes_threadFunction, &executed, false);
+    Thread_setAttributes(thread, &attributes);
+    Thread_start(thread);
+    Thread_destroy(thread);
 
-    CP24Time2a time2_dec = IntegratedTotalsWithCP24Time2a_getTimestamp(it2_dec);
-    TEST_ASSERT_EQUAL_INT(54, CP24Time2a_getMinute(time2_dec));
-    TEST_ASSERT_EQUAL_INT(12, CP24Time2a_getSecond(time2_dec));
-    TEST_ASSERT_EQUAL_INT(345, CP24Time2a_getMillisecond(time2_dec));
+    TEST_ASSERT_TRUE(executed);
+}
 
-    IntegratedTotalsWithCP24Time2a_destroy(it1_dec);
-    IntegratedTotalsWithCP24Time2a_destroy(it2_dec);
-    CS101_ASDU_destroy(asdu2);
+static Socket
+test_HandleSet_accept(ServerSocket serverSocket)
+{
+    Socket socket = NULL;
+    int retries = 100;
+
+    while ((socket == NULL) && (retries-- > 0)) {
+        socket = ServerSocket_accept(serverSocket);
+
+        if (socket == NULL)
+            Thread_sleep(10);
+    }
+
+    return socket;
 }
 
 void
-test_IntegratedTotalsWithCP56Time2a(void)
+test_HandleSetIsReady(void)
 {
-    IntegratedTotalsWithCP56Time2a it1;
-    IntegratedTotalsWithCP56Time2a it2;
-    BinaryCounterReading bcr1;
-    BinaryCounterReading bcr2;
+    uint8_t data[] = {0x68, 0x04, 0x07, 0x00, 0x00, 0x00};
 
-    uint64_t time1 = Hal_getTimeInMs();
-    uint64_t time2 = time1 + 1000;
+    ServerSocket serverSocket = TcpServerSocket_create("127.0.0.1", 20005);
+    TEST_ASSERT_NOT_NULL(serverSocket);
+    ServerSocket_listen(serverSocket);
 
-    struct sCP56Time2a cpTime1;
-    struct sCP56Time2a cpTime2;
+    Socket client1 = TcpSocket_create();
+    Socket client2 = TcpSocket_create();
 
-    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
-    CP56Time2a_createFromMsTimestamp(&cpTime2, time2);
+    TEST_ASSERT_TRUE(Socket_connect(client1, "127.0.0.1", 20005));
+    Socket con1 = test_HandleSet_accept(serverSocket);
 
-    bcr1 = BinaryCounterReading_create(NULL, INT32_MAX, 0, true, true, true);
-    bcr2 = BinaryCounterReading_create(NULL, INT32_MIN, 15, false, false, false);
-    it1 = IntegratedTotalsWithCP56Time2a_create(NULL, 101, bcr1, &cpTime1);
-    it2 = IntegratedTotalsWithCP56Time2a_create(NULL, 102, bcr2, &cpTime2);
+    TEST_ASSERT_TRUE(Socket_connect(client2, "127.0.0.1", 20005));
+    Socket con2 = test_HandleSet_accept(serverSocket);
 
-    BinaryCounterReading_destroy(bcr1);
-    BinaryCounterReading_destroy(bcr2);
+    TEST_ASSERT_NOT_NULL(con1);
+    TEST_ASSERT_NOT_NULL(con2);
+
+    HandleSet handleSet = Handleset_new();
+
+    Handleset_addSocket(handleSet, con1);
+    Handleset_addSocket(handleSet, con2);
+    Handleset_addSocket(handleSet, con2);
+
+    TEST_ASSERT_EQUAL_INT(0, Handleset_waitReady(handleSet, 10));
+
+    Socket_write(client2, data, sizeof(data));
+
+    /* sockets stay registered -> no reset/add required */
+    TEST_ASSERT_EQUAL_INT(1, Handleset_waitReady(handleSet, 1000));
+    TEST_ASSERT_FALSE(Handleset_isReady(handleSet, con1));
+    TEST_ASSERT_TRUE(Handleset_isReady(handleSet, con2));
+
+    Handleset_removeSocket(handleSet, con2);
+
+    TEST_ASSERT_EQUAL_INT(0, Handleset_waitReady(handleSet, 10));
+    TEST_ASSERT_FALSE(Handleset_isReady(handleSet, con2));
+
+    Handleset_destroy(handleSet);
+
+    Socket_destroy(client1);
+    Socket_destroy(client2);
+    Socket_destroy(con1);
+    Socket_destroy(con2);
+    ServerSocket_destroy(serverSocket);
+}
 
-    TEST_ASSERT_EQUAL_INT32(INT32_MAX, BinaryCounterReading_getValue(IntegratedTotals_getBCR((IntegratedTotals )it1)));
-    TEST_ASSERT_EQUAL_UINT8(0, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR((IntegratedTotals )it1)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR((IntegratedTotals )it1)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR((IntegratedTotals )it1)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR((IntegratedTotals )it1)));
+void
+test_HandleSetIsReadyAfterRemove(void)
+{
+    uint8_t data[] = {0x68, 0x04, 0x07, 0x00, 0x00, 0x00};
 
-    TEST_ASSERT_EQUAL_INT32(INT32_MIN, BinaryCounterReading_getValue(IntegratedTotals_getBCR((IntegratedTotals )it2)));
-    TEST_ASSERT_EQUAL_UINT8(15, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR((IntegratedTotals )it2)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR((IntegratedTotals )it2)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR((IntegratedTotals )it2)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR((IntegratedTotals )it2)));
-    uint8_t buffer[256];
+    ServerSocket serverSocket = TcpServerSocket_create("127.0.0.1", 20005);
+    TEST_ASSERT_NOT_NULL(serverSocket);
+    ServerSocket_listen(serverSocket);
 
-    struct sBufferFrame bf;
+    Socket clients[6];
+    Socket cons[6];
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    HandleSet handleSet = Handleset_new();
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    int i;
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) it1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) it2);
+    for (i = 0; i < 6; i++) {
+        clients[i] = TcpSocket_create();
+        TEST_ASSERT_TRUE(Socket_connect(clients[i], "127.0.0.1", 20005));
 
-    IntegratedTotalsWithCP56Time2a_destroy(it1);
-    IntegratedTotalsWithCP56Time2a_destroy(it2);
+        cons[i] = test_HandleSet_accept(serverSocket);
+        TEST_ASSERT_NOT_NULL(cons[i]);
 
-    CS101_ASDU_encode(asdu, f);
+        Handleset_addSocket(handleSet, cons[i]);
+    }
 
-    TEST_ASSERT_EQUAL_INT(36, Frame_getMsgSize(f));
+    /* the last sockets are moved to the positions of the removed sockets */
+    Handleset_removeSocket(handleSet, cons[0]);
+    Handleset_removeSocket(handleSet, cons[2]);
 
-    CS101_ASDU_destroy(asdu);
+    Socket_write(clients[1], data, sizeof(data));
+    Socket_write(clients[4], data, sizeof(data));
+    Socket_write(clients[2], data, sizeof(data));
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    Thread_sleep(50);
 
-    TEST_ASSERT_EQUAL_INT(2, CS101_ASDU_getNumberOfElements(asdu2));
+    TEST_ASSERT_EQUAL_INT(2, Handleset_waitReady(handleSet, 1000));
 
-    IntegratedTotalsWithCP56Time2a it1_dec = (IntegratedTotalsWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
-    IntegratedTotalsWithCP56Time2a it2_dec = (IntegratedTotalsWithCP56Time2a) CS101_ASDU_getElement(asdu2, 1);
+    TEST_ASSERT_FALSE(Handleset_isReady(handleSet, cons[0]));
+    TEST_ASSERT_TRUE(Handleset_isReady(handleSet, cons[1]));
+    TEST_ASSERT_FALSE(Handleset_isReady(handleSet, cons[2]));
+    TEST_ASSERT_FALSE(Handleset_isReady(handleSet, cons[3]));
+    TEST_ASSERT_TRUE(Handleset_isReady(handleSet, cons[4]));
+    TEST_ASSERT_FALSE(Handleset_isReady(handleSet, cons[5]));
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )it1_dec));
-    TEST_ASSERT_EQUAL_INT32(INT32_MAX, BinaryCounterReading_getValue(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
-    TEST_ASSERT_EQUAL_UINT8(0, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
-    TEST_ASSERT_TRUE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR((IntegratedTotals )it1_dec)));
+    /* a removed socket can be added again */
+    Handleset_addSocket(handleSet, cons[2]);
 
-    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject )it2_dec));
-    TEST_ASSERT_EQUAL_INT32(INT32_MIN, BinaryCounterReading_getValue(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
-    TEST_ASSERT_EQUAL_UINT8(15, BinaryCounterReading_getSequenceNumber(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_hasCarry(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_isAdjusted(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
-    TEST_ASSERT_FALSE(BinaryCounterReading_isInvalid(IntegratedTotals_getBCR((IntegratedTotals )it2_dec)));
+    TEST_ASSERT_EQUAL_INT(3, Handleset_waitReady(handleSet, 1000));
+    TEST_ASSERT_TRUE(Handleset_isReady(handleSet, cons[2]));
+    TEST_ASSERT_TRUE(Handleset_isReady(handleSet, cons[4]));
+    TEST_ASSERT_FALSE(Handleset_isReady(handleSet, cons[5]));
 
-    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(IntegratedTotalsWithCP56Time2a_getTimestamp(it1_dec)));
-    TEST_ASSERT_EQUAL_UINT64(time2, CP56Time2a_toMsTimestamp(IntegratedTotalsWithCP56Time2a_getTimestamp(it2_dec)));
+    Handleset_destroy(handleSet);
 
-    IntegratedTotalsWithCP56Time2a_destroy(it1_dec);
-    IntegratedTotalsWithCP56Time2a_destroy(it2_dec);
+    for (i = 0; i < 6; i++) {
+        Socket_destroy(clients[i]);
+        Socket_destroy(cons[i]);
+    }
 
-    CS101_ASDU_destroy(asdu2);
+    ServerSocket_destroy(serverSocket);
 }
 
 void
-test_SingleCommand(void)
+test_SocketIoRingSendAndReceive(void)
 {
-    SingleCommand sc;
-    sc = SingleCommand_create(NULL, 101, true, true, 0);
+    uint8_t data[] = {0x68, 0x04, 0x07, 0x00, 0x00, 0x00};
 
-    TEST_ASSERT_TRUE(SingleCommand_getState(sc));
-    TEST_ASSERT_TRUE(SingleCommand_isSelect(sc));
-    TEST_ASSERT_EQUAL_INT(0, SingleCommand_getQU(sc));
+    /* the send and the receive area are part of the registered buffer */
+    static uint8_t buffer[512];
 
-    uint8_t buffer[256];
+    SocketIoRing ioRing = SocketIoRing_create(2);
 
-    struct sBufferFrame bf;
+    if (ioRing == NULL)
+        TEST_IGNORE_MESSAGE("io_uring not supported");
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    TEST_ASSERT_TRUE(SocketIoRing_registerBuffer(ioRing, buffer, sizeof(buffer)));
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+    ServerSocket serverSocket = TcpServerSocket_create("127.0.0.1", 20005);
+    TEST_ASSERT_NOT_NULL(serverSocket);
+    ServerSocket_listen(serverSocket);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) sc);
+    Socket client = TcpSocket_create();
+    TEST_ASSERT_TRUE(Socket_connect(client, "127.0.0.1", 20005));
 
-    SingleCommand_destroy(sc);
+    Socket con = test_HandleSet_accept(serverSocket);
+    TEST_ASSERT_NOT_NULL(con);
 
-    CS101_ASDU_encode(asdu, f);
+    memcpy(buffer, data, sizeof(data));
 
-    TEST_ASSERT_EQUAL_INT(10, Frame_getMsgSize(f));
+    int sendId = 1;
+    int receiveId = 2;
 
-    CS101_ASDU_destroy(asdu);
+    TEST_ASSERT_TRUE(SocketIoRing_prepareReceive(ioRing, con, buffer + 256, 256, &receiveId));
+    TEST_ASSERT_TRUE(SocketIoRing_prepareSend(ioRing, client, buffer, sizeof(data), &sendId));
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    int sent = -1;
+    int received = -1;
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+    uint64_t timeout = Hal_getTimeInMs() + 1000;
 
-    SingleCommand sc_dec = (SingleCommand) CS101_ASDU_getElement(asdu2, 0);
+    while (((sent == -1) || (received == -1)) && (Hal_getTimeInMs() < timeout)) {
+        void* userData;
+        int result;
+        bool isSend;
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )sc_dec));
+        TEST_ASSERT_TRUE(SocketIoRing_submitAndWait(ioRing, 10));
 
-    TEST_ASSERT_TRUE(SingleCommand_getState(sc_dec));
-    TEST_ASSERT_TRUE(SingleCommand_isSelect(sc_dec));
-    TEST_ASSERT_EQUAL_INT(0, SingleCommand_getQU(sc_dec));
+        while (SocketIoRing_getCompletion(ioRing, &userData, &result, &isSend)) {
+            if (userData == &sendId) {
+                TEST_ASSERT_TRUE(isSend);
+                sent = result;
+            }
+            else if (userData == &receiveId) {
+                TEST_ASSERT_FALSE(isSend);
+                received = result;
+            }
+        }
+    }
 
-    SingleCommand_destroy(sc_dec);
+    TEST_ASSERT_EQUAL_INT(sizeof(data), sent);
+    TEST_ASSERT_EQUAL_INT(sizeof(data), received);
+    TEST_ASSERT_EQUAL_MEMORY(data, buffer + 256, sizeof(data));
 
-    CS101_ASDU_destroy(asdu2);
+    /* a canceled receive is completed before the ring is destroyed */
+    TEST_ASSERT_TRUE(SocketIoRing_prepareReceive(ioRing, con, buffer + 256, 256, &receiveId));
+    TEST_ASSERT_TRUE(SocketIoRing_submit(ioRing));
+    SocketIoRing_cancel(ioRing, &receiveId);
+
+    SocketIoRing_destroy(ioRing);
+
+    Socket_destroy(client);
+    Socket_destroy(con);
+    ServerSocket_destroy(serverSocket);
 }
 
 void
-test_SingleCommandWithCP56Time2a(void)
+test_CS104_Slave_CreateDestroy(void)
 {
-    SingleCommandWithCP56Time2a sc;
+	CS104_Slave slave = CS104_Slave_create(100, 100);
 
-    uint64_t time1 = Hal_getTimeInMs();
+	TEST_ASSERT_NOT_NULL(slave);
 
-    struct sCP56Time2a cpTime1;
+	CS104_Slave_destroy(slave);
+}
 
-    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
+void
+test_CS104_Connection_CreateDestroy(void)
+{
+	CS104_Connection con = CS104_Connection_create("127.0.0.1", 2404);
 
-    sc = SingleCommandWithCP56Time2a_create(NULL, 101, true, true, 0, &cpTime1);
+	TEST_ASSERT_NOT_NULL(con);
 
-    TEST_ASSERT_TRUE(SingleCommand_getState((SingleCommand )sc));
-    TEST_ASSERT_TRUE(SingleCommand_isSelect((SingleCommand )sc));
-    TEST_ASSERT_EQUAL_INT(0, SingleCommand_getQU((SingleCommand )sc));
+	CS104_Connection_destroy(con);
+}
 
-    uint8_t buffer[256];
+void
+test_CS104_MasterSlave_CreateDestroy(void)
+{
+	CS104_Slave slave = CS104_Slave_create(100, 100);
 
-    struct sBufferFrame bf;
+	TEST_ASSERT_NOT_NULL(slave);
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+	CS104_Slave_setLocalPort(slave, 20004);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+	CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) sc);
+	TEST_ASSERT_NOT_NULL(con);
 
-    SingleCommandWithCP56Time2a_destroy(sc);
+	CS104_Connection_connect(con);
 
-    CS101_ASDU_encode(asdu, f);
+	CS104_Slave_destroy(slave);
 
-    TEST_ASSERT_EQUAL_INT(17, Frame_getMsgSize(f));
+	CS104_Connection_destroy(con);
+}
 
-    CS101_ASDU_destroy(asdu);
+void
+test_CS104_MasterSlave_CreateDestroyLoop(void)
+{
+	CS104_Slave slave = NULL;
+	CS104_Connection con = NULL;
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+	for (int i = 0; i < 1000; i++) {
+		slave = CS104_Slave_create(100, 100);
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+		TEST_ASSERT_NOT_NULL(slave);
 
-    SingleCommandWithCP56Time2a sc_dec = (SingleCommandWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
+		CS104_Slave_setLocalPort(slave, 20004);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )sc_dec));
+		CS104_Slave_start(slave);
 
-    TEST_ASSERT_TRUE(SingleCommand_getState((SingleCommand )sc_dec));
-    TEST_ASSERT_TRUE(SingleCommand_isSelect((SingleCommand )sc_dec));
-    TEST_ASSERT_EQUAL_INT(0, SingleCommand_getQU((SingleCommand )sc_dec));
-    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(SingleCommandWithCP56Time2a_getTimestamp(sc_dec)));
+		con = CS104_Connection_create("127.0.0.1", 20004);
 
-    SingleCommandWithCP56Time2a_destroy(sc_dec);
+		TEST_ASSERT_NOT_NULL(con);
 
-    CS101_ASDU_destroy(asdu2);
+		bool result = CS104_Connection_connect(con);
+
+		TEST_ASSERT_TRUE(result);
+
+		CS104_Slave_destroy(slave);
+
+		CS104_Connection_destroy(con);
+	}
 }
 
+
 void
-test_DoubleCommand(void)
+test_CS104_Connection_ConnectTimeout(void)
 {
-    DoubleCommand dc;
-    dc = DoubleCommand_create(NULL, 101, 1, true, 0);
+	CS104_Connection con = CS104_Connection_create("192.168.3.120", 2404);
 
-    TEST_ASSERT_TRUE(DoubleCommand_isSelect(dc));
-    TEST_ASSERT_EQUAL_INT(1, DoubleCommand_getState(dc));
-    TEST_ASSERT_EQUAL_INT(0, DoubleCommand_getQU(dc));
+	TEST_ASSERT_NOT_NULL(con);
 
-    uint8_t buffer[256];
+	bool result = CS104_Connection_connect(con);
 
-    struct sBufferFrame bf;
+	TEST_ASSERT_FALSE(result);
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+	CS104_Connection_destroy(con);
+}
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+void
+test_CS104_Connection_UseAfterClose(void)
+{
+    CS104_Slave slave = NULL;
+    CS104_Connection con = NULL;
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) dc);
+    slave = CS104_Slave_create(100, 100);
 
-    DoubleCommand_destroy(dc);
+    TEST_ASSERT_NOT_NULL(slave);
 
-    CS101_ASDU_encode(asdu, f);
+    CS104_Slave_setLocalPort(slave, 20004);
+    CS104_Slave_start(slave);
 
-    TEST_ASSERT_EQUAL_INT(10, Frame_getMsgSize(f));
+    con = CS104_Connection_create("127.0.0.1", 20004);
 
-    CS101_ASDU_destroy(asdu);
+    TEST_ASSERT_NOT_NULL(con);
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    bool result = CS104_Connection_connect(con);
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+    TEST_ASSERT_TRUE(result);
 
-    DoubleCommand dc_dec = (DoubleCommand) CS101_ASDU_getElement(asdu2, 0);
+    CS104_Connection_close(con);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )dc_dec));
+    result = CS104_Connection_sendInterrogationCommand(con, CS101_COT_ACTIVATION, 1, IEC60870_QOI_STATION);
 
-    TEST_ASSERT_TRUE(DoubleCommand_isSelect(dc_dec));
-    TEST_ASSERT_EQUAL_INT(1, DoubleCommand_getState(dc_dec));
-    TEST_ASSERT_EQUAL_INT(0, DoubleCommand_getQU(dc_dec));
+    TEST_ASSERT_FALSE(result);
 
-    DoubleCommand_destroy(dc_dec);
+    CS104_Slave_destroy(slave);
 
-    CS101_ASDU_destroy(asdu2);
+    CS104_Connection_destroy(con);
 }
 
 void
-test_DoubleCommandWithCP56Time2a(void)
+test_CS104_Connection_UseAfterServerClosedConnection(void)
 {
-    DoubleCommandWithCP56Time2a dc;
+    CS104_Slave slave = NULL;
+    CS104_Connection con = NULL;
 
-    uint64_t time1 = Hal_getTimeInMs();
-    struct sCP56Time2a cpTime1;
-    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
+    slave = CS104_Slave_create(100, 100);
 
-    dc = DoubleCommandWithCP56Time2a_create(NULL, 101, 1, true, 0, &cpTime1);
+    TEST_ASSERT_NOT_NULL(slave);
 
-    TEST_ASSERT_TRUE(DoubleCommandWithCP56Time2a_isSelect(dc));
-    TEST_ASSERT_EQUAL_INT(1, DoubleCommandWithCP56Time2a_getState(dc));
-    TEST_ASSERT_EQUAL_INT(0, DoubleCommandWithCP56Time2a_getQU(dc));
+    CS104_Slave_setLocalPort(slave, 20004);
+    CS104_Slave_start(slave);
 
-    uint8_t buffer[256];
+    con = CS104_Connection_create("127.0.0.1", 20004);
 
-    struct sBufferFrame bf;
+    TEST_ASSERT_NOT_NULL(con);
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    bool result = CS104_Connection_connect(con);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+    TEST_ASSERT_TRUE(result);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) dc);
+    CS104_Slave_destroy(slave);
 
-    DoubleCommandWithCP56Time2a_destroy(dc);
+    /* wait to allow client side to detect connection loss */
+    Thread_sleep(500);
 
-    CS101_ASDU_encode(asdu, f);
+    result = CS104_Connection_sendInterrogationCommand(con, CS101_COT_ACTIVATION, 1, IEC60870_QOI_STATION);
 
-    TEST_ASSERT_EQUAL_INT(17, Frame_getMsgSize(f));
+    TEST_ASSERT_FALSE(result);
 
-    CS101_ASDU_destroy(asdu);
+    CS104_Connection_destroy(con);
+}
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+struct sFileTransferTestContext
+{
+    uint8_t* receivedData;
+    uint32_t receivedSize;
+    CS101_FileTransferState state;
+    int progressEvents;
+};
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+static bool
+fileServiceWriteHandler(void* parameter, uint32_t offset, const uint8_t* data, int size)
+{
+    struct sFileTransferTestContext* context = (struct sFileTransferTestContext*) parameter;
+
+    memcpy(context->receivedData + offset, data, size);
+
+    if (offset + size > context->receivedSize)
+        context->receivedSize = offset + size;
+
+    return true;
+}
+
+static int
+fileServiceReadHandler(void* parameter, uint32_t offset, uint8_t* buffer, int size)
+{
+    memcpy(buffer, (uint8_t*) parameter + offset, size);
+
+    return size;
+}
+
+static void
+fileServiceProgressHandler(void* parameter, int ca, int ioa, uint16_t nof, CS101_FileTransferState state,
+        uint32_t transferredBytes, uint32_t lengthOfFile)
+{
+    struct sFileTransferTestContext* context = (struct sFileTransferTestContext*) parameter;
+
+    (void)ca;
+    (void)ioa;
+    (void)nof;
+    (void)transferredBytes;
+    (void)lengthOfFile;
+
+    context->state = state;
+    context->progressEvents++;
+}
 
-    DoubleCommandWithCP56Time2a dc_dec = (DoubleCommandWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
+static bool
+fileServiceASDUReceivedHandler(void* parameter, int address, CS101_ASDU asdu)
+{
+    (void)address;
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )dc_dec));
+    return CS101_FileClient_handleASDU((CS101_FileClient) parameter, asdu);
+}
 
-    TEST_ASSERT_TRUE(DoubleCommandWithCP56Time2a_isSelect(dc_dec));
-    TEST_ASSERT_EQUAL_INT(1, DoubleCommandWithCP56Time2a_getState(dc_dec));
-    TEST_ASSERT_EQUAL_INT(0, DoubleCommandWithCP56Time2a_getQU(dc_dec));
-    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(DoubleCommandWithCP56Time2a_getTimestamp(dc_dec)));
+static bool
+waitForFileTransfer(CS101_FileClient client)
+{
+    uint64_t timeout = Hal_getTimeInMs() + 10000;
 
-    DoubleCommandWithCP56Time2a_destroy(dc_dec);
+    while (CS101_FileClient_isBusy(client) && (Hal_getTimeInMs() < timeout)) {
+        CS101_FileClient_run(client);
+        Thread_sleep(5);
+    }
 
-    CS101_ASDU_destroy(asdu2);
+    return (CS101_FileClient_isBusy(client) == false);
 }
 
 void
-test_StepCommandValue(void)
+test_CS104_FileService_TransferFiles(void)
 {
-    StepCommand scv;
-    scv = StepCommand_create(NULL, 101, IEC60870_STEP_INVALID_0, true, 0);
+    uint32_t fileSize = 100000;
 
-    TEST_ASSERT_TRUE(StepCommand_isSelect(scv));
-    TEST_ASSERT_EQUAL_INT(IEC60870_STEP_INVALID_0, StepCommand_getState(scv));
-    TEST_ASSERT_EQUAL_INT(0, StepCommand_getQU(scv));
+    uint8_t* fileData = (uint8_t*) malloc(fileSize);
+    uint8_t* receivedData = (uint8_t*) calloc(1, fileSize);
 
-    uint8_t buffer[256];
+    uint32_t i;
 
-    struct sBufferFrame bf;
+    for (i = 0; i < fileSize; i++)
+        fileData[i] = (uint8_t) ((i * 7) + (i >> 8));
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    CS101_FileServer fileServer = CS101_FileServer_create();
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+    /* multiple sections */
+    CS101_FileServer_setSectionSize(fileServer, 8192);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) scv);
+    TEST_ASSERT_TRUE(CS101_FileServer_addFile(fileServer, 1, 1000, CS101_NOF_TRANSPARENT_FILE, fileData, fileSize));
+    TEST_ASSERT_TRUE(CS101_FileServer_addFileWithReader(fileServer, 1, 1001, CS101_NOF_TRANSPARENT_FILE, fileSize - 1000,
+            fileServiceReadHandler, fileData + 1000));
+    TEST_ASSERT_FALSE(CS101_FileServer_addFile(fileServer, 1, 1000, CS101_NOF_TRANSPARENT_FILE, fileData, fileSize));
 
-    StepCommand_destroy(scv);
+    struct sFileTransferTestContext serverContext;
+    memset(&serverContext, 0, sizeof(serverContext));
 
-    CS101_ASDU_encode(asdu, f);
+    CS101_FileServer_setProgressHandler(fileServer, fileServiceProgressHandler, &serverContext);
 
-    TEST_ASSERT_EQUAL_INT(10, Frame_getMsgSize(f));
+    CS104_Slave slave = CS104_Slave_create(100, 100);
 
-    CS101_ASDU_destroy(asdu);
+    TEST_ASSERT_NOT_NULL(slave);
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    CS104_Slave_addPlugin(slave, CS101_FileServer_getSlavePlugin(fileServer));
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+    CS104_Slave_setLocalPort(slave, 20004);
+    CS104_Slave_start(slave);
 
-    StepCommand scv_dec = (StepCommand) CS101_ASDU_getElement(asdu2, 0);
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )scv_dec));
+    CS101_FileClient client = CS101_FileClient_createForCS104Connection(con);
 
-    TEST_ASSERT_TRUE(StepCommand_isSelect(scv_dec));
-    TEST_ASSERT_EQUAL_INT(IEC60870_STEP_INVALID_0, StepCommand_getState(scv_dec));
-    TEST_ASSERT_EQUAL_INT(0, StepCommand_getQU(scv_dec));
+    struct sFileTransferTestContext clientContext;
+    memset(&clientContext, 0, sizeof(clientContext));
+    clientContext.receivedData = receivedData;
 
-    StepCommand_destroy(scv_dec);
+    CS101_FileClient_setProgressHandler(client, fileServiceProgressHandler, &clientContext);
 
-    CS101_ASDU_destroy(asdu2);
-}
+    CS104_Connection_setASDUReceivedHandler(con, fileServiceASDUReceivedHandler, client);
 
-void
-test_StepCommandWithCP56Time2a(void)
-{
-    StepCommandWithCP56Time2a scv;
-    uint64_t time1 = Hal_getTimeInMs();
-    struct sCP56Time2a cpTime1;
-    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con));
 
-    scv = StepCommandWithCP56Time2a_create(NULL, 101, IEC60870_STEP_INVALID_0, true, 0, &cpTime1);
+    CS104_Connection_sendStartDT(con);
 
-    TEST_ASSERT_TRUE(StepCommandWithCP56Time2a_isSelect(scv));
-    TEST_ASSERT_EQUAL_INT(IEC60870_STEP_INVALID_0, StepCommandWithCP56Time2a_getState(scv));
-    TEST_ASSERT_EQUAL_INT(0, StepCommandWithCP56Time2a_getQU(scv));
+    Thread_sleep(100);
 
-    uint8_t buffer[256];
+    /* file in memory */
+    TEST_ASSERT_TRUE(CS101_FileClient_getFile(client, 1, 1000, CS101_NOF_TRANSPARENT_FILE, fileServiceWriteHandler, &clientContext));
+    TEST_ASSERT_FALSE(CS101_FileClient_getFile(client, 1, 1001, CS101_NOF_TRANSPARENT_FILE, fileServiceWriteHandler, &clientContext));
 
-    struct sBufferFrame bf;
+    TEST_ASSERT_TRUE(waitForFileTransfer(client));
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    TEST_ASSERT_EQUAL_INT(CS101_FILE_TRANSFER_SUCCESS, clientContext.state);
+    TEST_ASSERT_EQUAL_UINT32(fileSize, clientContext.receivedSize);
+    TEST_ASSERT_EQUAL_MEMORY(fileData, receivedData, fileSize);
+    TEST_ASSERT_TRUE(clientContext.progressEvents > 400);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+    Thread_sleep(100);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) scv);
+    TEST_ASSERT_EQUAL_INT(CS101_FILE_TRANSFER_SUCCESS, serverContext.state);
 
-    StepCommandWithCP56Time2a_destroy((StepCommandWithCP56Time2a) scv);
+    /* file with read handler */
+    memset(receivedData, 0, fileSize);
+    clientContext.receivedSize = 0;
 
-    CS101_ASDU_encode(asdu, f);
+    TEST_ASSERT_TRUE(CS101_FileClient_getFile(client, 1, 1001, CS101_NOF_TRANSPARENT_FILE, fileServiceWriteHandler, &clientContext));
 
-    TEST_ASSERT_EQUAL_INT(17, Frame_getMsgSize(f));
+    TEST_ASSERT_TRUE(waitForFileTransfer(client));
 
-    CS101_ASDU_destroy(asdu);
+    TEST_ASSERT_EQUAL_INT(CS101_FILE_TRANSFER_SUCCESS, clientContext.state);
+    TEST_ASSERT_EQUAL_UINT32(fileSize - 1000, clientContext.receivedSize);
+    TEST_ASSERT_EQUAL_MEMORY(fileData + 1000, receivedData, fileSize - 1000);
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    /* unknown file */
+    TEST_ASSERT_TRUE(CS101_FileClient_getFile(client, 1, 1002, CS101_NOF_TRANSPARENT_FILE, fileServiceWriteHandler, &clientContext));
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+    TEST_ASSERT_TRUE(waitForFileTransfer(client));
 
-    StepCommandWithCP56Time2a scv_dec = (StepCommandWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
+    TEST_ASSERT_EQUAL_INT(CS101_FILE_TRANSFER_FAILED, clientContext.state);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )scv_dec));
+    CS104_Connection_destroy(con);
+    CS101_FileClient_destroy(client);
 
-    TEST_ASSERT_TRUE(StepCommandWithCP56Time2a_isSelect(scv_dec));
-    TEST_ASSERT_EQUAL_INT(IEC60870_STEP_INVALID_0, StepCommandWithCP56Time2a_getState(scv_dec));
-    TEST_ASSERT_EQUAL_INT(0, StepCommandWithCP56Time2a_getQU(scv_dec));
-    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(StepCommandWithCP56Time2a_getTimestamp(scv_dec)));
+    CS104_Slave_stop(slave);
+    CS104_Slave_destroy(slave);
 
-    StepCommandWithCP56Time2a_destroy((StepCommandWithCP56Time2a) scv_dec);
+    CS101_FileServer_destroy(fileServer);
 
-    CS101_ASDU_destroy(asdu2);
+    free(receivedData);
+    free(fileData);
 }
 
-void
-test_SetpointCommandNormalized(void)
+struct sProcessImageTestContext
 {
-    SetpointCommandNormalized spcn;
-    spcn = SetpointCommandNormalized_create(NULL, 101, -1, true, 0);
+    int interrogatedPoints;
+    int interrogationASDUs;
+    int actCon;
+    int actTerm;
+    int spontaneousEvents;
+    int lastEventIoa;
+    int readIoa;
+    float readValue;
+};
 
-    TEST_ASSERT_EQUAL_INT(-1, SetpointCommandNormalized_getValue(spcn));
-    TEST_ASSERT_EQUAL_INT(0, SetpointCommandNormalized_getQL(spcn));
-    TEST_ASSERT_TRUE(SetpointCommandNormalized_isSelect(spcn));
+static bool
+processImageASDUReceivedHandler(void* parameter, int address, CS101_ASDU asdu)
+{
+    struct sProcessImageTestContext* context = (struct sProcessImageTestContext*) parameter;
 
-    uint8_t buffer[256];
+    (void)address;
 
-    struct sBufferFrame bf;
+    CS101_CauseOfTransmission cot = CS101_ASDU_getCOT(asdu);
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    if (CS101_ASDU_getTypeID(asdu) == C_IC_NA_1) {
+        if (cot == CS101_COT_ACTIVATION_CON)
+            context->actCon++;
+        else if (cot == CS101_COT_ACTIVATION_TERMINATION)
+            context->actTerm++;
+    }
+    else if ((cot >= CS101_COT_INTERROGATED_BY_STATION) && (cot <= CS101_COT_INTERROGATED_BY_GROUP_16)) {
+        context->interrogatedPoints += CS101_ASDU_getNumberOfElements(asdu);
+        context->interrogationASDUs++;
+    }
+    else if (cot == CS101_COT_SPONTANEOUS) {
+        InformationObject io = CS101_ASDU_getElement(asdu, 0);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+        context->spontaneousEvents++;
+        context->lastEventIoa = InformationObject_getObjectAddress(io);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) spcn);
+        InformationObject_destroy(io);
+    }
+    else if ((cot == CS101_COT_REQUEST) && (CS101_ASDU_getTypeID(asdu) == M_ME_NC_1)) {
+        InformationObject io = CS101_ASDU_getElement(asdu, 0);
 
-    SetpointCommandNormalized_destroy(spcn);
+        context->readIoa = InformationObject_getObjectAddress(io);
+        context->readValue = MeasuredValueShort_getValue((MeasuredValueShort) io);
 
-    CS101_ASDU_encode(asdu, f);
+        InformationObject_destroy(io);
+    }
 
-    TEST_ASSERT_EQUAL_INT(12, Frame_getMsgSize(f));
+    return true;
+}
 
-    CS101_ASDU_destroy(asdu);
+static bool
+waitForInterrogation(struct sProcessImageTestContext* context, int actTerm)
+{
+    uint64_t timeout = Hal_getTimeInMs() + 10000;
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    while ((context->actTerm < actTerm) && (Hal_getTimeInMs() < timeout))
+        Thread_sleep(5);
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+    return (context->actTerm == actTerm);
+}
 
-    SetpointCommandNormalized spcn_dec = (SetpointCommandNormalized) CS101_ASDU_getElement(asdu2, 0);
+/* start the slave, connect a client and run a station interrogation */
+static CS104_Connection
+startSlaveAndInterrogate(CS104_Slave slave, struct sProcessImageTestContext* context)
+{
+    CS104_Slave_setLocalPort(slave, 20004);
+    CS104_Slave_start(slave);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )spcn_dec));
+    memset(context, 0, sizeof(struct sProcessImageTestContext));
 
-    TEST_ASSERT_EQUAL_INT(-1, SetpointCommandNormalized_getValue(spcn_dec));
-    TEST_ASSERT_EQUAL_INT(0, SetpointCommandNormalized_getQL(spcn_dec));
-    TEST_ASSERT_TRUE(SetpointCommandNormalized_isSelect(spcn_dec));
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
 
-    SetpointCommandNormalized_destroy(spcn_dec);
+    CS104_Connection_setASDUReceivedHandler(con, processImageASDUReceivedHandler, context);
 
-    CS101_ASDU_destroy(asdu2);
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con));
+
+    CS104_Connection_sendStartDT(con);
+
+    Thread_sleep(100);
+
+    CS104_Connection_sendInterrogationCommand(con, CS101_COT_ACTIVATION, 1, IEC60870_QOI_STATION);
+
+    TEST_ASSERT_TRUE(waitForInterrogation(context, 1));
+
+    return con;
 }
 
 void
-test_SetpointCommandNormalizedWithCP56Time2a(void)
+test_CS104_ProcessImage_InterrogationAndEvents(void)
 {
-    SetpointCommandNormalizedWithCP56Time2a spcn;
-    uint64_t time1 = Hal_getTimeInMs();
-    struct sCP56Time2a cpTime1;
-    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(1);
 
-    spcn = SetpointCommandNormalizedWithCP56Time2a_create(NULL, 101, 0, true, 0, &cpTime1);
+    /* group 1 */
+    TEST_ASSERT_TRUE(CS101_ProcessImage_addPoints(processImage, M_SP_NA_1, 1, 100000, 0x0001));
+    /* group 2 (measured values and double points are stored in other tables than the single points) */
+    TEST_ASSERT_TRUE(CS101_ProcessImage_addPoints(processImage, M_ME_NC_1, 200001, 1000, 0x0002));
+    TEST_ASSERT_TRUE(CS101_ProcessImage_addPoints(processImage, M_DP_NA_1, 150001, 10, 0x0002));
 
-    TEST_ASSERT_EQUAL_INT(0, SetpointCommandNormalizedWithCP56Time2a_getValue(spcn));
-    TEST_ASSERT_EQUAL_INT(0, SetpointCommandNormalizedWithCP56Time2a_getQL(spcn));
-    TEST_ASSERT_TRUE(SetpointCommandNormalizedWithCP56Time2a_isSelect(spcn));
+    /* IOA already used */
+    TEST_ASSERT_FALSE(CS101_ProcessImage_addPoints(processImage, M_DP_NA_1, 99999, 10, 0x0002));
+    /* unsupported type */
+    TEST_ASSERT_FALSE(CS101_ProcessImage_addPoints(processImage, C_SC_NA_1, 300000, 1, 0x0001));
 
-    uint8_t buffer[256];
+    TEST_ASSERT_EQUAL_INT(101010, CS101_ProcessImage_getNumberOfPoints(processImage));
 
-    struct sBufferFrame bf;
+    CS104_Slave slave = CS104_Slave_create(100, 100);
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    TEST_ASSERT_NOT_NULL(slave);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+    CS101_ProcessImage_attachToCS104Slave(processImage, slave);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) spcn);
+    struct sProcessImageTestContext context;
 
-    SetpointCommandNormalizedWithCP56Time2a_destroy(spcn);
+    /* station interrogation */
+    CS104_Connection con = startSlaveAndInterrogate(slave, &context);
 
-    CS101_ASDU_encode(asdu, f);
+    TEST_ASSERT_EQUAL_INT(1, context.actCon);
+    TEST_ASSERT_EQUAL_INT(101010, context.interrogatedPoints);
 
-    TEST_ASSERT_EQUAL_INT(19, Frame_getMsgSize(f));
+    /* consecutive IOAs are packed into sequence ASDUs */
+    TEST_ASSERT_TRUE(context.interrogationASDUs < 2000);
 
-    CS101_ASDU_destroy(asdu);
+    /* group interrogation */
+    context.interrogatedPoints = 0;
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    CS104_Connection_sendInterrogationCommand(con, CS101_COT_ACTIVATION, 1, IEC60870_QOI_GROUP_2);
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+    TEST_ASSERT_TRUE(waitForInterrogation(&context, 2));
 
-    SetpointCommandNormalizedWithCP56Time2a spcn_dec = (SetpointCommandNormalizedWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
+    TEST_ASSERT_EQUAL_INT(1010, context.interrogatedPoints);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )spcn_dec));
+    /* spontaneous events only when the value changes */
+    TEST_ASSERT_TRUE(CS101_ProcessImage_updateMeasuredValueShort(processImage, 200010, 12.5f, IEC60870_QUALITY_GOOD, NULL));
+    TEST_ASSERT_TRUE(CS101_ProcessImage_updateMeasuredValueShort(processImage, 200010, 12.5f, IEC60870_QUALITY_GOOD, NULL));
+    TEST_ASSERT_TRUE(CS101_ProcessImage_updateSinglePoint(processImage, 500, true, IEC60870_QUALITY_GOOD, NULL));
+    TEST_ASSERT_FALSE(CS101_ProcessImage_updateSinglePoint(processImage, 200010, true, IEC60870_QUALITY_GOOD, NULL));
 
-    TEST_ASSERT_EQUAL_INT(0, SetpointCommandNormalizedWithCP56Time2a_getValue(spcn_dec));
-    TEST_ASSERT_EQUAL_INT(0, SetpointCommandNormalizedWithCP56Time2a_getQL(spcn_dec));
-    TEST_ASSERT_TRUE(SetpointCommandNormalizedWithCP56Time2a_isSelect(spcn_dec));
-    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(SetpointCommandNormalizedWithCP56Time2a_getTimestamp(spcn_dec)));
+    /* read command */
+    CS104_Connection_sendReadCommand(con, 1, 200010);
 
-    SetpointCommandNormalizedWithCP56Time2a_destroy(spcn_dec);
+    Thread_sleep(500);
 
-    CS101_ASDU_destroy(asdu2);
+    TEST_ASSERT_EQUAL_INT(2, context.spontaneousEvents);
+    TEST_ASSERT_EQUAL_INT(500, context.lastEventIoa);
+    TEST_ASSERT_EQUAL_INT(200010, context.readIoa);
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, context.readValue);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_stop(slave);
+    CS104_Slave_destroy(slave);
+
+    CS101_ProcessImage_destroy(processImage);
 }
 
 void
-test_SetpointCommandScaled(void)
+test_CS104_ProcessImage_ConnectionClosedDuringInterrogation(void)
 {
-    SetpointCommandScaled spcs;
-    spcs = SetpointCommandScaled_create(NULL, 101, -32768, true, 0);
+    /* STARTDT_ACT and station interrogation (I frame 0) */
+    uint8_t startDt[] = { 0x68, 0x04, 0x07, 0x00, 0x00, 0x00 };
+    uint8_t interrogation[] = { 0x68, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x64, 0x01, 0x06, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x14 };
 
-    TEST_ASSERT_EQUAL_INT(-32768, SetpointCommandScaled_getValue(spcs));
-    TEST_ASSERT_EQUAL_INT(0, SetpointCommandScaled_getQL(spcs));
-    TEST_ASSERT_TRUE(SetpointCommandScaled_isSelect(spcs));
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(1);
 
-    uint8_t buffer[256];
+    TEST_ASSERT_TRUE(CS101_ProcessImage_addPoints(processImage, M_SP_NA_1, 1, 100000, 0x0001));
 
-    struct sBufferFrame bf;
+    CS104_Slave slave = CS104_Slave_create(10, 10);
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    CS101_ProcessImage_attachToCS104Slave(processImage, slave);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+    CS104_Slave_setLocalPort(slave, 20004);
+    CS104_Slave_start(slave);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) spcs);
+    /* the first client never confirms the I frames -> the interrogation stops when the k window is full */
+    Socket socket = TcpSocket_create();
 
-    SetpointCommandScaled_destroy(spcs);
+    TEST_ASSERT_TRUE(Socket_connect(socket, "127.0.0.1", 20004));
 
-    CS101_ASDU_encode(asdu, f);
+    TEST_ASSERT_EQUAL_INT(sizeof(startDt), Socket_write(socket, startDt, sizeof(startDt)));
+    TEST_ASSERT_EQUAL_INT(sizeof(interrogation), Socket_write(socket, interrogation, sizeof(interrogation)));
 
-    TEST_ASSERT_EQUAL_INT(12, Frame_getMsgSize(f));
+    Thread_sleep(200);
 
-    CS101_ASDU_destroy(asdu);
+    Socket_destroy(socket);
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    Thread_sleep(200);
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+    TEST_ASSERT_EQUAL_INT(0, CS104_Slave_getOpenConnections(slave));
 
-    SetpointCommandScaled spcs_dec = (SetpointCommandScaled) CS101_ASDU_getElement(asdu2, 0);
+    /* the second client gets the connection object of the first client */
+    struct sProcessImageTestContext context;
+    memset(&context, 0, sizeof(context));
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )spcs_dec));
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
 
-    TEST_ASSERT_EQUAL_INT(-32768, SetpointCommandScaled_getValue(spcs_dec));
-    TEST_ASSERT_EQUAL_INT(0, SetpointCommandScaled_getQL(spcs_dec));
-    TEST_ASSERT_TRUE(SetpointCommandScaled_isSelect(spcs_dec));
+    CS104_Connection_setASDUReceivedHandler(con, processImageASDUReceivedHandler, &context);
 
-    SetpointCommandScaled_destroy(spcs_dec);
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con));
 
-    CS101_ASDU_destroy(asdu2);
+    CS104_Connection_sendStartDT(con);
+
+    Thread_sleep(500);
+
+    /* the interrogation of the first client is not continued */
+    TEST_ASSERT_EQUAL_INT(0, context.interrogatedPoints);
+    TEST_ASSERT_EQUAL_INT(0, context.actTerm);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_stop(slave);
+    CS104_Slave_destroy(slave);
+
+    CS101_ProcessImage_destroy(processImage);
 }
 
-void
-test_SetpointCommandScaledWithCP56Time2a(void)
+#define INTERROGATION_STREAM_POINTS 100000
+
+static bool
+interrogationStreamHandler(void* parameter, IMasterConnection connection, uint8_t qoi, uint32_t* position, CS101_ASDU asdu)
 {
-    SetpointCommandScaledWithCP56Time2a spcs;
+    int* handlerCalls = (int*) parameter;
 
-    uint64_t time1 = Hal_getTimeInMs();
-    struct sCP56Time2a cpTime1;
-    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
+    (void)connection;
 
-    spcs = SetpointCommandScaledWithCP56Time2a_create(NULL, 101, -32768, true, 0, &cpTime1);
+    (*handlerCalls)++;
 
-    TEST_ASSERT_EQUAL_INT(-32768, SetpointCommandScaledWithCP56Time2a_getValue(spcs));
-    TEST_ASSERT_EQUAL_INT(0, SetpointCommandScaledWithCP56Time2a_getQL(spcs));
-    TEST_ASSERT_TRUE(SetpointCommandScaledWithCP56Time2a_isSelect(spcs));
+    /* only the station interrogation has points */
+    if (qoi != IEC60870_QOI_STATION)
+        return false;
 
-    uint8_t buffer[256];
+    CS101_ASDU_setSequence(asdu, true);
 
-    struct sBufferFrame bf;
+    while (*position < INTERROGATION_STREAM_POINTS) {
+        struct sSinglePointInformation _sp;
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+        InformationObject io = (InformationObject) SinglePointInformation_create(&_sp, (int) *position + 1, true, IEC60870_QUALITY_GOOD);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+        if (CS101_ASDU_addInformationObject(asdu, io) == false)
+            return true; /* ASDU is full */
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) spcs);
+        (*position)++;
+    }
 
-    SetpointCommandScaledWithCP56Time2a_destroy(spcs);
+    return false;
+}
 
-    CS101_ASDU_encode(asdu, f);
+void
+test_CS104_Slave_InterrogationStream(void)
+{
+    int handlerCalls = 0;
 
-    TEST_ASSERT_EQUAL_INT(19, Frame_getMsgSize(f));
+    /* the response is much larger than the high priority queue */
+    CS104_Slave slave = CS104_Slave_create(10, 10);
 
-    CS101_ASDU_destroy(asdu);
+    TEST_ASSERT_NOT_NULL(slave);
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    CS104_Slave_setInterrogationStreamHandler(slave, interrogationStreamHandler, &handlerCalls);
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+    struct sProcessImageTestContext context;
 
-    SetpointCommandScaledWithCP56Time2a spcs_dec = (SetpointCommandScaledWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
+    CS104_Connection con = startSlaveAndInterrogate(slave, &context);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )spcs_dec));
+    /* nothing is dropped and ACT_TERM is the last message */
+    TEST_ASSERT_EQUAL_INT(1, context.actCon);
+    TEST_ASSERT_EQUAL_INT(INTERROGATION_STREAM_POINTS, context.interrogatedPoints);
+    TEST_ASSERT_EQUAL_INT(context.interrogationASDUs, handlerCalls);
 
-    TEST_ASSERT_EQUAL_INT(-32768, SetpointCommandScaledWithCP56Time2a_getValue(spcs_dec));
-    TEST_ASSERT_EQUAL_INT(0, SetpointCommandScaledWithCP56Time2a_getQL(spcs_dec));
-    TEST_ASSERT_TRUE(SetpointCommandScaledWithCP56Time2a_isSelect(spcs_dec));
-    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(SetpointCommandScaledWithCP56Time2a_getTimestamp(spcs_dec)));
+    /* empty group */
+    context.interrogatedPoints = 0;
 
-    SetpointCommandScaledWithCP56Time2a_destroy(spcs_dec);
+    CS104_Connection_sendInterrogationCommand(con, CS101_COT_ACTIVATION, 1, IEC60870_QOI_GROUP_3);
 
-    CS101_ASDU_destroy(asdu2);
+    TEST_ASSERT_TRUE(waitForInterrogation(&context, 2));
+
+    TEST_ASSERT_EQUAL_INT(2, context.actCon);
+    TEST_ASSERT_EQUAL_INT(0, context.interrogatedPoints);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_stop(slave);
+    CS104_Slave_destroy(slave);
 }
 
-void
-test_SetpointCommandShort(void)
+struct sWindowOpenTestContext
 {
-    SetpointCommandShort spcs;
-    spcs = SetpointCommandShort_create(NULL, 101, 10.5f, true, 0);
+    int asdusToSend;
+    int sentAsdus;
+    int initialFreeWindowSlots;
+    int initialFreeQueueBytes;
+    int windowOpenEvents;
+};
 
-    TEST_ASSERT_EQUAL_FLOAT(10.5f, SetpointCommandShort_getValue(spcs));
-    TEST_ASSERT_EQUAL_INT(0, SetpointCommandShort_getQL(spcs));
-    TEST_ASSERT_TRUE(SetpointCommandShort_isSelect(spcs));
+/* send the next part of the response without storing ASDUs in the queue */
+static void
+windowOpenTestSendAsdus(struct sWindowOpenTestContext* context, IMasterConnection connection, int freeWindowSlots)
+{
+    while ((freeWindowSlots > 0) && (context->sentAsdus < context->asdusToSend)) {
+        sCS101_StaticASDU _asdu;
+
+        CS101_ASDU asdu = CS101_ASDU_initializeStatic(&_asdu, IMasterConnection_getApplicationLayerParameters(connection),
+                false, CS101_COT_INTERROGATED_BY_STATION, 0, 1, false, false);
+
+        struct sMeasuredValueScaled _io;
+
+        CS101_ASDU_addInformationObject(asdu, (InformationObject) MeasuredValueScaled_create(&_io, 100 + context->sentAsdus, 1, IEC60870_QUALITY_GOOD));
+
+        IMasterConnection_sendASDU(connection, asdu);
 
-    uint8_t buffer[256];
+        context->sentAsdus++;
+        freeWindowSlots--;
 
-    struct sBufferFrame bf;
+        if (context->sentAsdus == context->asdusToSend) {
+            CS101_ASDU_removeAllElements(asdu);
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+            struct sInterrogationCommand _ic;
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+            CS101_ASDU_addInformationObject(asdu, (InformationObject) InterrogationCommand_create(&_ic, 0, IEC60870_QOI_STATION));
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) spcs);
+            IMasterConnection_sendACT_TERM(connection, asdu);
+        }
+    }
+}
 
-    SetpointCommandShort_destroy(spcs);
+static bool
+windowOpenTestInterrogationHandler(void* parameter, IMasterConnection connection, CS101_ASDU asdu, uint8_t qoi)
+{
+    struct sWindowOpenTestContext* context = (struct sWindowOpenTestContext*) parameter;
 
-    CS101_ASDU_encode(asdu, f);
+    (void)qoi;
 
-    TEST_ASSERT_EQUAL_INT(14, Frame_getMsgSize(f));
+    IMasterConnection_sendACT_CON(connection, asdu, false);
 
-    CS101_ASDU_destroy(asdu);
+    int freeWindowSlots;
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    IMasterConnection_isReadyEx(connection, &freeWindowSlots, &(context->initialFreeQueueBytes));
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+    context->initialFreeWindowSlots = freeWindowSlots;
 
-    SetpointCommandShort spcs_dec = (SetpointCommandShort) CS101_ASDU_getElement(asdu2, 0);
+    windowOpenTestSendAsdus(context, connection, freeWindowSlots);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )spcs_dec));
+    return true;
+}
 
-    TEST_ASSERT_EQUAL_FLOAT(10.5f, SetpointCommandShort_getValue(spcs_dec));
-    TEST_ASSERT_EQUAL_INT(0, SetpointCommandShort_getQL(spcs_dec));
-    TEST_ASSERT_TRUE(SetpointCommandShort_isSelect(spcs_dec));
+static void
+windowOpenTestWindowOpenHandler(void* parameter, IMasterConnection connection, int freeWindowSlots)
+{
+    struct sWindowOpenTestContext* context = (struct sWindowOpenTestContext*) parameter;
 
-    SetpointCommandShort_destroy(spcs_dec);
+    context->windowOpenEvents++;
 
-    CS101_ASDU_destroy(asdu2);
+    windowOpenTestSendAsdus(context, connection, freeWindowSlots);
 }
 
 void
-test_SetpointCommandShortWithCP56Time2a(void)
+test_CS104_Slave_WindowOpenHandler(void)
 {
-    SetpointCommandShortWithCP56Time2a spcs;
-    uint64_t time1 = Hal_getTimeInMs();
-    struct sCP56Time2a cpTime1;
-    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
-
-    spcs = SetpointCommandShortWithCP56Time2a_create(NULL, 101, 10.5f, true, 0, &cpTime1);
+    struct sWindowOpenTestContext handlerContext;
+    memset(&handlerContext, 0, sizeof(handlerContext));
 
-    TEST_ASSERT_EQUAL_FLOAT(10.5f, SetpointCommandShortWithCP56Time2a_getValue(spcs));
-    TEST_ASSERT_EQUAL_INT(0, SetpointCommandShortWithCP56Time2a_getQL(spcs));
-    TEST_ASSERT_TRUE(SetpointCommandShortWithCP56Time2a_isSelect(spcs));
+    handlerContext.asdusToSend = 1000;
 
-    uint8_t buffer[256];
+    CS104_Slave slave = CS104_Slave_create(10, 10);
 
-    struct sBufferFrame bf;
+    TEST_ASSERT_NOT_NULL(slave);
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    CS104_Slave_setInterrogationHandler(slave, windowOpenTestInterrogationHandler, &handlerContext);
+    CS104_Slave_setWindowOpenHandler(slave, windowOpenTestWindowOpenHandler, &handlerContext);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+    struct sProcessImageTestContext context;
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) spcs);
+    CS104_Connection con = startSlaveAndInterrogate(slave, &context);
 
-    SetpointCommandShortWithCP56Time2a_destroy(spcs);
+    /* ACT_CON uses one slot of the k window (k = 12), the queue is empty */
+    TEST_ASSERT_EQUAL_INT(11, handlerContext.initialFreeWindowSlots);
+    TEST_ASSERT_EQUAL_INT(10 * (2 + 256), handlerContext.initialFreeQueueBytes);
 
-    CS101_ASDU_encode(asdu, f);
+    TEST_ASSERT_EQUAL_INT(1000, context.interrogatedPoints);
+    TEST_ASSERT_TRUE(handlerContext.windowOpenEvents > 0);
 
-    TEST_ASSERT_EQUAL_INT(21, Frame_getMsgSize(f));
+    CS104_Connection_destroy(con);
 
-    CS101_ASDU_destroy(asdu);
+    CS104_Slave_stop(slave);
+    CS104_Slave_destroy(slave);
+}
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+struct sEventFilterTestContext
+{
+    int numberOfAsdus;
+    int numberOfElements;
+    CS101_ASDU lastAsdu;
+    bool isSequence;
+    TypeID typeId;
+    int ioas[0x7f];
+};
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+static void
+eventFilterASDUHandler(void* parameter, CS101_ASDU asdu)
+{
+    struct sEventFilterTestContext* context = (struct sEventFilterTestContext*) parameter;
 
-    SetpointCommandShortWithCP56Time2a spcs_dec = (SetpointCommandShortWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
+    int i;
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )spcs_dec));
+    for (i = 0; i < CS101_ASDU_getNumberOfElements(asdu); i++) {
+        InformationObject io = CS101_ASDU_getElement(asdu, i);
 
-    TEST_ASSERT_EQUAL_FLOAT(10.5f, SetpointCommandShortWithCP56Time2a_getValue(spcs_dec));
-    TEST_ASSERT_EQUAL_INT(0, SetpointCommandShortWithCP56Time2a_getQL(spcs_dec));
-    TEST_ASSERT_TRUE(SetpointCommandShortWithCP56Time2a_isSelect(spcs_dec));
-    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(SetpointCommandShortWithCP56Time2a_getTimestamp(spcs_dec)));
+        if ((io) && (context->numberOfElements < 0x7f))
+            context->ioas[context->numberOfElements++] = InformationObject_getObjectAddress(io);
 
-    SetpointCommandShortWithCP56Time2a_destroy(spcs_dec);
+        if (io)
+            InformationObject_destroy(io);
+    }
 
-    CS101_ASDU_destroy(asdu2);
+    context->numberOfAsdus++;
+    context->lastAsdu = asdu;
+    context->isSequence = CS101_ASDU_isSequence(asdu);
+    context->typeId = CS101_ASDU_getTypeID(asdu);
 }
 
-void
-test_InterrogationCommand(void)
+/* returns the number of reported information objects */
+static int
+eventFilterApplyShort(CS101_EventFilter filter, int ioa, float value, QualityDescriptor quality)
 {
-    InterrogationCommand ic;
-    uint8_t qoi = 21;
-    ic = InterrogationCommand_create(NULL, 101, qoi);
-    TEST_ASSERT_EQUAL_INT(21, InterrogationCommand_getQOI(ic));
-
-    uint8_t buffer[256];
+    sCS101_StaticASDU _asdu;
+    struct sEventFilterTestContext context;
 
-    struct sBufferFrame bf;
+    memset(&context, 0, sizeof(context));
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    CS101_ASDU asdu = CS101_ASDU_initializeStatic(&_asdu, &defaultAppLayerParameters, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+    struct sMeasuredValueShort _io;
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) ic);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) MeasuredValueShort_create(&_io, ioa, value, quality));
 
-    InterrogationCommand_destroy(ic);
+    CS101_EventFilter_apply(filter, asdu, eventFilterASDUHandler, &context);
 
-    CS101_ASDU_encode(asdu, f);
+    return context.numberOfElements;
+}
 
-    TEST_ASSERT_EQUAL_INT(10, Frame_getMsgSize(f));
+void
+test_CS101_EventFilter_DeadbandsAndChangeDetection(void)
+{
+    CS101_EventFilter filter = CS101_EventFilter_create();
 
-    CS101_ASDU_destroy(asdu);
+    TEST_ASSERT_NOT_NULL(filter);
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    TEST_ASSERT_TRUE(CS101_EventFilter_setDeadband(filter, 1, 100, CS101_DEADBAND_ABSOLUTE, 1.0f));
+    TEST_ASSERT_TRUE(CS101_EventFilter_setDeadband(filter, 1, 101, CS101_DEADBAND_PERCENTAGE, 10.0f));
+    TEST_ASSERT_TRUE(CS101_EventFilter_setDeadband(filter, 1, 102, CS101_DEADBAND_INTEGRATED, 1.0f));
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+    /* absolute deadband */
+    TEST_ASSERT_EQUAL_INT(1, eventFilterApplyShort(filter, 100, 10.0f, IEC60870_QUALITY_GOOD));
+    TEST_ASSERT_EQUAL_INT(0, eventFilterApplyShort(filter, 100, 10.5f, IEC60870_QUALITY_GOOD));
+    TEST_ASSERT_EQUAL_INT(0, eventFilterApplyShort(filter, 100, 9.5f, IEC60870_QUALITY_GOOD));
+    TEST_ASSERT_EQUAL_INT(1, eventFilterApplyShort(filter, 100, 11.5f, IEC60870_QUALITY_GOOD));
 
-    InterrogationCommand ic_dec = (InterrogationCommand) CS101_ASDU_getElement(asdu2, 0);
+    /* quality changes are always reported */
+    TEST_ASSERT_EQUAL_INT(1, eventFilterApplyShort(filter, 100, 11.5f, IEC60870_QUALITY_INVALID));
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )ic_dec));
+    /* percentage deadband */
+    TEST_ASSERT_EQUAL_INT(1, eventFilterApplyShort(filter, 101, 100.0f, IEC60870_QUALITY_GOOD));
+    TEST_ASSERT_EQUAL_INT(0, eventFilterApplyShort(filter, 101, 105.0f, IEC60870_QUALITY_GOOD));
+    TEST_ASSERT_EQUAL_INT(1, eventFilterApplyShort(filter, 101, 111.0f, IEC60870_QUALITY_GOOD));
 
-    TEST_ASSERT_EQUAL_INT(21, InterrogationCommand_getQOI(ic_dec));
+    /* integrated deadband */
+    TEST_ASSERT_EQUAL_INT(1, eventFilterApplyShort(filter, 102, 0.0f, IEC60870_QUALITY_GOOD));
+    TEST_ASSERT_EQUAL_INT(0, eventFilterApplyShort(filter, 102, 0.4f, IEC60870_QUALITY_GOOD));
+    TEST_ASSERT_EQUAL_INT(0, eventFilterApplyShort(filter, 102, 0.4f, IEC60870_QUALITY_GOOD));
+    TEST_ASSERT_EQUAL_INT(1, eventFilterApplyShort(filter, 102, 0.4f, IEC60870_QUALITY_GOOD));
 
-    InterrogationCommand_destroy(ic_dec);
+    /* default deadband (every change) */
+    TEST_ASSERT_EQUAL_INT(1, eventFilterApplyShort(filter, 103, 1.0f, IEC60870_QUALITY_GOOD));
+    TEST_ASSERT_EQUAL_INT(0, eventFilterApplyShort(filter, 103, 1.0f, IEC60870_QUALITY_GOOD));
+    TEST_ASSERT_EQUAL_INT(1, eventFilterApplyShort(filter, 103, 1.1f, IEC60870_QUALITY_GOOD));
 
-    CS101_ASDU_destroy(asdu2);
-}
+    /* change of state: only the changed single point remains in the ASDU */
+    sCS101_StaticASDU _asdu;
+    struct sEventFilterTestContext context;
 
-void
-test_CounterInterrogationCommand(void)
-{
-    CounterInterrogationCommand cic;
-    uint8_t qcc = 1;
-    cic = CounterInterrogationCommand_create(NULL, 101, qcc);
+    CS101_ASDU asdu = CS101_ASDU_initializeStatic(&_asdu, &defaultAppLayerParameters, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
 
-    TEST_ASSERT_EQUAL_INT(1, CounterInterrogationCommand_getQCC(cic));
+    struct sSinglePointInformation _sp;
 
-    uint8_t buffer[256];
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) SinglePointInformation_create(&_sp, 200, false, IEC60870_QUALITY_GOOD));
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) SinglePointInformation_create(&_sp, 201, false, IEC60870_QUALITY_GOOD));
 
-    struct sBufferFrame bf;
+    memset(&context, 0, sizeof(context));
+    TEST_ASSERT_EQUAL_INT(1, CS101_EventFilter_apply(filter, asdu, eventFilterASDUHandler, &context));
+    TEST_ASSERT_TRUE(context.lastAsdu == asdu);
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    memset(&context, 0, sizeof(context));
+    TEST_ASSERT_EQUAL_INT(0, CS101_EventFilter_apply(filter, asdu, eventFilterASDUHandler, &context));
+    TEST_ASSERT_EQUAL_INT(0, context.numberOfAsdus);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+    CS101_ASDU_removeAllElements(asdu);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) cic);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) SinglePointInformation_create(&_sp, 200, false, IEC60870_QUALITY_GOOD));
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) SinglePointInformation_create(&_sp, 201, true, IEC60870_QUALITY_GOOD));
 
-    CounterInterrogationCommand_destroy(cic);
+    memset(&context, 0, sizeof(context));
+    TEST_ASSERT_EQUAL_INT(1, CS101_EventFilter_apply(filter, asdu, eventFilterASDUHandler, &context));
+    TEST_ASSERT_TRUE(context.lastAsdu != asdu);
+    TEST_ASSERT_EQUAL_INT(1, context.numberOfElements);
+    TEST_ASSERT_EQUAL_INT(M_SP_NA_1, context.typeId);
+    TEST_ASSERT_EQUAL_INT(201, context.ioas[0]);
 
-    CS101_ASDU_encode(asdu, f);
+    /* other causes of transmission are not filtered */
+    CS101_ASDU_setCOT(asdu, CS101_COT_PERIODIC);
 
-    TEST_ASSERT_EQUAL_INT(10, Frame_getMsgSize(f));
+    memset(&context, 0, sizeof(context));
+    TEST_ASSERT_EQUAL_INT(1, CS101_EventFilter_apply(filter, asdu, eventFilterASDUHandler, &context));
+    TEST_ASSERT_TRUE(context.lastAsdu == asdu);
 
-    CS101_ASDU_destroy(asdu);
+    /* filter in front of the event queue of the slave */
+    CS104_Slave slave = CS104_Slave_create(10, 10);
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
+    CS104_Slave_setEventFilter(slave, filter);
+    CS104_Slave_setLocalPort(slave, 20004);
+    CS104_Slave_start(slave);
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+    CS101_EventFilter_reset(filter);
 
-    CounterInterrogationCommand cic_dec = (CounterInterrogationCommand) CS101_ASDU_getElement(asdu2, 0);
+    CS101_ASDU_setCOT(asdu, CS101_COT_SPONTANEOUS);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )cic_dec));
+    CS104_Slave_enqueueASDU(slave, asdu);
+    CS104_Slave_enqueueASDU(slave, asdu);
+    CS104_Slave_enqueueASDU(slave, asdu);
 
-    TEST_ASSERT_EQUAL_INT(1, CounterInterrogationCommand_getQCC(cic_dec));
+    TEST_ASSERT_EQUAL_INT(1, CS104_Slave_getNumberOfQueueEntries(slave, NULL));
 
-    CounterInterrogationCommand_destroy(cic_dec);
+    CS104_Slave_stop(slave);
+    CS104_Slave_destroy(slave);
 
-    CS101_ASDU_destroy(asdu2);
+    CS101_EventFilter_destroy(filter);
 }
 
 void
-test_ReadCommand(void)
+test_CS101_EventFilter_SplitSequenceASDU(void)
 {
-    ReadCommand rc;
-    rc = ReadCommand_create( NULL, 101);
+    CS101_EventFilter filter = CS101_EventFilter_create();
 
-    uint8_t buffer[256];
+    sCS101_StaticASDU _asdu;
+    struct sEventFilterTestContext context;
+    struct sSinglePointInformation _sp;
 
-    struct sBufferFrame bf;
+    /* sequence ASDU with the maximum number of single points (1 byte per information object) */
+    CS101_ASDU asdu = CS101_ASDU_initializeStatic(&_asdu, &defaultAppLayerParameters, true, CS101_COT_SPONTANEOUS, 0, 1, false, false);
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    int i;
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+    for (i = 0; i < 127; i++)
+        TEST_ASSERT_TRUE(CS101_ASDU_addInformationObject(asdu, (InformationObject) SinglePointInformation_create(&_sp, 1000 + i, false, IEC60870_QUALITY_GOOD)));
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) rc);
+    memset(&context, 0, sizeof(context));
+    TEST_ASSERT_EQUAL_INT(1, CS101_EventFilter_apply(filter, asdu, eventFilterASDUHandler, &context));
+    TEST_ASSERT_TRUE(context.lastAsdu == asdu);
+    TEST_ASSERT_EQUAL_INT(127, context.numberOfElements);
 
-    ReadCommand_destroy(rc);
+    /* change all single points except the first one */
+    CS101_ASDU_removeAllElements(asdu);
 
-    CS101_ASDU_encode(asdu, f);
+    for (i = 0; i < 127; i++)
+        TEST_ASSERT_TRUE(CS101_ASDU_addInformationObject(asdu, (InformationObject) SinglePointInformation_create(&_sp, 1000 + i, (i != 0), IEC60870_QUALITY_GOOD)));
 
-    TEST_ASSERT_EQUAL_INT(9, Frame_getMsgSize(f));
+    /* without the sequence format an information object needs 4 bytes -> the 126 changed single points are split */
+    memset(&context, 0, sizeof(context));
+    int numberOfAsdus = CS101_EventFilter_apply(filter, asdu, eventFilterASDUHandler, &context);
 
-    CS101_ASDU_destroy(asdu);
+    TEST_ASSERT_TRUE(numberOfAsdus > 1);
+    TEST_ASSERT_EQUAL_INT(numberOfAsdus, context.numberOfAsdus);
+    TEST_ASSERT_EQUAL_INT(126, context.numberOfElements);
+    TEST_ASSERT_FALSE(context.isSequence);
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    for (i = 0; i < 126; i++)
+        TEST_ASSERT_EQUAL_INT(1001 + i, context.ioas[i]);
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+    /* all changes have been reported */
+    memset(&context, 0, sizeof(context));
+    TEST_ASSERT_EQUAL_INT(0, CS101_EventFilter_apply(filter, asdu, eventFilterASDUHandler, &context));
 
-    ReadCommand rc_dec = (ReadCommand) CS101_ASDU_getElement(asdu2, 0);
+    CS101_EventFilter_destroy(filter);
+}
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )rc_dec));
+void
+test_CS101_ASDU_addObjectOfWrongType(void)
+{
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
 
-    ReadCommand_destroy(rc_dec);
+    InformationObject io1 = (InformationObject) SinglePointInformation_create(NULL, 101, true, IEC60870_QUALITY_GOOD);
 
-    CS101_ASDU_destroy(asdu2);
+    bool added = CS101_ASDU_addInformationObject(asdu, io1);
+
+    TEST_ASSERT_TRUE(added);
+
+    InformationObject_destroy(io1);
+
+    InformationObject io2 = (InformationObject) DoublePointInformation_create(NULL, 102, IEC60870_DOUBLE_POINT_OFF, IEC60870_QUALITY_GOOD);
+
+    added = CS101_ASDU_addInformationObject(asdu, io2);
+
+    TEST_ASSERT_FALSE(added);
+
+    InformationObject_destroy(io2);
+
+    CS101_ASDU_destroy(asdu);
 }
 
 void
-test_ClockSynchronizationCommand(void)
+test_CS101_ASDU_addUntilOverflow(void)
 {
-    ClockSynchronizationCommand csc;
-    uint64_t time1 = Hal_getTimeInMs();
-    struct sCP56Time2a cpTime1;
-    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
-    csc = ClockSynchronizationCommand_create(NULL, 101, &cpTime1);
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
 
-    uint8_t buffer[256];
+    int i = 0;
 
-    struct sBufferFrame bf;
+    for (i = 0; i < 60; i++) {
+        InformationObject io = (InformationObject) SinglePointInformation_create(NULL, 100 + i, true, IEC60870_QUALITY_GOOD);
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+        bool added = CS101_ASDU_addInformationObject(asdu, io);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+        TEST_ASSERT_TRUE(added);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) csc);
+        InformationObject_destroy(io);
 
-    ClockSynchronizationCommand_destroy(csc);
+        TEST_ASSERT_EQUAL_INT(i + 1, CS101_ASDU_getNumberOfElements(asdu));
+    }
 
-    CS101_ASDU_encode(asdu, f);
+    InformationObject io = (InformationObject) SinglePointInformation_create(NULL, 100 + i, true, IEC60870_QUALITY_GOOD);
 
-    TEST_ASSERT_EQUAL_INT(16, Frame_getMsgSize(f));
+    bool added = CS101_ASDU_addInformationObject(asdu, io);
+
+    TEST_ASSERT_FALSE(added);
+
+    InformationObject_destroy(io);
 
     CS101_ASDU_destroy(asdu);
+}
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+static void
+queueOverflowHandler(void* parameter, int droppedASDUs)
+{
+    int* dropped = (int*) parameter;
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+    *dropped += droppedASDUs;
+}
 
-    ClockSynchronizationCommand csc_dec = (ClockSynchronizationCommand) CS101_ASDU_getElement(asdu2, 0);
+static void
+enqueueScaledValue(CS101_Queue queue, CS101_CauseOfTransmission cot, int ioa, int value)
+{
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, cot, 0, 1, false, false);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )csc_dec));
-    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(ClockSynchronizationCommand_getTime(csc_dec)));
+    struct sMeasuredValueScaled _io;
 
-    ClockSynchronizationCommand_destroy(csc_dec);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) MeasuredValueScaled_create(&_io, ioa, value, IEC60870_QUALITY_GOOD));
 
-    CS101_ASDU_destroy(asdu2);
+    CS101_Queue_enqueue(queue, asdu);
+
+    CS101_ASDU_destroy(asdu);
 }
 
-void
-test_ResetProcessCommand(void)
+static MeasuredValueScaled
+dequeueScaledValue(CS101_Queue queue)
 {
-    ResetProcessCommand rpc;
-    uint8_t qrp = 0;
-    rpc = ResetProcessCommand_create(NULL, 101, qrp);
+    uint8_t buffer[256];
+    struct sBufferFrame bufferFrame;
 
-    TEST_ASSERT_EQUAL_INT(0, ResetProcessCommand_getQRP(rpc));
+    Frame frame = CS101_Queue_dequeue(queue, BufferFrame_initialize(&bufferFrame, buffer, 0));
 
-    uint8_t buffer[256];
+    if (frame == NULL)
+        return NULL;
 
-    struct sBufferFrame bf;
+    CS101_ASDU asdu = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(frame));
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    MeasuredValueScaled mv = (MeasuredValueScaled) CS101_ASDU_getElement(asdu, 0);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+    CS101_ASDU_destroy(asdu);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) rpc);
+    return mv;
+}
 
-    ResetProcessCommand_destroy(rpc);
+void
+test_CS101_Queue_VariableLengthEntries(void)
+{
+    struct sCS101_Queue queue;
+    int dropped = 0;
+    int i;
 
-    CS101_ASDU_encode(asdu, f);
+    /* memory for a single ASDU of maximum size */
+    CS101_Queue_initialize(&queue, 1);
+    CS101_Queue_setOverflowHandler(&queue, queueOverflowHandler, &dropped);
 
-    TEST_ASSERT_EQUAL_INT(10, Frame_getMsgSize(f));
+    /* each ASDU requires 13 bytes (length + 12 byte ASDU) -> 19 ASDUs fit into 257 bytes */
+    for (i = 0; i < 19; i++)
+        enqueueScaledValue(&queue, CS101_COT_SPONTANEOUS, 100 + i, i);
 
-    CS101_ASDU_destroy(asdu);
+    TEST_ASSERT_EQUAL_INT(0, dropped);
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    enqueueScaledValue(&queue, CS101_COT_SPONTANEOUS, 119, 19);
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+    TEST_ASSERT_EQUAL_INT(1, dropped);
 
-    ResetProcessCommand rpc_dec = (ResetProcessCommand) CS101_ASDU_getElement(asdu2, 0);
+    MeasuredValueScaled mv = dequeueScaledValue(&queue);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )rpc_dec));
+    TEST_ASSERT_NOT_NULL(mv);
+    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject) mv));
+    MeasuredValueScaled_destroy(mv);
 
-    TEST_ASSERT_EQUAL_INT(0, ResetProcessCommand_getQRP(rpc_dec));
+    /* wrap around the end of the buffer */
+    for (i = 0; i < 18; i++) {
+        mv = dequeueScaledValue(&queue);
 
-    ResetProcessCommand_destroy(rpc_dec);
+        TEST_ASSERT_NOT_NULL(mv);
+        TEST_ASSERT_EQUAL_INT(102 + i, InformationObject_getObjectAddress((InformationObject) mv));
+        TEST_ASSERT_EQUAL_INT(2 + i, MeasuredValueScaled_getValue(mv));
+        MeasuredValueScaled_destroy(mv);
+    }
 
-    CS101_ASDU_destroy(asdu2);
+    TEST_ASSERT_TRUE(CS101_Queue_isEmpty(&queue));
+
+    /* a periodic value replaces the queued value of the same information object */
+    enqueueScaledValue(&queue, CS101_COT_PERIODIC, 200, 1);
+    enqueueScaledValue(&queue, CS101_COT_PERIODIC, 201, 2);
+    enqueueScaledValue(&queue, CS101_COT_PERIODIC, 200, 3);
+
+    mv = dequeueScaledValue(&queue);
+    TEST_ASSERT_EQUAL_INT(200, InformationObject_getObjectAddress((InformationObject) mv));
+    TEST_ASSERT_EQUAL_INT(3, MeasuredValueScaled_getValue(mv));
+    MeasuredValueScaled_destroy(mv);
+
+    mv = dequeueScaledValue(&queue);
+    TEST_ASSERT_EQUAL_INT(201, InformationObject_getObjectAddress((InformationObject) mv));
+    MeasuredValueScaled_destroy(mv);
+
+    TEST_ASSERT_TRUE(CS101_Queue_isEmpty(&queue));
+
+    CS101_Queue_dispose(&queue);
 }
 
 void
-test_DelayAcquisitionCommand(void)
+test_CS104_MasterSlave_TLSConnectSuccess(void)
 {
-    DelayAcquisitionCommand dac;
-    uint8_t time1 = Hal_getTimeInMs();
-
-    struct sCP16Time2a delay;
+    TLSConfiguration tlsConfig1 = TLSConfiguration_create();
 
-    bzero(&delay, sizeof(struct sCP16Time2a));
+    TLSConfiguration_setChainValidation(tlsConfig1, true);
 
-    CP16Time2a_setEplapsedTimeInMs(&delay, 24123);
+    TLSConfiguration_setOwnKeyFromFile(tlsConfig1, "server-key.pem", NULL);
+    TLSConfiguration_setOwnCertificateFromFile(tlsConfig1, "server.cer");
+    TLSConfiguration_addCACertificateFromFile(tlsConfig1, "root.cer");
 
-    dac = DelayAcquisitionCommand_create(NULL, 101, &delay);
-    uint8_t buffer[256];
+    TLSConfiguration tlsConfig2 = TLSConfiguration_create();
 
-    struct sBufferFrame bf;
+    TLSConfiguration_setChainValidation(tlsConfig2, true);
+    TLSConfiguration_setAllowOnlyKnownCertificates(tlsConfig2, true);
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    TLSConfiguration_setOwnKeyFromFile(tlsConfig2, "client1-key.pem", NULL);
+    TLSConfiguration_setOwnCertificateFromFile(tlsConfig2, "client1.cer");
+    TLSConfiguration_addCACertificateFromFile(tlsConfig2, "root.cer");
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+    TLSConfiguration_addAllowedCertificateFromFile(tlsConfig2, "server.cer");
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) dac);
+    CS104_Slave slave = CS104_Slave_createSecure(100, 100, tlsConfig1);
 
-    DelayAcquisitionCommand_destroy(dac);
+    TEST_ASSERT_NOT_NULL(slave);
 
-    CS101_ASDU_encode(asdu, f);
+    CS104_Slave_setLocalPort(slave, 20004);
 
-    TEST_ASSERT_EQUAL_INT(11, Frame_getMsgSize(f));
+    CS104_Slave_start(slave);
 
-    CS101_ASDU_destroy(asdu);
+    CS104_Connection con = CS104_Connection_createSecure("127.0.0.1", 20004, tlsConfig2);
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    TEST_ASSERT_NOT_NULL(con);
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+    bool result = CS104_Connection_connect(con);
 
-    DelayAcquisitionCommand dac_dec = (DelayAcquisitionCommand) CS101_ASDU_getElement(asdu2, 0);
+    TEST_ASSERT_TRUE(result);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )dac_dec));
-    CP16Time2a time1_dec = DelayAcquisitionCommand_getDelay(dac_dec);
-    TEST_ASSERT_EQUAL_INT(24123, CP16Time2a_getEplapsedTimeInMs(time1_dec));
+    CS104_Slave_destroy(slave);
 
-    DelayAcquisitionCommand_destroy(dac_dec);
+    CS104_Connection_destroy(con);
 
-    CS101_ASDU_destroy(asdu2);
+    TLSConfiguration_destroy(tlsConfig1);
+    TLSConfiguration_destroy(tlsConfig2);
 }
 
+
 void
-test_BitString32(void)
+test_CS104_MasterSlave_TLSSessionResumption(void)
 {
-    BitString32 bs32;
+    TLSConfiguration tlsConfig1 = TLSConfiguration_create();
 
-    bs32 = BitString32_createEx(NULL, 101, 0xaaaa, IEC60870_QUALITY_INVALID);
+    TLSConfiguration_setChainValidation(tlsConfig1, true);
+    TLSConfiguration_enableSessionResumption(tlsConfig1, true);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, BitString32_getQuality(bs32));
+    TLSConfiguration_setOwnKeyFromFile(tlsConfig1, "server-key.pem", NULL);
+    TLSConfiguration_setOwnCertificateFromFile(tlsConfig1, "server.cer");
+    TLSConfiguration_addCACertificateFromFile(tlsConfig1, "root.cer");
 
-    BitString32_destroy(bs32);
+    TLSConfiguration tlsConfig2 = TLSConfiguration_create();
 
-    bs32 = BitString32_create(NULL, 101, 0xaaaa);
+    TLSConfiguration_setChainValidation(tlsConfig2, true);
+    TLSConfiguration_setAllowOnlyKnownCertificates(tlsConfig2, true);
+    TLSConfiguration_enableSessionResumption(tlsConfig2, true);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, BitString32_getQuality(bs32));
+    TLSConfiguration_setOwnKeyFromFile(tlsConfig2, "client1-key.pem", NULL);
+    TLSConfiguration_setOwnCertificateFromFile(tlsConfig2, "client1.cer");
+    TLSConfiguration_addCACertificateFromFile(tlsConfig2, "root.cer");
 
-    BitString32_destroy(bs32);
+    TLSConfiguration_addAllowedCertificateFromFile(tlsConfig2, "server.cer");
 
-    bs32 = BitString32_createEx(NULL, 101, 0xaaaa, IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL);
+    CS104_Slave slave = CS104_Slave_createSecure(100, 100, tlsConfig1);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID + IEC60870_QUALITY_NON_TOPICAL, BitString32_getQuality(bs32));
+    TEST_ASSERT_NOT_NULL(slave);
 
-    TEST_ASSERT_EQUAL_UINT32(0xaaaa, BitString32_getValue(bs32));
+    CS104_Slave_setLocalPort(slave, 20004);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject ) bs32));
+    CS104_Slave_start(slave);
 
-    BitString32_destroy(bs32);
+    int i;
 
-    Bitstring32WithCP24Time2a bs32cp24;
+    /* the second and third connect resume the session of the first one */
+    for (i = 0; i < 3; i++) {
+        CS104_Connection con = CS104_Connection_createSecure("127.0.0.1", 20004, tlsConfig2);
 
-    struct sCP24Time2a cp24;
+        TEST_ASSERT_NOT_NULL(con);
 
-    bs32cp24 = Bitstring32WithCP24Time2a_createEx(NULL, 100002, 0xbbbb, IEC60870_QUALITY_INVALID, &cp24);
+        bool result = CS104_Connection_connect(con);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID, BitString32_getQuality((BitString32 )bs32cp24));
+        TEST_ASSERT_TRUE(result);
 
-    TEST_ASSERT_EQUAL_UINT32(0xbbbb, BitString32_getValue((BitString32 )bs32cp24));
+        CS104_Connection_destroy(con);
+    }
 
-    TEST_ASSERT_EQUAL_INT(100002, InformationObject_getObjectAddress((InformationObject ) bs32cp24));
+    CS104_Slave_destroy(slave);
 
-    Bitstring32WithCP24Time2a_destroy(bs32cp24);
+    /* the first connect requires a full handshake */
+    TEST_ASSERT_EQUAL_INT(2, TLSConfiguration_getResumedSessionCount(tlsConfig1));
+    TEST_ASSERT_EQUAL_INT(2, TLSConfiguration_getResumedSessionCount(tlsConfig2));
 
-    bs32cp24 = Bitstring32WithCP24Time2a_create(NULL, 100002, 0xbbbb, &cp24);
+    TLSConfiguration_destroy(tlsConfig1);
+    TLSConfiguration_destroy(tlsConfig2);
+}
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, BitString32_getQuality((BitString32 )bs32cp24));
 
-    TEST_ASSERT_EQUAL_UINT32(0xbbbb, BitString32_getValue((BitString32 )bs32cp24));
+void
+test_CS104_MasterSlave_TLSStalledHandshake(void)
+{
+    TLSConfiguration tlsConfig1 = TLSConfiguration_create();
 
-    TEST_ASSERT_EQUAL_INT(100002, InformationObject_getObjectAddress((InformationObject ) bs32cp24));
+    TLSConfiguration_setChainValidation(tlsConfig1, true);
+    TLSConfiguration_setHandshakeTimeout(tlsConfig1, 2000);
 
-    Bitstring32WithCP24Time2a_destroy(bs32cp24);
+    TLSConfiguration_setOwnKeyFromFile(tlsConfig1, "server-key.pem", NULL);
+    TLSConfiguration_setOwnCertificateFromFile(tlsConfig1, "server.cer");
+    TLSConfiguration_addCACertificateFromFile(tlsConfig1, "root.cer");
 
-    Bitstring32WithCP56Time2a bs32cp56;
+    TLSConfiguration tlsConfig2 = TLSConfiguration_create();
 
-    struct sCP56Time2a cp56;
+    TLSConfiguration_setChainValidation(tlsConfig2, true);
+    TLSConfiguration_setAllowOnlyKnownCertificates(tlsConfig2, true);
 
-    bs32cp56 = Bitstring32WithCP56Time2a_createEx(NULL, 1000002, 0xcccc, IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL, &cp56);
+    TLSConfiguration_setOwnKeyFromFile(tlsConfig2, "client1-key.pem", NULL);
+    TLSConfiguration_setOwnCertificateFromFile(tlsConfig2, "client1.cer");
+    TLSConfiguration_addCACertificateFromFile(tlsConfig2, "root.cer");
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_INVALID + IEC60870_QUALITY_NON_TOPICAL, BitString32_getQuality((BitString32 )bs32cp56));
+    TLSConfiguration_addAllowedCertificateFromFile(tlsConfig2, "server.cer");
 
-    TEST_ASSERT_EQUAL_UINT32(0xcccc, BitString32_getValue((BitString32 )bs32cp56));
+    CS104_Slave slave = CS104_Slave_createSecure(100, 100, tlsConfig1);
 
-    TEST_ASSERT_EQUAL_INT(1000002, InformationObject_getObjectAddress((InformationObject ) bs32cp56));
+    TEST_ASSERT_NOT_NULL(slave);
 
-    Bitstring32WithCP56Time2a_destroy(bs32cp56);
+    CS104_Slave_setLocalPort(slave, 20004);
 
-    bs32cp56 = Bitstring32WithCP56Time2a_create(NULL, 1000002, 0xcccc, &cp56);
+    CS104_Slave_start(slave);
 
-    TEST_ASSERT_EQUAL_UINT8(IEC60870_QUALITY_GOOD, BitString32_getQuality((BitString32 )bs32cp56));
+    /* peer that connects but never starts the TLS handshake */
+    Socket stalledSocket = TcpSocket_create();
 
-    TEST_ASSERT_EQUAL_UINT32(0xcccc, BitString32_getValue((BitString32 )bs32cp56));
+    TEST_ASSERT_TRUE(Socket_connect(stalledSocket, "127.0.0.1", 20004));
 
-    TEST_ASSERT_EQUAL_INT(1000002, InformationObject_getObjectAddress((InformationObject ) bs32cp56));
+    Thread_sleep(100);
 
-    Bitstring32WithCP56Time2a_destroy(bs32cp56);
-}
+    CS104_Connection con = CS104_Connection_createSecure("127.0.0.1", 20004, tlsConfig2);
 
-void
-test_Bitstring32CommandWithCP56Time2a(void)
-{
-    Bitstring32CommandWithCP56Time2a bsc;
-    uint64_t time1 = Hal_getTimeInMs();
+    uint64_t startTime = Hal_getTimeInMs();
 
-    struct sCP56Time2a cpTime1;
+    bool result = CS104_Connection_connect(con);
 
-    CP56Time2a_createFromMsTimestamp(&cpTime1, time1);
+    TEST_ASSERT_TRUE(result);
 
-    bsc = Bitstring32CommandWithCP56Time2a_create(NULL, 101, (uint32_t) 0x0000000000, &cpTime1);
+    /* the handshake of the second client is not delayed by the stalled one */
+    TEST_ASSERT_TRUE(Hal_getTimeInMs() - startTime < 2000);
 
-    TEST_ASSERT_EQUAL_UINT32(0x0000000000, Bitstring32CommandWithCP56Time2a_getValue(bsc));
+    CS104_Connection_destroy(con);
 
-    uint8_t buffer[256];
+    /* the stalled connection is closed by the handshake timeout */
+    Thread_sleep(2500);
 
-    struct sBufferFrame bf;
+    TEST_ASSERT_EQUAL_INT(0, CS104_Slave_getOpenConnections(slave));
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    Socket_destroy(stalledSocket);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+    CS104_Slave_destroy(slave);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) bsc);
+    TLSConfiguration_destroy(tlsConfig1);
+    TLSConfiguration_destroy(tlsConfig2);
+}
 
-    Bitstring32CommandWithCP56Time2a_destroy(bsc);
+struct sSlaveTickThreadInfo {
+    CS104_Slave slave;
+    bool running;
+};
 
-    CS101_ASDU_encode(asdu, f);
+static void*
+slaveTickThread(void* parameter)
+{
+    struct sSlaveTickThreadInfo* info = (struct sSlaveTickThreadInfo*) parameter;
 
-    TEST_ASSERT_EQUAL_INT(20, Frame_getMsgSize(f));
+    while (info->running) {
+        CS104_Slave_tick(info->slave);
+        Thread_sleep(1);
+    }
 
-    CS101_ASDU_destroy(asdu);
+    return NULL;
+}
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+void
+test_CS104_MasterSlave_TLSStalledHandshakeThreadless(void)
+{
+    TLSConfiguration tlsConfig1 = TLSConfiguration_create();
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+    TLSConfiguration_setChainValidation(tlsConfig1, true);
+    TLSConfiguration_setHandshakeTimeout(tlsConfig1, 2000);
 
-    Bitstring32CommandWithCP56Time2a bsc_dec = (Bitstring32CommandWithCP56Time2a) CS101_ASDU_getElement(asdu2, 0);
+    TLSConfiguration_setOwnKeyFromFile(tlsConfig1, "server-key.pem", NULL);
+    TLSConfiguration_setOwnCertificateFromFile(tlsConfig1, "server.cer");
+    TLSConfiguration_addCACertificateFromFile(tlsConfig1, "root.cer");
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )bsc_dec));
-    TEST_ASSERT_EQUAL_UINT64(time1, CP56Time2a_toMsTimestamp(Bitstring32CommandWithCP56Time2a_getTimestamp(bsc_dec)));
-    TEST_ASSERT_EQUAL_UINT32(0x0000000000, Bitstring32CommandWithCP56Time2a_getValue(bsc_dec));
+    TLSConfiguration tlsConfig2 = TLSConfiguration_create();
 
-    Bitstring32CommandWithCP56Time2a_destroy(bsc_dec);
+    TLSConfiguration_setChainValidation(tlsConfig2, true);
+    TLSConfiguration_setAllowOnlyKnownCertificates(tlsConfig2, true);
 
-    CS101_ASDU_destroy(asdu2);
-}
+    TLSConfiguration_setOwnKeyFromFile(tlsConfig2, "client1-key.pem", NULL);
+    TLSConfiguration_setOwnCertificateFromFile(tlsConfig2, "client1.cer");
+    TLSConfiguration_addCACertificateFromFile(tlsConfig2, "root.cer");
 
-void
-test_QueryLog(void)
-{
-    QueryLog queryLog;
+    TLSConfiguration_addAllowedCertificateFromFile(tlsConfig2, "server.cer");
 
-    uint64_t stopTime = Hal_getTimeInMs();
-    uint64_t startTime = stopTime - 2000;
+    CS104_Slave slave = CS104_Slave_createSecure(100, 100, tlsConfig1);
 
-    struct sCP56Time2a rangeStartTime;
-    struct sCP56Time2a rangeStopTime;
+    TEST_ASSERT_NOT_NULL(slave);
 
-    CP56Time2a_createFromMsTimestamp(&rangeStartTime, startTime);
-    CP56Time2a_createFromMsTimestamp(&rangeStopTime, stopTime);
+    CS104_Slave_setLocalPort(slave, 20004);
 
-    queryLog = QueryLog_create(NULL, 101, 256, &rangeStartTime, &rangeStopTime);
+    CS104_Slave_startThreadless(slave);
 
-    TEST_ASSERT_EQUAL_UINT16(256, QueryLog_getNOF(queryLog));
+    /* the client connect blocks -> the main loop of the slave runs in another thread */
+    struct sSlaveTickThreadInfo info;
+    info.slave = slave;
+    info.running = true;
 
-    uint8_t buffer[256];
+    Thread tickThread = Thread_create(slaveTickThread, &info, false);
+    Thread_start(tickThread);
 
-    struct sBufferFrame bf;
+    /* peer that connects but never starts the TLS handshake */
+    Socket stalledSocket = TcpSocket_create();
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    TEST_ASSERT_TRUE(Socket_connect(stalledSocket, "127.0.0.1", 20004));
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION, 0, 1, false, false);
+    Thread_sleep(100);
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) queryLog);
+    CS104_Connection con = CS104_Connection_createSecure("127.0.0.1", 20004, tlsConfig2);
 
-    QueryLog_destroy(queryLog);
+    uint64_t startTime = Hal_getTimeInMs();
 
-    CS101_ASDU_encode(asdu, f);
+    bool result = CS104_Connection_connect(con);
 
-    TEST_ASSERT_EQUAL_INT(25, Frame_getMsgSize(f));
+    TEST_ASSERT_TRUE(result);
 
-    CS101_ASDU_destroy(asdu);
+    /* the main loop is not blocked by the handshake of the stalled peer */
+    TEST_ASSERT_TRUE(Hal_getTimeInMs() - startTime < 1000);
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    CS104_Connection_destroy(con);
 
-    TEST_ASSERT_EQUAL_INT(1, CS101_ASDU_getNumberOfElements(asdu2));
+    /* the stalled connection is closed by the handshake timeout */
+    Thread_sleep(2500);
 
-    QueryLog queryLog_dec = (QueryLog) CS101_ASDU_getElement(asdu2, 0);
+    TEST_ASSERT_EQUAL_INT(0, CS104_Slave_getOpenConnections(slave));
 
-    TEST_ASSERT_NOT_NULL(queryLog_dec);
+    info.running = false;
+    Thread_destroy(tickThread);
 
-    TEST_ASSERT_EQUAL_INT(101, InformationObject_getObjectAddress((InformationObject )queryLog_dec));
-    TEST_ASSERT_EQUAL_UINT16(256, QueryLog_getNOF(queryLog_dec));
-    TEST_ASSERT_EQUAL_UINT64(startTime, CP56Time2a_toMsTimestamp(QueryLog_getRangeStartTime(queryLog_dec)));
-    TEST_ASSERT_EQUAL_UINT64(stopTime, CP56Time2a_toMsTimestamp(QueryLog_getRangeStopTime(queryLog_dec)));
+    Socket_destroy(stalledSocket);
 
-    QueryLog_destroy(queryLog_dec);
+    CS104_Slave_stopThreadless(slave);
+    CS104_Slave_destroy(slave);
 
-    CS101_ASDU_destroy(asdu2);
+    TLSConfiguration_destroy(tlsConfig1);
+    TLSConfiguration_destroy(tlsConfig2);
 }
 
+
 void
-test_BitString32xx_encodeDecode(void)
+test_CS104_MasterSlave_TLSConnectFails(void)
 {
-#ifndef _WIN32
-    uint8_t buffer[256];
-
-    struct sBufferFrame bf;
-
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
-
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
-
-    BitString32 bs32_1 = BitString32_createEx(NULL, 101, (uint32_t) 0xaaaaaaaaaa, IEC60870_QUALITY_INVALID);
-    BitString32 bs32_2 = BitString32_create(NULL, 102, (uint32_t) 0x0000000000);
-    BitString32 bs32_3 = BitString32_create(NULL, 103, (uint32_t) 0xffffffffffUL);
+    TLSConfiguration tlsConfig1 = TLSConfiguration_create();
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) bs32_1);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) bs32_2);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) bs32_3);
+    TLSConfiguration_setChainValidation(tlsConfig1, true);
 
-    CS101_ASDU_encode(asdu, f);
+    TLSConfiguration tlsConfig2 = TLSConfiguration_create();
 
-    InformationObject_destroy((InformationObject) bs32_1);
-    InformationObject_destroy((InformationObject) bs32_2);
-    InformationObject_destroy((InformationObject) bs32_3);
-    CS101_ASDU_destroy(asdu);
+    TLSConfiguration_setChainValidation(tlsConfig2, true);
+    TLSConfiguration_setAllowOnlyKnownCertificates(tlsConfig2, true);
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    TLSConfiguration_setOwnKeyFromFile(tlsConfig2, "client1-key.pem", NULL);
+    TLSConfiguration_setOwnCertificateFromFile(tlsConfig2, "client1.cer");
+    TLSConfiguration_addCACertificateFromFile(tlsConfig2, "root.cer");
 
-    BitString32 bs32_1_dec = (BitString32) CS101_ASDU_getElement(asdu2, 0);
-    BitString32 bs32_2_dec = (BitString32) CS101_ASDU_getElement(asdu2, 1);
-    BitString32 bs32_3_dec = (BitString32) CS101_ASDU_getElement(asdu2, 2);
+    TLSConfiguration_addAllowedCertificateFromFile(tlsConfig2, "server.cer");
 
-    TEST_ASSERT_EQUAL_UINT32(0xaaaaaaaaaaUL, BitString32_getValue(bs32_1_dec));
-    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_INVALID, BitString32_getQuality(bs32_1_dec));
+    CS104_Slave slave = CS104_Slave_createSecure(100, 100, tlsConfig1);
 
-    TEST_ASSERT_EQUAL_UINT32(0x0000000000UL, BitString32_getValue(bs32_2_dec));
-    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_GOOD, BitString32_getQuality(bs32_2_dec));
+    TEST_ASSERT_NOT_NULL(slave);
 
-    TEST_ASSERT_EQUAL_UINT32(0xffffffffUL, BitString32_getValue(bs32_3_dec));
-    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_GOOD, BitString32_getQuality(bs32_3_dec));
+    CS104_Slave_setLocalPort(slave, 20004);
 
-    InformationObject_destroy((InformationObject)bs32_1_dec);
-    InformationObject_destroy((InformationObject)bs32_2_dec);
-    InformationObject_destroy((InformationObject)bs32_3_dec);
+    CS104_Slave_start(slave);
 
-    CS101_ASDU_destroy(asdu2);
-#endif
-}
+    CS104_Connection con = CS104_Connection_createSecure("127.0.0.1", 20004, tlsConfig2);
 
-void
-test_CS104_Slave_CreateDestroy(void)
-{
-	CS104_Slave slave = CS104_Slave_create(100, 100);
+    TEST_ASSERT_NOT_NULL(con);
 
-	TEST_ASSERT_NOT_NULL(slave);
+    bool result = CS104_Connection_connect(con);
 
-	CS104_Slave_destroy(slave);
-}
+    TEST_ASSERT_FALSE(result);
 
-void
-test_CS104_Connection_CreateDestroy(void)
-{
-	CS104_Connection con = CS104_Connection_create("127.0.0.1", 2404);
+    CS104_Slave_destroy(slave);
 
-	TEST_ASSERT_NOT_NULL(con);
+    CS104_Connection_destroy(con);
 
-	CS104_Connection_destroy(con);
+    TLSConfiguration_destroy(tlsConfig1);
+    TLSConfiguration_destroy(tlsConfig2);
 }
 
-void
-test_CS104_MasterSlave_CreateDestroy(void)
+struct sBlockingReceiver {
+    volatile bool blocked;
+    int receivedAsdus;
+    int unexpectedValues;
+};
+
+static bool
+blockingReceiverHandler(void* parameter, int address, CS101_ASDU asdu)
 {
-	CS104_Slave slave = CS104_Slave_create(100, 100);
+    struct sBlockingReceiver* receiver = (struct sBlockingReceiver*) parameter;
 
-	TEST_ASSERT_NOT_NULL(slave);
+    if (CS101_ASDU_getTypeID(asdu) == M_ME_NB_1) {
+        MeasuredValueScaled mv = (MeasuredValueScaled) CS101_ASDU_getElement(asdu, 0);
 
-	CS104_Slave_setLocalPort(slave, 20004);
+        /* the value of the first information object is the index of the ASDU */
+        if (MeasuredValueScaled_getValue(mv) != receiver->receivedAsdus)
+            receiver->unexpectedValues++;
 
-	CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+        MeasuredValueScaled_destroy(mv);
 
-	TEST_ASSERT_NOT_NULL(con);
+        receiver->receivedAsdus++;
 
-	CS104_Connection_connect(con);
+        /* the handler is called by the receive thread -> the connection doesn't read while blocked */
+        uint64_t timeout = Hal_getTimeInMs() + 5000;
 
-	CS104_Slave_destroy(slave);
+        while (receiver->blocked && (Hal_getTimeInMs() < timeout))
+            Thread_sleep(10);
+    }
 
-	CS104_Connection_destroy(con);
+    return true;
 }
 
 void
-test_CS104_MasterSlave_CreateDestroyLoop(void)
+test_CS104_MasterSlave_TLSSlowConsumer(void)
 {
-	CS104_Slave slave = NULL;
-	CS104_Connection con = NULL;
+    struct sSlowConsumerEvents events;
+    struct sBlockingReceiver receiver;
+    struct sSocketOptions socketOptions;
 
-	for (int i = 0; i < 1000; i++) {
-		slave = CS104_Slave_create(100, 100);
+    memset(&events, 0, sizeof(events));
+    memset(&receiver, 0, sizeof(receiver));
 
-		TEST_ASSERT_NOT_NULL(slave);
+    receiver.blocked = true;
 
-		CS104_Slave_setLocalPort(slave, 20004);
+    TLSConfiguration tlsConfig1 = TLSConfiguration_create();
 
-		CS104_Slave_start(slave);
+    TLSConfiguration_setChainValidation(tlsConfig1, true);
 
-		con = CS104_Connection_create("127.0.0.1", 20004);
+    TLSConfiguration_setOwnKeyFromFile(tlsConfig1, "server-key.pem", NULL);
+    TLSConfiguration_setOwnCertificateFromFile(tlsConfig1, "server.cer");
+    TLSConfiguration_addCACertificateFromFile(tlsConfig1, "root.cer");
 
-		TEST_ASSERT_NOT_NULL(con);
+    TLSConfiguration tlsConfig2 = TLSConfiguration_create();
 
-		bool result = CS104_Connection_connect(con);
+    TLSConfiguration_setChainValidation(tlsConfig2, true);
+    TLSConfiguration_setAllowOnlyKnownCertificates(tlsConfig2, true);
 
-		TEST_ASSERT_TRUE(result);
+    TLSConfiguration_setOwnKeyFromFile(tlsConfig2, "client1-key.pem", NULL);
+    TLSConfiguration_setOwnCertificateFromFile(tlsConfig2, "client1.cer");
+    TLSConfiguration_addCACertificateFromFile(tlsConfig2, "root.cer");
 
-		CS104_Slave_destroy(slave);
+    TLSConfiguration_addAllowedCertificateFromFile(tlsConfig2, "server.cer");
 
-		CS104_Connection_destroy(con);
-	}
-}
+    CS104_Slave slave = CS104_Slave_createSecure(500, 10, tlsConfig1);
 
+    TEST_ASSERT_NOT_NULL(slave);
 
-void
-test_CS104_Connection_ConnectTimeout(void)
-{
-	CS104_Connection con = CS104_Connection_create("192.168.3.120", 2404);
+    configureSlowConsumerSlave(slave, &events, 500);
 
-	TEST_ASSERT_NOT_NULL(con);
+    CS104_Slave_setSlowConsumerThresholds(slave, 200, 0);
 
-	bool result = CS104_Connection_connect(con);
+    CS104_Slave_start(slave);
 
-	TEST_ASSERT_FALSE(result);
+    enqueueSlowConsumerData(slave, 500);
 
-	CS104_Connection_destroy(con);
-}
+    CS104_Connection con = CS104_Connection_createSecure("127.0.0.1", 20007, tlsConfig2);
 
-void
-test_CS104_Connection_UseAfterClose(void)
-{
-    CS104_Slave slave = NULL;
-    CS104_Connection con = NULL;
+    TEST_ASSERT_NOT_NULL(con);
 
-    slave = CS104_Slave_create(100, 100);
+    SocketOptions_init(&socketOptions);
+    socketOptions.receiveBufferSize = 4096;
 
-    TEST_ASSERT_NOT_NULL(slave);
+    CS104_Connection_setSocketOptions(con, &socketOptions);
+    CS104_Connection_setASDUReceivedHandler(con, blockingReceiverHandler, &receiver);
 
-    CS104_Slave_setLocalPort(slave, 20004);
-    CS104_Slave_start(slave);
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con));
 
-    con = CS104_Connection_create("127.0.0.1", 20004);
+    CS104_Connection_sendStartDT(con);
 
-    TEST_ASSERT_NOT_NULL(con);
+    /* the TLS socket doesn't block when the peer doesn't read -> the record is kept in the output buffer */
+    uint64_t timeout = Hal_getTimeInMs() + 3000;
 
-    bool result = CS104_Connection_connect(con);
+    while ((Hal_getTimeInMs() < timeout) && (events.slowConsumerEvents == 0))
+        Thread_sleep(10);
 
-    TEST_ASSERT_TRUE(result);
+    TEST_ASSERT_TRUE(events.slowConsumerEvents > 0);
+    TEST_ASSERT_EQUAL_INT(1, CS104_Slave_getOpenConnections(slave));
 
-    CS104_Connection_close(con);
+    /* the peer reads again -> the rest of the partially written record is sent */
+    receiver.blocked = false;
 
-    result = CS104_Connection_sendInterrogationCommand(con, CS101_COT_ACTIVATION, 1, IEC60870_QOI_STATION);
+    timeout = Hal_getTimeInMs() + 5000;
 
-    TEST_ASSERT_FALSE(result);
+    while ((Hal_getTimeInMs() < timeout) && (receiver.receivedAsdus < 500))
+        Thread_sleep(10);
 
-    CS104_Slave_destroy(slave);
+    TEST_ASSERT_EQUAL_INT(500, receiver.receivedAsdus);
+    TEST_ASSERT_EQUAL_INT(0, receiver.unexpectedValues);
+    TEST_ASSERT_EQUAL_INT(0, events.closedEvents);
 
     CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+
+    TLSConfiguration_destroy(tlsConfig1);
+    TLSConfiguration_destroy(tlsConfig2);
 }
 
-void
-test_CS104_Connection_UseAfterServerClosedConnection(void)
+/* forwards the data between client and slave and counts the TLS records sent by the slave */
+struct sTlsRecordRelay {
+    ServerSocket serverSocket;
+    volatile bool running;
+    volatile int applicationDataRecords;
+    int headerBytes;
+    uint8_t header[5];
+    int remainingRecordBytes;
+};
+
+static void
+countTlsRecords(struct sTlsRecordRelay* relay, uint8_t* buf, int size)
 {
-    CS104_Slave slave = NULL;
-    CS104_Connection con = NULL;
+    int pos = 0;
 
-    slave = CS104_Slave_create(100, 100);
+    while (pos < size) {
 
-    TEST_ASSERT_NOT_NULL(slave);
+        if (relay->remainingRecordBytes > 0) {
+            int skip = size - pos;
 
-    CS104_Slave_setLocalPort(slave, 20004);
-    CS104_Slave_start(slave);
+            if (skip > relay->remainingRecordBytes)
+                skip = relay->remainingRecordBytes;
 
-    con = CS104_Connection_create("127.0.0.1", 20004);
+            relay->remainingRecordBytes -= skip;
+            pos += skip;
+        }
+        else {
+            relay->header[relay->headerBytes++] = buf[pos++];
 
-    TEST_ASSERT_NOT_NULL(con);
+            if (relay->headerBytes == 5) {
 
-    bool result = CS104_Connection_connect(con);
+                /* content type 23 = application data */
+                if (relay->header[0] == 23)
+                    relay->applicationDataRecords++;
 
-    TEST_ASSERT_TRUE(result);
+                relay->remainingRecordBytes = relay->header[3] * 0x100 + relay->header[4];
+                relay->headerBytes = 0;
+            }
+        }
+    }
+}
 
-    CS104_Slave_destroy(slave);
+static bool
+relayData(Socket from, Socket to, struct sTlsRecordRelay* relay)
+{
+    uint8_t buf[4096];
 
-    /* wait to allow client side to detect connection loss */
-    Thread_sleep(500);
+    int readBytes = Socket_read(from, buf, sizeof(buf));
 
-    result = CS104_Connection_sendInterrogationCommand(con, CS101_COT_ACTIVATION, 1, IEC60870_QOI_STATION);
+    if (readBytes < 0)
+        return false;
 
-    TEST_ASSERT_FALSE(result);
+    if (relay)
+        countTlsRecords(relay, buf, readBytes);
 
-    CS104_Connection_destroy(con);
+    int written = 0;
+
+    while (written < readBytes) {
+        int writtenBytes = Socket_write(to, buf + written, readBytes - written);
+
+        if (writtenBytes < 0)
+            return false;
+
+        written += writtenBytes;
+    }
+
+    return true;
 }
 
-void
-test_CS101_ASDU_addObjectOfWrongType(void)
+static void*
+tlsRecordRelayThread(void* parameter)
 {
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    struct sTlsRecordRelay* relay = (struct sTlsRecordRelay*) parameter;
 
-    InformationObject io1 = (InformationObject) SinglePointInformation_create(NULL, 101, true, IEC60870_QUALITY_GOOD);
+    Socket client = test_HandleSet_accept(relay->serverSocket);
 
-    bool added = CS101_ASDU_addInformationObject(asdu, io1);
+    Socket slaveSocket = TcpSocket_create();
 
-    TEST_ASSERT_TRUE(added);
+    if (client && Socket_connect(slaveSocket, "127.0.0.1", 20004)) {
 
-    InformationObject_destroy(io1);
+        HandleSet handleSet = Handleset_new();
 
-    InformationObject io2 = (InformationObject) DoublePointInformation_create(NULL, 102, IEC60870_DOUBLE_POINT_OFF, IEC60870_QUALITY_GOOD);
+        Handleset_addSocket(handleSet, client);
+        Handleset_addSocket(handleSet, slaveSocket);
 
-    added = CS101_ASDU_addInformationObject(asdu, io2);
+        while (relay->running) {
 
-    TEST_ASSERT_FALSE(added);
+            if (Handleset_waitReady(handleSet, 10) > 0) {
 
-    InformationObject_destroy(io2);
+                if (Handleset_isReady(handleSet, client)) {
+                    if (relayData(client, slaveSocket, NULL) == false)
+                        break;
+                }
 
-    CS101_ASDU_destroy(asdu);
+                if (Handleset_isReady(handleSet, slaveSocket)) {
+                    if (relayData(slaveSocket, client, relay) == false)
+                        break;
+                }
+            }
+        }
+
+        Handleset_destroy(handleSet);
+    }
+
+    if (client)
+        Socket_destroy(client);
+
+    Socket_destroy(slaveSocket);
+
+    return NULL;
 }
 
-void
-test_CS101_ASDU_addUntilOverflow(void)
+struct sTlsRecordInfo {
+    IMasterConnection connection;
+    volatile int receivedAsdus;
+    volatile int receivedSpontaneous;
+    volatile uint64_t lastSpontaneousTime;
+};
+
+static bool
+tlsRecordInterrogationHandler(void* parameter, IMasterConnection connection, CS101_ASDU asdu, uint8_t qoi)
 {
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    struct sTlsRecordInfo* info = (struct sTlsRecordInfo*) parameter;
 
-    int i = 0;
+    info->connection = connection;
 
-    for (i = 0; i < 60; i++) {
-        InformationObject io = (InformationObject) SinglePointInformation_create(NULL, 100 + i, true, IEC60870_QUALITY_GOOD);
+    CS101_AppLayerParameters alParams = IMasterConnection_getApplicationLayerParameters(connection);
 
-        bool added = CS101_ASDU_addInformationObject(asdu, io);
+    IMasterConnection_sendACT_CON(connection, asdu, false);
 
-        TEST_ASSERT_TRUE(added);
+    int i;
+
+    for (i = 0; i < 10; i++) {
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_INTERROGATED_BY_STATION, 0, 1, false, false);
+
+        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 100 + i, (int16_t) i, IEC60870_QUALITY_GOOD);
+
+        CS101_ASDU_addInformationObject(newAsdu, io);
 
         InformationObject_destroy(io);
 
-        TEST_ASSERT_EQUAL_INT(i + 1, CS101_ASDU_getNumberOfElements(asdu));
+        IMasterConnection_sendASDU(connection, newAsdu);
+
+        CS101_ASDU_destroy(newAsdu);
     }
 
-    InformationObject io = (InformationObject) SinglePointInformation_create(NULL, 100 + i, true, IEC60870_QUALITY_GOOD);
+    IMasterConnection_sendACT_TERM(connection, asdu);
 
-    bool added = CS101_ASDU_addInformationObject(asdu, io);
+    return true;
+}
 
-    TEST_ASSERT_FALSE(added);
+static bool
+tlsRecordAsduHandler(void* parameter, int address, CS101_ASDU asdu)
+{
+    struct sTlsRecordInfo* info = (struct sTlsRecordInfo*) parameter;
 
-    InformationObject_destroy(io);
+    if (CS101_ASDU_getCOT(asdu) == CS101_COT_SPONTANEOUS) {
+        info->lastSpontaneousTime = Hal_getTimeInMs();
+        info->receivedSpontaneous++;
+    }
+    else
+        info->receivedAsdus++;
 
-    CS101_ASDU_destroy(asdu);
+    return true;
 }
 
 void
-test_CS104_MasterSlave_TLSConnectSuccess(void)
+test_CS104_MasterSlave_TLSRecordCoalescing(void)
 {
+    struct sTlsRecordRelay relay;
+    struct sTlsRecordInfo info;
+
+    memset(&relay, 0, sizeof(relay));
+    memset(&info, 0, sizeof(info));
+
     TLSConfiguration tlsConfig1 = TLSConfiguration_create();
 
     TLSConfiguration_setChainValidation(tlsConfig1, true);
@@ -5247,64 +8415,96 @@ test_CS104_MasterSlave_TLSConnectSuccess(void)
     TEST_ASSERT_NOT_NULL(slave);
 
     CS104_Slave_setLocalPort(slave, 20004);
+    CS104_Slave_setInterrogationHandler(slave, tlsRecordInterrogationHandler, &info);
 
     CS104_Slave_start(slave);
 
-    CS104_Connection con = CS104_Connection_createSecure("127.0.0.1", 20004, tlsConfig2);
+    /* the client is connected to the slave by the relay */
+    relay.serverSocket = TcpServerSocket_create("127.0.0.1", 20005);
+
+    TEST_ASSERT_NOT_NULL(relay.serverSocket);
+
+    ServerSocket_listen(relay.serverSocket);
+
+    relay.running = true;
+
+    Thread relayThread = Thread_create(tlsRecordRelayThread, &relay, false);
+
+    Thread_start(relayThread);
+
+    CS104_Connection con = CS104_Connection_createSecure("127.0.0.1", 20005, tlsConfig2);
 
     TEST_ASSERT_NOT_NULL(con);
 
-    bool result = CS104_Connection_connect(con);
+    CS104_Connection_setASDUReceivedHandler(con, tlsRecordAsduHandler, &info);
 
-    TEST_ASSERT_TRUE(result);
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con));
 
-    CS104_Slave_destroy(slave);
+    CS104_Connection_sendStartDT(con);
 
-    CS104_Connection_destroy(con);
+    Thread_sleep(200);
 
-    TLSConfiguration_destroy(tlsConfig1);
-    TLSConfiguration_destroy(tlsConfig2);
-}
+    int recordsBefore = relay.applicationDataRecords;
 
+    TEST_ASSERT_TRUE(CS104_Connection_sendInterrogationCommand(con, CS101_COT_ACTIVATION, 1, IEC60870_QOI_STATION));
 
-void
-test_CS104_MasterSlave_TLSConnectFails(void)
-{
-    TLSConfiguration tlsConfig1 = TLSConfiguration_create();
+    uint64_t timeout = Hal_getTimeInMs() + 2000;
 
-    TLSConfiguration_setChainValidation(tlsConfig1, true);
+    while ((Hal_getTimeInMs() < timeout) && (info.receivedAsdus < 12))
+        Thread_sleep(1);
 
-    TLSConfiguration tlsConfig2 = TLSConfiguration_create();
+    TEST_ASSERT_EQUAL_INT(12, info.receivedAsdus);
 
-    TLSConfiguration_setChainValidation(tlsConfig2, true);
-    TLSConfiguration_setAllowOnlyKnownCertificates(tlsConfig2, true);
+    Thread_sleep(100);
 
-    TLSConfiguration_setOwnKeyFromFile(tlsConfig2, "client1-key.pem", NULL);
-    TLSConfiguration_setOwnCertificateFromFile(tlsConfig2, "client1.cer");
-    TLSConfiguration_addCACertificateFromFile(tlsConfig2, "root.cer");
+    /*
+     * ACT_CON, the 10 responses and ACT_TERM are sent in the same loop iteration of the
+     * connection -> single record (a TLS 1.3 session ticket can be sent with the first data)
+     */
+    TEST_ASSERT_TRUE((relay.applicationDataRecords - recordsBefore) <= 2);
 
-    TLSConfiguration_addAllowedCertificateFromFile(tlsConfig2, "server.cer");
+    /* frames sent by another thread are not kept until the end of the next loop iteration */
+    int i;
 
-    CS104_Slave slave = CS104_Slave_createSecure(100, 100, tlsConfig1);
+    for (i = 0; i < 5; i++) {
+        Thread_sleep(30);
 
-    TEST_ASSERT_NOT_NULL(slave);
+        CS101_ASDU newAsdu = CS101_ASDU_create(IMasterConnection_getApplicationLayerParameters(info.connection),
+                false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
 
-    CS104_Slave_setLocalPort(slave, 20004);
+        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 200, (int16_t) i, IEC60870_QUALITY_GOOD);
 
-    CS104_Slave_start(slave);
+        CS101_ASDU_addInformationObject(newAsdu, io);
 
-    CS104_Connection con = CS104_Connection_createSecure("127.0.0.1", 20004, tlsConfig2);
+        InformationObject_destroy(io);
 
-    TEST_ASSERT_NOT_NULL(con);
+        uint64_t sendTime = Hal_getTimeInMs();
 
-    bool result = CS104_Connection_connect(con);
+        TEST_ASSERT_TRUE(IMasterConnection_sendASDU(info.connection, newAsdu));
 
-    TEST_ASSERT_FALSE(result);
+        CS101_ASDU_destroy(newAsdu);
 
-    CS104_Slave_destroy(slave);
+        timeout = sendTime + 1000;
+
+        while ((Hal_getTimeInMs() < timeout) && (info.receivedSpontaneous < (i + 1)))
+            Thread_sleep(1);
+
+        TEST_ASSERT_EQUAL_INT(i + 1, info.receivedSpontaneous);
+
+        /* the connection thread waits up to 100 ms for data from the client */
+        TEST_ASSERT_TRUE((info.lastSpontaneousTime - sendTime) < 50);
+    }
 
     CS104_Connection_destroy(con);
 
+    relay.running = false;
+
+    Thread_destroy(relayThread);
+
+    ServerSocket_destroy(relay.serverSocket);
+
+    CS104_Slave_destroy(slave);
+
     TLSConfiguration_destroy(tlsConfig1);
     TLSConfiguration_destroy(tlsConfig2);
 }
@@ -5314,6 +8514,11 @@ main(int argc, char** argv)
 {
     UNITY_BEGIN();
     RUN_TEST(test_CS104_Slave_CreateDestroy);
+    RUN_TEST(test_ConditionWaitTimed);
+    RUN_TEST(test_ThreadAttributes);
+    RUN_TEST(test_HandleSetIsReady);
+    RUN_TEST(test_HandleSetIsReadyAfterRemove);
+    RUN_TEST(test_SocketIoRingSendAndReceive);
     RUN_TEST(test_CS104_MasterSlave_CreateDestroyLoop);
     RUN_TEST(test_CS104_Connection_CreateDestroy);
     RUN_TEST(test_CS104_MasterSlave_CreateDestroy);
@@ -5390,8 +8595,29 @@ main(int argc, char** argv)
 
     RUN_TEST(test_CS104SlaveConnectionIsRedundancyGroup);
     RUN_TEST(test_CS104SlaveSingleRedundancyGroup);
+    RUN_TEST(test_CS104SlaveConnectionIsRedundancyGroupThreadless);
+    RUN_TEST(test_CS104SlaveThreadlessMultipleConnections);
+#if defined(__linux__)
+    RUN_TEST(test_CS104SlaveConnectionThreadReused);
+#endif
 
     RUN_TEST(test_CS104SlaveEventQueue1);
+    RUN_TEST(test_CS104SlaveSocketOptionsCorkBatches);
+    RUN_TEST(test_CS104SlaveMultipleMessagesInOneSegment);
+    RUN_TEST(test_CS104SlaveSlowConsumerResume);
+    RUN_TEST(test_CS104SlaveSlowConsumerClose);
+#if defined(__linux__)
+    RUN_TEST(test_SerialTransceiverFT12_ResyncInBuffer);
+    RUN_TEST(test_SerialPort_WriteLineTiming);
+    RUN_TEST(test_SerialTransceiverFT12_TransmissionTimeFromCharacterFormat);
+    RUN_TEST(test_CS101_ChannelGroup_MultipleSlaves);
+    RUN_TEST(test_CS101_MasterUnbalanced_RetryDelayForDeadSlave);
+    RUN_TEST(test_CS101_MasterUnbalanced_SlaveQueueWithPriorities);
+    RUN_TEST(test_CS101_MasterUnbalanced_AdaptiveTimeouts);
+    RUN_TEST(test_CS101_VirtualLine_MasterSlaveUnbalanced);
+    RUN_TEST(test_CS101_VirtualLine_LongFrameAtLowBaudRate);
+    RUN_TEST(test_CS101_Slave_LogicalSlavesOnOneLine);
+#endif
     RUN_TEST(test_CS104SlaveEventQueueOverflow);
     RUN_TEST(test_CS104SlaveEventQueueOverflow2);
     RUN_TEST(test_CS104SlaveEventQueueCheckCapacity);
@@ -5401,11 +8627,24 @@ main(int argc, char** argv)
 
     RUN_TEST(test_CS104_Connection_UseAfterClose);
     RUN_TEST(test_CS104_Connection_UseAfterServerClosedConnection);
+    RUN_TEST(test_CS104_FileService_TransferFiles);
+    RUN_TEST(test_CS104_ProcessImage_InterrogationAndEvents);
+    RUN_TEST(test_CS104_ProcessImage_ConnectionClosedDuringInterrogation);
+    RUN_TEST(test_CS104_Slave_InterrogationStream);
+    RUN_TEST(test_CS104_Slave_WindowOpenHandler);
+    RUN_TEST(test_CS101_EventFilter_DeadbandsAndChangeDetection);
+    RUN_TEST(test_CS101_EventFilter_SplitSequenceASDU);
     RUN_TEST(test_CS101_ASDU_addObjectOfWrongType);
     RUN_TEST(test_CS101_ASDU_addUntilOverflow);
+    RUN_TEST(test_CS101_Queue_VariableLengthEntries);
 
     RUN_TEST(test_CS104_MasterSlave_TLSConnectSuccess);
     RUN_TEST(test_CS104_MasterSlave_TLSConnectFails);
+    RUN_TEST(test_CS104_MasterSlave_TLSSessionResumption);
+    RUN_TEST(test_CS104_MasterSlave_TLSStalledHandshake);
+    RUN_TEST(test_CS104_MasterSlave_TLSStalledHandshakeThreadless);
+    RUN_TEST(test_CS104_MasterSlave_TLSSlowConsumer);
+    RUN_TEST(test_CS104_MasterSlave_TLSRecordCoalescing);
 
     return UNITY_END();
 }